@@ -1,4699 +1,6701 @@
-/**
-* @mainpage STTNet C++ Framework
-* @author StephenTaam(1356597983@qq.com)
-* @version 0.5.0
-* @date 2026-01-09
-*/
-#ifndef PUBLIC_H
-#define PUBLIC_H 1
-#include<jsoncpp/json/json.h>
-#include<string_view>
-#include<string>
-#include<atomic>
-#include<iostream>
-#include<unistd.h>
-#include<sys/stat.h>
-#include<fstream>
-#include<fcntl.h>
-#include<sstream>
-#include<mutex>
-#include<chrono>
-#include<iomanip>
-#include<random>
-#include<cmath>
-#include<thread>
-#include<openssl/sha.h>
-#include<netdb.h>
-#include<arpa/inet.h>
-#include<sys/types.h>
-#include<sys/socket.h>
-#include<cstring>
-#include<openssl/bio.h>
-#include<openssl/evp.h>
-#include<openssl/buffer.h>
-#include<functional>
-#include<list>
-#include<queue>
-#include<sys/epoll.h> 
-#include<condition_variable>
-#include <regex>
-#include<unordered_map>
-#include <openssl/ssl.h>
-#include <openssl/err.h>
-#include<openssl/crypto.h>
-#include<signal.h>
-#include<sys/ipc.h>
-#include<sys/sem.h>
-#include<sys/wait.h>
-#include<sys/shm.h>
-#include<type_traits>
-#include<charconv>
-#include<any>
-#include <sys/eventfd.h>
-#include <sys/timerfd.h>
-#include <cstddef>
-#include <cstdint>
-#include <new>
-#include <vector>
-/**
-* @namespace stt
-*/
-
-namespace stt
-{
-
-    namespace system
-    {
-        class WorkerPool;
-
-/**
- * @brief Lock-free bounded MPSC queue (Multi-Producer Single-Consumer)
- *        无锁有界多生产者单消费者队列（环形缓冲）
- *
- * - Multiple threads may push concurrently.
- * - Only ONE thread may pop.
- *
- * - 多个线程可以同时 push
- * - 仅允许一个线程 pop（通常是 reactor 线程）
- *
- * Design:
- * - Fixed-size ring buffer (power-of-two capacity)
- * - Per-slot sequence number to coordinate producers/consumer
- *
- * 特点：
- * - 零 malloc/零 free（不为每个元素分配 Node）
- * - cache 友好
- * - push/pop 只用原子 + 轻量自旋
- *
- * IMPORTANT:
- *  ❗ Capacity must be a power of two.
- *  ❗ pop() must be called by only one thread.
- *
- * 重要：
- *  ❗ 容量必须是 2 的幂
- *  ❗ pop 只能由一个线程调用
- */
-template <typename T>
-class MPSCQueue {
-public:
-    explicit MPSCQueue(std::size_t capacity_pow2)
-        : capacity_(capacity_pow2),
-          mask_(capacity_pow2 - 1),
-          buffer_(capacity_pow2),
-          head_(0),
-          tail_(0)
-    {
-        // capacity must be power of two
-        if (capacity_ < 2 || (capacity_ & mask_) != 0) {
-            // You can replace with your own assert/log
-            throw std::invalid_argument("MPSCQueue capacity must be power of two and >= 2");
-        }
-
-        // Initialize per-slot sequence
-        for (std::size_t i = 0; i < capacity_; ++i) {
-            buffer_[i].seq.store(i, std::memory_order_relaxed);
-        }
-    }
-
-    MPSCQueue(const MPSCQueue&) = delete;
-    MPSCQueue& operator=(const MPSCQueue&) = delete;
-
-    ~MPSCQueue() {
-        // Drain remaining items to call destructors if needed
-        T tmp;
-        while (pop(tmp)) {}
-    }
-
-    /**
-     * @brief Try push (non-blocking). Returns false if queue is full.
-     *        尝试入队（非阻塞），队列满则返回 false
-     */
-    bool push(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>) {
-        return emplace_impl(std::move(v));
-    }
-
-    bool push(const T& v) noexcept(std::is_nothrow_copy_constructible_v<T>) {
-        return emplace_impl(v);
-    }
-
-    /**
-     * @brief Try pop (single consumer). Returns false if empty.
-     *        尝试出队（单消费者），空则返回 false
-     */
-    bool pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T> &&
-                              std::is_nothrow_move_constructible_v<T>)
-    {
-        Slot& slot = buffer_[head_ & mask_];
-        const std::size_t seq = slot.seq.load(std::memory_order_acquire);
-        const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(head_ + 1);
-
-        if (dif != 0) {
-            // seq != head+1 => empty
-            return false;
-        }
-
-        // Move out
-        out = std::move(*slot.ptr());
-
-        // Destroy in-place
-        slot.destroy();
-
-        // Mark slot as free for producers:
-        // seq = head + capacity
-        slot.seq.store(head_ + capacity_, std::memory_order_release);
-
-        ++head_;
-        return true;
-    }
-
-    /**
-     * @brief Approximate size (may be inaccurate under concurrency)
-     *        近似长度（并发下可能不精确）
-     */
-    std::size_t approx_size() const noexcept {
-        const std::size_t t = tail_.load(std::memory_order_relaxed);
-        const std::size_t h = head_; // consumer-only
-        return (t >= h) ? (t - h) : 0;
-    }
-
-private:
-    struct Slot {
-        std::atomic<std::size_t> seq;
-        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
-        bool has_value = false;
-
-        T* ptr() noexcept { return reinterpret_cast<T*>(&storage); }
-        const T* ptr() const noexcept { return reinterpret_cast<const T*>(&storage); }
-
-        template <class U>
-        void construct(U&& v) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
-            ::new (static_cast<void*>(&storage)) T(std::forward<U>(v));
-            has_value = true;
-        }
-
-        void destroy() noexcept {
-            if (has_value) {
-                ptr()->~T();
-                has_value = false;
-            }
-        }
-    };
-
-    template <class U>
-    bool emplace_impl(U&& v) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
-        std::size_t pos = tail_.load(std::memory_order_relaxed);
-
-        for (;;) {
-            Slot& slot = buffer_[pos & mask_];
-            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
-            const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
-
-            if (dif == 0) {
-                // slot is free for this pos
-                if (tail_.compare_exchange_weak(
-                        pos, pos + 1,
-                        std::memory_order_relaxed,
-                        std::memory_order_relaxed))
-                {
-                    // We own this slot now
-                    slot.construct(std::forward<U>(v));
-                    // Publish to consumer: seq = pos+1 means "ready"
-                    slot.seq.store(pos + 1, std::memory_order_release);
-                    return true;
-                }
-                // CAS failed: pos updated with current tail; retry
-            } else if (dif < 0) {
-                // slot seq < pos => queue is full (producer wrapped)
-                return false;
-            } else {
-                // Another producer is ahead; move pos forward
-                pos = tail_.load(std::memory_order_relaxed);
-            }
-        }
-    }
-
-private:
-    const std::size_t capacity_;
-    const std::size_t mask_;
-    std::vector<Slot> buffer_;
-
-    // Single consumer only
-    std::size_t head_;
-
-    // Multi-producer
-    std::atomic<std::size_t> tail_;
-};
-
-
-    }
-    /**
-    * @namespace stt::file
-    * @brief 文件相关：文件读写，日志等
-    * @ingroup stt
-    */
-    namespace file
-    {
-    /**
-    * @brief 提供文件操作的静态函数工具类
-    */
-    class FileTool
-    {
-    public:
-        /**
-        * @brief 新建一个目录
-        * @param ddir 目录路径，可以绝对路径也可以相对路径
-        * @param mode 位掩码表示新建目录的权限（默认为0775 即rwx rwx r-x）
-        * @return true 操作成功
-        * @return false 操作失败
-        */
-        static bool createDir(const std::string & ddir,const mode_t &mode=0775); 
-        /**
-        * @brief 复制文件
-        * @param sourceFile 源文件路径，可以绝对路径也可以相对路径
-        * @param objectFile 目标文件路径，可以绝对路径也可以相对路径
-        * @return true 操作成功
-        * @return false 操作失败
-        * @note 不会自动创造不存在的路径
-        */
-        static bool copy(const std::string &sourceFile,const std::string &objectFile);
-        /**
-        * @brief 新建一个文件
-        * @param filePath 文件路径，可以绝对路径也可以相对路径
-        * @param mode 位掩码表示新建文件的权限（默认为0666 即rw- rw- rw-）
-        * @return true 操作成功
-        * @return false 操作失败
-        * @note 会自动创造原本不存在的路径
-        */
-        static bool createFile(const std::string &filePath,const mode_t &mode=0666);
-        /**
-        * @brief 获取文件大小
-        * @param fileName 文件名字（可以填绝对路径也可以填相对路径）
-        * @return >=0 返回文件大小
-        * @return -1 获取文件大小失败
-        */
-        static size_t get_file_size(const std::string &fileName);
-    };
-    
-    /**
-    * @brief 记录文件和线程关系的结构体
-    * @note 用于在后续类中使用，保证线程安全
-    */
-    struct FileThreadLock
-    {
-        /**
-        * @brief 文件路径
-        */
-        std::string loc;
-        /**
-        * @brief 记录文件正在被多少个线程使用
-        */
-        int threads;
-        /**
-        * @brief 此文件的锁
-        */
-        std::mutex lock;
-        /**
-        * @brief 这个结构体的构造函数
-        * @param loc 传入路径构造结构体对象
-        * @param threads 传入文件被多少个线程使用的数量构造结构体对象
-        */
-        FileThreadLock(const std::string &loc,const int &threads):loc(loc),threads(threads){};
-    };
-
-    /**
-    * @brief 读写磁盘文件的类
-    * @note 1、本类的同一个对象能确保同步性和线程安全
-    * @note 2、如果用本类的对象操作同一个文件也能保证同步性。但注意打开的时候统一这个文件的路径，要么用绝对路径，要么用相对路径。
-    * @note 3、这个类操作文件的时候有两种模式：1，读取磁盘+操作内存的数据+保存到磁盘；这三步分开做，适合自定义复杂操作的场景。 2，把三步操作合并成一步操作完成
-    */
-    class File:private FileTool
-    {
-    protected:
-        static std::mutex l1;
-        static std::unordered_map<std::string,FileThreadLock> fl2;
-    protected:
-        std::mutex che;
-        
-    private:
-        void lockfl2();
-        void unlockfl2();
-    private:
-        std::ifstream fin;
-        std::vector<std::string> data;
-        std::vector<std::string> backUp;
-        char *data_binary=nullptr;
-        char *backUp_binary=nullptr;
-        size_t size1=0;
-        size_t size2=0;
-        int multiple=0;
-        size_t multiple_backup=0;
-        size_t malloced=0;
-        std::mutex fl1;
-        
-        std::ofstream fout;
-        std::string fileName;
-	    
-        std::string fileNameTemp;
-        bool flag=false;
-        bool binary;
-        mode_t mode;
-        size_t size=0;
-        uint64_t totalLines=0;
-    private:
-        void toMemory();
-        bool toDisk();
-    public:
-        /**
-        * @brief 打开文件
-        * @param fileName 打开文件的名字（可以用绝对路径或者相对路径）
-        * @param create true：当文件不存在的时候创建文件（以及目录） false：当文件不存在的时候不创建文件 （默认为true）
-        * @param multiple 当>=1的时候启用二进制打开文件，这个值为需要操作文件所需的预定的文件空间大小和原文件大小的比值  当<1的时候采用文本模式打开文件 （默认为0 文本模式打开）
-        * @param size 手动填入所需的预定文件空间的大小，当这个参数非0时，不会采用multiple的倍数预留值而是直接用这个预定大小 （单位字节）（默认为0）
-        * @param mode 如果create为true，且文件不存在，用位掩码表示新建文件的权限（默认为0666 rw- rw- rw-）
-        * @return true:打开成功
-        * @return false:打开失败
-        * @note 任何操作都需要先打开文件
-        * @warning 如果二进制模式下预留的空间太小，可能会导致段错误
-        *
-        * 示例代码 1： 文本模式打开和程序同一路径下名为"test"的文件
-        *
-        * @code
-        * File f; 
-        * f.openFile("test");
-        * @endcode
-        *
-        * 示例代码 2： 二进制模式下打开和程序同一路径下名为"test"的文件,计划只读
-        *
-        * @code
-        * File f; 
-        * f.openFile("test",true,1); //只读说明预留空间是原来的一倍（和原来一样）即可 
-        * @endcode
-        *
-        * 示例代码 3： 二进制模式下打开和程序同一路径下名为"test"的文件,预计会写入数据，写入后大小不大于原来文件大小的两倍
-        *
-        * @code
-        * File f; 
-        * f.openFile("test",true,2); //留出两倍的空间
-        * @endcode
-        *
-        * 示例代码 4： 二进制模式下打开和程序同一路径下名为"test"的文件,预计会写入数据，写入大小不大于1024字节，原文件大小为0
-        *
-        * @code
-        * File f; 
-        * f.openFile("test",true,1,1024);//由于文件大小为0，代表倍数的第三个参数multiple填入多少都是无效的，需要手动指定大小
-        * @endcode
-        */
-        bool openFile(const std::string &fileName,const bool &create=true,const int &multiple=0,const size_t &size=0,const mode_t &mode=0666);
-        /** 关闭文件
-        * @brief 关闭已打开了的文件
-        * @param del true:删除文件 false：不删除文件 （默认为false）
-        * @return true:操作成功 false：操作失败
-        */
-        bool closeFile(const bool &del=false);
-        /**
-        * @brief 析构函数
-        * @note 默认对象生命周期结束时关闭文件，不删除文件。
-        */
-        ~File(){closeFile(false);}
-        /**
-        * @brief 判断对象是否打开了文件
-        * @return true：对象打开了文件 false：对象没有打开文件
-        */
-        bool isOpen(){return flag;}
-        /**
-        * @brief 判断对象是否以二进制模式打开文件
-        * @return true：对象以二进制模式打开文件  false：对象不以二进制模式打开文件
-        */
-        bool isBinary(){return binary;}
-        /**
-        * @brief 获取打开的文件名字
-        * @return 返回一个打开的文件的名字的字符串
-        */
-        std::string getFileName(){return fileName;}
-        /**
-        * @brief 获取打开的文件的行数
-        * @return 返回打开的文件的行数
-        * @warning 1，只有在文本模式下打开才可能返回正确的值
-        * @warning 2，获取的是上一次读入内存的时候的文件的行数
-        * @warning 3，如果没有把文件读入过内存，返回的值不会是正确的
-        * @note 这个函数也许只有在操作内存数据的时候有作用
-        */
-        uint64_t getFileLine(){return totalLines;}
-        /**
-        * @brief 获取二进制打开的文件的大小
-        * @return 返回二进制打开的文件的大小
-        * @warning 1，只有在二进制模式下打开才可能返回正确的值
-        * @warning 2，获取的是上一次读入内存的时候的文件的大小
-        * @warning 3，如果没有把文件读入过内存，返回的值不会是正确的
-        * @note 这个函数也许只有在操作内存数据的时候有作用
-        */
-        size_t getFileSize(){return size;}
-        /**
-        * @brief 获取二进制打开的文件在内存中的大小
-        * @return 返回二进制打开的文件在内存中的大小
-        * @warning 1，只有在二进制模式下打开才可能返回正确的值
-        * @warning 2，获取的是此时内存中操作的文件的大小
-        * @warning 3，如果没有把文件读入过内存，返回的值不会是正确的
-        * @note 这个函数只有在操作内存数据的时候有作用
-        */
-        size_t getSize1(){return size1;}
-    public:
-        /**
-        * @brief 把数据从磁盘读入内存
-        * @return true 操作成功
-        * @return false 操作失败
-        */
-        bool lockMemory();
-        /**
-        * @brief 把数据从内存写入磁盘
-        * @param rec false 不回退操作，把操作结果保存入磁盘； true 回退操作，不保存。（默认为false 不需要回退）。
-        * @return true 操作成功
-        * @return false 操作失败
-        * @note 如果写入磁盘失败会自动回退操作
-        */     
-        bool unlockMemory(const bool &rec=false);
-    public:
-        /**
-        * @name 操作内存中的数据的函数-文本模式
-        * @{
-        */
-        /**
-        * @brief 查找行
-        * @note 1、查找文件导入内存的数据中存在目标字符串的首行
-        * @note 2、行数从1开始
-        * @param targetString 需要查找的字符串
-        * @param linePos 从指定行开始寻找（默认从第一行开始）
-        * @return >=1 返回匹配的行数
-        * @return -1 查找失败
-        */
-        int findC(const std::string &targetString,const int linePos=1);
-        /**
-        * @brief 插入行
-        * @note 1、在文件导入内存的数据中插入一行
-        * @note 2、行数从1开始
-        * @param data 需要插入的数据
-        * @param linePos 在指定行插入（默认从末尾插入）
-        * @return true 插入成功
-        * @return false 插入失败
-        */
-        bool appendLineC(const std::string &data,const int &linePos=0);
-        /**
-        * @brief 删除行
-        * @note 1、删除文件导入内存的数据中的一行
-        * @note 2、行数从1开始
-        * @param linePos 需要删除的行
-        * @return true 删除成功
-        * @return false 删除失败
-        */
-        bool deleteLineC(const int &linePos=0);
-        /**
-        * @brief 删除全部
-        * @note 删除文件导入内存的数据中的全部
-        * @return true 删除成功
-        * @return false 删除失败
-        */
-        bool deleteAllC();
-        /**
-        * @brief 修改行
-        * @note 1、修改文件导入内存的数据中的一行
-        * @note 2、行数从1开始
-        * @param data 覆盖到指定行的数据
-        * @param linePos 需要覆盖的行（默认最后一行）
-        * @return true 修改成功
-        * @return false 修改失败
-        */
-        bool chgLineC(const std::string &data,const int &linePos=0);
-        /**
-        * @brief 读取单行
-        * @note 1、读取文件导入内存的数据中的单行
-        * @note 2、行数从1开始
-        * @param data 接收数据的字符串容器
-        * @param linePos 读取的行
-        * @return true 读取成功
-        * @return false 读取失败
-        */
-        bool readLineC(std::string &data,const int linePos);
-        /**
-        * @brief 读取行
-        * @note 1、连续读取文件导入内存的数据中的n行
-        * @note 2、行数从1开始
-        * @param data 接收数据的字符串容器
-        * @param linePos 读取的起始位置
-        * @param num 读取的行的数量
-        * @return 字符串参数data的引用
-        */
-        std::string& readC(std::string &data,const int &linePos,const int &num);
-        /**
-        * @brief 读取全部
-        * @note 读取文件导入内存的数据中的全部
-        * @param data 接收数据的字符串容器
-        * @return 字符串参数data的引用
-        */
-        std::string& readAllC(std::string &data);
-        /** @} */
-        /**
-        * @name 操作内存中的数据的函数-二进制模式
-        * @{
-        */
-        /**
-        * @brief 读取数据块
-        * @note 1、读取文件导入内存的数据中的一块数据
-        * @note 2、数据字节单元从0开始
-        * @param data 接收数据的容器
-        * @param pos 数据起始位置
-        * @param size 数据块大小
-        * @return bool 读取成功
-        * @return false 读取失败
-        */
-        bool readC(char *data,const size_t &pos,const size_t &size);
-        /**
-        * @brief 写数据块
-        * @note 1、往文件导入内存的数据中写入一块数据
-        * @note 2、数据字节单元从0开始
-        * @param data 装着写入数据的容器
-        * @param pos 写入位置
-        * @param size 写入数据块大小
-        * @return bool 写入成功
-        * @return false 写入失败
-        */
-        bool writeC(const char *data,const size_t &pos,const size_t &size);
-        /**
-        * @brief 格式化数据
-        * @note 把文件导入内存的数据全部删除
-        */
-        bool formatC();
-        /** @} */
-    public:
-        /**
-        * @name 直接操作磁盘数据的函数-文本模式
-        * @{
-        */
-        /**
-        * @brief 查找行
-        * @note 1、查找文件中存在目标字符串的首行
-        * @note 2、行数从1开始
-        * @param targetString 需要查找的字符串
-        * @param linePos 从指定行开始寻找（默认从第一行开始）
-        * @return >=1 返回匹配的行数
-        * @return -1 查找失败
-        */
-        int find(const std::string &targetString,const int linePos=1);
-        /**
-        * @brief 插入行
-        * @note 1、在文件中插入一行
-        * @note 2、行数从1开始
-        * @param data 需要插入的数据
-        * @param linePos 在指定行插入（默认从末尾插入）
-        * @return true 插入成功
-        * @return false 插入失败
-        */
-        bool appendLine(const std::string &data,const int &linePos=0);
-        /**
-        * @brief 删除行
-        * @note 1、删除文件中的一行
-        * @note 2、行数从1开始
-        * @param linePos 需要删除的行
-        * @return true 删除成功
-        * @return false 删除失败
-        */
-        bool deleteLine(const int &linePos=0);
-        /**
-        * @brief 删除全部
-        * @note 删除文件中的全部行
-        * @return true 删除成功
-        * @return false 删除失败
-        */
-        bool deleteAll();
-        /**
-        * @brief 修改行
-        * @note 1、修改文件中的一行
-        * @note 2、行数从1开始
-        * @param data 覆盖到指定行的数据
-        * @param linePos 需要覆盖的行（默认最后一行）
-        * @return true 修改成功
-        * @return false 修改失败
-        */
-        bool chgLine(const std::string &data,const int &linePos=0);
-        /**
-        * @brief 读取单行
-        * @note 1、读取文件中的单行
-        * @note 2、行数从1开始
-        * @param data 接收数据的字符串容器
-        * @param linePos 读取的行
-        * @return true 读取成功
-        * @return false 读取失败
-        */
-        bool readLine(std::string &data,const int linePos);
-        /**
-        * @brief 读取行
-        * @note 1、连续读取文件中的n行
-        * @note 2、行数从1开始
-        * @param data 接收数据的字符串容器
-        * @param linePos 读取的起始位置
-        * @param num 读取的行的数量
-        * @return 字符串参数data的引用
-        */
-        std::string& read(std::string &data,const int &linePos,const int &num);
-        /**
-        * @brief 读取全部
-        * @note 读取文件中的全部
-        * @param data 接收数据的字符串容器
-        * @return 字符串参数data的引用
-        */
-        std::string& readAll(std::string &data);
-        /** @} */
-        /**
-        * @name 直接操作磁盘数据的函数-二进制模式
-        * @{
-        */
-        /**
-        * @brief 读取数据块
-        * @note 1、读取文件中的一块数据
-        * @note 2、数据字节单元从0开始
-        * @param data 接收数据的容器
-        * @param pos 数据起始位置
-        * @param size 数据块大小
-        * @return bool 读取成功
-        * @return false 读取失败
-        */
-        bool read(char *data,const size_t &pos,const size_t &size);
-        /**
-        * @brief 写数据块
-        * @note 1、往文件中写入一块数据
-        * @note 2、数据字节单元从0开始
-        * @param data 装着写入数据的容器
-        * @param pos 写入位置
-        * @param size 写入数据块大小
-        * @return bool 写入成功
-        * @return false 写入失败
-        */
-        bool write(const char *data,const size_t &pos,const size_t &size);
-        /**
-        * @brief 格式化数据
-        * @note 把文件的数据全部删除
-        */
-        void format();
-        /** @} */
-    };
-    }
-    /**
-    * @namespace stt::time
-    * @brief 时间相关操作，基础时间工具
-    * @ingroup stt
-    */
-    namespace time
-    {
-    /**
-    * @brief 表示时间间隔的结构体，支持天、小时、分钟、秒和毫秒粒度。
-    * @note 1、提供了对时间间隔的基本操作，如加减运算、比较操作、单位转换等。
-    * @note 2、本结构体并不表示绝对时间点，仅用于表示两个时间点之间的差值。
-    * @note 3、内部实现采用多个字段组合，而非统一的时间戳，以提高可读性和可控性。
-    */
-    struct Duration
-    {
-        /**
-        * @brief 天
-        */
-        long long day;
-        /**
-        * @brief 时
-        */
-        int hour;
-        /**
-        * @brief 分
-        */
-        int min;
-        /**
-        * @brief 秒
-        */
-        int sec;
-        /**
-        * @brief 毫秒
-        */
-        int msec;
-        /**
-        * @brief 构造函数，传入天，时，分，秒，毫秒
-        */
-        Duration(long long a,int b,int c,int d,int e):day(a),hour(b),min(c),sec(d),msec(e){}
-        Duration()=default;
-        /**
-        * @brief 判断当前时间间隔是否大于另一个时间间隔。
-        * @param b 要比较的另一个 Duration 实例。
-        * @return 如果当前对象大于参数 b，返回 true，否则返回 false。
-        */
-        bool operator>(const Duration &b)
-        {
-            long long total;
-            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
-            long long totalB;
-            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
-            if(total>totalB)
-                return true;
-            else
-                return false;
-        }
-        /**
-        * @brief 判断当前时间间隔是否小于另一个时间间隔。
-        * @param b 要比较的另一个 Duration 实例。
-        * @return 如果当前对象小于参数 b，返回 true，否则返回 false。
-        */
-        bool operator<(const Duration &b)
-        {
-            long long total;
-            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
-            long long totalB;
-            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
-            if(total<totalB)
-                return true;
-            else
-                return false;
-        }
-        /**
-        * @brief 判断当前时间间隔是否等于另一个时间间隔。
-        * @param b 要比较的另一个 Duration 实例。
-        * @return 如果当前对象等于参数 b，返回 true，否则返回 false。
-        */
-        bool operator==(const Duration &b)
-        {
-            long long total;
-            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
-            long long totalB;
-            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
-            if(total==totalB)
-                return true;
-            else
-                return false;
-        }
-        /**
-        * @brief 判断当前时间间隔是否大于等于另一个时间间隔。
-        * @param b 要比较的另一个 Duration 实例。
-        * @return 如果当前对象大于等于参数 b，返回 true，否则返回 false。
-        */
-        bool operator>=(const Duration &b)
-        {
-            long long total;
-            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
-            long long totalB;
-            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
-            if(total>=totalB)
-                return true;
-            else
-                return false;
-        }
-        /**
-        * @brief 判断当前时间间隔是否小于等于另一个时间间隔。
-        * @param b 要比较的另一个 Duration 实例。
-        * @return 如果当前对象小于等于参数 b，返回 true，否则返回 false。
-        */
-        bool operator<=(const Duration &b)
-        {
-            long long total;
-            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
-            long long totalB;
-            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
-            if(total<=totalB)
-                return true;
-            else
-                return false;
-        }
-        /**
-        * @brief 将两个时间间隔相加。
-        * @param b 要相加的另一个 Duration。
-        * @return 相加后的 Duration。
-        */
-        Duration operator+(const Duration &b)
-        {
-            long long dayy=day;
-            int hourr=hour;
-            int minn=min;
-            int secc=sec;
-            int msecc=msec;
-
-            msecc+=b.msec;
-            secc+=b.sec;
-            minn+=b.min;
-            hourr+=b.hour;
-            dayy+=b.day;
-
-            if(msecc/1000!=0)
-            {
-                secc+=msecc/1000;
-                msecc=msecc%1000;
-            }
-
-            if(secc/60!=0)
-            {
-                minn+=secc/60;
-                secc=secc%60;
-            }
-
-            if(minn/60!=0)
-            {
-                hourr+=minn/60;
-                minn=minn%60;
-            }
-
-            if(hourr/24!=0)
-            {
-                dayy+=hourr/24;
-                hourr=hourr%24;
-            }
-            return Duration(dayy,hourr,minn,secc,msecc);
-        }
-        /**
-        * @brief 计算两个时间间隔的差值（当前对象减去参数 b）。
-        * @param b 要减去的另一个 Duration。
-        * @return 差值 Duration。
-        */
-        Duration operator-(const Duration &b)
-        {
-            long long dayy=day;
-            int hourr=hour;
-            int minn=min;
-            int secc=sec;
-            int msecc=msec;
-
-            msecc=dayy*24*60*60*1000+hourr*60*60*1000+minn*60*1000+secc*1000+msecc-b.day*24*60*60*1000-b.hour*60*60*1000-b.min*60*1000-b.sec*1000-b.msec;
-            secc=0;
-            minn=0;
-            hourr=0;
-            dayy=0;
-
-            if(msecc/1000!=0)
-            {
-                secc+=msecc/1000;
-                msecc=msecc%1000;
-            }
-
-            if(secc/60!=0)
-            {
-                minn+=secc/60;
-                secc=secc%60;
-            }
-
-            if(minn/60!=0)
-            {
-                hourr+=minn/60;
-                minn=minn%60;
-            }
-
-            if(hourr/24!=0)
-            {
-                dayy+=hourr/24;
-                hourr=hourr%24;
-            }
-            return Duration(dayy,hourr,minn,secc,msecc);
-        }
-        
-        /**
-        * @brief 将当前时间间隔转换为以“天”为单位的浮点数表示。
-        */
-        double convertToDay()
-        { 
-            long long total;
-            total=hour*60*60*1000+min*60*1000+sec*1000+msec; 
-            double k=day+total/86400000.0000;
-            return k;
-        }
-        /**
-        * @brief 将当前时间间隔转换为以“小时”为单位的浮点数表示。
-        */
-        double convertToHour()
-        {
-            long long total;
-            total=min*60*1000+sec*1000+msec; 
-            double k=day*24+hour+total/36000000.0000;
-            return k;
-        }
-        /**
-        * @brief 将当前时间间隔转换为以“分钟”为单位的浮点数表示。
-        */
-        double convertToMin()
-        {
-            long long total;
-            total=sec*1000+msec; 
-            double k=day*24*60+hour*60+min+total/60000.0000;
-            return k;
-        }
-        /**
-        * @brief 将当前时间间隔转换为以“秒”为单位的浮点数表示。
-        */
-        double convertToSec()
-        {
-            long long total;
-            total=msec; 
-            double k=day*24*60*60+hour*60*60+min*60+sec+total/1000.0000;
-            return k;
-        }
-        /**
-         * @brief 将当前时间间隔转换为总毫秒数。
-        */
-        long long convertToMsec()
-        {
-            long long total;
-            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
-            return total;
-        }
-        /**
-        * @brief 从给定的毫秒数恢复为标准的天-时-分-秒-毫秒格式。
-        * @param t 要恢复的毫秒值。
-        * @return 转换后的 Duration。
-        */
-        Duration recoverForm(const long long &t)
-        {
-            msec=t;
-            sec=0;
-            min=0;
-            hour=0;
-            day=0;
-
-            if(msec/1000!=0)
-            {
-                sec+=msec/1000;
-                msec=msec%1000;
-            }
-
-            if(sec/60!=0)
-            {
-                min+=sec/60;
-                sec=sec%60;
-            }
-
-            if(min/60!=0)
-            {
-                hour+=min/60;
-                min=min%60;
-            }
-
-            if(hour/24!=0)
-            {
-                day+=hour/24;
-                hour=hour%24;
-            }
-            return Duration(day,hour,min,sec,msec);
-        }
-    };
-    /**
-    * @brief 将 Duration 对象以可读格式输出到流中。
-    *
-    * 该函数用于将 Duration 的各个字段（天、小时、分钟、秒、毫秒）格式化后输出到给定的输出流中。
-    *
-    * @param os 输出流（如 std::cout）。
-    * @param a 要输出的 Duration 对象。
-    * @return 输出流的引用，用于链式输出。
-    *
-    * @note 通常输出格式为类似于 "1d 02:03:04.005" 的人类可读格式（具体取决于实现）。
-    */
-    std::ostream& operator<<(std::ostream &os,const Duration &a);
-
-    using Milliseconds = std::chrono::duration<uint64_t,std::milli>;
-    using Seconds=std::chrono::duration<uint64_t>;
-    /**
-    * @brief 定义ISO8086A这个宏为"yyyy-mm-ddThh:mi:ss"
-    */
-    #define ISO8086A "yyyy-mm-ddThh:mi:ss"
-    /**
-    * @brief 定义ISO8086B这个宏为"yyyy-mm-ddThh:mi:ss.sss"
-    */
-    #define ISO8086B "yyyy-mm-ddThh:mi:ss.sss"
-
-
-    /**
-    * @brief 时间操作、运算、计时的类
-    * @brief 精确到毫秒
-    * @warning 只有在1970+-292年内的是确保准确的
-    * @bug 只有1970+-292年内确保准确,待优化
-    */
-    class DateTime
-    {
-    private:
-        static Duration& dTOD(const Milliseconds& d1,Duration &D1);
-        static Milliseconds& DTOd(const Duration &D1,Milliseconds& d1);
-        static std::string &toPGtimeFormat();
-        static std::chrono::system_clock::time_point strToTimePoint(const std::string &timeStr,const std::string &format=ISO8086A);
-        static std::string& timePointToStr(const std::chrono::system_clock::time_point &tp,std::string &timeStr,const std::string &format=ISO8086A);
-    public:
-        /**
-        * @brief 获取当前时间
-        * @note 获取当前时间，返回字符串
-        * @param timeStr 接收时间的字符串容器
-        * @param format 指定时间字符串的格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @return 返回timeStr的引用
-        */
-        static std::string& getTime(std::string &timeStr,const std::string &format=ISO8086A);
-        /**
-        * @brief 转化时间字符串的格式
-        * @note 传入时间字符串的引用修改原字符串
-        * @param timeSte 原时间字符串
-        * @param oldFormat 原时间字符串格式 （yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒）
-        * @param newFormat 新的时间格式 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @return true转化成功false 转化失败
-        */
-        static bool convertFormat(std::string &timeStr,const std::string &oldFormat,const std::string &newFormat=ISO8086A);
-        /**
-        * @brief 计算两个用字符串表示的时间相减的差值
-        * @param time1 被减的时间
-        * @param time2 减去的时间
-        * @param result 一个接收结果的Duration容器
-        * @param format1 time1的时间字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @param format2 time2的时间字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @return result的引用
-        */
-        static Duration& calculateTime(const std::string &time1,const std::string &time2,Duration &result,const std::string &format1=ISO8086A,const std::string &format2=ISO8086A);
-        /**
-        * @brief 一个用字符串表示的时间加上或者减去一段时间
-        * @param time1 待运算的时间字符串
-        * @param time2 参与运算的用Duration表示的一段时间
-        * @param result 接收用字符串表示的运算结果的string容器
-        * @param am 填入+：加法运算 填入-：减法运算
-        * @param format1 time1的格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @param format2 result的格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @return result的引用
-        */
-        static std::string& calculateTime(const std::string &time1,const Duration &time2,std::string &result,const std::string &am,const std::string &format1=ISO8086A,const std::string &format2=ISO8086A);
-        /**
-        * @brief 比较两个时间字符串表示的时间的大小
-        * @note 时间越往后越大
-        * @param time1 参与比较的第一个字符串
-        * @param time2 参与比较的第二个字符串
-        * @param format1 time1的字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @param format2 time2的字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @return true：time1>=time2  false: time1<time2
-        */
-        static bool compareTime(const std::string &time1,const std::string &time2,const std::string &format1=ISO8086A,const std::string &format2=ISO8086A);
-    private:
-        Duration dt{-1,-1,-1,-1,-1};
-        bool flag=false;
-        std::chrono::steady_clock::time_point start;
-        std::chrono::steady_clock::time_point end;
-    public:
-        /**
-        * @brief 开始计时
-        * @return ture：开始成功  false：开始失败
-        */
-        bool startTiming();
-        /**
-        * @brief 计时过程中检查时间
-        * @return 返回一个Duration记录时间到目前流逝长度
-        */
-        Duration checkTime();
-        /**
-        * @brief 停止计时
-        * @return 返回一个Duration记录时间
-        * @note 对象会保存记录上一次计时的时间
-        */
-        Duration endTiming();
-    public:
-        /**
-        * @brief 获取上一次计时的时间
-        * @return 返回一个Duration记录时间
-        */
-        Duration getDt(){return dt;}
-        /**
-        * @brief 返回本对象计时状态
-        * @return true：对象正在计时  false：对象没有开始计时
-        */
-        bool isStart(){return flag;}
-    };
-    }
-    namespace file
-    {
-    /**
-    * @brief 日志文件操作类
-    * @note 此类的读写日志是线程安全的，因为继承了File类
-    * @note 异步日志 会单独开一个线程进行写入操作，可以多个线程同时操作日志
-    */
-    class LogFile:private time::DateTime,protected File
-    {
-    private:
-        std::string timeFormat;
-        std::string contentFormat;
-        std::atomic<bool> consumerGuard{true};
-        //std::mutex queueMutex;
-        //std::condition_variable queueCV;
-        system::MPSCQueue<std::string> logQueue;
-        std::thread consumerThread;
-    public:
-        /**
-         * @brief 构造函数，初始化消费者线程
-         * @param logQueue_cap 异步日志队列容量（必须为 2 的幂）。
-//
-// 所有线程产生的日志会先进入该无锁队列，再由独立 logger 线程批量写入文件。
-// 日志系统不在主业务热路径上，允许在过载时丢弃，以保护核心服务性能。
-//
-// 选型原则：
-//   logQueue_cap >= 峰值日志速率 × logger 最坏暂停时间
-//
-// 建议值（经验）：
-//   - 默认：8192   (~8k)
-//   - 高频日志：16384 (~16k)
-//
-// 当队列已满时：日志将丢弃，框架不会阻塞调用线程。
-
-//
-
-
-         */
-        LogFile(const size_t &logQueue_cap=8192):logQueue(logQueue_cap)
-        {
-        consumerGuard=true;
-        consumerThread = std::thread([this]()->void
-        {
-            std::string content;
-            content.reserve(1024);
-            std::string time;
-            content.reserve(1074);
-            while(this->consumerGuard)
-            {
-                while(this->logQueue.pop(content))//非空则执行
-                {       
-                    getTime(time,timeFormat);
-                    time+=contentFormat;
-                    time+=content;
-                    this->appendLine(time);
-                }
-                std::this_thread::sleep_for(std::chrono::microseconds(500));
-
-            }
-        });
-        }
-        /**
-        * @brief 打开一个日志文件
-        * @note 不存在则创建（连带目录），默认新建的目录的权限为rwx rwx r-x，默认新建的日志文件权限为rw-，rw-，r--
-        * @param fileName 日志文件名（可以用绝对路径也可以用相对路径）
-        * @param timeFormat 日志文件中的时间格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
-        * @param contentFormat 日志文件中时间和记录之间的填充格式（默认为"   " 即四个空格）
-        * @return true：打开成功  false：打开失败
-        */
-        bool openFile(const std::string &fileName,const std::string &timeFormat=ISO8086A,const std::string &contentFormat="   ");
-        /**
-        * @brief 获取对象是否打开日志文件的状态
-        * @return true：打开了  false：没打开
-        */
-        bool isOpen(){return File::isOpen();}
-        /**
-        * @brief 获取对象打开的文件名
-        * @return 返回对象打开的文件名
-        */
-        std::string getFileName(){return File::getFileName();}
-        /**
-        * @brief 关闭对象打开的日志文件
-        * @param del true：关闭并且删除日志文件   false：只关闭不删除日志文件 （默认为false 即只关闭不删除日志文件）
-        * @return true：关闭成功  false：关闭失败
-        */
-        bool closeFile(const bool &del=false);
-        /**
-        * @brief 写一行日志
-        * @param data 需要写入的日志内容
-        */
-        void writeLog(const std::string &data);
-        /**
-        * @brief 清空所有日志
-        * @return true：写入成功  false：写入失败
-        */
-        bool clearLog();
-        /**
-        * @brief 删除指定时间区间内的日志
-        * @param date1 时间区间的第一个参数 （默认缺省为无限小）
-        * @param date2 时间区间的第二个参数  (默认缺省为无限大)
-        * @note 区间为[date1,date2)
-        * @return true：删除成功  false：删除失败
-        */
-        bool deleteLogByTime(const std::string &date1="1",const std::string &date2="2");
-        /**
-         * @brief 析构函数 写完日志 关闭消费者线程
-         */
-        ~LogFile();
-    };
-    }
-    /**
-    * @namespace stt::data
-    * @brief 数据处理
-    * @ingroup stt
-    */
-    namespace data
-    {
-        /**
-        * @brief 负责加密，解密和哈希
-        */
-        class CryptoUtil
-        {
-        public:
-            /**
-            * @brief  AES-256-CBC模式对称加密函数
-            * @param before 加密前的数据容器
-            * @param length 数据前的数据长度
-            * @param passwd 密钥
-            * @param iv iv向量
-            * @param after 密文的数据容器
-            * @return true：加密成功  false：加密失败
-            * @note  AES-256-CBC模式下 密钥为32字节 iv向量为16字节
-            */
-            static bool encryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after);
-            /**
-            * @brief AES-256-CBC模式对称解密函数
-            * @param before 密文的数据容器
-            * @param length 密文的数据长度
-            * @param passwd 密钥
-            * @param iv iv向量
-            * @param after 解密后的数据容器
-            * @return true：解密成功  false：解密失败
-            * @note  AES-256-CBC模式下 密钥为32字节 iv向量为16字节
-            */
-            static bool decryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after);
-            /**
-            * @brief 计算输入字符串的 SHA-1 哈希值（原始二进制形式）。
-            *
-            * 使用 OpenSSL 的 SHA1 函数对输入字符串进行哈希处理，结果以 20 字节的原始二进制形式存储在 result 中。
-            * 注意：result 可能包含不可打印字符，不适合直接输出或写入文本。
-            *
-            * @param ori_str 输入的原始字符串。
-            * @param result  用于存放输出的 SHA-1 哈希值（二进制形式），长度为 20 字节。
-            * @return 返回 result 的引用。
-            *
-            * @note 该函数适用于后续加密、签名等处理（例如用于 HMAC 的输入）。
-            */
-            static std::string& sha1(const std::string &ori_str,std::string &result);
-            /**
-            * @brief 计算输入字符串的 SHA-1 哈希值，并以十六进制字符串形式返回。
-            *
-            * 使用 OpenSSL 的 SHA1 函数对输入字符串进行哈希处理，结果以 40 个字符的十六进制格式表示存储在 result 中。
-            * 每个字节转换为两个十六进制字符，可直接用于打印、日志记录、存储等可读场景。
-            *
-            * @param ori_str 输入的原始字符串。
-            * @param result  用于存放输出的 SHA-1 哈希值（40 字节的十六进制字符串）。
-            * @return 返回 result 的引用。
-            *
-            * @note 适用于哈希显示、唯一标识、日志校验等场景。与 sha1 的主要区别是输出格式。
-            */
-	        static std::string& sha11(const std::string &ori_str,std::string &result);
-        };
-        /**
-        * @brief 负责二进制数据，字符串之间的转化
-        */
-        class BitUtil
-        {
-        public:
-            /**
-            * @brief 将单个字符转换为其对应的 8 位二进制字符串。
-            *
-            * @param input 输入的字符。
-            * @param result 用于保存输出的二进制字符串（例如 'A' -> "01000001"）。
-            * @return 返回 result 的引用。
-            */
-            static std::string& bitOutput(char input,std::string &result);
-            /**
-            * @brief 将字符串中的每个字符依次转换为二进制位，并拼接为一个整体字符串。
-            *
-            * @param input 输入字符串。
-            * @param result 保存输出的连续位字符串（长度为 input.size() * 8）。
-            * @return 返回 result 的引用。
-            */
-	        static std::string& bitOutput(const std::string &input,std::string &result);
-            /**
-            * @brief 获取字符 input 的从左向右第 pos 位（二进制）并返回 '1' 或 '0'。
-            *
-            * @param input 输入字符。
-            * @param pos 位位置（1~8，1 是最高位）。
-            * @param result 返回的位字符：'1' 或 '0'。
-            * @return 返回 result 的引用。
-            */
-	        static char& bitOutput_bit(char input,const int pos,char &result);
-            /**
-            * @brief 将 "01" 字符串（二进制字符串）转换为无符号整数。
-            *
-            * @param input 输入二进制字符串（如 "1011"）。
-            * @param result 输出结果数值。
-            * @return 返回 result 的引用。
-            */
-	        static unsigned long& bitStrToNumber(const std::string &input,unsigned long &result);
-            /**
-            * @brief 将字符串转换为二进制，再转换为对应数值。
-            *
-            * @param input 任意原始数据字符串。
-            * @param result 返回转换后的数值。
-            * @return 返回 result 的引用。
-            *
-            * @note 实际先调用 bitOutput 得到位串，再通过 bitStrToNumber 转换成整数。
-            */
-	        static unsigned long& bitToNumber(const std::string &input,unsigned long &result);
-            /**
-            * @brief 将最多 8 位的 "01" 字符串压缩成 1 个字节（char）。
-            *
-            * @param input 二进制字符串，最多 8 位。
-            * @param result 输出压缩后的字节。
-            * @return 返回 result 的引用。
-            */
-	        static char& toBit(const std::string &input,char &result);
-            /**
-            * @brief 将任意长度的 "01" 字符串压缩为二进制数据，每 8 位为一个字节。
-             *
-            * @param input 输入位串（长度应为 8 的倍数）。
-            * @param result 返回压缩后的二进制数据（每个字符代表 1 个字节）。
-            * @return 返回 result 的引用。
-            */
-	        static std::string& toBit(const std::string &input,std::string &result);
-        };
-        /**
-        * @brief 随机数，字符串生成相关
-        */
-        class RandomUtil
-        {
-        public:
-            /**
-            * @brief 生成一个随机整数
-            * @param 生成随机数的范围下限
-            * @param 生成随机数的范围上限
-            * @note 生成a-b范围的一个随机数
-            * @return 返回生成的一个随机数
-            */
-            static long getRandomNumber(const long &a,const long &b);
-            /**
-            * @brief 生成一个规定长度的“Base64 字符集内的伪随机字符串”，并在末尾用 '=' 补齐至符合 Base64 字符串格式
-            * @param str 保存生成字符串的容器
-            * @param length 需要生成的字符串的长度
-            * @return 返回str的引用
-            */
-            static std::string& getRandomStr_base64(std::string &str,const int &length);
-            /**
-            * @brief 生成一个 32 位（4 字节）的随机掩码。
-            *
-            * 该函数先随机生成一个由 '0' 和 '1' 组成的 32 位字符串（例如："010110..."），
-            * 然后通过内部的 `BitUtil::toBit()` 函数将其转换为对应的 4 字节二进制数据。
-            *
-            * 转换结果通过 mask 参数返回，通常用于生成数据包掩码、加密掩码、位图掩码等。
-            *
-            * @param mask 用于存放最终生成的 4 字节掩码（二进制字符串形式）。
-            * @return 返回 mask 的引用。
-            *
-            * @note 内部依赖函数 `BitUtil::toBit(const std::string&, std::string&)`，用于将 32 位二进制字符串压缩为 4 字节。
-            */
-            static std::string& generateMask_4(std::string &mask);
-        };
-        /**
-        * @brief 负责大小端字节序转换
-        */
-        class NetworkOrderUtil
-        {
-        public:
-            /**
-            * @brief 将 64 位无符号整数的字节序反转（大端 <-> 小端）。
-            *
-            * 该函数模拟 `htonl`/`ntohl` 的 64 位版本，即按字节交换实现高低位互换。
-            * 原地修改参数并返回引用。
-            *
-            * @param data 输入的 64 位无符号整数，按字节反转后返回。
-            * @return 反转后的 data 引用。
-            *
-            * @note 该实现不依赖平台库函数，适用于不确定机器端序的场景。
-            */
-            static unsigned long& htonl_ntohl_64(unsigned long &data);//64位无符号数转化为大/小端序（网络字节序）
-        };
-        
-        /**
-        * @brief 负责浮点数精度处理
-        */
-        class PrecisionUtil
-        {
-        public:
-        
-            /**
-            * @brief 将浮点数格式化为指定小数位数的字符串表示。
-            * 
-            * @param number 输入的浮点数。
-            * @param bit 保留的小数位数。
-            * @param str 用于存储格式化后的字符串。
-            * @return 格式化结果字符串的引用。
-            */
-	        static std::string& getPreciesFloat(const float &number,const int &bit,std::string &str);
-            /**
-            * @brief 将 float 数值保留指定位数的小数，并直接修改原值。
-            *
-            * @param number 待处理的 float 变量（将被修改）。
-            * @param bit 保留的小数位数。
-            * @return 修改后的 float 引用。
-            */
-            static float& getPreciesFloat(float &number,const int &bit);
-            /**
-            * @brief 将双精度浮点数格式化为指定小数位数的字符串表示。
-            *
-            * @param number 输入的 double 数值。
-            * @param bit 保留的小数位数。
-            * @param str 用于存储格式化后的字符串。
-            * @return 格式化结果字符串的引用。
-            */
-            static std::string& getPreciesDouble(const double &number,const int &bit,std::string &str);
-            /**
-            * @brief 将 double 数值保留指定位数的小数，并直接修改原值。
-            *
-            * @param number 待处理的 double 变量（将被修改）。
-            * @param bit 保留的小数位数。
-            * @return 修改后的 double 引用。
-            */
-            static double& getPreciesDouble(double &number,const int &bit);
-            /**
-            * @brief 根据数值动态调整小数精度，保留指定数量的有效数字。
-            *
-            * 对于小于 1 的小数，会先确定其最前位有效数字所处的位置，
-            * 然后在此基础上保留 bit 位有效数字。
-            * 修改后的数值将四舍五入保留合适的小数位，并写回原变量。
-            *
-            * @param number 待处理的 float 数值（将被修改）。
-            * @param bit 希望保留的有效数字位数。
-            * @return 修改后的 float 引用。
-            */
-            static float& getValidFloat(float &number,const int &bit);
-        };
-        /**
-        * @brief 负责Http字符串和URL解析
-        * 包括从 URL 或请求报文中提取参数、IP、端口、请求头字段等功能。
-        */
-        class HttpStringUtil
-        {
-        public:
-            /**
-            * @brief 从原始字符串中提取两个标记之间的子串。
-            *
-            * 提取从 a 到 b 之间的内容（不包含 a 和 b），可指定起始搜索位置。
-            * 若 a 或 b 为空字符串，则分别表示从头或到尾。
-            * 若a找不到，则默认从头开始
-            * 若b找不到，则默认到尾
-            *
-            * @param ori_str 原始字符串。
-            * @param str 存储提取结果的字符串。
-            * @param a 起始标记字符串。
-            * @param b 终止标记字符串。
-            * @param pos 搜索起始位置。
-            * @return 返回b在ori_str中的位置(可能返回string::npos,如果b找不到或者b为"")
-            * @note 如果找不到，结果字符串为""
-            */       
-	        static size_t get_split_str(const std::string_view& ori_str,std::string_view &str,const std::string_view &a,const std::string_view &b,const size_t &pos=0);
-            /**
-            * @brief 从 URL 查询参数中提取指定 key 的值。
-            *
-            * @note url不需要完整也行 例如从 `?id=123&name=abc`提取 `id` 的值和从`http://xxxx/?id=123&name=abc`提取 `id` 的值是一样的。
-            *
-            * @param ori_str 原始 URL 字符串。
-            * @param str 存储提取结果的字符串。
-            * @param name 参数名（key）。
-            * @return 引用，指向结果字符串。
-            */
-	        static std::string_view& get_value_str(const std::string_view& ori_str,std::string_view &str,const std::string& name);
-            /**
-            * @brief 从 HTTP 请求头中提取指定字段的值。
-            *
-            * @param ori_str 原始 HTTP 请求头字符串。
-            * @param str 提取结果。
-            * @param name 请求头字段名（如 "Host"）。
-            * @return 引用，指向结果字符串。
-            */
-	        static std::string_view& get_value_header(const std::string_view& ori_str,std::string_view &str,const std::string& name);
-            /**
-            * @brief 提取 URL 中 path 和 query 部分。
-            *
-            * 例如从 `http://abc.com/path?query=123` 或者从/path?query=123 提取 `/path`。
-            *
-            * @param ori_str 原始 URL。
-            * @param str 返回 path 部分。
-            * @return 引用，指向结果字符串。
-            */
-	        static std::string_view& get_location_str(const std::string_view& ori_str,std::string_view &str);
-            /**
-            * @brief 提取 URL 的 path 部分（不含 query）。
-            *
-            * 与 `get_location_str` 类似，但保留 path 之后的所有内容（如参数）。
-            *
-            * @param URL。
-            * @param locPara 返回 path+参数部分。
-            * @return 引用，指向结果字符串。
-            */
-            static std::string_view& getLocPara(const std::string_view &url,std::string_view &locPara);
-            /**
-            * @brief 获取 URL 中的查询参数字符串（包括 ?）。
-            * @note 可以是完整url 也可以是不太完整的，比如/path?id=123&name=abc
-            *
-            * @param URL。
-            * @param para 返回参数部分（形如 "?id=123&name=abc"）。
-            * @return 引用，指向结果字符串。
-            */
-            static std::string_view& getPara(const std::string_view &url,std::string_view &para);
-
-
-            /**
-            * @brief 从原始字符串中提取两个标记之间的子串。
-            *
-            * 提取从 a 到 b 之间的内容（不包含 a 和 b），可指定起始搜索位置。
-            * 若 a 或 b 为空字符串，则分别表示从头或到尾。
-            * 若a找不到，则默认从头开始
-            * 若b找不到，则默认到尾
-            *
-            * @param ori_str 原始字符串。
-            * @param str 存储提取结果的字符串。
-            * @param a 起始标记字符串。
-            * @param b 终止标记字符串。
-            * @param pos 搜索起始位置。
-            * @return 返回b在ori_str中的位置(可能返回string::npos,如果b找不到或者b为"")
-            * @note 如果找不到，结果字符串为""
-            */       
-	        static size_t get_split_str(const std::string_view& ori_str,std::string &str,const std::string_view &a,const std::string_view &b,const size_t &pos=0);
-            /**
-            * @brief 从 URL 查询参数中提取指定 key 的值。
-            *
-            * @note url不需要完整也行 例如从 `?id=123&name=abc`提取 `id` 的值和从`http://xxxx/?id=123&name=abc`提取 `id` 的值是一样的。
-            *
-            * @param ori_str 原始 URL 字符串。
-            * @param str 存储提取结果的字符串。
-            * @param name 参数名（key）。
-            * @return 引用，指向结果字符串。
-            */
-	        static std::string& get_value_str(const std::string& ori_str,std::string &str,const std::string& name);
-            /**
-            * @brief 从 HTTP 请求头中提取指定字段的值。
-            *
-            * @param ori_str 原始 HTTP 请求头字符串。
-            * @param str 提取结果。
-            * @param name 请求头字段名（如 "Host"）。
-            * @return 引用，指向结果字符串。
-            */
-	        static std::string& get_value_header(const std::string& ori_str,std::string &str,const std::string& name);
-            /**
-            * @brief 提取 URL 中 path 和 query 部分。
-            *
-            * 例如从 `http://abc.com/path?query=123` 或者从/path?query=123 提取 `/path`。
-            *
-            * @param ori_str 原始 URL。
-            * @param str 返回 path 部分。
-            * @return 引用，指向结果字符串。
-            */
-	        static std::string& get_location_str(const std::string& ori_str,std::string &str);
-            /**
-            * @brief 提取 URL 的 path 部分（不含 query）。
-            *
-            * 与 `get_location_str` 类似，但保留 path 之后的所有内容（如参数）。
-            *
-            * @param URL。
-            * @param locPara 返回 path+参数部分。
-            * @return 引用，指向结果字符串。
-            */
-            static std::string& getLocPara(const std::string &url,std::string &locPara);
-            /**
-            * @brief 获取 URL 中的查询参数字符串（包括 ?）。
-            * @note 可以是完整url 也可以是不太完整的，比如/path?id=123&name=abc
-            *
-            * @param URL。
-            * @param para 返回参数部分（形如 "?id=123&name=abc"）。
-            * @return 引用，指向结果字符串。
-            */
-            static std::string& getPara(const std::string &url,std::string &para);
-            /**
-            * @brief 从 URL 中提取主机 IP 或域名。
-            *
-            * 例如从 `http://127.0.0.1:8080/` 提取 `127.0.0.1`。
-            *
-            * @warning url必须完整而且显式指明端口
-            * @param url 完整 URL。
-            * @param IP 存储提取的 IP 或域名。
-            * @return 引用，指向结果字符串。
-            */
-            static std::string& getIP(const std::string &url,std::string &IP);
-            /**
-             * @brief 从 URL 中提取端口号。
-            *
-             * 例如从 `http://127.0.0.1:8080/` 中提取 8080。
-            *
-            * @warning 必须是完整的url，而且必须显式指定端口 还有路径 就算路径没有 也要写个/
-            * @param url 完整 URL。
-            * @param port 存储解析出的端口号。
-            * @return 引用，指向端口号。
-            */
-            static int& getPort(const std::string &url,int &port);
-            /**
-            * @brief 创建一个 HTTP 请求头字段字符串。
-            *
-            * 该函数构造格式为 `字段名: 字段值\r\n` 的字符串。
-            *
-            * @param first 第一个字段名。
-            * @param second 第一个字段值。
-            * @return 构造的单条 HTTP 请求头字符串。
-            */
-            static std::string createHeader(const std::string& first,const std::string& second);
-            /**
-            * @brief 递归构造多个 HTTP 请求头字段。
-            *
-            * 支持多个字段名和值的构造，用法为：
-            * @code
-            * std::string headers = createHeader("Host", "example.com", "Connection", "keep-alive,"Content-Type","charset=UTF-8");
-            * @endcode
-            * 最终生成：
-            * @code
-            * Host: example.com\r\n
-            * Connection: keep-alive\r\n
-            * Content-Type: charset=UTF-8\r\n
-            * @endcode
-            *
-            * @param Args 其余参数，需以 (字段名, 字段值) 成对传入。
-            * @param first 当前字段名。
-            * @param second 当前字段值。
-            * @param args 后续的字段名和值（必须为偶数个）。
-            * @return 构造的完整 HTTP 请求头字符串。
-            */
-	        template<class... Args>
-	        static std::string createHeader(const std::string& first,const std::string& second,Args... args)
-	        {
-		        std::string cf=first+": "+second+"\r\n"+createHeader(args...);
-		        return cf;
-	        }
-        };
-        /**
-        * @brief 负责websocket协议有关字符串的操作
-        */
-        class WebsocketStringUtil
-        {
-        public:
-            /**
-            * @brief 生成 WebSocket 握手响应中的 Sec-WebSocket-Accept 字段值。
-            *
-            * 该函数基于客户端提供的 Sec-WebSocket-Key，拼接 WebSocket 指定的魔法 GUID，
-            * 再进行 SHA-1 哈希与 Base64 编码，得到握手响应所需的 accept 字符串。
-            *
-            * @param str 输入为客户端提供的 Sec-WebSocket-Key，会被原地修改为结果字符串（Sec-WebSocket-Accept）。
-            * @return 引用返回修改后的 str。
-            *
-            * @note 实现参考 RFC 6455 第 4.2.2 节握手过程。
-            */
-            static std::string& transfer_websocket_key(std::string &str);
-        };
-        /**
-        * @brief 负责字符串和数字的转化
-        */
-        class NumberStringConvertUtil
-        {
-        public:
-            /**
-            * @brief string转化为int类型
-            * @note 不会抛出异常
-            * @param ori_str 原始string类型数据
-            * @param result 存放结果的int容器
-            * @param i 如果转化失败 则把result赋值为i(默认为-1)
-            * @return result的引用
-            */
-	        static int& toInt(const std::string_view&ori_str,int &result,const int &i=-1);
-            /**
-            * @brief 16进制数字的字符串表示转化为10进制int类型数字
-            * @param ori_str 16进制数字的字符串表示
-            * @param result 保存转化结果的int容器
-            * @return 返回result的引用
-            */
-            static int& str16toInt(const std::string_view&ori_str,int &result,const int &i=-1);
-            /**
-            * @brief string转化为long类型
-            * @note 不会抛出异常
-            * @param ori_str 原始string类型数据
-            * @param result 存放结果的long容器
-            * @param i 如果转化失败 则把result赋值为i(默认为-1)
-            * @return result的引用
-            */
-	        static long& toLong(const std::string_view&ori_str,long &result,const long &i=-1);
-            /**
-            * @brief string转化为float类型
-            * @note 不会抛出异常
-            * @param ori_str 原始string类型数据
-            * @param result 存放结果的float容器
-            * @param i 如果转化失败 则把result赋值为i(默认为-1)
-            * @return result的引用
-            */
-	        static float& toFloat(const std::string&ori_str,float &result,const float &i=-1);
-            /**
-            * @brief string转化为double类型
-            * @note 不会抛出异常
-            * @param ori_str 原始string类型数据
-            * @param result 存放结果的double容器
-            * @param i 如果转化失败 则把result赋值为i(默认为-1)
-            * @return result的引用
-            */
-	        static double& toDouble(const std::string&ori_str,double &result,const double &i=-1);
-            /**
-            * @brief string转化为bool类型
-            * @note 不会抛出异常，true或者True，TRUE返回true，否则返回false
-            * @param ori_str 原始string类型数据
-            * @param result 存放结果的bool容器
-            * @return result的引用
-            */
-	        static bool& toBool(const std::string_view&ori_str,bool &result);
-            /**
-            * @brief 将普通字符串转化为对应的十六进制表示字符串（hex string）。
-             *
-            * 例如输入 "ABC" 会被转化为 "414243"，每个字符转换为其 ASCII 的十六进制形式。
-            *
-            * @param ori_str 输入的原始字符串（可以包含任意字符，包括不可见字符）。
-            * @param result 存放转换后结果的字符串引用。
-            * @return 转换后的十六进制字符串 result 的引用。
-            * @bug 有bug待修复
-            */
-            static std::string& strto16(const std::string &ori_str,std::string &result);//字符串转化为16进制字符串     (暂不需要)(待修复)
-        };
-        /**
-        * @brief 数据编码解码，掩码处理等
-        */
-        class EncodingUtil
-        {
-        public:
-            /**
-            * @brief 对字符串进行 Base64 编码。
-            *
-            * 使用 OpenSSL 的 BIO 接口对给定字符串进行 Base64 编码，编码过程中不会插入换行符。
-            *
-            * @param input 要编码的原始字符串（可以包含任意二进制数据）。
-            * @return 编码后的 Base64 字符串。
-            */
-            static std::string base64_encode(const std::string &input);
-            /**
-            * @brief 对 Base64 编码的字符串进行解码。
-            *
-            * 使用 OpenSSL 的 BIO 接口对 Base64 字符串进行解码。该函数不接受带换行符的 Base64 字符串。
-            *
-            * @param input Base64 编码的字符串。
-            * @return 解码后的原始字符串。
-            */
-	        static std::string base64_decode(const std::string &input);
-            /**
-            * @brief 生成 WebSocket 握手响应中的 Sec-WebSocket-Accept 字段值。
-            *
-            * 该函数基于客户端提供的 Sec-WebSocket-Key，拼接 WebSocket 指定的魔法 GUID，
-            * 再进行 SHA-1 哈希与 Base64 编码，得到握手响应所需的 accept 字符串。
-            *
-            * @param str 输入为客户端提供的 Sec-WebSocket-Key，会被原地修改为结果字符串（Sec-WebSocket-Accept）。
-            * @return 引用返回修改后的 str。
-            *
-            * @note 实现参考 RFC 6455 第 4.2.2 节握手过程。
-            */
-	        static std::string& transfer_websocket_key(std::string &str);
-            /**
-            * @brief 生成一个 32 位（4 字节）的随机掩码。
-            *
-            * 该函数先随机生成一个由 '0' 和 '1' 组成的 32 位字符串（例如："010110..."），
-            * 然后通过内部的 `BitUtil::toBit()` 函数将其转换为对应的 4 字节二进制数据。
-            *
-            * 转换结果通过 mask 参数返回，通常用于生成数据包掩码、加密掩码、位图掩码等。
-            *
-            * @param mask 用于存放最终生成的 4 字节掩码（二进制字符串形式）。
-            * @return 返回 mask 的引用。
-            *
-            * @note 内部依赖函数 `BitUtil::toBit(const std::string&, std::string&)`，用于将 32 位二进制字符串压缩为 4 字节。
-            */
-            static std::string& generateMask_4(std::string &mask);
-            /**
-            * @brief 使用给定的 4 字节掩码对字符串进行异或操作（XOR Masking）。
-            *
-            * 此函数对输入字符串 data 的每个字节，按顺序与 mask 中的 4 字节循环异或。
-            * 该操作是可逆的，可用于加密或解密 WebSocket 中的掩码数据帧。
-            *
-            * @param data 要进行异或处理的数据字符串，处理结果会直接修改该字符串。
-            * @param mask 用作掩码的字符串，通常应为至少 4 字节。
-            * @return 引用，指向处理后的 data 字符串。
-            */
-	        static std::string& maskCalculate(std::string &data,const std::string &mask);
-        };
-        /**
-        * @brief json数据操作类
-        */
-        class JsonHelper
-        {
-            public:
-            /**
-            * @brief 提取 JSON 字符串中指定字段的值或嵌套结构。
-            * 
-            * @param oriStr 原始 JSON 字符串。
-            * @param result 存储返回值的字符串引用。
-            * @param type 类型模式，可选值：value, arrayvalue。分别为普通json对象里面的值，数组对象里面的值。
-            * @param name JSON 中的键名（仅适用于 value）。
-            * @param num 数组索引位置(从0开始)（仅适用于 arrayvalue）。
-            * @return -1:提取失败
-            *          0:返回非json对象
-            *          1:返回json对象
-            */
-	        static int getValue(const std::string &oriStr,std::string& result,const std::string &type="value",const std::string &name="a",const int &num=0);
-
-            /**
-            * @brief 将 Json::Value 转换为字符串。
-            * @param val JSON 值。
-            * @return std::string 字符串形式的值。
-            */
-            static std::string toString(const Json::Value &val);
-            /**
-            * @brief 解析 JSON 字符串为 Json::Value。
-            * @param str 输入的 JSON 字符串。
-            * @return Json::Value 解析后的 JSON 对象或数组。
-            */
-	        static Json::Value toJsonArray(const std::string & str);
-            /**
-            * @brief 创建仅包含一个键值对的 JSON 字符串。
-            * 
-            * @param T1 键的类型，通常为 std::string。
-            * @param T2 值的类型，可为任意可被 Json::Value 接收的类型。
-            * @param first 键。
-            * @param second 值。
-            * @return std::string JSON 字符串。
-            */
-            template<class T1,class T2>
-	        static std::string createJson(T1 first,T2 second)
-	        {
-		        Json::Value root;
-		        //root[first]=second;
-                if constexpr (std::is_integral_v<T2>) {
-                    root[first] = Json::Value(static_cast<Json::Int64>(second));
-                } else {
-                    root[first] = second;
-                }
-		        Json::StreamWriterBuilder builder;
-		        std::string jsonString=Json::writeString(builder,root);
-		        return jsonString;
-	        }
-            /**
-            * @brief 创建多个键值对组成的 JSON 字符串（递归变参模板）。
-            * 
-            * @param T1 第一个键的类型。
-            * @param T2 第一个值的类型。
-            * @param Args 其余成对出现的键值参数。
-            * @param first 第一个键。
-            * @param second 第一个值。
-            * @param args 其余键值参数。
-            * @return std::string 拼接完成的 JSON 字符串。
-            */
-             template<class T1,class T2,class... Args>
-	        static std::string createJson(T1 first,T2 second,Args... args)
-	        {
-		        Json::Value root;
-		        //root[first]=second;
-                if constexpr (std::is_integral_v<T2>) {
-                    root[first] = Json::Value(static_cast<Json::Int64>(second));
-                } else {
-                    root[first] = second;
-                }
-		        std::string kk=createJson(args...);
-		        Json::StreamWriterBuilder builder;
-		        std::string jsonString=Json::writeString(builder,root);
-		        jsonString=jsonString.erase(jsonString.length()-2);
-		        kk=kk.substr(1);
-		        return jsonString+","+kk;
-
-	        }
-            /**
-            * @brief 创建只包含一个元素的 JSON 数组字符串。
-            * 
-            * @param T 任意类型。
-            * @param first 第一个元素。
-            * @return std::string JSON 数组字符串。
-            */
-	        template<class T>
-	        static std::string createArray(T first)
-	        {
-		        Json::Value root(Json::arrayValue);
-		        root.append(first);
-		        Json::StreamWriterBuilder builder;
-		        std::string jsonString=Json::writeString(builder,root);
-		        return jsonString;
-	        }
-            /**
-            * @brief 创建多个元素组成的 JSON 数组字符串（递归变参模板）。
-            * 
-            * @param T 第一个元素类型。
-            * @param Args 其余元素类型。
-            * @param first 第一个元素。
-            * @param args 其余元素。
-            * @return std::string 拼接完成的 JSON 数组字符串。
-            */
-            template<class T,class... Args>
-	        static std::string createArray(T first,Args... args)
-	        {
-		        Json::Value root(Json::arrayValue);
-		        root.append(first);
-		        std::string kk=createArray(args...);
-		        Json::StreamWriterBuilder builder;
-		        std::string jsonString=Json::writeString(builder,root);
-		        jsonString=jsonString.erase(jsonString.length()-2);
-		        kk=kk.substr(1);
-		        return jsonString+","+kk;
-
-	        }
-            /**
-            * @brief 将两个 JSON 字符串拼接为一个有效的 JSON（适用于对象或数组拼接）。
-            * @param a 第一个 JSON 字符串。
-            * @param b 第二个 JSON 字符串。
-            * @return std::string 拼接后的 JSON 字符串。
-            */
-            static std::string jsonAdd(const std::string &a,const std::string &b);
-             /**
-            * @brief 将格式化后的 JSON 字符串去除缩进、空格等变成紧凑格式。
-            * @param a 输入的 JSON 字符串。
-            * @param b 存储格式化结果的引用。
-            * @return std::string& 紧凑格式的字符串引用。
-            */
-            static std::string& jsonFormatify(const std::string &a,std::string &b);
-            /**
-            * @brief 将 JSON 字符串中的 \uXXXX 转换为 UTF-8 字符。
-            * @param input 含有 Unicode 编码的 JSON 字符串。
-            * @param output 存储转换后字符串的引用。
-            * @return std::string& 返回转换后的字符串引用。
-            */
-            static std::string& jsonToUTF8(const std::string &input,std::string &output);
-        };
-    }
-
-    /**
-    * @brief 涉及信息安全的api
-    */
-    namespace security
-    {
-    /**
-     * @enum RateLimitType
-     * @brief 限流算法类型（策略）。
-     *
-     * 每种策略的“语义”不同，选择时请按业务/攻击模型匹配：
-     *
-     * @par 1) Cooldown（连续触发惩罚 / 冷却限流）
-     * - @b 规则：在 secs 时间内累计达到 times 次后，后续请求全部拒绝，直到“安静”满 secs 后才恢复。
-     * - @b 特性：对持续刷/爆破非常狠；对正常用户的“短时间突发”不友好（可能需要完全停一段时间才能恢复）。
-     * - @b 适用：
-     *   - 建连防爆破（connect）
-     *   - 登录失败次数惩罚（fail-based 可用同思路扩展）
-     *   - 防脚本快速重试
-     * - @b 不适用：
-     *   - 正常会出现突发但希望“自然恢复”的接口（例如页面加载产生的突发 HTTP 请求）
-     *
-     * @par 2) FixedWindow（固定窗口计数）
-     * - @b 规则：以某个窗口起点为基准，每 secs 秒为一个窗口；窗口内最多 times 次，超出拒绝；窗口结束时计数清零。
-     * - @b 特性：实现简单、开销小；存在“窗口边界突刺”（在窗口交界处可能短时间放行较多）。
-     * - @b 适用：
-     *   - 低风险、要求简单的限流
-     *   - 统计口径清晰的“每 N 秒最多 M 次”
-     * - @b 不适用：
-     *   - 对抗性强的场景（容易被边界行为利用）
-     *
-     * @par 3) SlidingWindow（滑动窗口 / 时间戳队列）
-     * - @b 规则：在任意时刻 now，统计 (now-secs, now] 区间内发生的次数；若 >= times 则拒绝。
-     * - @b 特性：比 FixedWindow 更公平、无窗口边界突刺；需要维护时间戳队列（开销略高）。
-     * - @b 适用：
-     *   - 对外 HTTP API、用户操作等希望公平且稳定的限流
-     *   - path 级别的关键接口（如 /login /register）
-     * - @b 不适用：
-     *   - 极高 QPS 且每个 key(times) 很大、又不愿意付出队列内存/维护成本的场景（可用近似桶）
-     *
-     * @par 4) TokenBucket（令牌桶）
-     * - @b 规则（常见语义）：令牌按固定速率补充；每次请求消耗 1 令牌；无令牌则拒绝。
-     *   在本类接口里通过 (times, secs) 表达：平均速率约为 times/secs，桶容量通常与 times 同级（实现可按需要定义）。
-     * - @b 特性：允许突发（桶里有存量时可瞬间放行一批），同时限制长期平均速率；工程上最常用。
-     * - @b 适用：
-     *   - 请求流量整形（允许短突发但控制长期平均）
-     *   - IM 消息、HTTP 请求等“既不想太硬也不想太松”的场景
-     * - @b 不适用：
-     *   - 你想要“打满后必须停一段时间”的强惩罚需求（那是 Cooldown）
-     */
-        enum class RateLimitType 
-        {
-            Cooldown,      // 连续触发惩罚：达到上限后进入冷却，需要安静 secs 才恢复
-            FixedWindow,   // 固定窗口计数：每 secs 一个窗口，窗口内最多 times 次
-            SlidingWindow, // 滑动窗口：统计最近 secs 内的次数（队列时间戳）
-            TokenBucket    // 令牌桶：允许突发 + 控制长期平均速率（常用于 API/消息）
-        };
-    /**
- * @struct RateState
- * @brief 单一限流器的运行状态（可复用于多种限流策略）。
- *
- * @details
- * 该结构用于记录某个限流维度（IP / fd / path 等）的实时状态，
- * 会被不同限流算法复用：
- *
- * - Cooldown / FixedWindow：
- *   - 使用 counter + lastTime
- * - SlidingWindow：
- *   - 使用 history（时间戳队列）
- * - TokenBucket：
- *   - 使用 tokens + lastRefill
- *
- * @note
- * - violations 用于记录“被拒绝”的次数，是防御升级（DROP / CLOSE / 封禁）的依据
- * - RateState 本身不做任何决策，只负责记录状态
- */
-        struct RateState
-        {
-            // 通用
-            int counter = 0;
-            int violations = 0;   // 新增：触发限流的次数
-            std::chrono::steady_clock::time_point lastTime{};
-
-            // SlidingWindow
-            std::deque<std::chrono::steady_clock::time_point> history;
-
-            // TokenBucket
-            double tokens = 0.0;
-            std::chrono::steady_clock::time_point lastRefill{};
-        };
-        /**
- * @struct ConnectionState
- * @brief 单个连接（fd）的安全与限流状态。
- *
- * @details
- * 每个成功通过 allowConnect 的 fd 都会拥有一个 ConnectionState，
- * 用于实现“连接级（fd 级）”防御：
- *
- * - requestRate：该连接的整体请求速率限制
- * - pathRate：该连接在不同 path 下的额外限流状态
- * - lastActivity：该连接最后一次活动时间（用于僵尸连接检测）
- *
- * @note
- * - 一个 IP 可以对应多个 ConnectionState
- * - 断连时必须清理对应的 ConnectionState
- */
-        struct ConnectionState
-        {
-            int fd = -1;
-            RateState requestRate;
-            std::unordered_map<std::string, RateState> pathRate;
-            std::chrono::steady_clock::time_point lastActivity{};
-        };
-        /**
- * @struct IPInformation
- * @brief 单个 IP 的安全状态与连接集合。
- *
- * @details
- * IPInformation 是 ConnectionLimiter 的核心状态单元，
- * 用于实现“IP 级 + fd 级”的分层防御模型：
- *
- * - activeConnections：当前 IP 已建立的并发连接数
- * - connectRate：IP 级建连速率限制状态
- * - badScore：IP 风险评分（多次恶意行为会累积）
- * - conns：该 IP 下所有活动连接（fd -> ConnectionState）
- *
- * @par 防御语义
- * - activeConnections / connectRate：
- *   - 用于防止建连洪水、爆破
- * - badScore：
- *   - 用于升级防御策略（断连 / 临时封禁 IP）
- *
- * @note
- * - IP 的黑名单（封禁时间）通常由 ConnectionLimiter 统一维护
- * - badScore 可随时间衰减或在封禁后重置
- */
-        struct IPInformation
-        {
-            int activeConnections = 0;
-            RateState connectRate;
-            int badScore = 0; //IP 风险评分（用于升级惩罚）
-            std::unordered_map<int, ConnectionState> conns; // fd -> state
-        };
-        /**
- * @enum DefenseDecision
- * @brief 安全裁决结果（由 ConnectionLimiter 返回）。
- *
- * @details
- * 所有连接 / 请求在进入业务处理前，都会经过 ConnectionLimiter 的判定，
- * 并返回以下三种裁决之一：
- *
- * - ALLOW (0)：
- *   - 正常通过，继续处理
- * - DROP (1)：
- *   - 无视该请求（不回应、不处理）
- *   - 主要用于 request 阶段的轻度防御
- * - CLOSE (2)：
- *   - 立即断开连接
- *   - 可伴随 IP 风险升级或临时封禁
- *
- * @note
- * - connect 阶段通常只使用 ALLOW / CLOSE
- * - DROP 主要用于 request 阶段（fd 已存在时）
- */
-        enum DefenseDecision : int
-        {
-            ALLOW = 0,  // 正常通过
-            DROP  = 1,  // 不回应（丢弃）
-            CLOSE = 2   // 断连（可伴随封 IP）
-        };
-    
-        /**
- * @class ConnectionLimiter
- * @brief 统一的连接与请求安全裁决器（IP 级 + fd 级，多策略限流 + 黑名单）。
- *
- * @details
- * ConnectionLimiter 是一个“安全门（Security Gate）”，
- * 所有连接建立与请求处理在进入业务逻辑前，都必须经过该类的裁决。
- *
- * 本类不直接执行业务行为（如 close / send / sleep），
- * 而是返回一个 @ref DefenseDecision 结果，由外层统一执行。
- *
- * ---
- * @section design_overview 设计概览
- *
- * 本类实现的是一个分层防御模型：
- *
- * - IP 级防御：
- *   - 并发连接数限制（maxConnections）
- *   - 建连速率限制（connectRate）
- *   - IP 风险评分（badScore）
- *   - 临时黑名单（blacklist，带 TTL）
- *
- * - fd 级防御：
- *   - 请求速率限制（requestRate）
- *   - path 级额外限流（pathRate）
- *   - 连接活动时间记录（lastActivity）
- *
- * ---
- * @section defense_decision 防御裁决语义
- *
- * allowConnect / allowRequest 的返回值为 @ref DefenseDecision：
- *
- * - ALLOW (0)：
- *   - 允许继续处理
- *
- * - DROP (1)：
- *   - 无视本次请求（不回应、不处理）
- *   - 主要用于 request 阶段的轻度防御
- *
- * - CLOSE (2)：
- *   - 立即断开连接
- *   - 可伴随 IP 风险升级或临时封禁
- *
- * @note
- * - connect 阶段由于 TCP 连接已建立，通常只使用 ALLOW / CLOSE
- * - DROP 主要用于 request 阶段（fd 已存在时）
- *
- * ---
- * @section rate_limit 策略与限流
- *
- * 本类支持多种限流策略（见 @ref RateLimitType）：
- *
- * - Cooldown
- * - FixedWindow
- * - SlidingWindow
- * - TokenBucket
- *
- * 不同维度使用不同策略：
- *
- * - 建连速率：connectStrategy（默认 Cooldown）
- * - fd 级请求速率：requestStrategy（默认 SlidingWindow）
- * - path 级请求速率：pathStrategy（默认 SlidingWindow）
- *
- * ---
- * @section thread_safety 线程安全
- *
- * @warning
- * 本类本身不包含锁：
- * - table / pathConfig / blacklist 的并发安全
- *   需由上层保证（如事件循环线程、外部互斥锁等）。
- *
- * ---
- * @section lifecycle 生命周期说明
- *
- * - allowConnect：
- *   - 判断 IP 是否允许进入应用层
- *   - 在 ALLOW 时登记 fd
- *
- * - allowRequest：
- *   - 对已登记 fd 进行请求裁决
- *
- * - clearIP：
- *   - 在连接关闭时调用，回收 fd 与并发计数
- *
- * - connectionDetect：
- *   - 用于检测并清理长时间无活动的僵尸连接
- */
-        class ConnectionLimiter
-        {
-        public:
-        /**
-         * @brief 构造函数。
-         *
-         * @param maxConn 同一 IP 允许的最大并发连接数（activeConnections 上限）。
-         * @param idleTimeout 连接僵尸检测超时时间（秒）。若 < 0 表示不做僵尸检测。
-         */
-            ConnectionLimiter(const int& maxConn = 20, const int& idleTimeout = 60) : maxConnections(maxConn),connectionTimeout(idleTimeout){}
-
-            // ========== 策略设置 ==========
-        /**
-         * @brief 设置“连接速率限流”所使用的策略。
-         *
-         * @param type 策略类型，见 @ref RateLimitType 说明。
-         * @note 不调用本函数时，默认策略为 @ref RateLimitType::Cooldown 。
-         */
-            void setConnectStrategy(const RateLimitType &type);
-        /**
-         * @brief 设置“IP 级请求限流”所使用的策略。
-         *
-         * @param type 策略类型，见 @ref RateLimitType 说明。
-         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
-         */
-            void setRequestStrategy(const RateLimitType &type);
-        /**
-         * @brief 设置“path 级请求限流”所使用的策略。
-         *
-         * @param type 策略类型，见 @ref RateLimitType 说明。
-         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
-         */
-            void setPathStrategy(const RateLimitType &type);
-
-            // ========== Path 配置 ==========
-        /**
-         * @brief 设置某个路径的额外限流规则（path 级）。
-         *
-         * @param path 需要额外限流的路径，例如 "/login"、"/register"。
-         * @param times 在 secs 秒内允许的最大请求次数。
-         * @param secs 统计窗口长度（秒）。
-         *
-         * @note setPathLimit 配置的是 @b 额外规则：
-         * - allowRequest 调用时传入的 (times, secs) 仍然会作为 IP 级规则先执行；
-         * - 若 path 命中此配置，则再执行 path 级规则；
-         * - 两者为 AND 关系：任何一层失败即拒绝。
-         */
-            void setPathLimit(const std::string &path, const int &times, const int &secs);
-
-            // ========== 核心判断 ==========
-        /**
-     * @brief 对新建立的连接进行安全裁决（IP 级）。
-     *
-     * @param ip 对端 IP 地址。
-     * @param fd 新 accept 得到的文件描述符。
-     * @param times 在 secs 秒内允许的最大建连次数。
-     * @param secs 建连速率统计窗口（秒）。
-     *
-     * @return DefenseDecision
-     * - ALLOW：允许该连接进入应用层（fd 将被登记）
-     * - CLOSE：拒绝并应立即断开连接
-     *
-     * @note
-     * - connect 阶段通常不使用 DROP
-     * - 若命中黑名单或高风险状态，将直接返回 CLOSE
-     */
-            DefenseDecision allowConnect(const std::string &ip, const int &fd,const int &times, const int &secs);
-        /**
-     * @brief 对已建立连接的一次请求进行安全裁决。
-     *
-     * @param ip 对端 IP 地址。
-     * @param fd 当前请求对应的文件描述符。
-     * @param path 请求路径（用于 path 级限流）。
-     * @param times fd 级请求速率上限。
-     * @param secs 请求速率统计窗口（秒）。
-     *
-     * @return DefenseDecision
-     * - ALLOW：正常处理请求
-     * - DROP：无视本次请求（不回应）
-     * - CLOSE：断开连接
-     */
-            DefenseDecision allowRequest(const std::string &ip,const int &fd,const std::string_view &path,const int &times,const int &secs);
-
-            // ========== 生命周期 ==========
-        /**
-     * @brief 在连接断开时回收对应 fd 的状态。
-     *
-     * @param ip 对端 IP 地址。
-     * @param fd 已关闭的文件描述符。
-     *
-     * @note
-     * - 必须在 close(fd) 后调用
-     * - 用于维护 activeConnections 与内部状态一致性
-     */
-            void clearIP(const std::string &ip,const int &fd);
-        /**
-     * @brief 检测并清理僵尸连接（fd 级）。
-     *
-     * @param ip 对端 IP 地址。
-     * @param fd 待检测的文件描述符。
-     *
-     * @return true  该连接被判定为僵尸并已清理
-     * @return false 未超时或不存在
-     *
-     * @note
-     * - “活动”指 allowConnect / allowRequest 更新 lastActivity
-     * - 建议由外部定时器触发调用，避免热路径扫描
-     */
-            bool connectionDetect(const std::string &ip,const int &fd);
-        /**
- * @brief 立即将指定 IP 加入黑名单（直接封禁）。
- *
- * @details
- * 该接口用于在检测到“明确恶意行为”时，绕过评分与渐进惩罚，
- * 直接对 IP 进行封禁（写入黑名单）。
- *
- * 封禁语义说明：
- * - 若 IP 当前不在黑名单中：直接加入；
- * - 若 IP 已在黑名单中：@b 刷新（覆盖）封禁到期时间；
- * - 若 banSeconds < 0：表示永久封禁（使用 time_point::max）。
- *
- * @param ip 需要封禁的 IP 地址。
- * @param banSeconds 封禁时长（秒）：
- *   - > 0 ：封禁 banSeconds 秒（短期封禁）
- *   - = 0 ：不做任何操作
- *   - < 0 ：永久封禁
- * @param reasonCN 封禁原因（中文，用于日志）。
- * @param reasonEN 封禁原因（英文，用于日志）。
- *
- * @note
- * - 本函数 @b 不会 立即断开已有连接；
- *   外层逻辑应在返回 CLOSE 后自行 close(fd)。
- * - 使用 steady_clock，不受系统时间调整影响。
- * - 该接口是安全裁决的“终态动作”，应谨慎调用。
-  * @note
- * - 若 IP 已被封禁且原到期时间晚于本次封禁时间，
- *   将保留更长的封禁（不会缩短）。
-
- */
-        void banIP(const std::string &ip,int banSeconds,const std::string &reasonCN,const std::string &reasonEN);
-        /**
- * @brief 手动解除某个 IP 的黑名单。
- */
-    void unbanIP(const std::string &ip);
-    /**
-    * @brief 判断某ip是否被封禁
-    */
-    bool isBanned(const std::string &ip) const;
-
-
-        private:
-            // 核心判定
-            bool allow(RateState &st,const RateLimitType &type,const int &times,const int &secs,const std::chrono::steady_clock::time_point &now);
-
-        private:
-            int maxConnections;
-            int connectionTimeout;
-
-            RateLimitType connectStrategy = RateLimitType::Cooldown;
-            RateLimitType requestStrategy = RateLimitType::SlidingWindow;
-            RateLimitType pathStrategy    = RateLimitType::SlidingWindow;
-
-            std::unordered_map<std::string, IPInformation> table;
-            std::unordered_map<std::string, std::pair<int,int>> pathConfig;
-            // IP -> 解封时间
-            std::unordered_map<std::string,std::chrono::steady_clock::time_point> blacklist;
-            inline void logSecurity(const std::string &msgCN,const std::string &msgEN);
-        };
-
-        
-        
-    }
-
-    /**
-    * @namespace stt::network
-    * @brief 网络框架，协议，通信，io多路复用相关
-    * @ingroup stt
-    */
-    namespace network
-    {
-    /**
-    * @brief tcp协议的套接字操作类
-    */
-    class TcpFDHandler
-    {
-    protected:
-        int fd=-1;
-        bool flag1=false;
-        bool flag2=false;
-        SSL *ssl=nullptr;
-        int sec=-1;
-    public:
-        /**
-        * @brief 如果sendData的block=true，如果发送过程中连接断开，这个标志位会置为true
-        */
-        bool flag3=false;
-    public:
-        /**
-        * @brief 传入套接字初始化对象
-        * @note 可以选择设置套接字的阻塞和非阻塞，SO_REUSEADDR模式（只可能在服务端socket用到），还能选择该套接字加密后的SSL句柄
-        * @param fd 套接字
-        * @param ssl fd经过TLS加密后的SSL句柄（如果没有可以填nullptr）
-        * @param flag1 true：启用非阻塞模式  false：启用阻塞模式 （默认为false，即启用阻塞模式）
-        * @param flag2 true：启用SO_REUSEADDR模式  false：不启用SO_REUSEADDR模式 （默认为false，即不启用SO_REUSEADDR模式）
-        * @param sec 阻塞超时时间 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
-        */
-        void setFD(const int &fd,SSL *ssl,const bool &flag1=false,const bool &flag2=false,const int &sec=-1);
-        /**
-        * @brief 获取该对象的套接字
-        * @return 返回该对象的套接字
-        */
-        int getFD(){return fd;}
-        /**
-        * @brief 获取该对象的加密SSL句柄
-        * @return 返回加密SSL句柄。如果没有加密SSL句柄，返回nullptr。
-        */
-        SSL *getSSL(){return ssl;}
-        /**
-        * @brief 关闭对象
-        * @param cle true：关闭对象并且关闭原对象句柄的套接字的链接   false：仅关闭对象  （默认为ture，关闭对象也关闭连接）
-        */
-        void close(const bool &cle=true);
-        /**
-        * @brief 设置对象中的套接字为阻塞模式
-        * @param sec 阻塞超时时间 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
-        */
-        void blockSet(const int &sec = -1);
-        /**
-        * @brief 设置对象中的套接字为非阻塞模式
-        */
-        void unblockSet();
-        /**
-        * @brief 设置对象中的套接字为SO_REUSEADDR模式
-        */
-        bool multiUseSet();
-        /**
-        * @brief 判断对象是否有套接字绑定
-        * @return true：对象绑定了套接字  false：对象没有绑定套接字
-        */
-        bool isConnect(){if(fd==-1)return false;else return true;}
-    public:
-        /**
-        * @brief 向已连接的套接字发送字符串数据。
-        *
-        * @param data 要发送的数据内容（std::string 类型）。
-        * @param block 是否以阻塞模式发送（默认 true）。
-        *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；如果需要判断是否连接断开了可以检查flag3标志位判断。
-        *              - false：阻塞与否取决于套接字状态。
-        * 
-        * @return
-        * - 返回值 > 0：成功发送的字节数；
-        * - 返回值 = 0：连接已关闭（block=false）或者发送成功的字节数为0（block=true）；
-        * - 返回值 < 0（只可能在block=false的情况下）：发送失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式下，发送缓冲区已满。
-        *
-        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞），返回值一定>=0,适合希望确保完整发送的场景。如果需要判断是否连接断开了可以检查flag3标志位判断。
-        * 若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 希望发送的长度，需手动处理剩余数据。
-        */
-        int sendData(const std::string &data,const bool &block=true);
-        /**
-        * @brief 向已连接的套接字发送指定长度的二进制数据。
-        *
-        * @param data 指向要发送的数据缓冲区。
-        * @param length 数据长度（字节）。
-        * @param block 是否以阻塞模式发送（默认 true）。
-        *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；如果需要判断是否连接断开了可以检查flag3标志位判断。
-        *              - false：阻塞与否取决于套接字状态。
-        * 
-        * @return
-        * - 返回值 > 0：成功发送的字节数；
-        * - 返回值 = 0：连接已关闭（block=false）或者发送成功的字节数为0（block=true）；
-        * - 返回值 < 0（只可能在block=false的情况下）：发送失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式下，发送缓冲区已满。
-        *
-        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞），返回值一定>=0,适合希望确保完整发送的场景。如果需要判断是否连接断开了可以检查flag3标志位判断。
-        * 若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 length，需手动处理剩余数据。
-        */
-        int sendData(const char *data,const uint64_t &length,const bool &block=true);
-        /**
-        * @brief 从已连接的套接字中阻塞接收指定长度的数据到字符串
-        *
-        * @param data 接收数据的数据容器（string类型）
-        * @param length 接收长度
-        * @param sec 等待时间 单位为秒 -1为无限阻塞等待 （默认为2s）
-        * @return
-        * - 返回值 > 0：成功接收的字节数；
-        * - 返回值 = 0：连接已关闭；
-        * - 返回值 < 0：接收失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：超时
-        *
-        * @note 如果没有接收完指定的数据大小，一定阻塞到超时或者出错
-        */
-        int recvDataByLength(std::string &data,const uint64_t &length,const int &sec=2);
-        /**
-        * @brief 从已连接的套接字中阻塞接收指定长度的数据到char*容器
-        *
-        * @param data 接收数据的数据容器（char*类型）
-        * @param length 接收长度
-        * @param sec 等待时间 单位为秒 -1为无限阻塞等待 （默认为2s）
-        * @return
-        * - 返回值 > 0：成功接收的字节数；
-        * - 返回值 = 0：连接已关闭；
-        * - 返回值 < 0：接收失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：超时
-        *
-        * @note 如果没有接收完指定的数据大小，一定阻塞到超时或者出错
-        */
-        int recvDataByLength(char *data,const uint64_t &length,const int &sec=2);
-        /**
-        * @brief 从已连接的套接字中接收一次数据到string字符串容器
-        * @param data 接收数据的数据容器（string类型）
-        * @param length 最大接收长度
-        * @return 
-        * - 返回值 > 0：成功接收的字节数；
-        * - 返回值 = 0：连接已关闭；
-        * - 返回值 < 0：接收失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式且没有数据
-        * @note 接收是否会阻塞根据fd的阻塞情况决定
-        */
-        int recvData(std::string &data,const uint64_t &length);
-        /**
-        * @brief 从已连接的套接字中接收一次数据到char*容器
-        * @param data 接收数据的数据容器（char*类型）
-        * @param length 最大接收长度
-        * @return 
-        * - 返回值 > 0：成功接收的字节数；
-        * - 返回值 = 0：连接已关闭；
-        * - 返回值 < 0：接收失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式且没有数据
-        * @note 接收是否会阻塞根据fd的阻塞情况决定
-        */
-        int recvData(char *data,const uint64_t &length);
-    };
-
-    /**
-    * @brief tcp协议客户端操作类
-    * @note 默认是阻塞模式的
-    */
-    class TcpClient:public TcpFDHandler
-    {
-    private:
-        std::string serverIP="";
-        int serverPort=-1;
-        bool flag=false;
-        bool TLS;
-        SSL_CTX *ctx=nullptr;
-        const char *ca;
-        const char *cert;
-        const char *key;
-        const char *passwd;
-    private:
-        bool createFD();
-        void closeAndUnCreate();
-        bool initCTX(const char *ca,const char *cert="",const char *key="",const char *passwd="");
-    public:
-        /**
-        * @brief TcpClient类的构造函数
-        * @param TLS true：启用TLS加密  false：不启用TLS加密 （默认为false不启用）
-        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
-        * @param cert 客户端证书路径（可选 默认空）
-        * @param key 客户端私钥路径（可选 默认空）
-        * @param passwd 私钥解密密码（可选 默认空）
-        * @note 
-        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
-        * -如果启用了TLS加密 ca必填 其他可选
-        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
-        */
-        TcpClient(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd="");
-        /**
-        * @brief 向服务端发起tcp连接
-        * @param ip 服务端ip
-        * @param port 服务端端口
-        * return  true：连接成功  false：连接失败
-        */
-        bool connect(const std::string &ip,const int &port);        
-        /**
-        * @brief 重新或第一次设置TLS加密参数
-        * @note 设置了的TLS参数伴随整个生命周期，除非调用这个函数重新设置
-        * @param TLS true：启用TLS加密  false：不启用TLS加密 （默认为false不启用）
-        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
-        * @param cert 客户端证书路径（可选 默认空）
-        * @param key 客户端私钥路径（可选 默认空）
-        * @param passwd 私钥解密密码（可选 默认空）
-        * @note 
-        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
-        * -如果启用了TLS加密 ca必填 其他可选
-        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
-        */
-        void resetCTX(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd="");
-        /**
-        * @brief 如果对象有套接字连接，关闭和释放这个连接和套接字，并且重新新建一个套接字。
-        * @return true：关闭成功，新建套接字成功   false：关闭成功，新建套接字失败
-        */
-        bool close();
-        /**
-        * @brief TcpClient的析构函数，会关闭释放套接字和其连接
-        */
-        ~TcpClient(){closeAndUnCreate();}
-    public:
-        /**
-        * @brief 返回已连接的服务端的ip
-        * return 已连接的服务端的ip
-        */
-        std::string getServerIP(){return serverIP;}
-        /**
-        * @brief 返回已连接的客户端的端口
-        * return 已连接的服务端的端口
-        */
-        int getServerPort(){return serverPort;}
-        /**
-        * @brief 返回对象的连接状态
-        * @return  true：已连接  false：未连接
-        */
-        bool isConnect(){return flag;}
-    };  
-
-    /**
-    * @brief Http/Https客户端操作类
-    * @note 
-    * -请求头都会自动带上Connection: keep-alive
-    * -如果需要重新设置TLS/Https加密的证书，目前需要销毁对象后重新构造
-    * -如果没用传入套接字的函数，底层TCP默认是阻塞的
-    */
-    class HttpClient:private TcpClient
-    {
-    private:
-        bool flag=false;
-    public:
-        /**
-        * @brief HttpClient类的构造函数
-        * @param TLS true：启用Https加密  false：不启用Https加密 （默认为false不启用）
-        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
-        * @param cert 客户端证书路径（可选 默认空）
-        * @param key 客户端私钥路径（可选 默认空）
-        * @param passwd 私钥解密密码（可选 默认空）
-        * @note 
-        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
-        * -如果启用了Https加密 ca必填 其他可选
-        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
-        */
-        HttpClient(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd=""):TcpClient(TLS,ca,cert,key,passwd){}
-    public:
-        /**
-        * @brief 发送一个GET请求到服务器
-        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
-        * @note 如果使用了TLS，会自动采用https协议，否则是自动采用http协议
-        * @note 默认是阻塞的
-        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
-        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
-        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
-        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
-        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        */
-        bool getRequest(const std::string &url,const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=-1);
-        /**
-        * @brief 发送一个POST请求到服务器
-        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
-        * @note 如果使用了TLS，会自动采用https协议，否则是自动采用http协议
-        * @note 默认是阻塞的
-        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        * @param body http请求体
-        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
-        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
-        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
-        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
-        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        */
-        bool postRequest(const std::string &url,const std::string &body="",const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=-1);
-        /**
-        * @brief 从tcp套接字发送一个GET请求到服务器
-        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
-        * @note 如果填入的ssl不为nullptr，会自动采用https协议，否则是自动采用http协议
-        * @note 调用的时候会阻塞，改变原有fd的状态，注意备份和恢复
-        * @param fd tcp套接字
-        * @param ssl TLS加密套接字
-        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
-        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
-        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为2s
-        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
-        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        */
-        bool getRequestFromFD(const int &fd,SSL *ssl,const std::string &url,const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=2);
-        /**
-        * @brief 发送一个POST请求到服务器
-        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
-        * @note 如果填入的ssl不为nullptr，会自动采用https协议，否则是自动采用http协议
-        * @note 调用的时候会阻塞，改变原有fd的状态，注意备份和恢复
-        * @param fd tcp套接字
-        * @param ssl TLS加密套接字
-        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        * @param body http请求体
-        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
-        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
-        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
-        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
-        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
-        */
-        bool postRequestFromFD(const int &fd,SSL *ssl,const std::string &url,const std::string &body="",const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=2);
-    public:
-        /**
-        * @brief 获取服务器返回响应状态
-        * @return true：服务器返回响应成功  false：服务器返回响应失败
-        */
-        bool isReturn(){return flag;}
-        /**
-        * @brief 服务器返回响应头
-        */
-        std::string header="";
-        /**
-        * @brief 服务器返回响应体
-        */
-        std::string body="";
-    };
-    
-    /**
-    * @brief 用epoll监听单个句柄
-    */
-    class EpollSingle
-    {
-    private:
-        int fd;
-        bool flag=true;
-        std::function<bool(const int &fd)> fc=[](const int &fd)->bool
-        {return true;};
-        std::function<void(const int &fd)> fcEnd=[](const int &fd)->void
-        {};
-        std::function<bool(const int &fd)> fcTimeOut=[](const int &fd)->bool
-        {return true;};
-        bool flag1=true;
-        bool flag2=false;
-        time::Duration dt{0,20,0,0,0};
-        bool flag3=false;
-        time::Duration t;
-    private:
-        void epolll();
-    public:
-        /**
-        * @brief 开始监听
-        * @param fd 需要监听的句柄
-        * @param flag  true：水平触发    false：边缘触发
-        * @param dt 填入监听超时时间
-        */
-        void startListen(const int &fd,const bool &flag=true,const time::Duration &dt=time::Duration{0,0,20,0,0});
-    public:
-        /**
-        * @brief 返回epoll监听状态
-        * @return true：正在监听  false：没有监听
-        */
-        bool isListen(){return flag2;}
-        /**
-        * @brief 设置epoll触发后的处理函数
-        * 注册一个回调函数
-        * @param fc 一个函数或函数对象，用于当有数据时上来的时候回调处理套接字fd
-        * -参数：const int &fd - 要处理的套接字
-        * -返回： bool - 返回true成功成功，返回false处理失败
-        * @note 传入的函数应该有如下签名 bool func(const int &fd)
-        * @note 如果处理失败了 会退出epoll监听（没有关闭套接字）
-        */
-        void setFunction(std::function<bool(const int &fd)> fc){this->fc=fc;}
-        /**
-        * @brief 设置epoll退出前的回调函数
-        * 注册一个回调函数
-        * @param fcEnd 一个函数或函数对象，用于处理epoll退出前的流程
-        * -参数：const int &fd - 要处理的套接字
-        * @note 传入的函数应该有如下签名 void func(const int &fd)
-        */
-        void setEndFunction(std::function<void(const int &fd)> fcEnd){this->fcEnd=fcEnd;};
-        /**
-        * @brief 设置epoll超时后出发的回调函数
-        * 注册一个回调函数
-        * @param fc 一个函数或函数对象，用于当epoll超时的时候回调处理套接字fd
-        * -参数：const int &fd - 要处理的套接字
-        * -返回： bool - 返回true成功成功，返回false处理失败
-        * @note 传入的函数应该有如下签名 bool func(const int &fd)
-        * @note 如果处理失败了 会退出epoll监听（没有关闭套接字）
-        */
-        void setTimeOutFunction(std::function<bool(const int &fd)> fcTimeOut){this->fcTimeOut=fcTimeOut;};
-        /**
-        * @brief 结束epoll监听
-        * 会阻塞直到epoll退出完成
-        * @return true：处理结束  false：结束失败
-        */
-        bool endListen();
-        /**
-        * @brief 发送结束epoll的信号
-        * @note 仅仅发送信号，不跟进后续逻辑
-        */
-        void endListenWithSignal(){flag1=false;}
-        /**
-        * @brief 开始退出epoll倒计时，直到套接字有新的消息
-        * 如果套接字倒计时结束还没有新的消息，那么退出epoll
-        * @param t 一个Duration对象 填入倒计时时长 （默认为10秒）
-        */
-        void waitAndQuit(const time::Duration &t=time::Duration{0,0,0,10,10}){flag3=true;this->t=t;}
-        /**
-        * @brief EpollSingle的析构函数
-        * 调用eldListen阻塞退出epoll
-        */
-        ~EpollSingle(){endListen();}
-    };
-    
-    /**
-    * @brief Websocket客户端操作的类
-    * -如果需要重新设置TLS/Https加密的证书，目前需要销毁对象后重新构造
-    * 底层TCP默认是阻塞的
-    */
-    class WebSocketClient:private TcpClient 
-    {
-    private:
-        bool flag4=false;
-        std::function<bool(const std::string &message,WebSocketClient &k)> fc=[](const std::string &message,WebSocketClient &k)->bool
-        {std::cout<<"收到: "<<message<<std::endl;return true;};
-        std::string url;
-        EpollSingle k;
-        bool flag5=false;
-    private:
-        bool close1();
-    public:
-        /**
-        * @brief WebSocketClient类的构造函数
-        * @param TLS true：启用wss加密  false：不启用wss加密 （默认为false不启用）
-        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
-        * @param cert 客户端证书路径（可选 默认空）
-        * @param key 客户端私钥路径（可选 默认空）
-        * @param passwd 私钥解密密码（可选 默认空）
-        * @note 
-        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
-        * -如果启用了wss加密 ca必填 其他可选
-        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
-        */
-        WebSocketClient(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd=""):TcpClient(TLS,ca,cert,key,passwd){}
-        /**
-        * @brief 设置收到服务端消息后的回调函数
-        * 注册一个回调函数
-        * @param fc 一个函数或函数对象，用于收到服务端消息后处理逻辑
-        * -参数：string &message - 要处理的套接字
-                WebsocketClient &k - 当前对象的引用
-        * -返回： bool - 返回true处理成功，返回false处理失败
-        * @note 传入的函数应该有如下签名 bool func(const std::string &message,WebSocketClient &k)
-        * @note 如果处理失败了 会直接关闭整个websocket连接
-        */
-        void setFunction(std::function<bool(const std::string &message,WebSocketClient &k)> fc){this->fc=fc;}
-        /**
-        * @brief 连接到websocket服务器
-        * @param url ws/wss的完整url（注意需要显式指定端口和路径） 如：wss://google.com 要写成wss://google.com:443/ (补全:443和/)
-        * @param min 心跳时间，单位分钟 （默认为20分钟）
-        * @warning 需要ws/wss的完整url（注意需要显式指定端口和路径） 如：wss://google.com 要写成wss://google.com:443/ (补全:443和/) 
-        */
-        bool connect(const std::string &url,const int &min=20);
-        /**
-        * @brief 发送 WebSocket 消息
-        * 
-        * 根据 WebSocket 协议，封装并发送一条带掩码的数据帧（客户端必须使用掩码），
-        * 支持根据 payload 长度自动选择帧格式：
-        * - payload <= 125 字节：使用 1 字节长度
-        * - 126 <= payload <= 65535：使用 2 字节扩展长度（附加 126 标记）
-        * - payload > 65535：使用 8 字节扩展长度（附加 127 标记）
-        * 
-        * @param message 要发送的消息内容（已编码为文本或二进制）
-        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
-        *        约定格式为 `"1000" + type`，其中：
-        *        - "0001" 表示文本帧（Text Frame）
-        *        - "0010" 表示二进制帧（Binary Frame）
-        *        - "1000" 表示连接关闭（Close Frame）
-        *        - "1001" 表示 Ping 帧
-        *        - "1010" 表示 Pong 帧
-        *        请根据内部约定使用，默认使用 text（文本帧）
-        * 
-        * @return true 发送成功
-        * @return false 发送失败（可能因连接未建立或发送异常）
-        */
-        bool sendMessage(const std::string &message,const std::string &type="0001");
-        /**
-        * @brief 发送关闭帧并关闭 WebSocket 连接（简化方式）
-        * 
-         * 直接传入编码后的关闭 payload，其中前两字节为关闭码（big-endian），
-         * 后续为 UTF-8 编码的关闭原因描述，用于简化调用。
-        * 
-        * @param closeCodeAndMessage 编码后的关闭帧 payload（2 字节关闭码 + 可选消息）
-        * @param wait 是否等待底层监听线程/epoll事件处理后退出
-        */
-        void close(const std::string &closeCodeAndMessage,const bool &wait=true);
-        /**
-        * @brief 发送关闭帧并关闭 WebSocket 连接（标准方式）
-        * 
-        * 构建符合 RFC 6455 的关闭帧（opcode = 0x8），帧 payload 包含关闭码（2 字节）与可选关闭原因字符串。
-        * 
-        * @param code WebSocket 关闭码，常见包括：
-        * - 1000：正常关闭（Normal Closure）
-        * - 1001：终端离开（Going Away）
-        * - 1002：协议错误（Protocol Error）
-        * - 1003：不支持的数据类型（Unsupported Data）
-        * - 1006：非正常关闭（无关闭帧，程序内部使用）
-        * - 1008：策略违规（Policy Violation）
-        * - 1011：服务器内部错误（Internal Error）
-        * 
-        * @param message 可选关闭原因，供调试或日志记录用
-        * @param wait 是否等待底层监听线程/epoll事件处理后退出
-        */
-        void close(const short &code=1000,const std::string &message="bye",const bool &wait=true);       
-    public:
-        /**
-        * @brief 返回连接状态
-        * @return true：和服务器存在连接  false：没有连接
-        */
-        bool isConnect(){return flag4;}
-        /**
-        * @brief 如果连接到了服务器 返回url
-        * @return 返回url
-        */
-        std::string getUrl(){return url;}
-        /**
-        * @brief 如果连接到了服务器 返回服务器ip
-        * @return 返回服务器ip
-        */
-        std::string getServerIp(){return TcpClient::getServerIP();}
-        /**
-        * @brief 如果连接到了服务器 返回服务器端口
-        * @return 返回服务器端口
-        */
-        std::string getServerPort(){return TcpClient::getServerIP();}
-        /**
-        * @brief WebSocketClient类的析构函数，销毁对象时候会优雅退出断开连接
-        */    
-        ~WebSocketClient();
-    };
-
-    /**
-    * @brief 保存HTTP/HTTPS请求信息的结构体
-    */
-    struct HttpRequestInformation 
-    {
-        /**
-        * @brief 底层的socket套接字
-        */
-        int fd;
-        /**
-        * @brief 连接对象fd
-        */
-        uint64_t connection_obj_fd;
-        /**
-        * @brief 请求类型
-        */
-        std::string type;
-        /**
-        * @brief url中的路径和参数
-        */
-        std::string locPara;
-        /**
-        * @brief url中的路径
-        */
-        std::string loc;
-        /**
-        * @brief url中的参数
-        */
-        std::string para;
-        /**
-        * @brief 请求头
-        */
-        std::string header;
-        /**
-        * @brief 请求体
-        */
-        std::string body;
-        /**
-        * @brief 请求体（chunked）
-        */
-        std::string body_chunked;
-        /**
-        * @brief 所需的数据仓库
-        */
-        std::unordered_map<std::string,std::any> ctx;
-    };
-    
-    struct TcpFDInf;
-    /**
-    * @brief 解析，响应Http/https请求的操作类
-    * 仅传入套接字，然后使用这个类进行Http的操作
-    */
-    class HttpServerFDHandler:public TcpFDHandler
-    {
-    public:
-        /**
-        * @brief 初始化对象，传入套接字等参数
-        * @param fd 套接字
-        * @param ssl TLS加密的SSL句柄(默认为nullptr)
-        * @param flag1 true：启用非阻塞模式  false：启用阻塞模式 （默认为false，即启用阻塞模式）
-        * @param flag2 true：启用SO_REUSEADDR模式  false：不启用SO_REUSEADDR模式 （默认为true，即启用SO_REUSEADDR模式）
-        */
-        void setFD(const int &fd,SSL *ssl=nullptr,const bool &flag1=false,const bool &flag2=true){TcpFDHandler::setFD(fd,ssl,flag1,flag2);}
-        /**
-        * @brief 解析Http/Https请求
-        * @param TcpInf 存放底层tcp处理套接字的信息
-        * @param HttpInf 存放Http协议的信息
-        * @param buffer_size 服务器定义的解析缓冲区的大小（单位为字节)
-        * @param times 记录解析的次数，某些场景会用上
-        * @return -1:解析失败 0:还需要继续解析 1:解析完成
-        * @note TcpInf.status
-        *
-        * 0 初始状态
-        * 1 接收请求头中
-        * 2 接收请求体中(chunk模式)
-        * 3 接收请求体中(非chunk模式)
-        * 
-        */
-        int solveRequest(TcpFDInf &TcpInf,HttpRequestInformation &HttpInf,const unsigned long &buffer_size,const int &times=1);
-        /**
-        * @brief 发送Http/Https响应
-        * @param data 装着响应体的数据的string容器
-        * @param code Http响应状态码和状态说明 （默认是 200 OK）
-        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
-        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（比如可以默认填入keepalive项）
-        * @return  true：发送响应成功  false：发送响应失败
-        */
-        bool sendBack(const std::string &data,const std::string &header="",const std::string &code="200 OK",const std::string &header1="");
-        /**
-        * @brief 发送Http/Https响应
-        * @param data 装着响应体的数据的char *容器
-        * @param length char*容器中的数据长度
-        * @param code Http响应状态码和状态说明 （默认是 200 OK）
-        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
-        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（比如可以默认填入keepalive项）
-        * @param header_length 响应头部加起来的最大长度（默认为50)
-        * @warning 预留的空间务必准确 否则可能发送失败
-        * @warning 所有char*指向的数据都必须确保\0结尾 \0不计入长度 否则有崩溃风险
-        * @return  true：发送响应成功  false：发送响应失败
-        */
-        bool sendBack(const char *data,const size_t &length,const char *header="\0",const char *code="200 OK\0",const char *header1="\0",const size_t &header_length=50);
-    };
-    /**
-    * @brief 保存客户端WS/WSS请求信息的结构体
-    */
-    struct WebSocketFDInformation
-    {
-        /**
-        * @brief 底层的socket套接字
-        */
-        int fd;
-        /**
-        * @brief 连接对象fd
-        */
-        uint64_t connection_obj_fd;
-        /**
-        * @brief true:发送了关闭帧  false：没有发送关闭帧
-        */
-        bool closeflag;
-        /**
-        * @brief  握手阶段的Http/Https路径和参数
-        */
-        std::string locPara;
-        /**
-        * @brief  握手阶段的Http/Https请求头
-        */
-        std::string header;
-        /**
-        * @brief 发送心跳的时间（没有发送过就填0） (检查完又要清空为0)
-        */
-        time_t HBTime=0;
-        /**
-        * @brief 上次收到信息的时间
-        */
-        time_t response;
-        /**
-        * @brief 待接收的长度
-        */
-        size_t recv_length;
-        /**
-        * @brief 已经接收的长度
-        */
-        size_t have_recv_length;
-        /**
-        * @brief 消息类型
-        */
-        int message_type;
-        /**
-        * @brief 消息
-        */
-        std::string message="";
-        /**
-        * @brief fin的状态
-        */
-        bool fin;
-        /**
-        * @brief mask
-        */
-        std::string mask;
-        /**
-        * @brief 所需的数据仓库
-        */
-        std::unordered_map<std::string,std::any> ctx;
-        /**
-        * @brief 握手阶段保存的http信息
-        */
-        HttpRequestInformation httpinf;
-    };
-
-    /**
-    * @brief 保存Tcp客户端的信息
-    */
-    struct TcpInformation
-    {
-        /**
-        * @brief 套接字fd
-        */
-        int fd;
-        /**
-        * @brief 连接对象fd
-        */
-        uint64_t connection_obj_fd;
-        /**
-        * @brief 裸数据
-        */
-        std::string data;
-        /**
-        * @brief 所需的数据仓库
-        */
-        std::unordered_map<std::string,std::any> ctx;
-    };
-
-    enum class TLSState : uint8_t {
-    NONE = 0,        // 非 TLS 连接（普通 TCP）
-    HANDSHAKING,    // TLS 握手中（SSL_accept 还没完成）
-    ESTABLISHED,    // TLS 已建立，可以 SSL_read / SSL_write
-    ERROR           // TLS 出错（可选）
-    };
-
-    /**
-    * @brief 保存底层基础Tcp通道信息的结构体
-    */
-    struct TcpFDInf
-    {
-        /**
-        * @brief 套接字fd
-        */
-        int fd;
-        /**
-        * @brief 连接对象fd
-        */
-        uint64_t connection_obj_fd;
-        /**
-        * @brief 客户端ip
-        */
-        std::string ip;
-        /**
-        * @brief 客户端端口
-        */
-        std::string port;
-        /**
-         * @brief 记录当前处理状态机到第几步了
-         */
-        int FDStatus;
-        /**
-        * @brief 等待处理的队列
-        */
-        std::queue<std::any> pendindQueue;
-        /**
-        * @brief 当前fd的接收状态，用于保存接收处理机逻辑
-        */
-        int status;
-        /**
-        * @brief 保存收到的客户端传来的数据
-        */
-        std::string_view data;
-        /**
-        * @brief 如果加密了，存放加密句柄
-        */
-        SSL* ssl;
-        /**
-        * @brief tls状态
-        */
-        TLSState tls_state;
-        /**
-        * @brief 接收空间指针
-        */
-        char *buffer;
-        /**
-        * @brief 接收空间位置指针
-        */
-        unsigned long p_buffer_now;
-    };
-
-    /**
-    * @brief 工作现场完成任务后压入完成队列的数据结构
-    */
-    struct WorkerMessage
-    {
-        /**
-        * @brief 底层套接字
-        */
-        int fd;
-        /**
-        * @brief 返回值 -2:失败并且要求关闭连接 -1:失败但不需要关闭连接 1:成功
-        */
-        int ret;
-    };
-    
-    
-    /**
-    * @brief Tcp服务端类
-    * @note 默认底层实现是epoll边缘触发+套接字非阻塞模式
-    */
-    class TcpServer 
-    {
-    protected:
-        system::MPSCQueue<WorkerMessage> finishQueue;
-        stt::system::WorkerPool *workpool; 
-        unsigned long buffer_size;
-        unsigned long long  maxFD;
-        security::ConnectionLimiter connectionLimiter;
-        //std::unordered_map<int,TcpFDInf> clientfd;
-        //std::mutex lc1;
-        TcpFDInf *clientfd;
-        int flag1=true;
-        //std::queue<QueueFD> *fdQueue;
-        //std::mutex *lq1;
-        //std::condition_variable cv1;
-        //std::condition_variable *cv;
-        //int consumerNum;
-        //std::mutex lco1;
-        bool unblock;
-        SSL_CTX *ctx=nullptr;
-        bool TLS=false;
-        //std::unordered_map<int,SSL*> tlsfd;
-        //std::mutex ltl1;
-        bool security_open;
-        //bool flag_detect;
-        //bool flag_detect_status;
-        int workerEventFD;
-        int serverType; // 1 tcp 2 http 3 websocket
-        int connectionSecs;
-        int connectionTimes;
-        int requestSecs;
-        int requestTimes;
-        int checkFrequency;
-        uint64_t connection_obj_fd;
-    private:
-        std::function<void(const int &fd)> closeFun=[](const int &fd)->void
-        {
-
-        };
-        std::function<void(TcpFDHandler &k,TcpInformation &inf)> securitySendBackFun=[](TcpFDHandler &k,TcpInformation &inf)->void
-        {};
-        std::function<bool(TcpFDHandler &k,TcpInformation &inf)> globalSolveFun=[](TcpFDHandler &k,TcpInformation &inf)->bool
-        {return true;};
-        std::unordered_map<std::string,std::vector<std::function<int(TcpFDHandler &k,TcpInformation &inf)>>> solveFun;
-        std::function<int(TcpFDHandler &k,TcpInformation &inf)> parseKey=[](TcpFDHandler &k,TcpInformation &inf)->int
-        {inf.ctx["key"]=inf.data;return 1;};
-        int fd=-1;
-        int port=-1;
-        int flag=false;
-        bool flag2=false;
-    private:
-        void epolll(const int &evsNum);
-        //virtual void consumer(const int &threadID);
-        virtual void handler_netevent(const int &fd);
-        virtual void handler_workerevent(const int &fd,const int &ret);
-        virtual void handleHeartbeat()=0;
-    public:
-        /**
-        * @brief 把一个任务放入工作线程池由工作线程完成
-        * @note 应当把速度慢、会阻塞的io任务放入工作线程池
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param fun 放入工作线程池的可执行对象
-        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       TcpFDInf &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 1:处理成功
-        * @param k 和客户端连接的套接字的操作对象的引用
-        * @param inf 客户端信息的引用，保存数据，处理进度，状态机信息等
-        * @return true：投递成功 false：投递失败
-        */
-        void putTask(const std::function<int(TcpFDHandler &k,TcpInformation &inf)> &fun,TcpFDHandler &k,TcpInformation &inf);
-        /**
-        * @brief 构造函数，默认是允许最大1000000个连接，每个连接接收缓冲区最大为256kb，启用安全模块。
-        * @note 打开安全模块会对性能有影响
-        * @param maxFD 服务对象的最大接受连接数 默认为1000000
-        * @param buffer_size 同一个连接允许传输的最大数据量（单位为kb） 默认为256kb
-        * @param finishQueue_cap Worker 完成队列（Worker → Reactor）的容量，必须为 2 的幂。
-        //
-        // 该队列用于承载 worker 线程已完成任务的结果，等待 reactor 线程消费。
-        // 这是主数据通路的一部分，对系统吞吐和延迟极其敏感。
-        //
-        // 选型原则：
-        //   finishQueue_cap >= 峰值完成速率(QPS) × reactor 最坏暂停时间
-        //
-        // 建议值（经验）：
-        //   - 低负载/轻业务： 8192  (~8k)
-        //   - 常规高并发：   65536 (~64k)   【默认】
-        //   - 极端突发流量： 131072(~128k)
-        //
-        // 队列满时 请求将会丢弃，框架不会阻塞生产者。
-        * @param security_open true:开启安全模块 false：关闭安全模块 （默认为开启）
-        * @param connectionNumLimit 同一个ip连接数目的上限（默认20）
-        * @param connectionSecs   连接速率统计窗口长度（单位：秒）（默认1秒）
-        * @param connectionTimes  在 connectionSecs 秒内允许的最大连接次数 （默认6次）
-        * @param requestSecs 请求速率统计窗口长度（单位：秒）（默认1秒）
-        * @param requestTimes 在秒requestSecs内允许的最大请求数量（默认40次）
-        * @param checkFrequency 检查僵尸连接的频率（单位秒钟）  -1为不做检查 （默认为60秒）
-        * @param connectionTimeout 连接多少秒内没有任何反应就视为僵尸连接 （单位为秒） -1为无限制 （默认60秒）
-        */
-        TcpServer(const unsigned long long &maxFD=1000000,const int &buffer_size=256,const size_t &finishQueue_cap=65536,const bool &security_open=true,
-        const int &connectionNumLimit=20,const int &connectionSecs=1,const int &connectionTimes=6,const int &requestSecs=1,const int &requestTimes=40,
-        const int &checkFrequency=60,const int &connectionTimeout=60):maxFD(maxFD),buffer_size(buffer_size*1024),finishQueue(finishQueue_cap),security_open(security_open),connectionSecs(connectionSecs),connectionTimes(connectionTimes),requestSecs(requestSecs),requestTimes(requestTimes),
-        connectionLimiter(connectionNumLimit,connectionTimeout),checkFrequency(checkFrequency){serverType=1;}
-        /**
-        * @brief 打开Tcp服务器监听程序
-        * @param port 监听的端口
-        * @param threads 消费者线程的数量 （默认为8）
-        * @return true：打开监听程序成功 false：打开监听程序失败
-        */
-        bool startListen(const int &port,const int &threads=8);
-        /**
-        * @brief 启用 TLS 加密并配置服务器端证书与密钥
-        * 
-        * 本函数用于初始化 OpenSSL，并为 TCP 服务器启用 TLS（SSL/TLSv1 协议族）支持。
-        * 它加载服务器端证书、私钥和可选的 CA 根证书，用于实现对等验证。
-        * 
-        * 若已启用 TLS，将自动重建（重载）上下文。
-        * 
-        * @param cacert 服务器端证书链文件路径（通常为 PEM 格式，包括中间证书）
-        * @param key 私钥文件路径（与证书匹配的 PEM 格式密钥）
-        * @param passwd 私钥文件的密码（若密钥加密，可为空字符串）
-        * @param ca CA 根证书路径，用于验证客户端证书（PEM 格式）
-        * 
-        * @note 使用的协议方法为 `SSLv23_method()`，实际上支持 SSLv3/TLSv1/TLSv1.1/TLSv1.2 及更高版本（具体取决于 OpenSSL 版本与配置）
-        * 
-        * @note 校验证书策略使用 `SSL_VERIFY_FAIL_IF_NO_PEER_CERT`，即：
-        * - 若客户端未提供证书，则握手失败（更安全，推荐）
-        * - 若证书无效或校验失败，也会终止握手
-        * 
-        * @return true 启用 TLS 成功，服务器已进入加密状态
-        * @return false 启用失败（日志将输出具体错误）
-        * 
-        * @warning 启用 TLS 后，所有接入连接必须遵循 TLS 握手流程，否则通信失败
-        * 
-        * @see redrawTLS() 若已有 TLS 上下文存在，会先释放并重建（可用于热更新证书）
-        */
-        bool setTLS(const char *cert,const char *key,const char *passwd,const char *ca);
-        /**
-        * @brief 撤销TLS加密，ca证书等
-        */
-        void redrawTLS();
-        /**
-        * @brief 设置违反信息安全策略时候的返回函数
-        * @note 违反信息安全策略时候的返回函数,调用完就关闭连接
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       TcpInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：true：处理成功 false：处理失败 会关闭连接
-        */
-        void setSecuritySendBackFun(std::function<void(TcpFDHandler &k,TcpInformation &inf)> fc){this->securitySendBackFun=fc;}
-        /**
-        * @brief 设置全局备用函数
-        * @note 找不到对应回调函数的时候会调用全局备用函数
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       TcpInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：true：处理成功 false：处理失败 会关闭连接
-        */
-        void setGlobalSolveFunction(std::function<bool(TcpFDHandler &k,TcpInformation &inf)> fc){this->globalSolveFun=fc;}
-        /**
-        * @brief 设置key对应的收到客户端消息后的回调函数
-        * @note 可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       TcpFDInf &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        */
-        void setFunction(const std::string &key,std::function<int(TcpFDHandler &k,TcpInformation &inf)> fc)
-        {
-            auto [it, inserted] = solveFun.try_emplace(key);
-            it->second.push_back(std::move(fc));
-        }
-        /**
-        * @brief 设置解析出key的回调函数
-        * @note 根据传入的参数把key存入TcpInformation信息中的ctx哈希表。框架会根据key的值找到你注册的处理函数。
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param parseKeyFun 解析key的回调函数
-        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       TcpFDInf &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        */
-        void setGetKeyFunction(std::function<int(TcpFDHandler &k,TcpInformation &inf)> parseKeyFun){this->parseKey=parseKeyFun;}
-        /** 
-        * @brief 停止监听
-        * @warning 仅停止监听(但是套接字也已经无法接收了，它依赖于监听和消费者，所以这个函数没什么意义)
-        * @return true:停止成功  false：停止失败
-        */
-        bool stopListen();
-        /**
-        * @brief 关闭监听和所有已连接的套接字
-        * @note 关闭监听和所有已经连接的套接字，已经注册的回调函数和tls不会删除和redraw
-        * @note 会阻塞等待直到全部关闭完成
-        * @return true：关闭成功 false：关闭失败
-        */
-        bool close();
-        /**
-        * @brief 关闭某个套接字的连接
-        * @param fd 需要关闭的套接字
-        * @return true：关闭成功 false：关闭失败
-        */
-        virtual bool close(const int &fd);
-        /**
-         * @brief 设置“连接速率限流”所使用的策略。
-         *
-         * @param type 策略类型，见 @ref RateLimitType 说明。
-         * @note 不调用本函数时，默认策略为 @ref RateLimitType::Cooldown 。
-         */
-        void setConnectStrategy(const stt::security::RateLimitType &type){this->connectionLimiter.setConnectStrategy(type);}
-        /**
-         * @brief 设置“IP 级请求限流”所使用的策略。
-         *
-         * @param type 策略类型，见 @ref RateLimitType 说明。
-         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
-         */
-        void setRequestStrategy(const stt::security::RateLimitType &type){this->connectionLimiter.setRequestStrategy(type);}
-        /**
-         * @brief 设置“path 级请求限流”所使用的策略。
-         * 
-         * @param type 策略类型，见 @ref RateLimitType 说明。
-         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
-         * @note 这个path和parseKeyFun解析出来的key是一个东西
-         */
-        void setPathStrategy(const stt::security::RateLimitType &type){this->connectionLimiter.setPathStrategy(type);}
-        /**
-         * @brief 设置某个路径的额外限流规则（path 级）。
-         *
-         * @note 这个path和parseKeyFun解析出来的key是一个东西
-         * @param path 需要额外限流的路径，例如 "/login"、"/register"。
-         * @param times 在 secs 秒内允许的最大请求次数。
-         * @param secs 统计窗口长度（秒）。
-         *
-         * @note setPathLimit 配置的是 @b 额外规则：
-         * - allowRequest 调用时传入的 (times, secs) 仍然会作为 IP 级规则先执行；
-         * - 若 path 命中此配置，则再执行 path 级规则；
-         * - 两者为 AND 关系：任何一层失败即拒绝。
-         */
-        void setPathLimit(const std::string &path, const int &times, const int &secs){this->connectionLimiter.setPathLimit(path,times,secs);}
-        /**
-        * @brief 设置关闭tcp连接之后调用的函数
-        */
-        void setCloseFun(std::function<void(const int &fd)> closeFun){this->closeFun=closeFun;}
-    public:
-        /**
-        * @brief 返回对象的监听状态
-        * @return true:正在监听  false：没有在监听
-        */
-        bool isListen(){return flag;}
-        /**
-        * @brief 查询和服务端的连接，传入套接字，返回加密的SSL句柄
-        * @return 返回加密的SSL指针； 如果不存在此fd或者没有加密 返回nullptr
-        */
-        SSL* getSSL(const int &fd);
-        /**
-        * @brief TcpServer 类的析构函数
-        * @note 会调用close函数关闭
-        */
-        ~TcpServer(){close();}
-    };
-
-    
-    
-    /**
-    * @brief Http/HttpServer 服务端操作类
-    * @note 支持http/1.0 1.1
-    */
-    class HttpServer:public TcpServer
-    {
-    private:
-        std::function<void(HttpServerFDHandler &k,HttpRequestInformation &inf)> securitySendBackFun=[](HttpServerFDHandler &k,HttpRequestInformation &inf)->void
-        {};
-        std::vector<std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)>> globalSolveFun;
-        //std::function<bool(HttpServerFDHandler &k,HttpRequestInformation &inf)> globalSolveFun={};
-        std::unordered_map<std::string,std::vector<std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)>>> solveFun;
-        std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> parseKey=[](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
-        {inf.ctx["key"]=inf.loc;return 1;};
-        //std::function<bool(const HttpRequestInformation &inf,HttpServerFDHandler &k)> fc;
-        //HttpRequestInformation *HttpInf;
-        HttpRequestInformation *httpinf;
-    private:
-        //void consumer(const int &threadID);
-        //inline void handler(const int &fd);
-        void handler_netevent(const int &fd);
-        void handler_workerevent(const int &fd,const int &ret);
-        void handleHeartbeat(){}
-    public:
-        /**
-        * @brief 把一个任务放入工作线程池由工作线程完成
-        * @note 应当把速度慢、会阻塞的io任务放入工作线程池
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param fun 放入工作线程池的可执行对象
-        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 1:处理成功
-        * @param k 和客户端连接的套接字的操作对象的引用
-        * @param inf 客户端信息的引用，保存数据，处理进度，状态机信息等
-        * @return true：投递成功 false：投递失败
-        */
-        void putTask(const std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> &fun,HttpServerFDHandler &k,HttpRequestInformation &inf);
-         
-        /**
-        * @brief 构造函数，默认是允许最大1000000个连接，每个连接接收缓冲区最大为256kb，启用安全模块。
-        * @note 打开安全模块会对性能有影响
-        * @param maxFD 服务对象的最大接受连接数 默认为1000000
-        * @param buffer_size 同一个连接允许传输的最大数据量（单位为kb） 默认为256kb
-        * @param finishQueue_cap Worker 完成队列（Worker → Reactor）的容量，必须为 2 的幂。
-        //
-        // 该队列用于承载 worker 线程已完成任务的结果，等待 reactor 线程消费。
-        // 这是主数据通路的一部分，对系统吞吐和延迟极其敏感。
-        //
-        // 选型原则：
-        //   finishQueue_cap >= 峰值完成速率(QPS) × reactor 最坏暂停时间
-        //
-        // 建议值（经验）：
-        //   - 低负载/轻业务： 8192  (~8k)
-        //   - 常规高并发：   65536 (~64k)   【默认】
-        //   - 极端突发流量： 131072(~128k)
-        //
-        // 队列满时 请求将会丢弃，框架不会阻塞生产者。
-        * @param security_open true:开启安全模块 false：关闭安全模块 （默认为开启）
-        * @param connectionNumLimit 同一个ip连接数目的上限（默认10）
-        * @param connectionSecs   连接速率统计窗口长度（单位：秒）（默认1秒）
-        * @param connectionTimes  在 connectionSecs 秒内允许的最大连接次数 （默认3次）
-        * @param requestSecs 请求速率统计窗口长度（单位：秒）（默认1秒）
-        * @param requestTimes 在秒requestSecs内允许的最大请求数量（默认20次）
-        * @param checkFrequency 检查僵尸连接的频率（单位：秒）  -1为不做检查 （默认为30秒）
-        * @param connectionTimeout 连接多少秒内没有任何反应就视为僵尸连接 （单位为秒） -1为无限制 （默认30秒）
-        */
-        HttpServer(const unsigned long long &maxFD=1000000,const int &buffer_size=256,const size_t &finishQueue_cap=65536,const bool &security_open=true,
-        const int &connectionNumLimit=10,const int &connectionSecs=1,const int &connectionTimes=3,const int &requestSecs=1,const int &requestTimes=20,
-        const int &checkFrequency=30,const int &connectionTimeout=30):TcpServer(
-              maxFD,
-              buffer_size,
-              finishQueue_cap,
-              security_open,
-              connectionNumLimit,
-              connectionSecs,
-              connectionTimes,
-              requestSecs,
-              requestTimes,
-              checkFrequency,
-              connectionTimeout
-          ){serverType=2;}
-        /**
-        * @brief 设置违反信息安全策略时候的返回函数
-        * @note 违反信息安全策略时候的返回函数,调用完就关闭连接
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：true：处理成功 false：处理失败 会关闭连接
-        */
-        void setSecuritySendBackFun(std::function<void(HttpServerFDHandler &k,HttpRequestInformation &inf)> fc){this->securitySendBackFun=fc;}
-        /**
-        * @brief 设置全局备用函数
-        * @note 找不到对应回调函数的时候会调用全局备用函数.可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        */
-        void setGlobalSolveFunction(std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> fc){globalSolveFun.push_back(std::move(fc));}
-        /**
-        * @brief 设置key对应的收到客户端消息后的回调函数
-        * @note 可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        * @code httpserver->setFunction("/ping",[](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
-	                {
-		                k.sendBack("pong");
-		                return 1;
-	                });
-        * @endcode
-        * @code httpserver->setFunction("/ping",[](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
-	                {
-		                httpserver->putTask([](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
-		                {
-			                k.sendBack("pong");
-			                return 1;
-		                },k,inf);
-		                return 0;
-	                });
-        * @endcode
-        */
-        void setFunction(const std::string &key,std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> fc)
-        {
-            auto [it, inserted] = solveFun.try_emplace(key);
-            it->second.push_back(std::move(fc));
-        }
-        /**
-        * @brief 设置解析出key的回调函数
-        * @note 根据传入的参数把key存入TcpInformation信息中的ctx哈希表。框架会根据key的值找到你注册的处理函数。
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param parseKeyFun 解析key的回调函数
-        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        * @code httpserver->setGetKeyFunction([](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
-	                {
-			            inf.ctx["key"]=inf.loc;
-			            return 1;
-	                });
-        * @endcode
-        */
-        void setGetKeyFunction(std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> parseKeyFun){this->parseKey=parseKeyFun;}
-        /**
-        * @brief 打开Http服务器监听程序
-        * @param port 监听的端口
-        * @param threads 消费者线程的数量 （默认为8）
-        * @return true：打开监听程序成功 false：打开监听程序失败
-        */
-        bool startListen(const int &port,const int &threads=8)
-        {
-            //HttpInf=new HttpRequestInformation[maxFD];
-            httpinf=new HttpRequestInformation[maxFD];
-            return TcpServer::startListen(port,threads);
-        }
-        /**
-        * @brief 析构函数
-        */
-        ~HttpServer()
-        {
-            delete[] httpinf;
-        }
-    };
-    /**
-    * @brief WebSocket协议的操作类
-    * 仅传入套接字，然后使用这个类进行WebSocket的操作
-    */
-    class WebSocketServerFDHandler:private TcpFDHandler
-    {
-    public:
-        /**
-        * @brief 初始化对象，传入套接字等参数
-        * @param fd 套接字
-        * @param ssl TLS加密的SSL句柄(默认为nullptr)
-        * @param flag1 true：启用非阻塞模式  false：启用阻塞模式 （默认为false，即启用阻塞模式）
-        * @param flag2 true：启用SO_REUSEADDR模式  false：不启用SO_REUSEADDR模式 （默认为true，即启用SO_REUSEADDR模式）
-        */
-        void setFD(const int &fd,SSL *ssl=nullptr,const bool &flag1=false,const bool &flag2=true){TcpFDHandler::setFD(fd,ssl,flag1,flag2);}
-        /**
-        * @brief 获取一条websocket消息
-        * @param Tcpinf 保存底层tcp状态的信息
-        * @param Websocketinf 保存websocket协议状态信息
-        * @param buffer_size 服务器定义的解析缓冲区的大小（单位为字节)
-        * @param ii 记录解析次数，一些场合用得到 默认为1
-        * @return
-        * -1：获取失败
-        * 0：一般报文
-        * 1：关闭帧
-        * 2：心跳确认报文
-        * 3：心跳报文
-        * 4: 等待数据
-        * @note TcpInf.status
-        *
-        * 0 初始状态
-        * 1 确认消息类型中
-        * 2 确认消息长度中
-        * 3 接收mask中
-        * 4 接收消息中
-        * 
-        */
-        int getMessage(TcpFDInf &Tcpinf,WebSocketFDInformation &Websocketinf,const unsigned long &buffer_size,const int &ii=1);
-        /**
-        * @brief 发送一条websocket信息
-        * @param msg 需要发送的websocket信息
-        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
-        *        约定格式为 `"1000" + type`，其中：
-        *        - "0001" 表示文本帧（Text Frame）
-        *        - "0010" 表示二进制帧（Binary Frame）
-        *        - "1000" 表示连接关闭（Close Frame）
-        *        - "1001" 表示 Ping 帧
-        *        - "1010" 表示 Pong 帧
-        *        请根据内部约定使用，默认使用 text（文本帧）
-        * 
-        * @return true：发送成功  false：发送失败
-        */
-        bool sendMessage(const std::string &msg,const std::string &type="0001");
-       
-    };
-    
-    /**
-    * @brief WebSocketServer服务端操作类
-    */
-    class WebSocketServer:public TcpServer
-    {
-    private:
-        std::unordered_map<int,WebSocketFDInformation> wbclientfd;
-        std::function<void(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> securitySendBackFun=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->void
-        {};
-        //std::function<bool(const std::string &msg,WebSocketServer &k,const WebSocketFDInformation &inf)> fc=[](const std::string &message,WebSocketServer &k,const WebSocketFDInformation &inf)->bool
-        //{std::cout<<"收到: "<<message<<std::endl;return true;};
-        std::function<bool(WebSocketFDInformation &k)> fcc=[](WebSocketFDInformation &k)
-        {return true;};
-        std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fccc=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->bool
-        {
-            return true;
-        };
-        std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> globalSolveFun=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->bool
-        {return true;};
-        std::unordered_map<std::string,std::vector<std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)>>> solveFun;
-        std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> parseKey=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->int
-        {inf.ctx["key"]=inf.message;return 1;};
-        int seca=20*60;
-        int secb=30;
-
-    private:
-        void handler_netevent(const int &fd);
-        void handler_workerevent(const int &fd,const int &ret);
-        //void consumer(const int &threadID);
-        //inline void handler(const int &fd);
-        void closeAck(const int &fd,const std::string &closeCodeAndMessage);
-        void closeAck(const int &fd,const short &code=1000,const std::string &message="bye");
-        
-        void handleHeartbeat();
-        bool closeWithoutLock(const int &fd,const std::string &closeCodeAndMessage);
-        bool closeWithoutLock(const int &fd,const short &code=1000,const std::string &message="bye");
-    public:
-        /**
-        * @brief 把一个任务放入工作线程池由工作线程完成
-        * @note 应当把速度慢、会阻塞的io任务放入工作线程池
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param fun 放入工作线程池的可执行对象
-        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 1:处理成功
-        * @param k 和客户端连接的套接字的操作对象的引用
-        * @param inf 客户端信息的引用，保存数据，处理进度，状态机信息等
-        * @return true：投递成功 false：投递失败
-        */
-         void putTask(const std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> &fun,WebSocketServerFDHandler &k,WebSocketFDInformation &inf);
-        /**
-        * @brief 构造函数，默认是允许最大1000000个连接，每个连接接收缓冲区最大为256kb，启用安全模块。
-        * @note 打开安全模块会对性能有影响
-        * @param maxFD 服务对象的最大接受连接数 默认为1000000
-        * @param buffer_size 同一个连接允许传输的最大数据量（单位为kb） 默认为256kb
-        * @param finishQueue_cap Worker 完成队列（Worker → Reactor）的容量，必须为 2 的幂。
-        //
-        // 该队列用于承载 worker 线程已完成任务的结果，等待 reactor 线程消费。
-        // 这是主数据通路的一部分，对系统吞吐和延迟极其敏感。
-        //
-        // 选型原则：
-        //   finishQueue_cap >= 峰值完成速率(QPS) × reactor 最坏暂停时间
-        //
-        // 建议值（经验）：
-        //   - 低负载/轻业务： 8192  (~8k)
-        //   - 常规高并发：   65536 (~64k)   【默认】
-        //   - 极端突发流量： 131072(~128k)
-        //
-        // 队列满时 请求将会丢弃，框架不会阻塞生产者。
-        * @param security_open true:开启安全模块 false：关闭安全模块 （默认为开启）
-        * @param connectionNumLimit 同一个ip连接数目的上限（默认5）
-        * @param connectionSecs   连接速率统计窗口长度（单位：秒）（默认10秒）
-        * @param connectionTimes  在 connectionSecs 秒内允许的最大连接次数 （默认3次）
-        * @param requestSecs 请求速率统计窗口长度（单位：秒）（默认1秒）
-        * @param requestTimes 在秒requestSecs内允许的最大请求数量（默认10次）
-        * @param checkFrequency 检查僵尸连接的频率（单位：秒）  -1为不做检查 （默认为60秒）
-        * @param connectionTimeout 连接多少秒内没有任何反应就视为僵尸连接 （单位为秒） -1为无限制 （默认120秒）
-        */
-        WebSocketServer(const unsigned long long &maxFD=1000000,const int &buffer_size=256,const size_t &finishQueue_cap=65536,const bool &security_open=true,
-        const int &connectionNumLimit=5,const int &connectionSecs=10,const int &connectionTimes=3,const int &requestSecs=1,const int &requestTimes=10,
-        const int &checkFrequency=60,const int &connectionTimeout=120):TcpServer(
-              maxFD,
-              buffer_size,
-              finishQueue_cap,
-              security_open,
-              connectionNumLimit,
-              connectionSecs,
-              connectionTimes,
-              requestSecs,
-              requestTimes,
-              checkFrequency,
-              connectionTimeout
-          ){serverType=3;}
-        /**
-        * @brief 设置违反信息安全策略时候的返回函数
-        * @note 违反信息安全策略时候的返回函数,调用完就关闭连接
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：true：处理成功 false：处理失败 会关闭连接
-        */
-        void setSecuritySendBackFun(std::function<void(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fc){this->securitySendBackFun=fc;}
-        /**
-        * @brief 设置全局备用函数
-        * @note 找不到对应回调函数的时候会调用全局备用函数
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：true：处理成功 false：处理失败 会关闭连接
-        */
-        void setGlobalSolveFunction(std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fc){this->globalSolveFun=fc;}
-        /**
-        * @brief 设置websocket连接成功后就执行的回调函数
-        * 注册一个回调函数
-        * @param fc 一个函数或函数对象，websocket连接成功后就执行
-        * -参数：const WebSocketFDInformation &inf - Websocket服务端的信息
-        *       WebSocketServer &k - 服务端对象的引用
-        * @note 传入的函数应该有如下签名 void func(const WebSocketFDInformation &inf,WebSocketServer &k)
-        */
-        void setStartFunction(std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fccc){this->fccc=fccc;}
-        /**
-        * @brief 设置websocket握手阶段的检查函数，只有检查通过才执行后续握手
-        * 注册一个回调函数
-        * @param fc 一个函数或函数对象，websocket连接成功后就执行
-        * -参数：const WebSocketFDInformation &inf - Websocket服务端的信息
-        * -返回值 ： true：检查通过  false：检查不通过
-        * @note 传入的函数应该有如下签名 bool func(const WebSocketFDInformation &k)
-        * @note 只有检查通过才执行后续握手，否则断开连接
-        */
-        void setJudgeFunction(std::function<bool(WebSocketFDInformation &k)> fcc){this->fcc=fcc;}
-        /**
-        * @brief 设置key对应的收到客户端消息后的回调函数
-        * @note 可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param key 找到对应回调函数的key
-        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
-        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        * @code s->setFunction("ping",[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->int
-	                {
-		                k.sendMessage("pong");
-		                return 1;
-	                });
-        * @endcode
-        */
-        void setFunction(const std::string &key,std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fc)
-        {
-            auto [it, inserted] = solveFun.try_emplace(key);
-            it->second.push_back(std::move(fc));
-        }
-        /**
-        * @brief 设置解析出key的回调函数
-        * @note 根据传入的参数把key存入TcpInformation信息中的ctx哈希表。框架会根据key的值找到你注册的处理函数。
-        * @warning 可执行对象必须严格按照规定的返回值返回
-        * @param parseKeyFun 解析key的回调函数
-        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
-        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
-        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
-        * @code s->setGetKeyFunction([](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->int
-	                {
-			            inf.ctx["key"]=inf.message;
-			            return 1;
-		            });
-        * @endcode
-        */
-        void setGetKeyFunction(std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> parseKeyFun){this->parseKey=parseKeyFun;}
-        //void setFunction(std::function<bool(const std::string &msg,WebSocketServer &k,const WebSocketFDInformation &inf)> fc){this->fc=fc;}
-        /**
-        * @brief 设置心跳时间
-        * @param seca 心跳时间 单位为分钟。不设置默认为20分钟
-        */
-        void setTimeOutTime(const int &seca){this->seca=seca*60;}
-        /**
-        * @brief 设置发送心跳后的等待时间
-        * @param secb 发送心跳后的等待时间 单位为秒 不设置默认为30秒
-        * @note 如果超过这个时间对端没有反应 关闭连接
-        */
-        void setHBTimeOutTime(const int &secb){this->secb=secb;}
-        /**
-        * @brief 发送关闭帧关闭对应套接字的 WebSocket 连接（简化方式）
-        * 
-        * 传入套接字fd然后关闭连接
-         * 直接传入编码后的关闭 payload，其中前两字节为关闭码（big-endian），
-         * 后续为 UTF-8 编码的关闭原因描述，用于简化调用。
-        * 
-        * @param fd 套接字fd
-        * @param closeCodeAndMessage 编码后的关闭帧 payload（2 字节关闭码 + 可选消息）
-        * @return true：关闭成功  false：关闭失败
-        */
-        bool closeFD(const int &fd,const std::string &closeCodeAndMessage);
-        /**
-        * @brief 发送关闭帧关闭对应套接字的 WebSocket 连接（标准方式）
-        * 
-        * 传入套接字fd然后关闭连接
-        * 构建符合 RFC 6455 的关闭帧（opcode = 0x8），帧 payload 包含关闭码（2 字节）与可选关闭原因字符串。
-        * 
-        * @param fd 套接字fd
-        * @param code WebSocket 关闭码，常见包括：
-        * - 1000：正常关闭（Normal Closure）
-        * - 1001：终端离开（Going Away）
-        * - 1002：协议错误（Protocol Error）
-        * - 1003：不支持的数据类型（Unsupported Data）
-        * - 1006：非正常关闭（无关闭帧，程序内部使用）
-        * - 1008：策略违规（Policy Violation）
-        * - 1011：服务器内部错误（Internal Error）
-        * 
-        * @param message 可选关闭原因，供调试或日志记录用
-        * @return true：关闭成功 false：关闭失败
-        */
-        bool closeFD(const int &fd,const short &code=1000,const std::string &message="bye");
-        /**
-        * @brief 发送 WebSocket 消息给某一个客户端
-        * 
-        * 根据 WebSocket 协议，封装并发送一条带掩码的数据帧（客户端必须使用掩码），
-        * 支持根据 payload 长度自动选择帧格式：
-        * - payload <= 125 字节：使用 1 字节长度
-        * - 126 <= payload <= 65535：使用 2 字节扩展长度（附加 126 标记）
-        * - payload > 65535：使用 8 字节扩展长度（附加 127 标记）
-        * 
-        * @param fd 和客户端连接的套接字
-        * @param msg 要发送的消息内容（已编码为文本或二进制）
-        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
-        *        约定格式为 `"1000" + type`，其中：
-        *        - "0001" 表示文本帧（Text Frame）
-        *        - "0010" 表示二进制帧（Binary Frame）
-        *        - "1000" 表示连接关闭（Close Frame）
-        *        - "1001" 表示 Ping 帧
-        *        - "1010" 表示 Pong 帧
-        *        请根据内部约定使用，默认使用 text（文本帧）
-        * 
-        * @return true 发送成功
-        * @return false 发送失败（可能因连接未建立或发送异常）
-        */
-        bool sendMessage(const int &fd,const std::string &msg,const std::string &type="0001"){WebSocketServerFDHandler k;k.setFD(fd,getSSL(fd),unblock);return k.sendMessage(msg,type);}
-        /**
-        * @brief 关闭监听和所有连接
-        * @note 会阻塞直到全部关闭
-        */
-        bool close();
-        /**
-        * @brief 关闭某个套接字的连接
-        @ @note 多态了TcpServer的close某个套接字 直接掐掉Tcp连接 没有按照websocket协议关闭
-        */
-        bool close(const int &fd);
-        /**
-        * @brief 打开Websocket服务器监听程序
-        * @param port 监听的端口
-        * @param threads 消费者线程的数量 （默认为8）
-        * @return true：打开监听程序成功 false：打开监听程序失败
-        */
-        bool startListen(const int &port,const int &threads=8)
-        {
-            //std::thread(&WebSocketServer::HB,this).detach();
-
-            return TcpServer::startListen(port,threads);
-        }
-        /**
-        * @brief 广播发送 WebSocket 消息
-        * 
-        * 给全体客户端广播发送消息
-        * 根据 WebSocket 协议，封装并发送一条带掩码的数据帧（客户端必须使用掩码），
-        * 支持根据 payload 长度自动选择帧格式：
-        * - payload <= 125 字节：使用 1 字节长度
-        * - 126 <= payload <= 65535：使用 2 字节扩展长度（附加 126 标记）
-        * - payload > 65535：使用 8 字节扩展长度（附加 127 标记）
-        * 
-        * @param msg 要发送的消息内容（已编码为文本或二进制）
-        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
-        *        约定格式为 `"1000" + type`，其中：
-        *        - "0001" 表示文本帧（Text Frame）
-        *        - "0010" 表示二进制帧（Binary Frame）
-        *        - "1000" 表示连接关闭（Close Frame）
-        *        - "1001" 表示 Ping 帧
-        *        - "1010" 表示 Pong 帧
-        *        请根据内部约定使用，默认使用 text（文本帧）
-        * 
-        */
-        void sendMessage(const std::string &msg,const std::string &type="0001");
-        /**
-        * @brief  WebSocketServer的析构函数
-        * @note 销毁对象的时候会阻塞直到全部连接和监听等全部关闭
-        */
-        ~WebSocketServer(){  }
-    };
-
-    /**
-    * @brief UDP操作的类
-    * 传入套接字进行UDP协议的操作
-    */
-    class UdpFDHandler
-    {
-    protected:
-        int fd=-1;
-        bool flag1=false;
-        bool flag2=false;
-        int sec=-1;
-    public:
-        /**
-        * @brief 设置fd
-        * @param fd 需要传入的套接字fd
-        * @param flag1 true：设置非阻塞模式  false：设置阻塞模式 （默认为阻塞模式）
-        * @param sec 设置阻塞超时时间（秒） （默认为-1 即为无限等待）
-        * @param flag2 true：设置SO_REUSEADDR模式 false：不设置SO_REUSEADDR模式
-        */
-        void setFD(const int &fd,const bool &flag1=false,const int &sec=-1,const bool &flag2=false);
-        /**
-        * @brief 设置为阻塞模式
-        * @param sec 阻塞超时时间 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
-        */
-        void blockSet(const int &sec=-1);
-        /**
-        * @brief 设置为非阻塞模式
-        */
-        void unblockSet();
-        /**
-        * @brief 设置SO_REUSEADDR模式
-        * @return true：设置成功  false：设置失败
-        */
-        bool multiUseSet();
-        /**
-        * @brief 返回fd
-        */
-        int getFD(){return fd;}
-        /**
-        * @brief 置空对象，关闭套接字
-        * @param cle true：置空对象并且关闭套接字  false：仅仅清空对象，不关闭套接字
-        */
-        void close(const bool &cle=true);
-        /**
-        * @brief 向目标发送字符串数据。
-        *
-        * @param data 要发送的数据内容（std::string 类型）。
-        * @param block 是否以阻塞模式发送（默认 true）。
-        *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；
-        *              - false：阻塞与否取决于套接字状态。
-        * 
-        * @return
-        * - 返回值 > 0：成功发送的字节数；
-        * - 返回值 <= 0：发送失败；
-        *   - -98：目标错误
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式下，发送缓冲区已满。
-        *
-        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞），适合希望确保完整发送的场景。
-        * 若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 length，需手动处理剩余数据。
-        */
-        int sendData(const std::string &data,const std::string &ip,const int &port,const bool &block=true);
-        /**
-        * @brief 向目标发送指定长度的二进制数据。
-        *
-        * @param data 指向要发送的数据缓冲区。
-        * @param length 数据长度（字节）。
-        * @param block 是否以阻塞模式发送（默认 true）。
-         *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；
-         *              - false：阻塞与否取决于套接字状态。
-        * 
-        * @return
-        * - 返回值 > 0：成功发送的字节数；
-        * - 返回值 <= 0：发送失败；
-        *   - -98：目标错误
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式下，发送缓冲区已满。
-        *
-        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞）。
-        *       若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 length，需手动处理剩余数据。
-        */
-        int sendData(const char *data,const uint64_t &length,const std::string &ip,const int &port,const bool &block=true);
-        /**
-        * @brief 接收一次数据到string字符串容器
-        * @param data 接收数据的数据容器（string类型）
-        * @param length 最大接收长度
-        * @param ip 记录发送来源的ip
-        * @param port 记录发送来源的断开
-        * @return 
-        * - 返回值 > 0：成功接收的字节数；
-        * - 返回值 = 0：连接已关闭；
-        * - 返回值 < 0：接收失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式且没有数据
-        * @note 接收是否会阻塞根据fd的阻塞情况决定
-        */
-        int recvData(std::string &data,const uint64_t &length,std::string &ip,int &port);
-        /**
-        * @brief 接收一次数据到char*容器
-        * @param data 接收数据的数据容器（char*类型）
-        * @param length 最大接收长度
-        * @param ip 记录发送来源的ip
-        * @param port 记录发送来源的断开
-        * @return 
-        * - 返回值 > 0：成功接收的字节数；
-        * - 返回值 = 0：连接已关闭；
-        * - 返回值 < 0：接收失败；
-        *   - -99：对象未绑定 socket；
-        *   - -100：非阻塞模式且没有数据
-        * @note 接收是否会阻塞根据fd的阻塞情况决定
-        */
-        int recvData(char *data,const uint64_t &length,std::string &ip,int &port);
-        
-    };
-    /**
-    * @brief udp客户端的操作类
-    */
-    class UdpClient:public UdpFDHandler
-    {
-    public:
-        /**
-        * @brief 构造函数
-        * @param flag1 true：非阻塞模式 false：阻塞模式 （默认阻塞模式）
-        * @param sec 设置阻塞超时时间（秒） （默认为无限等待）
-        */
-        UdpClient(const bool &flag1=false,const int &sec=-1);
-        /**
-        * @brief 销毁原来的套接字，重新创建一个客户端
-        * @param flag1 true：非阻塞模式 false：阻塞模式 （默认阻塞模式）
-        * @param sec 设置阻塞超时时间（秒） （默认为无限等待）
-        */
-        bool createFD(const bool &flag1=false,const int &sec=-1);
-        /**
-        * @brief 析构函数，对象生命结束会会关闭套接字
-        */
-        ~UdpClient(){close();}
-    };
-    /**
-    * @brief udp服务端的操作类
-    */
-    class UdpServer:public UdpFDHandler
-    {
-    public:
-        /**
-        * @brief 构造函数
-        * @param flag1 true：设置非阻塞模式  false：设置阻塞模式 （默认为阻塞模式）
-        * @param sec 设置阻塞超时时间（秒） （默认为-1 即为无限等待）
-        * @param flag2 true：设置SO_REUSEADDR模式 false：不设置SO_REUSEADDR模式
-        */
-        UdpServer(const int &port,const bool &flag1=false,const int &sec=-1,const bool &flag2=true);
-        /**
-        * @brief 销毁原来的套接字，重新创建一个服务端
-        * @param flag1 true：设置非阻塞模式  false：设置阻塞模式 （默认为阻塞模式）
-        * @param sec 设置阻塞超时时间（秒） （默认为-1 即为无限等待）
-        * @param flag2 true：设置SO_REUSEADDR模式 false：不设置SO_REUSEADDR模式
-        */
-        bool createFD(const int &port,const bool &flag1=false,const int &sec=-1,const bool &flag2=true);
-        /**
-        * @brief 析构函数，对象生命结束会会关闭套接字
-        */
-        ~UdpServer(){close();}
-    };
-    }
-    /**
-    * @namespace stt::system
-    * @brief 系统的设置，进程的控制，心跳监控等
-    * @ingroup stt
-    */
-    namespace system
-    {
-        /**
-        * @brief 初始化服务系统的类
-        * - 适用于需要稳定运行的服务程序的初始化
-        * - 传入的日志文件对象如果是没初始化的空的对象，系统自动在程序目录下创建server_log的文件夹并根据当前时间生成日志文件；如果是初始化了的对象，则启用当前对象下的日志文件。
-        * - 日志系统一旦设置好，会生成日志文件记录服务网络程序的运行动态
-        * - 日志系统的有效工作时间和传入的日志文件对象的生命周期相关
-        */
-        class ServerSetting
-        {
-        public:
-            /**
-            * @brief 系统的日志系统的读写日志对象的指针
-            */
-            static file::LogFile *logfile;
-            /**
-            * @brief 系统的日志系统的语言选择，默认为English
-            */
-            static std::string language;
-        private:
-            static void signalterminated(){std::cout<<"未捕获的异常终止"<<std::endl;if(system::ServerSetting::logfile!=nullptr){if(system::ServerSetting::language=="Chinese")system::ServerSetting::logfile->writeLog("未捕获的异常终止");else system::ServerSetting::logfile->writeLog("end for uncaught exception");}kill(getpid(),15);}
-            static void signalSIGSEGV(int signal){std::cout<<"SIGSEGV"<<std::endl;if(system::ServerSetting::logfile!=nullptr){if(system::ServerSetting::language=="Chinese")system::ServerSetting::logfile->writeLog("信号SIGSEGV");else system::ServerSetting::logfile->writeLog("signal SIGSEGV");}kill(getpid(),15);}
-            static void signalSIGABRT(int signal){std::cout<<"SIGABRT"<<std::endl;if(system::ServerSetting::logfile!=nullptr){if(system::ServerSetting::language=="Chinese")system::ServerSetting::logfile->writeLog("信号SIGABRT");else system::ServerSetting::logfile->writeLog("signal SIGABRT");}kill(getpid(),15);}
-        public:
-            /**
-            * @brief 设置系统的信号
-            * - 屏蔽信号1-14，14-64
-            * - 收到SIGSEGV信号后发送信号15
-            * - 收到未捕获的异常后发送信号15
-            * - 收到SIGABRT信号后发送信号15
-            * - 信号15的退出方式自定义
-            */
-            static void setExceptionHandling();
-            /**
-            * @brief 设置日志系统的日志文件对象
-            * 传入的日志文件对象如果是没初始化的空的对象，系统自动在程序目录下生成server_log文件夹并且根据当前时间生成一个日志文件记录服务程序的网络通信
-            * 如果传入的日志文件对象是初始化了的对象，则启用当前对象下的日志文件。
-            * @param logfile 传入日志文件对象的指针，如果这个对象没初始化，系统自动在程序目录下生成server_log文件夹并且根据当前时间生成一个日志文件。 （默认为nullptr，不设置日志文件）
-            * @param language 日志文件的语言 "Chinese":中文 除此之外都会设置成英文 （默认为空 设置为英文）
-            */
-            static void setLogFile(file::LogFile *logfile=nullptr,const std::string &language="");
-            /**
-            * @brief 执行setExceptionHandling和setLogFile两个函数，完成初始化信号和日志系统
-            * @param logfile 传入日志文件对象的指针，如果这个对象没初始化，系统自动在程序目录下生成server_log文件夹并且根据当前时间生成一个日志文件。 （默认为nullptr，不设置日志文件）
-            * @param language 日志文件的语言 "Chinese":中文 除此之外都会设置成英文 （默认为空 设置为英文）
-            */
-            static void init(file::LogFile *logfile=nullptr,const std::string &language="");
-        };
-        
-        /**
-        * @brief 封装 System V 信号量的同步工具类。
-        * 
-        * `csemp` 提供互斥机制，支持进程间同步操作。通过封装 semget、semop、semctl 等系统调用，
-        * 实现信号量的初始化、P（等待）操作、V（释放）操作、销毁及读取当前值等功能。
-        * 
-        * 禁用复制构造和赋值运算符，保证资源唯一。
-        */
-        class csemp
-        {
-        private:
-            /**
-            * @brief 用于 semctl() 系统调用的联合体参数。
-            * 
-            * `semun` 是 System V 接口中设置信号量属性所必需的用户定义结构。
-            */
-            union semun  
-            {
-                int val;                ///< 设置信号量的值（用于 SETVAL）
-                struct semid_ds *buf;   ///< 信号量的状态缓冲区（用于 IPC_STAT, IPC_SET）
-                unsigned short  *arry;  ///< 设置信号量数组的值（用于 SETALL）
-            };
-
-            int   m_semid;      ///< 信号量的 ID，由 semget 获取。
-            short m_sem_flg;    ///< 信号量操作标志（如 SEM_UNDO）。
-
-            csemp(const csemp &) = delete;             ///< 禁用拷贝构造
-            csemp &operator=(const csemp &) = delete;  ///< 禁用赋值操作
-
-        public:
-            /**
-            * @brief 构造函数，初始化内部状态。
-            */
-            csemp():m_semid(-1){}
-
-            /**
-            * @brief 初始化信号量。
-            * 
-            * 如果信号量已存在，则获取它；否则尝试创建并设置初值。
-            * 
-            * @param key 信号量的唯一键值。
-            * @param value 信号量的初始值（默认1，表示互斥锁）。
-            * @param sem_flg 信号量操作标志，默认 SEM_UNDO，操作会在进程终止后自动撤销。
-            * @return true 成功；false 失败。
-            */
-            bool init(key_t key, unsigned short value = 1, short sem_flg = SEM_UNDO);
-
-            /**
-            * @brief P 操作（等待），尝试将信号量值减去 value。
-            * 
-            * 若当前值不足，会阻塞直到可用。
-            * 
-            * @param value 等待值（必须小于0，默认 -1）。
-            * @return true 成功；false 失败。
-            */
-            bool wait(short value = -1);
-
-            /**
-            * @brief V 操作（释放），尝试将信号量值加上 value。
-            * 
-            * 释放资源或唤醒等待中的进程。
-            * 
-            * @param value 释放值（必须大于0，默认 1）。
-            * @return true 成功；false 失败。
-            */
-            bool post(short value = 1);
-
-            /**
-            * @brief 获取信号量当前的值。
-            * 
-            * @return 信号量的值；失败时返回 -1。
-            */
-            int getvalue();
-
-            /**
-            * @brief 销毁当前信号量。
-            * 
-            * 一般用于持有该信号量的主进程退出前清理资源。
-            * 
-            * @return true 成功；false 失败。
-            */
-            bool destroy();
-
-            /**
-            * @brief 析构函数，不自动销毁信号量。
-            */
-            ~csemp();
-        };
-
-        /**
-        * @brief 定义MAX_PROCESS_NAME这个宏为100,意思是进程信息中的进程名字长度不超过100个字节
-        */
-        #define MAX_PROCESS_NAME 100
-        /**
-        * @brief 定义MAX_PROCESS_INF这个宏为1000,意思是进程信息表记录的进程信息最多为1000条
-        */
-        #define MAX_PROCESS_INF 1000
-        /**
-        * @brief 定义SHARED_MEMORY_KEY这个宏为0x5095,意思是进程信息表的共享内存键值为0x5095
-        */
-        #define SHARED_MEMORY_KEY 0x5095
-        /**
-        * @brief 定义SHARED_MEMORY_LOCK_KEY这个宏为0x5095,意思是操作进程信息表的信号量的键值为0x5095
-        */
-        #define SHARED_MEMORY_LOCK_KEY 0x5095
-
-        /**
-        * @brief 进程信息的结构体
-        */
-        struct ProcessInf
-        {
-            /**
-            * @brief 进程id
-            */
-            pid_t pid;
-            /**
-            * @brief 进程最后一次心跳时间,是时间戳
-            */
-            time_t lastTime;
-            /**
-            * @brief 进程名字
-            */
-            char name[MAX_PROCESS_NAME];
-            /**
-            * @brief 进程第一个参数
-            */
-            char argv0[20];
-            /**
-            * @brief 进程第二个参数
-            */
-            char argv1[20];
-            /**
-            * @brief 进程第三个参数
-            */
-            char argv2[20];
-        };
-
-        /**
-        * @brief 负责进程心跳监控，调度的类
-        * 用于监控服务进程，保证服务进程持续有效运行
-        * 进程结束后，0x5095这一块共享内存和信号量都没有删掉
-        * 目前只支持最多三个参数的进程加入监控
-        * 应该自己手动在程序编写加入心跳监控系统，更新心跳，检查心跳系统的逻辑。该类只提供调用接口。
-        */
-        class HBSystem
-        {
-        private:
-        
-            static ProcessInf *p;
-            static csemp plock;
-            static bool isJoin;
-        public:
-            /**
-            * @brief 把进程加入到心跳系统
-            * @param name 进程名字的绝对路径
-            * @param argv0 进程的第一个参数
-            * @param argv1 进程的第二个参数
-            * @param argv2 进程的第三个参数
-            * @return true：加入成功  false：加入失败
-            */
-            bool join(const char *name,const char *argv0="",const char *argv1="",const char *argv2="");
-            /**
-            * @brief 更新当前进程的心跳
-            * @return true：更新成功  false：更新失败
-            */
-            bool renew();
-            /**
-            * @brief 输出心跳监控系统的所有进程的信息
-            */
-            static void list();
-            /**
-            * @brief 检查心跳监控系统
-            * 如果上一次心跳更新的时间和现在的时候相差大于等于sec秒，则杀死进程
-            * 先发送信号15杀死进程 如果8秒后进程还存在 则发送信号9强制杀死
-            * @return true：操作成功  false：操作失败
-            */
-            static bool HBCheck(const int &sec);
-            /**
-            * @brief 把当前进程从心跳系统中删除
-            * @return true：操作成功 false：操作失败
-            */
-            bool deleteFromHBS();
-            /**
-            * @brief HBSystem的析构函数
-            * - 把当前进程从心跳系统中删除
-            */
-            ~HBSystem();
-        };
-
-        /**
-        * @brief 进程管理的静态工具类
-        */
-        class Process
-        {
-        public:
-        
-
-            /**
-            * @brief 启动一个新进程（可选择是否定时重启）
-            * 
-            * 当 `sec == -1` 时，仅启动一次子进程；否则，会创建一个辅助子进程，定期重启该目标进程。
-            * 
-            * - 定时启动时，辅助进程会屏蔽所有信号。
-            * - 启动的目标进程会屏蔽除 SIGCHLD 和 SIGTERM 的所有信号。
-            * 
-            * @param Args 可变参数类型（用于传递给目标程序的 argv）
-            * @param name 要执行的程序路径（如 `/usr/bin/myapp`）
-            * @param sec 定时间隔（单位：秒）。若为 -1，则表示只启动一次，不定时。
-            * @param args 启动参数（第一个参数必须是程序名称，即 argv[0]，末尾不需要添加 nullptr）
-            * @return true 父进程返回 true 表示启动（或调度）成功
-            * @return false fork 或 execv 出错时返回 false
-            * 
-            * @note
-            * - 参数中不需要手动添加 nullptr；内部自动添加。
-            * - 执行失败后不会抛出异常；返回 false。
-            * - execv 会在子进程中替换当前进程镜像，不返回。
-            */
-            template<class... Args>
-            static bool startProcess(const std::string &name,const int &sec=-1,Args ...args)
-            {
-                std::vector<const char *> paramList={args...,nullptr};
-                if(sec==-1)
-                {
-                    pid_t pid=fork();
-                    if(pid==-1)
-                        return false;
-                    if(pid>0)
-                        return true;
-                    else
-                    {
-                        execv(name.c_str(),const_cast<char* const*>(paramList.data()));
-                        return false;
-                    }
-                }
-                for(int ii=1;ii<=64;ii++)
-                    signal(ii,SIG_IGN);           
-                pid_t pid=fork();
-                if(pid==-1)
-                    return false;
-                if(pid>0)
-                {   
-                    return true;
-                }
-                else
-                {
-                    signal(SIGCHLD,SIG_DFL);
-                    signal(15,SIG_DFL);
-                    while(1)
-                    {
-                        pid=fork();
-                        if(fork()==0)
-                        {
-                            execv(name.c_str(),const_cast<char* const*>(paramList.data()));
-                            exit(0);
-                        }
-                        else if(pid>0)
-                        {
-                            int sts;
-                            wait(&sts);
-                            sleep(sec);
-                        }
-                        else
-                            continue;
-                    }
-                }
-            }
-            /**
-            * @brief 通过函数创建子进程（可选择是否定时重启）
-            * 
-            * 使用一个可调用对象（如 Lambda、函数指针、std::function）作为新子进程的主体逻辑。
-            * 
-            * - 当 `sec == -1`，函数仅执行一次；
-            * - 否则，会创建一个辅助进程定期重新 fork 并执行该函数。
-            * 
-            * @param Fn 可调用对象类型（如函数、Lambda）
-            * @param Args 可调用对象的参数类型
-            * @param fn 要执行的函数或可调用对象
-            * @param sec 定时间隔（单位：秒）。若为 -1，则表示只执行一次，不定时。
-            * @param args 要传递给函数的参数
-            * @return true 父进程返回 true 表示启动成功；子进程内部也会返回 true（用于链式调用等）
-            * @return false 创建进程失败
-            * 
-            * @note
-            * - 函数的实际执行是在新 fork 出的子进程中。
-            * - 函数 fn 必须是可调用的；参数类型需能完美转发。
-            * - 子进程执行完毕后会退出；辅助进程将周期性地重新创建它。
-            */
-            template<class Fn,class... Args>
-            static typename std::enable_if<!std::is_convertible<Fn, std::string>::value, bool>::type
-            startProcess(Fn&& fn,const int &sec=-1,Args &&...args)
-            {
-                if(sec==-1)
-                {
-                    pid_t pid=fork();
-                    if(pid==-1)
-                        return false;
-                    if(pid>0)
-                    return true;
-                    else
-                    {
-                        auto f=std::bind(std::forward<Fn>(fn),std::forward<Args>(args)...);
-                        f();
-                        return true;
-                    }
-                }
-                for(int ii=1;ii<=64;ii++)
-                    signal(ii,SIG_IGN);           
-                pid_t pid=fork();
-                if(pid==-1)
-                    return false;
-                if(pid>0)
-                {   
-                    return true;
-                }
-                else
-                {
-                    signal(SIGCHLD,SIG_DFL);
-                    signal(15,SIG_DFL);
-                    while(1)
-                    {
-                        pid=fork();
-                        if(pid==0)
-                        {
-                            auto f=std::bind(std::forward<Fn>(fn),std::forward<Args>(args)...);
-                            f();
-                            return true;
-                        }
-                        else if(pid>0)
-                        {
-                            int sts;
-                            wait(&sts);
-                            sleep(sec);
-                        }
-                        else
-                            continue;
-                    }
-                }
-            }
-        };
-
-        using Task = std::function<void()>;
-        /**
-        * @class WorkerPool
-        * @brief 固定大小的工作线程池
-        *
-        * WorkerPool 内部维护一个任务队列和若干工作线程。
-        * 每个工作线程循环从队列中取出任务并执行。
-        *
-        * ## 特性
-        * - 固定线程数量
-        * - 线程安全的任务提交
-        * - 支持优雅停止（graceful shutdown）
-        *
-        * ## 线程安全说明
-        * - submit() 是线程安全的
-        * - stop() 是线程安全的
-        *
-        * ## 使用示例
-        * @code
-        * WorkerPool pool(4);
-        * pool.submit([] {
-        *     // 执行任务
-        * });
-        * pool.stop();
-        * @endcode
-        */
-        class WorkerPool 
-        {
-        public:
-            /**
-            * @brief 构造函数，创建指定数量的工作线程
-            *
-            * @param n 工作线程数量
-            *
-            * 构造完成后，所有线程立即启动并进入等待状态。
-            */
-            explicit WorkerPool(size_t n):stop_(false)
-            {
-                for (size_t i = 0; i < n; ++i) {
-                    threads_.emplace_back([this] {
-                        this->workerLoop();
-                    });
-                }
-            }
-            /**
-            * @brief 析构函数
-            *
-            * 析构时会自动调用 stop()，
-            * 确保所有线程退出并被正确 join。
-            */
-            ~WorkerPool() 
-            {
-                stop();
-            }
-            /**
-            * @brief 向线程池提交一个任务
-            *
-            * @param task 可调用对象，函数签名为 void()
-            *
-            * 任务会被放入内部队列，并由某个工作线程异步执行。
-            */
-            void submit(Task task) 
-            {
-                {
-                    std::lock_guard<std::mutex> lk(mtx_);
-                    tasks_.push(std::move(task));
-                }
-                cv_.notify_one();
-            }
-            /**
-             * @brief 停止线程池并等待所有线程退出
-             *
-            * 调用后：
-            * - 不应再提交新的任务
-            * - 已提交但未执行的任务会被执行完
-            * - 所有工作线程都会退出并 join
-            *
-            * 该函数可安全重复调用。
-            */
-            void stop() 
-            {
-                {
-                    std::lock_guard<std::mutex> lk(mtx_);
-                    stop_ = true;
-                }
-                cv_.notify_all();
-                for (auto &t : threads_) 
-                {
-                    if (t.joinable()) t.join();
-                }
-            }
-
-        private:
-            /**
-            * @brief 工作线程主循环
-            *
-            * 每个工作线程都会执行此函数：
-            * - 在条件变量上等待任务或停止信号
-            * - 从任务队列中取出任务
-            * - 执行任务
-            *
-            * 当 stop_ 为 true 且任务队列为空时，线程退出。
-            */
-            void workerLoop() 
-            {
-                while (true) 
-                {
-                    Task task;
-                    {
-                        std::unique_lock<std::mutex> lk(mtx_);
-                        cv_.wait(lk, [this] {
-                        return stop_ || !tasks_.empty();
-                        });
-                        if (stop_ && tasks_.empty())
-                        {
-                            return;
-                        }
-                        task = std::move(tasks_.front());
-                        tasks_.pop();
-                    }
-                    task(); // 执行任务
-                }
-            }
-
-        private:
-            std::vector<std::thread> threads_;
-            std::queue<Task> tasks_;
-            std::mutex mtx_;
-            std::condition_variable cv_;
-            bool stop_;
-        };
-    }
-    
-}
-
-
-#endif
-
+/**
+* @mainpage STTNet C++ Framework
+* @author StephenTaam(1356597983@qq.com)
+* @version 0.5.0
+* @date 2026-01-09
+*/
+#ifndef PUBLIC_H
+#define PUBLIC_H 1
+#include<jsoncpp/json/json.h>
+#include<string_view>
+#include<string>
+#include<atomic>
+#include<iostream>
+#include<unistd.h>
+#include<sys/stat.h>
+#include<fstream>
+#include<fcntl.h>
+#include<sstream>
+#include<mutex>
+#include<chrono>
+#include<iomanip>
+#include<random>
+#include<cmath>
+#include<thread>
+#include<openssl/sha.h>
+#include<netdb.h>
+#include<arpa/inet.h>
+#include<sys/types.h>
+#include<sys/socket.h>
+#include<cstring>
+#include<openssl/bio.h>
+#include<openssl/evp.h>
+#include<openssl/buffer.h>
+#include<functional>
+#include<list>
+#include<queue>
+#include<sys/epoll.h> 
+#include<condition_variable>
+#include <regex>
+#include<unordered_map>
+#include <openssl/ssl.h>
+#include <openssl/err.h>
+#include<openssl/rand.h>
+#include<openssl/crypto.h>
+#include<signal.h>
+#include<sys/ipc.h>
+#include<sys/sem.h>
+#include<sys/wait.h>
+#include<sys/shm.h>
+#include<type_traits>
+#include<charconv>
+#include<any>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <vector>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <linux/futex.h>
+#include <deque>
+#include <poll.h>
+#include <sys/uio.h>
+#include <sys/sendfile.h>
+#include <sys/un.h>
+#include <netinet/tcp.h>
+#include <spawn.h>
+#include <sys/resource.h>
+/**
+* @namespace stt
+*/
+
+namespace stt
+{
+
+    namespace system
+    {
+        class WorkerPool;
+
+/**
+ * @brief Lock-free bounded MPSC queue (Multi-Producer Single-Consumer)
+ *        无锁有界多生产者单消费者队列（环形缓冲）
+ *
+ * - Multiple threads may push concurrently.
+ * - Only ONE thread may pop.
+ *
+ * - 多个线程可以同时 push
+ * - 仅允许一个线程 pop（通常是 reactor 线程）
+ *
+ * Design:
+ * - Fixed-size ring buffer (power-of-two capacity)
+ * - Per-slot sequence number to coordinate producers/consumer
+ *
+ * 特点：
+ * - 零 malloc/零 free（不为每个元素分配 Node）
+ * - cache 友好
+ * - push/pop 只用原子 + 轻量自旋
+ *
+ * IMPORTANT:
+ *  ❗ Capacity must be a power of two.
+ *  ❗ pop() must be called by only one thread.
+ *
+ * 重要：
+ *  ❗ 容量必须是 2 的幂
+ *  ❗ pop 只能由一个线程调用
+ */
+template <typename T>
+class MPSCQueue {
+public:
+    /**
+     * @param capacity_pow2 capacity, must be a power of two
+     *        容量（必须为 2 的幂）
+     * @param blocking true: enable wait_pop(); every push then checks whether the consumer is asleep and wakes it
+     *        true：开启 wait_pop()，之后每次 push 都会检查消费者是否睡眠并唤醒它（默认为 false）
+     */
+    explicit MPSCQueue(std::size_t capacity_pow2, bool blocking = false)
+        : capacity_(capacity_pow2),
+          mask_(capacity_pow2 - 1),
+          blocking_(blocking),
+          buffer_(capacity_pow2),
+          head_(0),
+          tail_(0)
+    {
+        // capacity must be power of two
+        if (capacity_ < 2 || (capacity_ & mask_) != 0) {
+            // You can replace with your own assert/log
+            throw std::invalid_argument("MPSCQueue capacity must be power of two and >= 2");
+        }
+
+        // Initialize per-slot sequence
+        for (std::size_t i = 0; i < capacity_; ++i) {
+            buffer_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MPSCQueue(const MPSCQueue&) = delete;
+    MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+    ~MPSCQueue() {
+        // Drain remaining items to call destructors if needed
+        T tmp;
+        while (pop(tmp)) {}
+    }
+
+    /**
+     * @brief Try push (non-blocking). Returns false if queue is full.
+     *        尝试入队（非阻塞），队列满则返回 false
+     */
+    bool push(T&& v) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        return emplace_impl(std::move(v));
+    }
+
+    bool push(const T& v) noexcept(std::is_nothrow_copy_constructible_v<T>) {
+        return emplace_impl(v);
+    }
+
+    /**
+     * @brief Try pop (single consumer). Returns false if empty.
+     *        尝试出队（单消费者），空则返回 false
+     */
+    bool pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T> &&
+                              std::is_nothrow_move_constructible_v<T>)
+    {
+        Slot& slot = buffer_[head_ & mask_];
+        const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+        const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(head_ + 1);
+
+        if (dif != 0) {
+            // seq != head+1 => empty
+            return false;
+        }
+
+        // Move out
+        out = std::move(*slot.ptr());
+
+        // Destroy in-place
+        slot.destroy();
+
+        // Mark slot as free for producers:
+        // seq = head + capacity
+        slot.seq.store(head_ + capacity_, std::memory_order_release);
+
+        ++head_;
+        return true;
+    }
+
+    /**
+     * @brief Pop up to max items in one call (single consumer). Returns the number popped.
+     *        批量出队（单消费者），一次最多取 max 个，返回取到的个数
+     *
+     * Stops at the first slot that is not ready yet, so items keep FIFO order.
+     * 遇到第一个还没发布的槽就停止，保持先进先出
+     */
+    std::size_t pop_bulk(T* out, std::size_t max) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        std::size_t n = 0;
+        while (n < max) {
+            Slot& slot = buffer_[head_ & mask_];
+            if (slot.seq.load(std::memory_order_acquire) != head_ + 1)
+                break;
+            out[n++] = std::move(*slot.ptr());
+            slot.destroy();
+            slot.seq.store(head_ + capacity_, std::memory_order_release);
+            ++head_;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Pop, blocking up to timeout_ms when empty (single consumer, blocking mode only).
+     *        阻塞出队（单消费者，仅 blocking 模式），队列空时最多等待 timeout_ms 毫秒（<0 表示一直等）
+     * @return true if an item was popped, false on timeout
+     *
+     * Spins briefly first, then sleeps on a futex that producers only signal while the consumer is asleep.
+     * 先短暂自旋，再睡在 futex 上；只有消费者睡着时生产者才会发起唤醒
+     */
+    bool wait_pop(T& out, int timeout_ms = -1)
+    {
+        for (int spin = 0; spin < 64; ++spin) {
+            if (pop(out))
+                return true;
+            std::this_thread::yield();
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+        for (;;) {
+            sleeping_.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (pop(out)) {
+                sleeping_.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            struct timespec ts;
+            struct timespec *tsp = nullptr;
+            if (timeout_ms >= 0) {
+                auto left = deadline - std::chrono::steady_clock::now();
+                if (left <= std::chrono::steady_clock::duration::zero()) {
+                    sleeping_.store(0, std::memory_order_relaxed);
+                    return false;
+                }
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+                ts.tv_sec = ns / 1000000000;
+                ts.tv_nsec = ns % 1000000000;
+                tsp = &ts;
+            }
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sleeping_), FUTEX_WAIT_PRIVATE, 1, tsp, nullptr, 0);
+            sleeping_.store(0, std::memory_order_relaxed);
+            if (pop(out))
+                return true;
+        }
+    }
+
+    /**
+     * @brief Approximate size (may be inaccurate under concurrency)
+     *        近似长度（并发下可能不精确）
+     */
+    std::size_t approx_size() const noexcept {
+        const std::size_t t = tail_.load(std::memory_order_relaxed);
+        const std::size_t h = head_; // consumer-only
+        return (t >= h) ? (t - h) : 0;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        bool has_value = false;
+
+        T* ptr() noexcept { return reinterpret_cast<T*>(&storage); }
+        const T* ptr() const noexcept { return reinterpret_cast<const T*>(&storage); }
+
+        template <class U>
+        void construct(U&& v) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+            ::new (static_cast<void*>(&storage)) T(std::forward<U>(v));
+            has_value = true;
+        }
+
+        void destroy() noexcept {
+            if (has_value) {
+                ptr()->~T();
+                has_value = false;
+            }
+        }
+    };
+
+    template <class U>
+    bool emplace_impl(U&& v) noexcept(std::is_nothrow_constructible_v<T, U&&>) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+
+        for (;;) {
+            Slot& slot = buffer_[pos & mask_];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            const std::intptr_t dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+            if (dif == 0) {
+                // slot is free for this pos
+                if (tail_.compare_exchange_weak(
+                        pos, pos + 1,
+                        std::memory_order_relaxed,
+                        std::memory_order_relaxed))
+                {
+                    // We own this slot now
+                    slot.construct(std::forward<U>(v));
+                    // Publish to consumer: seq = pos+1 means "ready"
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    if (blocking_)
+                        wake_consumer();
+                    return true;
+                }
+                // CAS failed: pos updated with current tail; retry
+            } else if (dif < 0) {
+                // slot seq < pos => queue is full (producer wrapped)
+                return false;
+            } else {
+                // Another producer is ahead; move pos forward
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Pairs with the consumer's "mark asleep, then re-check" in wait_pop
+    // 和 wait_pop 里"先标记睡眠再检查"配对，保证不漏唤醒
+    void wake_consumer() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) != 0 && sleeping_.exchange(0) != 0)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sleeping_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
+private:
+    // Read-mostly, shared by everyone
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    const bool blocking_;
+    std::vector<Slot> buffer_;
+
+    // Single consumer only; own cache line so producers' CAS on tail_ does not invalidate it
+    // 单消费者独占一条 cache line，生产者 CAS tail_ 时不会连带失效
+    alignas(64) std::size_t head_;
+    std::atomic<uint32_t> sleeping_{0};
+
+    // Multi-producer
+    alignas(64) std::atomic<std::size_t> tail_;
+    char pad_[64 - sizeof(std::atomic<std::size_t>)];
+};
+
+/**
+ * @brief Lock-free bounded SPSC queue (Single-Producer Single-Consumer)
+ *        无锁有界单生产者单消费者队列（环形缓冲）
+ *
+ * - Exactly ONE thread may push and ONE thread may pop.
+ * - 只允许一个线程 push、一个线程 pop
+ *
+ * Design:
+ * - Slots are constructed once and reused by move-assignment
+ * - head/tail live on separate cache lines; each side caches the other's index
+ *   and only reloads it when the ring looks full/empty
+ *
+ * 特点：
+ * - 生产者和消费者各自只写自己的下标，没有 CAS
+ * - 适合每个线程一个的暂存队列
+ *
+ * IMPORTANT:
+ *  ❗ Capacity must be a power of two.
+ *
+ * 重要：
+ *  ❗ 容量必须是 2 的幂
+ */
+template <typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(std::size_t capacity_pow2)
+        : capacity_(capacity_pow2),
+          mask_(capacity_pow2 - 1),
+          buffer_(capacity_pow2)
+    {
+        if (capacity_ < 2 || (capacity_ & mask_) != 0) {
+            throw std::invalid_argument("SPSCQueue capacity must be power of two and >= 2");
+        }
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * @brief Try push (producer thread only). Returns false if queue is full.
+     *        尝试入队（仅生产者线程），队列满则返回 false
+     */
+    bool push(T&& v) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const std::size_t t = tail_.load(std::memory_order_relaxed);
+        if (t - headCache_ == capacity_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (t - headCache_ == capacity_)
+                return false;
+        }
+        buffer_[t & mask_] = std::move(v);
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Try pop (consumer thread only). Returns false if empty.
+     *        尝试出队（仅消费者线程），空则返回 false
+     */
+    bool pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const std::size_t h = head_.load(std::memory_order_relaxed);
+        if (h == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (h == tailCache_)
+                return false;
+        }
+        out = std::move(buffer_[h & mask_]);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate size (may be inaccurate under concurrency)
+     *        近似长度（并发下可能不精确）
+     */
+    std::size_t approx_size() const noexcept {
+        const std::size_t t = tail_.load(std::memory_order_acquire);
+        const std::size_t h = head_.load(std::memory_order_acquire);
+        return (t >= h) ? (t - h) : 0;
+    }
+
+private:
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::vector<T> buffer_;
+
+    // Consumer side
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t tailCache_ = 0;
+
+    // Producer side
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t headCache_ = 0;
+};
+
+
+    }
+    /**
+    * @namespace stt::file
+    * @brief 文件相关：文件读写，日志等
+    * @ingroup stt
+    */
+    namespace file
+    {
+    /**
+    * @brief 提供文件操作的静态函数工具类
+    */
+    class FileTool
+    {
+    public:
+        /**
+        * @brief 新建一个目录
+        * @param ddir 目录路径，可以绝对路径也可以相对路径
+        * @param mode 位掩码表示新建目录的权限（默认为0775 即rwx rwx r-x）
+        * @return true 操作成功
+        * @return false 操作失败
+        */
+        static bool createDir(const std::string & ddir,const mode_t &mode=0775); 
+        /**
+        * @brief 复制文件
+        * @param sourceFile 源文件路径，可以绝对路径也可以相对路径
+        * @param objectFile 目标文件路径，可以绝对路径也可以相对路径
+        * @return true 操作成功
+        * @return false 操作失败
+        * @note 不会自动创造不存在的路径
+        */
+        static bool copy(const std::string &sourceFile,const std::string &objectFile);
+        /**
+        * @brief 新建一个文件
+        * @param filePath 文件路径，可以绝对路径也可以相对路径
+        * @param mode 位掩码表示新建文件的权限（默认为0666 即rw- rw- rw-）
+        * @return true 操作成功
+        * @return false 操作失败
+        * @note 会自动创造原本不存在的路径
+        */
+        static bool createFile(const std::string &filePath,const mode_t &mode=0666);
+        /**
+        * @brief 获取文件大小
+        * @param fileName 文件名字（可以填绝对路径也可以填相对路径）
+        * @return >=0 返回文件大小
+        * @return -1 获取文件大小失败
+        */
+        static size_t get_file_size(const std::string &fileName);
+    };
+    
+    /**
+    * @brief 记录文件和线程关系的结构体
+    * @note 用于在后续类中使用，保证线程安全
+    */
+    struct FileThreadLock
+    {
+        /**
+        * @brief 文件路径
+        */
+        std::string loc;
+        /**
+        * @brief 记录文件正在被多少个线程使用
+        */
+        int threads;
+        /**
+        * @brief 此文件的锁
+        */
+        std::mutex lock;
+        /**
+        * @brief 这个结构体的构造函数
+        * @param loc 传入路径构造结构体对象
+        * @param threads 传入文件被多少个线程使用的数量构造结构体对象
+        */
+        FileThreadLock(const std::string &loc,const int &threads):loc(loc),threads(threads){};
+    };
+
+    /**
+    * @brief 读写磁盘文件的类
+    * @note 1、本类的同一个对象能确保同步性和线程安全
+    * @note 2、如果用本类的对象操作同一个文件也能保证同步性。但注意打开的时候统一这个文件的路径，要么用绝对路径，要么用相对路径。
+    * @note 3、这个类操作文件的时候有两种模式：1，读取磁盘+操作内存的数据+保存到磁盘；这三步分开做，适合自定义复杂操作的场景。 2，把三步操作合并成一步操作完成
+    */
+    class File:private FileTool
+    {
+    protected:
+        static std::mutex l1;
+        static std::unordered_map<std::string,FileThreadLock> fl2;
+    protected:
+        std::mutex che;
+        
+    private:
+        void lockfl2();
+        void unlockfl2();
+    private:
+        std::ifstream fin;
+        std::vector<std::string> data;
+        std::vector<std::string> backUp;
+        char *data_binary=nullptr;
+        char *backUp_binary=nullptr;
+        size_t size1=0;
+        size_t size2=0;
+        int multiple=0;
+        size_t multiple_backup=0;
+        size_t malloced=0;
+        std::mutex fl1;
+        
+        std::ofstream fout;
+        std::string fileName;
+	    
+        std::string fileNameTemp;
+        bool flag=false;
+        bool binary;
+        mode_t mode;
+        size_t size=0;
+        uint64_t totalLines=0;
+    private:
+        void toMemory();
+        bool toDisk();
+    public:
+        /**
+        * @brief 打开文件
+        * @param fileName 打开文件的名字（可以用绝对路径或者相对路径）
+        * @param create true：当文件不存在的时候创建文件（以及目录） false：当文件不存在的时候不创建文件 （默认为true）
+        * @param multiple 当>=1的时候启用二进制打开文件，这个值为需要操作文件所需的预定的文件空间大小和原文件大小的比值  当<1的时候采用文本模式打开文件 （默认为0 文本模式打开）
+        * @param size 手动填入所需的预定文件空间的大小，当这个参数非0时，不会采用multiple的倍数预留值而是直接用这个预定大小 （单位字节）（默认为0）
+        * @param mode 如果create为true，且文件不存在，用位掩码表示新建文件的权限（默认为0666 rw- rw- rw-）
+        * @return true:打开成功
+        * @return false:打开失败
+        * @note 任何操作都需要先打开文件
+        * @warning 如果二进制模式下预留的空间太小，可能会导致段错误
+        *
+        * 示例代码 1： 文本模式打开和程序同一路径下名为"test"的文件
+        *
+        * @code
+        * File f; 
+        * f.openFile("test");
+        * @endcode
+        *
+        * 示例代码 2： 二进制模式下打开和程序同一路径下名为"test"的文件,计划只读
+        *
+        * @code
+        * File f; 
+        * f.openFile("test",true,1); //只读说明预留空间是原来的一倍（和原来一样）即可 
+        * @endcode
+        *
+        * 示例代码 3： 二进制模式下打开和程序同一路径下名为"test"的文件,预计会写入数据，写入后大小不大于原来文件大小的两倍
+        *
+        * @code
+        * File f; 
+        * f.openFile("test",true,2); //留出两倍的空间
+        * @endcode
+        *
+        * 示例代码 4： 二进制模式下打开和程序同一路径下名为"test"的文件,预计会写入数据，写入大小不大于1024字节，原文件大小为0
+        *
+        * @code
+        * File f; 
+        * f.openFile("test",true,1,1024);//由于文件大小为0，代表倍数的第三个参数multiple填入多少都是无效的，需要手动指定大小
+        * @endcode
+        */
+        bool openFile(const std::string &fileName,const bool &create=true,const int &multiple=0,const size_t &size=0,const mode_t &mode=0666);
+        /** 关闭文件
+        * @brief 关闭已打开了的文件
+        * @param del true:删除文件 false：不删除文件 （默认为false）
+        * @return true:操作成功 false：操作失败
+        */
+        bool closeFile(const bool &del=false);
+        /**
+        * @brief 析构函数
+        * @note 默认对象生命周期结束时关闭文件，不删除文件。
+        */
+        ~File(){closeFile(false);}
+        /**
+        * @brief 判断对象是否打开了文件
+        * @return true：对象打开了文件 false：对象没有打开文件
+        */
+        bool isOpen(){return flag;}
+        /**
+        * @brief 判断对象是否以二进制模式打开文件
+        * @return true：对象以二进制模式打开文件  false：对象不以二进制模式打开文件
+        */
+        bool isBinary(){return binary;}
+        /**
+        * @brief 获取打开的文件名字
+        * @return 返回一个打开的文件的名字的字符串
+        */
+        std::string getFileName(){return fileName;}
+        /**
+        * @brief 获取打开的文件的行数
+        * @return 返回打开的文件的行数
+        * @warning 1，只有在文本模式下打开才可能返回正确的值
+        * @warning 2，获取的是上一次读入内存的时候的文件的行数
+        * @warning 3，如果没有把文件读入过内存，返回的值不会是正确的
+        * @note 这个函数也许只有在操作内存数据的时候有作用
+        */
+        uint64_t getFileLine(){return totalLines;}
+        /**
+        * @brief 获取二进制打开的文件的大小
+        * @return 返回二进制打开的文件的大小
+        * @warning 1，只有在二进制模式下打开才可能返回正确的值
+        * @warning 2，获取的是上一次读入内存的时候的文件的大小
+        * @warning 3，如果没有把文件读入过内存，返回的值不会是正确的
+        * @note 这个函数也许只有在操作内存数据的时候有作用
+        */
+        size_t getFileSize(){return size;}
+        /**
+        * @brief 获取二进制打开的文件在内存中的大小
+        * @return 返回二进制打开的文件在内存中的大小
+        * @warning 1，只有在二进制模式下打开才可能返回正确的值
+        * @warning 2，获取的是此时内存中操作的文件的大小
+        * @warning 3，如果没有把文件读入过内存，返回的值不会是正确的
+        * @note 这个函数只有在操作内存数据的时候有作用
+        */
+        size_t getSize1(){return size1;}
+    public:
+        /**
+        * @brief 把数据从磁盘读入内存
+        * @return true 操作成功
+        * @return false 操作失败
+        */
+        bool lockMemory();
+        /**
+        * @brief 把数据从内存写入磁盘
+        * @param rec false 不回退操作，把操作结果保存入磁盘； true 回退操作，不保存。（默认为false 不需要回退）。
+        * @return true 操作成功
+        * @return false 操作失败
+        * @note 如果写入磁盘失败会自动回退操作
+        */     
+        bool unlockMemory(const bool &rec=false);
+    public:
+        /**
+        * @name 操作内存中的数据的函数-文本模式
+        * @{
+        */
+        /**
+        * @brief 查找行
+        * @note 1、查找文件导入内存的数据中存在目标字符串的首行
+        * @note 2、行数从1开始
+        * @param targetString 需要查找的字符串
+        * @param linePos 从指定行开始寻找（默认从第一行开始）
+        * @return >=1 返回匹配的行数
+        * @return -1 查找失败
+        */
+        int findC(const std::string &targetString,const int linePos=1);
+        /**
+        * @brief 插入行
+        * @note 1、在文件导入内存的数据中插入一行
+        * @note 2、行数从1开始
+        * @param data 需要插入的数据
+        * @param linePos 在指定行插入（默认从末尾插入）
+        * @return true 插入成功
+        * @return false 插入失败
+        */
+        bool appendLineC(const std::string &data,const int &linePos=0);
+        /**
+        * @brief 删除行
+        * @note 1、删除文件导入内存的数据中的一行
+        * @note 2、行数从1开始
+        * @param linePos 需要删除的行
+        * @return true 删除成功
+        * @return false 删除失败
+        */
+        bool deleteLineC(const int &linePos=0);
+        /**
+        * @brief 删除全部
+        * @note 删除文件导入内存的数据中的全部
+        * @return true 删除成功
+        * @return false 删除失败
+        */
+        bool deleteAllC();
+        /**
+        * @brief 修改行
+        * @note 1、修改文件导入内存的数据中的一行
+        * @note 2、行数从1开始
+        * @param data 覆盖到指定行的数据
+        * @param linePos 需要覆盖的行（默认最后一行）
+        * @return true 修改成功
+        * @return false 修改失败
+        */
+        bool chgLineC(const std::string &data,const int &linePos=0);
+        /**
+        * @brief 读取单行
+        * @note 1、读取文件导入内存的数据中的单行
+        * @note 2、行数从1开始
+        * @param data 接收数据的字符串容器
+        * @param linePos 读取的行
+        * @return true 读取成功
+        * @return false 读取失败
+        */
+        bool readLineC(std::string &data,const int linePos);
+        /**
+        * @brief 读取行
+        * @note 1、连续读取文件导入内存的数据中的n行
+        * @note 2、行数从1开始
+        * @param data 接收数据的字符串容器
+        * @param linePos 读取的起始位置
+        * @param num 读取的行的数量
+        * @return 字符串参数data的引用
+        */
+        std::string& readC(std::string &data,const int &linePos,const int &num);
+        /**
+        * @brief 读取全部
+        * @note 读取文件导入内存的数据中的全部
+        * @param data 接收数据的字符串容器
+        * @return 字符串参数data的引用
+        */
+        std::string& readAllC(std::string &data);
+        /** @} */
+        /**
+        * @name 操作内存中的数据的函数-二进制模式
+        * @{
+        */
+        /**
+        * @brief 读取数据块
+        * @note 1、读取文件导入内存的数据中的一块数据
+        * @note 2、数据字节单元从0开始
+        * @param data 接收数据的容器
+        * @param pos 数据起始位置
+        * @param size 数据块大小
+        * @return bool 读取成功
+        * @return false 读取失败
+        */
+        bool readC(char *data,const size_t &pos,const size_t &size);
+        /**
+        * @brief 写数据块
+        * @note 1、往文件导入内存的数据中写入一块数据
+        * @note 2、数据字节单元从0开始
+        * @param data 装着写入数据的容器
+        * @param pos 写入位置
+        * @param size 写入数据块大小
+        * @return bool 写入成功
+        * @return false 写入失败
+        */
+        bool writeC(const char *data,const size_t &pos,const size_t &size);
+        /**
+        * @brief 格式化数据
+        * @note 把文件导入内存的数据全部删除
+        */
+        bool formatC();
+        /** @} */
+    public:
+        /**
+        * @name 直接操作磁盘数据的函数-文本模式
+        * @{
+        */
+        /**
+        * @brief 查找行
+        * @note 1、查找文件中存在目标字符串的首行
+        * @note 2、行数从1开始
+        * @param targetString 需要查找的字符串
+        * @param linePos 从指定行开始寻找（默认从第一行开始）
+        * @return >=1 返回匹配的行数
+        * @return -1 查找失败
+        */
+        int find(const std::string &targetString,const int linePos=1);
+        /**
+        * @brief 插入行
+        * @note 1、在文件中插入一行
+        * @note 2、行数从1开始
+        * @param data 需要插入的数据
+        * @param linePos 在指定行插入（默认从末尾插入）
+        * @return true 插入成功
+        * @return false 插入失败
+        */
+        bool appendLine(const std::string &data,const int &linePos=0);
+        /**
+        * @brief 删除行
+        * @note 1、删除文件中的一行
+        * @note 2、行数从1开始
+        * @param linePos 需要删除的行
+        * @return true 删除成功
+        * @return false 删除失败
+        */
+        bool deleteLine(const int &linePos=0);
+        /**
+        * @brief 删除全部
+        * @note 删除文件中的全部行
+        * @return true 删除成功
+        * @return false 删除失败
+        */
+        bool deleteAll();
+        /**
+        * @brief 修改行
+        * @note 1、修改文件中的一行
+        * @note 2、行数从1开始
+        * @param data 覆盖到指定行的数据
+        * @param linePos 需要覆盖的行（默认最后一行）
+        * @return true 修改成功
+        * @return false 修改失败
+        */
+        bool chgLine(const std::string &data,const int &linePos=0);
+        /**
+        * @brief 读取单行
+        * @note 1、读取文件中的单行
+        * @note 2、行数从1开始
+        * @param data 接收数据的字符串容器
+        * @param linePos 读取的行
+        * @return true 读取成功
+        * @return false 读取失败
+        */
+        bool readLine(std::string &data,const int linePos);
+        /**
+        * @brief 读取行
+        * @note 1、连续读取文件中的n行
+        * @note 2、行数从1开始
+        * @param data 接收数据的字符串容器
+        * @param linePos 读取的起始位置
+        * @param num 读取的行的数量
+        * @return 字符串参数data的引用
+        */
+        std::string& read(std::string &data,const int &linePos,const int &num);
+        /**
+        * @brief 读取全部
+        * @note 读取文件中的全部
+        * @param data 接收数据的字符串容器
+        * @return 字符串参数data的引用
+        */
+        std::string& readAll(std::string &data);
+        /** @} */
+        /**
+        * @name 直接操作磁盘数据的函数-二进制模式
+        * @{
+        */
+        /**
+        * @brief 读取数据块
+        * @note 1、读取文件中的一块数据
+        * @note 2、数据字节单元从0开始
+        * @param data 接收数据的容器
+        * @param pos 数据起始位置
+        * @param size 数据块大小
+        * @return bool 读取成功
+        * @return false 读取失败
+        */
+        bool read(char *data,const size_t &pos,const size_t &size);
+        /**
+        * @brief 写数据块
+        * @note 1、往文件中写入一块数据
+        * @note 2、数据字节单元从0开始
+        * @param data 装着写入数据的容器
+        * @param pos 写入位置
+        * @param size 写入数据块大小
+        * @return bool 写入成功
+        * @return false 写入失败
+        */
+        bool write(const char *data,const size_t &pos,const size_t &size);
+        /**
+        * @brief 格式化数据
+        * @note 把文件的数据全部删除
+        */
+        void format();
+        /** @} */
+    };
+    }
+    /**
+    * @namespace stt::time
+    * @brief 时间相关操作，基础时间工具
+    * @ingroup stt
+    */
+    namespace time
+    {
+    /**
+    * @brief 表示时间间隔的结构体，支持天、小时、分钟、秒和毫秒粒度。
+    * @note 1、提供了对时间间隔的基本操作，如加减运算、比较操作、单位转换等。
+    * @note 2、本结构体并不表示绝对时间点，仅用于表示两个时间点之间的差值。
+    * @note 3、内部实现采用多个字段组合，而非统一的时间戳，以提高可读性和可控性。
+    */
+    struct Duration
+    {
+        /**
+        * @brief 天
+        */
+        long long day;
+        /**
+        * @brief 时
+        */
+        int hour;
+        /**
+        * @brief 分
+        */
+        int min;
+        /**
+        * @brief 秒
+        */
+        int sec;
+        /**
+        * @brief 毫秒
+        */
+        int msec;
+        /**
+        * @brief 构造函数，传入天，时，分，秒，毫秒
+        */
+        Duration(long long a,int b,int c,int d,int e):day(a),hour(b),min(c),sec(d),msec(e){}
+        Duration()=default;
+        /**
+        * @brief 判断当前时间间隔是否大于另一个时间间隔。
+        * @param b 要比较的另一个 Duration 实例。
+        * @return 如果当前对象大于参数 b，返回 true，否则返回 false。
+        */
+        bool operator>(const Duration &b)
+        {
+            long long total;
+            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
+            long long totalB;
+            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
+            if(total>totalB)
+                return true;
+            else
+                return false;
+        }
+        /**
+        * @brief 判断当前时间间隔是否小于另一个时间间隔。
+        * @param b 要比较的另一个 Duration 实例。
+        * @return 如果当前对象小于参数 b，返回 true，否则返回 false。
+        */
+        bool operator<(const Duration &b)
+        {
+            long long total;
+            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
+            long long totalB;
+            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
+            if(total<totalB)
+                return true;
+            else
+                return false;
+        }
+        /**
+        * @brief 判断当前时间间隔是否等于另一个时间间隔。
+        * @param b 要比较的另一个 Duration 实例。
+        * @return 如果当前对象等于参数 b，返回 true，否则返回 false。
+        */
+        bool operator==(const Duration &b)
+        {
+            long long total;
+            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
+            long long totalB;
+            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
+            if(total==totalB)
+                return true;
+            else
+                return false;
+        }
+        /**
+        * @brief 判断当前时间间隔是否大于等于另一个时间间隔。
+        * @param b 要比较的另一个 Duration 实例。
+        * @return 如果当前对象大于等于参数 b，返回 true，否则返回 false。
+        */
+        bool operator>=(const Duration &b)
+        {
+            long long total;
+            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
+            long long totalB;
+            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
+            if(total>=totalB)
+                return true;
+            else
+                return false;
+        }
+        /**
+        * @brief 判断当前时间间隔是否小于等于另一个时间间隔。
+        * @param b 要比较的另一个 Duration 实例。
+        * @return 如果当前对象小于等于参数 b，返回 true，否则返回 false。
+        */
+        bool operator<=(const Duration &b)
+        {
+            long long total;
+            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
+            long long totalB;
+            totalB=b.day*24*60*60*1000+b.hour*60*60*1000+b.min*60*1000+b.sec*1000+b.msec;
+            if(total<=totalB)
+                return true;
+            else
+                return false;
+        }
+        /**
+        * @brief 将两个时间间隔相加。
+        * @param b 要相加的另一个 Duration。
+        * @return 相加后的 Duration。
+        */
+        Duration operator+(const Duration &b)
+        {
+            long long dayy=day;
+            int hourr=hour;
+            int minn=min;
+            int secc=sec;
+            int msecc=msec;
+
+            msecc+=b.msec;
+            secc+=b.sec;
+            minn+=b.min;
+            hourr+=b.hour;
+            dayy+=b.day;
+
+            if(msecc/1000!=0)
+            {
+                secc+=msecc/1000;
+                msecc=msecc%1000;
+            }
+
+            if(secc/60!=0)
+            {
+                minn+=secc/60;
+                secc=secc%60;
+            }
+
+            if(minn/60!=0)
+            {
+                hourr+=minn/60;
+                minn=minn%60;
+            }
+
+            if(hourr/24!=0)
+            {
+                dayy+=hourr/24;
+                hourr=hourr%24;
+            }
+            return Duration(dayy,hourr,minn,secc,msecc);
+        }
+        /**
+        * @brief 计算两个时间间隔的差值（当前对象减去参数 b）。
+        * @param b 要减去的另一个 Duration。
+        * @return 差值 Duration。
+        */
+        Duration operator-(const Duration &b)
+        {
+            long long dayy=day;
+            int hourr=hour;
+            int minn=min;
+            int secc=sec;
+            int msecc=msec;
+
+            msecc=dayy*24*60*60*1000+hourr*60*60*1000+minn*60*1000+secc*1000+msecc-b.day*24*60*60*1000-b.hour*60*60*1000-b.min*60*1000-b.sec*1000-b.msec;
+            secc=0;
+            minn=0;
+            hourr=0;
+            dayy=0;
+
+            if(msecc/1000!=0)
+            {
+                secc+=msecc/1000;
+                msecc=msecc%1000;
+            }
+
+            if(secc/60!=0)
+            {
+                minn+=secc/60;
+                secc=secc%60;
+            }
+
+            if(minn/60!=0)
+            {
+                hourr+=minn/60;
+                minn=minn%60;
+            }
+
+            if(hourr/24!=0)
+            {
+                dayy+=hourr/24;
+                hourr=hourr%24;
+            }
+            return Duration(dayy,hourr,minn,secc,msecc);
+        }
+        
+        /**
+        * @brief 将当前时间间隔转换为以“天”为单位的浮点数表示。
+        */
+        double convertToDay()
+        { 
+            long long total;
+            total=hour*60*60*1000+min*60*1000+sec*1000+msec; 
+            double k=day+total/86400000.0000;
+            return k;
+        }
+        /**
+        * @brief 将当前时间间隔转换为以“小时”为单位的浮点数表示。
+        */
+        double convertToHour()
+        {
+            long long total;
+            total=min*60*1000+sec*1000+msec; 
+            double k=day*24+hour+total/36000000.0000;
+            return k;
+        }
+        /**
+        * @brief 将当前时间间隔转换为以“分钟”为单位的浮点数表示。
+        */
+        double convertToMin()
+        {
+            long long total;
+            total=sec*1000+msec; 
+            double k=day*24*60+hour*60+min+total/60000.0000;
+            return k;
+        }
+        /**
+        * @brief 将当前时间间隔转换为以“秒”为单位的浮点数表示。
+        */
+        double convertToSec()
+        {
+            long long total;
+            total=msec; 
+            double k=day*24*60*60+hour*60*60+min*60+sec+total/1000.0000;
+            return k;
+        }
+        /**
+         * @brief 将当前时间间隔转换为总毫秒数。
+        */
+        long long convertToMsec()
+        {
+            long long total;
+            total=day*24*60*60*1000+hour*60*60*1000+min*60*1000+sec*1000+msec;
+            return total;
+        }
+        /**
+        * @brief 从给定的毫秒数恢复为标准的天-时-分-秒-毫秒格式。
+        * @param t 要恢复的毫秒值。
+        * @return 转换后的 Duration。
+        */
+        Duration recoverForm(const long long &t)
+        {
+            msec=t;
+            sec=0;
+            min=0;
+            hour=0;
+            day=0;
+
+            if(msec/1000!=0)
+            {
+                sec+=msec/1000;
+                msec=msec%1000;
+            }
+
+            if(sec/60!=0)
+            {
+                min+=sec/60;
+                sec=sec%60;
+            }
+
+            if(min/60!=0)
+            {
+                hour+=min/60;
+                min=min%60;
+            }
+
+            if(hour/24!=0)
+            {
+                day+=hour/24;
+                hour=hour%24;
+            }
+            return Duration(day,hour,min,sec,msec);
+        }
+    };
+    /**
+    * @brief 将 Duration 对象以可读格式输出到流中。
+    *
+    * 该函数用于将 Duration 的各个字段（天、小时、分钟、秒、毫秒）格式化后输出到给定的输出流中。
+    *
+    * @param os 输出流（如 std::cout）。
+    * @param a 要输出的 Duration 对象。
+    * @return 输出流的引用，用于链式输出。
+    *
+    * @note 通常输出格式为类似于 "1d 02:03:04.005" 的人类可读格式（具体取决于实现）。
+    */
+    std::ostream& operator<<(std::ostream &os,const Duration &a);
+
+    using Milliseconds = std::chrono::duration<uint64_t,std::milli>;
+    using Seconds=std::chrono::duration<uint64_t>;
+    /**
+    * @brief 定义ISO8086A这个宏为"yyyy-mm-ddThh:mi:ss"
+    */
+    #define ISO8086A "yyyy-mm-ddThh:mi:ss"
+    /**
+    * @brief 定义ISO8086B这个宏为"yyyy-mm-ddThh:mi:ss.sss"
+    */
+    #define ISO8086B "yyyy-mm-ddThh:mi:ss.sss"
+
+
+    /**
+    * @brief 时间操作、运算、计时的类
+    * @brief 精确到毫秒
+    * @warning 只有在1970+-292年内的是确保准确的
+    * @bug 只有1970+-292年内确保准确,待优化
+    */
+    class DateTime
+    {
+    private:
+        static Duration& dTOD(const Milliseconds& d1,Duration &D1);
+        static Milliseconds& DTOd(const Duration &D1,Milliseconds& d1);
+        static std::string &toPGtimeFormat();
+        static std::chrono::system_clock::time_point strToTimePoint(const std::string &timeStr,const std::string &format=ISO8086A);
+    protected:
+        static std::string& timePointToStr(const std::chrono::system_clock::time_point &tp,std::string &timeStr,const std::string &format=ISO8086A);
+    public:
+        /**
+        * @brief 获取当前时间
+        * @note 获取当前时间，返回字符串
+        * @param timeStr 接收时间的字符串容器
+        * @param format 指定时间字符串的格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @return 返回timeStr的引用
+        */
+        static std::string& getTime(std::string &timeStr,const std::string &format=ISO8086A);
+        /**
+        * @brief 转化时间字符串的格式
+        * @note 传入时间字符串的引用修改原字符串
+        * @param timeSte 原时间字符串
+        * @param oldFormat 原时间字符串格式 （yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒）
+        * @param newFormat 新的时间格式 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @return true转化成功false 转化失败
+        */
+        static bool convertFormat(std::string &timeStr,const std::string &oldFormat,const std::string &newFormat=ISO8086A);
+        /**
+        * @brief 计算两个用字符串表示的时间相减的差值
+        * @param time1 被减的时间
+        * @param time2 减去的时间
+        * @param result 一个接收结果的Duration容器
+        * @param format1 time1的时间字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @param format2 time2的时间字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @return result的引用
+        */
+        static Duration& calculateTime(const std::string &time1,const std::string &time2,Duration &result,const std::string &format1=ISO8086A,const std::string &format2=ISO8086A);
+        /**
+        * @brief 一个用字符串表示的时间加上或者减去一段时间
+        * @param time1 待运算的时间字符串
+        * @param time2 参与运算的用Duration表示的一段时间
+        * @param result 接收用字符串表示的运算结果的string容器
+        * @param am 填入+：加法运算 填入-：减法运算
+        * @param format1 time1的格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @param format2 result的格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @return result的引用
+        */
+        static std::string& calculateTime(const std::string &time1,const Duration &time2,std::string &result,const std::string &am,const std::string &format1=ISO8086A,const std::string &format2=ISO8086A);
+        /**
+        * @brief 比较两个时间字符串表示的时间的大小
+        * @note 时间越往后越大
+        * @param time1 参与比较的第一个字符串
+        * @param time2 参与比较的第二个字符串
+        * @param format1 time1的字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @param format2 time2的字符串格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @return true：time1>=time2  false: time1<time2
+        */
+        static bool compareTime(const std::string &time1,const std::string &time2,const std::string &format1=ISO8086A,const std::string &format2=ISO8086A);
+    private:
+        Duration dt{-1,-1,-1,-1,-1};
+        bool flag=false;
+        std::chrono::steady_clock::time_point start;
+        std::chrono::steady_clock::time_point end;
+    public:
+        /**
+        * @brief 开始计时
+        * @return ture：开始成功  false：开始失败
+        */
+        bool startTiming();
+        /**
+        * @brief 计时过程中检查时间
+        * @return 返回一个Duration记录时间到目前流逝长度
+        */
+        Duration checkTime();
+        /**
+        * @brief 停止计时
+        * @return 返回一个Duration记录时间
+        * @note 对象会保存记录上一次计时的时间
+        */
+        Duration endTiming();
+    public:
+        /**
+        * @brief 获取上一次计时的时间
+        * @return 返回一个Duration记录时间
+        */
+        Duration getDt(){return dt;}
+        /**
+        * @brief 返回本对象计时状态
+        * @return true：对象正在计时  false：对象没有开始计时
+        */
+        bool isStart(){return flag;}
+    };
+    }
+    namespace file
+    {
+    /**
+    * @brief 日志级别
+    * @note 级别从低到高，日志对象只写入不低于自身级别的日志
+    */
+    enum class LogLevel
+    {
+        TRACE=0,///< 每个事件、每次读写的细节（如收到数据、心跳）
+        DEBUG=1,///< 每个连接、每个请求的处理过程（如新连接、请求处理结果）
+        INFO=2,///< 启动、退出等运行状态（默认级别）
+        WARN=3,///< 安全拦截、队列已满等需要注意的情况
+        ERROR=4,///< 监听、accept等服务级别的失败
+        OFF=5///< 关闭日志
+    };
+    /**
+    * @brief 日志落盘（fsync）策略
+    */
+    enum class LogSyncPolicy
+    {
+        NEVER=0,///< 只write到内核 由操作系统决定何时落盘（默认）
+        PER_BATCH=1,///< 每写完一批日志fdatasync一次
+        INTERVAL=2///< 距离上次落盘超过设定的间隔后，在下一批写完时fdatasync
+    };
+    /**
+    * @brief 二进制日志的格式描述
+    * @note 每个调用点一个静态对象（由STT_LOG_BIN宏生成），对象地址就是这个格式的id
+    */
+    struct LogFormat
+    {
+        const char *format;///< 格式串 用{}作为参数的占位符
+        LogLevel level;///< 日志级别
+    };
+    /**
+    * @brief 定长的二进制日志记录
+    * @note 调用点只记录格式id、原始时间戳和参数，字符串参数拷贝进记录内的定长缓冲区（超出部分截断），入队不分配内存
+    * @note 由消费者线程按格式串格式化后写入日志文件
+    */
+    struct LogRecord
+    {
+        static constexpr int MAX_ARGS=6;///< 最多参数个数
+        static constexpr int TEXT_BYTES=48;///< 所有字符串参数共用的缓冲区大小
+        enum ArgType:uint8_t{INT=0,UINT=1,DOUBLE=2,STRING=3,BOOL=4,CHAR=5};
+        const LogFormat *fmt=nullptr;
+        int64_t timestamp=0;///< system_clock的纳秒数
+        uint8_t argc=0;
+        uint8_t types[MAX_ARGS];
+        union
+        {
+            int64_t i;
+            uint64_t u;
+            double d;
+            struct{uint16_t off;uint16_t len;} s;
+        } args[MAX_ARGS];
+        uint16_t textUsed=0;
+        char text[TEXT_BYTES];
+        /**
+        * @brief 追加一个参数
+        * @param v 参数 支持整数、浮点数、bool、char、const char*、std::string、std::string_view
+        */
+        template<class T>
+        void add(const T &v)
+        {
+            using U=std::decay_t<T>;
+            if constexpr(std::is_same_v<U,bool>)
+            {
+                types[argc]=BOOL;
+                args[argc++].u=v;
+            }
+            else if constexpr(std::is_same_v<U,char>)
+            {
+                types[argc]=CHAR;
+                args[argc++].i=v;
+            }
+            else if constexpr(std::is_integral_v<U>&&std::is_signed_v<U>)
+            {
+                types[argc]=INT;
+                args[argc++].i=v;
+            }
+            else if constexpr(std::is_integral_v<U>||std::is_enum_v<U>)
+            {
+                types[argc]=UINT;
+                args[argc++].u=(uint64_t)v;
+            }
+            else if constexpr(std::is_floating_point_v<U>)
+            {
+                types[argc]=DOUBLE;
+                args[argc++].d=v;
+            }
+            else
+            {
+                addText(std::string_view(v));
+            }
+        }
+        void addText(const std::string_view &v)
+        {
+            size_t len=v.size();
+            if(len>(size_t)(TEXT_BYTES-textUsed))
+                len=TEXT_BYTES-textUsed;
+            memcpy(text+textUsed,v.data(),len);
+            types[argc]=STRING;
+            args[argc].s.off=textUsed;
+            args[argc++].s.len=len;
+            textUsed+=len;
+        }
+    };
+    /**
+    * @brief 单个写日志线程的统计
+    */
+    struct LogThreadStat
+    {
+        std::thread::id thread;///< 线程id
+        uint64_t written=0;///< 已经进入暂存队列的日志条数
+        uint64_t dropped=0;///< 暂存队列满而丢弃的日志条数
+    };
+    /**
+    * @brief 日志文件操作类
+    * @note 此类的读写日志是线程安全的，因为继承了File类
+    * @note 异步日志 会单独开一个线程进行写入操作，可以多个线程同时操作日志
+    * @note 写入线程空闲时先短暂自旋，然后阻塞在eventfd上，有新日志入队时才被唤醒
+    * @note 写日志只追加到文件末尾（O_APPEND + writev批量写入），开销和日志文件大小无关
+    */
+    class LogFile:private time::DateTime,protected File
+    {
+    private:
+        std::string timeFormat;
+        std::string contentFormat;
+        std::atomic<bool> consumerGuard{true};
+        //std::mutex queueMutex;
+        //std::condition_variable queueCV;
+        //每个写日志的线程一个单生产者暂存队列 生产者之间不再争抢同一个队尾
+        struct LogEntry
+        {
+            int64_t timestamp=0;//system_clock的纳秒数 消费者按它合并各线程的日志
+            std::string content;
+        };
+        struct ThreadRing
+        {
+            system::SPSCQueue<LogEntry> queue;
+            std::thread::id thread;
+            //只有所属线程写 消费者和统计接口读
+            alignas(64) std::atomic<uint64_t> written{0};
+            std::atomic<uint64_t> dropped{0};
+            explicit ThreadRing(const size_t &cap):queue(cap){}
+        };
+        size_t ringCapacity;
+        //保护rings 只在线程第一次写日志、回收退出线程的队列、查询统计时加锁
+        std::mutex ringMutex;
+        std::vector<std::shared_ptr<ThreadRing>> rings;
+        std::atomic<bool> ringsChanged{false};
+        uint64_t retiredWritten=0;
+        uint64_t retiredDropped=0;
+        static std::atomic<uint64_t> nextInstanceId;
+        const uint64_t instanceId=nextInstanceId++;
+        std::thread consumerThread;
+        std::atomic<int> level{(int)LogLevel::INFO};
+        //O_APPEND打开的写日志fd 消费者线程攒一批日志后用writev一次写入
+        int logFD=-1;
+        //保护logFD 清空、删除日志时会重写文件，要和写入互斥并在之后重新打开
+        std::mutex writeMutex;
+        std::atomic<int> syncPolicy{(int)LogSyncPolicy::NEVER};
+        std::atomic<int> syncIntervalMs{1000};
+        std::chrono::steady_clock::time_point lastSync;
+        //分段轮转 以下都由writeMutex保护
+        size_t rotateBytes=0;
+        bool rotateDaily=false;
+        bool compressSegments=false;
+        size_t segmentBytes=0;
+        int segmentDay=0;
+        std::string segmentFirst;//当前分段第一批日志的时间 "-"表示打开时文件里已有内容 时间未知
+        std::string segmentLast;
+        //二进制日志队列 enableBinaryLog之后才分配
+        std::atomic<system::MPSCQueue<LogRecord>*> binQueue{nullptr};
+        //消费者空闲时阻塞在这个eventfd上 只有它睡着时生产者才需要唤醒
+        int wakeFD=-1;
+        std::atomic<bool> sleeping{false};
+    private:
+        /**
+        * @brief 入队之后调用 消费者已经睡下时把它唤醒
+        */
+        void notifyConsumer()
+        {
+            //和消费者"先标记睡眠再检查队列"配对 保证不会漏掉唤醒
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if(sleeping.load(std::memory_order_relaxed)&&sleeping.exchange(false))
+            {
+                uint64_t one=1;
+                if(::write(wakeFD,&one,sizeof(one))<0){}
+            }
+        }
+        ThreadRing *threadRing();
+        bool pushEntry(std::string &&content);
+        void formatEntry(const LogEntry &e,std::string &line,std::string &time);
+        void retireRings();
+        void formatRecord(const LogRecord &r,std::string &line,std::string &time);
+        void consumer();
+        void writeBatch(std::vector<std::string> &batch,const size_t &n);
+        bool reopenLogFD();
+        void rotate(const std::string &now);
+    public:
+        /**
+         * @brief 构造函数，初始化消费者线程
+         * @param logQueue_cap 每个写日志线程的暂存队列容量（必须为 2 的幂）。
+//
+// 每个线程产生的日志会先进入自己的无锁暂存队列，再由独立 logger 线程轮流取出、按时间戳合并后批量写入文件。
+// 日志系统不在主业务热路径上，允许在过载时丢弃，以保护核心服务性能。
+//
+// 选型原则：
+//   logQueue_cap >= 峰值日志速率 × logger 最坏暂停时间
+//
+// 建议值（经验）：
+//   - 默认：8192   (~8k)
+//   - 高频日志：16384 (~16k)
+//
+// 当队列已满时：日志将丢弃，框架不会阻塞调用线程，丢弃条数按线程记录（见getThreadStats）。
+
+//
+
+
+         */
+        LogFile(const size_t &logQueue_cap=8192):ringCapacity(logQueue_cap)
+        {
+        if(logQueue_cap<2||(logQueue_cap&(logQueue_cap-1))!=0)
+            throw std::invalid_argument("LogFile queue capacity must be power of two and >= 2");
+        consumerGuard=true;
+        wakeFD=eventfd(0,EFD_CLOEXEC|EFD_NONBLOCK);
+        consumerThread = std::thread([this]()->void
+        {
+            this->consumer();
+        });
+        }
+        /**
+        * @brief 打开一个日志文件
+        * @note 不存在则创建（连带目录），默认新建的目录的权限为rwx rwx r-x，默认新建的日志文件权限为rw-，rw-，r--
+        * @param fileName 日志文件名（可以用绝对路径也可以用相对路径）
+        * @param timeFormat 日志文件中的时间格式 yyyy年 mm月 dd日 hh时 mi分 ss秒 sss毫秒 （默认格式为'yyyy-mm-ddThh:mi:ss',即ISO08086A标准）
+        * @param contentFormat 日志文件中时间和记录之间的填充格式（默认为"   " 即四个空格）
+        * @return true：打开成功  false：打开失败
+        */
+        bool openFile(const std::string &fileName,const std::string &timeFormat=ISO8086A,const std::string &contentFormat="   ");
+        /**
+        * @brief 获取对象是否打开日志文件的状态
+        * @return true：打开了  false：没打开
+        */
+        bool isOpen(){return File::isOpen();}
+        /**
+        * @brief 获取对象打开的文件名
+        * @return 返回对象打开的文件名
+        */
+        std::string getFileName(){return File::getFileName();}
+        /**
+        * @brief 关闭对象打开的日志文件
+        * @param del true：关闭并且删除日志文件   false：只关闭不删除日志文件 （默认为false 即只关闭不删除日志文件）
+        * @return true：关闭成功  false：关闭失败
+        */
+        bool closeFile(const bool &del=false);
+        /**
+        * @brief 写一行日志
+        * @param data 需要写入的日志内容
+        * @note 按INFO级别写入
+        */
+        void writeLog(const std::string &data);
+        /**
+        * @brief 按级别写一行日志
+        * @param data 需要写入的日志内容
+        * @param level 这条日志的级别 低于日志对象级别时直接丢弃 INFO以外的级别会在内容前加上[级别]标记
+        */
+        void writeLog(const std::string &data,const LogLevel &level);
+        /**
+        * @brief 设置日志对象的级别
+        * @param level 低于该级别的日志不会写入（默认为INFO）
+        * @note 运行时可随时调用 线程安全
+        */
+        void setLevel(const LogLevel &level){this->level.store((int)level,std::memory_order_relaxed);}
+        /**
+        * @brief 获取日志对象的级别
+        * @return 返回当前级别
+        */
+        LogLevel getLevel(){return (LogLevel)level.load(std::memory_order_relaxed);}
+        /**
+        * @brief 判断某个级别的日志是否会被写入
+        * @param level 日志级别
+        * @return true：会写入  false：会被丢弃
+        * @note 在构造日志字符串之前调用，避免为不会写入的日志做字符串拼接
+        */
+        bool shouldLog(const LogLevel &level){return (int)level>=this->level.load(std::memory_order_relaxed);}
+        /**
+        * @brief 清空所有日志
+        * @return true：写入成功  false：写入失败
+        */
+        bool clearLog();
+        /**
+        * @brief 删除指定时间区间内的日志
+        * @param date1 时间区间的第一个参数 （默认缺省为无限小）
+        * @param date2 时间区间的第二个参数  (默认缺省为无限大)
+        * @note 区间为[date1,date2)
+        * @return true：删除成功  false：删除失败
+        */
+        bool deleteLogByTime(const std::string &date1="1",const std::string &date2="2");
+        /**
+        * @brief 设置日志的落盘策略
+        * @param policy 落盘策略（默认为NEVER）
+        * @param intervalMs policy为INTERVAL时两次fdatasync之间的最小间隔（单位毫秒，默认为1000）
+        * @note 关闭文件和析构时，只要策略不是NEVER都会再落盘一次
+        */
+        void setSyncPolicy(const LogSyncPolicy &policy,const int &intervalMs=1000){syncIntervalMs=intervalMs;syncPolicy=(int)policy;}
+        /**
+        * @brief 开启日志分段轮转
+        * @param maxBytes 当前分段写到这个大小后切换到新分段（单位字节，0表示不按大小轮转）
+        * @param daily true：日期变化后切换到新分段  false：不按日期轮转（默认为false）
+        * @param compress true：切换出去的旧分段在后台用gzip压缩  false：不压缩（默认为false）
+        * @note 旧分段被重命名为 日志文件名.yyyymmdd-hhmiss，同目录下的索引文件 日志文件名.index 每行记录一个分段的文件名和起止时间
+        * @note 开启后deleteLogByTime只作用于当前分段，历史分段用purgeSegments整个文件删除
+        */
+        void setRotation(const size_t &maxBytes,const bool &daily=false,const bool &compress=false);
+        /**
+        * @brief 删除最后一条日志早于指定时间的所有历史分段
+        * @param date 时间字符串 格式和openFile时设置的timeFormat一致
+        * @return 删除的分段数量  -1：读取索引失败
+        * @note 只读写索引文件、整个删除分段文件，耗时只和分段数量有关
+        */
+        int purgeSegments(const std::string &date);
+        /**
+        * @brief 获取每个写过日志的线程的统计
+        * @return 每个线程一项 已经退出的线程不在其中（计入getDroppedCount）
+        */
+        std::vector<LogThreadStat> getThreadStats();
+        /**
+        * @brief 获取因为暂存队列已满而丢弃的日志总条数
+        * @return 所有线程（包括已经退出的线程）丢弃的条数之和
+        */
+        uint64_t getDroppedCount();
+        /**
+        * @brief 开启二进制日志模式
+        * @param queueCap 二进制日志队列容量（必须为2的幂，默认为4096）
+        * @return true：开启成功（或已经开启）  false：容量不合法
+        * @note 必须在任何线程调用writeLogBinary之前调用
+        */
+        bool enableBinaryLog(const size_t &queueCap=4096);
+        /**
+        * @brief 写一条二进制日志
+        * @param fmt 格式描述（一般由STT_LOG_BIN宏生成静态对象）
+        * @param args 参数 个数不超过LogRecord::MAX_ARGS
+        * @return true：已入队  false：没有开启二进制模式、级别被过滤或者队列已满（日志被丢弃）
+        * @note 调用点只做级别检查、取时间戳、拷贝参数到定长记录，不构造字符串、不分配内存；格式化在消费者线程完成
+        */
+        template<class... Args>
+        bool writeLogBinary(const LogFormat &fmt,const Args&... args)
+        {
+            static_assert(sizeof...(Args)<=LogRecord::MAX_ARGS,"too many arguments for one binary log record");
+            system::MPSCQueue<LogRecord> *q=binQueue.load(std::memory_order_acquire);
+            if(q==nullptr||!shouldLog(fmt.level))
+                return false;
+            LogRecord r;
+            r.fmt=&fmt;
+            r.timestamp=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+            (r.add(args),...);
+            if(!q->push(r))
+                return false;
+            notifyConsumer();
+            return true;
+        }
+        /**
+         * @brief 析构函数 写完队列里剩下的日志 关闭消费者线程
+         */
+        ~LogFile();
+    };
+    }
+    /**
+    * @def STT_LOG_MIN_LEVEL
+    * @brief 编译期的最低日志级别 低于它的STT_LOG调用在编译时被整个去掉，没有任何运行时开销
+    * @note 取值和stt::file::LogLevel对应 0:TRACE 1:DEBUG 2:INFO 3:WARN 4:ERROR 5:OFF
+    * @note 默认为0，即全部编译进来，由日志对象的运行时级别过滤；生产环境可以用 -DSTT_LOG_MIN_LEVEL=2 去掉框架热路径上的TRACE和DEBUG日志
+    */
+    #ifndef STT_LOG_MIN_LEVEL
+    #define STT_LOG_MIN_LEVEL 0
+    #endif
+    /**
+    * @def STT_LOG(level,zh,en)
+    * @brief 按级别写一条中英文日志
+    * @param level 日志级别 stt::file::LogLevel
+    * @param zh 语言为中文时写入的内容
+    * @param en 其他语言时写入的内容
+    * @note 先在编译期和STT_LOG_MIN_LEVEL比较，再检查ServerSetting::logfile是否存在以及其运行时级别，都通过以后才会比较语言、构造日志字符串
+    */
+    #define STT_LOG(level,zh,en) do{ if constexpr((int)(level)>=STT_LOG_MIN_LEVEL){ if(stt::system::ServerSetting::logfile!=nullptr&&stt::system::ServerSetting::logfile->shouldLog(level)){ if(stt::system::ServerSetting::language=="Chinese") stt::system::ServerSetting::logfile->writeLog(zh,level); else stt::system::ServerSetting::logfile->writeLog(en,level); } } }while(0)
+    /**
+    * @def STT_LOG_BIN(logfile,level,format,...)
+    * @brief 用二进制模式写一条日志
+    * @param logfile 日志对象指针 需要已经调用enableBinaryLog
+    * @param level 日志级别 stt::file::LogLevel
+    * @param format 格式串字面量 用{}作为参数的占位符
+    * @note 每个调用点生成一个静态的LogFormat作为格式id；同样受STT_LOG_MIN_LEVEL的编译期过滤
+    *
+    * @code
+    * STT_LOG_BIN(lf,stt::file::LogLevel::INFO,"fd={} read {} bytes",fd,n);
+    * @endcode
+    */
+    #define STT_LOG_BIN(logfile,level,format,...) do{ if constexpr((int)(level)>=STT_LOG_MIN_LEVEL){ static const stt::file::LogFormat stt_log_format_{format,level}; (logfile)->writeLogBinary(stt_log_format_,##__VA_ARGS__); } }while(0)
+    /**
+    * @namespace stt::data
+    * @brief 数据处理
+    * @ingroup stt
+    */
+    namespace data
+    {
+        /**
+        * @brief 负责加密，解密和哈希
+        */
+        class CryptoUtil
+        {
+        public:
+            /**
+            * @brief  AES-256-CBC模式对称加密函数
+            * @param before 加密前的数据容器
+            * @param length 数据前的数据长度
+            * @param passwd 密钥
+            * @param iv iv向量
+            * @param after 密文的数据容器
+            * @return true：加密成功  false：加密失败
+            * @note  AES-256-CBC模式下 密钥为32字节 iv向量为16字节
+            */
+            static bool encryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after);
+            /**
+            * @brief AES-256-CBC模式对称解密函数
+            * @param before 密文的数据容器
+            * @param length 密文的数据长度
+            * @param passwd 密钥
+            * @param iv iv向量
+            * @param after 解密后的数据容器
+            * @return true：解密成功  false：解密失败
+            * @note  AES-256-CBC模式下 密钥为32字节 iv向量为16字节
+            */
+            static bool decryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after);
+            /**
+            * @brief 计算输入字符串的 SHA-1 哈希值（原始二进制形式）。
+            *
+            * 使用 OpenSSL 的 SHA1 函数对输入字符串进行哈希处理，结果以 20 字节的原始二进制形式存储在 result 中。
+            * 注意：result 可能包含不可打印字符，不适合直接输出或写入文本。
+            *
+            * @param ori_str 输入的原始字符串。
+            * @param result  用于存放输出的 SHA-1 哈希值（二进制形式），长度为 20 字节。
+            * @return 返回 result 的引用。
+            *
+            * @note 该函数适用于后续加密、签名等处理（例如用于 HMAC 的输入）。
+            */
+            static std::string& sha1(const std::string &ori_str,std::string &result);
+            /**
+            * @brief 计算输入字符串的 SHA-1 哈希值，并以十六进制字符串形式返回。
+            *
+            * 使用 OpenSSL 的 SHA1 函数对输入字符串进行哈希处理，结果以 40 个字符的十六进制格式表示存储在 result 中。
+            * 每个字节转换为两个十六进制字符，可直接用于打印、日志记录、存储等可读场景。
+            *
+            * @param ori_str 输入的原始字符串。
+            * @param result  用于存放输出的 SHA-1 哈希值（40 字节的十六进制字符串）。
+            * @return 返回 result 的引用。
+            *
+            * @note 适用于哈希显示、唯一标识、日志校验等场景。与 sha1 的主要区别是输出格式。
+            */
+	        static std::string& sha11(const std::string &ori_str,std::string &result);
+        };
+        /**
+        * @brief 负责二进制数据，字符串之间的转化
+        */
+        class BitUtil
+        {
+        public:
+            /**
+            * @brief 将单个字符转换为其对应的 8 位二进制字符串。
+            *
+            * @param input 输入的字符。
+            * @param result 用于保存输出的二进制字符串（例如 'A' -> "01000001"）。
+            * @return 返回 result 的引用。
+            */
+            static std::string& bitOutput(char input,std::string &result);
+            /**
+            * @brief 将字符串中的每个字符依次转换为二进制位，并拼接为一个整体字符串。
+            *
+            * @param input 输入字符串。
+            * @param result 保存输出的连续位字符串（长度为 input.size() * 8）。
+            * @return 返回 result 的引用。
+            */
+	        static std::string& bitOutput(const std::string &input,std::string &result);
+            /**
+            * @brief 获取字符 input 的从左向右第 pos 位（二进制）并返回 '1' 或 '0'。
+            *
+            * @param input 输入字符。
+            * @param pos 位位置（1~8，1 是最高位）。
+            * @param result 返回的位字符：'1' 或 '0'。
+            * @return 返回 result 的引用。
+            */
+	        static char& bitOutput_bit(char input,const int pos,char &result);
+            /**
+            * @brief 将 "01" 字符串（二进制字符串）转换为无符号整数。
+            *
+            * @param input 输入二进制字符串（如 "1011"）。
+            * @param result 输出结果数值。
+            * @return 返回 result 的引用。
+            */
+	        static unsigned long& bitStrToNumber(const std::string &input,unsigned long &result);
+            /**
+            * @brief 将字符串转换为二进制，再转换为对应数值。
+            *
+            * @param input 任意原始数据字符串。
+            * @param result 返回转换后的数值。
+            * @return 返回 result 的引用。
+            *
+            * @note 实际先调用 bitOutput 得到位串，再通过 bitStrToNumber 转换成整数。
+            */
+	        static unsigned long& bitToNumber(const std::string &input,unsigned long &result);
+            /**
+            * @brief 将最多 8 位的 "01" 字符串压缩成 1 个字节（char）。
+            *
+            * @param input 二进制字符串，最多 8 位。
+            * @param result 输出压缩后的字节。
+            * @return 返回 result 的引用。
+            */
+	        static char& toBit(const std::string &input,char &result);
+            /**
+            * @brief 将任意长度的 "01" 字符串压缩为二进制数据，每 8 位为一个字节。
+             *
+            * @param input 输入位串（长度应为 8 的倍数）。
+            * @param result 返回压缩后的二进制数据（每个字符代表 1 个字节）。
+            * @return 返回 result 的引用。
+            */
+	        static std::string& toBit(const std::string &input,std::string &result);
+        };
+        /**
+        * @brief 随机数，字符串生成相关
+        */
+        class RandomUtil
+        {
+        public:
+            /**
+            * @brief 生成一个随机整数
+            * @param 生成随机数的范围下限
+            * @param 生成随机数的范围上限
+            * @note 生成a-b范围的一个随机数
+            * @return 返回生成的一个随机数
+            */
+            static long getRandomNumber(const long &a,const long &b);
+            /**
+            * @brief 生成一个规定长度的“Base64 字符集内的伪随机字符串”，并在末尾用 '=' 补齐至符合 Base64 字符串格式
+            * @param str 保存生成字符串的容器
+            * @param length 需要生成的字符串的长度
+            * @return 返回str的引用
+            */
+            static std::string& getRandomStr_base64(std::string &str,const int &length);
+            /**
+            * @brief 生成一个 32 位（4 字节）的随机掩码。
+            *
+            * 该函数先随机生成一个由 '0' 和 '1' 组成的 32 位字符串（例如："010110..."），
+            * 然后通过内部的 `BitUtil::toBit()` 函数将其转换为对应的 4 字节二进制数据。
+            *
+            * 转换结果通过 mask 参数返回，通常用于生成数据包掩码、加密掩码、位图掩码等。
+            *
+            * @param mask 用于存放最终生成的 4 字节掩码（二进制字符串形式）。
+            * @return 返回 mask 的引用。
+            *
+            * @note 内部依赖函数 `BitUtil::toBit(const std::string&, std::string&)`，用于将 32 位二进制字符串压缩为 4 字节。
+            */
+            static std::string& generateMask_4(std::string &mask);
+        };
+        /**
+        * @brief 负责大小端字节序转换
+        */
+        class NetworkOrderUtil
+        {
+        public:
+            /**
+            * @brief 将 64 位无符号整数的字节序反转（大端 <-> 小端）。
+            *
+            * 该函数模拟 `htonl`/`ntohl` 的 64 位版本，即按字节交换实现高低位互换。
+            * 原地修改参数并返回引用。
+            *
+            * @param data 输入的 64 位无符号整数，按字节反转后返回。
+            * @return 反转后的 data 引用。
+            *
+            * @note 该实现不依赖平台库函数，适用于不确定机器端序的场景。
+            */
+            static unsigned long& htonl_ntohl_64(unsigned long &data);//64位无符号数转化为大/小端序（网络字节序）
+        };
+        
+        /**
+        * @brief 负责浮点数精度处理
+        */
+        class PrecisionUtil
+        {
+        public:
+        
+            /**
+            * @brief 将浮点数格式化为指定小数位数的字符串表示。
+            * 
+            * @param number 输入的浮点数。
+            * @param bit 保留的小数位数。
+            * @param str 用于存储格式化后的字符串。
+            * @return 格式化结果字符串的引用。
+            */
+	        static std::string& getPreciesFloat(const float &number,const int &bit,std::string &str);
+            /**
+            * @brief 将 float 数值保留指定位数的小数，并直接修改原值。
+            *
+            * @param number 待处理的 float 变量（将被修改）。
+            * @param bit 保留的小数位数。
+            * @return 修改后的 float 引用。
+            */
+            static float& getPreciesFloat(float &number,const int &bit);
+            /**
+            * @brief 将双精度浮点数格式化为指定小数位数的字符串表示。
+            *
+            * @param number 输入的 double 数值。
+            * @param bit 保留的小数位数。
+            * @param str 用于存储格式化后的字符串。
+            * @return 格式化结果字符串的引用。
+            */
+            static std::string& getPreciesDouble(const double &number,const int &bit,std::string &str);
+            /**
+            * @brief 将 double 数值保留指定位数的小数，并直接修改原值。
+            *
+            * @param number 待处理的 double 变量（将被修改）。
+            * @param bit 保留的小数位数。
+            * @return 修改后的 double 引用。
+            */
+            static double& getPreciesDouble(double &number,const int &bit);
+            /**
+            * @brief 根据数值动态调整小数精度，保留指定数量的有效数字。
+            *
+            * 对于小于 1 的小数，会先确定其最前位有效数字所处的位置，
+            * 然后在此基础上保留 bit 位有效数字。
+            * 修改后的数值将四舍五入保留合适的小数位，并写回原变量。
+            *
+            * @param number 待处理的 float 数值（将被修改）。
+            * @param bit 希望保留的有效数字位数。
+            * @return 修改后的 float 引用。
+            */
+            static float& getValidFloat(float &number,const int &bit);
+        };
+        /**
+        * @brief 负责Http字符串和URL解析
+        * 包括从 URL 或请求报文中提取参数、IP、端口、请求头字段等功能。
+        */
+        class HttpStringUtil
+        {
+        public:
+            /**
+            * @brief 从原始字符串中提取两个标记之间的子串。
+            *
+            * 提取从 a 到 b 之间的内容（不包含 a 和 b），可指定起始搜索位置。
+            * 若 a 或 b 为空字符串，则分别表示从头或到尾。
+            * 若a找不到，则默认从头开始
+            * 若b找不到，则默认到尾
+            *
+            * @param ori_str 原始字符串。
+            * @param str 存储提取结果的字符串。
+            * @param a 起始标记字符串。
+            * @param b 终止标记字符串。
+            * @param pos 搜索起始位置。
+            * @return 返回b在ori_str中的位置(可能返回string::npos,如果b找不到或者b为"")
+            * @note 如果找不到，结果字符串为""
+            */       
+	        static size_t get_split_str(const std::string_view& ori_str,std::string_view &str,const std::string_view &a,const std::string_view &b,const size_t &pos=0);
+            /**
+            * @brief 从 URL 查询参数中提取指定 key 的值。
+            *
+            * @note url不需要完整也行 例如从 `?id=123&name=abc`提取 `id` 的值和从`http://xxxx/?id=123&name=abc`提取 `id` 的值是一样的。
+            *
+            * @param ori_str 原始 URL 字符串。
+            * @param str 存储提取结果的字符串。
+            * @param name 参数名（key）。
+            * @return 引用，指向结果字符串。
+            */
+	        static std::string_view& get_value_str(const std::string_view& ori_str,std::string_view &str,const std::string& name);
+            /**
+            * @brief 从 HTTP 请求头中提取指定字段的值。
+            *
+            * @param ori_str 原始 HTTP 请求头字符串。
+            * @param str 提取结果。
+            * @param name 请求头字段名（如 "Host"）。
+            * @return 引用，指向结果字符串。
+            */
+	        static std::string_view& get_value_header(const std::string_view& ori_str,std::string_view &str,const std::string& name);
+            /**
+            * @brief 提取 URL 中 path 和 query 部分。
+            *
+            * 例如从 `http://abc.com/path?query=123` 或者从/path?query=123 提取 `/path`。
+            *
+            * @param ori_str 原始 URL。
+            * @param str 返回 path 部分。
+            * @return 引用，指向结果字符串。
+            */
+	        static std::string_view& get_location_str(const std::string_view& ori_str,std::string_view &str);
+            /**
+            * @brief 提取 URL 的 path 部分（不含 query）。
+            *
+            * 与 `get_location_str` 类似，但保留 path 之后的所有内容（如参数）。
+            *
+            * @param URL。
+            * @param locPara 返回 path+参数部分。
+            * @return 引用，指向结果字符串。
+            */
+            static std::string_view& getLocPara(const std::string_view &url,std::string_view &locPara);
+            /**
+            * @brief 获取 URL 中的查询参数字符串（包括 ?）。
+            * @note 可以是完整url 也可以是不太完整的，比如/path?id=123&name=abc
+            *
+            * @param URL。
+            * @param para 返回参数部分（形如 "?id=123&name=abc"）。
+            * @return 引用，指向结果字符串。
+            */
+            static std::string_view& getPara(const std::string_view &url,std::string_view &para);
+
+
+            /**
+            * @brief 从原始字符串中提取两个标记之间的子串。
+            *
+            * 提取从 a 到 b 之间的内容（不包含 a 和 b），可指定起始搜索位置。
+            * 若 a 或 b 为空字符串，则分别表示从头或到尾。
+            * 若a找不到，则默认从头开始
+            * 若b找不到，则默认到尾
+            *
+            * @param ori_str 原始字符串。
+            * @param str 存储提取结果的字符串。
+            * @param a 起始标记字符串。
+            * @param b 终止标记字符串。
+            * @param pos 搜索起始位置。
+            * @return 返回b在ori_str中的位置(可能返回string::npos,如果b找不到或者b为"")
+            * @note 如果找不到，结果字符串为""
+            */       
+	        static size_t get_split_str(const std::string_view& ori_str,std::string &str,const std::string_view &a,const std::string_view &b,const size_t &pos=0);
+            /**
+            * @brief 从 URL 查询参数中提取指定 key 的值。
+            *
+            * @note url不需要完整也行 例如从 `?id=123&name=abc`提取 `id` 的值和从`http://xxxx/?id=123&name=abc`提取 `id` 的值是一样的。
+            *
+            * @param ori_str 原始 URL 字符串。
+            * @param str 存储提取结果的字符串。
+            * @param name 参数名（key）。
+            * @return 引用，指向结果字符串。
+            */
+	        static std::string& get_value_str(const std::string& ori_str,std::string &str,const std::string& name);
+            /**
+            * @brief 从 HTTP 请求头中提取指定字段的值。
+            *
+            * @param ori_str 原始 HTTP 请求头字符串。
+            * @param str 提取结果。
+            * @param name 请求头字段名（如 "Host"）。
+            * @return 引用，指向结果字符串。
+            */
+	        static std::string& get_value_header(const std::string& ori_str,std::string &str,const std::string& name);
+            /**
+            * @brief 提取 URL 中 path 和 query 部分。
+            *
+            * 例如从 `http://abc.com/path?query=123` 或者从/path?query=123 提取 `/path`。
+            *
+            * @param ori_str 原始 URL。
+            * @param str 返回 path 部分。
+            * @return 引用，指向结果字符串。
+            */
+	        static std::string& get_location_str(const std::string& ori_str,std::string &str);
+            /**
+            * @brief 提取 URL 的 path 部分（不含 query）。
+            *
+            * 与 `get_location_str` 类似，但保留 path 之后的所有内容（如参数）。
+            *
+            * @param URL。
+            * @param locPara 返回 path+参数部分。
+            * @return 引用，指向结果字符串。
+            */
+            static std::string& getLocPara(const std::string &url,std::string &locPara);
+            /**
+            * @brief 获取 URL 中的查询参数字符串（包括 ?）。
+            * @note 可以是完整url 也可以是不太完整的，比如/path?id=123&name=abc
+            *
+            * @param URL。
+            * @param para 返回参数部分（形如 "?id=123&name=abc"）。
+            * @return 引用，指向结果字符串。
+            */
+            static std::string& getPara(const std::string &url,std::string &para);
+            /**
+            * @brief 从 URL 中提取主机 IP 或域名。
+            *
+            * 例如从 `http://127.0.0.1:8080/` 提取 `127.0.0.1`。
+            *
+            * @warning url必须完整而且显式指明端口
+            * @param url 完整 URL。
+            * @param IP 存储提取的 IP 或域名。
+            * @return 引用，指向结果字符串。
+            */
+            static std::string& getIP(const std::string &url,std::string &IP);
+            /**
+             * @brief 从 URL 中提取端口号。
+            *
+             * 例如从 `http://127.0.0.1:8080/` 中提取 8080。
+            *
+            * @warning 必须是完整的url，而且必须显式指定端口 还有路径 就算路径没有 也要写个/
+            * @param url 完整 URL。
+            * @param port 存储解析出的端口号。
+            * @return 引用，指向端口号。
+            */
+            static int& getPort(const std::string &url,int &port);
+            /**
+            * @brief 创建一个 HTTP 请求头字段字符串。
+            *
+            * 该函数构造格式为 `字段名: 字段值\r\n` 的字符串。
+            *
+            * @param first 第一个字段名。
+            * @param second 第一个字段值。
+            * @return 构造的单条 HTTP 请求头字符串。
+            */
+            static std::string createHeader(const std::string& first,const std::string& second);
+            /**
+            * @brief 递归构造多个 HTTP 请求头字段。
+            *
+            * 支持多个字段名和值的构造，用法为：
+            * @code
+            * std::string headers = createHeader("Host", "example.com", "Connection", "keep-alive,"Content-Type","charset=UTF-8");
+            * @endcode
+            * 最终生成：
+            * @code
+            * Host: example.com\r\n
+            * Connection: keep-alive\r\n
+            * Content-Type: charset=UTF-8\r\n
+            * @endcode
+            *
+            * @param Args 其余参数，需以 (字段名, 字段值) 成对传入。
+            * @param first 当前字段名。
+            * @param second 当前字段值。
+            * @param args 后续的字段名和值（必须为偶数个）。
+            * @return 构造的完整 HTTP 请求头字符串。
+            */
+	        template<class... Args>
+	        static std::string createHeader(const std::string& first,const std::string& second,Args... args)
+	        {
+		        std::string cf=first+": "+second+"\r\n"+createHeader(args...);
+		        return cf;
+	        }
+        };
+        /**
+        * @brief 负责websocket协议有关字符串的操作
+        */
+        class WebsocketStringUtil
+        {
+        public:
+            /**
+            * @brief 生成 WebSocket 握手响应中的 Sec-WebSocket-Accept 字段值。
+            *
+            * 该函数基于客户端提供的 Sec-WebSocket-Key，拼接 WebSocket 指定的魔法 GUID，
+            * 再进行 SHA-1 哈希与 Base64 编码，得到握手响应所需的 accept 字符串。
+            *
+            * @param str 输入为客户端提供的 Sec-WebSocket-Key，会被原地修改为结果字符串（Sec-WebSocket-Accept）。
+            * @return 引用返回修改后的 str。
+            *
+            * @note 实现参考 RFC 6455 第 4.2.2 节握手过程。
+            */
+            static std::string& transfer_websocket_key(std::string &str);
+        };
+        /**
+        * @brief 负责字符串和数字的转化
+        */
+        class NumberStringConvertUtil
+        {
+        public:
+            /**
+            * @brief string转化为int类型
+            * @note 不会抛出异常
+            * @param ori_str 原始string类型数据
+            * @param result 存放结果的int容器
+            * @param i 如果转化失败 则把result赋值为i(默认为-1)
+            * @return result的引用
+            */
+	        static int& toInt(const std::string_view&ori_str,int &result,const int &i=-1);
+            /**
+            * @brief 16进制数字的字符串表示转化为10进制int类型数字
+            * @param ori_str 16进制数字的字符串表示
+            * @param result 保存转化结果的int容器
+            * @return 返回result的引用
+            */
+            static int& str16toInt(const std::string_view&ori_str,int &result,const int &i=-1);
+            /**
+            * @brief string转化为long类型
+            * @note 不会抛出异常
+            * @param ori_str 原始string类型数据
+            * @param result 存放结果的long容器
+            * @param i 如果转化失败 则把result赋值为i(默认为-1)
+            * @return result的引用
+            */
+	        static long& toLong(const std::string_view&ori_str,long &result,const long &i=-1);
+            /**
+            * @brief string转化为float类型
+            * @note 不会抛出异常
+            * @param ori_str 原始string类型数据
+            * @param result 存放结果的float容器
+            * @param i 如果转化失败 则把result赋值为i(默认为-1)
+            * @return result的引用
+            */
+	        static float& toFloat(const std::string&ori_str,float &result,const float &i=-1);
+            /**
+            * @brief string转化为double类型
+            * @note 不会抛出异常
+            * @param ori_str 原始string类型数据
+            * @param result 存放结果的double容器
+            * @param i 如果转化失败 则把result赋值为i(默认为-1)
+            * @return result的引用
+            */
+	        static double& toDouble(const std::string&ori_str,double &result,const double &i=-1);
+            /**
+            * @brief string转化为bool类型
+            * @note 不会抛出异常，true或者True，TRUE返回true，否则返回false
+            * @param ori_str 原始string类型数据
+            * @param result 存放结果的bool容器
+            * @return result的引用
+            */
+	        static bool& toBool(const std::string_view&ori_str,bool &result);
+            /**
+            * @brief 将普通字符串转化为对应的十六进制表示字符串（hex string）。
+             *
+            * 例如输入 "ABC" 会被转化为 "414243"，每个字符转换为其 ASCII 的十六进制形式。
+            *
+            * @param ori_str 输入的原始字符串（可以包含任意字符，包括不可见字符）。
+            * @param result 存放转换后结果的字符串引用。
+            * @return 转换后的十六进制字符串 result 的引用。
+            * @bug 有bug待修复
+            */
+            static std::string& strto16(const std::string &ori_str,std::string &result);//字符串转化为16进制字符串     (暂不需要)(待修复)
+        };
+        /**
+        * @brief 数据编码解码，掩码处理等
+        */
+        class EncodingUtil
+        {
+        public:
+            /**
+            * @brief 对字符串进行 Base64 编码。
+            *
+            * 使用 OpenSSL 的 BIO 接口对给定字符串进行 Base64 编码，编码过程中不会插入换行符。
+            *
+            * @param input 要编码的原始字符串（可以包含任意二进制数据）。
+            * @return 编码后的 Base64 字符串。
+            */
+            static std::string base64_encode(const std::string &input);
+            /**
+            * @brief 对 Base64 编码的字符串进行解码。
+            *
+            * 使用 OpenSSL 的 BIO 接口对 Base64 字符串进行解码。该函数不接受带换行符的 Base64 字符串。
+            *
+            * @param input Base64 编码的字符串。
+            * @return 解码后的原始字符串。
+            */
+	        static std::string base64_decode(const std::string &input);
+            /**
+            * @brief 生成 WebSocket 握手响应中的 Sec-WebSocket-Accept 字段值。
+            *
+            * 该函数基于客户端提供的 Sec-WebSocket-Key，拼接 WebSocket 指定的魔法 GUID，
+            * 再进行 SHA-1 哈希与 Base64 编码，得到握手响应所需的 accept 字符串。
+            *
+            * @param str 输入为客户端提供的 Sec-WebSocket-Key，会被原地修改为结果字符串（Sec-WebSocket-Accept）。
+            * @return 引用返回修改后的 str。
+            *
+            * @note 实现参考 RFC 6455 第 4.2.2 节握手过程。
+            */
+	        static std::string& transfer_websocket_key(std::string &str);
+            /**
+            * @brief 生成一个 32 位（4 字节）的随机掩码。
+            *
+            * 该函数先随机生成一个由 '0' 和 '1' 组成的 32 位字符串（例如："010110..."），
+            * 然后通过内部的 `BitUtil::toBit()` 函数将其转换为对应的 4 字节二进制数据。
+            *
+            * 转换结果通过 mask 参数返回，通常用于生成数据包掩码、加密掩码、位图掩码等。
+            *
+            * @param mask 用于存放最终生成的 4 字节掩码（二进制字符串形式）。
+            * @return 返回 mask 的引用。
+            *
+            * @note 内部依赖函数 `BitUtil::toBit(const std::string&, std::string&)`，用于将 32 位二进制字符串压缩为 4 字节。
+            */
+            static std::string& generateMask_4(std::string &mask);
+            /**
+            * @brief 使用给定的 4 字节掩码对字符串进行异或操作（XOR Masking）。
+            *
+            * 此函数对输入字符串 data 的每个字节，按顺序与 mask 中的 4 字节循环异或。
+            * 该操作是可逆的，可用于加密或解密 WebSocket 中的掩码数据帧。
+            *
+            * @param data 要进行异或处理的数据字符串，处理结果会直接修改该字符串。
+            * @param mask 用作掩码的字符串，通常应为至少 4 字节。
+            * @return 引用，指向处理后的 data 字符串。
+            */
+	        static std::string& maskCalculate(std::string &data,const std::string &mask);
+        };
+        /**
+        * @brief json数据操作类
+        */
+        class JsonHelper
+        {
+            public:
+            /**
+            * @brief 提取 JSON 字符串中指定字段的值或嵌套结构。
+            * 
+            * @param oriStr 原始 JSON 字符串。
+            * @param result 存储返回值的字符串引用。
+            * @param type 类型模式，可选值：value, arrayvalue。分别为普通json对象里面的值，数组对象里面的值。
+            * @param name JSON 中的键名（仅适用于 value）。
+            * @param num 数组索引位置(从0开始)（仅适用于 arrayvalue）。
+            * @return -1:提取失败
+            *          0:返回非json对象
+            *          1:返回json对象
+            */
+	        static int getValue(const std::string &oriStr,std::string& result,const std::string &type="value",const std::string &name="a",const int &num=0);
+
+            /**
+            * @brief 将 Json::Value 转换为字符串。
+            * @param val JSON 值。
+            * @return std::string 字符串形式的值。
+            */
+            static std::string toString(const Json::Value &val);
+            /**
+            * @brief 解析 JSON 字符串为 Json::Value。
+            * @param str 输入的 JSON 字符串。
+            * @return Json::Value 解析后的 JSON 对象或数组。
+            */
+	        static Json::Value toJsonArray(const std::string & str);
+            /**
+            * @brief 创建仅包含一个键值对的 JSON 字符串。
+            * 
+            * @param T1 键的类型，通常为 std::string。
+            * @param T2 值的类型，可为任意可被 Json::Value 接收的类型。
+            * @param first 键。
+            * @param second 值。
+            * @return std::string JSON 字符串。
+            */
+            template<class T1,class T2>
+	        static std::string createJson(T1 first,T2 second)
+	        {
+		        Json::Value root;
+		        //root[first]=second;
+                if constexpr (std::is_integral_v<T2>) {
+                    root[first] = Json::Value(static_cast<Json::Int64>(second));
+                } else {
+                    root[first] = second;
+                }
+		        Json::StreamWriterBuilder builder;
+		        std::string jsonString=Json::writeString(builder,root);
+		        return jsonString;
+	        }
+            /**
+            * @brief 创建多个键值对组成的 JSON 字符串（递归变参模板）。
+            * 
+            * @param T1 第一个键的类型。
+            * @param T2 第一个值的类型。
+            * @param Args 其余成对出现的键值参数。
+            * @param first 第一个键。
+            * @param second 第一个值。
+            * @param args 其余键值参数。
+            * @return std::string 拼接完成的 JSON 字符串。
+            */
+             template<class T1,class T2,class... Args>
+	        static std::string createJson(T1 first,T2 second,Args... args)
+	        {
+		        Json::Value root;
+		        //root[first]=second;
+                if constexpr (std::is_integral_v<T2>) {
+                    root[first] = Json::Value(static_cast<Json::Int64>(second));
+                } else {
+                    root[first] = second;
+                }
+		        std::string kk=createJson(args...);
+		        Json::StreamWriterBuilder builder;
+		        std::string jsonString=Json::writeString(builder,root);
+		        jsonString=jsonString.erase(jsonString.length()-2);
+		        kk=kk.substr(1);
+		        return jsonString+","+kk;
+
+	        }
+            /**
+            * @brief 创建只包含一个元素的 JSON 数组字符串。
+            * 
+            * @param T 任意类型。
+            * @param first 第一个元素。
+            * @return std::string JSON 数组字符串。
+            */
+	        template<class T>
+	        static std::string createArray(T first)
+	        {
+		        Json::Value root(Json::arrayValue);
+		        root.append(first);
+		        Json::StreamWriterBuilder builder;
+		        std::string jsonString=Json::writeString(builder,root);
+		        return jsonString;
+	        }
+            /**
+            * @brief 创建多个元素组成的 JSON 数组字符串（递归变参模板）。
+            * 
+            * @param T 第一个元素类型。
+            * @param Args 其余元素类型。
+            * @param first 第一个元素。
+            * @param args 其余元素。
+            * @return std::string 拼接完成的 JSON 数组字符串。
+            */
+            template<class T,class... Args>
+	        static std::string createArray(T first,Args... args)
+	        {
+		        Json::Value root(Json::arrayValue);
+		        root.append(first);
+		        std::string kk=createArray(args...);
+		        Json::StreamWriterBuilder builder;
+		        std::string jsonString=Json::writeString(builder,root);
+		        jsonString=jsonString.erase(jsonString.length()-2);
+		        kk=kk.substr(1);
+		        return jsonString+","+kk;
+
+	        }
+            /**
+            * @brief 将两个 JSON 字符串拼接为一个有效的 JSON（适用于对象或数组拼接）。
+            * @param a 第一个 JSON 字符串。
+            * @param b 第二个 JSON 字符串。
+            * @return std::string 拼接后的 JSON 字符串。
+            */
+            static std::string jsonAdd(const std::string &a,const std::string &b);
+             /**
+            * @brief 将格式化后的 JSON 字符串去除缩进、空格等变成紧凑格式。
+            * @param a 输入的 JSON 字符串。
+            * @param b 存储格式化结果的引用。
+            * @return std::string& 紧凑格式的字符串引用。
+            */
+            static std::string& jsonFormatify(const std::string &a,std::string &b);
+            /**
+            * @brief 将 JSON 字符串中的 \uXXXX 转换为 UTF-8 字符。
+            * @param input 含有 Unicode 编码的 JSON 字符串。
+            * @param output 存储转换后字符串的引用。
+            * @return std::string& 返回转换后的字符串引用。
+            */
+            static std::string& jsonToUTF8(const std::string &input,std::string &output);
+        };
+    }
+
+    /**
+    * @brief 涉及信息安全的api
+    */
+    namespace security
+    {
+    /**
+     * @enum RateLimitType
+     * @brief 限流算法类型（策略）。
+     *
+     * 每种策略的“语义”不同，选择时请按业务/攻击模型匹配：
+     *
+     * @par 1) Cooldown（连续触发惩罚 / 冷却限流）
+     * - @b 规则：在 secs 时间内累计达到 times 次后，后续请求全部拒绝，直到“安静”满 secs 后才恢复。
+     * - @b 特性：对持续刷/爆破非常狠；对正常用户的“短时间突发”不友好（可能需要完全停一段时间才能恢复）。
+     * - @b 适用：
+     *   - 建连防爆破（connect）
+     *   - 登录失败次数惩罚（fail-based 可用同思路扩展）
+     *   - 防脚本快速重试
+     * - @b 不适用：
+     *   - 正常会出现突发但希望“自然恢复”的接口（例如页面加载产生的突发 HTTP 请求）
+     *
+     * @par 2) FixedWindow（固定窗口计数）
+     * - @b 规则：以某个窗口起点为基准，每 secs 秒为一个窗口；窗口内最多 times 次，超出拒绝；窗口结束时计数清零。
+     * - @b 特性：实现简单、开销小；存在“窗口边界突刺”（在窗口交界处可能短时间放行较多）。
+     * - @b 适用：
+     *   - 低风险、要求简单的限流
+     *   - 统计口径清晰的“每 N 秒最多 M 次”
+     * - @b 不适用：
+     *   - 对抗性强的场景（容易被边界行为利用）
+     *
+     * @par 3) SlidingWindow（滑动窗口 / 时间戳队列）
+     * - @b 规则：在任意时刻 now，统计 (now-secs, now] 区间内发生的次数；若 >= times 则拒绝。
+     * - @b 特性：比 FixedWindow 更公平、无窗口边界突刺；需要维护时间戳队列（开销略高）。
+     * - @b 适用：
+     *   - 对外 HTTP API、用户操作等希望公平且稳定的限流
+     *   - path 级别的关键接口（如 /login /register）
+     * - @b 不适用：
+     *   - 极高 QPS 且每个 key(times) 很大、又不愿意付出队列内存/维护成本的场景（可用近似桶）
+     *
+     * @par 4) TokenBucket（令牌桶）
+     * - @b 规则（常见语义）：令牌按固定速率补充；每次请求消耗 1 令牌；无令牌则拒绝。
+     *   在本类接口里通过 (times, secs) 表达：平均速率约为 times/secs，桶容量通常与 times 同级（实现可按需要定义）。
+     * - @b 特性：允许突发（桶里有存量时可瞬间放行一批），同时限制长期平均速率；工程上最常用。
+     * - @b 适用：
+     *   - 请求流量整形（允许短突发但控制长期平均）
+     *   - IM 消息、HTTP 请求等“既不想太硬也不想太松”的场景
+     * - @b 不适用：
+     *   - 你想要“打满后必须停一段时间”的强惩罚需求（那是 Cooldown）
+     */
+        enum class RateLimitType 
+        {
+            Cooldown,      // 连续触发惩罚：达到上限后进入冷却，需要安静 secs 才恢复
+            FixedWindow,   // 固定窗口计数：每 secs 一个窗口，窗口内最多 times 次
+            SlidingWindow, // 滑动窗口：统计最近 secs 内的次数（队列时间戳）
+            TokenBucket    // 令牌桶：允许突发 + 控制长期平均速率（常用于 API/消息）
+        };
+    /**
+ * @struct RateState
+ * @brief 单一限流器的运行状态（可复用于多种限流策略）。
+ *
+ * @details
+ * 该结构用于记录某个限流维度（IP / fd / path 等）的实时状态，
+ * 会被不同限流算法复用：
+ *
+ * - Cooldown / FixedWindow：
+ *   - 使用 counter + lastTime
+ * - SlidingWindow：
+ *   - 使用 history（时间戳队列）
+ * - TokenBucket：
+ *   - 使用 tokens + lastRefill
+ *
+ * @note
+ * - violations 用于记录“被拒绝”的次数，是防御升级（DROP / CLOSE / 封禁）的依据
+ * - RateState 本身不做任何决策，只负责记录状态
+ */
+        struct RateState
+        {
+            // 通用
+            int counter = 0;
+            int violations = 0;   // 新增：触发限流的次数
+            std::chrono::steady_clock::time_point lastTime{};
+
+            // SlidingWindow
+            std::deque<std::chrono::steady_clock::time_point> history;
+
+            // TokenBucket
+            double tokens = 0.0;
+            std::chrono::steady_clock::time_point lastRefill{};
+        };
+        /**
+ * @struct ConnectionState
+ * @brief 单个连接（fd）的安全与限流状态。
+ *
+ * @details
+ * 每个成功通过 allowConnect 的 fd 都会拥有一个 ConnectionState，
+ * 用于实现“连接级（fd 级）”防御：
+ *
+ * - requestRate：该连接的整体请求速率限制
+ * - pathRate：该连接在不同 path 下的额外限流状态
+ * - lastActivity：该连接最后一次活动时间（用于僵尸连接检测）
+ *
+ * @note
+ * - 一个 IP 可以对应多个 ConnectionState
+ * - 断连时必须清理对应的 ConnectionState
+ */
+        struct ConnectionState
+        {
+            int fd = -1;
+            RateState requestRate;
+            std::unordered_map<std::string, RateState> pathRate;
+            std::chrono::steady_clock::time_point lastActivity{};
+        };
+        /**
+ * @struct IPInformation
+ * @brief 单个 IP 的安全状态与连接集合。
+ *
+ * @details
+ * IPInformation 是 ConnectionLimiter 的核心状态单元，
+ * 用于实现“IP 级 + fd 级”的分层防御模型：
+ *
+ * - activeConnections：当前 IP 已建立的并发连接数
+ * - connectRate：IP 级建连速率限制状态
+ * - badScore：IP 风险评分（多次恶意行为会累积）
+ * - conns：该 IP 下所有活动连接（fd -> ConnectionState）
+ *
+ * @par 防御语义
+ * - activeConnections / connectRate：
+ *   - 用于防止建连洪水、爆破
+ * - badScore：
+ *   - 用于升级防御策略（断连 / 临时封禁 IP）
+ *
+ * @note
+ * - IP 的黑名单（封禁时间）通常由 ConnectionLimiter 统一维护
+ * - badScore 可随时间衰减或在封禁后重置
+ */
+        struct IPInformation
+        {
+            int activeConnections = 0;
+            RateState connectRate;
+            int badScore = 0; //IP 风险评分（用于升级惩罚）
+            std::unordered_map<int, ConnectionState> conns; // fd -> state
+        };
+        /**
+ * @enum DefenseDecision
+ * @brief 安全裁决结果（由 ConnectionLimiter 返回）。
+ *
+ * @details
+ * 所有连接 / 请求在进入业务处理前，都会经过 ConnectionLimiter 的判定，
+ * 并返回以下三种裁决之一：
+ *
+ * - ALLOW (0)：
+ *   - 正常通过，继续处理
+ * - DROP (1)：
+ *   - 无视该请求（不回应、不处理）
+ *   - 主要用于 request 阶段的轻度防御
+ * - CLOSE (2)：
+ *   - 立即断开连接
+ *   - 可伴随 IP 风险升级或临时封禁
+ *
+ * @note
+ * - connect 阶段通常只使用 ALLOW / CLOSE
+ * - DROP 主要用于 request 阶段（fd 已存在时）
+ */
+        enum DefenseDecision : int
+        {
+            ALLOW = 0,  // 正常通过
+            DROP  = 1,  // 不回应（丢弃）
+            CLOSE = 2   // 断连（可伴随封 IP）
+        };
+    
+        /**
+ * @class ConnectionLimiter
+ * @brief 统一的连接与请求安全裁决器（IP 级 + fd 级，多策略限流 + 黑名单）。
+ *
+ * @details
+ * ConnectionLimiter 是一个“安全门（Security Gate）”，
+ * 所有连接建立与请求处理在进入业务逻辑前，都必须经过该类的裁决。
+ *
+ * 本类不直接执行业务行为（如 close / send / sleep），
+ * 而是返回一个 @ref DefenseDecision 结果，由外层统一执行。
+ *
+ * ---
+ * @section design_overview 设计概览
+ *
+ * 本类实现的是一个分层防御模型：
+ *
+ * - IP 级防御：
+ *   - 并发连接数限制（maxConnections）
+ *   - 建连速率限制（connectRate）
+ *   - IP 风险评分（badScore）
+ *   - 临时黑名单（blacklist，带 TTL）
+ *
+ * - fd 级防御：
+ *   - 请求速率限制（requestRate）
+ *   - path 级额外限流（pathRate）
+ *   - 连接活动时间记录（lastActivity）
+ *
+ * ---
+ * @section defense_decision 防御裁决语义
+ *
+ * allowConnect / allowRequest 的返回值为 @ref DefenseDecision：
+ *
+ * - ALLOW (0)：
+ *   - 允许继续处理
+ *
+ * - DROP (1)：
+ *   - 无视本次请求（不回应、不处理）
+ *   - 主要用于 request 阶段的轻度防御
+ *
+ * - CLOSE (2)：
+ *   - 立即断开连接
+ *   - 可伴随 IP 风险升级或临时封禁
+ *
+ * @note
+ * - connect 阶段由于 TCP 连接已建立，通常只使用 ALLOW / CLOSE
+ * - DROP 主要用于 request 阶段（fd 已存在时）
+ *
+ * ---
+ * @section rate_limit 策略与限流
+ *
+ * 本类支持多种限流策略（见 @ref RateLimitType）：
+ *
+ * - Cooldown
+ * - FixedWindow
+ * - SlidingWindow
+ * - TokenBucket
+ *
+ * 不同维度使用不同策略：
+ *
+ * - 建连速率：connectStrategy（默认 Cooldown）
+ * - fd 级请求速率：requestStrategy（默认 SlidingWindow）
+ * - path 级请求速率：pathStrategy（默认 SlidingWindow）
+ *
+ * ---
+ * @section thread_safety 线程安全
+ *
+ * @warning
+ * 本类本身不包含锁：
+ * - table / pathConfig / blacklist 的并发安全
+ *   需由上层保证（如事件循环线程、外部互斥锁等）。
+ *
+ * ---
+ * @section lifecycle 生命周期说明
+ *
+ * - allowConnect：
+ *   - 判断 IP 是否允许进入应用层
+ *   - 在 ALLOW 时登记 fd
+ *
+ * - allowRequest：
+ *   - 对已登记 fd 进行请求裁决
+ *
+ * - clearIP：
+ *   - 在连接关闭时调用，回收 fd 与并发计数
+ *
+ * - connectionDetect：
+ *   - 用于检测并清理长时间无活动的僵尸连接
+ */
+        class ConnectionLimiter
+        {
+        public:
+        /**
+         * @brief 构造函数。
+         *
+         * @param maxConn 同一 IP 允许的最大并发连接数（activeConnections 上限）。
+         * @param idleTimeout 连接僵尸检测超时时间（秒）。若 < 0 表示不做僵尸检测。
+         */
+            ConnectionLimiter(const int& maxConn = 20, const int& idleTimeout = 60) : maxConnections(maxConn),connectionTimeout(idleTimeout){}
+
+            // ========== 策略设置 ==========
+        /**
+         * @brief 设置“连接速率限流”所使用的策略。
+         *
+         * @param type 策略类型，见 @ref RateLimitType 说明。
+         * @note 不调用本函数时，默认策略为 @ref RateLimitType::Cooldown 。
+         */
+            void setConnectStrategy(const RateLimitType &type);
+        /**
+         * @brief 设置“IP 级请求限流”所使用的策略。
+         *
+         * @param type 策略类型，见 @ref RateLimitType 说明。
+         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
+         */
+            void setRequestStrategy(const RateLimitType &type);
+        /**
+         * @brief 设置“path 级请求限流”所使用的策略。
+         *
+         * @param type 策略类型，见 @ref RateLimitType 说明。
+         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
+         */
+            void setPathStrategy(const RateLimitType &type);
+
+            // ========== Path 配置 ==========
+        /**
+         * @brief 设置某个路径的额外限流规则（path 级）。
+         *
+         * @param path 需要额外限流的路径，例如 "/login"、"/register"。
+         * @param times 在 secs 秒内允许的最大请求次数。
+         * @param secs 统计窗口长度（秒）。
+         *
+         * @note setPathLimit 配置的是 @b 额外规则：
+         * - allowRequest 调用时传入的 (times, secs) 仍然会作为 IP 级规则先执行；
+         * - 若 path 命中此配置，则再执行 path 级规则；
+         * - 两者为 AND 关系：任何一层失败即拒绝。
+         */
+            void setPathLimit(const std::string &path, const int &times, const int &secs);
+
+            // ========== 核心判断 ==========
+        /**
+     * @brief 对新建立的连接进行安全裁决（IP 级）。
+     *
+     * @param ip 对端 IP 地址。
+     * @param fd 新 accept 得到的文件描述符。
+     * @param times 在 secs 秒内允许的最大建连次数。
+     * @param secs 建连速率统计窗口（秒）。
+     *
+     * @return DefenseDecision
+     * - ALLOW：允许该连接进入应用层（fd 将被登记）
+     * - CLOSE：拒绝并应立即断开连接
+     *
+     * @note
+     * - connect 阶段通常不使用 DROP
+     * - 若命中黑名单或高风险状态，将直接返回 CLOSE
+     */
+            DefenseDecision allowConnect(const std::string &ip, const int &fd,const int &times, const int &secs);
+        /**
+     * @brief 对已建立连接的一次请求进行安全裁决。
+     *
+     * @param ip 对端 IP 地址。
+     * @param fd 当前请求对应的文件描述符。
+     * @param path 请求路径（用于 path 级限流）。
+     * @param times fd 级请求速率上限。
+     * @param secs 请求速率统计窗口（秒）。
+     *
+     * @return DefenseDecision
+     * - ALLOW：正常处理请求
+     * - DROP：无视本次请求（不回应）
+     * - CLOSE：断开连接
+     */
+            DefenseDecision allowRequest(const std::string &ip,const int &fd,const std::string_view &path,const int &times,const int &secs);
+
+            // ========== 生命周期 ==========
+        /**
+     * @brief 在连接断开时回收对应 fd 的状态。
+     *
+     * @param ip 对端 IP 地址。
+     * @param fd 已关闭的文件描述符。
+     *
+     * @note
+     * - 必须在 close(fd) 后调用
+     * - 用于维护 activeConnections 与内部状态一致性
+     */
+            void clearIP(const std::string &ip,const int &fd);
+        /**
+     * @brief 检测并清理僵尸连接（fd 级）。
+     *
+     * @param ip 对端 IP 地址。
+     * @param fd 待检测的文件描述符。
+     *
+     * @return true  该连接被判定为僵尸并已清理
+     * @return false 未超时或不存在
+     *
+     * @note
+     * - “活动”指 allowConnect / allowRequest 更新 lastActivity
+     * - 建议由外部定时器触发调用，避免热路径扫描
+     */
+            bool connectionDetect(const std::string &ip,const int &fd);
+        /**
+     * @brief 返回僵尸连接检测的超时时间（秒），< 0 表示不做检测。
+     */
+            int getConnectionTimeout() const{return connectionTimeout;}
+        /**
+ * @brief 立即将指定 IP 加入黑名单（直接封禁）。
+ *
+ * @details
+ * 该接口用于在检测到“明确恶意行为”时，绕过评分与渐进惩罚，
+ * 直接对 IP 进行封禁（写入黑名单）。
+ *
+ * 封禁语义说明：
+ * - 若 IP 当前不在黑名单中：直接加入；
+ * - 若 IP 已在黑名单中：@b 刷新（覆盖）封禁到期时间；
+ * - 若 banSeconds < 0：表示永久封禁（使用 time_point::max）。
+ *
+ * @param ip 需要封禁的 IP 地址。
+ * @param banSeconds 封禁时长（秒）：
+ *   - > 0 ：封禁 banSeconds 秒（短期封禁）
+ *   - = 0 ：不做任何操作
+ *   - < 0 ：永久封禁
+ * @param reasonCN 封禁原因（中文，用于日志）。
+ * @param reasonEN 封禁原因（英文，用于日志）。
+ *
+ * @note
+ * - 本函数 @b 不会 立即断开已有连接；
+ *   外层逻辑应在返回 CLOSE 后自行 close(fd)。
+ * - 使用 steady_clock，不受系统时间调整影响。
+ * - 该接口是安全裁决的“终态动作”，应谨慎调用。
+  * @note
+ * - 若 IP 已被封禁且原到期时间晚于本次封禁时间，
+ *   将保留更长的封禁（不会缩短）。
+
+ */
+        void banIP(const std::string &ip,int banSeconds,const std::string &reasonCN,const std::string &reasonEN);
+        /**
+ * @brief 手动解除某个 IP 的黑名单。
+ */
+    void unbanIP(const std::string &ip);
+    /**
+    * @brief 判断某ip是否被封禁
+    */
+    bool isBanned(const std::string &ip) const;
+
+
+        private:
+            // 核心判定
+            bool allow(RateState &st,const RateLimitType &type,const int &times,const int &secs,const std::chrono::steady_clock::time_point &now);
+
+        private:
+            int maxConnections;
+            int connectionTimeout;
+
+            RateLimitType connectStrategy = RateLimitType::Cooldown;
+            RateLimitType requestStrategy = RateLimitType::SlidingWindow;
+            RateLimitType pathStrategy    = RateLimitType::SlidingWindow;
+
+            std::unordered_map<std::string, IPInformation> table;
+            std::unordered_map<std::string, std::pair<int,int>> pathConfig;
+            // IP -> 解封时间
+            std::unordered_map<std::string,std::chrono::steady_clock::time_point> blacklist;
+            // 多reactor模式下acceptor和各个reactor线程会同时访问
+            mutable std::mutex mtx;
+        };
+
+        
+        
+    }
+
+    /**
+    * @namespace stt::network
+    * @brief 网络框架，协议，通信，io多路复用相关
+    * @ingroup stt
+    */
+    namespace network
+    {
+    /**
+    * @brief 静态文件的打开句柄和元数据缓存
+    * @note 按路径缓存打开的fd、大小、修改时间、ETag和Last-Modified，同一个文件的请求不用每次open/fstat。按最近使用淘汰，超过容量时淘汰最久没用的。
+    * @note 一个条目最多每CHECK_INTERVAL毫秒重新stat一次，文件被替换或者修改后会重新打开。
+    * @note 条目用shared_ptr持有，被淘汰时正在发送的响应还持有原来的fd，发完才关闭。所有成员都是静态的，整个进程共用一个缓存，线程安全。
+    */
+    class FileCache
+    {
+    public:
+        /**
+        * @brief 两次stat检查之间的最短间隔（毫秒）
+        */
+        static constexpr int CHECK_INTERVAL=1000;
+        /**
+        * @brief 缓存的文件
+        */
+        struct Entry
+        {
+            /**
+            * @brief 只读打开的fd
+            */
+            int fd=-1;
+            /**
+            * @brief 文件大小（字节）
+            */
+            uint64_t size=0;
+            /**
+            * @brief 修改时间
+            */
+            time_t mtime=0;
+            /**
+            * @brief inode号 用来发现文件被替换
+            */
+            ino_t ino=0;
+            /**
+            * @brief ETag（带双引号）
+            */
+            std::string etag;
+            /**
+            * @brief Last-Modified的值（HTTP日期格式）
+            */
+            std::string lastModified;
+            /**
+            * @brief 上一次stat检查的时间
+            */
+            std::chrono::steady_clock::time_point checked;
+            ~Entry(){if(fd!=-1)::close(fd);}
+        };
+    private:
+        static std::mutex lc;
+        static std::list<std::pair<std::string,std::shared_ptr<Entry>>> lru;
+        static std::unordered_map<std::string,std::list<std::pair<std::string,std::shared_ptr<Entry>>>::iterator> table;
+        static size_t capacity;
+    public:
+        /**
+        * @brief 获取一个普通文件的缓存条目
+        * @param path 文件路径
+        * @return 缓存条目 文件不存在、不是普通文件或者打不开时返回nullptr
+        */
+        static std::shared_ptr<Entry> get(const std::string &path);
+        /**
+        * @brief 设置最多缓存多少个文件（默认256）
+        */
+        static void setCapacity(const size_t &capacity);
+        /**
+        * @brief 获取当前缓存的文件数量
+        */
+        static size_t size();
+        /**
+        * @brief 清空缓存
+        */
+        static void clear();
+    };
+
+    /**
+    * @brief 连接的非阻塞输出队列
+    * @note 发送时先直接写socket，写不完（EAGAIN或者TLS的WANT_WRITE）的部分按顺序存进队列，同时通过watchFun让reactor关注这个socket的可写事件（EPOLLOUT），可写时由reactor调用flush继续发送，发完后取消关注。发送线程不会因为对端接收慢而阻塞或者空转。
+    * @note 积压字节数达到高水位后isWritable返回false，直到flush把积压降到低水位以下才恢复，处理函数可以据此暂停生产数据（背压）。
+    * @note 线程安全，worker线程写入和reactor线程flush可以同时进行。
+    */
+    class OutputBuffer
+    {
+    private:
+        int fd;
+        std::mutex lo;
+        struct Chunk
+        {
+            std::string data;
+            std::shared_ptr<FileCache::Entry> file;//不为空时这一块是文件的一段
+            uint64_t fileOffset=0;
+            uint64_t fileLength=0;
+            Chunk(const char *data,const size_t &length):data(data,length){}
+            Chunk(std::string &&data):data(std::move(data)){}
+            Chunk(const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length):file(file),fileOffset(offset),fileLength(length){}
+        };
+        std::deque<Chunk> chunks;
+        size_t offset=0;
+        std::atomic<size_t> bytes{0};
+        size_t highWater;
+        size_t lowWater;
+        std::atomic<bool> overHigh{false};
+        bool watching=false;
+        bool closing=false;
+        bool closed=false;
+        bool ktls=false;//发送方向已经交给内核TLS
+        std::function<void(const bool &on)> watchFun;
+        static constexpr int IOV_BATCH=64;//一次sendmsg最多带的段数
+        static constexpr size_t TLS_BATCH=16384;//TLS下不超过这个大小的多段数据先拼成一条记录
+    private:
+        int sendSome(SSL *ssl,const char *data,const size_t &length,size_t &sent);
+        int sendSomeV(SSL *ssl,const struct iovec *iov,const int &iovcnt,size_t &sent,const int &flags=0);
+        int drain(SSL *ssl);
+    public:
+        static constexpr size_t FILE_PIECE=65536;//TLS下文件每次读出发送的大小
+        /**
+        * @brief 构造函数
+        * @param fd 套接字
+        * @param watchFun 开关可写事件关注的函数 参数为true时开始关注EPOLLOUT，false时取消关注
+        * @param highWater 高水位（字节） 积压达到这个值后isWritable返回false（默认4MB）
+        * @param lowWater 低水位（字节） 积压降到这个值以下后isWritable重新返回true（默认1MB）
+        */
+        OutputBuffer(const int &fd,const std::function<void(const bool &on)> &watchFun,const size_t &highWater=4*1024*1024,const size_t &lowWater=1024*1024):fd(fd),highWater(highWater),lowWater(lowWater),watchFun(watchFun){}
+        /**
+        * @brief 发送数据
+        * @note 队列为空时先直接发送，发不完的部分入队；队列不为空时直接入队，保证数据顺序
+        * @param ssl TLS加密句柄（没有则为nullptr）
+        * @param data 数据
+        * @param length 数据长度
+        * @return 接受的字节数（发出去的加上入队的，一定等于length） -1：连接出错或者已经关闭
+        */
+        int write(SSL *ssl,const char *data,const size_t &length);
+        /**
+        * @brief 分散发送多段数据
+        * @note 和write一样，但是多段数据（比如响应头和响应体）不用先拼接：明文用一次sendmsg发出，TLS下小的多段拼成一条记录，大的逐段写；只有发不完的部分才会拷贝进队列
+        * @param ssl TLS加密句柄（没有则为nullptr）
+        * @param iov 数据段数组
+        * @param iovcnt 段数
+        * @return 接受的字节数（一定等于各段长度之和） -1：连接出错或者已经关闭
+        */
+        int writev(SSL *ssl,const struct iovec *iov,const int &iovcnt);
+        /**
+        * @brief 发送一段响应头和紧跟着的一段文件
+        * @note 文件数据不经过用户态：明文用sendfile直接从文件发到socket，TLS下每次pread最多64KB再加密发送，内存占用有上限
+        * @param ssl TLS加密句柄（没有则为nullptr）
+        * @param head 文件前面要发送的数据（比如http响应头） 可以为空
+        * @param file 文件缓存条目
+        * @param offset 文件中的起始位置
+        * @param length 发送的长度
+        * @return 接受的字节数（head长度加上length） -1：连接出错或者已经关闭
+        */
+        int writeFile(SSL *ssl,const std::string &head,const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length);
+        /**
+        * @brief 标记发送方向已经由内核TLS（kTLS）加密
+        * @note 标记后普通数据直接用sendmsg聚合发送、文件用SSL_sendfile发送，由内核封装成TLS记录，不再经过SSL_write
+        * @param on true：开启
+        */
+        void setKernelTLS(const bool &on){std::lock_guard<std::mutex> lock(lo);ktls=on;}
+        /**
+        * @brief 发送方向是否由内核TLS加密
+        */
+        bool isKernelTLS(){std::lock_guard<std::mutex> lock(lo);return ktls;}
+        /**
+        * @brief 把队列里的数据尽量发出去
+        * @note 由reactor在收到可写事件后调用
+        * @param ssl TLS加密句柄（没有则为nullptr）
+        * @param resumed 返回本次是否从高水位以上降到了低水位以下
+        * @return 1：已经全部发完 0：socket又写满了，还有数据等待下一次可写 -1：连接出错
+        */
+        int flush(SSL *ssl,bool &resumed);
+        /**
+        * @brief 获取积压在队列里还没发出去的字节数
+        */
+        size_t pending() const{return bytes.load(std::memory_order_relaxed);}
+        /**
+        * @brief 是否可以继续写入
+        * @return true：积压没有超过高水位 false：积压超过了高水位，应该暂停发送，等待积压降到低水位以下
+        */
+        bool isWritable() const{return !overHigh.load(std::memory_order_relaxed);}
+        /**
+        * @brief 请求延迟关闭
+        * @note 还有积压数据时标记为正在关闭并返回true，调用者应等数据发完再真正关闭；没有积压或者已经在关闭中返回false，调用者应马上关闭
+        */
+        bool deferClose();
+        /**
+        * @brief 是否正在等待积压数据发完后关闭
+        */
+        bool isClosing();
+        /**
+        * @brief 丢弃积压的数据，之后的写入都返回失败
+        * @note 连接真正关闭时调用
+        */
+        void close();
+    };
+
+    /**
+    * @brief tcp协议的套接字操作类
+    */
+    class TcpFDHandler
+    {
+    protected:
+        int fd=-1;
+        bool flag1=false;
+        bool flag2=false;
+        SSL *ssl=nullptr;
+        int sec=-1;
+        std::shared_ptr<OutputBuffer> out;
+    public:
+        /**
+        * @brief 如果sendData的block=true，如果发送过程中连接断开，这个标志位会置为true
+        */
+        bool flag3=false;
+    public:
+        /**
+        * @brief 传入套接字初始化对象
+        * @note 可以选择设置套接字的阻塞和非阻塞，SO_REUSEADDR模式（只可能在服务端socket用到），还能选择该套接字加密后的SSL句柄
+        * @param fd 套接字
+        * @param ssl fd经过TLS加密后的SSL句柄（如果没有可以填nullptr）
+        * @param flag1 true：启用非阻塞模式  false：启用阻塞模式 （默认为false，即启用阻塞模式）
+        * @param flag2 true：启用SO_REUSEADDR模式  false：不启用SO_REUSEADDR模式 （默认为false，即不启用SO_REUSEADDR模式）
+        * @param sec 阻塞超时时间 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
+        */
+        void setFD(const int &fd,SSL *ssl,const bool &flag1=false,const bool &flag2=false,const int &sec=-1);
+        /**
+        * @brief 获取该对象的套接字
+        * @return 返回该对象的套接字
+        */
+        int getFD(){return fd;}
+        /**
+        * @brief 获取该对象的加密SSL句柄
+        * @return 返回加密SSL句柄。如果没有加密SSL句柄，返回nullptr。
+        */
+        SSL *getSSL(){return ssl;}
+        /**
+        * @brief 关闭对象
+        * @param cle true：关闭对象并且关闭原对象句柄的套接字的链接   false：仅关闭对象  （默认为ture，关闭对象也关闭连接）
+        */
+        void close(const bool &cle=true);
+        /**
+        * @brief 设置对象中的套接字为阻塞模式
+        * @param sec 阻塞超时时间 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
+        */
+        void blockSet(const int &sec = -1);
+        /**
+        * @brief 设置对象中的套接字为非阻塞模式
+        */
+        void unblockSet();
+        /**
+        * @brief 设置对象中的套接字为SO_REUSEADDR模式
+        */
+        bool multiUseSet();
+        /**
+        * @brief 判断对象是否有套接字绑定
+        * @return true：对象绑定了套接字  false：对象没有绑定套接字
+        */
+        bool isConnect(){if(fd==-1)return false;else return true;}
+        /**
+        * @brief 绑定连接的输出队列
+        * @note 绑定之后sendData不再阻塞等待socket可写：发不完的数据存进输出队列，由服务器的reactor在socket可写时继续发送。服务器传给处理函数的对象已经绑定好了。
+        * @note setFD会解除绑定，需要在setFD之后调用
+        * @param out 输出队列 传入nullptr则解除绑定
+        */
+        void setOutputBuffer(const std::shared_ptr<OutputBuffer> &out){this->out=out;}
+        /**
+        * @brief 获取输出队列里还没发出去的字节数
+        * @return 没有绑定输出队列时返回0
+        */
+        size_t getPendingBytes(){return out?out->pending():0;}
+        /**
+        * @brief 是否可以继续发送
+        * @return true：可以继续发送 false：输出队列积压超过了高水位，应该暂停发送，等积压降到低水位以下（TcpServer::setWritableFunction设置的回调会被调用）再继续
+        */
+        bool isWritable(){return out?out->isWritable():true;}
+    public:
+        /**
+        * @brief 向已连接的套接字发送字符串数据。
+        *
+        * @param data 要发送的数据内容（std::string 类型）。
+        * @param block 是否以阻塞模式发送（默认 true）。
+        *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；如果需要判断是否连接断开了可以检查flag3标志位判断。
+        *              - false：阻塞与否取决于套接字状态。
+        * 
+        * @return
+        * - 返回值 > 0：成功发送的字节数；
+        * - 返回值 = 0：连接已关闭（block=false）或者发送成功的字节数为0（block=true）；
+        * - 返回值 < 0（只可能在block=false的情况下）：发送失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式下，发送缓冲区已满。
+        *
+        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞），返回值一定>=0,适合希望确保完整发送的场景。如果需要判断是否连接断开了可以检查flag3标志位判断。
+        * 若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 希望发送的长度，需手动处理剩余数据。
+        * @note 绑定了输出队列（setOutputBuffer）时无论block取值都不会阻塞：发不完的部分进入输出队列，返回值为全部长度；连接出错时block=true返回0并且flag3置为true，block=false返回-1。
+        */
+        int sendData(const std::string &data,const bool &block=true);
+        /**
+        * @brief 向已连接的套接字发送指定长度的二进制数据。
+        *
+        * @param data 指向要发送的数据缓冲区。
+        * @param length 数据长度（字节）。
+        * @param block 是否以阻塞模式发送（默认 true）。
+        *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；如果需要判断是否连接断开了可以检查flag3标志位判断。
+        *              - false：阻塞与否取决于套接字状态。
+        * 
+        * @return
+        * - 返回值 > 0：成功发送的字节数；
+        * - 返回值 = 0：连接已关闭（block=false）或者发送成功的字节数为0（block=true）；
+        * - 返回值 < 0（只可能在block=false的情况下）：发送失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式下，发送缓冲区已满。
+        *
+        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞），返回值一定>=0,适合希望确保完整发送的场景。如果需要判断是否连接断开了可以检查flag3标志位判断。
+        * 若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 length，需手动处理剩余数据。
+        * @note 绑定了输出队列（setOutputBuffer）时无论block取值都不会阻塞：发不完的部分进入输出队列，返回值为全部长度；连接出错时block=true返回0并且flag3置为true，block=false返回-1。
+        */
+        int sendData(const char *data,const uint64_t &length,const bool &block=true);
+        /**
+        * @brief 向已连接的套接字分散发送多段数据
+        * @note 各段按顺序发送，不需要先拼接成一块；绑定了输出队列时明文用一次sendmsg发出，TLS下小的多段拼成一条记录
+        * @param iov 数据段数组
+        * @param iovcnt 段数
+        * @param block 是否以阻塞模式发送（默认 true），含义和sendData(const char*,...)一样
+        * @return 成功发送（或者进入输出队列）的字节数，其他返回值和sendData(const char*,...)一样
+        */
+        int sendData(const struct iovec *iov,const int &iovcnt,const bool &block=true);
+        /**
+        * @brief 向已连接的套接字发送一段数据和紧跟着的一段文件
+        * @note 绑定了输出队列时交给输出队列（明文用sendfile，TLS分块pread），不阻塞；没有绑定时明文用sendfile发送，TLS分块读出来发送，阻塞与否和sendData一样
+        * @param file 文件缓存条目（FileCache::get获取）
+        * @param offset 文件中的起始位置
+        * @param length 发送的长度
+        * @param head 文件前面要发送的数据（比如http响应头） 默认为空
+        * @param block 是否以阻塞模式发送（默认 true），含义和sendData一样
+        * @return 成功发送（或者进入输出队列）的字节数，其他返回值和sendData一样
+        */
+        int sendFile(const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length,const std::string &head="",const bool &block=true);
+        /**
+        * @brief 从已连接的套接字中阻塞接收指定长度的数据到字符串
+        *
+        * @param data 接收数据的数据容器（string类型）
+        * @param length 接收长度
+        * @param sec 等待时间 单位为秒 -1为无限阻塞等待 （默认为2s）
+        * @return
+        * - 返回值 > 0：成功接收的字节数；
+        * - 返回值 = 0：连接已关闭；
+        * - 返回值 < 0：接收失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：超时
+        *
+        * @note 如果没有接收完指定的数据大小，一定阻塞到超时或者出错
+        */
+        int recvDataByLength(std::string &data,const uint64_t &length,const int &sec=2);
+        /**
+        * @brief 从已连接的套接字中阻塞接收指定长度的数据到char*容器
+        *
+        * @param data 接收数据的数据容器（char*类型）
+        * @param length 接收长度
+        * @param sec 等待时间 单位为秒 -1为无限阻塞等待 （默认为2s）
+        * @return
+        * - 返回值 > 0：成功接收的字节数；
+        * - 返回值 = 0：连接已关闭；
+        * - 返回值 < 0：接收失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：超时
+        *
+        * @note 如果没有接收完指定的数据大小，一定阻塞到超时或者出错
+        */
+        int recvDataByLength(char *data,const uint64_t &length,const int &sec=2);
+        /**
+        * @brief 从已连接的套接字中接收一次数据到string字符串容器
+        * @param data 接收数据的数据容器（string类型）
+        * @param length 最大接收长度
+        * @return 
+        * - 返回值 > 0：成功接收的字节数；
+        * - 返回值 = 0：连接已关闭；
+        * - 返回值 < 0：接收失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式且没有数据
+        * @note 接收是否会阻塞根据fd的阻塞情况决定
+        */
+        int recvData(std::string &data,const uint64_t &length);
+        /**
+        * @brief 从已连接的套接字中接收一次数据到char*容器
+        * @param data 接收数据的数据容器（char*类型）
+        * @param length 最大接收长度
+        * @return 
+        * - 返回值 > 0：成功接收的字节数；
+        * - 返回值 = 0：连接已关闭；
+        * - 返回值 < 0：接收失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式且没有数据
+        * @note 接收是否会阻塞根据fd的阻塞情况决定
+        */
+        int recvData(char *data,const uint64_t &length);
+    };
+
+    /**
+    * @brief tcp协议客户端操作类
+    * @note 默认是阻塞模式的
+    */
+    class TcpClient:public TcpFDHandler
+    {
+    private:
+        std::string serverIP="";
+        int serverPort=-1;
+        bool flag=false;
+        bool TLS;
+        SSL_CTX *ctx=nullptr;
+        const char *ca;
+        const char *cert;
+        const char *key;
+        const char *passwd;
+    private:
+        bool createFD();
+        void closeAndUnCreate();
+        bool initCTX(const char *ca,const char *cert="",const char *key="",const char *passwd="");
+    public:
+        /**
+        * @brief TcpClient类的构造函数
+        * @param TLS true：启用TLS加密  false：不启用TLS加密 （默认为false不启用）
+        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
+        * @param cert 客户端证书路径（可选 默认空）
+        * @param key 客户端私钥路径（可选 默认空）
+        * @param passwd 私钥解密密码（可选 默认空）
+        * @note 
+        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
+        * -如果启用了TLS加密 ca必填 其他可选
+        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
+        */
+        TcpClient(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd="");
+        /**
+        * @brief 向服务端发起tcp连接
+        * @param ip 服务端ip
+        * @param port 服务端端口
+        * return  true：连接成功  false：连接失败
+        */
+        bool connect(const std::string &ip,const int &port);        
+        /**
+        * @brief 重新或第一次设置TLS加密参数
+        * @note 设置了的TLS参数伴随整个生命周期，除非调用这个函数重新设置
+        * @param TLS true：启用TLS加密  false：不启用TLS加密 （默认为false不启用）
+        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
+        * @param cert 客户端证书路径（可选 默认空）
+        * @param key 客户端私钥路径（可选 默认空）
+        * @param passwd 私钥解密密码（可选 默认空）
+        * @note 
+        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
+        * -如果启用了TLS加密 ca必填 其他可选
+        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
+        */
+        void resetCTX(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd="");
+        /**
+        * @brief 如果对象有套接字连接，关闭和释放这个连接和套接字，并且重新新建一个套接字。
+        * @return true：关闭成功，新建套接字成功   false：关闭成功，新建套接字失败
+        */
+        bool close();
+        /**
+        * @brief TcpClient的析构函数，会关闭释放套接字和其连接
+        */
+        ~TcpClient(){closeAndUnCreate();}
+    public:
+        /**
+        * @brief 返回已连接的服务端的ip
+        * return 已连接的服务端的ip
+        */
+        std::string getServerIP(){return serverIP;}
+        /**
+        * @brief 返回已连接的客户端的端口
+        * return 已连接的服务端的端口
+        */
+        int getServerPort(){return serverPort;}
+        /**
+        * @brief 返回对象的连接状态
+        * @return  true：已连接  false：未连接
+        */
+        bool isConnect(){return flag;}
+    };  
+
+    /**
+    * @brief Http/Https客户端操作类
+    * @note 
+    * -请求头都会自动带上Connection: keep-alive
+    * -如果需要重新设置TLS/Https加密的证书，目前需要销毁对象后重新构造
+    * -如果没用传入套接字的函数，底层TCP默认是阻塞的
+    */
+    class HttpClient:private TcpClient
+    {
+    private:
+        bool flag=false;
+    public:
+        /**
+        * @brief HttpClient类的构造函数
+        * @param TLS true：启用Https加密  false：不启用Https加密 （默认为false不启用）
+        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
+        * @param cert 客户端证书路径（可选 默认空）
+        * @param key 客户端私钥路径（可选 默认空）
+        * @param passwd 私钥解密密码（可选 默认空）
+        * @note 
+        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
+        * -如果启用了Https加密 ca必填 其他可选
+        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
+        */
+        HttpClient(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd=""):TcpClient(TLS,ca,cert,key,passwd){}
+    public:
+        /**
+        * @brief 发送一个GET请求到服务器
+        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
+        * @note 如果使用了TLS，会自动采用https协议，否则是自动采用http协议
+        * @note 默认是阻塞的
+        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
+        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
+        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
+        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
+        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        */
+        bool getRequest(const std::string &url,const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=-1);
+        /**
+        * @brief 发送一个POST请求到服务器
+        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
+        * @note 如果使用了TLS，会自动采用https协议，否则是自动采用http协议
+        * @note 默认是阻塞的
+        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        * @param body http请求体
+        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
+        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
+        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
+        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
+        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        */
+        bool postRequest(const std::string &url,const std::string &body="",const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=-1);
+        /**
+        * @brief 从tcp套接字发送一个GET请求到服务器
+        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
+        * @note 如果填入的ssl不为nullptr，会自动采用https协议，否则是自动采用http协议
+        * @note 调用的时候会阻塞，改变原有fd的状态，注意备份和恢复
+        * @param fd tcp套接字
+        * @param ssl TLS加密套接字
+        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
+        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
+        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为2s
+        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
+        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        */
+        bool getRequestFromFD(const int &fd,SSL *ssl,const std::string &url,const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=2);
+        /**
+        * @brief 发送一个POST请求到服务器
+        * @note 返回结果请调用isReturn函数判断；如果有返回结果，返回头和返回体存在header和body这两个全局变量中。
+        * @note 如果填入的ssl不为nullptr，会自动采用https协议，否则是自动采用http协议
+        * @note 调用的时候会阻塞，改变原有fd的状态，注意备份和恢复
+        * @param fd tcp套接字
+        * @param ssl TLS加密套接字
+        * @param url http/https的完整url（注意需要显式指定端口和路径） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        * @param body http请求体
+        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
+        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（默认填入了keepalive项）
+        * @param sec 阻塞超时时间(s) 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
+        * @return true：请求发送成功   false：请求发送失败  注意：这不代表是否返回，只说明了发送成功
+        * @warning 需要http/https协议的完整url（注意需要显式指定端口和路径（就算路径不需要也要填入/）） 如：https://google.com 要写成https://google.com:443/ (补全:443和/)
+        */
+        bool postRequestFromFD(const int &fd,SSL *ssl,const std::string &url,const std::string &body="",const std::string &header="",const std::string &header1="Connection: keep-alive",const int &sec=2);
+    public:
+        /**
+        * @brief 获取服务器返回响应状态
+        * @return true：服务器返回响应成功  false：服务器返回响应失败
+        */
+        bool isReturn(){return flag;}
+        /**
+        * @brief 服务器返回响应头
+        */
+        std::string header="";
+        /**
+        * @brief 服务器返回响应体
+        */
+        std::string body="";
+    };
+    
+    /**
+    * @brief 用epoll监听单个句柄
+    */
+    class EpollSingle
+    {
+    private:
+        int fd;
+        bool flag=true;
+        std::function<bool(const int &fd)> fc=[](const int &fd)->bool
+        {return true;};
+        std::function<void(const int &fd)> fcEnd=[](const int &fd)->void
+        {};
+        std::function<bool(const int &fd)> fcTimeOut=[](const int &fd)->bool
+        {return true;};
+        bool flag1=true;
+        bool flag2=false;
+        time::Duration dt{0,20,0,0,0};
+        bool flag3=false;
+        time::Duration t;
+    private:
+        void epolll();
+    public:
+        /**
+        * @brief 开始监听
+        * @param fd 需要监听的句柄
+        * @param flag  true：水平触发    false：边缘触发
+        * @param dt 填入监听超时时间
+        */
+        void startListen(const int &fd,const bool &flag=true,const time::Duration &dt=time::Duration{0,0,20,0,0});
+    public:
+        /**
+        * @brief 返回epoll监听状态
+        * @return true：正在监听  false：没有监听
+        */
+        bool isListen(){return flag2;}
+        /**
+        * @brief 设置epoll触发后的处理函数
+        * 注册一个回调函数
+        * @param fc 一个函数或函数对象，用于当有数据时上来的时候回调处理套接字fd
+        * -参数：const int &fd - 要处理的套接字
+        * -返回： bool - 返回true成功成功，返回false处理失败
+        * @note 传入的函数应该有如下签名 bool func(const int &fd)
+        * @note 如果处理失败了 会退出epoll监听（没有关闭套接字）
+        */
+        void setFunction(std::function<bool(const int &fd)> fc){this->fc=fc;}
+        /**
+        * @brief 设置epoll退出前的回调函数
+        * 注册一个回调函数
+        * @param fcEnd 一个函数或函数对象，用于处理epoll退出前的流程
+        * -参数：const int &fd - 要处理的套接字
+        * @note 传入的函数应该有如下签名 void func(const int &fd)
+        */
+        void setEndFunction(std::function<void(const int &fd)> fcEnd){this->fcEnd=fcEnd;};
+        /**
+        * @brief 设置epoll超时后出发的回调函数
+        * 注册一个回调函数
+        * @param fc 一个函数或函数对象，用于当epoll超时的时候回调处理套接字fd
+        * -参数：const int &fd - 要处理的套接字
+        * -返回： bool - 返回true成功成功，返回false处理失败
+        * @note 传入的函数应该有如下签名 bool func(const int &fd)
+        * @note 如果处理失败了 会退出epoll监听（没有关闭套接字）
+        */
+        void setTimeOutFunction(std::function<bool(const int &fd)> fcTimeOut){this->fcTimeOut=fcTimeOut;};
+        /**
+        * @brief 结束epoll监听
+        * 会阻塞直到epoll退出完成
+        * @return true：处理结束  false：结束失败
+        */
+        bool endListen();
+        /**
+        * @brief 发送结束epoll的信号
+        * @note 仅仅发送信号，不跟进后续逻辑
+        */
+        void endListenWithSignal(){flag1=false;}
+        /**
+        * @brief 开始退出epoll倒计时，直到套接字有新的消息
+        * 如果套接字倒计时结束还没有新的消息，那么退出epoll
+        * @param t 一个Duration对象 填入倒计时时长 （默认为10秒）
+        */
+        void waitAndQuit(const time::Duration &t=time::Duration{0,0,0,10,10}){flag3=true;this->t=t;}
+        /**
+        * @brief EpollSingle的析构函数
+        * 调用eldListen阻塞退出epoll
+        */
+        ~EpollSingle(){endListen();}
+    };
+    
+    /**
+    * @brief Websocket客户端操作的类
+    * -如果需要重新设置TLS/Https加密的证书，目前需要销毁对象后重新构造
+    * 底层TCP默认是阻塞的
+    */
+    class WebSocketClient:private TcpClient 
+    {
+    private:
+        bool flag4=false;
+        std::function<bool(const std::string &message,WebSocketClient &k)> fc=[](const std::string &message,WebSocketClient &k)->bool
+        {std::cout<<"收到: "<<message<<std::endl;return true;};
+        std::string url;
+        EpollSingle k;
+        bool flag5=false;
+    private:
+        bool close1();
+    public:
+        /**
+        * @brief WebSocketClient类的构造函数
+        * @param TLS true：启用wss加密  false：不启用wss加密 （默认为false不启用）
+        * @param ca CA 根证书路径（若启用TLS加密则必须填这个 默认空）
+        * @param cert 客户端证书路径（可选 默认空）
+        * @param key 客户端私钥路径（可选 默认空）
+        * @param passwd 私钥解密密码（可选 默认空）
+        * @note 
+        * -ca用来校验对方服务器的证书是否可信（可以用操作系统自带的根证书验证）
+        * -如果启用了wss加密 ca必填 其他可选
+        * -如果服务端要求客户端身份认证（双向 TLS/SSL），你需要提供一个有效的客户端证书。
+        */
+        WebSocketClient(const bool &TLS=false,const char *ca="",const char *cert="",const char *key="",const char *passwd=""):TcpClient(TLS,ca,cert,key,passwd){}
+        /**
+        * @brief 设置收到服务端消息后的回调函数
+        * 注册一个回调函数
+        * @param fc 一个函数或函数对象，用于收到服务端消息后处理逻辑
+        * -参数：string &message - 要处理的套接字
+                WebsocketClient &k - 当前对象的引用
+        * -返回： bool - 返回true处理成功，返回false处理失败
+        * @note 传入的函数应该有如下签名 bool func(const std::string &message,WebSocketClient &k)
+        * @note 如果处理失败了 会直接关闭整个websocket连接
+        */
+        void setFunction(std::function<bool(const std::string &message,WebSocketClient &k)> fc){this->fc=fc;}
+        /**
+        * @brief 连接到websocket服务器
+        * @param url ws/wss的完整url（注意需要显式指定端口和路径） 如：wss://google.com 要写成wss://google.com:443/ (补全:443和/)
+        * @param min 心跳时间，单位分钟 （默认为20分钟）
+        * @warning 需要ws/wss的完整url（注意需要显式指定端口和路径） 如：wss://google.com 要写成wss://google.com:443/ (补全:443和/) 
+        */
+        bool connect(const std::string &url,const int &min=20);
+        /**
+        * @brief 发送 WebSocket 消息
+        * 
+        * 根据 WebSocket 协议，封装并发送一条带掩码的数据帧（客户端必须使用掩码），
+        * 支持根据 payload 长度自动选择帧格式：
+        * - payload <= 125 字节：使用 1 字节长度
+        * - 126 <= payload <= 65535：使用 2 字节扩展长度（附加 126 标记）
+        * - payload > 65535：使用 8 字节扩展长度（附加 127 标记）
+        * 
+        * @param message 要发送的消息内容（已编码为文本或二进制）
+        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
+        *        约定格式为 `"1000" + type`，其中：
+        *        - "0001" 表示文本帧（Text Frame）
+        *        - "0010" 表示二进制帧（Binary Frame）
+        *        - "1000" 表示连接关闭（Close Frame）
+        *        - "1001" 表示 Ping 帧
+        *        - "1010" 表示 Pong 帧
+        *        请根据内部约定使用，默认使用 text（文本帧）
+        * 
+        * @return true 发送成功
+        * @return false 发送失败（可能因连接未建立或发送异常）
+        */
+        bool sendMessage(const std::string &message,const std::string &type="0001");
+        /**
+        * @brief 发送关闭帧并关闭 WebSocket 连接（简化方式）
+        * 
+         * 直接传入编码后的关闭 payload，其中前两字节为关闭码（big-endian），
+         * 后续为 UTF-8 编码的关闭原因描述，用于简化调用。
+        * 
+        * @param closeCodeAndMessage 编码后的关闭帧 payload（2 字节关闭码 + 可选消息）
+        * @param wait 是否等待底层监听线程/epoll事件处理后退出
+        */
+        void close(const std::string &closeCodeAndMessage,const bool &wait=true);
+        /**
+        * @brief 发送关闭帧并关闭 WebSocket 连接（标准方式）
+        * 
+        * 构建符合 RFC 6455 的关闭帧（opcode = 0x8），帧 payload 包含关闭码（2 字节）与可选关闭原因字符串。
+        * 
+        * @param code WebSocket 关闭码，常见包括：
+        * - 1000：正常关闭（Normal Closure）
+        * - 1001：终端离开（Going Away）
+        * - 1002：协议错误（Protocol Error）
+        * - 1003：不支持的数据类型（Unsupported Data）
+        * - 1006：非正常关闭（无关闭帧，程序内部使用）
+        * - 1008：策略违规（Policy Violation）
+        * - 1011：服务器内部错误（Internal Error）
+        * 
+        * @param message 可选关闭原因，供调试或日志记录用
+        * @param wait 是否等待底层监听线程/epoll事件处理后退出
+        */
+        void close(const short &code=1000,const std::string &message="bye",const bool &wait=true);       
+    public:
+        /**
+        * @brief 返回连接状态
+        * @return true：和服务器存在连接  false：没有连接
+        */
+        bool isConnect(){return flag4;}
+        /**
+        * @brief 如果连接到了服务器 返回url
+        * @return 返回url
+        */
+        std::string getUrl(){return url;}
+        /**
+        * @brief 如果连接到了服务器 返回服务器ip
+        * @return 返回服务器ip
+        */
+        std::string getServerIp(){return TcpClient::getServerIP();}
+        /**
+        * @brief 如果连接到了服务器 返回服务器端口
+        * @return 返回服务器端口
+        */
+        std::string getServerPort(){return TcpClient::getServerIP();}
+        /**
+        * @brief WebSocketClient类的析构函数，销毁对象时候会优雅退出断开连接
+        */    
+        ~WebSocketClient();
+    };
+
+    /**
+    * @brief 保存HTTP/HTTPS请求信息的结构体
+    */
+    struct HttpRequestInformation 
+    {
+        /**
+        * @brief 底层的socket套接字
+        */
+        int fd;
+        /**
+        * @brief 连接对象fd
+        */
+        uint64_t connection_obj_fd;
+        /**
+        * @brief 请求类型
+        */
+        std::string type;
+        /**
+        * @brief url中的路径和参数
+        */
+        std::string locPara;
+        /**
+        * @brief url中的路径
+        */
+        std::string loc;
+        /**
+        * @brief url中的参数
+        */
+        std::string para;
+        /**
+        * @brief 请求头
+        */
+        std::string header;
+        /**
+        * @brief 请求体
+        */
+        std::string body;
+        /**
+        * @brief 请求体（chunked）
+        */
+        std::string body_chunked;
+        /**
+        * @brief 所需的数据仓库
+        */
+        std::unordered_map<std::string,std::any> ctx;
+    };
+    
+    struct TcpFDInf;
+    /**
+    * @brief 解析，响应Http/https请求的操作类
+    * 仅传入套接字，然后使用这个类进行Http的操作
+    */
+    class HttpServerFDHandler:public TcpFDHandler
+    {
+    public:
+        /**
+        * @brief 初始化对象，传入套接字等参数
+        * @param fd 套接字
+        * @param ssl TLS加密的SSL句柄(默认为nullptr)
+        * @param flag1 true：启用非阻塞模式  false：启用阻塞模式 （默认为false，即启用阻塞模式）
+        * @param flag2 true：启用SO_REUSEADDR模式  false：不启用SO_REUSEADDR模式 （默认为true，即启用SO_REUSEADDR模式）
+        */
+        void setFD(const int &fd,SSL *ssl=nullptr,const bool &flag1=false,const bool &flag2=true){TcpFDHandler::setFD(fd,ssl,flag1,flag2);}
+        /**
+        * @brief 解析Http/Https请求
+        * @param TcpInf 存放底层tcp处理套接字的信息
+        * @param HttpInf 存放Http协议的信息
+        * @param buffer_size 服务器定义的解析缓冲区的大小（单位为字节)
+        * @param times 记录解析的次数，某些场景会用上
+        * @return -1:解析失败 0:还需要继续解析 1:解析完成
+        * @note TcpInf.status
+        *
+        * 0 初始状态
+        * 1 接收请求头中
+        * 2 接收请求体中(chunk模式)
+        * 3 接收请求体中(非chunk模式)
+        * 
+        */
+        int solveRequest(TcpFDInf &TcpInf,HttpRequestInformation &HttpInf,const unsigned long &buffer_size,const int &times=1);
+        /**
+        * @brief 发送Http/Https响应
+        * @param data 装着响应体的数据的string容器
+        * @param code Http响应状态码和状态说明 （默认是 200 OK）
+        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
+        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（比如可以默认填入keepalive项）
+        * @note 响应头和响应体分两段一起发送（sendData的iovec版本），响应体不会被拷贝
+        * @return  true：发送响应成功  false：发送响应失败
+        */
+        bool sendBack(const std::string &data,const std::string &header="",const std::string &code="200 OK",const std::string &header1="");
+        /**
+        * @brief 发送Http/Https响应
+        * @param data 装着响应体的数据的char *容器
+        * @param length char*容器中的数据长度
+        * @param code Http响应状态码和状态说明 （默认是 200 OK）
+        * @param header Http请求头；如果不是用createHeader生成，记得在末尾要加上\r\n。
+        * @param header1 HTTP请求头的附加项；如果需要，一定要填入一个有效项；末尾不需要加入\r\n（不能用createHeader）。（比如可以默认填入keepalive项）
+        * @param header_length 不再使用，只为兼容保留（响应头放在线程本地的缓冲区里生成，长度不受限制）
+        * @note 响应头和响应体分两段一起发送（sendData的iovec版本），响应体不会被拷贝
+        * @warning header,code,header1必须确保\0结尾 data按length发送，可以包含\0
+        * @return  true：发送响应成功  false：发送响应失败
+        */
+        bool sendBack(const char *data,const size_t &length,const char *header="\0",const char *code="200 OK\0",const char *header1="\0",const size_t &header_length=50);
+        using TcpFDHandler::sendFile;
+        /**
+        * @brief 发送一个静态文件作为Http/Https响应
+        * @note 文件的fd和元数据来自FileCache，响应体用TcpFDHandler::sendFile发送（明文sendfile零拷贝，TLS分块读取），大文件下载几乎不占用户态的CPU和内存
+        * @note 自动加上Content-Type（按扩展名）、ETag、Last-Modified和Accept-Ranges；请求带If-None-Match且和ETag一致时回复304；支持单个区间的Range（bytes=a-b、bytes=a-、bytes=-n），回复206，区间无效时回复416；多个区间时忽略Range回复整个文件；HEAD请求只发送响应头
+        * @param path 文件路径
+        * @param inf 请求信息（读取请求方法和Range、If-None-Match请求头）
+        * @param header Http响应头；如果不是用createHeader生成，记得在末尾要加上\r\n。包含Content-Type时不再自动添加
+        * @param header1 HTTP响应头的附加项；末尾不需要加入\r\n（不能用createHeader）
+        * @return 1：已经发送响应 0：文件不存在或者不是普通文件，什么都没有发送 -1：发送失败
+        */
+        int sendFile(const std::string &path,const HttpRequestInformation &inf,const std::string &header="",const std::string &header1="");
+    };
+    /**
+    * @brief 保存客户端WS/WSS请求信息的结构体
+    */
+    struct WebSocketFDInformation
+    {
+        /**
+        * @brief 底层的socket套接字
+        */
+        int fd;
+        /**
+        * @brief 连接对象fd
+        */
+        uint64_t connection_obj_fd;
+        /**
+        * @brief true:发送了关闭帧  false：没有发送关闭帧
+        */
+        bool closeflag;
+        /**
+        * @brief  握手阶段的Http/Https路径和参数
+        */
+        std::string locPara;
+        /**
+        * @brief  握手阶段的Http/Https请求头
+        */
+        std::string header;
+        /**
+        * @brief 发送心跳的时间（没有发送过就填0） (检查完又要清空为0)
+        */
+        time_t HBTime=0;
+        /**
+        * @brief 上次收到信息的时间
+        */
+        time_t response;
+        /**
+        * @brief 待接收的长度
+        */
+        size_t recv_length;
+        /**
+        * @brief 已经接收的长度
+        */
+        size_t have_recv_length;
+        /**
+        * @brief 消息类型
+        */
+        int message_type;
+        /**
+        * @brief 消息
+        */
+        std::string message="";
+        /**
+        * @brief fin的状态
+        */
+        bool fin;
+        /**
+        * @brief mask
+        */
+        std::string mask;
+        /**
+        * @brief 所需的数据仓库
+        */
+        std::unordered_map<std::string,std::any> ctx;
+        /**
+        * @brief 握手阶段保存的http信息
+        */
+        HttpRequestInformation httpinf;
+    };
+
+    /**
+    * @brief 保存Tcp客户端的信息
+    */
+    struct TcpInformation
+    {
+        /**
+        * @brief 套接字fd
+        */
+        int fd;
+        /**
+        * @brief 连接对象fd
+        */
+        uint64_t connection_obj_fd;
+        /**
+        * @brief 裸数据
+        */
+        std::string data;
+        /**
+        * @brief 所需的数据仓库
+        */
+        std::unordered_map<std::string,std::any> ctx;
+    };
+
+    enum class TLSState : uint8_t {
+    NONE = 0,        // 非 TLS 连接（普通 TCP）
+    HANDSHAKING,    // TLS 握手中（SSL_accept 还没完成）
+    ESTABLISHED,    // TLS 已建立，可以 SSL_read / SSL_write
+    ERROR           // TLS 出错（可选）
+    };
+
+    /**
+    * @brief 服务端使用的事件引擎
+    */
+    enum class EventEngine : uint8_t {
+    EPOLL = 0,       // epoll边缘触发（默认）
+    IO_URING        // io_uring：multishot poll + multishot accept，内核不支持时自动回退到epoll
+    };
+
+    /**
+    * @brief 接收缓冲区池（按大小分级的slab）
+    * @note 连接只在有未解析完的数据时持有缓冲区，数据全部消费完之后缓冲区还回池里，空闲的长连接不占接收内存。
+    * 缓冲区按4KB、16KB、64KB、256KB、1MB、4MB分级：先拿最小的一级，装满了再换成上一级（保留已有数据），超过4MB的直接new/delete不缓存。
+    * 每一级有自己的空闲链表和锁，多个reactor可以同时使用。所有成员都是静态的，整个进程共用一个池。
+    * @note 多个NUMA节点的机器上每个节点有自己的一组空闲链表：拿和还都走当前线程所在节点的链表，绑定了CPU的reactor只会拿到本节点的内存（见TcpServer::setAffinity）。
+    */
+    class RecvBufferPool
+    {
+    public:
+        /**
+        * @brief 大小分级的数量
+        */
+        static constexpr int CLASS_NUM=6;
+        /**
+        * @brief 最小一级的大小（字节）
+        */
+        static constexpr unsigned long MIN_CLASS=4096;
+        /**
+        * @brief 分别缓存的NUMA节点数上限 节点编号超过的按取模共用
+        */
+        static constexpr int MAX_NODES=8;
+        /**
+        * @brief 某一级的统计信息
+        */
+        struct ClassStat
+        {
+            /**
+            * @brief 这一级缓冲区的大小（字节）
+            */
+            unsigned long size;
+            /**
+            * @brief 正在被连接使用的数量
+            */
+            uint64_t inUse;
+            /**
+            * @brief 同时使用数量的历史最大值（高水位）
+            */
+            uint64_t highWater;
+            /**
+            * @brief 空闲链表里缓存的数量
+            */
+            uint64_t cached;
+        };
+    private:
+        struct SizeClass
+        {
+            std::atomic<uint64_t> inUse{0};
+            std::atomic<uint64_t> highWater{0};
+        };
+        struct FreeList
+        {
+            std::mutex mtx;
+            std::vector<char*> buffers;
+        };
+        static SizeClass classes[CLASS_NUM];
+        static FreeList freeLists[MAX_NODES][CLASS_NUM];
+        static std::atomic<uint64_t> bytesInUse;
+        static std::atomic<uint64_t> bytesHighWater;
+        static std::atomic<size_t> cacheLimit;
+        static int classOf(const unsigned long &size);
+        static unsigned long classSize(const int &cls){return MIN_CLASS<<(2*cls);}
+        static int nodeIndex();
+    public:
+        /**
+        * @brief 从池里拿一块至少size字节的缓冲区
+        * @param size 需要的大小（字节）
+        * @param cap 返回实际的容量（字节） 归还时要原样传回
+        * @return 缓冲区指针
+        */
+        static char* acquire(const unsigned long &size,unsigned long &cap);
+        /**
+        * @brief 把缓冲区还回池里
+        * @param buffer acquire拿到的缓冲区 nullptr时什么都不做
+        * @param cap acquire返回的容量
+        */
+        static void release(char *buffer,const unsigned long &cap);
+        /**
+        * @brief 保证连接的缓冲区容量至少为need字节
+        * @note 没有缓冲区时从池里拿，容量不够时换成更大的一级并且拷贝已有的p_buffer_now字节的数据
+        * @param inf 连接信息
+        * @param need 需要的容量（字节）
+        */
+        static void reserve(TcpFDInf &inf,const unsigned long &need);
+        /**
+        * @brief 连接没有未解析的数据时把缓冲区还回池里
+        * @param inf 连接信息
+        */
+        static void recycle(TcpFDInf &inf);
+        /**
+        * @brief 设置每一级空闲链表缓存的字节上限 超过的部分直接释放（默认每个节点每级64MB）
+        */
+        static void setCacheLimit(const size_t &bytes){cacheLimit=bytes;}
+        /**
+        * @brief 返回每一级的使用量和高水位（所有NUMA节点合计）
+        */
+        static std::vector<ClassStat> getStats();
+        /**
+        * @brief 返回当前被连接持有的缓冲区总字节数
+        */
+        static uint64_t getBytesInUse(){return bytesInUse;}
+        /**
+        * @brief 返回被连接持有的缓冲区总字节数的历史最大值（高水位）
+        */
+        static uint64_t getBytesHighWater(){return bytesHighWater;}
+    };
+
+    /**
+    * @brief 保存底层基础Tcp通道信息的结构体
+    */
+    struct TcpFDInf
+    {
+        /**
+        * @brief 套接字fd
+        */
+        int fd;
+        /**
+        * @brief 连接对象fd
+        */
+        uint64_t connection_obj_fd;
+        /**
+        * @brief 客户端地址（二进制，accept时直接保存，不做格式化）
+        */
+        sockaddr_storage addr;
+        /**
+        * @brief addr的有效长度 为0时表示还没有取得（io_uring的multishot accept不带对端地址，第一次用到时才调用getpeername）
+        */
+        socklen_t addr_len;
+        /**
+        * @brief 客户端ip 第一次调用getIP时才从addr格式化 之前为空
+        * @note 开启安全模块时accept阶段就要用到，会马上格式化
+        */
+        std::string ip;
+        /**
+        * @brief 客户端端口 第一次调用getPort时才从addr格式化 之前为空
+        */
+        std::string port;
+        /**
+        * @brief 获取客户端ip 第一次调用时格式化并缓存
+        * @note 应该在处理这个连接的线程里调用
+        */
+        const std::string& getIP(){if(ip.empty())formatAddress();return ip;}
+        /**
+        * @brief 获取客户端端口 第一次调用时格式化并缓存
+        * @note 应该在处理这个连接的线程里调用
+        */
+        const std::string& getPort(){if(port.empty())formatAddress();return port;}
+        /**
+        * @brief 把二进制地址格式化成ip和端口字符串（支持IPv4和IPv6）
+        * @param addr 地址
+        * @param ip 存放ip
+        * @param port 存放端口
+        */
+        static void formatAddress(const sockaddr_storage &addr,std::string &ip,std::string &port);
+    private:
+        void formatAddress();
+    public:
+        /**
+         * @brief 记录当前处理状态机到第几步了
+         */
+        int FDStatus;
+        /**
+        * @brief 等待处理的队列
+        */
+        std::queue<std::any> pendindQueue;
+        /**
+        * @brief 当前fd的接收状态，用于保存接收处理机逻辑
+        */
+        int status;
+        /**
+        * @brief 保存收到的客户端传来的数据
+        */
+        std::string_view data;
+        /**
+        * @brief 如果加密了，存放加密句柄
+        */
+        SSL* ssl;
+        /**
+        * @brief tls状态
+        */
+        TLSState tls_state;
+        /**
+        * @brief 接收空间指针 没有未解析的数据时为nullptr（缓冲区已经还回RecvBufferPool）
+        */
+        char *buffer;
+        /**
+        * @brief 接收空间的容量 为0时表示没有持有缓冲区
+        */
+        unsigned long buffer_cap;
+        /**
+        * @brief 接收空间位置指针
+        */
+        unsigned long p_buffer_now;
+        /**
+        * @brief 负责这个连接的I/O事件循环(reactor)编号
+        */
+        int reactor;
+        /**
+        * @brief 连接的输出队列 用std::atomic_load/std::atomic_store读写
+        */
+        std::shared_ptr<OutputBuffer> out;
+    };
+
+    /**
+    * @brief 按fd下标访问的稀疏连接表
+    * @note 表按页（每页PAGE_SIZE个元素）切分，只有某一页里第一次有fd被访问时才分配并初始化这一页，启动时只分配一个页指针数组，不再一次性构造maxFD个元素。
+    * @note 每页带一个活跃位图，setLive标记的fd可以用forEachLive遍历，遍历只访问已分配且有活跃连接的页，不再扫描整个maxFD。
+    * @note 页一旦分配就不会在运行中释放，所以拿到的引用在clear之前一直有效；operator[]可以被多个线程同时调用。
+    * @tparam T 表里保存的元素类型
+    */
+    template<class T>
+    class ConnectionTable
+    {
+    public:
+        /**
+        * @brief 每页的元素个数
+        */
+        static constexpr int PAGE_SIZE=1024;
+    private:
+        struct Page
+        {
+            T items[PAGE_SIZE];
+            std::atomic<uint64_t> live[PAGE_SIZE/64];
+            std::atomic<int> liveNum{0};
+        };
+        std::unique_ptr<std::atomic<Page*>[]> pages;
+        int pageNum=0;
+        unsigned long long maxFD=0;
+        std::function<void(T&)> initFun;
+        std::mutex lpage;
+        std::atomic<size_t> allocated{0};
+        std::atomic<size_t> liveCount{0};
+    private:
+        Page* getPage(const int &fd)
+        {
+            std::atomic<Page*> &slot=pages[fd/PAGE_SIZE];
+            Page *p=slot.load(std::memory_order_acquire);
+            if(p!=nullptr)
+                return p;
+            std::lock_guard<std::mutex> lock(lpage);
+            p=slot.load(std::memory_order_relaxed);
+            if(p==nullptr)
+            {
+                p=new Page();
+                if(initFun)
+                    for(auto &ii:p->items)
+                        initFun(ii);
+                slot.store(p,std::memory_order_release);
+                ++allocated;
+            }
+            return p;
+        }
+    public:
+        ConnectionTable()=default;
+        ConnectionTable(const ConnectionTable&)=delete;
+        ConnectionTable& operator=(const ConnectionTable&)=delete;
+        /**
+        * @brief 初始化连接表（会先清空原来的内容）
+        * @param maxFD fd的上限（不包含）
+        * @param initFun 新分配的页里每个元素都会先调用一次这个函数做初始化（默认为空）
+        */
+        void init(const unsigned long long &maxFD,std::function<void(T&)> initFun=nullptr)
+        {
+            clear();
+            this->maxFD=maxFD;
+            this->initFun=initFun;
+            pageNum=(maxFD+PAGE_SIZE-1)/PAGE_SIZE;
+            pages.reset(new std::atomic<Page*>[pageNum]);
+            for(int ii=0;ii<pageNum;ii++)
+                pages[ii].store(nullptr,std::memory_order_relaxed);
+        }
+        /**
+        * @brief 取得fd对应的元素，所在页不存在时分配这一页
+        * @note fd必须小于init时给的maxFD
+        */
+        T& operator[](const int &fd){return getPage(fd)->items[fd%PAGE_SIZE];}
+        /**
+        * @brief 查找fd对应的元素，不会分配新页
+        * @return 所在页还没有分配或者fd越界时返回nullptr
+        */
+        T* find(const int &fd)
+        {
+            if(fd<0||(unsigned long long)fd>=maxFD)
+                return nullptr;
+            Page *p=pages[fd/PAGE_SIZE].load(std::memory_order_acquire);
+            return p==nullptr?nullptr:&p->items[fd%PAGE_SIZE];
+        }
+        /**
+        * @brief 标记fd是不是活跃连接
+        * @param fd 套接字
+        * @param live true：加入活跃集合 false：移出活跃集合
+        */
+        void setLive(const int &fd,const bool &live)
+        {
+            Page *p=getPage(fd);
+            uint64_t bit=1ULL<<(fd%64);
+            std::atomic<uint64_t> &word=p->live[(fd%PAGE_SIZE)/64];
+            if(live)
+            {
+                if(!(word.fetch_or(bit)&bit))
+                {
+                    ++p->liveNum;
+                    ++liveCount;
+                }
+            }
+            else
+            {
+                if(word.fetch_and(~bit)&bit)
+                {
+                    --p->liveNum;
+                    --liveCount;
+                }
+            }
+        }
+        /**
+        * @brief 遍历所有活跃的fd
+        * @param fun 回调函数，参数为fd和对应的元素，回调里可以调用setLive(fd,false)
+        */
+        template<class Fn>
+        void forEachLive(Fn &&fun)
+        {
+            if(!pages)
+                return;
+            for(int ii=0;ii<pageNum;ii++)
+            {
+                Page *p=pages[ii].load(std::memory_order_acquire);
+                if(p==nullptr||p->liveNum.load(std::memory_order_relaxed)==0)
+                    continue;
+                for(int jj=0;jj<PAGE_SIZE/64;jj++)
+                {
+                    uint64_t word=p->live[jj].load(std::memory_order_acquire);
+                    while(word!=0)
+                    {
+                        int bit=__builtin_ctzll(word);
+                        word&=word-1;
+                        int fd=ii*PAGE_SIZE+jj*64+bit;
+                        fun(fd,p->items[fd%PAGE_SIZE]);
+                    }
+                }
+            }
+        }
+        /**
+        * @brief 返回活跃连接的数量
+        */
+        size_t getLiveCount(){return liveCount;}
+        /**
+        * @brief 返回已经分配的页数
+        */
+        size_t getPageCount(){return allocated;}
+        /**
+        * @brief 释放所有页
+        * @note 调用前要保证没有其他线程还在访问连接表
+        */
+        void clear()
+        {
+            for(int ii=0;ii<pageNum;ii++)
+            {
+                delete pages[ii].load(std::memory_order_relaxed);
+                pages[ii].store(nullptr,std::memory_order_relaxed);
+            }
+            allocated=0;
+            liveCount=0;
+        }
+        /**
+        * @brief 析构函数 释放所有页
+        */
+        ~ConnectionTable(){clear();}
+    };
+
+    /**
+    * @brief 工作现场完成任务后压入完成队列的数据结构
+    */
+    struct WorkerMessage
+    {
+        /**
+        * @brief 底层套接字
+        */
+        int fd;
+        /**
+        * @brief 返回值 -2:失败并且要求关闭连接 -1:失败但不需要关闭连接 1:成功
+        */
+        int ret;
+    };
+    /**
+    * @brief 握手线程池做完TLS握手后交回reactor的消息
+    */
+    struct HandshakeMessage
+    {
+        /**
+        * @brief 底层套接字
+        */
+        int fd;
+        /**
+        * @brief 连接对象的唯一编号 用来识别fd是否已经被复用
+        */
+        uint64_t connection_obj_fd;
+        /**
+        * @brief true：握手完成 false：握手失败，需要关闭连接
+        */
+        bool ok;
+    };
+    /**
+    * @brief 按排队时间卸载负载（见TcpServer::setLoadShedding）的统计 时间单位微秒
+    */
+    struct LoadShedStats
+    {
+        /**
+        * @brief 因为排队时间过长被直接拒绝的任务数
+        */
+        uint64_t shed=0;
+        /**
+        * @brief 统计了排队时间的任务数
+        */
+        uint64_t tasks=0;
+        /**
+        * @brief 平均排队时间
+        */
+        uint64_t delayAvg=0;
+        /**
+        * @brief 最长的一次排队时间
+        */
+        uint64_t delayMax=0;
+        /**
+        * @brief 最近一个开始执行的任务的排队时间
+        */
+        uint64_t delayLast=0;
+        /**
+        * @brief 当前已经入队还没开始执行的任务数
+        */
+        int queued=0;
+        /**
+        * @brief 当前是否处于卸载状态（新任务直接被拒绝）
+        */
+        bool dropping=false;
+    };
+    /**
+    * @brief 工作线程组（舱壁）的统计
+    */
+    struct WorkerGroupStats
+    {
+        /**
+        * @brief 线程组名
+        */
+        std::string name;
+        /**
+        * @brief 线程数
+        */
+        int threads=0;
+        /**
+        * @brief 线程的nice值
+        */
+        int nice=0;
+        /**
+        * @brief 排队和正在执行的任务数上限 0为不限制
+        */
+        int maxQueue=0;
+        /**
+        * @brief 当前排队和正在执行的任务数
+        */
+        int inflight=0;
+        /**
+        * @brief 交给这个线程组的任务数
+        */
+        uint64_t submitted=0;
+        /**
+        * @brief 因为达到上限被拒绝的任务数
+        */
+        uint64_t rejected=0;
+    };
+    /**
+    * @brief TLS握手线程池的统计
+    * @note 一次握手可能要分几轮（每收到一批握手数据交给线程池一次），时间按轮统计，单位微秒
+    */
+    struct HandshakeStats
+    {
+        /**
+        * @brief 交给线程池的轮数
+        */
+        uint64_t rounds=0;
+        /**
+        * @brief 因为并发握手达到上限被拒绝（关闭）的连接数
+        */
+        uint64_t rejected=0;
+        /**
+        * @brief 排队时间总和（从reactor提交到线程开始执行）
+        */
+        uint64_t queueTimeTotal=0;
+        /**
+        * @brief 最长的一次排队时间
+        */
+        uint64_t queueTimeMax=0;
+        /**
+        * @brief 线程池执行SSL_accept的时间总和
+        */
+        uint64_t busyTimeTotal=0;
+        /**
+        * @brief 当前排队和正在执行的握手数
+        */
+        int inflight=0;
+    };
+
+    /**
+    * @brief 基于io_uring的事件通知环（直接使用系统调用，不依赖liburing）
+    * @note 连接、定时器和门铃用multishot poll登记，一次登记持续产生事件，不需要每次重新注册；监听套接字用multishot accept，一个请求持续产出新连接。
+    * 提交队列有锁保护，acceptor和其他线程可以往环里增加或者取消登记；完成队列只由所属的reactor线程消费。
+    * @note 需要内核5.19以上（IORING_FEAT_EXT_ARG和multishot accept），init失败时调用者应回退到epoll
+    */
+    class IoUring
+    {
+    private:
+        int ringFD=-1;
+        void *sqPtr=nullptr;
+        size_t sqSize=0;
+        void *cqPtr=nullptr;
+        size_t cqSize=0;
+        io_uring_sqe *sqes=nullptr;
+        size_t sqesSize=0;
+        unsigned *sqHead;
+        unsigned *sqTail;
+        unsigned *sqMask;
+        unsigned *sqArray;
+        unsigned sqEntries;
+        unsigned *cqHead;
+        unsigned *cqTail;
+        unsigned *cqMask;
+        io_uring_cqe *cqes;
+        std::mutex lsq;
+        int listenFD=-1;
+        bool multishotAccept=true;
+        bool acceptStopped=false;
+        static constexpr uint64_t WRITE_TAG=1ULL<<61;
+        static constexpr uint64_t ACCEPT_TAG=1ULL<<62;
+        static constexpr uint64_t CANCEL_TAG=1ULL<<63;
+    private:
+        io_uring_sqe* getSQE();
+        bool submit();
+        bool prepPoll(const int &fd,const uint32_t &events,const uint32_t &tag=0);
+        bool prepAccept();
+    public:
+        /**
+        * @brief 登记时可以附带的标记的有效位
+        * @note 标记放在user_data的32到60位，超出的部分被截掉
+        */
+        static constexpr uint32_t TAG_MASK=(1U<<29)-1;
+        /**
+        * @brief 本次wait通过multishot accept收到的新连接
+        * @note 由reactor在wait返回后取走并清空
+        */
+        std::vector<int> acceptedFD;
+        /**
+        * @brief 创建io_uring
+        * @param entries 提交队列长度
+        * @param cqEntries 完成队列长度 multishot请求会持续产生完成事件，应当明显大于提交队列
+        * @return true：创建成功 false：内核不支持或者创建失败
+        */
+        bool init(const unsigned &entries=64,const unsigned &cqEntries=16384);
+        /**
+        * @brief 用multishot poll登记一个fd
+        * @param fd 要登记的fd
+        * @param events 关注的事件 取值和epoll的EPOLLIN/EPOLLRDHUP等一致
+        * @param tag 标记（默认为0） wait返回的事件里放在data.u64的高32位，用来区分复用同一个fd号的新旧连接
+        * @return true：登记成功 false：登记失败
+        */
+        bool addFD(const int &fd,const uint32_t &events,const uint32_t &tag=0);
+        /**
+        * @brief 用一次性poll关注一个fd的可写事件
+        * @note 可写时wait返回这个fd的EPOLLOUT事件，之后登记失效，还需要关注的话要重新调用
+        * @param tag 标记（默认为0） 和addFD一样
+        * @return true：登记成功 false：登记失败
+        */
+        bool addWriteWatch(const int &fd,const uint32_t &tag=0);
+        /**
+        * @brief 取消一个fd的登记（包括可写事件的登记）
+        * @note 必须在close这个fd之前调用，io_uring持有文件引用，只close不取消的话套接字不会真正关闭
+        * @param tag 登记时用的标记
+        * @return true：提交成功 false：提交失败
+        */
+        bool removeFD(const int &fd,const uint32_t &tag=0);
+        /**
+        * @brief 用multishot accept监听一个套接字
+        * @note 内核不支持multishot accept时自动改为poll这个套接字，此时wait会像epoll一样返回监听套接字的可读事件
+        * @return true：提交成功 false：提交失败
+        */
+        bool addAccept(const int &fd);
+        /**
+        * @brief 停止addAccept开始的accept
+        * @note 已经被内核accept的连接仍然会在之后的wait里放进acceptedFD
+        * @return true：提交成功 false：提交失败
+        */
+        bool removeAccept();
+        /**
+        * @brief 等待事件
+        * @param evs 存放事件的数组，格式和epoll_wait一样（data.fd和events） data.u64的高32位是登记时的标记
+        * @param maxevents evs的长度
+        * @param timeout 超时时间（毫秒）
+        * @return 返回的事件数量 超时返回0 出错返回-1
+        * @note 新连接不算在返回值内，放在acceptedFD里面
+        */
+        int wait(epoll_event *evs,const int &maxevents,const int &timeout);
+        /**
+        * @brief 销毁io_uring 所有登记随之取消
+        */
+        void close();
+        ~IoUring(){close();}
+    };
+
+    /**
+    * @brief 分层时间轮
+    * @note 4层，每层64个槽，第0层一个槽代表一个tick，第n层一个槽代表64^n个tick，最长可以直接表示64^4个tick，更长的定时会在到达最高层后重新放置。
+    * @note 重新设置一个已经存在的定时（set）是O(1)的：到期时间变晚时只修改记录，不移动节点，等节点所在的槽到期时再按新的到期时间放到正确的位置；到期时间变早时把节点摘下来重新放置。
+    * @note 每次advance只处理走过的槽，到期回调只会针对真正到期的定时，不需要遍历所有定时。
+    * @note 内部有互斥锁，可以在多个线程里调用。
+    */
+    class TimingWheel
+    {
+    public:
+        /**
+        * @brief 每层的槽数
+        */
+        static constexpr int SLOT_NUM=64;
+        /**
+        * @brief 层数
+        */
+        static constexpr int LEVEL_NUM=4;
+        /**
+        * @brief 到期的定时
+        */
+        struct Expired
+        {
+            /**
+            * @brief 定时的键
+            */
+            uint64_t key;
+            /**
+            * @brief set时传入的附加标记
+            */
+            uint64_t tag;
+        };
+    private:
+        struct Node
+        {
+            uint64_t expire;
+            uint64_t tag;
+            int level;
+            int slot;
+            std::list<uint64_t>::iterator it;
+        };
+        static constexpr int SLOT_BITS=6;
+        std::list<uint64_t> slots[LEVEL_NUM][SLOT_NUM];
+        std::unordered_map<uint64_t,Node> nodes;
+        uint64_t current=0;
+        std::mutex lw;
+    private:
+        void place(const uint64_t &key,Node &node);
+        void cascade(const int &level,const int &slot);
+    public:
+        /**
+        * @brief 设置或者重新设置一个定时
+        * @param key 定时的键 同一个键只会存在一个定时
+        * @param ticks 从现在开始多少个tick后到期（0也会在下一个tick到期）
+        * @param tag 附加标记 到期时原样返回，可以用来识别fd是否已经被复用（默认为0）
+        */
+        void set(const uint64_t &key,const uint64_t &ticks,const uint64_t &tag=0);
+        /**
+        * @brief 取消一个定时
+        * @return true：取消成功 false：没有这个定时
+        */
+        bool remove(const uint64_t &key);
+        /**
+        * @brief 时间轮前进若干个tick
+        * @param ticks 前进的tick数
+        * @param expired 到期的定时追加到这里，到期的定时会被移除，需要的话在回调里重新set
+        */
+        void advance(const uint64_t &ticks,std::vector<Expired> &expired);
+        /**
+        * @brief 返回当前的定时数量
+        */
+        size_t size();
+    };
+
+    /**
+    * @brief 按排队时间做准入控制（CoDel）的状态
+    * @note 每个任务开始执行时用它从入队到开始执行的时间（排队时间）更新：排队时间连续一个interval都高于target时进入卸载状态，新任务不再排队直接被拒绝；
+    * 看到一次低于target的排队时间，或者积压的任务全部开始执行之后退出卸载状态
+    */
+    struct QueueDelayControl
+    {
+        std::atomic<int> queued{0};//已经入队还没开始执行的任务数
+        std::atomic<int64_t> aboveSince{0};//排队时间开始高于target的时刻（steady_clock纳秒） 0表示没有高于
+        std::atomic<bool> dropping{false};
+        std::atomic<uint64_t> shed{0};
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint64_t> delayTotal{0};//微秒
+        std::atomic<uint64_t> delayMax{0};
+        std::atomic<uint64_t> delayLast{0};
+    };
+
+    /**
+    * @brief 一个工作线程组（舱壁）
+    * @note 线程组有自己的线程和排队上限，分配到这个组的路由只占用这个组的线程，慢的路由排满了也不会拖住其他路由
+    */
+    struct WorkerGroup
+    {
+        std::string name;
+        int threads;
+        int maxQueue;
+        int nice;
+        std::unique_ptr<system::WorkerPool> pool;
+        std::atomic<int> inflight{0};
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> rejected{0};
+        QueueDelayControl delay;
+    };
+
+    /**
+    * @brief 一个I/O事件循环(reactor)的运行信息
+    * @note 每个reactor拥有自己的epoll句柄、worker完成队列和门铃eventfd，只处理分配给它的连接
+    */
+    struct ReactorInf
+    {
+        /**
+        * @brief reactor编号
+        */
+        int id;
+        /**
+        * @brief 这个reactor的epoll句柄
+        */
+        int epollFD=-1;
+        /**
+        * @brief worker完成任务后通知这个reactor的eventfd
+        */
+        int workerEventFD=-1;
+        /**
+        * @brief 使用io_uring引擎时这个reactor的事件环 使用epoll时为nullptr
+        */
+        std::unique_ptr<IoUring> ring;
+        /**
+        * @brief 这个reactor的时间轮 一个tick为1秒 负责僵尸连接检测和websocket心跳
+        */
+        TimingWheel wheel;
+        /**
+        * @brief 当前分配到这个reactor的连接数
+        */
+        std::atomic<uint64_t> connections{0};
+        /**
+        * @brief Worker → Reactor 的完成队列
+        */
+        system::MPSCQueue<WorkerMessage> finishQueue;
+        /**
+        * @brief 握手线程池 → Reactor 的完成队列 和finishQueue共用门铃
+        */
+        system::MPSCQueue<HandshakeMessage> handshakeQueue;
+        ReactorInf(const int &id,const size_t &finishQueue_cap,const size_t &handshakeQueue_cap=2):id(id),finishQueue(finishQueue_cap),handshakeQueue(handshakeQueue_cap){}
+    };
+    
+    
+    /**
+    * @brief TLS会话票据（session ticket）的密钥环
+    * @note 新票据用当前密钥加密；轮换后上一把密钥再保留一个周期，只用来解密旧票据（并换发新票据），所以一张票据至少能用一个轮换周期
+    * @note 到期后在下一次签发票据时自动轮换；密钥只保存在内存里，重启进程后旧票据失效，客户端退回完整握手
+    */
+    class TicketKeyRing
+    {
+    public:
+        /**
+        * @brief 一把票据密钥
+        */
+        struct Key
+        {
+            unsigned char name[16];
+            unsigned char aesKey[32];
+            unsigned char hmacKey[32];
+            std::chrono::steady_clock::time_point created;
+        };
+    private:
+        std::mutex lk;
+        Key keys[2];//0是当前密钥 1是上一把
+        int count=0;
+        int interval=3600;
+        bool generate(Key &key);
+    public:
+        /**
+        * @brief 设置轮换周期
+        * @param secs 轮换周期（秒）
+        */
+        void setInterval(const int &secs){std::lock_guard<std::mutex> lock(lk);interval=secs;}
+        /**
+        * @brief 取出加密新票据用的当前密钥 到期时先轮换
+        * @param key 取出的密钥
+        * @return true：成功 false：生成随机密钥失败
+        */
+        bool current(Key &key);
+        /**
+        * @brief 按票据里的密钥名找解密用的密钥
+        * @param name 票据里的16字节密钥名
+        * @param key 找到的密钥
+        * @return 1：当前密钥 2：上一把密钥（需要换发新票据） 0：找不到（票据作废，走完整握手）
+        */
+        int find(const unsigned char *name,Key &key);
+        /**
+        * @brief 马上轮换一次（比如怀疑密钥泄露时）
+        */
+        void rotate();
+    };
+    
+    /**
+    * @brief Tcp服务端类
+    * @note 默认底层实现是epoll边缘触发+套接字非阻塞模式
+    */
+    class TcpServer 
+    {
+    protected:
+        std::vector<std::unique_ptr<ReactorInf>> reactorInf;
+        size_t finishQueue_cap;
+        int reactorNum=1;
+        static constexpr int EVENT_BATCH=4096;//每个reactor每次epoll_wait最多取回的事件数
+        EventEngine engine;
+        stt::system::WorkerPool *workpool; 
+        stt::system::WorkerPool *handshakePool=nullptr;
+        int handshakeThreads=0;
+        int handshakeLimit=1024;
+        ConnectionTable<std::atomic<int>> handshakeState;//0:空闲 1:在握手线程池里 2:在线程池里并且又来了新数据
+        std::atomic<int> handshakeInflight{0};
+        std::atomic<uint64_t> handshakeRounds{0};
+        std::atomic<uint64_t> handshakeRejected{0};
+        std::atomic<uint64_t> handshakeQueueTime{0};
+        std::atomic<uint64_t> handshakeQueueMax{0};
+        std::atomic<uint64_t> handshakeBusyTime{0};
+        std::string hotRestartPath;
+        int hotRestartDrain=30;
+        std::function<void()> drainedFun;
+        std::atomic<bool> accepting{true};
+        std::atomic<bool> handedOver{false};
+        bool noDelay=true;
+        int deferAcceptSecs=0;
+        int fastOpenQueue=0;
+        std::vector<int> reactorCPUs;
+        std::vector<int> workerCPUs;
+        bool taskLanes=false;
+        std::unordered_map<std::string,std::unique_ptr<WorkerGroup>> workerGroups;
+        int shedTargetUs=0;
+        int shedIntervalUs=100000;
+        QueueDelayControl queueDelay;//默认线程池的排队时间
+        std::unordered_map<std::string,WorkerGroup*> routeGroups;//路由key到线程组
+        unsigned long buffer_size;
+        unsigned long long  maxFD;
+        security::ConnectionLimiter connectionLimiter;
+        //std::unordered_map<int,TcpFDInf> clientfd;
+        //std::mutex lc1;
+        ConnectionTable<TcpFDInf> clientfd;
+        int flag1=true;
+        //std::queue<QueueFD> *fdQueue;
+        //std::mutex *lq1;
+        //std::condition_variable cv1;
+        //std::condition_variable *cv;
+        //int consumerNum;
+        //std::mutex lco1;
+        bool unblock;
+        SSL_CTX *ctx=nullptr;
+        bool TLS=false;
+        bool ktls=false;
+        TicketKeyRing ticketKeys;
+        std::atomic<uint64_t> fullHandshakes{0};
+        std::atomic<uint64_t> resumedHandshakes{0};
+        //std::unordered_map<int,SSL*> tlsfd;
+        //std::mutex ltl1;
+        bool security_open;
+        //bool flag_detect;
+        //bool flag_detect_status;
+        int serverType; // 1 tcp 2 http 3 websocket
+        int connectionSecs;
+        int connectionTimes;
+        int requestSecs;
+        int requestTimes;
+        int checkFrequency;
+        uint64_t connection_obj_fd;
+        static constexpr int TIMER_IDLE=0;//僵尸连接检测定时
+        static constexpr int TIMER_HEARTBEAT=1;//websocket心跳定时
+        void armTimer(const int &fd,const int &kind,const int &secs);//在fd所属reactor的时间轮上设置(或者推迟)一个secs秒后到期的定时
+        bool dispatchTask(std::unordered_map<std::string,std::any> &ctx,const uint64_t &connection_obj_fd,std::function<void()> &&task);//按路由把任务交给线程组或默认线程池 线程组排满时返回false
+        void recordQueueDelay(QueueDelayControl &qc,const std::chrono::steady_clock::time_point &queuedAt);
+    private:
+        std::function<void(const int &fd)> closeFun=[](const int &fd)->void
+        {
+
+        };
+        std::function<void(TcpFDHandler &k,TcpInformation &inf)> securitySendBackFun=[](TcpFDHandler &k,TcpInformation &inf)->void
+        {};
+        std::function<bool(TcpFDHandler &k,TcpInformation &inf)> globalSolveFun=[](TcpFDHandler &k,TcpInformation &inf)->bool
+        {return true;};
+        std::unordered_map<std::string,std::vector<std::function<int(TcpFDHandler &k,TcpInformation &inf)>>> solveFun;
+        std::function<int(TcpFDHandler &k,TcpInformation &inf)> parseKey=[](TcpFDHandler &k,TcpInformation &inf)->int
+        {inf.ctx["key"]=inf.data;return 1;};
+        std::function<void(const int &fd)> writableFun;
+        size_t outHighWater=4*1024*1024;
+        size_t outLowWater=1024*1024;
+        int fd=-1;
+        int port=-1;
+        int flag=false;
+        std::atomic<int> loopNum{0};
+        uint64_t nextReactor=0;
+    private:
+        void epolll(const int &id);
+        void acceptLoop();
+        void acceptConnection();
+        void addConnection(const int &cfd,const struct sockaddr_storage *addr=nullptr,const socklen_t &addrLen=0);
+        void watchFD(ReactorInf &r,const int &fd,const uint32_t &events,const uint32_t &tag=0);
+        void watchWrite(const int &reactor,const int &fd,const bool &on,const uint32_t &tag);
+        static uint32_t eventTag(const uint64_t &connection_obj_fd){return (uint32_t)(connection_obj_fd&IoUring::TAG_MASK);}
+        void forceClose(const int &fd);
+        bool idleCheckOn();
+        void handshakeTask(const int &reactor,const int &fd,const uint64_t &connection_obj_fd,const std::chrono::steady_clock::time_point &queued);
+        void onTLSEstablished(const int &fd);
+        int inheritListenFD(const int &port);
+        int openControlSocket();
+        void hotRestartLoop(const int &controlFD);
+        void unwatchListen(IoUring *ring,const int &epollFD);
+        //virtual void consumer(const int &threadID);
+        virtual void handler_netevent(const int &fd);
+        virtual void handler_workerevent(const int &fd,const int &ret);
+        virtual void handleHeartbeat(const int &id,const int &fd)=0;
+    public:
+        /**
+        * @brief 把一个任务放入工作线程池由工作线程完成
+        * @note 应当把速度慢、会阻塞的io任务放入工作线程池
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param fun 放入工作线程池的可执行对象
+        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       TcpFDInf &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 1:处理成功
+        * @param k 和客户端连接的套接字的操作对象的引用
+        * @param inf 客户端信息的引用，保存数据，处理进度，状态机信息等
+        * @return true：投递成功 false：投递失败
+        */
+        void putTask(const std::function<int(TcpFDHandler &k,TcpInformation &inf)> &fun,TcpFDHandler &k,TcpInformation &inf);
+        /**
+        * @brief 构造函数，默认是允许最大1000000个连接，每个连接接收缓冲区最大为256kb，启用安全模块。
+        * @note 打开安全模块会对性能有影响
+        * @param maxFD 服务对象的最大接受连接数 默认为1000000
+        * @param buffer_size 同一个连接允许传输的最大数据量（单位为kb） 默认为256kb
+        * @param finishQueue_cap Worker 完成队列（Worker → Reactor）的容量，必须为 2 的幂。
+        //
+        // 该队列用于承载 worker 线程已完成任务的结果，等待 reactor 线程消费。
+        // 这是主数据通路的一部分，对系统吞吐和延迟极其敏感。
+        //
+        // 选型原则：
+        //   finishQueue_cap >= 峰值完成速率(QPS) × reactor 最坏暂停时间
+        //
+        // 建议值（经验）：
+        //   - 低负载/轻业务： 8192  (~8k)
+        //   - 常规高并发：   65536 (~64k)   【默认】
+        //   - 极端突发流量： 131072(~128k)
+        //
+        // 队列满时 请求将会丢弃，框架不会阻塞生产者。
+        * @param security_open true:开启安全模块 false：关闭安全模块 （默认为开启）
+        * @param connectionNumLimit 同一个ip连接数目的上限（默认20）
+        * @param connectionSecs   连接速率统计窗口长度（单位：秒）（默认1秒）
+        * @param connectionTimes  在 connectionSecs 秒内允许的最大连接次数 （默认6次）
+        * @param requestSecs 请求速率统计窗口长度（单位：秒）（默认1秒）
+        * @param requestTimes 在秒requestSecs内允许的最大请求数量（默认40次）
+        * @param checkFrequency 检查僵尸连接的频率（单位秒钟）  -1为不做检查 （默认为60秒） 每个连接在reactor的时间轮上按自己的到期时间检查（精度1秒），正数只表示打开检查
+        * @param connectionTimeout 连接多少秒内没有任何反应就视为僵尸连接 （单位为秒） -1为无限制 （默认60秒）
+        * @param engine 事件引擎 EventEngine::EPOLL或者EventEngine::IO_URING（默认epoll） 内核不支持io_uring时startListen会回退到epoll
+        */
+        TcpServer(const unsigned long long &maxFD=1000000,const int &buffer_size=256,const size_t &finishQueue_cap=65536,const bool &security_open=true,
+        const int &connectionNumLimit=20,const int &connectionSecs=1,const int &connectionTimes=6,const int &requestSecs=1,const int &requestTimes=40,
+        const int &checkFrequency=60,const int &connectionTimeout=60,const EventEngine &engine=EventEngine::EPOLL):maxFD(maxFD),buffer_size(buffer_size*1024),finishQueue_cap(finishQueue_cap),security_open(security_open),connectionSecs(connectionSecs),connectionTimes(connectionTimes),requestSecs(requestSecs),requestTimes(requestTimes),
+        connectionLimiter(connectionNumLimit,connectionTimeout),checkFrequency(checkFrequency),engine(engine){serverType=1;}
+        /**
+        * @brief 打开Tcp服务器监听程序
+        * @param port 监听的端口
+        * @param threads 消费者线程的数量 （默认为8）
+        * @param reactors I/O事件循环(reactor)的数量 （默认为1）
+        * - 1：单个epoll线程同时负责accept和所有连接的读写（原来的模式）
+        * - 大于1：一个acceptor线程只负责accept，按轮询把新连接分配给N个reactor线程，每个reactor有自己的epoll、连接分片和完成队列
+        * @return true：打开监听程序成功 false：打开监听程序失败
+        */
+        bool startListen(const int &port,const int &threads=8,const int &reactors=1);
+        /**
+        * @brief 启用 TLS 加密并配置服务器端证书与密钥
+        * 
+        * 本函数用于初始化 OpenSSL，并为 TCP 服务器启用 TLS（SSL/TLSv1 协议族）支持。
+        * 它加载服务器端证书、私钥和可选的 CA 根证书，用于实现对等验证。
+        * 
+        * 若已启用 TLS，将自动重建（重载）上下文。
+        * 
+        * @param cacert 服务器端证书链文件路径（通常为 PEM 格式，包括中间证书）
+        * @param key 私钥文件路径（与证书匹配的 PEM 格式密钥）
+        * @param passwd 私钥文件的密码（若密钥加密，可为空字符串）
+        * @param ca CA 根证书路径，用于验证客户端证书（PEM 格式）
+        * 
+        * @note 使用的协议方法为 `SSLv23_method()`，实际上支持 SSLv3/TLSv1/TLSv1.1/TLSv1.2 及更高版本（具体取决于 OpenSSL 版本与配置）
+        * 
+        * @note 校验证书策略使用 `SSL_VERIFY_FAIL_IF_NO_PEER_CERT`，即：
+        * - 若客户端未提供证书，则握手失败（更安全，推荐）
+        * - 若证书无效或校验失败，也会终止握手
+        * 
+        * @return true 启用 TLS 成功，服务器已进入加密状态
+        * @return false 启用失败（日志将输出具体错误）
+        * 
+        * @warning 启用 TLS 后，所有接入连接必须遵循 TLS 握手流程，否则通信失败
+        * 
+        * @note 会话复用：服务端会话缓存（TLS1.2的session id）容量有上限并且按sessionTimeout过期；会话票据（TLS1.3和TLS1.2的ticket）用TicketKeyRing里定期轮换的密钥加密，服务端不用保存状态；
+        * 重连的客户端带上票据或者session id就只需要简化握手，省掉证书签名和密钥交换的CPU。握手次数可以用getFullHandshakes和getResumedHandshakes查看
+        * @note 票据密钥在重新调用setTLS（热更新证书）时保留，已经签发的票据继续有效
+        * 
+        * @param sessionCacheSize 服务端会话缓存最多保存的会话数 默认20480 为0时关闭会话缓存
+        * @param sessionTimeout 会话（缓存和票据）的有效期（秒） 默认300
+        * @param ticketKeyInterval 票据密钥的轮换周期（秒） 默认3600 为0时不签发票据，只用会话缓存复用
+        * 
+        * @see redrawTLS() 若已有 TLS 上下文存在，会先释放并重建（可用于热更新证书）
+        */
+        bool setTLS(const char *cert,const char *key,const char *passwd,const char *ca,const long &sessionCacheSize=20480,const long &sessionTimeout=300,const int &ticketKeyInterval=3600);
+        /**
+        * @brief 获取完整握手的次数
+        */
+        uint64_t getFullHandshakes(){return fullHandshakes;}
+        /**
+        * @brief 获取复用会话（简化握手）的次数
+        */
+        uint64_t getResumedHandshakes(){return resumedHandshakes;}
+        /**
+        * @brief 马上轮换会话票据密钥
+        * @note 上一把密钥还会保留一个周期，已经签发的票据仍然可以复用
+        */
+        void rotateTicketKey(){ticketKeys.rotate();}
+        /**
+        * @brief 把TLS握手交给单独的线程池
+        * @note 默认握手（SSL_accept里的RSA/ECDHE运算）在reactor线程里做，大量客户端同时重连时会拖慢已建立连接的收发。开启后处于握手状态的连接每收到一批握手数据，就交给握手线程池执行SSL_accept，
+        * 握手完成后交回所属的reactor继续处理，reactor只负责收发
+        * @note 排队和正在执行的握手数达到maxPending时，新的握手直接关闭连接（客户端会重试），防止握手积压拖垮内存和延迟；统计见getHandshakeStats
+        * @note 必须在startListen之前调用
+        * @param threads 握手线程数 为0时关闭（在reactor里握手）
+        * @param maxPending 同时排队和执行的握手数上限 默认1024
+        */
+        void setHandshakePool(const int &threads,const int &maxPending=1024){handshakeThreads=threads;handshakeLimit=maxPending>0?maxPending:1;}
+        /**
+        * @brief 获取握手线程池的统计
+        */
+        HandshakeStats getHandshakeStats();
+        /**
+        * @brief 开启热重启（监听套接字交接）
+        * @note 开启后startListen会先连接path这个Unix域套接字：如果旧进程在监听，就通过SCM_RIGHTS拿到旧进程的监听套接字直接使用，不再重新bind，
+        * 连接在交接期间留在同一个accept队列里，不会丢失；没有旧进程时正常bind。随后自己在path上监听，等待下一个新进程来交接
+        * @note 旧进程交出监听套接字后停止accept，已有的连接继续处理，直到全部关闭或者超过drainSecs秒，然后调用fun（默认给自己发送信号15退出）
+        * @note 新进程一般由旧进程用Process::startProcess启动，监听套接字和连接套接字都带有FD_CLOEXEC，不会被新进程继承
+        * @note 必须在startListen之前调用，同一个进程里的每个服务器要用不同的path
+        * @param path Unix域套接字的路径 为空时关闭
+        * @param drainSecs 交出监听套接字后等待已有连接关闭的最长时间（秒） 默认30
+        * @param fun 旧进程处理完已有连接后执行的函数 默认为nullptr（发送信号15）
+        */
+        void setHotRestart(const std::string &path,const int &drainSecs=30,const std::function<void()> &fun=nullptr){hotRestartPath=path;hotRestartDrain=drainSecs;drainedFun=fun;}
+        /**
+        * @brief 监听套接字是否已经交给了新进程
+        * @return true：已经交出，正在处理剩下的连接 false：没有
+        */
+        bool isHandedOver(){return handedOver;}
+        /**
+        * @brief 设置监听套接字的TCP_NODELAY（默认开启）
+        * @note 设置在监听套接字上，accept出来的连接直接继承，不用每个连接多一次setsockopt；
+        * 响应已经用writev和MSG_MORE合并发送，关掉Nagle算法不会多出小包，反而避免了和客户端延迟确认叠加的几十毫秒等待
+        * @note 必须在startListen之前调用
+        * @param on true：开启 false：关闭
+        */
+        void setNoDelay(const bool &on=true){noDelay=on;}
+        /**
+        * @brief 设置TCP_DEFER_ACCEPT
+        * @note 开启后内核要等客户端发来第一批数据才把连接交给accept，只建立连接不发数据的客户端不会占用连接表和reactor，
+        * 短连接的第一次读一定有数据，省掉一次空的可读事件；只适合客户端先发数据的协议（HTTP、TLS、WebSocket）
+        * @note 必须在startListen之前调用
+        * @param secs 最多等待的秒数 超时后内核仍会交给accept 为0时关闭（默认）
+        */
+        void setDeferAccept(const int &secs){deferAcceptSecs=secs>0?secs:0;}
+        /**
+        * @brief 开启服务端TCP Fast Open
+        * @note 带着有效cookie重连的客户端可以在SYN里直接发送请求，省掉一个往返；需要系统开启net.ipv4.tcp_fastopen的服务端位（值包含2）
+        * @note 必须在startListen之前调用
+        * @param queueLen 还没完成三次握手的TFO请求队列长度 为0时关闭（默认）
+        */
+        void setFastOpen(const int &queueLen){fastOpenQueue=queueLen>0?queueLen:0;}
+        /**
+        * @brief 设置reactor和工作线程绑定的CPU
+        * @note 第ii个reactor绑定到reactorCPUs[ii%size]这一个CPU上，多reactor模式下的acceptor线程绑定到整个reactorCPUs集合；
+        * 第ii个工作线程（包括握手线程池）绑定到workerCPUs[ii%size]
+        * @note 每个reactor的完成队列和io_uring事件环在它绑定的CPU上创建，接收缓冲区从当前线程所在NUMA节点的池里拿（见RecvBufferPool），
+        * 连接的内存都落在服务它的reactor所在的节点上，不会跨节点访问
+        * @note startListen时会把实际的布局（每个线程绑定的CPU和所在的NUMA节点）写入日志
+        * @note 必须在startListen之前调用
+        * @param reactorCPUs reactor绑定的CPU编号 为空时不绑定（默认）
+        * @param workerCPUs 工作线程绑定的CPU编号 为空时不绑定（默认）
+        */
+        void setAffinity(const std::vector<int> &reactorCPUs,const std::vector<int> &workerCPUs={}){this->reactorCPUs=reactorCPUs;this->workerCPUs=workerCPUs;}
+        /**
+        * @brief 让同一个连接的putTask任务固定在一个工作线程上按顺序执行
+        * @note 开启后putTask按连接的connection_obj_fd选择工作线程的有序通道（见WorkerPool::submitTo）：同一个连接的任务只在这一个线程上按提交顺序串行执行，
+        * 不同连接的任务仍然并行；连接的状态始终只被同一个线程访问，处理函数里不用再为每个连接的状态加锁，缓存也更热
+        * @note 通道里的任务不会被其他线程窃取，某个连接的长任务会推迟同一通道里其他连接的任务；任务耗时差别很大时保持关闭（默认），由工作线程之间互相窃取来均衡
+        * @note 必须在startListen之前调用
+        * @param on true：开启 false：关闭（默认）
+        */
+        void setTaskLanes(const bool &on=true){taskLanes=on;}
+        /**
+        * @brief 创建一个工作线程组（舱壁）
+        * @note 线程组有自己的线程和排队上限，用setRouteGroup把路由分配进来；分配到组里的路由的putTask任务只在这个组的线程上执行，
+        * 其他路由仍然使用默认的工作线程池。慢的路由（比如生成报表）排满了自己的组也不会推迟/ping、认证之类的轻量请求
+        * @note 排队和正在执行的任务数达到maxQueue时新任务直接被拒绝：HttpServer回复503 Service Unavailable，TcpServer和WebSocketServer跳过这条消息，都不关闭连接；统计见getWorkerGroupStats
+        * @note 组之间的调度交给内核：nice值大的组在CPU紧张时按权重少分时间（每差1约1.25倍），nice为19时基本只在其他线程空闲时运行。负的nice需要CAP_SYS_NICE权限
+        * @note 必须在startListen之前调用 绑定的CPU和默认线程池一样（见setAffinity），setTaskLanes对组里的任务同样生效
+        * @param name 线程组名 同名时覆盖之前的设置
+        * @param threads 线程数
+        * @param maxQueue 排队和正在执行的任务数上限 为0时不限制（默认）
+        * @param nice 线程的nice值 默认0
+        * @return true：成功 false：参数不合法或者已经在监听
+        */
+        bool setWorkerGroup(const std::string &name,const int &threads,const int &maxQueue=0,const int &nice=0);
+        /**
+        * @brief 把一个路由分配给工作线程组
+        * @note key就是setFunction用的key（HttpServer默认是请求路径，WebSocketServer默认是消息内容，可以用setGetKeyFunction修改）
+        * @note 必须在startListen之前调用
+        * @param key 路由的key
+        * @param group setWorkerGroup创建的线程组名 为空时取消分配，回到默认线程池
+        * @return true：成功 false：线程组不存在或者已经在监听
+        */
+        bool setRouteGroup(const std::string &key,const std::string &group);
+        /**
+        * @brief 获取每个工作线程组的统计
+        */
+        std::vector<WorkerGroupStats> getWorkerGroupStats();
+        /**
+        * @brief 开启按排队时间卸载负载（CoDel）
+        * @note putTask的任务从入队到开始执行的时间（排队时间）连续intervalMs毫秒都高于targetMs时，新的putTask任务不再排队：
+        * HttpServer直接回复（设置了setSecuritySendBackFun就调用它，否则回复503 Service Unavailable），TcpServer和WebSocketServer调用securitySendBackFun后跳过这条消息；
+        * 都不关闭连接。出现一次低于targetMs的排队时间，或者积压的任务全部开始执行之后恢复排队。这样过载时不会为已经超时离开的客户端做无用功
+        * @note 默认线程池和每个工作线程组（见setWorkerGroup）分别统计、分别卸载；统计见getLoadShedStats
+        * @note 必须在startListen之前调用
+        * @param targetMs 可以接受的排队时间（毫秒） 为0时关闭（默认）
+        * @param intervalMs 排队时间要持续高于targetMs多久才开始卸载（毫秒） 默认100
+        */
+        void setLoadShedding(const int &targetMs,const int &intervalMs=100){shedTargetUs=targetMs>0?targetMs*1000:0;shedIntervalUs=intervalMs>0?intervalMs*1000:100000;}
+        /**
+        * @brief 获取按排队时间卸载负载的统计
+        * @param group 工作线程组名 为空时返回默认线程池的统计（默认）
+        */
+        LoadShedStats getLoadShedStats(const std::string &group="");
+        /**
+        * @brief 撤销TLS加密，ca证书等
+        */
+        void redrawTLS();
+        /**
+        * @brief 开启或关闭内核TLS（kTLS）卸载
+        * @note 开启后给SSL_CTX加上SSL_OP_ENABLE_KTLS，握手完成后如果内核和加密套件支持，对称加密交给内核完成：
+        * - 发送：响应直接用sendmsg/sendfile写入socket（静态文件通过SSL_sendfile零拷贝），不再在用户态加密和拷贝
+        * - 接收：仍然通过SSL_read读取，OpenSSL内部直接从内核拿明文，非应用数据的记录（告警、密钥更新）也能正确处理
+        * @note 内核没有加载tls模块或者套件不支持时自动退回用户态加密，行为和不开启一样；是否生效会写入日志
+        * @note 可以在setTLS之前或之后调用，只影响之后新建立的连接
+        * @param on true：开启（默认） false：关闭
+        */
+        void setKTLS(const bool &on=true);
+        /**
+        * @brief 设置违反信息安全策略时候的返回函数
+        * @note 违反信息安全策略时候的返回函数,调用完就关闭连接
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       TcpInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：true：处理成功 false：处理失败 会关闭连接
+        */
+        void setSecuritySendBackFun(std::function<void(TcpFDHandler &k,TcpInformation &inf)> fc){this->securitySendBackFun=fc;}
+        /**
+        * @brief 设置全局备用函数
+        * @note 找不到对应回调函数的时候会调用全局备用函数
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       TcpInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：true：处理成功 false：处理失败 会关闭连接
+        */
+        void setGlobalSolveFunction(std::function<bool(TcpFDHandler &k,TcpInformation &inf)> fc){this->globalSolveFun=fc;}
+        /**
+        * @brief 设置key对应的收到客户端消息后的回调函数
+        * @note 可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       TcpFDInf &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        */
+        void setFunction(const std::string &key,std::function<int(TcpFDHandler &k,TcpInformation &inf)> fc)
+        {
+            auto [it, inserted] = solveFun.try_emplace(key);
+            it->second.push_back(std::move(fc));
+        }
+        /**
+        * @brief 设置解析出key的回调函数
+        * @note 根据传入的参数把key存入TcpInformation信息中的ctx哈希表。框架会根据key的值找到你注册的处理函数。
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param parseKeyFun 解析key的回调函数
+        * -参数：TcpFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       TcpFDInf &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        */
+        void setGetKeyFunction(std::function<int(TcpFDHandler &k,TcpInformation &inf)> parseKeyFun){this->parseKey=parseKeyFun;}
+        /** 
+        * @brief 停止监听
+        * @warning 仅停止监听(但是套接字也已经无法接收了，它依赖于监听和消费者，所以这个函数没什么意义)
+        * @return true:停止成功  false：停止失败
+        */
+        bool stopListen();
+        /**
+        * @brief 关闭监听和所有已连接的套接字
+        * @note 关闭监听和所有已经连接的套接字，已经注册的回调函数和tls不会删除和redraw
+        * @note 会阻塞等待直到全部关闭完成
+        * @return true：关闭成功 false：关闭失败
+        */
+        bool close();
+        /**
+        * @brief 关闭某个套接字的连接
+        * @note 连接的输出队列里还有没发完的数据时会先等reactor把数据发完再关闭（再次调用或者连接出错则立即关闭）
+        * @param fd 需要关闭的套接字
+        * @return true：关闭成功 false：关闭失败
+        */
+        virtual bool close(const int &fd);
+        /**
+         * @brief 设置“连接速率限流”所使用的策略。
+         *
+         * @param type 策略类型，见 @ref RateLimitType 说明。
+         * @note 不调用本函数时，默认策略为 @ref RateLimitType::Cooldown 。
+         */
+        void setConnectStrategy(const stt::security::RateLimitType &type){this->connectionLimiter.setConnectStrategy(type);}
+        /**
+         * @brief 设置“IP 级请求限流”所使用的策略。
+         *
+         * @param type 策略类型，见 @ref RateLimitType 说明。
+         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
+         */
+        void setRequestStrategy(const stt::security::RateLimitType &type){this->connectionLimiter.setRequestStrategy(type);}
+        /**
+         * @brief 设置“path 级请求限流”所使用的策略。
+         * 
+         * @param type 策略类型，见 @ref RateLimitType 说明。
+         * @note 不调用本函数时，默认策略为 @ref RateLimitType::SlidingWindow 。
+         * @note 这个path和parseKeyFun解析出来的key是一个东西
+         */
+        void setPathStrategy(const stt::security::RateLimitType &type){this->connectionLimiter.setPathStrategy(type);}
+        /**
+         * @brief 设置某个路径的额外限流规则（path 级）。
+         *
+         * @note 这个path和parseKeyFun解析出来的key是一个东西
+         * @param path 需要额外限流的路径，例如 "/login"、"/register"。
+         * @param times 在 secs 秒内允许的最大请求次数。
+         * @param secs 统计窗口长度（秒）。
+         *
+         * @note setPathLimit 配置的是 @b 额外规则：
+         * - allowRequest 调用时传入的 (times, secs) 仍然会作为 IP 级规则先执行；
+         * - 若 path 命中此配置，则再执行 path 级规则；
+         * - 两者为 AND 关系：任何一层失败即拒绝。
+         */
+        void setPathLimit(const std::string &path, const int &times, const int &secs){this->connectionLimiter.setPathLimit(path,times,secs);}
+        /**
+        * @brief 设置关闭tcp连接之后调用的函数
+        */
+        void setCloseFun(std::function<void(const int &fd)> closeFun){this->closeFun=closeFun;}
+    public:
+        /**
+        * @brief 返回对象的监听状态
+        * @return true:正在监听  false：没有在监听
+        */
+        bool isListen(){return flag;}
+        /**
+        * @brief 返回I/O事件循环(reactor)的数量
+        */
+        int getReactorNum(){return reactorNum;}
+        /**
+        * @brief 返回实际使用的事件引擎
+        * @note 构造时选择了io_uring但内核不支持的话，startListen之后这里返回EventEngine::EPOLL
+        */
+        EventEngine getEventEngine(){return engine;}
+        /**
+        * @brief 查询和服务端的连接，传入套接字，返回加密的SSL句柄
+        * @return 返回加密的SSL指针； 如果不存在此fd或者没有加密 返回nullptr
+        */
+        SSL* getSSL(const int &fd);
+        /**
+        * @brief 查询和服务端的连接，传入套接字，返回这个连接的输出队列
+        * @return 返回输出队列； 如果不存在此fd 返回nullptr
+        */
+        std::shared_ptr<OutputBuffer> getOutputBuffer(const int &fd);
+        /**
+        * @brief 设置每个连接输出队列的高低水位
+        * @note 只对之后建立的连接生效，应当在startListen之前设置
+        * @param highWater 高水位（字节） 积压达到这个值后TcpFDHandler::isWritable返回false（默认4MB）
+        * @param lowWater 低水位（字节） 积压降到这个值以下后恢复可写，并调用setWritableFunction设置的回调（默认1MB）
+        */
+        void setOutputWaterMark(const size_t &highWater,const size_t &lowWater){this->outHighWater=highWater;this->outLowWater=lowWater;}
+        /**
+        * @brief 设置连接恢复可写时的回调函数
+        * @note 连接的输出队列积压超过高水位后又降到低水位以下时，由负责这个连接的reactor线程调用，处理函数可以在这里继续发送之前暂停的数据
+        * @param fc 回调函数 参数为连接的套接字
+        */
+        void setWritableFunction(std::function<void(const int &fd)> fc){this->writableFun=fc;}
+        /**
+        * @brief TcpServer 类的析构函数
+        * @note 会调用close函数关闭
+        */
+        ~TcpServer(){close();}
+    };
+
+    
+    
+    /**
+    * @brief Http/HttpServer 服务端操作类
+    * @note 支持http/1.0 1.1
+    */
+    class HttpServer:public TcpServer
+    {
+    private:
+        std::function<void(HttpServerFDHandler &k,HttpRequestInformation &inf)> securitySendBackFun=[](HttpServerFDHandler &k,HttpRequestInformation &inf)->void
+        {};
+        bool securitySendBackSet=false;
+        std::vector<std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)>> globalSolveFun;
+        //std::function<bool(HttpServerFDHandler &k,HttpRequestInformation &inf)> globalSolveFun={};
+        std::unordered_map<std::string,std::vector<std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)>>> solveFun;
+        std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> parseKey=[](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
+        {inf.ctx["key"]=inf.loc;return 1;};
+        //std::function<bool(const HttpRequestInformation &inf,HttpServerFDHandler &k)> fc;
+        //HttpRequestInformation *HttpInf;
+        ConnectionTable<HttpRequestInformation> httpinf;
+        std::vector<std::pair<std::string,std::string>> staticDir;
+    private:
+        int serveStatic(HttpServerFDHandler &k,HttpRequestInformation &inf);//0:不是静态目录 1:已经回复 -1:发送失败
+        //void consumer(const int &threadID);
+        //inline void handler(const int &fd);
+        void handler_netevent(const int &fd);
+        void handler_workerevent(const int &fd,const int &ret);
+        void handleHeartbeat(const int &id,const int &fd){}
+    public:
+        /**
+        * @brief 把一个任务放入工作线程池由工作线程完成
+        * @note 应当把速度慢、会阻塞的io任务放入工作线程池
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param fun 放入工作线程池的可执行对象
+        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 1:处理成功
+        * @param k 和客户端连接的套接字的操作对象的引用
+        * @param inf 客户端信息的引用，保存数据，处理进度，状态机信息等
+        * @return true：投递成功 false：投递失败
+        */
+        void putTask(const std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> &fun,HttpServerFDHandler &k,HttpRequestInformation &inf);
+         
+        /**
+        * @brief 构造函数，默认是允许最大1000000个连接，每个连接接收缓冲区最大为256kb，启用安全模块。
+        * @note 打开安全模块会对性能有影响
+        * @param maxFD 服务对象的最大接受连接数 默认为1000000
+        * @param buffer_size 同一个连接允许传输的最大数据量（单位为kb） 默认为256kb
+        * @param finishQueue_cap Worker 完成队列（Worker → Reactor）的容量，必须为 2 的幂。
+        //
+        // 该队列用于承载 worker 线程已完成任务的结果，等待 reactor 线程消费。
+        // 这是主数据通路的一部分，对系统吞吐和延迟极其敏感。
+        //
+        // 选型原则：
+        //   finishQueue_cap >= 峰值完成速率(QPS) × reactor 最坏暂停时间
+        //
+        // 建议值（经验）：
+        //   - 低负载/轻业务： 8192  (~8k)
+        //   - 常规高并发：   65536 (~64k)   【默认】
+        //   - 极端突发流量： 131072(~128k)
+        //
+        // 队列满时 请求将会丢弃，框架不会阻塞生产者。
+        * @param security_open true:开启安全模块 false：关闭安全模块 （默认为开启）
+        * @param connectionNumLimit 同一个ip连接数目的上限（默认10）
+        * @param connectionSecs   连接速率统计窗口长度（单位：秒）（默认1秒）
+        * @param connectionTimes  在 connectionSecs 秒内允许的最大连接次数 （默认3次）
+        * @param requestSecs 请求速率统计窗口长度（单位：秒）（默认1秒）
+        * @param requestTimes 在秒requestSecs内允许的最大请求数量（默认20次）
+        * @param checkFrequency 检查僵尸连接的频率（单位：秒）  -1为不做检查 （默认为30秒） 每个连接在reactor的时间轮上按自己的到期时间检查（精度1秒），正数只表示打开检查
+        * @param connectionTimeout 连接多少秒内没有任何反应就视为僵尸连接 （单位为秒） -1为无限制 （默认30秒）
+        * @param engine 事件引擎 EventEngine::EPOLL或者EventEngine::IO_URING（默认epoll） 内核不支持io_uring时startListen会回退到epoll
+        */
+        HttpServer(const unsigned long long &maxFD=1000000,const int &buffer_size=256,const size_t &finishQueue_cap=65536,const bool &security_open=true,
+        const int &connectionNumLimit=10,const int &connectionSecs=1,const int &connectionTimes=3,const int &requestSecs=1,const int &requestTimes=20,
+        const int &checkFrequency=30,const int &connectionTimeout=30,const EventEngine &engine=EventEngine::EPOLL):TcpServer(
+              maxFD,
+              buffer_size,
+              finishQueue_cap,
+              security_open,
+              connectionNumLimit,
+              connectionSecs,
+              connectionTimes,
+              requestSecs,
+              requestTimes,
+              checkFrequency,
+              connectionTimeout,
+              engine
+          ){serverType=2;httpinf.init(maxFD);}
+        /**
+        * @brief 设置静态文件目录
+        * @note 请求的路径（inf.loc）以prefix开头并且没有对应的处理函数时，把剩下的部分拼到dir后面，用HttpServerFDHandler::sendFile发送这个文件；路径是目录时发送里面的index.html；文件不存在时回复404，路径里有..时回复403
+        * @note 可以设置多个，按设置顺序匹配；在全局备用函数之前匹配；路径按原样使用，不做百分号解码
+        * @param prefix 请求路径的前缀 比如"/static/"
+        * @param dir 本地目录 比如"./www/"
+        */
+        void setStaticDirectory(const std::string &prefix,const std::string &dir){staticDir.emplace_back(prefix,dir);}
+        /**
+        * @brief 设置违反信息安全策略时候的返回函数
+        * @note 违反信息安全策略时候的返回函数,调用完就关闭连接
+        * @note 开启setLoadShedding或者工作线程组排满时，被拒绝的请求也用它回复（不关闭连接）；没有设置时回复503 Service Unavailable
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：true：处理成功 false：处理失败 会关闭连接
+        */
+        void setSecuritySendBackFun(std::function<void(HttpServerFDHandler &k,HttpRequestInformation &inf)> fc){this->securitySendBackFun=fc;securitySendBackSet=true;}
+        /**
+        * @brief 设置全局备用函数
+        * @note 找不到对应回调函数的时候会调用全局备用函数.可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        */
+        void setGlobalSolveFunction(std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> fc){globalSolveFun.push_back(std::move(fc));}
+        /**
+        * @brief 设置key对应的收到客户端消息后的回调函数
+        * @note 可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        * @code httpserver->setFunction("/ping",[](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
+	                {
+		                k.sendBack("pong");
+		                return 1;
+	                });
+        * @endcode
+        * @code httpserver->setFunction("/ping",[](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
+	                {
+		                httpserver->putTask([](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
+		                {
+			                k.sendBack("pong");
+			                return 1;
+		                },k,inf);
+		                return 0;
+	                });
+        * @endcode
+        */
+        void setFunction(const std::string &key,std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> fc)
+        {
+            auto [it, inserted] = solveFun.try_emplace(key);
+            it->second.push_back(std::move(fc));
+        }
+        /**
+        * @brief 设置解析出key的回调函数
+        * @note 根据传入的参数把key存入TcpInformation信息中的ctx哈希表。框架会根据key的值找到你注册的处理函数。
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param parseKeyFun 解析key的回调函数
+        * -参数：HttpServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       HttpRequestInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        * @code httpserver->setGetKeyFunction([](HttpServerFDHandler &k,HttpRequestInformation &inf)->int
+	                {
+			            inf.ctx["key"]=inf.loc;
+			            return 1;
+	                });
+        * @endcode
+        */
+        void setGetKeyFunction(std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> parseKeyFun){this->parseKey=parseKeyFun;}
+        /**
+        * @brief 打开Http服务器监听程序
+        * @param port 监听的端口
+        * @param threads 消费者线程的数量 （默认为8）
+        * @param reactors I/O事件循环(reactor)的数量 （默认为1） 详见TcpServer::startListen
+        * @return true：打开监听程序成功 false：打开监听程序失败
+        */
+        bool startListen(const int &port,const int &threads=8,const int &reactors=1)
+        {
+            //HttpInf=new HttpRequestInformation[maxFD];
+            return TcpServer::startListen(port,threads,reactors);
+        }
+    };
+    /**
+    * @brief WebSocket协议的操作类
+    * 仅传入套接字，然后使用这个类进行WebSocket的操作
+    */
+    class WebSocketServerFDHandler:private TcpFDHandler
+    {
+    public:
+        /**
+        * @brief 初始化对象，传入套接字等参数
+        * @param fd 套接字
+        * @param ssl TLS加密的SSL句柄(默认为nullptr)
+        * @param flag1 true：启用非阻塞模式  false：启用阻塞模式 （默认为false，即启用阻塞模式）
+        * @param flag2 true：启用SO_REUSEADDR模式  false：不启用SO_REUSEADDR模式 （默认为true，即启用SO_REUSEADDR模式）
+        */
+        void setFD(const int &fd,SSL *ssl=nullptr,const bool &flag1=false,const bool &flag2=true){TcpFDHandler::setFD(fd,ssl,flag1,flag2);}
+        using TcpFDHandler::setOutputBuffer;
+        using TcpFDHandler::getPendingBytes;
+        using TcpFDHandler::isWritable;
+        /**
+        * @brief 获取一条websocket消息
+        * @param Tcpinf 保存底层tcp状态的信息
+        * @param Websocketinf 保存websocket协议状态信息
+        * @param buffer_size 服务器定义的解析缓冲区的大小（单位为字节)
+        * @param ii 记录解析次数，一些场合用得到 默认为1
+        * @return
+        * -1：获取失败
+        * 0：一般报文
+        * 1：关闭帧
+        * 2：心跳确认报文
+        * 3：心跳报文
+        * 4: 等待数据
+        * @note TcpInf.status
+        *
+        * 0 初始状态
+        * 1 确认消息类型中
+        * 2 确认消息长度中
+        * 3 接收mask中
+        * 4 接收消息中
+        * 
+        */
+        int getMessage(TcpFDInf &Tcpinf,WebSocketFDInformation &Websocketinf,const unsigned long &buffer_size,const int &ii=1);
+        /**
+        * @brief 发送一条websocket信息
+        * @param msg 需要发送的websocket信息
+        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
+        *        约定格式为 `"1000" + type`，其中：
+        *        - "0001" 表示文本帧（Text Frame）
+        *        - "0010" 表示二进制帧（Binary Frame）
+        *        - "1000" 表示连接关闭（Close Frame）
+        *        - "1001" 表示 Ping 帧
+        *        - "1010" 表示 Pong 帧
+        *        请根据内部约定使用，默认使用 text（文本帧）
+        * 
+        * @return true：发送成功  false：发送失败
+        */
+        bool sendMessage(const std::string &msg,const std::string &type="0001");
+       
+    };
+    
+    /**
+    * @brief WebSocketServer服务端操作类
+    */
+    class WebSocketServer:public TcpServer
+    {
+    private:
+        //每个reactor一张表，只由负责这个连接的reactor线程访问
+        std::vector<std::unordered_map<int,WebSocketFDInformation>> wbclientfd{1};
+        std::unordered_map<int,WebSocketFDInformation>& wbTable(const int &fd){return wbclientfd[clientfd[fd].reactor];}
+        std::function<void(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> securitySendBackFun=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->void
+        {};
+        //std::function<bool(const std::string &msg,WebSocketServer &k,const WebSocketFDInformation &inf)> fc=[](const std::string &message,WebSocketServer &k,const WebSocketFDInformation &inf)->bool
+        //{std::cout<<"收到: "<<message<<std::endl;return true;};
+        std::function<bool(WebSocketFDInformation &k)> fcc=[](WebSocketFDInformation &k)
+        {return true;};
+        std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fccc=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->bool
+        {
+            return true;
+        };
+        std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> globalSolveFun=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->bool
+        {return true;};
+        std::unordered_map<std::string,std::vector<std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)>>> solveFun;
+        std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> parseKey=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->int
+        {inf.ctx["key"]=inf.message;return 1;};
+        int seca=20*60;
+        int secb=30;
+
+    private:
+        void handler_netevent(const int &fd);
+        void handler_workerevent(const int &fd,const int &ret);
+        //void consumer(const int &threadID);
+        //inline void handler(const int &fd);
+        void closeAck(const int &fd,const std::string &closeCodeAndMessage);
+        void closeAck(const int &fd,const short &code=1000,const std::string &message="bye");
+        
+        void handleHeartbeat(const int &id,const int &fd);
+        bool closeWithoutLock(const int &fd,const std::string &closeCodeAndMessage);
+        bool closeWithoutLock(const int &fd,const short &code=1000,const std::string &message="bye");
+    public:
+        /**
+        * @brief 把一个任务放入工作线程池由工作线程完成
+        * @note 应当把速度慢、会阻塞的io任务放入工作线程池
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param fun 放入工作线程池的可执行对象
+        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 1:处理成功
+        * @param k 和客户端连接的套接字的操作对象的引用
+        * @param inf 客户端信息的引用，保存数据，处理进度，状态机信息等
+        * @return true：投递成功 false：投递失败
+        */
+         void putTask(const std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> &fun,WebSocketServerFDHandler &k,WebSocketFDInformation &inf);
+        /**
+        * @brief 构造函数，默认是允许最大1000000个连接，每个连接接收缓冲区最大为256kb，启用安全模块。
+        * @note 打开安全模块会对性能有影响
+        * @param maxFD 服务对象的最大接受连接数 默认为1000000
+        * @param buffer_size 同一个连接允许传输的最大数据量（单位为kb） 默认为256kb
+        * @param finishQueue_cap Worker 完成队列（Worker → Reactor）的容量，必须为 2 的幂。
+        //
+        // 该队列用于承载 worker 线程已完成任务的结果，等待 reactor 线程消费。
+        // 这是主数据通路的一部分，对系统吞吐和延迟极其敏感。
+        //
+        // 选型原则：
+        //   finishQueue_cap >= 峰值完成速率(QPS) × reactor 最坏暂停时间
+        //
+        // 建议值（经验）：
+        //   - 低负载/轻业务： 8192  (~8k)
+        //   - 常规高并发：   65536 (~64k)   【默认】
+        //   - 极端突发流量： 131072(~128k)
+        //
+        // 队列满时 请求将会丢弃，框架不会阻塞生产者。
+        * @param security_open true:开启安全模块 false：关闭安全模块 （默认为开启）
+        * @param connectionNumLimit 同一个ip连接数目的上限（默认5）
+        * @param connectionSecs   连接速率统计窗口长度（单位：秒）（默认10秒）
+        * @param connectionTimes  在 connectionSecs 秒内允许的最大连接次数 （默认3次）
+        * @param requestSecs 请求速率统计窗口长度（单位：秒）（默认1秒）
+        * @param requestTimes 在秒requestSecs内允许的最大请求数量（默认10次）
+        * @param checkFrequency 检查僵尸连接的频率（单位：秒）  -1为不做检查 （默认为60秒） 每个连接在reactor的时间轮上按自己的到期时间检查（精度1秒），正数只表示打开检查
+        * @param connectionTimeout 连接多少秒内没有任何反应就视为僵尸连接 （单位为秒） -1为无限制 （默认120秒）
+        * @param engine 事件引擎 EventEngine::EPOLL或者EventEngine::IO_URING（默认epoll） 内核不支持io_uring时startListen会回退到epoll
+        */
+        WebSocketServer(const unsigned long long &maxFD=1000000,const int &buffer_size=256,const size_t &finishQueue_cap=65536,const bool &security_open=true,
+        const int &connectionNumLimit=5,const int &connectionSecs=10,const int &connectionTimes=3,const int &requestSecs=1,const int &requestTimes=10,
+        const int &checkFrequency=60,const int &connectionTimeout=120,const EventEngine &engine=EventEngine::EPOLL):TcpServer(
+              maxFD,
+              buffer_size,
+              finishQueue_cap,
+              security_open,
+              connectionNumLimit,
+              connectionSecs,
+              connectionTimes,
+              requestSecs,
+              requestTimes,
+              checkFrequency,
+              connectionTimeout,
+              engine
+          ){serverType=3;}
+        /**
+        * @brief 设置违反信息安全策略时候的返回函数
+        * @note 违反信息安全策略时候的返回函数,调用完就关闭连接
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：true：处理成功 false：处理失败 会关闭连接
+        */
+        void setSecuritySendBackFun(std::function<void(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fc){this->securitySendBackFun=fc;}
+        /**
+        * @brief 设置全局备用函数
+        * @note 找不到对应回调函数的时候会调用全局备用函数
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：true：处理成功 false：处理失败 会关闭连接
+        */
+        void setGlobalSolveFunction(std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fc){this->globalSolveFun=fc;}
+        /**
+        * @brief 设置websocket连接成功后就执行的回调函数
+        * 注册一个回调函数
+        * @param fc 一个函数或函数对象，websocket连接成功后就执行
+        * -参数：const WebSocketFDInformation &inf - Websocket服务端的信息
+        *       WebSocketServer &k - 服务端对象的引用
+        * @note 传入的函数应该有如下签名 void func(const WebSocketFDInformation &inf,WebSocketServer &k)
+        */
+        void setStartFunction(std::function<bool(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fccc){this->fccc=fccc;}
+        /**
+        * @brief 设置websocket握手阶段的检查函数，只有检查通过才执行后续握手
+        * 注册一个回调函数
+        * @param fc 一个函数或函数对象，websocket连接成功后就执行
+        * -参数：const WebSocketFDInformation &inf - Websocket服务端的信息
+        * -返回值 ： true：检查通过  false：检查不通过
+        * @note 传入的函数应该有如下签名 bool func(const WebSocketFDInformation &k)
+        * @note 只有检查通过才执行后续握手，否则断开连接
+        */
+        void setJudgeFunction(std::function<bool(WebSocketFDInformation &k)> fcc){this->fcc=fcc;}
+        /**
+        * @brief 设置key对应的收到客户端消息后的回调函数
+        * @note 可以设置多个 ，框架会根据设置顺序依次执行回调函数；也可以设置扔入工作线程池处理的流程，注意设置不同的返回值即可。
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param key 找到对应回调函数的key
+        * @param fc 一个函数或函数对象，用于收到客户端消息后处理逻辑
+        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        * @code s->setFunction("ping",[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->int
+	                {
+		                k.sendMessage("pong");
+		                return 1;
+	                });
+        * @endcode
+        */
+        void setFunction(const std::string &key,std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> fc)
+        {
+            auto [it, inserted] = solveFun.try_emplace(key);
+            it->second.push_back(std::move(fc));
+        }
+        /**
+        * @brief 设置解析出key的回调函数
+        * @note 根据传入的参数把key存入TcpInformation信息中的ctx哈希表。框架会根据key的值找到你注册的处理函数。
+        * @warning 可执行对象必须严格按照规定的返回值返回
+        * @param parseKeyFun 解析key的回调函数
+        * -参数：WebSocketServerFDHandler &k - 和客户端连接的套接字的操作对象的引用
+        *       WebSocketFDInformation &inf - 客户端信息，保存数据，处理进度，状态机信息等
+        * -返回值：-2:处理失败并且需要关闭连接 -1:处理失败但不需要关闭连接 0:处理流程已经扔入工作线程池，需要等待处理完成 1:处理成功
+        * @code s->setGetKeyFunction([](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->int
+	                {
+			            inf.ctx["key"]=inf.message;
+			            return 1;
+		            });
+        * @endcode
+        */
+        void setGetKeyFunction(std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> parseKeyFun){this->parseKey=parseKeyFun;}
+        //void setFunction(std::function<bool(const std::string &msg,WebSocketServer &k,const WebSocketFDInformation &inf)> fc){this->fc=fc;}
+        /**
+        * @brief 设置心跳时间
+        * @param seca 心跳时间 单位为分钟。不设置默认为20分钟
+        */
+        void setTimeOutTime(const int &seca){this->seca=seca*60;}
+        /**
+        * @brief 设置发送心跳后的等待时间
+        * @param secb 发送心跳后的等待时间 单位为秒 不设置默认为30秒
+        * @note 如果超过这个时间对端没有反应 关闭连接
+        */
+        void setHBTimeOutTime(const int &secb){this->secb=secb;}
+        /**
+        * @brief 发送关闭帧关闭对应套接字的 WebSocket 连接（简化方式）
+        * 
+        * 传入套接字fd然后关闭连接
+         * 直接传入编码后的关闭 payload，其中前两字节为关闭码（big-endian），
+         * 后续为 UTF-8 编码的关闭原因描述，用于简化调用。
+        * 
+        * @param fd 套接字fd
+        * @param closeCodeAndMessage 编码后的关闭帧 payload（2 字节关闭码 + 可选消息）
+        * @return true：关闭成功  false：关闭失败
+        */
+        bool closeFD(const int &fd,const std::string &closeCodeAndMessage);
+        /**
+        * @brief 发送关闭帧关闭对应套接字的 WebSocket 连接（标准方式）
+        * 
+        * 传入套接字fd然后关闭连接
+        * 构建符合 RFC 6455 的关闭帧（opcode = 0x8），帧 payload 包含关闭码（2 字节）与可选关闭原因字符串。
+        * 
+        * @param fd 套接字fd
+        * @param code WebSocket 关闭码，常见包括：
+        * - 1000：正常关闭（Normal Closure）
+        * - 1001：终端离开（Going Away）
+        * - 1002：协议错误（Protocol Error）
+        * - 1003：不支持的数据类型（Unsupported Data）
+        * - 1006：非正常关闭（无关闭帧，程序内部使用）
+        * - 1008：策略违规（Policy Violation）
+        * - 1011：服务器内部错误（Internal Error）
+        * 
+        * @param message 可选关闭原因，供调试或日志记录用
+        * @return true：关闭成功 false：关闭失败
+        */
+        bool closeFD(const int &fd,const short &code=1000,const std::string &message="bye");
+        /**
+        * @brief 发送 WebSocket 消息给某一个客户端
+        * 
+        * 根据 WebSocket 协议，封装并发送一条带掩码的数据帧（客户端必须使用掩码），
+        * 支持根据 payload 长度自动选择帧格式：
+        * - payload <= 125 字节：使用 1 字节长度
+        * - 126 <= payload <= 65535：使用 2 字节扩展长度（附加 126 标记）
+        * - payload > 65535：使用 8 字节扩展长度（附加 127 标记）
+        * 
+        * @param fd 和客户端连接的套接字
+        * @param msg 要发送的消息内容（已编码为文本或二进制）
+        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
+        *        约定格式为 `"1000" + type`，其中：
+        *        - "0001" 表示文本帧（Text Frame）
+        *        - "0010" 表示二进制帧（Binary Frame）
+        *        - "1000" 表示连接关闭（Close Frame）
+        *        - "1001" 表示 Ping 帧
+        *        - "1010" 表示 Pong 帧
+        *        请根据内部约定使用，默认使用 text（文本帧）
+        * 
+        * @return true 发送成功
+        * @return false 发送失败（可能因连接未建立或发送异常）
+        */
+        bool sendMessage(const int &fd,const std::string &msg,const std::string &type="0001"){WebSocketServerFDHandler k;k.setFD(fd,getSSL(fd),unblock);k.setOutputBuffer(getOutputBuffer(fd));return k.sendMessage(msg,type);}
+        /**
+        * @brief 关闭监听和所有连接
+        * @note 会阻塞直到全部关闭
+        */
+        bool close();
+        /**
+        * @brief 关闭某个套接字的连接
+        @ @note 多态了TcpServer的close某个套接字 直接掐掉Tcp连接 没有按照websocket协议关闭
+        */
+        bool close(const int &fd);
+        /**
+        * @brief 打开Websocket服务器监听程序
+        * @param port 监听的端口
+        * @param threads 消费者线程的数量 （默认为8）
+        * @param reactors I/O事件循环(reactor)的数量 （默认为1） 详见TcpServer::startListen
+        * @return true：打开监听程序成功 false：打开监听程序失败
+        */
+        bool startListen(const int &port,const int &threads=8,const int &reactors=1)
+        {
+            //std::thread(&WebSocketServer::HB,this).detach();
+            if(reactors<=0)
+                return false;
+            wbclientfd.assign(reactors,{});
+            return TcpServer::startListen(port,threads,reactors);
+        }
+        /**
+        * @brief 广播发送 WebSocket 消息
+        * 
+        * 给全体客户端广播发送消息
+        * 根据 WebSocket 协议，封装并发送一条带掩码的数据帧（客户端必须使用掩码），
+        * 支持根据 payload 长度自动选择帧格式：
+        * - payload <= 125 字节：使用 1 字节长度
+        * - 126 <= payload <= 65535：使用 2 字节扩展长度（附加 126 标记）
+        * - payload > 65535：使用 8 字节扩展长度（附加 127 标记）
+        * 
+        * @param msg 要发送的消息内容（已编码为文本或二进制）
+        * @param type 指定消息类型的自定义字段（通常是 WebSocket 帧的 opcode）
+        *        约定格式为 `"1000" + type`，其中：
+        *        - "0001" 表示文本帧（Text Frame）
+        *        - "0010" 表示二进制帧（Binary Frame）
+        *        - "1000" 表示连接关闭（Close Frame）
+        *        - "1001" 表示 Ping 帧
+        *        - "1010" 表示 Pong 帧
+        *        请根据内部约定使用，默认使用 text（文本帧）
+        * 
+        */
+        void sendMessage(const std::string &msg,const std::string &type="0001");
+        /**
+        * @brief  WebSocketServer的析构函数
+        * @note 销毁对象的时候会阻塞直到全部连接和监听等全部关闭
+        */
+        ~WebSocketServer(){  }
+    };
+
+    /**
+    * @brief UDP操作的类
+    * 传入套接字进行UDP协议的操作
+    */
+    class UdpFDHandler
+    {
+    protected:
+        int fd=-1;
+        bool flag1=false;
+        bool flag2=false;
+        int sec=-1;
+    public:
+        /**
+        * @brief 设置fd
+        * @param fd 需要传入的套接字fd
+        * @param flag1 true：设置非阻塞模式  false：设置阻塞模式 （默认为阻塞模式）
+        * @param sec 设置阻塞超时时间（秒） （默认为-1 即为无限等待）
+        * @param flag2 true：设置SO_REUSEADDR模式 false：不设置SO_REUSEADDR模式
+        */
+        void setFD(const int &fd,const bool &flag1=false,const int &sec=-1,const bool &flag2=false);
+        /**
+        * @brief 设置为阻塞模式
+        * @param sec 阻塞超时时间 阻塞超过这个时间就不会再阻塞了 默认为-1 即无限等待
+        */
+        void blockSet(const int &sec=-1);
+        /**
+        * @brief 设置为非阻塞模式
+        */
+        void unblockSet();
+        /**
+        * @brief 设置SO_REUSEADDR模式
+        * @return true：设置成功  false：设置失败
+        */
+        bool multiUseSet();
+        /**
+        * @brief 返回fd
+        */
+        int getFD(){return fd;}
+        /**
+        * @brief 置空对象，关闭套接字
+        * @param cle true：置空对象并且关闭套接字  false：仅仅清空对象，不关闭套接字
+        */
+        void close(const bool &cle=true);
+        /**
+        * @brief 向目标发送字符串数据。
+        *
+        * @param data 要发送的数据内容（std::string 类型）。
+        * @param block 是否以阻塞模式发送（默认 true）。
+        *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；
+        *              - false：阻塞与否取决于套接字状态。
+        * 
+        * @return
+        * - 返回值 > 0：成功发送的字节数；
+        * - 返回值 <= 0：发送失败；
+        *   - -98：目标错误
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式下，发送缓冲区已满。
+        *
+        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞），适合希望确保完整发送的场景。
+        * 若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 length，需手动处理剩余数据。
+        */
+        int sendData(const std::string &data,const std::string &ip,const int &port,const bool &block=true);
+        /**
+        * @brief 向目标发送指定长度的二进制数据。
+        *
+        * @param data 指向要发送的数据缓冲区。
+        * @param length 数据长度（字节）。
+        * @param block 是否以阻塞模式发送（默认 true）。
+         *              - true：会阻塞直到全部数据发送成功除非出错了（无论 socket 是阻塞或非阻塞）；
+         *              - false：阻塞与否取决于套接字状态。
+        * 
+        * @return
+        * - 返回值 > 0：成功发送的字节数；
+        * - 返回值 <= 0：发送失败；
+        *   - -98：目标错误
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式下，发送缓冲区已满。
+        *
+        * @note 若 block 为 true，会持续阻塞直到全部数据发送完毕除非出错了（无论 socket 是阻塞或非阻塞）。
+        *       若 block 为 false，阻塞与否取决于套接字状态。返回值可能小于 length，需手动处理剩余数据。
+        */
+        int sendData(const char *data,const uint64_t &length,const std::string &ip,const int &port,const bool &block=true);
+        /**
+        * @brief 接收一次数据到string字符串容器
+        * @param data 接收数据的数据容器（string类型）
+        * @param length 最大接收长度
+        * @param ip 记录发送来源的ip
+        * @param port 记录发送来源的断开
+        * @return 
+        * - 返回值 > 0：成功接收的字节数；
+        * - 返回值 = 0：连接已关闭；
+        * - 返回值 < 0：接收失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式且没有数据
+        * @note 接收是否会阻塞根据fd的阻塞情况决定
+        */
+        int recvData(std::string &data,const uint64_t &length,std::string &ip,int &port);
+        /**
+        * @brief 接收一次数据到char*容器
+        * @param data 接收数据的数据容器（char*类型）
+        * @param length 最大接收长度
+        * @param ip 记录发送来源的ip
+        * @param port 记录发送来源的断开
+        * @return 
+        * - 返回值 > 0：成功接收的字节数；
+        * - 返回值 = 0：连接已关闭；
+        * - 返回值 < 0：接收失败；
+        *   - -99：对象未绑定 socket；
+        *   - -100：非阻塞模式且没有数据
+        * @note 接收是否会阻塞根据fd的阻塞情况决定
+        */
+        int recvData(char *data,const uint64_t &length,std::string &ip,int &port);
+        
+    };
+    /**
+    * @brief udp客户端的操作类
+    */
+    class UdpClient:public UdpFDHandler
+    {
+    public:
+        /**
+        * @brief 构造函数
+        * @param flag1 true：非阻塞模式 false：阻塞模式 （默认阻塞模式）
+        * @param sec 设置阻塞超时时间（秒） （默认为无限等待）
+        */
+        UdpClient(const bool &flag1=false,const int &sec=-1);
+        /**
+        * @brief 销毁原来的套接字，重新创建一个客户端
+        * @param flag1 true：非阻塞模式 false：阻塞模式 （默认阻塞模式）
+        * @param sec 设置阻塞超时时间（秒） （默认为无限等待）
+        */
+        bool createFD(const bool &flag1=false,const int &sec=-1);
+        /**
+        * @brief 析构函数，对象生命结束会会关闭套接字
+        */
+        ~UdpClient(){close();}
+    };
+    /**
+    * @brief udp服务端的操作类
+    */
+    class UdpServer:public UdpFDHandler
+    {
+    public:
+        /**
+        * @brief 构造函数
+        * @param flag1 true：设置非阻塞模式  false：设置阻塞模式 （默认为阻塞模式）
+        * @param sec 设置阻塞超时时间（秒） （默认为-1 即为无限等待）
+        * @param flag2 true：设置SO_REUSEADDR模式 false：不设置SO_REUSEADDR模式
+        */
+        UdpServer(const int &port,const bool &flag1=false,const int &sec=-1,const bool &flag2=true);
+        /**
+        * @brief 销毁原来的套接字，重新创建一个服务端
+        * @param flag1 true：设置非阻塞模式  false：设置阻塞模式 （默认为阻塞模式）
+        * @param sec 设置阻塞超时时间（秒） （默认为-1 即为无限等待）
+        * @param flag2 true：设置SO_REUSEADDR模式 false：不设置SO_REUSEADDR模式
+        */
+        bool createFD(const int &port,const bool &flag1=false,const int &sec=-1,const bool &flag2=true);
+        /**
+        * @brief 析构函数，对象生命结束会会关闭套接字
+        */
+        ~UdpServer(){close();}
+    };
+    }
+    /**
+    * @namespace stt::system
+    * @brief 系统的设置，进程的控制，心跳监控等
+    * @ingroup stt
+    */
+    namespace system
+    {
+        /**
+        * @brief 初始化服务系统的类
+        * - 适用于需要稳定运行的服务程序的初始化
+        * - 传入的日志文件对象如果是没初始化的空的对象，系统自动在程序目录下创建server_log的文件夹并根据当前时间生成日志文件；如果是初始化了的对象，则启用当前对象下的日志文件。
+        * - 日志系统一旦设置好，会生成日志文件记录服务网络程序的运行动态
+        * - 日志系统的有效工作时间和传入的日志文件对象的生命周期相关
+        */
+        class ServerSetting
+        {
+        public:
+            /**
+            * @brief 系统的日志系统的读写日志对象的指针
+            */
+            static file::LogFile *logfile;
+            /**
+            * @brief 系统的日志系统的语言选择，默认为English
+            */
+            static std::string language;
+        private:
+            static void signalterminated(){std::cout<<"未捕获的异常终止"<<std::endl;if(system::ServerSetting::logfile!=nullptr){if(system::ServerSetting::language=="Chinese")system::ServerSetting::logfile->writeLog("未捕获的异常终止");else system::ServerSetting::logfile->writeLog("end for uncaught exception");}kill(getpid(),15);}
+            static void signalSIGSEGV(int signal){std::cout<<"SIGSEGV"<<std::endl;if(system::ServerSetting::logfile!=nullptr){if(system::ServerSetting::language=="Chinese")system::ServerSetting::logfile->writeLog("信号SIGSEGV");else system::ServerSetting::logfile->writeLog("signal SIGSEGV");}kill(getpid(),15);}
+            static void signalSIGABRT(int signal){std::cout<<"SIGABRT"<<std::endl;if(system::ServerSetting::logfile!=nullptr){if(system::ServerSetting::language=="Chinese")system::ServerSetting::logfile->writeLog("信号SIGABRT");else system::ServerSetting::logfile->writeLog("signal SIGABRT");}kill(getpid(),15);}
+        public:
+            /**
+            * @brief 设置系统的信号
+            * - 屏蔽信号1-14，14-64
+            * - 收到SIGSEGV信号后发送信号15
+            * - 收到未捕获的异常后发送信号15
+            * - 收到SIGABRT信号后发送信号15
+            * - 信号15的退出方式自定义
+            */
+            static void setExceptionHandling();
+            /**
+            * @brief 设置日志系统的日志文件对象
+            * 传入的日志文件对象如果是没初始化的空的对象，系统自动在程序目录下生成server_log文件夹并且根据当前时间生成一个日志文件记录服务程序的网络通信
+            * 如果传入的日志文件对象是初始化了的对象，则启用当前对象下的日志文件。
+            * @param logfile 传入日志文件对象的指针，如果这个对象没初始化，系统自动在程序目录下生成server_log文件夹并且根据当前时间生成一个日志文件。 （默认为nullptr，不设置日志文件）
+            * @param language 日志文件的语言 "Chinese":中文 除此之外都会设置成英文 （默认为空 设置为英文）
+            */
+            static void setLogFile(file::LogFile *logfile=nullptr,const std::string &language="");
+            /**
+            * @brief 执行setExceptionHandling和setLogFile两个函数，完成初始化信号和日志系统
+            * @param logfile 传入日志文件对象的指针，如果这个对象没初始化，系统自动在程序目录下生成server_log文件夹并且根据当前时间生成一个日志文件。 （默认为nullptr，不设置日志文件）
+            * @param language 日志文件的语言 "Chinese":中文 除此之外都会设置成英文 （默认为空 设置为英文）
+            */
+            static void init(file::LogFile *logfile=nullptr,const std::string &language="");
+        };
+        
+        /**
+        * @brief 封装 System V 信号量的同步工具类。
+        * 
+        * `csemp` 提供互斥机制，支持进程间同步操作。通过封装 semget、semop、semctl 等系统调用，
+        * 实现信号量的初始化、P（等待）操作、V（释放）操作、销毁及读取当前值等功能。
+        * 
+        * 禁用复制构造和赋值运算符，保证资源唯一。
+        */
+        class csemp
+        {
+        private:
+            /**
+            * @brief 用于 semctl() 系统调用的联合体参数。
+            * 
+            * `semun` 是 System V 接口中设置信号量属性所必需的用户定义结构。
+            */
+            union semun  
+            {
+                int val;                ///< 设置信号量的值（用于 SETVAL）
+                struct semid_ds *buf;   ///< 信号量的状态缓冲区（用于 IPC_STAT, IPC_SET）
+                unsigned short  *arry;  ///< 设置信号量数组的值（用于 SETALL）
+            };
+
+            int   m_semid;      ///< 信号量的 ID，由 semget 获取。
+            short m_sem_flg;    ///< 信号量操作标志（如 SEM_UNDO）。
+
+            csemp(const csemp &) = delete;             ///< 禁用拷贝构造
+            csemp &operator=(const csemp &) = delete;  ///< 禁用赋值操作
+
+        public:
+            /**
+            * @brief 构造函数，初始化内部状态。
+            */
+            csemp():m_semid(-1){}
+
+            /**
+            * @brief 初始化信号量。
+            * 
+            * 如果信号量已存在，则获取它；否则尝试创建并设置初值。
+            * 
+            * @param key 信号量的唯一键值。
+            * @param value 信号量的初始值（默认1，表示互斥锁）。
+            * @param sem_flg 信号量操作标志，默认 SEM_UNDO，操作会在进程终止后自动撤销。
+            * @return true 成功；false 失败。
+            */
+            bool init(key_t key, unsigned short value = 1, short sem_flg = SEM_UNDO);
+
+            /**
+            * @brief P 操作（等待），尝试将信号量值减去 value。
+            * 
+            * 若当前值不足，会阻塞直到可用。
+            * 
+            * @param value 等待值（必须小于0，默认 -1）。
+            * @return true 成功；false 失败。
+            */
+            bool wait(short value = -1);
+
+            /**
+            * @brief V 操作（释放），尝试将信号量值加上 value。
+            * 
+            * 释放资源或唤醒等待中的进程。
+            * 
+            * @param value 释放值（必须大于0，默认 1）。
+            * @return true 成功；false 失败。
+            */
+            bool post(short value = 1);
+
+            /**
+            * @brief 获取信号量当前的值。
+            * 
+            * @return 信号量的值；失败时返回 -1。
+            */
+            int getvalue();
+
+            /**
+            * @brief 销毁当前信号量。
+            * 
+            * 一般用于持有该信号量的主进程退出前清理资源。
+            * 
+            * @return true 成功；false 失败。
+            */
+            bool destroy();
+
+            /**
+            * @brief 析构函数，不自动销毁信号量。
+            */
+            ~csemp();
+        };
+
+        /**
+        * @brief 定义MAX_PROCESS_NAME这个宏为100,意思是进程信息中的进程名字长度不超过100个字节
+        */
+        #define MAX_PROCESS_NAME 100
+        /**
+        * @brief 定义MAX_PROCESS_INF这个宏为1000,意思是进程信息表记录的进程信息最多为1000条
+        */
+        #define MAX_PROCESS_INF 1000
+        /**
+        * @brief 定义SHARED_MEMORY_KEY这个宏为0x5095,意思是进程信息表的共享内存键值为0x5095
+        */
+        #define SHARED_MEMORY_KEY 0x5095
+        /**
+        * @brief 定义SHARED_MEMORY_LOCK_KEY这个宏为0x5095,意思是操作进程信息表的信号量的键值为0x5095
+        */
+        #define SHARED_MEMORY_LOCK_KEY 0x5095
+
+        /**
+        * @brief 进程信息的结构体
+        */
+        struct ProcessInf
+        {
+            /**
+            * @brief 进程id
+            */
+            pid_t pid;
+            /**
+            * @brief 进程最后一次心跳时间,是时间戳
+            */
+            time_t lastTime;
+            /**
+            * @brief 进程名字
+            */
+            char name[MAX_PROCESS_NAME];
+            /**
+            * @brief 进程第一个参数
+            */
+            char argv0[20];
+            /**
+            * @brief 进程第二个参数
+            */
+            char argv1[20];
+            /**
+            * @brief 进程第三个参数
+            */
+            char argv2[20];
+        };
+
+        /**
+        * @brief 负责进程心跳监控，调度的类
+        * 用于监控服务进程，保证服务进程持续有效运行
+        * 进程结束后，0x5095这一块共享内存和信号量都没有删掉
+        * 目前只支持最多三个参数的进程加入监控
+        * 应该自己手动在程序编写加入心跳监控系统，更新心跳，检查心跳系统的逻辑。该类只提供调用接口。
+        */
+        class HBSystem
+        {
+        private:
+        
+            static ProcessInf *p;
+            static csemp plock;
+            static bool isJoin;
+        public:
+            /**
+            * @brief 把进程加入到心跳系统
+            * @param name 进程名字的绝对路径
+            * @param argv0 进程的第一个参数
+            * @param argv1 进程的第二个参数
+            * @param argv2 进程的第三个参数
+            * @return true：加入成功  false：加入失败
+            */
+            bool join(const char *name,const char *argv0="",const char *argv1="",const char *argv2="");
+            /**
+            * @brief 更新当前进程的心跳
+            * @return true：更新成功  false：更新失败
+            */
+            bool renew();
+            /**
+            * @brief 输出心跳监控系统的所有进程的信息
+            */
+            static void list();
+            /**
+            * @brief 检查心跳监控系统
+            * 如果上一次心跳更新的时间和现在的时候相差大于等于sec秒，则杀死进程
+            * 先发送信号15杀死进程 如果8秒后进程还存在 则发送信号9强制杀死
+            * @return true：操作成功  false：操作失败
+            */
+            static bool HBCheck(const int &sec);
+            /**
+            * @brief 把当前进程从心跳系统中删除
+            * @return true：操作成功 false：操作失败
+            */
+            bool deleteFromHBS();
+            /**
+            * @brief HBSystem的析构函数
+            * - 把当前进程从心跳系统中删除
+            */
+            ~HBSystem();
+        };
+
+        /**
+        * @brief 进程管理的静态工具类
+        */
+        class Process
+        {
+        public:
+        
+
+            /**
+            * @brief 启动一个新进程（可选择是否定时重启）
+            * 
+            * 当 `sec == -1` 时，仅启动一次子进程；否则，会创建一个辅助子进程，定期重启该目标进程。
+            * 
+            * - 定时启动时，辅助进程会屏蔽所有信号。
+            * - 启动的目标进程会屏蔽除 SIGCHLD 和 SIGTERM 的所有信号。
+            * 
+            * @param Args 可变参数类型（用于传递给目标程序的 argv）
+            * @param name 要执行的程序路径（如 `/usr/bin/myapp`）
+            * @param sec 定时间隔（单位：秒）。若为 -1，则表示只启动一次，不定时。
+            * @param args 启动参数（第一个参数必须是程序名称，即 argv[0]，末尾不需要添加 nullptr）
+            * @return true 父进程返回 true 表示启动（或调度）成功
+            * @return false fork 或 execv 出错时返回 false
+            * 
+            * @note
+            * - 参数中不需要手动添加 nullptr；内部自动添加。
+            * - 执行失败后不会抛出异常；返回 false。
+            * - execv 会在子进程中替换当前进程镜像，不返回。
+            */
+            template<class... Args>
+            static bool startProcess(const std::string &name,const int &sec=-1,Args ...args)
+            {
+                std::vector<const char *> paramList={args...,nullptr};
+                if(sec==-1)
+                {
+                    pid_t pid=fork();
+                    if(pid==-1)
+                        return false;
+                    if(pid>0)
+                        return true;
+                    else
+                    {
+                        execv(name.c_str(),const_cast<char* const*>(paramList.data()));
+                        return false;
+                    }
+                }
+                for(int ii=1;ii<=64;ii++)
+                    signal(ii,SIG_IGN);           
+                pid_t pid=fork();
+                if(pid==-1)
+                    return false;
+                if(pid>0)
+                {   
+                    return true;
+                }
+                else
+                {
+                    signal(SIGCHLD,SIG_DFL);
+                    signal(15,SIG_DFL);
+                    while(1)
+                    {
+                        pid=fork();
+                        if(fork()==0)
+                        {
+                            execv(name.c_str(),const_cast<char* const*>(paramList.data()));
+                            exit(0);
+                        }
+                        else if(pid>0)
+                        {
+                            int sts;
+                            wait(&sts);
+                            sleep(sec);
+                        }
+                        else
+                            continue;
+                    }
+                }
+            }
+            /**
+            * @brief 通过函数创建子进程（可选择是否定时重启）
+            * 
+            * 使用一个可调用对象（如 Lambda、函数指针、std::function）作为新子进程的主体逻辑。
+            * 
+            * - 当 `sec == -1`，函数仅执行一次；
+            * - 否则，会创建一个辅助进程定期重新 fork 并执行该函数。
+            * 
+            * @param Fn 可调用对象类型（如函数、Lambda）
+            * @param Args 可调用对象的参数类型
+            * @param fn 要执行的函数或可调用对象
+            * @param sec 定时间隔（单位：秒）。若为 -1，则表示只执行一次，不定时。
+            * @param args 要传递给函数的参数
+            * @return true 父进程返回 true 表示启动成功；子进程内部也会返回 true（用于链式调用等）
+            * @return false 创建进程失败
+            * 
+            * @note
+            * - 函数的实际执行是在新 fork 出的子进程中。
+            * - 函数 fn 必须是可调用的；参数类型需能完美转发。
+            * - 子进程执行完毕后会退出；辅助进程将周期性地重新创建它。
+            */
+            template<class Fn,class... Args>
+            static typename std::enable_if<!std::is_convertible<Fn, std::string>::value, bool>::type
+            startProcess(Fn&& fn,const int &sec=-1,Args &&...args)
+            {
+                if(sec==-1)
+                {
+                    pid_t pid=fork();
+                    if(pid==-1)
+                        return false;
+                    if(pid>0)
+                    return true;
+                    else
+                    {
+                        auto f=std::bind(std::forward<Fn>(fn),std::forward<Args>(args)...);
+                        f();
+                        return true;
+                    }
+                }
+                for(int ii=1;ii<=64;ii++)
+                    signal(ii,SIG_IGN);           
+                pid_t pid=fork();
+                if(pid==-1)
+                    return false;
+                if(pid>0)
+                {   
+                    return true;
+                }
+                else
+                {
+                    signal(SIGCHLD,SIG_DFL);
+                    signal(15,SIG_DFL);
+                    while(1)
+                    {
+                        pid=fork();
+                        if(pid==0)
+                        {
+                            auto f=std::bind(std::forward<Fn>(fn),std::forward<Args>(args)...);
+                            f();
+                            return true;
+                        }
+                        else if(pid>0)
+                        {
+                            int sts;
+                            wait(&sts);
+                            sleep(sec);
+                        }
+                        else
+                            continue;
+                    }
+                }
+            }
+        };
+
+        /**
+        * @brief CPU亲和性和NUMA拓扑的静态工具类
+        * @note 拓扑从/sys/devices/system读取，不依赖libnuma；读不到时按只有一个节点（节点0）处理
+        */
+        class CPUAffinity
+        {
+        public:
+            /**
+            * @brief 获取NUMA节点数
+            */
+            static int nodeCount();
+            /**
+            * @brief 获取某个CPU所在的NUMA节点
+            * @return 节点编号 读不到时返回0
+            */
+            static int nodeOfCPU(const int &cpu);
+            /**
+            * @brief 获取当前线程正在运行的CPU所在的NUMA节点
+            */
+            static int currentNode();
+            /**
+            * @brief 把当前线程绑定到cpus上
+            * @param cpus CPU编号的集合 为空时什么都不做
+            * @return true：成功（或者cpus为空） false：失败（CPU编号不存在等）
+            */
+            static bool bindThread(const std::vector<int> &cpus);
+            /**
+            * @brief 获取当前线程允许运行的CPU集合
+            */
+            static std::vector<int> threadCPUs();
+            /**
+            * @brief 把CPU集合格式化为"0-3,8(node0)"的形式 用于日志
+            * @param cpus CPU编号的集合 为空时返回"unpinned"
+            */
+            static std::string describe(const std::vector<int> &cpus);
+        };
+
+        using Task = std::function<void()>;
+        /**
+        * @class WorkerPool
+        * @brief 固定大小的工作窃取（work-stealing）线程池
+        *
+        * 每个工作线程有自己的本地任务队列；外部线程（如 reactor）提交的任务先进入无锁的 MPSC 收件箱，
+        * 空闲的工作线程负责把收件箱里的任务成批搬到自己的本地队列，其余空闲线程再从忙碌线程那里窃取一半任务。
+        * 没有任务时工作线程睡在 futex 上，提交方只在确实有线程睡眠时才发起系统调用。
+        *
+        * ## 特性
+        * - 固定线程数量
+        * - 线程安全的任务提交，提交路径上没有全局锁
+        * - 工作线程内部再提交的任务直接进入本线程的本地队列
+        * - 收件箱满时退化到一个加锁的溢出队列，任务不会丢失
+        * - submitTo() 按key把任务放进固定工作线程的有序通道，同一个key的任务串行执行
+        * - 支持优雅停止（graceful shutdown）
+        *
+        * ## 线程安全说明
+        * - submit() 和 submitTo() 是线程安全的
+        * - stop() 是线程安全的
+        *
+        * ## 使用示例
+        * @code
+        * WorkerPool pool(4);
+        * pool.submit([] {
+        *     // 执行任务
+        * });
+        * pool.stop();
+        * @endcode
+        */
+        class WorkerPool 
+        {
+        public:
+            /**
+            * @brief 构造函数，创建指定数量的工作线程
+            *
+            * @param n 工作线程数量
+            * @param cpus 第i个工作线程绑定到cpus[i%cpus.size()]这个CPU上 为空时不绑定（默认）
+            * @param nice 工作线程的nice值 CPU紧张时内核按它分配时间（每差1约1.25倍） 默认0 负数需要CAP_SYS_NICE权限，设置失败时保持0
+            *
+            * 构造完成后，所有线程立即启动并进入等待状态。
+            * 每个工作线程先绑定CPU再创建自己的本地队列，队列的内存落在它所在的NUMA节点上。
+            */
+            explicit WorkerPool(size_t n,const std::vector<int> &cpus={},const int &nice=0):inbox_(inboxCapacity),stop_(false)
+            {
+                workers_.resize(n);
+                for (size_t i = 0; i < n; ++i) {
+                    int cpu=cpus.empty()?-1:cpus[i%cpus.size()];
+                    threads_.emplace_back([this,i,cpu,nice] {
+                        if(cpu>=0)
+                            CPUAffinity::bindThread({cpu});
+                        if(nice!=0)
+                            setpriority(PRIO_PROCESS,(id_t)syscall(SYS_gettid),nice);
+                        workers_[i].reset(new Worker());
+                        ready_.fetch_add(1,std::memory_order_release);
+                        while(ready_.load(std::memory_order_acquire)<workers_.size())
+                            std::this_thread::yield();
+                        this->workerLoop(i);
+                    });
+                }
+                while(ready_.load(std::memory_order_acquire)<n)
+                    std::this_thread::yield();
+            }
+            /**
+            * @brief 析构函数
+            *
+            * 析构时会自动调用 stop()，
+            * 确保所有线程退出并被正确 join。
+            */
+            ~WorkerPool() 
+            {
+                stop();
+            }
+            /**
+            * @brief 向线程池提交一个任务
+            *
+            * @param task 可调用对象，函数签名为 void()
+            *
+            * 外部线程提交的任务进入无锁收件箱（满了则进入溢出队列），
+            * 工作线程自己提交的任务直接进入它的本地队列，随后最多唤醒一个睡眠中的工作线程。
+            */
+            void submit(Task task) 
+            {
+                pending_.fetch_add(1,std::memory_order_relaxed);
+                if(currentPool()==this)
+                {
+                    Worker &w=*workers_[currentIndex()];
+                    std::lock_guard<std::mutex> lk(w.mtx);
+                    w.tasks.push_back(std::move(task));
+                }
+                else if(!inbox_.push(std::move(task)))
+                {
+                    std::lock_guard<std::mutex> lk(overflowMtx_);
+                    overflow_.push_back(std::move(task));
+                    overflowCount_.fetch_add(1,std::memory_order_release);
+                }
+                wakeOne();
+            }
+            /**
+            * @brief 把任务提交到key对应的执行通道（lane）
+            *
+            * @param key 通道的键 同一个key的任务总是落在第key%n个工作线程上
+            * @param task 可调用对象，函数签名为 void()
+            *
+            * 每个工作线程有一条自己的通道，通道里的任务只由这个线程按提交顺序依次执行，不会被其他线程窃取。
+            * 同一个key（比如同一个连接）的任务因此串行执行并且总在同一个线程上，不同key的任务仍然并行；
+            * 代价是通道里的长任务会推迟同一通道后面的任务。
+            */
+            void submitTo(uint64_t key,Task task)
+            {
+                if(workers_.empty())
+                {
+                    submit(std::move(task));
+                    return;
+                }
+                Worker &w=*workers_[key%workers_.size()];
+                w.lanePending.fetch_add(1,std::memory_order_relaxed);
+                // 溢出队列里还有任务时后面的任务也进溢出队列，保持先后顺序
+                if(w.laneOverflowCount.load(std::memory_order_acquire)!=0||!w.lane.push(std::move(task)))
+                {
+                    std::lock_guard<std::mutex> lk(w.laneMtx);
+                    w.laneOverflow.push_back(std::move(task));
+                    w.laneOverflowCount.fetch_add(1,std::memory_order_release);
+                }
+                wakeWorker(w);
+            }
+            /**
+             * @brief 停止线程池并等待所有线程退出
+             *
+            * 调用后：
+            * - 不应再提交新的任务
+            * - 已提交但未执行的任务会被执行完
+            * - 所有工作线程都会退出并 join
+            *
+            * 该函数可安全重复调用。
+            */
+            void stop() 
+            {
+                stop_.store(true,std::memory_order_release);
+                for(auto &w:workers_)
+                    wakeWorker(*w);
+                for (auto &t : threads_) 
+                {
+                    if (t.joinable()) t.join();
+                }
+            }
+
+        private:
+            static constexpr size_t inboxCapacity=4096;
+            static constexpr size_t inboxBatch=32;
+            static constexpr size_t laneCapacity=1024;
+            static constexpr int idleSpinRounds=64;
+
+            // 每个工作线程一份，独占 cache line；本线程从队头取，窃取者从队尾拿
+            struct alignas(64) Worker
+            {
+                std::mutex mtx;
+                std::deque<Task> tasks;
+                Task batch[inboxBatch];
+                // 只由这个线程执行的有序通道，满了进溢出队列
+                MPSCQueue<Task> lane{laneCapacity};
+                std::mutex laneMtx;
+                std::deque<Task> laneOverflow;
+                std::atomic<size_t> laneOverflowCount{0};
+                std::atomic<size_t> lanePending{0};
+                std::atomic<uint32_t> parked{0};
+            };
+
+            static WorkerPool*& currentPool()
+            {
+                thread_local WorkerPool *pool=nullptr;
+                return pool;
+            }
+            static size_t& currentIndex()
+            {
+                thread_local size_t index=0;
+                return index;
+            }
+
+            /**
+            * @brief 工作线程主循环
+            *
+            * 每个工作线程都会执行此函数：
+            * - 依次从自己的通道、本地队列、收件箱、其他线程的本地队列取任务
+            * - 执行任务
+            * - 还有未执行的任务时让出 CPU 重试，否则短暂自旋后睡在 futex 上
+            *
+            * 当 stop_ 为 true 且没有未执行的任务时，线程退出。
+            */
+            void workerLoop(size_t self) 
+            {
+                currentPool()=this;
+                currentIndex()=self;
+                Worker &w=*workers_[self];
+                Task task;
+                int idle=0;
+                while (true) 
+                {
+                    if(takeLane(w,task))
+                    {
+                        w.lanePending.fetch_sub(1,std::memory_order_relaxed);
+                        task();
+                        task=nullptr;
+                        idle=0;
+                        continue;
+                    }
+                    if(takeTask(self,task))
+                    {
+                        pending_.fetch_sub(1,std::memory_order_relaxed);
+                        task(); // 执行任务
+                        task=nullptr;
+                        idle=0;
+                        continue;
+                    }
+                    if(pending_.load(std::memory_order_acquire)>0||w.lanePending.load(std::memory_order_acquire)>0||++idle<idleSpinRounds)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    if(stop_.load(std::memory_order_acquire))
+                        return;
+                    park(w);
+                    idle=0;
+                }
+            }
+            // 溢出队列只在通道空了之后才取，和submitTo配合保持提交顺序
+            bool takeLane(Worker &w,Task &task)
+            {
+                if(w.lane.pop(task))
+                    return true;
+                if(w.laneOverflowCount.load(std::memory_order_acquire)==0)
+                    return false;
+                std::lock_guard<std::mutex> lk(w.laneMtx);
+                if(w.laneOverflow.empty())
+                    return false;
+                task=std::move(w.laneOverflow.front());
+                w.laneOverflow.pop_front();
+                w.laneOverflowCount.fetch_sub(1,std::memory_order_release);
+                return true;
+            }
+            bool takeTask(size_t self,Task &task)
+            {
+                Worker &w=*workers_[self];
+                {
+                    std::lock_guard<std::mutex> lk(w.mtx);
+                    if(!w.tasks.empty())
+                    {
+                        task=std::move(w.tasks.front());
+                        w.tasks.pop_front();
+                        return true;
+                    }
+                }
+                return drainInbox(w,task)||steal(self,task);
+            }
+            // 收件箱是单消费者队列，同一时刻只允许一个工作线程搬运
+            bool drainInbox(Worker &w,Task &task)
+            {
+                size_t n=0;
+                if(!inboxBusy_.exchange(true,std::memory_order_acquire))
+                {
+                    n=inbox_.pop_bulk(w.batch,inboxBatch);
+                    inboxBusy_.store(false,std::memory_order_release);
+                }
+                if(n==0&&overflowCount_.load(std::memory_order_acquire)>0)
+                {
+                    std::lock_guard<std::mutex> lk(overflowMtx_);
+                    while(n<inboxBatch&&!overflow_.empty())
+                    {
+                        w.batch[n++]=std::move(overflow_.front());
+                        overflow_.pop_front();
+                    }
+                    overflowCount_.fetch_sub(n,std::memory_order_relaxed);
+                }
+                if(n==0)
+                    return false;
+                task=std::move(w.batch[0]);
+                if(n>1)
+                {
+                    {
+                        std::lock_guard<std::mutex> lk(w.mtx);
+                        for(size_t i=1;i<n;++i)
+                            w.tasks.push_back(std::move(w.batch[i]));
+                    }
+                    // 手上多出来的任务让其他睡眠的线程来窃取
+                    wakeOne();
+                }
+                return true;
+            }
+            // 从其他工作线程的队尾窃取一半任务，拿不到锁就跳过，不在窃取上阻塞
+            bool steal(size_t self,Task &task)
+            {
+                Worker &w=*workers_[self];
+                size_t n=workers_.size();
+                for(size_t k=1;k<n;++k)
+                {
+                    Worker &victim=*workers_[(self+k)%n];
+                    std::unique_lock<std::mutex> lk(victim.mtx,std::try_to_lock);
+                    if(!lk.owns_lock()||victim.tasks.empty())
+                        continue;
+                    size_t take=std::min((victim.tasks.size()+1)/2,inboxBatch);
+                    for(size_t i=0;i<take;++i)
+                    {
+                        w.batch[i]=std::move(victim.tasks.back());
+                        victim.tasks.pop_back();
+                    }
+                    lk.unlock();
+                    // batch 里是倒序的，先执行最早提交的那个
+                    task=std::move(w.batch[take-1]);
+                    if(take>1)
+                    {
+                        std::lock_guard<std::mutex> own(w.mtx);
+                        for(size_t i=take-1;i-->0;)
+                            w.tasks.push_back(std::move(w.batch[i]));
+                    }
+                    return true;
+                }
+                return false;
+            }
+            // 先登记为睡眠者再检查有没有任务，和 wakeOne/wakeWorker 里"先发布任务再检查睡眠者"配对，保证不漏唤醒
+            void park(Worker &w)
+            {
+                w.parked.store(1,std::memory_order_relaxed);
+                sleepers_.fetch_add(1,std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(pending_.load(std::memory_order_relaxed)==0&&w.lanePending.load(std::memory_order_relaxed)==0&&!stop_.load(std::memory_order_relaxed))
+                    syscall(SYS_futex,reinterpret_cast<uint32_t*>(&w.parked),FUTEX_WAIT_PRIVATE,1,nullptr,nullptr,0);
+                w.parked.store(0,std::memory_order_relaxed);
+                sleepers_.fetch_sub(1,std::memory_order_relaxed);
+            }
+            bool wakeWorker(Worker &w)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(w.parked.load(std::memory_order_relaxed)==0||w.parked.exchange(0)==0)
+                    return false;
+                syscall(SYS_futex,reinterpret_cast<uint32_t*>(&w.parked),FUTEX_WAKE_PRIVATE,1,nullptr,nullptr,0);
+                return true;
+            }
+            // 共享的任务谁都能做 叫醒任意一个睡着的线程
+            void wakeOne()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(sleepers_.load(std::memory_order_relaxed)==0)
+                    return;
+                for(auto &w:workers_)
+                {
+                    if(wakeWorker(*w))
+                        return;
+                }
+            }
+
+        private:
+            std::vector<std::unique_ptr<Worker>> workers_;
+            std::vector<std::thread> threads_;
+            MPSCQueue<Task> inbox_;
+            alignas(64) std::atomic<bool> inboxBusy_{false};
+            std::mutex overflowMtx_;
+            std::deque<Task> overflow_;
+            std::atomic<size_t> overflowCount_{0};
+            alignas(64) std::atomic<long> pending_{0};
+            alignas(64) std::atomic<int> sleepers_{0};
+            std::atomic<bool> stop_;
+            std::atomic<size_t> ready_{0};
+        };
+    }
+    
+}
+
+
+#endif
+
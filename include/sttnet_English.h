@@ -40,6 +40,7 @@
 #include<unordered_map>
 #include <openssl/ssl.h>
 #include <openssl/err.h>
+#include<openssl/rand.h>
 #include<openssl/crypto.h>
 #include<signal.h>
 #include<sys/ipc.h>
@@ -55,6 +56,19 @@
 #include <cstdint>
 #include <new>
 #include <vector>
+#include <memory>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#include <linux/futex.h>
+#include <deque>
+#include <poll.h>
+#include <sys/uio.h>
+#include <sys/sendfile.h>
+#include <sys/un.h>
+#include <netinet/tcp.h>
+#include <spawn.h>
+#include <sys/resource.h>
 /**
 * @namespace stt
 */
@@ -93,9 +107,16 @@ namespace stt
 template <typename T>
 class MPSCQueue {
 public:
-    explicit MPSCQueue(std::size_t capacity_pow2)
+    /**
+     * @param capacity_pow2 capacity, must be a power of two
+     *        容量（必须为 2 的幂）
+     * @param blocking true: enable wait_pop(); every push then checks whether the consumer is asleep and wakes it
+     *        true：开启 wait_pop()，之后每次 push 都会检查消费者是否睡眠并唤醒它（默认为 false）
+     */
+    explicit MPSCQueue(std::size_t capacity_pow2, bool blocking = false)
         : capacity_(capacity_pow2),
           mask_(capacity_pow2 - 1),
+          blocking_(blocking),
           buffer_(capacity_pow2),
           head_(0),
           tail_(0)
@@ -163,6 +184,71 @@ public:
         return true;
     }
 
+    /**
+     * @brief Pop up to max items in one call (single consumer). Returns the number popped.
+     *        批量出队（单消费者），一次最多取 max 个，返回取到的个数
+     *
+     * Stops at the first slot that is not ready yet, so items keep FIFO order.
+     * 遇到第一个还没发布的槽就停止，保持先进先出
+     */
+    std::size_t pop_bulk(T* out, std::size_t max) noexcept(std::is_nothrow_move_assignable_v<T>)
+    {
+        std::size_t n = 0;
+        while (n < max) {
+            Slot& slot = buffer_[head_ & mask_];
+            if (slot.seq.load(std::memory_order_acquire) != head_ + 1)
+                break;
+            out[n++] = std::move(*slot.ptr());
+            slot.destroy();
+            slot.seq.store(head_ + capacity_, std::memory_order_release);
+            ++head_;
+        }
+        return n;
+    }
+
+    /**
+     * @brief Pop, blocking up to timeout_ms when empty (single consumer, blocking mode only).
+     *        阻塞出队（单消费者，仅 blocking 模式），队列空时最多等待 timeout_ms 毫秒（<0 表示一直等）
+     * @return true if an item was popped, false on timeout
+     *
+     * Spins briefly first, then sleeps on a futex that producers only signal while the consumer is asleep.
+     * 先短暂自旋，再睡在 futex 上；只有消费者睡着时生产者才会发起唤醒
+     */
+    bool wait_pop(T& out, int timeout_ms = -1)
+    {
+        for (int spin = 0; spin < 64; ++spin) {
+            if (pop(out))
+                return true;
+            std::this_thread::yield();
+        }
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout_ms < 0 ? 0 : timeout_ms);
+        for (;;) {
+            sleeping_.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (pop(out)) {
+                sleeping_.store(0, std::memory_order_relaxed);
+                return true;
+            }
+            struct timespec ts;
+            struct timespec *tsp = nullptr;
+            if (timeout_ms >= 0) {
+                auto left = deadline - std::chrono::steady_clock::now();
+                if (left <= std::chrono::steady_clock::duration::zero()) {
+                    sleeping_.store(0, std::memory_order_relaxed);
+                    return false;
+                }
+                auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(left).count();
+                ts.tv_sec = ns / 1000000000;
+                ts.tv_nsec = ns % 1000000000;
+                tsp = &ts;
+            }
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sleeping_), FUTEX_WAIT_PRIVATE, 1, tsp, nullptr, 0);
+            sleeping_.store(0, std::memory_order_relaxed);
+            if (pop(out))
+                return true;
+        }
+    }
+
     /**
      * @brief Approximate size (may be inaccurate under concurrency)
      *        近似长度（并发下可能不精确）
@@ -216,6 +302,8 @@ private:
                     slot.construct(std::forward<U>(v));
                     // Publish to consumer: seq = pos+1 means "ready"
                     slot.seq.store(pos + 1, std::memory_order_release);
+                    if (blocking_)
+                        wake_consumer();
                     return true;
                 }
                 // CAS failed: pos updated with current tail; retry
@@ -229,16 +317,123 @@ private:
         }
     }
 
+    // Pairs with the consumer's "mark asleep, then re-check" in wait_pop
+    // 和 wait_pop 里"先标记睡眠再检查"配对，保证不漏唤醒
+    void wake_consumer() noexcept {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping_.load(std::memory_order_relaxed) != 0 && sleeping_.exchange(0) != 0)
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&sleeping_), FUTEX_WAKE_PRIVATE, 1, nullptr, nullptr, 0);
+    }
+
 private:
+    // Read-mostly, shared by everyone
     const std::size_t capacity_;
     const std::size_t mask_;
+    const bool blocking_;
     std::vector<Slot> buffer_;
 
-    // Single consumer only
-    std::size_t head_;
+    // Single consumer only; own cache line so producers' CAS on tail_ does not invalidate it
+    // 单消费者独占一条 cache line，生产者 CAS tail_ 时不会连带失效
+    alignas(64) std::size_t head_;
+    std::atomic<uint32_t> sleeping_{0};
 
     // Multi-producer
-    std::atomic<std::size_t> tail_;
+    alignas(64) std::atomic<std::size_t> tail_;
+    char pad_[64 - sizeof(std::atomic<std::size_t>)];
+};
+
+/**
+ * @brief Lock-free bounded SPSC queue (Single-Producer Single-Consumer)
+ *        无锁有界单生产者单消费者队列（环形缓冲）
+ *
+ * - Exactly ONE thread may push and ONE thread may pop.
+ * - 只允许一个线程 push、一个线程 pop
+ *
+ * Design:
+ * - Slots are constructed once and reused by move-assignment
+ * - head/tail live on separate cache lines; each side caches the other's index
+ *   and only reloads it when the ring looks full/empty
+ *
+ * 特点：
+ * - 生产者和消费者各自只写自己的下标，没有 CAS
+ * - 适合每个线程一个的暂存队列
+ *
+ * IMPORTANT:
+ *  ❗ Capacity must be a power of two.
+ *
+ * 重要：
+ *  ❗ 容量必须是 2 的幂
+ */
+template <typename T>
+class SPSCQueue {
+public:
+    explicit SPSCQueue(std::size_t capacity_pow2)
+        : capacity_(capacity_pow2),
+          mask_(capacity_pow2 - 1),
+          buffer_(capacity_pow2)
+    {
+        if (capacity_ < 2 || (capacity_ & mask_) != 0) {
+            throw std::invalid_argument("SPSCQueue capacity must be power of two and >= 2");
+        }
+    }
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * @brief Try push (producer thread only). Returns false if queue is full.
+     *        尝试入队（仅生产者线程），队列满则返回 false
+     */
+    bool push(T&& v) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const std::size_t t = tail_.load(std::memory_order_relaxed);
+        if (t - headCache_ == capacity_) {
+            headCache_ = head_.load(std::memory_order_acquire);
+            if (t - headCache_ == capacity_)
+                return false;
+        }
+        buffer_[t & mask_] = std::move(v);
+        tail_.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Try pop (consumer thread only). Returns false if empty.
+     *        尝试出队（仅消费者线程），空则返回 false
+     */
+    bool pop(T& out) noexcept(std::is_nothrow_move_assignable_v<T>) {
+        const std::size_t h = head_.load(std::memory_order_relaxed);
+        if (h == tailCache_) {
+            tailCache_ = tail_.load(std::memory_order_acquire);
+            if (h == tailCache_)
+                return false;
+        }
+        out = std::move(buffer_[h & mask_]);
+        head_.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Approximate size (may be inaccurate under concurrency)
+     *        近似长度（并发下可能不精确）
+     */
+    std::size_t approx_size() const noexcept {
+        const std::size_t t = tail_.load(std::memory_order_acquire);
+        const std::size_t h = head_.load(std::memory_order_acquire);
+        return (t >= h) ? (t - h) : 0;
+    }
+
+private:
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    std::vector<T> buffer_;
+
+    // Consumer side
+    alignas(64) std::atomic<std::size_t> head_{0};
+    std::size_t tailCache_ = 0;
+
+    // Producer side
+    alignas(64) std::atomic<std::size_t> tail_{0};
+    std::size_t headCache_ = 0;
 };
 
     }
@@ -1029,6 +1224,7 @@ private:
     static Milliseconds& DTOd(const Duration &D1, Milliseconds& d1);
     static std::string &toPGtimeFormat();
     static std::chrono::system_clock::time_point strToTimePoint(const std::string &timeStr, const std::string &format = ISO8086A);
+protected:
     static std::string& timePointToStr(const std::chrono::system_clock::time_point &tp, std::string &timeStr, const std::string &format = ISO8086A);
 public:
     /**
@@ -1117,9 +1313,124 @@ public:
 namespace file
 {
 /**
+* @brief Log level
+* @note Levels go from low to high; a log object only writes entries at or above its own level
+*/
+enum class LogLevel
+{
+    TRACE = 0, ///< Per-event / per-read details (e.g. data received, heartbeats)
+    DEBUG = 1, ///< Per-connection / per-request processing (e.g. new connection, request result)
+    INFO = 2,  ///< Startup, shutdown and other runtime state (default level)
+    WARN = 3,  ///< Security rejections, full queues and other conditions worth attention
+    ERROR = 4, ///< Server-level failures such as listen or accept errors
+    OFF = 5    ///< Logging disabled
+};
+/**
+* @brief Log durability (fsync) policy
+*/
+enum class LogSyncPolicy
+{
+    NEVER = 0,     ///< Only write to the kernel; the OS decides when to flush to disk (default)
+    PER_BATCH = 1, ///< fdatasync after every written batch
+    INTERVAL = 2   ///< fdatasync after the next batch once the configured interval has elapsed since the last sync
+};
+/**
+* @brief Format descriptor of a binary log entry
+* @note One static object per call site (generated by the STT_LOG_BIN macro); its address is the format id
+*/
+struct LogFormat
+{
+    const char *format; ///< Format string, {} is the argument placeholder
+    LogLevel level;     ///< Log level
+};
+/**
+* @brief Fixed-size binary log record
+* @note The call site only records the format id, a raw timestamp and the arguments; string arguments are copied into a fixed buffer inside the record (truncated if too long), so enqueuing does not allocate
+* @note The consumer thread formats the record according to the format string and writes it to the log file
+*/
+struct LogRecord
+{
+    static constexpr int MAX_ARGS = 6;      ///< Maximum number of arguments
+    static constexpr int TEXT_BYTES = 48;   ///< Buffer shared by all string arguments
+    enum ArgType : uint8_t { INT = 0, UINT = 1, DOUBLE = 2, STRING = 3, BOOL = 4, CHAR = 5 };
+    const LogFormat *fmt = nullptr;
+    int64_t timestamp = 0; ///< Nanoseconds of system_clock
+    uint8_t argc = 0;
+    uint8_t types[MAX_ARGS];
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        struct { uint16_t off; uint16_t len; } s;
+    } args[MAX_ARGS];
+    uint16_t textUsed = 0;
+    char text[TEXT_BYTES];
+    /**
+    * @brief Append an argument
+    * @param v Argument; integers, floating point, bool, char, const char*, std::string and std::string_view are supported
+    */
+    template<class T>
+    void add(const T &v)
+    {
+        using U = std::decay_t<T>;
+        if constexpr (std::is_same_v<U, bool>)
+        {
+            types[argc] = BOOL;
+            args[argc++].u = v;
+        }
+        else if constexpr (std::is_same_v<U, char>)
+        {
+            types[argc] = CHAR;
+            args[argc++].i = v;
+        }
+        else if constexpr (std::is_integral_v<U> && std::is_signed_v<U>)
+        {
+            types[argc] = INT;
+            args[argc++].i = v;
+        }
+        else if constexpr (std::is_integral_v<U> || std::is_enum_v<U>)
+        {
+            types[argc] = UINT;
+            args[argc++].u = (uint64_t)v;
+        }
+        else if constexpr (std::is_floating_point_v<U>)
+        {
+            types[argc] = DOUBLE;
+            args[argc++].d = v;
+        }
+        else
+        {
+            addText(std::string_view(v));
+        }
+    }
+    void addText(const std::string_view &v)
+    {
+        size_t len = v.size();
+        if (len > (size_t)(TEXT_BYTES - textUsed))
+            len = TEXT_BYTES - textUsed;
+        memcpy(text + textUsed, v.data(), len);
+        types[argc] = STRING;
+        args[argc].s.off = textUsed;
+        args[argc++].s.len = len;
+        textUsed += len;
+    }
+};
+/**
+* @brief Statistics of a single logging thread
+*/
+struct LogThreadStat
+{
+    std::thread::id thread; ///< Thread id
+    uint64_t written = 0;   ///< Entries that entered the staging queue
+    uint64_t dropped = 0;   ///< Entries dropped because the staging queue was full
+};
+/**
 * @brief Log file operation class
 * @note The log reading/writing of this class is thread-safe due to inheritance from the File class
 * @note Asynchronous logging will use a separate thread for writing operations, allowing multiple threads to operate on the log simultaneously.
+* @note When idle, the writer thread spins briefly and then blocks on an eventfd; it is only woken when new entries are enqueued
+* @note Logs are only appended to the end of the file (O_APPEND + batched writev), so the cost does not depend on the file size
 */
 class LogFile : private time::DateTime, protected file::File
 {
@@ -1129,16 +1440,83 @@ private:
     std::atomic<bool> consumerGuard{true};
     //std::mutex queueMutex;
     //std::condition_variable queueCV;
-    system::MPSCQueue<std::string> logQueue;
+    // One single-producer staging queue per logging thread, so producers no longer contend on one tail
+    struct LogEntry
+    {
+        int64_t timestamp = 0; // Nanoseconds of system_clock; the consumer merges threads by it
+        std::string content;
+    };
+    struct ThreadRing
+    {
+        system::SPSCQueue<LogEntry> queue;
+        std::thread::id thread;
+        // Written only by the owning thread, read by the consumer and the statistics API
+        alignas(64) std::atomic<uint64_t> written{0};
+        std::atomic<uint64_t> dropped{0};
+        explicit ThreadRing(const size_t &cap) : queue(cap) {}
+    };
+    size_t ringCapacity;
+    // Guards rings; locked only on a thread's first log, when retiring exited threads' queues and when querying statistics
+    std::mutex ringMutex;
+    std::vector<std::shared_ptr<ThreadRing>> rings;
+    std::atomic<bool> ringsChanged{false};
+    uint64_t retiredWritten = 0;
+    uint64_t retiredDropped = 0;
+    static std::atomic<uint64_t> nextInstanceId;
+    const uint64_t instanceId = nextInstanceId++;
     std::thread consumerThread;
+    std::atomic<int> level{(int)LogLevel::INFO};
+    // O_APPEND log fd; the consumer thread collects a batch of lines and writes it with a single writev
+    int logFD = -1;
+    // Guards logFD; clearing or deleting logs rewrites the file, so it must exclude writes and reopen afterwards
+    std::mutex writeMutex;
+    std::atomic<int> syncPolicy{(int)LogSyncPolicy::NEVER};
+    std::atomic<int> syncIntervalMs{1000};
+    std::chrono::steady_clock::time_point lastSync;
+    // Segment rotation; all guarded by writeMutex
+    size_t rotateBytes = 0;
+    bool rotateDaily = false;
+    bool compressSegments = false;
+    size_t segmentBytes = 0;
+    int segmentDay = 0;
+    std::string segmentFirst; // Time of the first batch in the current segment; "-" means the file already had content of unknown age when opened
+    std::string segmentLast;
+    // Binary log queue, allocated by enableBinaryLog
+    std::atomic<system::MPSCQueue<LogRecord>*> binQueue{nullptr};
+    // The idle consumer blocks on this eventfd; producers only need to wake it while it is asleep
+    int wakeFD = -1;
+    std::atomic<bool> sleeping{false};
+private:
+    /**
+    * @brief Called after enqueuing; wakes the consumer if it has gone to sleep
+    */
+    void notifyConsumer()
+    {
+        // Pairs with the consumer's "mark asleep, then re-check the queue" so no wakeup is lost
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (sleeping.load(std::memory_order_relaxed) && sleeping.exchange(false))
+        {
+            uint64_t one = 1;
+            if (::write(wakeFD, &one, sizeof(one)) < 0) {}
+        }
+    }
+    ThreadRing *threadRing();
+    bool pushEntry(std::string &&content);
+    void formatEntry(const LogEntry &e, std::string &line, std::string &time);
+    void retireRings();
+    void formatRecord(const LogRecord &r, std::string &line, std::string &time);
+    void consumer();
+    void writeBatch(std::vector<std::string> &batch, const size_t &n);
+    bool reopenLogFD();
+    void rotate(const std::string &now);
 public:
     /**
 
 * @brief Constructor, initializes the consumer thread
 
-* @param logQueue_cap Asynchronous log queue capacity (must be a power of 2).
+* @param logQueue_cap Staging queue capacity of each logging thread (must be a power of 2).
 
-// // Logs generated by all threads will first enter this lock-free queue, and then be written to the file in batches by an independent logger thread.
+// // Logs generated by each thread first enter that thread's own lock-free staging queue; an independent logger thread drains them round-robin, merges them by timestamp and writes them to the file in batches.
 
 // The logging system is not on the main business hot path, allowing logs to be discarded during overload to protect the performance of core services.
 
@@ -1154,31 +1532,19 @@ public:
 // - High-frequency logs: 16384 (~16k)
 
 //
-// When the queue is full: logs will be discarded, and the framework will not block the calling thread.
+// When the queue is full: logs will be discarded, and the framework will not block the calling thread; drops are counted per thread (see getThreadStats).
 
 //
 */
-    LogFile(const size_t &logQueue_cap=8192):logQueue(logQueue_cap)
+    LogFile(const size_t &logQueue_cap=8192):ringCapacity(logQueue_cap)
     {
+        if(logQueue_cap<2||(logQueue_cap&(logQueue_cap-1))!=0)
+            throw std::invalid_argument("LogFile queue capacity must be power of two and >= 2");
         consumerGuard=true;
+        wakeFD=eventfd(0,EFD_CLOEXEC|EFD_NONBLOCK);
         consumerThread = std::thread([this]()->void
         {
-            std::string content;
-            content.reserve(1024);
-            std::string time;
-            content.reserve(1074);
-            while(this->consumerGuard)
-            {
-                while(this->logQueue.pop(content))//非空则执行
-                {       
-                    getTime(time,timeFormat);
-                    time+=contentFormat;
-                    time+=content;
-                    this->appendLine(time);
-                }
-                std::this_thread::sleep_for(std::chrono::microseconds(500));
-
-            }
+            this->consumer();
         });
     }
     /**
@@ -1210,9 +1576,34 @@ public:
     /**
     * @brief Write a line of log
     * @param data Content to be written to the log
+    * @note Written at INFO level
     */
     void writeLog(const std::string &data);
     /**
+    * @brief Write a line of log at a given level
+    * @param data Content to be written to the log
+    * @param level Level of this entry; dropped if below the object's level. Levels other than INFO are prefixed with a [LEVEL] tag
+    */
+    void writeLog(const std::string &data, const LogLevel &level);
+    /**
+    * @brief Set the level of the log object
+    * @param level Entries below this level are not written (default INFO)
+    * @note May be called at any time; thread-safe
+    */
+    void setLevel(const LogLevel &level) { this->level.store((int)level, std::memory_order_relaxed); }
+    /**
+    * @brief Get the level of the log object
+    * @return The current level
+    */
+    LogLevel getLevel() { return (LogLevel)level.load(std::memory_order_relaxed); }
+    /**
+    * @brief Check whether an entry of the given level would be written
+    * @param level Log level
+    * @return true if it would be written, false if it would be dropped
+    * @note Call this before building the log string so that dropped entries cost no string concatenation
+    */
+    bool shouldLog(const LogLevel &level) { return (int)level >= this->level.load(std::memory_order_relaxed); }
+    /**
     * @brief Clear all logs
     * @return true for successful clear, false for failure
     */
@@ -1226,11 +1617,105 @@ public:
     */
     bool deleteLogByTime(const std::string &date1 = "1", const std::string &date2 = "2");
     /**
-    * @brief The destructor writes the log and then closes the consumer thread.
+    * @brief Set the log durability policy
+    * @param policy Sync policy (default NEVER)
+    * @param intervalMs Minimum interval between two fdatasync calls when policy is INTERVAL (milliseconds, default 1000)
+    * @note Closing the file and destruction sync once more unless the policy is NEVER
+    */
+    void setSyncPolicy(const LogSyncPolicy &policy, const int &intervalMs = 1000) { syncIntervalMs = intervalMs; syncPolicy = (int)policy; }
+    /**
+    * @brief Enable log segment rotation
+    * @param maxBytes Switch to a new segment once the current one reaches this size (bytes, 0 disables size-based rotation)
+    * @param daily true to switch to a new segment when the date changes, false to not rotate by date (default false)
+    * @param compress true to gzip rotated segments in the background, false to leave them uncompressed (default false)
+    * @note Rotated segments are renamed to <log file name>.yyyymmdd-hhmiss; the index file <log file name>.index in the same directory records one segment per line with its file name and time range
+    * @note Once enabled, deleteLogByTime only affects the current segment; use purgeSegments to delete history by whole files
+    */
+    void setRotation(const size_t &maxBytes, const bool &daily = false, const bool &compress = false);
+    /**
+    * @brief Delete every rotated segment whose last entry is older than the given time
+    * @param date Time string in the same format as the timeFormat passed to openFile
+    * @return Number of segments deleted, -1 if the index could not be read
+    * @note Only reads/writes the index and deletes whole segment files, so the cost depends only on the number of segments
+    */
+    int purgeSegments(const std::string &date);
+    /**
+    * @brief Get statistics for every thread that has written logs
+    * @return One entry per thread; threads that have exited are not listed (they are counted in getDroppedCount)
+    */
+    std::vector<LogThreadStat> getThreadStats();
+    /**
+    * @brief Get the total number of entries dropped because a staging queue was full
+    * @return Sum of drops over all threads, including threads that have exited
+    */
+    uint64_t getDroppedCount();
+    /**
+    * @brief Enable binary logging mode
+    * @param queueCap Binary log queue capacity (must be a power of 2, default 4096)
+    * @return true if enabled (or already enabled), false if the capacity is invalid
+    * @note Must be called before any thread calls writeLogBinary
+    */
+    bool enableBinaryLog(const size_t &queueCap = 4096);
+    /**
+    * @brief Write a binary log entry
+    * @param fmt Format descriptor (usually a static object generated by the STT_LOG_BIN macro)
+    * @param args Arguments, at most LogRecord::MAX_ARGS
+    * @return true if enqueued, false if binary mode is off, the level is filtered or the queue is full (entry dropped)
+    * @note The call site only checks the level, takes a timestamp and copies the arguments into a fixed-size record; no string is built and nothing is allocated. Formatting happens in the consumer thread
+    */
+    template<class... Args>
+    bool writeLogBinary(const LogFormat &fmt, const Args&... args)
+    {
+        static_assert(sizeof...(Args) <= LogRecord::MAX_ARGS, "too many arguments for one binary log record");
+        system::MPSCQueue<LogRecord> *q = binQueue.load(std::memory_order_acquire);
+        if (q == nullptr || !shouldLog(fmt.level))
+            return false;
+        LogRecord r;
+        r.fmt = &fmt;
+        r.timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+        (r.add(args), ...);
+        if (!q->push(r))
+            return false;
+        notifyConsumer();
+        return true;
+    }
+    /**
+    * @brief The destructor writes the remaining queued logs and then closes the consumer thread.
     */
     ~LogFile();
 };
 }
+/**
+* @def STT_LOG_MIN_LEVEL
+* @brief Compile-time minimum log level. STT_LOG calls below it are removed at compile time and cost nothing at runtime
+* @note Values match stt::file::LogLevel: 0:TRACE 1:DEBUG 2:INFO 3:WARN 4:ERROR 5:OFF
+* @note Defaults to 0, i.e. everything is compiled in and filtered by the log object's runtime level; production builds can use -DSTT_LOG_MIN_LEVEL=2 to strip the framework's TRACE and DEBUG hot-path logs
+*/
+#ifndef STT_LOG_MIN_LEVEL
+#define STT_LOG_MIN_LEVEL 0
+#endif
+/**
+* @def STT_LOG(level,zh,en)
+* @brief Write a bilingual log entry at a given level
+* @param level Log level, stt::file::LogLevel
+* @param zh Content written when the language is Chinese
+* @param en Content written for any other language
+* @note The level is first compared against STT_LOG_MIN_LEVEL at compile time, then ServerSetting::logfile and its runtime level are checked; only after both pass is the language compared and the log string built
+*/
+#define STT_LOG(level,zh,en) do{ if constexpr((int)(level)>=STT_LOG_MIN_LEVEL){ if(stt::system::ServerSetting::logfile!=nullptr&&stt::system::ServerSetting::logfile->shouldLog(level)){ if(stt::system::ServerSetting::language=="Chinese") stt::system::ServerSetting::logfile->writeLog(zh,level); else stt::system::ServerSetting::logfile->writeLog(en,level); } } }while(0)
+/**
+* @def STT_LOG_BIN(logfile,level,format,...)
+* @brief Write a log entry in binary mode
+* @param logfile Log object pointer; enableBinaryLog must have been called
+* @param level Log level, stt::file::LogLevel
+* @param format Format string literal, {} is the argument placeholder
+* @note Each call site gets a static LogFormat that serves as the format id; also subject to compile-time filtering by STT_LOG_MIN_LEVEL
+*
+* @code
+* STT_LOG_BIN(lf,stt::file::LogLevel::INFO,"fd={} read {} bytes",fd,n);
+* @endcode
+*/
+#define STT_LOG_BIN(logfile,level,format,...) do{ if constexpr((int)(level)>=STT_LOG_MIN_LEVEL){ static const stt::file::LogFormat stt_log_format_{format,level}; (logfile)->writeLogBinary(stt_log_format_,##__VA_ARGS__); } }while(0)
     /**
     * @namespace stt::data
     * @brief Data processing
@@ -2363,6 +2848,10 @@ public:
      */
     bool connectionDetect(const std::string &ip, const int &fd);
     /**
+     * @brief Idle timeout in seconds used for zombie detection; < 0 means disabled.
+     */
+    int getConnectionTimeout() const{return connectionTimeout;}
+    /**
  * @brief Immediately add the specified IP to the blacklist (direct ban).
  *
  * @details
@@ -2437,7 +2926,9 @@ private:
     // IP -> unban time
     std::unordered_map<std::string, std::chrono::steady_clock::time_point> blacklist;
 
-    inline void logSecurity(const std::string &msgCN, const std::string &msgEN);
+    // accessed concurrently by the acceptor and every reactor thread in multi-reactor mode
+    mutable std::mutex mtx;
+
 };
 
     }
@@ -2449,6 +2940,200 @@ private:
     */
     namespace network
     {
+    /**
+    * @brief Cache of open handles and metadata of static files
+    * @note Caches the open fd, size, modification time, ETag and Last-Modified per path, so requests for the same file do not open/fstat it every time. Least recently used entries are evicted once the capacity is exceeded.
+    * @note An entry is re-stat'ed at most once every CHECK_INTERVAL milliseconds and reopened when the file was replaced or modified.
+    * @note Entries are held by shared_ptr: a response still being sent keeps the old fd after eviction and it is closed when done. All members are static, one cache is shared by the whole process, and it is thread-safe.
+    */
+    class FileCache
+    {
+    public:
+        /**
+        * @brief Minimum interval between two stat checks (milliseconds)
+        */
+        static constexpr int CHECK_INTERVAL=1000;
+        /**
+        * @brief A cached file
+        */
+        struct Entry
+        {
+            /**
+            * @brief fd opened read-only
+            */
+            int fd=-1;
+            /**
+            * @brief file size (bytes)
+            */
+            uint64_t size=0;
+            /**
+            * @brief modification time
+            */
+            time_t mtime=0;
+            /**
+            * @brief inode number, used to notice a replaced file
+            */
+            ino_t ino=0;
+            /**
+            * @brief ETag (with double quotes)
+            */
+            std::string etag;
+            /**
+            * @brief value of Last-Modified (HTTP date)
+            */
+            std::string lastModified;
+            /**
+            * @brief time of the last stat check
+            */
+            std::chrono::steady_clock::time_point checked;
+            ~Entry(){if(fd!=-1)::close(fd);}
+        };
+    private:
+        static std::mutex lc;
+        static std::list<std::pair<std::string,std::shared_ptr<Entry>>> lru;
+        static std::unordered_map<std::string,std::list<std::pair<std::string,std::shared_ptr<Entry>>>::iterator> table;
+        static size_t capacity;
+    public:
+        /**
+        * @brief Get the cache entry of a regular file
+        * @param path file path
+        * @return the entry; nullptr if the file does not exist, is not a regular file or cannot be opened
+        */
+        static std::shared_ptr<Entry> get(const std::string &path);
+        /**
+        * @brief Set how many files are cached at most (default 256)
+        */
+        static void setCapacity(const size_t &capacity);
+        /**
+        * @brief Number of files currently cached
+        */
+        static size_t size();
+        /**
+        * @brief Empty the cache
+        */
+        static void clear();
+    };
+
+    /**
+    * @brief Non-blocking output queue of a connection
+    * @note Sending first writes to the socket directly. Whatever cannot be written (EAGAIN or TLS WANT_WRITE) is queued in order, and watchFun asks the reactor to watch the socket for writability (EPOLLOUT). When it becomes writable the reactor calls flush to continue, and stops watching once the queue is empty. The sending thread never blocks or spins on a slow peer.
+    * @note Once the backlog reaches the high-water mark isWritable returns false until flush brings it below the low-water mark, so handlers can pause producing data (backpressure).
+    * @note Thread-safe: worker threads may write while the reactor thread flushes.
+    */
+    class OutputBuffer
+    {
+    private:
+        int fd;
+        std::mutex lo;
+        struct Chunk
+        {
+            std::string data;
+            std::shared_ptr<FileCache::Entry> file;//不为空时这一块是文件的一段
+            uint64_t fileOffset=0;
+            uint64_t fileLength=0;
+            Chunk(const char *data,const size_t &length):data(data,length){}
+            Chunk(std::string &&data):data(std::move(data)){}
+            Chunk(const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length):file(file),fileOffset(offset),fileLength(length){}
+        };
+        std::deque<Chunk> chunks;
+        size_t offset=0;
+        std::atomic<size_t> bytes{0};
+        size_t highWater;
+        size_t lowWater;
+        std::atomic<bool> overHigh{false};
+        bool watching=false;
+        bool closing=false;
+        bool closed=false;
+        bool ktls=false;//the send direction has been handed to kernel TLS
+        std::function<void(const bool &on)> watchFun;
+        static constexpr int IOV_BATCH=64;//maximum segments per sendmsg
+        static constexpr size_t TLS_BATCH=16384;//under TLS, segments up to this total size are joined into one record
+    private:
+        int sendSome(SSL *ssl,const char *data,const size_t &length,size_t &sent);
+        int sendSomeV(SSL *ssl,const struct iovec *iov,const int &iovcnt,size_t &sent,const int &flags=0);
+        int drain(SSL *ssl);
+    public:
+        static constexpr size_t FILE_PIECE=65536;//under TLS, files are read and sent in pieces of this size
+        /**
+        * @brief Constructor
+        * @param fd socket
+        * @param watchFun switches writability watching: true starts watching EPOLLOUT, false stops
+        * @param highWater high-water mark in bytes; isWritable returns false once the backlog reaches it (default 4MB)
+        * @param lowWater low-water mark in bytes; isWritable returns true again once the backlog drops below it (default 1MB)
+        */
+        OutputBuffer(const int &fd,const std::function<void(const bool &on)> &watchFun,const size_t &highWater=4*1024*1024,const size_t &lowWater=1024*1024):fd(fd),highWater(highWater),lowWater(lowWater),watchFun(watchFun){}
+        /**
+        * @brief Send data
+        * @note With an empty queue the data is sent directly and the rest is queued; with a non-empty queue it is queued directly so ordering is kept
+        * @param ssl TLS handle (nullptr if none)
+        * @param data data
+        * @param length data length
+        * @return bytes accepted (sent plus queued, always equal to length); -1: connection error or already closed
+        */
+        int write(SSL *ssl,const char *data,const size_t &length);
+        /**
+        * @brief Send several segments of data
+        * @note Like write, but segments (e.g. response headers and body) are not concatenated first: plain sockets send them with one sendmsg, TLS joins small segments into one record and writes large ones one by one; only the unsent part is copied into the queue
+        * @param ssl TLS handle (nullptr if none)
+        * @param iov segment array
+        * @param iovcnt number of segments
+        * @return bytes accepted (always the total length of the segments); -1: connection error or already closed
+        */
+        int writev(SSL *ssl,const struct iovec *iov,const int &iovcnt);
+        /**
+        * @brief Send some data (e.g. response headers) followed by a range of a file
+        * @note File data does not pass through user space: plain sockets use sendfile from the file to the socket; under TLS at most 64KB is pread at a time and then encrypted, so memory use is bounded
+        * @param ssl TLS handle (nullptr if none)
+        * @param head data to send before the file (e.g. HTTP response headers), may be empty
+        * @param file file cache entry
+        * @param offset start position in the file
+        * @param length number of bytes to send
+        * @return bytes accepted (length of head plus length); -1: connection error or already closed
+        */
+        int writeFile(SSL *ssl,const std::string &head,const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length);
+        /**
+        * @brief Mark the send direction as encrypted by kernel TLS (kTLS)
+        * @note Once marked, plain data is gathered into sendmsg and files go through SSL_sendfile; the kernel builds the TLS records and SSL_write is no longer used
+        * @param on true: enable
+        */
+        void setKernelTLS(const bool &on){std::lock_guard<std::mutex> lock(lo);ktls=on;}
+        /**
+        * @brief Whether the send direction is encrypted by kernel TLS
+        */
+        bool isKernelTLS(){std::lock_guard<std::mutex> lock(lo);return ktls;}
+        /**
+        * @brief Send as much queued data as possible
+        * @note Called by the reactor after a writable event
+        * @param ssl TLS handle (nullptr if none)
+        * @param resumed set to whether the backlog dropped from above the high-water mark to below the low-water mark
+        * @return 1: everything sent 0: the socket is full again and data waits for the next writable event -1: connection error
+        */
+        int flush(SSL *ssl,bool &resumed);
+        /**
+        * @brief Bytes still waiting in the queue
+        */
+        size_t pending() const{return bytes.load(std::memory_order_relaxed);}
+        /**
+        * @brief Whether more data should be written
+        * @return true: the backlog is below the high-water mark false: over the high-water mark; pause until it drops below the low-water mark
+        */
+        bool isWritable() const{return !overHigh.load(std::memory_order_relaxed);}
+        /**
+        * @brief Request a deferred close
+        * @note Returns true and marks the queue as closing if data is still pending; the caller should close after it is flushed. Returns false if nothing is pending or a close is already in progress; the caller should close right away
+        */
+        bool deferClose();
+        /**
+        * @brief Whether the queue is waiting to be flushed before closing
+        */
+        bool isClosing();
+        /**
+        * @brief Drop pending data; every later write fails
+        * @note Called when the connection is really closed
+        */
+        void close();
+    };
+
     /**
     * @brief TCP socket operation class
     */
@@ -2460,6 +3145,7 @@ private:
         bool flag2 = false;
         SSL *ssl = nullptr;
         int sec=-1;
+        std::shared_ptr<OutputBuffer> out;
     public:
         /**
         * @brief if the connection lost while using sendData function with block=true，this flag will be set to true
@@ -2510,6 +3196,23 @@ private:
         * @return true: The object has a socket bound, false: The object has no socket bound
         */
         bool isConnect() { if (fd == -1) return false; else return true; }
+        /**
+        * @brief Bind the output queue of a connection
+        * @note Once bound, sendData no longer waits for the socket to become writable: unsent data goes into the output queue and the server's reactor sends it when the socket is writable. Objects the server passes to handlers are already bound.
+        * @note setFD unbinds it, so call this after setFD
+        * @param out output queue; nullptr unbinds
+        */
+        void setOutputBuffer(const std::shared_ptr<OutputBuffer> &out){this->out=out;}
+        /**
+        * @brief Bytes still waiting in the output queue
+        * @return 0 if no output queue is bound
+        */
+        size_t getPendingBytes(){return out?out->pending():0;}
+        /**
+        * @brief Whether more data should be sent
+        * @return true: go on false: the output queue is over the high-water mark; pause until it drops below the low-water mark (the callback set by TcpServer::setWritableFunction is called then)
+        */
+        bool isWritable(){return out?out->isWritable():true;}
     public:
         /**
         * @brief Send string data to the connected socket.
@@ -2532,6 +3235,7 @@ private:
         *       Check the flag3 flag to determine if the connection is disconnected.
         *       If block is false, blocking depends on socket state. The return value may be less than the expected length, 
         *       requiring manual handling of remaining data.
+        * @note With an output queue bound (setOutputBuffer) it never blocks whatever block is: the unsent part goes into the queue and the full length is returned; on a connection error block=true returns 0 and sets flag3, block=false returns -1.
         */
         int sendData(const std::string &data, const bool &block = true);
         /**
@@ -2556,9 +3260,30 @@ private:
         *       Check the flag3 flag to determine if the connection is disconnected.
         *       If block is false, blocking depends on socket state. The return value may be less than length, 
         *       requiring manual handling of remaining data.
+        * @note With an output queue bound (setOutputBuffer) it never blocks whatever block is: the unsent part goes into the queue and the full length is returned; on a connection error block=true returns 0 and sets flag3, block=false returns -1.
         */
         int sendData(const char *data, const uint64_t &length, const bool &block = true);
         /**
+        * @brief Send several segments of data to the connected socket
+        * @note Segments are sent in order without being concatenated first; with an output queue bound, plain sockets use a single sendmsg and TLS joins small segments into one record
+        * @param iov segment array
+        * @param iovcnt number of segments
+        * @param block whether to send in blocking mode (default true), same meaning as in sendData(const char*,...)
+        * @return bytes sent (or queued); other return values are the same as sendData(const char*,...)
+        */
+        int sendData(const struct iovec *iov,const int &iovcnt,const bool &block = true);
+        /**
+        * @brief Send some data followed by a range of a file to the connected socket
+        * @note With an output queue bound it is handed to the queue (sendfile on plain sockets, chunked pread under TLS) and never blocks; otherwise plain sockets use sendfile and TLS reads and sends in chunks, blocking like sendData
+        * @param file file cache entry (from FileCache::get)
+        * @param offset start position in the file
+        * @param length number of bytes to send
+        * @param head data to send before the file (e.g. HTTP response headers), empty by default
+        * @param block whether to send in blocking mode (default true), same meaning as in sendData
+        * @return bytes sent (or queued); other return values are the same as sendData
+        */
+        int sendFile(const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length,const std::string &head="",const bool &block = true);
+        /**
         * @brief Blocking receive of specified length of data from a connected socket into a string
         *
         * @param data Data container for received data (string type)
@@ -3123,6 +3848,7 @@ private:
         * @param header Http request header; if not generated by createHeader, remember to add \r\n at the end.
         * @param header1 Additional item for the HTTP request header; if needed, must fill in a valid item; 
         *        no need to add \r\n at the end (cannot use createHeader). (For example, you can fill in the keepalive field by default)
+        * @note Headers and body are sent together as two segments (the iovec version of sendData); the body is not copied
         * @return true: Response sent successfully, false: Response sending failed
         */
         bool sendBack(const std::string &data, const std::string &header = "", const std::string &code = "200 OK", const std::string &header1 = "");
@@ -3134,12 +3860,24 @@ private:
         * @param header Http request header; if not generated by createHeader, remember to add \r\n at the end.
         * @param header1 Additional item for the HTTP request header; if needed, must fill in a valid item; 
         *        no need to add \r\n at the end (cannot use createHeader). (For example, you can fill in the keepalive field by default)
-        * @param header_length Maximum length of the response header added up (default is 50)
-        * @warning The reserved space must be accurate, otherwise the delivery may fail
-        * @warning All data pointed to by char must be ensured that 0 ends with 0 is not counted in the length, otherwise there is a risk of crashing
+        * @param header_length No longer used, kept for compatibility (headers are built in a thread-local buffer of any length)
+        * @note Headers and body are sent together as two segments (the iovec version of sendData); the body is not copied
+        * @warning header, code and header1 must be \0 terminated; data is sent by length and may contain \0
         * @return true: The response was successfully sent false: The response failed to be sent
         */
         bool sendBack(const char *data,const size_t &length,const char *header="\0",const char *code="200 OK\0",const char *header1="\0",const size_t &header_length=50);
+        using TcpFDHandler::sendFile;
+        /**
+        * @brief Send a static file as the Http/Https response
+        * @note The fd and metadata come from FileCache and the body is sent with TcpFDHandler::sendFile (zero-copy sendfile on plain sockets, chunked reads under TLS), so large downloads cost almost no user-space CPU or memory
+        * @note Content-Type (by extension), ETag, Last-Modified and Accept-Ranges are added automatically. A matching If-None-Match gets 304. A single Range (bytes=a-b, bytes=a-, bytes=-n) gets 206, an unsatisfiable one gets 416, and multiple ranges are ignored in favour of the whole file. HEAD requests get headers only
+        * @param path file path
+        * @param inf request information (method and the Range and If-None-Match headers are read)
+        * @param header Http response header; if not generated by createHeader, remember to add \r\n at the end. Content-Type is not added automatically if it contains one
+        * @param header1 Additional response header item; no \r\n at the end (cannot use createHeader)
+        * @return 1: response sent 0: the file does not exist or is not a regular file, nothing was sent -1: sending failed
+        */
+        int sendFile(const std::string &path,const HttpRequestInformation &inf,const std::string &header="",const std::string &header1="");
     };
 
     /**
@@ -3216,6 +3954,14 @@ private:
     ERROR           // TLS 出错（可选）
     };
 
+    /**
+    * @brief Event engine used by the server
+    */
+    enum class EventEngine : uint8_t {
+    EPOLL = 0,       // epoll edge-triggered (default)
+    IO_URING        // io_uring: multishot poll + multishot accept, falls back to epoll when the kernel lacks support
+    };
+
     /**
     * @brief Save TCP client information
     */
@@ -3239,6 +3985,113 @@ private:
         std::unordered_map<std::string,std::any> ctx;
     };
 
+    /**
+    * @brief Pool of receive buffers (slab with size classes)
+    * @note A connection only holds a buffer while it has unparsed bytes; once everything is consumed the buffer goes back to the pool, so idle keep-alive connections hold no receive memory.
+    * Size classes are 4KB, 16KB, 64KB, 256KB, 1MB and 4MB: a connection starts with the smallest class and moves up a class (keeping its data) when the buffer fills; requests above 4MB are plain new/delete and are not cached.
+    * Each class has its own free list and lock so several reactors can use it at once. All members are static: the pool is shared by the whole process.
+    * @note On machines with several NUMA nodes each node has its own set of free lists: acquire and release use the list of the node the calling thread runs on, so a pinned reactor only gets memory from its own node (see TcpServer::setAffinity).
+    */
+    class RecvBufferPool
+    {
+    public:
+        /**
+        * @brief Number of size classes
+        */
+        static constexpr int CLASS_NUM=6;
+        /**
+        * @brief Size of the smallest class in bytes
+        */
+        static constexpr unsigned long MIN_CLASS=4096;
+        /**
+        * @brief Number of NUMA nodes with separate caches; higher node numbers share by modulo
+        */
+        static constexpr int MAX_NODES=8;
+        /**
+        * @brief Statistics of one size class
+        */
+        struct ClassStat
+        {
+            /**
+            * @brief buffer size of this class in bytes
+            */
+            unsigned long size;
+            /**
+            * @brief buffers currently held by connections
+            */
+            uint64_t inUse;
+            /**
+            * @brief highest number of buffers held at the same time (high-water mark)
+            */
+            uint64_t highWater;
+            /**
+            * @brief buffers cached in the free list
+            */
+            uint64_t cached;
+        };
+    private:
+        struct SizeClass
+        {
+            std::atomic<uint64_t> inUse{0};
+            std::atomic<uint64_t> highWater{0};
+        };
+        struct FreeList
+        {
+            std::mutex mtx;
+            std::vector<char*> buffers;
+        };
+        static SizeClass classes[CLASS_NUM];
+        static FreeList freeLists[MAX_NODES][CLASS_NUM];
+        static std::atomic<uint64_t> bytesInUse;
+        static std::atomic<uint64_t> bytesHighWater;
+        static std::atomic<size_t> cacheLimit;
+        static int classOf(const unsigned long &size);
+        static unsigned long classSize(const int &cls){return MIN_CLASS<<(2*cls);}
+        static int nodeIndex();
+    public:
+        /**
+        * @brief Take a buffer of at least size bytes from the pool
+        * @param size required size in bytes
+        * @param cap returns the actual capacity in bytes; pass it back unchanged on release
+        * @return buffer pointer
+        */
+        static char* acquire(const unsigned long &size,unsigned long &cap);
+        /**
+        * @brief Return a buffer to the pool
+        * @param buffer buffer from acquire; nothing happens for nullptr
+        * @param cap capacity returned by acquire
+        */
+        static void release(char *buffer,const unsigned long &cap);
+        /**
+        * @brief Make sure the connection's buffer holds at least need bytes
+        * @note Takes a buffer from the pool if the connection has none; if it is too small, moves to a larger class and copies the p_buffer_now bytes already received
+        * @param inf connection information
+        * @param need required capacity in bytes
+        */
+        static void reserve(TcpFDInf &inf,const unsigned long &need);
+        /**
+        * @brief Return the connection's buffer to the pool if it has no unparsed bytes
+        * @param inf connection information
+        */
+        static void recycle(TcpFDInf &inf);
+        /**
+        * @brief Set the byte limit of each class's free-list cache; buffers beyond it are freed (default 64MB per class per node)
+        */
+        static void setCacheLimit(const size_t &bytes){cacheLimit=bytes;}
+        /**
+        * @brief Return usage and high-water marks of every class (summed over all NUMA nodes)
+        */
+        static std::vector<ClassStat> getStats();
+        /**
+        * @brief Return the total bytes of buffers currently held by connections
+        */
+        static uint64_t getBytesInUse(){return bytesInUse;}
+        /**
+        * @brief Return the highest total bytes of buffers held by connections (high-water mark)
+        */
+        static uint64_t getBytesHighWater(){return bytesHighWater;}
+    };
+
    /**
     * @brief Structure to save TCP client information
     */
@@ -3253,13 +4106,42 @@ private:
         */
         uint64_t connection_obj_fd;
         /**
-        * @brief Client IP
+        * @brief Client address (binary, stored at accept without formatting)
+        */
+        sockaddr_storage addr;
+        /**
+        * @brief Valid length of addr; 0 means not known yet (io_uring multishot accept does not report the peer address, getpeername is called the first time it is needed)
+        */
+        socklen_t addr_len;
+        /**
+        * @brief Client IP, formatted from addr on the first call to getIP; empty before that
+        * @note When the security module is on it is needed during accept and is formatted right away
         */
         std::string ip;
         /**
-        * @brief Client port
+        * @brief Client port, formatted from addr on the first call to getPort; empty before that
         */
         std::string port;
+        /**
+        * @brief Get the client IP, formatted and cached on the first call
+        * @note Should be called from the thread handling this connection
+        */
+        const std::string& getIP(){if(ip.empty())formatAddress();return ip;}
+        /**
+        * @brief Get the client port, formatted and cached on the first call
+        * @note Should be called from the thread handling this connection
+        */
+        const std::string& getPort(){if(port.empty())formatAddress();return port;}
+        /**
+        * @brief Format a binary address into IP and port strings (IPv4 and IPv6)
+        * @param addr address
+        * @param ip receives the IP
+        * @param port receives the port
+        */
+        static void formatAddress(const sockaddr_storage &addr,std::string &ip,std::string &port);
+    private:
+        void formatAddress();
+    public:
         /**
         * @brief The current fd status, used to save the processor logic
         */
@@ -3277,10 +4159,14 @@ private:
         */
         TLSState tls_state;
         /**
-        * @brief Receives the space pointer
+        * @brief Receives the space pointer; nullptr while there are no unparsed bytes (the buffer is back in RecvBufferPool)
         */
         char *buffer;
         /**
+        * @brief Capacity of the receive space; 0 means no buffer is held
+        */
+        unsigned long buffer_cap;
+        /**
         * @brief Receives a spatial position pointer
         */
         unsigned long p_buffer_now;
@@ -3292,6 +4178,180 @@ private:
         * @brief Queue waiting to be processed
         */
         std::queue<std::any> pendindQueue;
+        /**
+        * @brief Index of the I/O event loop (reactor) that owns this connection
+        */
+        int reactor;
+        /**
+        * @brief Output queue of the connection, read and written with std::atomic_load/std::atomic_store
+        */
+        std::shared_ptr<OutputBuffer> out;
+    };
+
+    /**
+    * @brief Sparse connection table indexed by fd
+    * @note The table is split into pages of PAGE_SIZE elements. A page is allocated and initialised only when an fd in it is first accessed, so startup only allocates an array of page pointers instead of constructing maxFD elements.
+    * @note Each page carries a live bitmap. fds marked with setLive can be visited with forEachLive, which only touches allocated pages that hold live connections instead of scanning all of maxFD.
+    * @note Pages are never freed while running, so references stay valid until clear(). operator[] may be called from several threads at once.
+    * @tparam T Element type stored in the table
+    */
+    template<class T>
+    class ConnectionTable
+    {
+    public:
+        /**
+        * @brief Number of elements per page
+        */
+        static constexpr int PAGE_SIZE=1024;
+    private:
+        struct Page
+        {
+            T items[PAGE_SIZE];
+            std::atomic<uint64_t> live[PAGE_SIZE/64];
+            std::atomic<int> liveNum{0};
+        };
+        std::unique_ptr<std::atomic<Page*>[]> pages;
+        int pageNum=0;
+        unsigned long long maxFD=0;
+        std::function<void(T&)> initFun;
+        std::mutex lpage;
+        std::atomic<size_t> allocated{0};
+        std::atomic<size_t> liveCount{0};
+    private:
+        Page* getPage(const int &fd)
+        {
+            std::atomic<Page*> &slot=pages[fd/PAGE_SIZE];
+            Page *p=slot.load(std::memory_order_acquire);
+            if(p!=nullptr)
+                return p;
+            std::lock_guard<std::mutex> lock(lpage);
+            p=slot.load(std::memory_order_relaxed);
+            if(p==nullptr)
+            {
+                p=new Page();
+                if(initFun)
+                    for(auto &ii:p->items)
+                        initFun(ii);
+                slot.store(p,std::memory_order_release);
+                ++allocated;
+            }
+            return p;
+        }
+    public:
+        ConnectionTable()=default;
+        ConnectionTable(const ConnectionTable&)=delete;
+        ConnectionTable& operator=(const ConnectionTable&)=delete;
+        /**
+        * @brief Initialise the table (existing content is cleared first)
+        * @param maxFD Upper bound of fd (exclusive)
+        * @param initFun Called once on every element of a newly allocated page (default empty)
+        */
+        void init(const unsigned long long &maxFD,std::function<void(T&)> initFun=nullptr)
+        {
+            clear();
+            this->maxFD=maxFD;
+            this->initFun=initFun;
+            pageNum=(maxFD+PAGE_SIZE-1)/PAGE_SIZE;
+            pages.reset(new std::atomic<Page*>[pageNum]);
+            for(int ii=0;ii<pageNum;ii++)
+                pages[ii].store(nullptr,std::memory_order_relaxed);
+        }
+        /**
+        * @brief Get the element for fd, allocating its page if needed
+        * @note fd must be less than the maxFD given to init
+        */
+        T& operator[](const int &fd){return getPage(fd)->items[fd%PAGE_SIZE];}
+        /**
+        * @brief Look up the element for fd without allocating
+        * @return nullptr if the page is not allocated yet or fd is out of range
+        */
+        T* find(const int &fd)
+        {
+            if(fd<0||(unsigned long long)fd>=maxFD)
+                return nullptr;
+            Page *p=pages[fd/PAGE_SIZE].load(std::memory_order_acquire);
+            return p==nullptr?nullptr:&p->items[fd%PAGE_SIZE];
+        }
+        /**
+        * @brief Mark whether fd is a live connection
+        * @param fd Socket
+        * @param live true: add to the live set; false: remove from it
+        */
+        void setLive(const int &fd,const bool &live)
+        {
+            Page *p=getPage(fd);
+            uint64_t bit=1ULL<<(fd%64);
+            std::atomic<uint64_t> &word=p->live[(fd%PAGE_SIZE)/64];
+            if(live)
+            {
+                if(!(word.fetch_or(bit)&bit))
+                {
+                    ++p->liveNum;
+                    ++liveCount;
+                }
+            }
+            else
+            {
+                if(word.fetch_and(~bit)&bit)
+                {
+                    --p->liveNum;
+                    --liveCount;
+                }
+            }
+        }
+        /**
+        * @brief Visit every live fd
+        * @param fun Callback taking fd and its element; it may call setLive(fd,false)
+        */
+        template<class Fn>
+        void forEachLive(Fn &&fun)
+        {
+            if(!pages)
+                return;
+            for(int ii=0;ii<pageNum;ii++)
+            {
+                Page *p=pages[ii].load(std::memory_order_acquire);
+                if(p==nullptr||p->liveNum.load(std::memory_order_relaxed)==0)
+                    continue;
+                for(int jj=0;jj<PAGE_SIZE/64;jj++)
+                {
+                    uint64_t word=p->live[jj].load(std::memory_order_acquire);
+                    while(word!=0)
+                    {
+                        int bit=__builtin_ctzll(word);
+                        word&=word-1;
+                        int fd=ii*PAGE_SIZE+jj*64+bit;
+                        fun(fd,p->items[fd%PAGE_SIZE]);
+                    }
+                }
+            }
+        }
+        /**
+        * @brief Number of live connections
+        */
+        size_t getLiveCount(){return liveCount;}
+        /**
+        * @brief Number of allocated pages
+        */
+        size_t getPageCount(){return allocated;}
+        /**
+        * @brief Free all pages
+        * @note No other thread may be using the table
+        */
+        void clear()
+        {
+            for(int ii=0;ii<pageNum;ii++)
+            {
+                delete pages[ii].load(std::memory_order_relaxed);
+                pages[ii].store(nullptr,std::memory_order_relaxed);
+            }
+            allocated=0;
+            liveCount=0;
+        }
+        /**
+        * @brief Destructor, frees all pages
+        */
+        ~ConnectionTable(){clear();}
     };
 
     /**
@@ -3308,6 +4368,426 @@ private:
         */
         int ret;
     };
+    /**
+    * @brief Message handed back to the reactor after the handshake pool has run a TLS handshake
+    */
+    struct HandshakeMessage
+    {
+        /**
+        * @brief Low-level socket
+        */
+        int fd;
+        /**
+        * @brief Unique id of the connection object, used to tell whether the fd has been reused
+        */
+        uint64_t connection_obj_fd;
+        /**
+        * @brief true: handshake finished false: handshake failed and the connection must be closed
+        */
+        bool ok;
+    };
+    /**
+    * @brief Statistics of queue-delay load shedding (see TcpServer::setLoadShedding); times in microseconds
+    */
+    struct LoadShedStats
+    {
+        /**
+        * @brief tasks rejected because the queue delay was too long
+        */
+        uint64_t shed=0;
+        /**
+        * @brief tasks whose queue delay was measured
+        */
+        uint64_t tasks=0;
+        /**
+        * @brief average queue delay
+        */
+        uint64_t delayAvg=0;
+        /**
+        * @brief longest queue delay
+        */
+        uint64_t delayMax=0;
+        /**
+        * @brief queue delay of the most recently started task
+        */
+        uint64_t delayLast=0;
+        /**
+        * @brief tasks currently queued but not started
+        */
+        int queued=0;
+        /**
+        * @brief whether the queue is shedding (new tasks rejected) right now
+        */
+        bool dropping=false;
+    };
+    /**
+    * @brief Statistics of a worker group (bulkhead)
+    */
+    struct WorkerGroupStats
+    {
+        /**
+        * @brief group name
+        */
+        std::string name;
+        /**
+        * @brief number of threads
+        */
+        int threads=0;
+        /**
+        * @brief nice value of the threads
+        */
+        int nice=0;
+        /**
+        * @brief limit of queued plus running tasks, 0 means unlimited
+        */
+        int maxQueue=0;
+        /**
+        * @brief tasks currently queued or running
+        */
+        int inflight=0;
+        /**
+        * @brief tasks handed to this group
+        */
+        uint64_t submitted=0;
+        /**
+        * @brief tasks rejected because the limit was reached
+        */
+        uint64_t rejected=0;
+    };
+    /**
+    * @brief Statistics of the TLS handshake pool
+    * @note One handshake may take several rounds (the pool is handed the connection once per flight of handshake data); times are per round, in microseconds
+    */
+    struct HandshakeStats
+    {
+        /**
+        * @brief Rounds handed to the pool
+        */
+        uint64_t rounds=0;
+        /**
+        * @brief Connections rejected (closed) because the concurrent handshake limit was reached
+        */
+        uint64_t rejected=0;
+        /**
+        * @brief Total queueing time (from reactor submission to a pool thread starting it)
+        */
+        uint64_t queueTimeTotal=0;
+        /**
+        * @brief Longest single queueing time
+        */
+        uint64_t queueTimeMax=0;
+        /**
+        * @brief Total time pool threads spent in SSL_accept
+        */
+        uint64_t busyTimeTotal=0;
+        /**
+        * @brief Handshakes currently queued or running
+        */
+        int inflight=0;
+    };
+
+    /**
+    * @brief io_uring based event ring (raw system calls, no liburing dependency)
+    * @note Connections, timers and doorbells are registered with multishot poll, so one registration keeps producing events without re-arming; the listening socket uses multishot accept, so one request keeps producing new connections.
+    * The submission queue is protected by a lock so the acceptor and other threads can add or cancel registrations; the completion queue is only consumed by the owning reactor thread.
+    * @note Requires Linux 5.19+ (IORING_FEAT_EXT_ARG and multishot accept); when init fails the caller should fall back to epoll
+    */
+    class IoUring
+    {
+    private:
+        int ringFD=-1;
+        void *sqPtr=nullptr;
+        size_t sqSize=0;
+        void *cqPtr=nullptr;
+        size_t cqSize=0;
+        io_uring_sqe *sqes=nullptr;
+        size_t sqesSize=0;
+        unsigned *sqHead;
+        unsigned *sqTail;
+        unsigned *sqMask;
+        unsigned *sqArray;
+        unsigned sqEntries;
+        unsigned *cqHead;
+        unsigned *cqTail;
+        unsigned *cqMask;
+        io_uring_cqe *cqes;
+        std::mutex lsq;
+        int listenFD=-1;
+        bool multishotAccept=true;
+        bool acceptStopped=false;
+        static constexpr uint64_t WRITE_TAG=1ULL<<61;
+        static constexpr uint64_t ACCEPT_TAG=1ULL<<62;
+        static constexpr uint64_t CANCEL_TAG=1ULL<<63;
+    private:
+        io_uring_sqe* getSQE();
+        bool submit();
+        bool prepPoll(const int &fd,const uint32_t &events,const uint32_t &tag=0);
+        bool prepAccept();
+    public:
+        /**
+        * @brief Usable bits of the tag that can be attached to a registration
+        * @note The tag is stored in bits 32 to 60 of user_data; higher bits are dropped
+        */
+        static constexpr uint32_t TAG_MASK=(1U<<29)-1;
+        /**
+        * @brief New connections received through multishot accept during the last wait
+        * @note The reactor takes and clears them after wait returns
+        */
+        std::vector<int> acceptedFD;
+        /**
+        * @brief Create the io_uring
+        * @param entries submission queue size
+        * @param cqEntries completion queue size; multishot requests keep producing completions, so it should be much larger than the submission queue
+        * @return true: created false: the kernel does not support it or creation failed
+        */
+        bool init(const unsigned &entries=64,const unsigned &cqEntries=16384);
+        /**
+        * @brief Register an fd with multishot poll
+        * @param fd fd to register
+        * @param events events of interest, same values as epoll's EPOLLIN/EPOLLRDHUP etc.
+        * @param tag tag (default 0), returned in the high 32 bits of data.u64 of every event, used to tell apart old and new connections that reuse the same fd number
+        * @return true: registered false: failed
+        */
+        bool addFD(const int &fd,const uint32_t &events,const uint32_t &tag=0);
+        /**
+        * @brief Watch an fd for writability with a one-shot poll
+        * @note When writable, wait returns an EPOLLOUT event for the fd and the registration is gone; call again to keep watching
+        * @param tag tag (default 0), same as addFD
+        * @return true: registered false: failed
+        */
+        bool addWriteWatch(const int &fd,const uint32_t &tag=0);
+        /**
+        * @brief Cancel the registration of an fd (including a writability watch)
+        * @note Must be called before closing the fd; io_uring holds a file reference, so closing without cancelling would leave the socket open
+        * @param tag tag used when registering
+        * @return true: submitted false: failed
+        */
+        bool removeFD(const int &fd,const uint32_t &tag=0);
+        /**
+        * @brief Accept on a listening socket with multishot accept
+        * @note If the kernel lacks multishot accept the socket is polled instead, and wait reports it readable just like epoll
+        * @return true: submitted false: failed
+        */
+        bool addAccept(const int &fd);
+        /**
+        * @brief Stop the accept started by addAccept
+        * @note Connections the kernel has already accepted are still placed in acceptedFD by later waits
+        * @return true: submitted false: failed
+        */
+        bool removeAccept();
+        /**
+        * @brief Wait for events
+        * @param evs output array, same layout as epoll_wait (data.fd and events); the high 32 bits of data.u64 hold the registration tag
+        * @param maxevents length of evs
+        * @param timeout timeout in milliseconds
+        * @return number of events, 0 on timeout, -1 on error
+        * @note New connections are not counted in the return value; they are placed in acceptedFD
+        */
+        int wait(epoll_event *evs,const int &maxevents,const int &timeout);
+        /**
+        * @brief Destroy the io_uring, cancelling all registrations
+        */
+        void close();
+        ~IoUring(){close();}
+    };
+
+    /**
+    * @brief Hierarchical timing wheel
+    * @note 4 levels of 64 slots. A level-0 slot covers one tick and a level-n slot covers 64^n ticks, so up to 64^4 ticks can be represented directly. Longer timers are re-placed once they reach the top level.
+    * @note Re-arming an existing timer (set) is O(1). When the deadline moves later only the record is updated and the node stays put; it is moved to the right slot when its current slot comes due. When the deadline moves earlier the node is unlinked and re-placed.
+    * @note advance only visits the slots it passes over, and only timers that are actually due are reported.
+    * @note Internally locked; may be called from several threads.
+    */
+    class TimingWheel
+    {
+    public:
+        /**
+        * @brief Slots per level
+        */
+        static constexpr int SLOT_NUM=64;
+        /**
+        * @brief Number of levels
+        */
+        static constexpr int LEVEL_NUM=4;
+        /**
+        * @brief A timer that came due
+        */
+        struct Expired
+        {
+            /**
+            * @brief Timer key
+            */
+            uint64_t key;
+            /**
+            * @brief Tag passed to set
+            */
+            uint64_t tag;
+        };
+    private:
+        struct Node
+        {
+            uint64_t expire;
+            uint64_t tag;
+            int level;
+            int slot;
+            std::list<uint64_t>::iterator it;
+        };
+        static constexpr int SLOT_BITS=6;
+        std::list<uint64_t> slots[LEVEL_NUM][SLOT_NUM];
+        std::unordered_map<uint64_t,Node> nodes;
+        uint64_t current=0;
+        std::mutex lw;
+    private:
+        void place(const uint64_t &key,Node &node);
+        void cascade(const int &level,const int &slot);
+    public:
+        /**
+        * @brief Arm or re-arm a timer
+        * @param key Timer key; at most one timer exists per key
+        * @param ticks Ticks from now until it is due (0 fires on the next tick)
+        * @param tag Extra value returned on expiry, e.g. to detect a reused fd (default 0)
+        */
+        void set(const uint64_t &key,const uint64_t &ticks,const uint64_t &tag=0);
+        /**
+        * @brief Cancel a timer
+        * @return true if it existed
+        */
+        bool remove(const uint64_t &key);
+        /**
+        * @brief Advance the wheel
+        * @param ticks Number of ticks to advance
+        * @param expired Due timers are appended here and removed from the wheel; set them again to re-arm
+        */
+        void advance(const uint64_t &ticks,std::vector<Expired> &expired);
+        /**
+        * @brief Number of armed timers
+        */
+        size_t size();
+    };
+
+    /**
+    * @brief State of queue-delay admission control (CoDel)
+    * @note Updated when each task starts, with the time it spent between being queued and starting (its sojourn time). When sojourn stays above target for a whole interval, the queue enters the shedding state and new tasks are rejected instead of queued;
+    * one sojourn below target, or the backlog fully draining, leaves the shedding state
+    */
+    struct QueueDelayControl
+    {
+        std::atomic<int> queued{0};//tasks queued but not started yet
+        std::atomic<int64_t> aboveSince{0};//when sojourn first went above target (steady_clock ns), 0 when it is not above
+        std::atomic<bool> dropping{false};
+        std::atomic<uint64_t> shed{0};
+        std::atomic<uint64_t> samples{0};
+        std::atomic<uint64_t> delayTotal{0};//microseconds
+        std::atomic<uint64_t> delayMax{0};
+        std::atomic<uint64_t> delayLast{0};
+    };
+
+    /**
+    * @brief A worker group (bulkhead)
+    * @note A group has its own threads and queue limit; routes assigned to it only use its threads, so a slow route that fills up does not hold back the others
+    */
+    struct WorkerGroup
+    {
+        std::string name;
+        int threads;
+        int maxQueue;
+        int nice;
+        std::unique_ptr<system::WorkerPool> pool;
+        std::atomic<int> inflight{0};
+        std::atomic<uint64_t> submitted{0};
+        std::atomic<uint64_t> rejected{0};
+        QueueDelayControl delay;
+    };
+
+    /**
+    * @brief Runtime information of one I/O event loop (reactor)
+    * @note Each reactor owns its epoll handle, worker completion queue and doorbell eventfd, and only serves the connections assigned to it
+    */
+    struct ReactorInf
+    {
+        /**
+        * @brief reactor index
+        */
+        int id;
+        /**
+        * @brief epoll handle of this reactor
+        */
+        int epollFD=-1;
+        /**
+        * @brief eventfd used by workers to notify this reactor of finished tasks
+        */
+        int workerEventFD=-1;
+        /**
+        * @brief event ring of this reactor when the io_uring engine is used, nullptr with epoll
+        */
+        std::unique_ptr<IoUring> ring;
+        /**
+        * @brief Timing wheel of this reactor, one tick per second; drives zombie detection and WebSocket heartbeats
+        */
+        TimingWheel wheel;
+        /**
+        * @brief number of connections currently assigned to this reactor
+        */
+        std::atomic<uint64_t> connections{0};
+        /**
+        * @brief Worker → Reactor completion queue
+        */
+        system::MPSCQueue<WorkerMessage> finishQueue;
+        /**
+        * @brief Handshake pool → Reactor completion queue, sharing the doorbell with finishQueue
+        */
+        system::MPSCQueue<HandshakeMessage> handshakeQueue;
+        ReactorInf(const int &id,const size_t &finishQueue_cap,const size_t &handshakeQueue_cap=2):id(id),finishQueue(finishQueue_cap),handshakeQueue(handshakeQueue_cap){}
+    };
+    
+    /**
+    * @brief Key ring for TLS session tickets
+    * @note New tickets are encrypted with the current key; after a rotation the previous key is kept for one more period only to decrypt old tickets (and issue new ones), so a ticket stays usable for at least one rotation period
+    * @note Rotation happens automatically on the next ticket issued after the period expires; keys live only in memory, so old tickets become invalid after a restart and clients fall back to a full handshake
+    */
+    class TicketKeyRing
+    {
+    public:
+        /**
+        * @brief One ticket key
+        */
+        struct Key
+        {
+            unsigned char name[16];
+            unsigned char aesKey[32];
+            unsigned char hmacKey[32];
+            std::chrono::steady_clock::time_point created;
+        };
+    private:
+        std::mutex lk;
+        Key keys[2];//0 is the current key, 1 the previous one
+        int count=0;
+        int interval=3600;
+        bool generate(Key &key);
+    public:
+        /**
+        * @brief Set the rotation period
+        * @param secs rotation period (seconds)
+        */
+        void setInterval(const int &secs){std::lock_guard<std::mutex> lock(lk);interval=secs;}
+        /**
+        * @brief Get the current key used to encrypt new tickets, rotating first if it has expired
+        * @param key the key
+        * @return true: success false: failed to generate a random key
+        */
+        bool current(Key &key);
+        /**
+        * @brief Find the decryption key by the key name stored in a ticket
+        * @param name 16-byte key name from the ticket
+        * @param key the key found
+        * @return 1: current key 2: previous key (a new ticket should be issued) 0: not found (the ticket is rejected and a full handshake follows)
+        */
+        int find(const unsigned char *name,Key &key);
+        /**
+        * @brief Rotate immediately (e.g. when a key may have leaked)
+        */
+        void rotate();
+    };
     
     /**
     * @brief Tcp server class
@@ -3316,14 +4796,44 @@ private:
     class TcpServer 
     {
     protected:
-        system::MPSCQueue<WorkerMessage> finishQueue;
+        std::vector<std::unique_ptr<ReactorInf>> reactorInf;
+        size_t finishQueue_cap;
+        int reactorNum=1;
+        static constexpr int EVENT_BATCH=4096;//max events fetched by one epoll_wait call of a reactor
+        EventEngine engine;
         stt::system::WorkerPool *workpool; 
+        stt::system::WorkerPool *handshakePool=nullptr;
+        int handshakeThreads=0;
+        int handshakeLimit=1024;
+        ConnectionTable<std::atomic<int>> handshakeState;//0: idle 1: in the handshake pool 2: in the pool and more data has arrived
+        std::atomic<int> handshakeInflight{0};
+        std::atomic<uint64_t> handshakeRounds{0};
+        std::atomic<uint64_t> handshakeRejected{0};
+        std::atomic<uint64_t> handshakeQueueTime{0};
+        std::atomic<uint64_t> handshakeQueueMax{0};
+        std::atomic<uint64_t> handshakeBusyTime{0};
+        std::string hotRestartPath;
+        int hotRestartDrain=30;
+        std::function<void()> drainedFun;
+        std::atomic<bool> accepting{true};
+        std::atomic<bool> handedOver{false};
+        bool noDelay=true;
+        int deferAcceptSecs=0;
+        int fastOpenQueue=0;
+        std::vector<int> reactorCPUs;
+        std::vector<int> workerCPUs;
+        bool taskLanes=false;
+        std::unordered_map<std::string,std::unique_ptr<WorkerGroup>> workerGroups;
+        int shedTargetUs=0;
+        int shedIntervalUs=100000;
+        QueueDelayControl queueDelay;//queue delay of the default pool
+        std::unordered_map<std::string,WorkerGroup*> routeGroups;//route key to worker group
         unsigned long buffer_size;
         unsigned long long  maxFD;
         security::ConnectionLimiter connectionLimiter;
         //std::unordered_map<int,TcpFDInf> clientfd;
         //std::mutex lc1;
-        TcpFDInf *clientfd;
+        ConnectionTable<TcpFDInf> clientfd;
         int flag1=true;
         //std::queue<QueueFD> *fdQueue;
         //std::mutex *lq1;
@@ -3334,12 +4844,15 @@ private:
         bool unblock;
         SSL_CTX *ctx=nullptr;
         bool TLS=false;
+        bool ktls=false;
+        TicketKeyRing ticketKeys;
+        std::atomic<uint64_t> fullHandshakes{0};
+        std::atomic<uint64_t> resumedHandshakes{0};
         //std::unordered_map<int,SSL*> tlsfd;
         //std::mutex ltl1;
         bool security_open;
         //bool flag_detect;
         //bool flag_detect_status;
-        int workerEventFD;
         int serverType; // 1 tcp 2 http 3 websocket
         int connectionSecs;
         int connectionTimes;
@@ -3347,6 +4860,11 @@ private:
         int requestTimes;
         int checkFrequency;
         uint64_t connection_obj_fd;
+        static constexpr int TIMER_IDLE=0;//zombie detection timer
+        static constexpr int TIMER_HEARTBEAT=1;//websocket heartbeat timer
+        void armTimer(const int &fd,const int &kind,const int &secs);//arm (or push back) a timer due in secs seconds on the wheel of the reactor owning fd
+        bool dispatchTask(std::unordered_map<std::string,std::any> &ctx,const uint64_t &connection_obj_fd,std::function<void()> &&task);//hand a task to its route's worker group or the default pool; false when the group is full
+        void recordQueueDelay(QueueDelayControl &qc,const std::chrono::steady_clock::time_point &queuedAt);
     private:
         std::function<void(const int &fd)> closeFun=[](const int &fd)->void
         {
@@ -3359,16 +4877,34 @@ private:
         std::unordered_map<std::string,std::vector<std::function<int(TcpFDHandler &k,TcpInformation &inf)>>> solveFun;
         std::function<int(TcpFDHandler &k,TcpInformation &inf)> parseKey=[](TcpFDHandler &k,TcpInformation &inf)->int
         {inf.ctx["key"]=inf.data;return 1;};
+        std::function<void(const int &fd)> writableFun;
+        size_t outHighWater=4*1024*1024;
+        size_t outLowWater=1024*1024;
         int fd=-1;
         int port=-1;
         int flag=false;
-        bool flag2=false;
+        std::atomic<int> loopNum{0};
+        uint64_t nextReactor=0;
     private:
-        void epolll(const int &evsNum);
+        void epolll(const int &id);
+        void acceptLoop();
+        void acceptConnection();
+        void addConnection(const int &cfd,const struct sockaddr_storage *addr=nullptr,const socklen_t &addrLen=0);
+        void watchFD(ReactorInf &r,const int &fd,const uint32_t &events,const uint32_t &tag=0);
+        void watchWrite(const int &reactor,const int &fd,const bool &on,const uint32_t &tag);
+        static uint32_t eventTag(const uint64_t &connection_obj_fd){return (uint32_t)(connection_obj_fd&IoUring::TAG_MASK);}
+        void forceClose(const int &fd);
+        bool idleCheckOn();
+        void handshakeTask(const int &reactor,const int &fd,const uint64_t &connection_obj_fd,const std::chrono::steady_clock::time_point &queued);
+        void onTLSEstablished(const int &fd);
+        int inheritListenFD(const int &port);
+        int openControlSocket();
+        void hotRestartLoop(const int &controlFD);
+        void unwatchListen(IoUring *ring,const int &epollFD);
         //virtual void consumer(const int &threadID);
         virtual void handler_netevent(const int &fd);
         virtual void handler_workerevent(const int &fd,const int &ret);
-        virtual void handleHeartbeat()=0;
+        virtual void handleHeartbeat(const int &id,const int &fd)=0;
     public:
         /**
         * @brief Add a task to a worker thread pool and have it completed by worker threads.
@@ -3454,6 +4990,8 @@ private:
  * @param checkFrequency
  *        Frequency (in seconds) for checking zombie/idle connections.
  *        -1 disables zombie connection detection.
+ *        Each connection is expired individually on the reactor's timing
+ *        wheel (1 s resolution); any positive value just enables detection.
  *        Default: 60 seconds.
  *
  * @param connectionTimeout
@@ -3461,6 +4999,11 @@ private:
  *        it is considered a zombie connection.
  *        -1 means no timeout (infinite).
  *        Default: 60 seconds.
+ *
+ * @param engine
+ *        Event engine: EventEngine::EPOLL or EventEngine::IO_URING.
+ *        startListen falls back to epoll when the kernel lacks io_uring support.
+ *        Default: EventEngine::EPOLL.
  */
 TcpServer(
     const unsigned long long &maxFD = 1000000,
@@ -3473,18 +5016,20 @@ TcpServer(
     const int &requestSecs = 1,
     const int &requestTimes = 40,
     const int &checkFrequency = 60,
-    const int &connectionTimeout = 60
+    const int &connectionTimeout = 60,
+    const EventEngine &engine = EventEngine::EPOLL
 )
 : maxFD(maxFD),
   buffer_size(buffer_size * 1024),
-  finishQueue(finishQueue_cap),
+  finishQueue_cap(finishQueue_cap),
   security_open(security_open),
   connectionSecs(connectionSecs),
   connectionTimes(connectionTimes),
   requestSecs(requestSecs),
   requestTimes(requestTimes),
   connectionLimiter(connectionNumLimit, connectionTimeout),
-  checkFrequency(checkFrequency)
+  checkFrequency(checkFrequency),
+  engine(engine)
 {
     serverType = 1;
 }
@@ -3493,9 +5038,12 @@ TcpServer(
         * @brief Start the TCP server listening program
         * @param port Port to listen on
         * @param threads Number of consumer threads (default is 8)
+        * @param reactors Number of I/O event loops (reactors) (default is 1)
+        * - 1: a single epoll thread accepts and serves every connection (the original mode)
+        * - greater than 1: one acceptor thread only accepts and hands new connections round-robin to N reactor threads, each with its own epoll set, slice of connections and completion queue
         * @return true: Listening started successfully, false: Failed to start listening
         */
-        bool startListen(const int &port, const int &threads = 8);
+        bool startListen(const int &port, const int &threads = 8, const int &reactors = 1);
         /**
         * @brief Enable TLS encryption and configure server-side certificate and key
         * 
@@ -3521,14 +5069,163 @@ TcpServer(
         * 
         * @warning After enabling TLS, all incoming connections must follow the TLS handshake process, otherwise communication will fail
         * 
+        * @note Session resumption: the server-side session cache (TLS 1.2 session ids) has a bounded capacity and expires entries after sessionTimeout; session tickets (TLS 1.3 and TLS 1.2 tickets) are encrypted with keys from a TicketKeyRing that rotates periodically, so the server keeps no state for them.
+        * A reconnecting client presenting a ticket or session id only needs an abbreviated handshake, saving the CPU of certificate signing and key exchange. Handshake counts are available through getFullHandshakes and getResumedHandshakes
+        * @note Ticket keys survive a new setTLS call (certificate hot reload), so tickets already issued stay valid
+        * 
+        * @param sessionCacheSize maximum number of sessions in the server-side cache, default 20480; 0 disables the cache
+        * @param sessionTimeout lifetime of sessions (cache entries and tickets) in seconds, default 300
+        * @param ticketKeyInterval rotation period of ticket keys in seconds, default 3600; 0 disables tickets and resumption uses the cache only
+        * 
         * @see redrawTLS() If a TLS context already exists, it will be released and rebuilt first (can be used for hot updating certificates)
         */
-        bool setTLS(const char *cert, const char *key, const char *passwd, const char *ca);
+        bool setTLS(const char *cert, const char *key, const char *passwd, const char *ca, const long &sessionCacheSize = 20480, const long &sessionTimeout = 300, const int &ticketKeyInterval = 3600);
+        /**
+        * @brief Get the number of full handshakes
+        */
+        uint64_t getFullHandshakes(){return fullHandshakes;}
+        /**
+        * @brief Get the number of resumed (abbreviated) handshakes
+        */
+        uint64_t getResumedHandshakes(){return resumedHandshakes;}
+        /**
+        * @brief Rotate the session ticket key immediately
+        * @note The previous key is kept for one more period, so tickets already issued can still be resumed
+        */
+        void rotateTicketKey(){ticketKeys.rotate();}
+        /**
+        * @brief Hand TLS handshakes to a dedicated thread pool
+        * @note By default the handshake (the RSA/ECDHE work inside SSL_accept) runs in the reactor thread, so a reconnect storm stalls traffic on established connections. When enabled, every flight of handshake data for a connection in the handshaking state is handed to the handshake pool, which runs SSL_accept;
+        * once the handshake completes the connection goes back to its reactor, which only does I/O
+        * @note When queued plus running handshakes reach maxPending, new handshakes close the connection right away (clients retry), so a backlog cannot blow up memory and latency; see getHandshakeStats
+        * @note Must be called before startListen
+        * @param threads number of handshake threads; 0 disables the pool (handshakes run in the reactor)
+        * @param maxPending limit of handshakes queued and running at the same time, default 1024
+        */
+        void setHandshakePool(const int &threads,const int &maxPending=1024){handshakeThreads=threads;handshakeLimit=maxPending>0?maxPending:1;}
+        /**
+        * @brief Get statistics of the handshake pool
+        */
+        HandshakeStats getHandshakeStats();
+        /**
+        * @brief Enable hot restart (listening socket handover)
+        * @note When enabled, startListen first connects to the Unix domain socket at path: if an old process is listening there, its listening socket is received through SCM_RIGHTS and used directly without binding again,
+        * so connections wait in the same accept queue during the handover and none are lost; without an old process it binds normally. Afterwards it listens on path itself, waiting for the next process to hand over to
+        * @note After giving away the listening socket the old process stops accepting and keeps serving its existing connections until they are all closed or drainSecs seconds have passed, then calls fun (by default it sends signal 15 to itself)
+        * @note The new process is usually started by the old one with Process::startProcess; listening and connection sockets carry FD_CLOEXEC, so the new process does not inherit them
+        * @note Must be called before startListen; every server in the same process needs its own path
+        * @param path path of the Unix domain socket; empty disables the feature
+        * @param drainSecs longest time to wait for existing connections after handing over the listening socket (seconds), default 30
+        * @param fun function run by the old process once its connections are done, default nullptr (send signal 15)
+        */
+        void setHotRestart(const std::string &path,const int &drainSecs=30,const std::function<void()> &fun=nullptr){hotRestartPath=path;hotRestartDrain=drainSecs;drainedFun=fun;}
+        /**
+        * @brief Whether the listening socket has been handed to a new process
+        * @return true: handed over, serving the remaining connections false: not handed over
+        */
+        bool isHandedOver(){return handedOver;}
+        /**
+        * @brief Set TCP_NODELAY on the listening socket (on by default)
+        * @note It is set on the listening socket and inherited by accepted connections, so no extra setsockopt per connection;
+        * responses are already coalesced with writev and MSG_MORE, so disabling Nagle adds no small packets and avoids the tens of milliseconds it costs together with the client's delayed ACK
+        * @note Must be called before startListen
+        * @param on true: enable false: disable
+        */
+        void setNoDelay(const bool &on=true){noDelay=on;}
+        /**
+        * @brief Set TCP_DEFER_ACCEPT
+        * @note The kernel hands a connection to accept only after the client's first data arrives, so clients that connect without sending do not occupy the connection table or a reactor,
+        * and the first read of a short connection always finds data, saving an empty readable event; only suitable for protocols where the client speaks first (HTTP, TLS, WebSocket)
+        * @note Must be called before startListen
+        * @param secs longest wait in seconds, after which the kernel still hands the connection to accept; 0 disables it (default)
+        */
+        void setDeferAccept(const int &secs){deferAcceptSecs=secs>0?secs:0;}
+        /**
+        * @brief Enable server-side TCP Fast Open
+        * @note Clients reconnecting with a valid cookie can send the request inside the SYN, saving a round trip; the server bit of net.ipv4.tcp_fastopen must be enabled (value includes 2)
+        * @note Must be called before startListen
+        * @param queueLen length of the queue of TFO requests that have not completed the three-way handshake; 0 disables it (default)
+        */
+        void setFastOpen(const int &queueLen){fastOpenQueue=queueLen>0?queueLen:0;}
+        /**
+        * @brief Set the CPUs the reactor and worker threads are pinned to
+        * @note Reactor ii is pinned to the single CPU reactorCPUs[ii%size]; in multi-reactor mode the acceptor thread is pinned to the whole reactorCPUs set.
+        * Worker ii (including the handshake pool) is pinned to workerCPUs[ii%size]
+        * @note Each reactor's completion queues and io_uring ring are created on its CPU, and receive buffers come from the pool of the NUMA node the calling thread runs on (see RecvBufferPool),
+        * so a connection's memory lives on the node of the reactor that serves it and is not accessed across nodes
+        * @note startListen writes the actual layout (CPUs and NUMA node of every thread) to the log
+        * @note Must be called before startListen
+        * @param reactorCPUs CPU numbers for the reactors; empty means unpinned (default)
+        * @param workerCPUs CPU numbers for the worker threads; empty means unpinned (default)
+        */
+        void setAffinity(const std::vector<int> &reactorCPUs,const std::vector<int> &workerCPUs={}){this->reactorCPUs=reactorCPUs;this->workerCPUs=workerCPUs;}
+        /**
+        * @brief Run the putTask tasks of one connection on one fixed worker, in order
+        * @note When on, putTask picks a worker's ordered lane from the connection's connection_obj_fd (see WorkerPool::submitTo): the tasks of one connection run serially on that single thread in submission order,
+        * while different connections still run in parallel. A connection's state is only ever touched by the same thread, so handlers need no per-connection locks and caches stay warm
+        * @note Lane tasks are never stolen, so a long task of one connection delays the other connections sharing its lane; keep this off (default) when task durations vary widely and let workers balance by stealing
+        * @note Must be called before startListen
+        * @param on true: on false: off (default)
+        */
+        void setTaskLanes(const bool &on=true){taskLanes=on;}
+        /**
+        * @brief Create a worker group (bulkhead)
+        * @note A group has its own threads and queue limit; assign routes to it with setRouteGroup. putTask tasks of those routes run only on the group's threads,
+        * while all other routes keep using the default worker pool. A slow route (e.g. report generation) that fills its group no longer delays light requests such as /ping or authentication
+        * @note When queued plus running tasks reach maxQueue, new tasks are rejected: HttpServer replies 503 Service Unavailable, TcpServer and WebSocketServer skip the message; the connection stays open in all cases. See getWorkerGroupStats
+        * @note Scheduling between groups is left to the kernel: a group with a higher nice value gets less time when the CPU is contended (about 1.25x per step), and at nice 19 it mostly runs only when other threads are idle. Negative nice needs CAP_SYS_NICE
+        * @note Must be called before startListen. Groups use the same CPUs as the default pool (see setAffinity), and setTaskLanes applies to their tasks as well
+        * @param name group name; an existing group with the same name is replaced
+        * @param threads number of threads
+        * @param maxQueue limit of queued plus running tasks; 0 means unlimited (default)
+        * @param nice nice value of the threads, default 0
+        * @return true: success false: invalid arguments or already listening
+        */
+        bool setWorkerGroup(const std::string &name,const int &threads,const int &maxQueue=0,const int &nice=0);
+        /**
+        * @brief Assign a route to a worker group
+        * @note key is the key used by setFunction (the request path for HttpServer and the message for WebSocketServer by default; change it with setGetKeyFunction)
+        * @note Must be called before startListen
+        * @param key route key
+        * @param group group name created by setWorkerGroup; empty removes the assignment and returns the route to the default pool
+        * @return true: success false: the group does not exist or already listening
+        */
+        bool setRouteGroup(const std::string &key,const std::string &group);
+        /**
+        * @brief Get the statistics of every worker group
+        */
+        std::vector<WorkerGroupStats> getWorkerGroupStats();
+        /**
+        * @brief Turn on queue-delay load shedding (CoDel)
+        * @note When the time putTask tasks spend between being queued and starting (their queue delay) stays above targetMs for intervalMs milliseconds, new putTask tasks are no longer queued:
+        * HttpServer answers at once (through setSecuritySendBackFun if one was set, otherwise 503 Service Unavailable), TcpServer and WebSocketServer call securitySendBackFun and skip the message;
+        * the connection stays open. One queue delay below targetMs, or the backlog fully draining, resumes queueing. Under overload this avoids doing work for clients that have already timed out
+        * @note The default pool and every worker group (see setWorkerGroup) are measured and shed separately; see getLoadShedStats
+        * @note Must be called before startListen
+        * @param targetMs acceptable queue delay in milliseconds; 0 turns it off (default)
+        * @param intervalMs how long the delay must stay above targetMs before shedding starts, in milliseconds; default 100
+        */
+        void setLoadShedding(const int &targetMs,const int &intervalMs=100){shedTargetUs=targetMs>0?targetMs*1000:0;shedIntervalUs=intervalMs>0?intervalMs*1000:100000;}
+        /**
+        * @brief Get the statistics of queue-delay load shedding
+        * @param group worker group name; empty returns the default pool's statistics (default)
+        */
+        LoadShedStats getLoadShedStats(const std::string &group="");
         /**
         * @brief Revoke TLS encryption, CA certificate, etc.
         */
         void redrawTLS();
         /**
+        * @brief Enable or disable kernel TLS (kTLS) offload
+        * @note When enabled, SSL_OP_ENABLE_KTLS is set on the SSL_CTX; after the handshake, if the kernel and the cipher suite support it, symmetric encryption is done by the kernel:
+        * - sending: responses are written to the socket with sendmsg/sendfile directly (static files go zero-copy through SSL_sendfile), with no user-space encryption or copy
+        * - receiving: still goes through SSL_read; OpenSSL gets plaintext from the kernel and still handles non-application records (alerts, key updates) correctly
+        * @note If the kernel tls module is not loaded or the suite is not supported, it falls back to user-space encryption and behaves as if disabled; whether it took effect is logged
+        * @note Can be called before or after setTLS, and only affects connections established afterwards
+        * @param on true: enable (default) false: disable
+        */
+        void setKTLS(const bool &on=true);
+        /**
  * @brief Set the callback invoked when an information security policy is violated.
  *
  * @details
@@ -3648,6 +5345,7 @@ void setGetKeyFunction(
         bool close();
         /**
         * @brief Close the connection of a specific socket
+        * @note If the connection's output queue still holds unsent data, the close waits until the reactor has flushed it (calling again or a connection error closes immediately)
         * @param fd Socket to be closed
         * @return true: Closed successfully, false: Failed to close
         */
@@ -3663,11 +5361,38 @@ void setGetKeyFunction(
         */
         bool isListen() { return flag; }
         /**
+        * @brief Return the number of I/O event loops (reactors)
+        */
+        int getReactorNum() { return reactorNum; }
+        /**
+        * @brief Return the event engine actually in use
+        * @note If io_uring was chosen at construction but the kernel lacks support, this returns EventEngine::EPOLL after startListen
+        */
+        EventEngine getEventEngine() { return engine; }
+        /**
         * @brief Query the connection with the server, pass in the socket, and return the encrypted SSL handle
         * @return Encrypted SSL pointer; returns nullptr if this fd does not exist or there is no encryption
         */
         SSL* getSSL(const int &fd);
         /**
+        * @brief Query the connection with the server, pass in the socket, and return its output queue
+        * @return The output queue; nullptr if this fd does not exist
+        */
+        std::shared_ptr<OutputBuffer> getOutputBuffer(const int &fd);
+        /**
+        * @brief Set the high and low water marks of every connection's output queue
+        * @note Only affects connections accepted afterwards; call before startListen
+        * @param highWater high-water mark in bytes; TcpFDHandler::isWritable returns false once the backlog reaches it (default 4MB)
+        * @param lowWater low-water mark in bytes; below it the connection is writable again and the callback from setWritableFunction is called (default 1MB)
+        */
+        void setOutputWaterMark(const size_t &highWater,const size_t &lowWater){this->outHighWater=highWater;this->outLowWater=lowWater;}
+        /**
+        * @brief Set the callback for a connection becoming writable again
+        * @note Called on the connection's reactor thread when its output queue went over the high-water mark and has dropped below the low-water mark; handlers can resume data they paused
+        * @param fc callback; the argument is the connection's socket
+        */
+        void setWritableFunction(std::function<void(const int &fd)> fc){this->writableFun=fc;}
+        /**
         * @brief Destructor of TcpServer class
         * @note Calls the close function to close
         */
@@ -3685,6 +5410,7 @@ void setGetKeyFunction(
 private:
     std::function<void(HttpServerFDHandler &k,HttpRequestInformation &inf)> securitySendBackFun=[](HttpServerFDHandler &k,HttpRequestInformation &inf)->void
         {};
+    bool securitySendBackSet=false;
     std::vector<std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)>> globalSolveFun;
     // std::function<bool(HttpServerFDHandler &k, HttpRequestInformation &inf)> globalSolveFun = {};
     std::unordered_map<
@@ -3697,12 +5423,14 @@ private:
             inf.ctx["key"] = inf.loc;
             return 1;
         };
-        HttpRequestInformation *httpinf;
+        ConnectionTable<HttpRequestInformation> httpinf;
+        std::vector<std::pair<std::string,std::string>> staticDir;
 
 private:
+    int serveStatic(HttpServerFDHandler &k,HttpRequestInformation &inf);//0: not a static path 1: responded -1: send failed
     void handler_netevent(const int &fd);
     void handler_workerevent(const int &fd, const int &ret);
-    void handleHeartbeat(){}
+    void handleHeartbeat(const int &id,const int &fd){}
 
 public:
     /**
@@ -3804,6 +5532,8 @@ public:
  * @param checkFrequency
  *        Frequency (in seconds) for checking zombie/idle connections.
  *        -1 disables zombie connection detection.
+ *        Each connection is expired individually on the reactor's timing
+ *        wheel (1 s resolution); any positive value just enables detection.
  *        Default: 30 seconds.
  *
  * @param connectionTimeout
@@ -3811,6 +5541,11 @@ public:
  *        it is considered a zombie connection.
  *        -1 means no timeout (infinite).
  *        Default: 30 seconds.
+ *
+ * @param engine
+ *        Event engine: EventEngine::EPOLL or EventEngine::IO_URING.
+ *        startListen falls back to epoll when the kernel lacks io_uring support.
+ *        Default: EventEngine::EPOLL.
  */
 HttpServer(
     const unsigned long long &maxFD = 1000000,
@@ -3823,7 +5558,8 @@ HttpServer(
     const int &requestSecs = 1,
     const int &requestTimes = 20,
     const int &checkFrequency = 30,
-    const int &connectionTimeout = 30
+    const int &connectionTimeout = 30,
+    const EventEngine &engine = EventEngine::EPOLL
 )
 : TcpServer(
       maxFD,
@@ -3836,11 +5572,21 @@ HttpServer(
       requestSecs,
       requestTimes,
       checkFrequency,
-      connectionTimeout
+      connectionTimeout,
+      engine
   )
 {
     serverType = 2;
+    httpinf.init(maxFD);
 }
+        /**
+        * @brief Set a static file directory
+        * @note When the request path (inf.loc) starts with prefix and has no handler, the rest of the path is appended to dir and that file is sent with HttpServerFDHandler::sendFile; a directory sends its index.html; a missing file gets 404 and a path containing .. gets 403
+        * @note Several can be set and are matched in order, before the global backup functions; paths are used as-is without percent-decoding
+        * @param prefix request path prefix, e.g. "/static/"
+        * @param dir local directory, e.g. "./www/"
+        */
+        void setStaticDirectory(const std::string &prefix,const std::string &dir){staticDir.emplace_back(prefix,dir);}
     /**
  * @brief Set the callback invoked when an information security policy is violated.
  *
@@ -3869,6 +5615,7 @@ HttpServer(
  * @note
  * The callback does not return a value.
  * The connection will be closed regardless of the outcome of the callback.
+ * When setLoadShedding sheds a request or a worker group is full, the rejected request is also answered through it (without closing the connection); if none was set, 503 Service Unavailable is sent.
  */
 void setSecuritySendBackFun(
     std::function<void(HttpServerFDHandler &k,
@@ -3876,6 +5623,7 @@ void setSecuritySendBackFun(
 )
 {
     this->securitySendBackFun = fc;
+    securitySendBackSet = true;
 }
 
         /**
@@ -3990,19 +5738,14 @@ void setSecuritySendBackFun(
      * @brief Start the HTTP server listening loop.
      * @param port The port to listen on.
      * @param threads Number of worker/consumer threads (default: 8).
+     * @param reactors Number of I/O event loops (default: 1), see TcpServer::startListen.
      * @return true if the server starts listening successfully,
      *         false otherwise.
      */
-    bool startListen(const int &port, const int &threads = 8)
+    bool startListen(const int &port, const int &threads = 8, const int &reactors = 1)
     {
-        httpinf = new HttpRequestInformation[maxFD];
-        return TcpServer::startListen(port, threads);
+        return TcpServer::startListen(port, threads, reactors);
     }
-
-    /**
-     * @brief Destructor.
-     */
-    ~HttpServer() {delete[] httpinf;}
 };
 
     /**
@@ -4020,6 +5763,9 @@ void setSecuritySendBackFun(
         * @param flag2 true: Enable SO_REUSEADDR mode, false: Do not enable SO_REUSEADDR mode (default is true, i.e., enable mode)
         */
         void setFD(const int &fd, SSL *ssl = nullptr, const bool &flag1 = false, const bool &flag2 = true) { TcpFDHandler::setFD(fd, ssl, flag1, flag2); }
+        using TcpFDHandler::setOutputBuffer;
+        using TcpFDHandler::getPendingBytes;
+        using TcpFDHandler::isWritable;
         /**
         * @brief Get a websocket message
         * @param Tcpinf saves the underlying TCP status information
@@ -4067,7 +5813,9 @@ void setSecuritySendBackFun(
     class WebSocketServer : public TcpServer
 {
 private:
-    std::unordered_map<int, WebSocketFDInformation> wbclientfd;
+    // one table per reactor, only touched by the reactor thread that owns the connection
+    std::vector<std::unordered_map<int, WebSocketFDInformation>> wbclientfd{1};
+    std::unordered_map<int, WebSocketFDInformation>& wbTable(const int &fd) { return wbclientfd[clientfd[fd].reactor]; }
     std::function<void(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> securitySendBackFun=[](WebSocketServerFDHandler &k,WebSocketFDInformation &inf)->void
         {};
 
@@ -4110,7 +5858,7 @@ private:
 
     
 
-    void handleHeartbeat();
+    void handleHeartbeat(const int &id,const int &fd);
 
     bool closeWithoutLock(const int &fd, const std::string &closeCodeAndMessage);
     bool closeWithoutLock(const int &fd, const short &code = 1000, const std::string &message = "bye");
@@ -4210,6 +5958,8 @@ public:
  * @param checkFrequency
  *        Frequency (in seconds) for checking zombie/idle connections.
  *        -1 disables zombie connection detection.
+ *        Each connection is expired individually on the reactor's timing
+ *        wheel (1 s resolution); any positive value just enables detection.
  *        Default: 60 seconds.
  *
  * @param connectionTimeout
@@ -4217,6 +5967,11 @@ public:
  *        it is considered a zombie connection.
  *        -1 means no timeout (infinite).
  *        Default: 120 seconds.
+ *
+ * @param engine
+ *        Event engine: EventEngine::EPOLL or EventEngine::IO_URING.
+ *        startListen falls back to epoll when the kernel lacks io_uring support.
+ *        Default: EventEngine::EPOLL.
  */
 WebSocketServer(
     const unsigned long long &maxFD = 1000000,
@@ -4229,7 +5984,8 @@ WebSocketServer(
     const int &requestSecs = 1,
     const int &requestTimes = 10,
     const int &checkFrequency = 60,
-    const int &connectionTimeout = 120
+    const int &connectionTimeout = 120,
+    const EventEngine &engine = EventEngine::EPOLL
 )
 : TcpServer(
       maxFD,
@@ -4242,7 +5998,8 @@ WebSocketServer(
       requestSecs,
       requestTimes,
       checkFrequency,
-      connectionTimeout
+      connectionTimeout,
+      engine
   )
 {
     serverType = 3;
@@ -4413,6 +6170,7 @@ void setSecuritySendBackFun(
     {
         WebSocketServerFDHandler k;
         k.setFD(fd, getSSL(fd), unblock);
+        k.setOutputBuffer(getOutputBuffer(fd));
         return k.sendMessage(msg, type);
     }
 
@@ -4430,11 +6188,15 @@ void setSecuritySendBackFun(
      * @brief Start the WebSocket server.
      * @param port Listening port.
      * @param threads Number of worker threads (default: 8).
+     * @param reactors Number of I/O event loops (default: 1), see TcpServer::startListen.
      */
-    bool startListen(const int &port, const int &threads = 8)
+    bool startListen(const int &port, const int &threads = 8, const int &reactors = 1)
     {
         //std::thread(&WebSocketServer::HB, this).detach();
-        return TcpServer::startListen(port, threads);
+        if (reactors <= 0)
+            return false;
+        wbclientfd.assign(reactors, {});
+        return TcpServer::startListen(port, threads, reactors);
     }
 
     /**
@@ -5022,21 +6784,62 @@ void setSecuritySendBackFun(
             }
         };
 
+        /**
+        * @brief Static utility class for CPU affinity and NUMA topology
+        * @note The topology is read from /sys/devices/system without libnuma; if it cannot be read, the machine is treated as a single node (node 0)
+        */
+        class CPUAffinity
+        {
+        public:
+            /**
+            * @brief Get the number of NUMA nodes
+            */
+            static int nodeCount();
+            /**
+            * @brief Get the NUMA node of a CPU
+            * @return node number, 0 if it cannot be read
+            */
+            static int nodeOfCPU(const int &cpu);
+            /**
+            * @brief Get the NUMA node of the CPU the current thread is running on
+            */
+            static int currentNode();
+            /**
+            * @brief Pin the current thread to cpus
+            * @param cpus set of CPU numbers; nothing happens when empty
+            * @return true: success (or cpus is empty) false: failure (e.g. a CPU does not exist)
+            */
+            static bool bindThread(const std::vector<int> &cpus);
+            /**
+            * @brief Get the set of CPUs the current thread may run on
+            */
+            static std::vector<int> threadCPUs();
+            /**
+            * @brief Format a CPU set as "0-3,8(node0)" for logging
+            * @param cpus set of CPU numbers; returns "unpinned" when empty
+            */
+            static std::string describe(const std::vector<int> &cpus);
+        };
+
         using Task = std::function<void()>;
         /**
         * @class WorkerPool
-        * @brief Fixed-size worker thread pool
+        * @brief Fixed-size work-stealing worker thread pool
         *
-        * WorkerPool Internally, it maintains a task queue and several worker threads.
-        * Each worker thread takes a task from the queue and executes it in a loop.
+        * Every worker thread owns a local task queue. Tasks submitted from outside (e.g. the reactor) go into a lock-free MPSC inbox;
+        * an idle worker moves them in batches into its own local queue, and other idle workers steal half of a busy worker's queue.
+        * Workers with nothing to do sleep on a futex, and submitters only make a system call when some worker is actually asleep.
         *
         * ## characteristic
         * - Fixed number of threads
-        * - Thread-safe task submission
+        * - Thread-safe task submission with no global lock on the submit path
+        * - Tasks submitted from inside a worker go straight into that worker's local queue
+        * - When the inbox is full, submission falls back to a locked overflow queue, so no task is lost
+        * - submitTo() puts a task into the ordered lane of a fixed worker chosen by key, so tasks with the same key run serially
         * - Supports graceful shutdown.
         *
         * ## Thread safety instructions
-        * - submit() is thread-safe
+        * - submit() and submitTo() are thread-safe
         * - stop() is thread-safe
         *
         * ## Usage example
@@ -5055,16 +6858,31 @@ void setSecuritySendBackFun(
             * @brief Constructor, creates a specified number of worker threads.
             *
             * @param n Number of worker threads
+            * @param cpus worker i is pinned to the CPU cpus[i%cpus.size()]; empty means unpinned (default)
+            * @param nice nice value of the worker threads; when the CPU is contended the kernel shares time by it (about 1.25x per step). Default 0; negative values need CAP_SYS_NICE and stay 0 if setting fails
             *
             * Once constructed, all threads start immediately and enter a waiting state.
+            * Each worker pins itself before creating its local queue, so the queue's memory lives on its NUMA node.
             */
-            explicit WorkerPool(size_t n):stop_(false)
+            explicit WorkerPool(size_t n,const std::vector<int> &cpus={},const int &nice=0):inbox_(inboxCapacity),stop_(false)
             {
+                workers_.resize(n);
                 for (size_t i = 0; i < n; ++i) {
-                    threads_.emplace_back([this] {
-                        this->workerLoop();
+                    int cpu=cpus.empty()?-1:cpus[i%cpus.size()];
+                    threads_.emplace_back([this,i,cpu,nice] {
+                        if(cpu>=0)
+                            CPUAffinity::bindThread({cpu});
+                        if(nice!=0)
+                            setpriority(PRIO_PROCESS,(id_t)syscall(SYS_gettid),nice);
+                        workers_[i].reset(new Worker());
+                        ready_.fetch_add(1,std::memory_order_release);
+                        while(ready_.load(std::memory_order_acquire)<workers_.size())
+                            std::this_thread::yield();
+                        this->workerLoop(i);
                     });
                 }
+                while(ready_.load(std::memory_order_acquire)<n)
+                    std::this_thread::yield();
             }
             /**
             * @brief destructor
@@ -5081,15 +6899,53 @@ void setSecuritySendBackFun(
             *
             * @param task Callable objects, with the function signature void()
             *
-            * The task is placed in an internal queue and executed asynchronously by a worker thread.
+            * Tasks from outside threads go into the lock-free inbox (or the overflow queue when it is full);
+            * tasks from a worker thread go into its local queue. At most one sleeping worker is then woken.
             */
             void submit(Task task) 
             {
+                pending_.fetch_add(1,std::memory_order_relaxed);
+                if(currentPool()==this)
+                {
+                    Worker &w=*workers_[currentIndex()];
+                    std::lock_guard<std::mutex> lk(w.mtx);
+                    w.tasks.push_back(std::move(task));
+                }
+                else if(!inbox_.push(std::move(task)))
+                {
+                    std::lock_guard<std::mutex> lk(overflowMtx_);
+                    overflow_.push_back(std::move(task));
+                    overflowCount_.fetch_add(1,std::memory_order_release);
+                }
+                wakeOne();
+            }
+            /**
+            * @brief Submit a task to the execution lane of key
+            *
+            * @param key lane key; tasks with the same key always run on worker key%n
+            * @param task Callable objects, with the function signature void()
+            *
+            * Every worker owns one lane. Tasks in a lane run only on that worker, one after another in submission order, and are never stolen.
+            * Tasks with the same key (e.g. the same connection) therefore run serially and always on the same thread, while different keys still run in parallel;
+            * the price is that a long task delays the tasks queued behind it in the same lane.
+            */
+            void submitTo(uint64_t key,Task task)
+            {
+                if(workers_.empty())
                 {
-                    std::lock_guard<std::mutex> lk(mtx_);
-                    tasks_.push(std::move(task));
+                    submit(std::move(task));
+                    return;
                 }
-                cv_.notify_one();
+                Worker &w=*workers_[key%workers_.size()];
+                w.lanePending.fetch_add(1,std::memory_order_relaxed);
+                // While the overflow queue holds tasks, later ones follow it there to keep their order
+                if(w.laneOverflowCount.load(std::memory_order_acquire)!=0||!w.lane.push(std::move(task)))
+                {
+                    std::lock_guard<std::mutex> lk(w.laneMtx);
+                    w.laneOverflow.push_back(std::move(task));
+                    w.laneOverflowCount.fetch_add(1,std::memory_order_release);
+                }
+                wakeWorker(w);
             }
             /**
              * @brief Stop the thread pool and wait for all threads to exit.
@@ -5103,11 +6959,9 @@ void setSecuritySendBackFun(
             */
             void stop() 
             {
-                {
-                    std::lock_guard<std::mutex> lk(mtx_);
-                    stop_ = true;
-                }
-                cv_.notify_all();
+                stop_.store(true,std::memory_order_release);
+                for(auto &w:workers_)
+                    wakeWorker(*w);
                 for (auto &t : threads_) 
                 {
                     if (t.joinable()) t.join();
@@ -5115,43 +6969,220 @@ void setSecuritySendBackFun(
             }
 
         private:
+            static constexpr size_t inboxCapacity=4096;
+            static constexpr size_t inboxBatch=32;
+            static constexpr size_t laneCapacity=1024;
+            static constexpr int idleSpinRounds=64;
+
+            // One per worker on its own cache line; the owner takes from the front, thieves take from the back
+            struct alignas(64) Worker
+            {
+                std::mutex mtx;
+                std::deque<Task> tasks;
+                Task batch[inboxBatch];
+                // Ordered lane run only by this worker; overflows into a locked deque
+                MPSCQueue<Task> lane{laneCapacity};
+                std::mutex laneMtx;
+                std::deque<Task> laneOverflow;
+                std::atomic<size_t> laneOverflowCount{0};
+                std::atomic<size_t> lanePending{0};
+                std::atomic<uint32_t> parked{0};
+            };
+
+            static WorkerPool*& currentPool()
+            {
+                thread_local WorkerPool *pool=nullptr;
+                return pool;
+            }
+            static size_t& currentIndex()
+            {
+                thread_local size_t index=0;
+                return index;
+            }
+
             /**
             * @brief Worker thread main loop
             *
             * This function will be executed by each worker thread:
-            * - Waiting for a task or stop signal on a condition variable.
-            * - Retrieve tasks from the task queue.
+            * - Take a task from its own lane, then the local queue, then the inbox, then other workers' queues.
             * - perform tasks
+            * - While tasks are still pending, yield and retry; otherwise spin briefly and sleep on the futex.
             *
-            * The thread exits when stop_ is true and the task queue is empty.
+            * The thread exits when stop_ is true and no task is pending.
             */
-            void workerLoop() 
+            void workerLoop(size_t self) 
             {
+                currentPool()=this;
+                currentIndex()=self;
+                Worker &w=*workers_[self];
+                Task task;
+                int idle=0;
                 while (true) 
                 {
-                    Task task;
+                    if(takeLane(w,task))
                     {
-                        std::unique_lock<std::mutex> lk(mtx_);
-                        cv_.wait(lk, [this] {
-                        return stop_ || !tasks_.empty();
-                        });
-                        if (stop_ && tasks_.empty())
-                        {
-                            return;
-                        }
-                        task = std::move(tasks_.front());
-                        tasks_.pop();
+                        w.lanePending.fetch_sub(1,std::memory_order_relaxed);
+                        task();
+                        task=nullptr;
+                        idle=0;
+                        continue;
+                    }
+                    if(takeTask(self,task))
+                    {
+                        pending_.fetch_sub(1,std::memory_order_relaxed);
+                        task(); // perform tasks
+                        task=nullptr;
+                        idle=0;
+                        continue;
+                    }
+                    if(pending_.load(std::memory_order_acquire)>0||w.lanePending.load(std::memory_order_acquire)>0||++idle<idleSpinRounds)
+                    {
+                        std::this_thread::yield();
+                        continue;
+                    }
+                    if(stop_.load(std::memory_order_acquire))
+                        return;
+                    park(w);
+                    idle=0;
+                }
+            }
+            // The overflow queue is only read once the lane is empty; together with submitTo this keeps submission order
+            bool takeLane(Worker &w,Task &task)
+            {
+                if(w.lane.pop(task))
+                    return true;
+                if(w.laneOverflowCount.load(std::memory_order_acquire)==0)
+                    return false;
+                std::lock_guard<std::mutex> lk(w.laneMtx);
+                if(w.laneOverflow.empty())
+                    return false;
+                task=std::move(w.laneOverflow.front());
+                w.laneOverflow.pop_front();
+                w.laneOverflowCount.fetch_sub(1,std::memory_order_release);
+                return true;
+            }
+            bool takeTask(size_t self,Task &task)
+            {
+                Worker &w=*workers_[self];
+                {
+                    std::lock_guard<std::mutex> lk(w.mtx);
+                    if(!w.tasks.empty())
+                    {
+                        task=std::move(w.tasks.front());
+                        w.tasks.pop_front();
+                        return true;
+                    }
+                }
+                return drainInbox(w,task)||steal(self,task);
+            }
+            // The inbox is single-consumer, so only one worker may drain it at a time
+            bool drainInbox(Worker &w,Task &task)
+            {
+                size_t n=0;
+                if(!inboxBusy_.exchange(true,std::memory_order_acquire))
+                {
+                    n=inbox_.pop_bulk(w.batch,inboxBatch);
+                    inboxBusy_.store(false,std::memory_order_release);
+                }
+                if(n==0&&overflowCount_.load(std::memory_order_acquire)>0)
+                {
+                    std::lock_guard<std::mutex> lk(overflowMtx_);
+                    while(n<inboxBatch&&!overflow_.empty())
+                    {
+                        w.batch[n++]=std::move(overflow_.front());
+                        overflow_.pop_front();
+                    }
+                    overflowCount_.fetch_sub(n,std::memory_order_relaxed);
+                }
+                if(n==0)
+                    return false;
+                task=std::move(w.batch[0]);
+                if(n>1)
+                {
+                    {
+                        std::lock_guard<std::mutex> lk(w.mtx);
+                        for(size_t i=1;i<n;++i)
+                            w.tasks.push_back(std::move(w.batch[i]));
+                    }
+                    // Let a sleeping worker steal the rest of the batch
+                    wakeOne();
+                }
+                return true;
+            }
+            // Steal half of another worker's queue from its back; skip it if the lock is busy rather than block
+            bool steal(size_t self,Task &task)
+            {
+                Worker &w=*workers_[self];
+                size_t n=workers_.size();
+                for(size_t k=1;k<n;++k)
+                {
+                    Worker &victim=*workers_[(self+k)%n];
+                    std::unique_lock<std::mutex> lk(victim.mtx,std::try_to_lock);
+                    if(!lk.owns_lock()||victim.tasks.empty())
+                        continue;
+                    size_t take=std::min((victim.tasks.size()+1)/2,inboxBatch);
+                    for(size_t i=0;i<take;++i)
+                    {
+                        w.batch[i]=std::move(victim.tasks.back());
+                        victim.tasks.pop_back();
+                    }
+                    lk.unlock();
+                    // batch is in reverse order; run the oldest task first
+                    task=std::move(w.batch[take-1]);
+                    if(take>1)
+                    {
+                        std::lock_guard<std::mutex> own(w.mtx);
+                        for(size_t i=take-1;i-->0;)
+                            w.tasks.push_back(std::move(w.batch[i]));
                     }
-                    task(); // perform tasks
+                    return true;
+                }
+                return false;
+            }
+            // Register as a sleeper before re-checking for work; pairs with wakeOne/wakeWorker's "publish, then check sleepers" so no wakeup is lost
+            void park(Worker &w)
+            {
+                w.parked.store(1,std::memory_order_relaxed);
+                sleepers_.fetch_add(1,std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(pending_.load(std::memory_order_relaxed)==0&&w.lanePending.load(std::memory_order_relaxed)==0&&!stop_.load(std::memory_order_relaxed))
+                    syscall(SYS_futex,reinterpret_cast<uint32_t*>(&w.parked),FUTEX_WAIT_PRIVATE,1,nullptr,nullptr,0);
+                w.parked.store(0,std::memory_order_relaxed);
+                sleepers_.fetch_sub(1,std::memory_order_relaxed);
+            }
+            bool wakeWorker(Worker &w)
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(w.parked.load(std::memory_order_relaxed)==0||w.parked.exchange(0)==0)
+                    return false;
+                syscall(SYS_futex,reinterpret_cast<uint32_t*>(&w.parked),FUTEX_WAKE_PRIVATE,1,nullptr,nullptr,0);
+                return true;
+            }
+            // Shared work can run anywhere, so wake any one sleeping worker
+            void wakeOne()
+            {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if(sleepers_.load(std::memory_order_relaxed)==0)
+                    return;
+                for(auto &w:workers_)
+                {
+                    if(wakeWorker(*w))
+                        return;
                 }
             }
 
         private:
+            std::vector<std::unique_ptr<Worker>> workers_;
             std::vector<std::thread> threads_;
-            std::queue<Task> tasks_;
-            std::mutex mtx_;
-            std::condition_variable cv_;
-            bool stop_;
+            MPSCQueue<Task> inbox_;
+            alignas(64) std::atomic<bool> inboxBusy_{false};
+            std::mutex overflowMtx_;
+            std::deque<Task> overflow_;
+            std::atomic<size_t> overflowCount_{0};
+            alignas(64) std::atomic<long> pending_{0};
+            alignas(64) std::atomic<int> sleepers_{0};
+            std::atomic<bool> stop_;
+            std::atomic<size_t> ready_{0};
         };
     }
 
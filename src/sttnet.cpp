@@ -1,9424 +1,11282 @@
-#include"../include/sttnet.h"
-using namespace std;
-using namespace stt::file;
-using namespace stt::time;
-using namespace stt::data;
-using namespace stt::network;
-using namespace stt::system;
-
-
-            //思路：先从尾到头遍历检查看看哪里的目录是不存在的，边检查边逐级创建
-bool stt::file::FileTool::createDir(const string & ddir,const mode_t &mode)
-{	
-	string k=ddir;
-	string test;
-	size_t ii=1;
-	while(1)
-	{	
-		if((ii=k.find('/',ii))==string::npos)//已经是最顶层
-		{	
-			if(access(k.c_str(),F_OK)<0)//不存在就创建
-			{
-				if(mkdir(k.c_str(),mode)<0)
-				{
-					//cout<<k<<endl;
-					perror("mkdir() fail");
-					return false;
-				}
-			}
-			break;
-		}
-		//非最顶层
-		test=k.substr(0,ii);
-		if(access(test.c_str(),F_OK)<0)//不存在就创建
-		{
-                                if(mkdir(test.c_str(),mode)<0)
-                                {
-                                        //cout<<test<<endl;
-                                        perror("mkdir() fail");
-					return false;
-                                }
-                        
-		}
-		ii++;
-	}		
-	return true;
-}
-bool stt::file::FileTool::createFile(const string &filePath,const mode_t &mode)
-{
-    if(access(filePath.c_str(),F_OK)==0)//检查文件是否已经存在
-    {
-        //cerr<<"file has already exist"<<endl;
-        return true;
-    }
-    //创建路径
-    size_t ii=filePath.rfind("/");
-    string path=filePath;
-    if(ii!=string::npos)
-    {
-        path.erase(ii);
-        if(createDir(path,0775)==false)
-        {
-            cerr<<"create path fail"<<endl;
-            return false;
-        }
-    }
-    //创建文件
-    int fd=open(filePath.c_str(),O_CREAT|O_EXCL,mode);
-    if(fd<0)
-    {
-        perror("open() fail");
-        return false;
-    }
-    //关闭文件
-    ::close(fd);
-    return true;
-}
-bool stt::file::FileTool::copy(const string &a,const string &b)
-{
-	ifstream a1;
-	ofstream b1;
-	a1.open(a,ios::in);
-	b1.open(b,ios::out);
-//	if(a1.is_open()==false||b1.is_open()==false)
-//		return false;
-	string kk;
-	while(getline(a1,kk))
-	      b1<<kk<<endl;
-	a1.close();
-	b1.close();
-	return true;
-}
-    size_t stt::file::FileTool::get_file_size(const string &fileName)
-    {
-        struct stat st;
-        if(stat(fileName.c_str(),&st)==0)
-        {
-            return st.st_size;
-        }
-        else
-            return -1;
-    }
-    mutex File::l1;
-    unordered_map<string,FileThreadLock> File::fl2;
-    bool stt::file::File::closeFile(const bool &del)
-    {
-        bool ok=true;
-        if(!isOpen())//检查是否对象打开了文件
-        {
-            cerr<<"没有打开文件"<<endl;
-            return false;
-        }
-        //看是否需要unlockmemory
-        //如果还是锁住说明是突然关闭，那么理应回退内存，操作失败 
-        unique_lock<mutex> testlock(che,try_to_lock);
-        if(!testlock.owns_lock())//拿不到锁
-        {
-            unlockMemory(true);
-        }
-
-        //关闭锁注册表
-        //if(l1use)
-        unique_lock<mutex> lock2(l1);
-        auto ii=fl2.find(fileName);
-        if(ii!=fl2.end())
-        {
-        if(ii->second.threads==1)
-        {
-            fl2.erase(ii);
-        }
-        else
-            ii->second.threads--;
-        }
-        //if(l1use)
-        lock2.unlock();
-        //关闭读流
-        fin.clear();//清除文件数据流
-        fin.close();
-
-        //if(fin.fail())
-        //{
-        //   perror("fin close() fail");
-        //    ok=false;
-        //}
-        if(del==true)
-        {
-            if(remove(fileName.c_str())!=0)
-            {
-                perror("file delete() fail");
-                ok=false;
-            }
-        }
-        //清除内存数据
-        if(binary)
-            data.clear();
-        else
-        {
-            if(data_binary!=nullptr)
-            {
-                delete[] data_binary;
-                data_binary=nullptr;
-            }
-            if(backUp_binary!=nullptr)
-            {
-                delete[] backUp_binary;
-                backUp_binary=nullptr;
-            }
-        }
-        //关闭fd
-        //::close(fd);
-        //fd=-1;
-        //完成
-        flag=false;
-        return ok;
-        
-    }
-    bool stt::file::File::toDisk()//创造临时文件 加锁 写 覆盖原文件。不在源文件直接写是怕清空内容后来不及写就发生故障 文字消失 (就算前面主文件有读写锁了，只能保证在这个类的操作不会影响这个临时文件，不代表其他不会，所以一样要加上读锁)
-    {
-        //创建一个临时文件
-        int fdd=open(fileNameTemp.c_str(),O_RDWR|O_CREAT,mode);//问了进程锁 用posix的接口打开文件
-        if(fdd<0)
-        {
-            cerr<<"临时文件创建失败"<<endl;
-            return false;
-        }
-        //打开临时文件
-        if(binary)
-        {
-            fout.open(fileNameTemp,ios::binary);
-            if(!fout.is_open())
-            {
-                perror("tempfile fout open() fail");
-                fout.clear();
-                fout.close();
-                ::close(fdd);
-                return false;
-            }
-            fout.write(data_binary,size1);
-            
-            size=size1;
-        }
-        else
-        {
-            fout.open(fileNameTemp,ios::trunc);
-            if(!fout.is_open())
-            {
-                perror("tempfile fout open() fail");
-                fout.clear();
-                fout.close();
-                ::close(fdd);
-                return false;
-            }
-            fout<<unitbuf;//不启用缓冲区
-
-            //把内存数据存到一个字符串
-            string dataa;
-            for(auto &ii:this->data)
-            {
-                dataa+=ii+"\n";
-            }
-            if(dataa!="")
-                dataa.erase(dataa.size()-1);
-
-            fout<<dataa;
-
-            totalLines=this->data.size();
-        }
-        
-        fout.clear();
-        fout.close();
-        if(fout.fail())
-        {
-            perror("temp fout close() fail");
-            ::close(fdd);
-            return false;
-        }
-        if(rename(fileNameTemp.c_str(),fileName.c_str())<0)
-		{
-			perror("temp rename() fail");
-            ::close(fdd);
-			return false;
-		}
-        ::close(fdd);
-        return true;
-    }
-
-    void stt::file::File::toMemory()
-    {
-        fin.close();
-        if(binary)
-        {
-            /*
-            fin.open(fileName,ios::binary);
-            fin.seekg(0,ios::end);
-            streampos file_size = fin.tellg(); // 获取文件大小
-            size=static_cast<size_t>(file_size);
-
-            fin.seekg(0,ios::beg);
-            */
-            if(data_binary!=nullptr)
-                delete[] data_binary;
-            if(backUp_binary!=nullptr)
-                delete[] backUp_binary;
-            size=FileTool::get_file_size(fileName);
-            fin.open(fileName,ios::binary);
-            
-            if(multiple_backup==0)
-            {
-                malloced=size*multiple;
-            }
-            else
-            {
-                malloced=multiple_backup;
-            }
-            
-            data_binary=new char[malloced];
-            backUp_binary=new char[malloced];
-
-            fin.read(data_binary,size);
-            memcpy(backUp_binary,data_binary,size);
-
-            size1=size;
-            size2=size;
-        }
-        else
-        {
-            fin.open(fileName,ios::in);
-            string dataa;
-            data.clear();
-            fin.seekg(0, ios::beg); 
-            while(1)
-            {
-                getline(fin,dataa);
-                if(fin)
-                {
-                    //cout<<"+dataa:"<<dataa<<endl;
-                    data.push_back(dataa);
-                }
-                else
-                {
-                    //fin.seekg(0,ios::beg);
-                    break;
-                }
-            }
-            totalLines=data.size();
-        }
-        
-        //fin.seekg(0, ios::end); // 移动到文件末尾
-        //streampos file_size = fin.tellg(); // 获取文件大小
-        //size=static_cast<size_t>(file_size);
-    }
-    bool stt::file::File::openFile(const string & fileName,const bool &create,const int &multiple,const size_t &size,const mode_t &mode)
-    {
-        if(isOpen())
-        {
-            if(!closeFile(false))
-            {
-                cerr<<"对象无法关闭已经打开的文件"<<endl;
-                return false;
-            }
-        }
-        if(!create)
-        {
-            if(access(fileName.c_str(),F_OK)!=0)//检查文件是否已经存在
-                return false;
-        }
-        this->mode=mode;
-        if(multiple>=1)
-        {
-            this->binary=true;
-            this->multiple=multiple;
-            this->multiple_backup=size;
-        }
-        else
-            this->binary=false;
-        this->fileName=fileName;
-        this->fileNameTemp=fileName+".temp";
-        if(!createFile(fileName,mode))
-        {
-            cerr<<"文件不存在 且创建文件失败"<<endl;
-            return false;
-        }
-        //读文件流
-        /*
-        //std::ios::in：打开文件用于读取（默认模式）。
-	    //std::ios::out：打开文件用于写入。
-	    //std::ios::app：打开文件用于追加写入，文件指针移动到文件末尾。
-	    //std::ios::binary：以二进制模式打开文件，用于处理二进制数据。
-        */
-        if(binary)
-        {
-            fin.open(fileName,ios::binary);
-        }
-        else
-        {
-            fin.open(fileName,ios::in);
-        }
-        if(!fin.is_open())
-        {
-            perror("file fin open() fail");
-            return false;
-        }
-        
-        //把数据读入到容器
-        //toMemory();
-        //if(l1use)
-        unique_lock<mutex> lock2(l1);
-        auto ii=fl2.find(fileName);
-        if(ii!=fl2.end())
-            ii->second.threads++;
-        else
-        {
-            File::fl2.emplace(piecewise_construct,forward_as_tuple(fileName),forward_as_tuple(fileName,1));
-        }
-        //if(l1use)
-        lock2.unlock();
-        flag=true;
-        return flag;
-    }
-    string& stt::file::File::read(string &data,const int &linePos,const int &num)
-    {
-        unique_lock<mutex> lock1(fl1); //因为要调用size函数 所以要上锁小心改变
-        toMemory();
-        
-        return readC(data,linePos,num);
-    }
-    string& stt::file::File::readC(string &data,const int &linePos,const int &num)
-    {
-        data="";
-        if(!isOpen())
-            return data;
-        if(linePos<=this->data.size()&&(linePos+num-1)<=this->data.size())
-        {
-            int ii=1;
-            while(ii<=num)
-            {
-                data+=this->data[linePos-1+ii-1]+"\n";
-                ii++;
-            }
-            if(data!="")
-                data.erase(data.size()-1);
-            return data;
-        }
-        else
-            return data;
-    }
-    bool stt::file::File::readLine(string &data,const int linePos)
-    {
-        unique_lock<mutex> lock1(fl1); //因为要调用size函数 所以要上锁小心改变
-        toMemory();
-        
-        return readLineC(data,linePos);
-    }
-    
-    bool stt::file::File::readLineC(string &data,const int linePos)
-    {
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return false;
-        }
-        if(this->data.size()<linePos)
-            return false;
-        data=this->data[linePos-1];
-        return true;
-    }
-    
-    string& stt::file::File::readAll(string &data)
-    {
-        unique_lock<mutex> lock1(fl1);//由于是read，不需要加锁（要确保读写统一性请组合操作 组合操作前后操作锁），因为要遍历容器，所以要上内存的容器锁
-        toMemory();
-        readAllC(data);
-        return data;
-    }
-    
-    string& stt::file::File::readAllC(string &data)
-    {
-        data="";
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return data;
-        }
-        
-        for(auto &ii:this->data)
-        {
-            data+=ii+"\n";
-        }
-
-        if(data!="")
-            data.erase(data.size()-1);
-        return data;
-    }
-    
-    void stt::file::File::lockfl2()
-    {
-        //if(l1use)
-        unique_lock<mutex> lock2(l1);
-        auto ii=fl2.find(fileName);
-        if(ii==fl2.end())
-        {
-            //cout<<fileName<<endl;
-            //cout<<"lock找不到文件"<<endl;
-        }
-        else
-            ii->second.lock.lock();
-    }
-    void stt::file::File::unlockfl2()
-    {
-        //if(l1use)
-        unique_lock<mutex> lock2(l1);
-        auto ii=fl2.find(fileName);
-        //if(ii==fl2.end())
-            //cout<<"unlock找不到文件"<<endl;
-        //else
-        if(ii!=fl2.end())
-            ii->second.lock.unlock();
-    }
-    bool stt::file::File::lockMemory()
-    {
-        //if(fd<0)
-        //{
-        //    fd=open(fileName.c_str(),O_RDWR,mode);//问了进程锁 用posix的接口打开文件
-        //    if(fd<0)
-        //    {
-        //        cerr<<"fd打开文件失败"<<endl;
-        //        return false;
-        //    }
-        //}
-        //if(flag_lock)
-        //    unlockMemory(true);
-        //flag_lock=true;
-        che.lock();
-        //线程上锁
-        lockfl2();
-         // 获取文件锁
-        //struct flock fl;
-        //fl.l_type = F_RDLCK;  // 写入锁
-        //fl.l_whence = SEEK_SET;
-        //fl.l_start = 0;
-        //fl.l_len = 0;
-        //if (fcntl(fd, F_SETLKW, &fl) == -1)
-		//{
-        //    ::close(fd);
-        //    fd=-1;
-        //    cerr << getpid()<<":failed to acquire lock." <<endl;
-        //    return false;
-        //}
-        //File::fl2.lock();
-        fl1.lock();
-        toMemory();
-        backUp=data;
-        return true;
-    }
-    bool stt::file::File::unlockMemory(const bool &rec)
-    {
-        //if(!chee.owns_lock())
-        //    return false;
-        //struct flock fl;
-        //fl.l_type = F_UNLCK;  // 解锁
-        //fl.l_whence = SEEK_SET;
-        //fl.l_start = 0;
-        //fl.l_len = 0;
-        //flag_lock=false;
-        if(rec||!toDisk())
-        {
-            //释放原来文件的锁
-            //File::fl2.unlock();
-            //if (fcntl(fd, F_SETLK, &fl) == -1) 
-	        //{
-            //    cerr << getpid()<< "Failed to unlock file" << endl;
-		    //    perror("unlock");
-            //    //::close(fd);
-            //    //fd不可以取消,取消了就无法处理没解锁的情况了
-            //    //return false;
-            //}
-            //close(fd);
-            //fd=-1;
-            unlockfl2();
-            if(!binary)
-                data=backUp;
-            else
-            {
-                memcpy(data_binary,backUp_binary,size2);
-                size1=size2;
-            }
-
-            if(rec==false)
-            {
-                fl1.unlock();
-                //flag_lock=false;
-                che.unlock();
-                return false;
-            }
-            else
-            {
-                fl1.unlock();
-                //flag_lock=false;
-                che.unlock();
-                return true;//因为别的原因（导入了参数，而参数来自其他操作）需要回退内存也是返回false
-            }
-        }
-        else
-        {
-            //释放原来文件的锁
-            //File::fl2.unlock();
-            //if (fcntl(fd, F_SETLK, &fl) == -1) 
-	        //{
-            //    cerr << getpid()<< "Failed to unlock file" << endl;
-		    //    perror("unlock");
-            //    //::close(fd);
-            //    //fd不可以取消
-            //    //return false;
-            //}
-            //close(fd);
-            //fd=-1;
-            unlockfl2();
-            fl1.unlock();
-            //flag_lock=false;
-            che.unlock();
-            return true;
-        }
-    }
-    int stt::file::File::findC(const string &targetString,const int linePos)
-    {
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return -1;
-        }
-        if(this->data.size()<linePos)
-            return -1;
-        for(int pos=linePos;pos<=this->data.size();pos++)
-        {
-            if(this->data[pos-1].find(targetString)!=string::npos)
-            {
-                return pos;
-            }
-        }
-        return -1;
-    }
-    int stt::file::File::find(const string &targetString,const int linePos)
-    {
-        int rec;
-        //fl1.lock();//不涉及内存改变 正常加锁就行
-        unique_lock<mutex> lock1(fl1);
-        //new:需要加锁（内存容器的） 因为调用了size函数
-        toMemory();
-        rec=findC(targetString,linePos);
-        //lock1.unlock();
-        return rec;
-    }
-    bool stt::file::File::appendLineC(const string &data,const int &linePos)
-    {
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return false;
-        }
-        if(linePos==0)
-        {
-            this->data.push_back(data);
-        }
-        else
-        {
-            if(linePos>this->data.size())
-            {
-                cerr<<"插入行无法定位"<<endl;
-                return false;
-            }
-            this->data.insert(this->data.begin()+linePos-1,data);
-        }
-        return true;
-
-    }
-    bool stt::file::File::appendLine(const string &data,const int &linePos)
-    {
-        if(!lockMemory())
-            return false;
-        return unlockMemory(!appendLineC(data,linePos));
-    }
-    bool stt::file::File::deleteLineC(const int &linePos)
-    {
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return false;
-        }
-        if(linePos==0)
-        {
-            this->data.pop_back();
-        }
-        else
-        {
-            if(linePos>this->data.size())
-            {
-                cerr<<"删除行无法定位"<<endl;
-                return false;
-            }
-            this->data.erase(this->data.begin()+linePos-1);
-        }
-        return true;
-    }
-    bool stt::file::File::deleteLine(const int &linePos)
-    {
-        if(!lockMemory())
-            return false;
-        return unlockMemory(!deleteLineC(linePos));
-    }
-    bool stt::file::File::deleteAllC()
-    {
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return false;
-        }
-        this->data.clear();
-        return true;
-    }
-    bool stt::file::File::deleteAll()
-    {
-        if(!lockMemory())
-            return false;
-        return unlockMemory(!deleteAllC());
-    }
-    bool stt::file::File::chgLineC(const string &data,const int &linePos)
-    {
-        if(!isOpen())
-        {
-            cerr<<"对象没有打开文件 无法调用函数"<<endl;
-            return false;
-        }
-        if(linePos==0)
-        {
-            this->data[this->data.size()-1]=data;
-        }
-        else
-        {
-            if(linePos>this->data.size())
-            {
-                cerr<<"修改行无法定位"<<endl;
-                return false;
-            }
-            this->data[linePos-1]=data;
-        }
-        return true;
-    }
-    bool stt::file::File::chgLine(const string &data,const int &linePos)
-    {
-        if(!lockMemory())
-            return false;
-        return unlockMemory(!chgLineC(data,linePos));
-    }
-    /*
-    char* File::read(char *data,const int &size,const int &pos)
-    {
-        string dataa;
-        readAll(dataa);
-        dataa=dataa.substr(pos,size);
-        memcpy(data,dataa.data(),size);
-        return data;
-    }
-    bool File::write(char *data,const int &size)
-    {
-        string dataa(data,size);
-        return appendLine(dataa);
-    }
-    bool File::rewrite(char *data,const int &size)
-    {
-        lockMemory();
-        if(!deleteAllC())
-        {
-            unlockMemory();
-            return false;
-        }
-        string dataa(data,size);
-        if(!appendLine(dataa))
-        {
-            unlockMemory();
-            return false;
-        }
-        return unlockMemory();
-    }
-    */
-    
-    bool stt::file::File::read(char *data,const size_t &pos,const size_t &size)
-    {
-        unique_lock<mutex> lock1(fl1);
-        //要上锁，防止容器的size改变了没及时发现，可能带来危险
-        toMemory();
-        return readC(data,pos,size);
-    }
-    bool stt::file::File::readC(char *data,const size_t &pos,const size_t &size)
-    {
-        //判断是否越界(是否在文件有效范围内)
-        if(pos+1<=size1&&pos+size<=size1)
-        {
-            //读内存
-            memcpy(data,data_binary+pos,size);
-            return true;
-        }
-        return false;
-    }
-    bool stt::file::File::write(const char *data,const size_t &pos,const size_t &size)
-    {
-        lockMemory();
-        return unlockMemory(!writeC(data,pos,size));
-    }
-    bool stt::file::File::writeC(const char *data,const size_t &pos,const size_t &size)
-    {
-        //判断是否越界(有没有超出限制)
-        if(((pos+1)<=malloced)&&((pos+size)<=malloced))
-        {
-            //写内存
-            memcpy(data_binary+pos,data,size);
-            //改变size1的值
-            if(pos+size>size1)
-                size1=pos+size;
-            return true;
-        }
-        return false;
-    }
-    void stt::file::File::format()
-    {
-        lockMemory();
-        formatC();
-        unlockMemory();
-    }
-    bool stt::file::File::formatC()
-    {
-        //格式化内存
-        memset(data_binary,0,size1);
-        //改变size1的值
-        size1=0;
-        return true;
-    }
-    
-    ostream& stt::time::operator<<(ostream &os,const Duration &a)
-    {
-        os<<"day="<<a.day<<" "<<a.hour<<":"<<a.min<<":"<<a.sec<<"."<<a.msec;
-        return os;
-    }
-    chrono::system_clock::time_point stt::time::DateTime::strToTimePoint(const string &timeStr,const string &format)
-    {
-        //获取毫秒保存
-        string sss;
-        auto pos=format.find(".sss");
-        if(pos==string::npos)
-            sss="000";
-        else
-            sss=timeStr.substr(pos+1,3);
-        //创建一个新的日期和格式字符串的拷贝并且消掉毫秒部分
-        string cformat=format;
-        string ctimeStr=timeStr;
-
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,4,"");
-            ctimeStr.replace(pos,4,"");
-        }
-
-        //先把yyyy格式转化为gettime接受的形式
-        pos=cformat.find("yyyy");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,4,"%Y");
-        }
-        pos=cformat.find("mm");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%m");
-        }
-        pos=cformat.find("dd");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%d");
-        }
-        pos=cformat.find("hh");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%H");
-        }
-        pos=cformat.find("mi");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%M");
-        }
-        pos=cformat.find("ss");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%S");
-        }
-        //开始反向解析日期字符串
-            //先用istringstream和gettime反向解析为tm结构体
-        tm t;
-        istringstream ss(ctimeStr);
-        ss>>get_time(&t,cformat.c_str());
-        if(ss.fail())
-        {
-            cerr<<"fail to parse time string to tm struct"<<endl;
-        }
-        t.tm_isdst = -1; //tm结构体要补完 防止没有初始化导致有时有可能行为不确定
-        //cout<<t.tm_year<<endl;
-        //cout<<t.tm_mon<<endl;
-        //cout<<t.tm_mday<<endl;
-        //cout<<t.tm_hour<<endl;
-        //cout<<t.tm_min<<endl;
-        //cout<<t.tm_sec<<endl;
-            //tm结构体转化为timet
-        //setenv("TZ","UTC0",1);
-        //tzset();//设置时区为utc并且禁用夏令时，调用tzset更新环境变量
-        time_t tt=mktime(&t);
-        //cout<<tt<<endl;
-            //timet转换为chrono::system_clock::time_point
-        chrono::system_clock::time_point tp=chrono::system_clock::from_time_t(tt);
-        
-        //cout<<tp.time_since_epoch().count()<<endl;
-        
-            //检查是否存在毫秒
-        if(sss!="000")
-        {
-            int msec=stoi(sss);
-            tp+=Milliseconds(msec);
-        }
-        //else//为了转化为毫秒精度的chrono::system_clock::time_point,没有就设置为0
-        //{
-        ///    tp+=Milliseconds(0);
-        //}
-        return tp;
-    }
-    string& stt::time::DateTime::timePointToStr(const chrono::system_clock::time_point &tp,string &timeStr,const string &format)
-    {
-        string cformat=format;
-        //先把yyyy格式转化为puttime接受的形式
-        auto pos=cformat.find("yyyy");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,4,"%Y");
-        }
-        pos=cformat.find("mm");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%m");
-        }
-        pos=cformat.find("dd");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%d");
-        }
-        pos=cformat.find("hh");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%H");
-        }
-        pos=cformat.find("mi");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%M");
-        }
-        pos=cformat.find("ss");
-        if(pos!=string::npos)
-        {
-            cformat.replace(pos,2,"%S");
-        }
-
-        
-        time_t t_tp;
-        t_tp=chrono::system_clock::to_time_t(tp);
-        //to_time_t得到的时间可能处理不了久远的、时间 自己写实现办法 转化为timet
-        //string a="1970-01-01T00:00:00";
-        //chrono::system_clock::time_point b=DateTime::strToTimePoint(a);
-        
-       //cout<<b.time_since_epoch().count()<<endl;
-       //cout<<tp.time_since_epoch().count()<<endl;
-
-          //  s=chrono::duration_cast<chrono::duration<uint64_t>>(b-tp);
-          //  t_tp=0-s.count();
-
-        //
-
-        tm tm_tp;
-        localtime_r(&t_tp,&tm_tp);
-        ostringstream oss;
-        oss<<put_time(&tm_tp,cformat.c_str());
-        timeStr=oss.str();
-        //检查是否有毫秒
-        pos=timeStr.find("sss");
-        if(pos!=string::npos)
-        {
-            Milliseconds milliseconds=chrono::duration_cast<Milliseconds>(tp.time_since_epoch())%1000;
-            oss.str("");
-            oss<<setfill('0')<<setw(3)<<milliseconds.count();
-            timeStr.replace(pos,3,oss.str());
-        }
-        return timeStr;
-    }
-    string& stt::time::DateTime::getTime(string &timeStr,const string &format)
-    {
-        chrono::time_point<chrono::system_clock> now=chrono::system_clock::now();
-        timePointToStr(now,timeStr,format);
-        return timeStr;
-    }
-    Duration& stt::time::DateTime::dTOD(const Milliseconds& d1,Duration &D1)
-    {
-        uint64_t msec=d1.count();
-        D1.day=msec/(24*60*60*1000);
-        msec=msec%(24*60*60*1000);
-        D1.hour=msec/(60*60*1000);
-        msec=msec%(60*60*1000);
-        D1.min=msec/(60*1000);
-        msec=msec%(60*1000);
-        D1.sec=msec/(1000);
-        msec=msec%(1000);
-        D1.msec=msec;
-        return D1;
-    }
-    Milliseconds& stt::time::DateTime::DTOd(const Duration &D1,Milliseconds& d1)
-    {
-        uint64_t msec=0;
-        msec+=static_cast<uint64_t>(D1.day)*86400000;
-        msec+=static_cast<uint64_t>(D1.hour)*60*60*1000;
-        msec+=static_cast<uint64_t>(D1.min)*60*1000;
-        msec+=static_cast<uint64_t>(D1.sec)*1000;
-        msec+=D1.msec;
-        d1=Milliseconds(msec);
-        return d1;
-    }
-    bool stt::time::DateTime::convertFormat(string &timeStr,const string &oldFormat,const string &newFormat)
-    {
-        string str=newFormat;
-        auto pos1=oldFormat.find("yyyy");
-        auto pos2=str.find("yyyy");
-        if(pos1!=string::npos)//新字符串比起旧的缺失了不要紧 如果新的比起旧的新加了 那就是缺少数据 会导致字符串数据不完整 直接报错就行了
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,4,timeStr.substr(pos1,4));
-        }
-        else
-            return false;
-        pos1=oldFormat.find("mm");
-        pos2=str.find("mm");
-        if(pos1!=string::npos)
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,2,timeStr.substr(pos1,2));
-        }
-        else
-            return false;
-        pos1=oldFormat.find("dd");
-        pos2=str.find("dd");
-        if(pos1!=string::npos)
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,2,timeStr.substr(pos1,2));
-        }
-        else
-            return false;
-        pos1=oldFormat.find("hh");
-        pos2=str.find("hh");
-        if(pos1!=string::npos)
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,2,timeStr.substr(pos1,2));
-        }
-        else
-            return false;
-        pos1=oldFormat.find("mi");
-        pos2=str.find("mi");
-        if(pos1!=string::npos)
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,2,timeStr.substr(pos1,2));
-        }
-        else
-            return false;
-        pos1=oldFormat.find("ss");
-        pos2=str.find("ss");
-        if(pos1!=string::npos)
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,2,timeStr.substr(pos1,2));
-        }
-        else
-            return false;
-        pos1=oldFormat.find("sss");
-        pos2=str.find("sss");
-        if(pos1!=string::npos)
-        {
-            if(pos2!=string::npos)
-                str.replace(pos2,3,timeStr.substr(pos1,3));
-        }
-        else
-            return false;
-        timeStr=str;
-        return true;
-    }
-    Duration& stt::time::DateTime::calculateTime(const string &time1,const string &time2,Duration &result,const string &format1,const string &format2)
-    {
-        Milliseconds dt;
-        chrono::system_clock::time_point t1=strToTimePoint(time1,format1);
-        chrono::system_clock::time_point t2=strToTimePoint(time2,format2);
-        dt=chrono::duration_cast<Milliseconds>(t1-t2);
-        dTOD(dt,result);
-        return result;
-    }
-    string& stt::time::DateTime::calculateTime(const string &time1,const Duration &time2,string &result,const string &am,const string &format1,const string &format2)
-    {
-        chrono::system_clock::time_point t1=strToTimePoint(time1,format1);
-        Milliseconds t2;
-        DTOd(time2,t2);
-        chrono::system_clock::time_point t3;
-        if(am=="+")
-            t3=t1+t2;
-        else
-            t3=t1-t2;
-        time_t t_tp=chrono::system_clock::to_time_t(t3);
-        timePointToStr(t3,result,format2);
-        return result;
-    }
-    bool stt::time::DateTime::startTiming()
-    {
-        if(isStart())
-            return false;
-        flag=true;
-        start=chrono::steady_clock::now();
-        return true;
-    }
-    Duration stt::time::DateTime::endTiming()
-    {
-        if(!isStart())
-        {
-            dt.day=-1;
-            dt.hour=-1;
-            dt.min=-1;
-            dt.sec=-1;
-            dt.msec=-1;
-            return dt;
-        }
-        end=chrono::steady_clock::now();
-        dTOD(chrono::duration_cast<Milliseconds>(end-start),dt);
-        flag=false;
-        return dt;
-    }
-    Duration stt::time::DateTime::checkTime()
-    {
-        if(!isStart())
-        {
-            dt.day=-1;
-            dt.hour=-1;
-            dt.min=-1;
-            dt.sec=-1;
-            dt.msec=-1;
-            return dt;
-        }
-        end=chrono::steady_clock::now();
-        dTOD(chrono::duration_cast<Milliseconds>(end-start),dt);
-        return dt;
-    }
-    bool stt::time::DateTime::compareTime(const string &time1,const string &time2,const string &format1,const string &format2)
-    {
-        auto t1=strToTimePoint(time1,format1);
-        auto t2=strToTimePoint(time2,format2);
-        if(t1.time_since_epoch()>=t2.time_since_epoch())
-            return true;
-        else
-            return false;
-    }
-
-    stt::file::LogFile::~LogFile()
-    {
-        consumerGuard=false;
-        //queueCV.notify_all();
-        if(consumerThread.joinable())
-            consumerThread.join();
-    }
-    bool stt::file::LogFile::openFile(const string &fileName,const string &timeFormat,const string &contentFormat)
-    {
-        this->timeFormat=timeFormat;
-        this->contentFormat=contentFormat;
-        return File::openFile(fileName,true,0,0,0664);
-    }
-    void stt::file::LogFile::writeLog(const string &data)
-    {
-        //string content;
-        //getTime(content,timeFormat);
-        //content+=contentFormat+data;
-        
-        //{
-        //    std::lock_guard<std::mutex> lock(queueMutex);
-            logQueue.push(std::move(data));
-        //}
-        //queueCV.notify_all();
-        /*
-        string content;
-        getTime(content,timeFormat);
-        content+=contentFormat+data;
-        return appendLine(content);
-        */
-    }
-    bool stt::file::LogFile::closeFile(const bool &del)
-    {
-        timeFormat.clear();
-        contentFormat.clear();
-        return File::closeFile(del);
-    }
-    bool stt::file::LogFile::clearLog()
-    {
-        return File::deleteAll();
-    }
-    bool stt::file::LogFile::deleteLogByTime(const string &date1,const string &date2)
-    {
-        if(!isOpen())
-            return false;
-        int linePos=1;
-        string data;
-        string time;
-        int timeSize=timeFormat.size();
-        if(!lockMemory())
-            return false;
-        while(readLineC(data,linePos))
-        {
-            time=data.substr(0,timeSize);
-            if((date1=="1"||compareTime(time,date1,timeFormat,timeFormat)==true)&&(date2=="2"||compareTime(time,date2,timeFormat,timeFormat)==false))
-            {
-                deleteLineC(linePos);
-                unlockMemory(false);
-                linePos--;
-            }
-            linePos++;
-        }
-        //if(chee.owns_lock())
-        //    unlockMemory(true);
-        unique_lock<mutex> testlock(che,try_to_lock);
-        if(!testlock.owns_lock())
-            unlockMemory(true);
-        
-        return true;
-    }
-    
-    bool stt::data::CryptoUtil::encryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after)
-    {
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-        if (!ctx) return false;
-        int len;
-        int ciphertext_len;
-        // 初始化加密操作
-        if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, passwd, iv)) 
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        // 加密数据
-        if (1 != EVP_EncryptUpdate(ctx, after, &len, before, length))
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        ciphertext_len = len;
-        // 加密完成
-        if (1 != EVP_EncryptFinal_ex(ctx, after + len, &len)) 
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        ciphertext_len += len;
-        EVP_CIPHER_CTX_free(ctx);
-        return ciphertext_len;
-    }
-    bool stt::data::CryptoUtil::decryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after)
-    {
-        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
-        if (!ctx) return false;
-
-        int len;
-        int plaintext_len;
-
-        // 初始化解密操作
-        if (1 != EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, passwd, iv)) 
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-
-        // 解密数据
-        if (1 != EVP_DecryptUpdate(ctx, after, &len, before, length)) 
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        plaintext_len = len;
-
-        // 解密完成
-        if (1 != EVP_DecryptFinal_ex(ctx, after + len, &len)) 
-        {
-            EVP_CIPHER_CTX_free(ctx);
-            return false;
-        }
-        plaintext_len += len;
-
-        EVP_CIPHER_CTX_free(ctx);
-        return plaintext_len;
-    }
-string& stt::data::CryptoUtil::sha1(const string &ori_str,string &result)
-{
-	unsigned char hash[SHA_DIGEST_LENGTH];
-	SHA1((unsigned char*)ori_str.c_str(),ori_str.length(),hash);
-    char hash1[SHA_DIGEST_LENGTH];
-    for(int i=0;i<SHA_DIGEST_LENGTH;i++)
-        hash1[i]=static_cast<char>(hash[i]);
-	result.assign(hash1,SHA_DIGEST_LENGTH);
-	return result;
-}
-string& stt::data::CryptoUtil::sha11(const string &ori_str,string &result)
-{
-	unsigned char hash[SHA_DIGEST_LENGTH];
-	SHA1((unsigned char*)ori_str.c_str(),ori_str.length(),hash);
-	char buffer[2*SHA_DIGEST_LENGTH+1];
-	buffer[2*SHA_DIGEST_LENGTH]=0;
-	for(int i=0;i<SHA_DIGEST_LENGTH;i++)
-	{
-		snprintf(buffer+i*2,3,"%02x",hash[i]);
-	}
-	result.assign(buffer);
-	return result;
-}
-string& stt::data::BitUtil::bitOutput(char input,string &result)
-{
-    result.clear();
-    for(int i=1;i<=8;i++)
-    {
-        if((input&'z'+6)=='z'+6)
-            result+='1';
-        else
-            result+='0';
-        input=input<<1;
-    }
-    return result;
-}
-string& stt::data::BitUtil::bitOutput(const string &input,string &result)
-{
-    result.clear();
-    for(char cc:input)
-    {
-        for(int i=1;i<=8;i++)
-        {
-            if((cc&'z'+6)=='z'+6)
-                result+='1';
-            else
-                result+='0';
-            cc=cc<<1;
-        }
-    }
-    return result;
-}
-char& stt::data::BitUtil::bitOutput_bit(char input,const int pos,char &result)
-{
-    input=input<<(pos-1);
-    if((input&'z'+6)=='z'+6)
-        result='1';
-    else
-        result='0';
-    return result;
-}
-unsigned long& stt::data::BitUtil::bitStrToNumber(const string &input,unsigned long &result)
-{
-    result=0;
-    int mul=input.length()-1;
-    for(const char &cc:input)
-    {
-        if(cc=='1')
-            result+=pow(2,mul);
-        mul--;
-    }
-    return result;
-}
-unsigned long& stt::data::BitUtil::bitToNumber(const string &input,unsigned long &result)
-{
-    string rr;
-    bitOutput(input,rr);
-    result=bitStrToNumber(rr,result);
-    return result;
-}
-char& stt::data::BitUtil::toBit(const string &input,char &result)
-{
-    int pos=0;
-    result='z'-122;
-    unsigned char cc;
-    for(const char &ii:input)
-    {
-        if(ii=='1')
-        {
-            cc='z'+6;
-            cc=cc>>(pos%8);
-            result=result|cc;
-        }
-        pos++;
-    }
-    return result;
-}
-string& stt::data::BitUtil::toBit(const string &input,string &result)
-{
-    result.clear();
-    int pos=0;
-    char bb='z'-122;
-    unsigned char cc;
-    for(const char &ii:input)
-    {
-        if(ii=='1')
-        {
-            cc='z'+6;
-            cc=cc>>pos;
-            bb=bb|cc;
-        }
-        pos++;
-        if(pos==8)
-        {
-            pos=0;
-            result+=bb;
-            bb='z'-122;
-        }
-    }
-    return result;
-}
-    long stt::data::RandomUtil::getRandomNumber(const long &a,const long &b)
-    {
-        random_device rd;
-        mt19937_64 generator(rd());
-        uniform_int_distribution<long long> dist(a,b);
-        return dist(generator);
-    }
-    string& stt::data::RandomUtil::getRandomStr_base64(string &str,const int &length)
-    {
-        str.clear();
-		// 定义包含可能字符的字符串
-    	const string characters = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz+/";
-
-    	// 设置随机数引擎和分布
-    	random_device rd;
-    	mt19937 generator(rd());
-    	uniform_int_distribution<int> distribution(0, characters.size() - 1);
-
-    	// 生成随机字符串
-    	
-    	for (int i = 1; i <=length-length%4; i++) //长度为randomNumber
-		{
-        	str += characters[distribution(generator)];
-    	}
-        for(int i=1;i<=length%4;i++)
-        {
-            str+='=';
-        }
-        return str;
-    }
-string& stt::data::RandomUtil::generateMask_4(string &mask)
-{
-    mask.clear();
-		// 定义包含可能字符的字符串
-    	const string characters = "01";
-        string bitStr;
-    	// 设置随机数引擎和分布
-    	random_device rd;
-    	mt19937 generator(rd());
-    	uniform_int_distribution<int> distribution(0, characters.size() - 1);
-
-    	// 生成随机字符串
-    	
-    	for (int i = 1; i <=32; i++) //长度为randomNumber
-		{
-        	bitStr += characters[distribution(generator)];
-    	}
-        BitUtil::toBit(bitStr,mask);
-        return mask;
-}
-unsigned long& stt::data::NetworkOrderUtil::htonl_ntohl_64(unsigned long &data)
-{
-    char swi;
-    for(int i=0;i<4;i++)
-    {
-        memcpy(&swi,(char*)&data+i,1);
-        memcpy((char*)&data+i,(char*)&data+7-i,1);
-        memcpy((char*)&data+7-i,&swi,1);
-    }
-    return data;
-}
-    string& stt::data::PrecisionUtil::getPreciesFloat(const float &number,const int &bit,string &str)
-    {
-        stringstream ss;
-        ss<<fixed<<setprecision(bit)<<number;
-        str=ss.str();
-        return str;
-    }
-    string& stt::data::PrecisionUtil::getPreciesDouble(const double &number,const int &bit,string &str)
-    {
-        stringstream ss;
-        ss<<fixed<<setprecision(bit)<<number;
-        str=ss.str();
-        return str;
-    }
-    float& stt::data::PrecisionUtil::getPreciesFloat(float &number,const int &bit)
-    {
-        number=round(number*pow(10,bit))/pow(10,bit);
-        return number;
-    }
-    double& stt::data::PrecisionUtil::getPreciesDouble(double &number,const int &bit)
-    {
-        number=round(number*pow(10,bit))/pow(10,bit);
-        return number;
-    }
-    float& stt::data::PrecisionUtil::getValidFloat(float &number,const int &bit)
-    {
-        int bitt=0;
-
-        while(((int)(number*pow(10,bitt))==0)&&bitt<=6)//如果是1以下的小数 确定位数
-        {
-            bitt++;
-        }
-
-        if(bitt==7)
-            return number;
-        if((int)number==0)
-            bitt=bitt+bit-1;//1以下的
-        else
-            bitt=bitt+bit;//1以上的
-        number=round(number*pow(10,bitt))/pow(10,bitt);
-        return number;
-    }
-
-    size_t stt::data::HttpStringUtil::get_split_str(const string_view& ori_str,string_view &str,const string_view &a,const string_view &b,const size_t &pos)
-    {
-        size_t aa;
-        size_t bb;
-        if(a=="")
-            aa=string::npos;
-        else
-            aa=ori_str.find(a,pos);
-        if(b=="")
-            bb=string::npos;
-        else
-            bb=ori_str.find(b,aa+1);
-        if(aa==string::npos&&bb==string::npos)
-        {
-                str="";
-                //return str;
-                return bb;
-        }
-        else if(aa==string::npos&&bb!=string::npos)
-        {
-                str=ori_str.substr(0,bb);
-                //return str;
-                return bb;
-        }
-        else if(aa!=string::npos&&bb==string::npos)
-        {
-                aa+=a.length();
-                str=ori_str.substr(aa);
-                //return str;
-                return bb;
-        }
-        aa+=a.length();
-        str=ori_str.substr(aa,bb-aa);
-        //return str;
-        return bb;
-    }
-    string_view& stt::data::HttpStringUtil::get_value_header(const string_view& ori_str,string_view &str,const string& name)
-    {
-        size_t ii=ori_str.find(name);
-	    if(ii==string::npos)
-	    {
-		    str="";
-		    return str;
-	    }
-		    get_split_str(ori_str,str,name+": ","\r\n");
-		    //del_space_str(str);
-		    return str;
-    }
-    string_view& stt::data::HttpStringUtil::get_value_str(const string_view& ori_str,string_view &str,const string& name)
-{
-    size_t ii=ori_str.find("?");
-    if(ii==string::npos)
-        ii=0;
-	ii=ori_str.find(name+"=",ii);
-	if(ii==string::npos)
-	{
-		str="";
-		return str;
-	}
-	//分两种情况，可能是最后一个，或者不是最后一个。&分隔开很关键
-	if(ori_str.find("&",ii)==string::npos)//最后一个
-	{
-		ii=ori_str.find("=",ii);
-		str=ori_str.substr(ii+1,ori_str.length()-ii-1);
-		//del_space_str(str);//去掉空格
-		return str;
-	}
-	else
-	{
-		get_split_str(ori_str,str,name+"=","&");
-		//del_space_str(str);
-		return str;
-	}
-}
-    string_view& stt::data::HttpStringUtil::get_location_str(const string_view& ori_str,string_view &str)
-{
-	auto pos1=ori_str.find("://");
-    if(pos1==string::npos)
-        pos1=0;
-    else
-    {
-        pos1=ori_str.find("/",pos1+3);
-    }
-
-    auto pos2=ori_str.find("?");
-
-    str=ori_str.substr(pos1,pos2-pos1);
-    return str;
-    
-}
-    string_view& stt::data::HttpStringUtil::getLocPara(const string_view &url,string_view &locPara)
-    {
-        auto pos1=url.find("://");
-        if(pos1==string::npos)
-            pos1=0;
-        else
-        {
-            pos1=url.find("/",pos1+3);
-        }
-        if(pos1==string::npos)
-        {
-            cerr<<"无效url"<<endl;
-            locPara="";
-            return locPara;
-        }
-        locPara=url.substr(pos1);
-        return locPara;
-    }
-    string_view& stt::data::HttpStringUtil::getPara(const string_view &url,string_view &para)
-    {
-        para="";
-        auto pos=url.find("?");
-        if(pos==string::npos)
-            return para;
-        para=url.substr(pos);
-        return para;
-    }
-
-
-    size_t stt::data::HttpStringUtil::get_split_str(const string_view& ori_str,string &str,const string_view &a,const string_view &b,const size_t &pos)
-    {
-        size_t aa;
-        size_t bb;
-        if(a=="")
-            aa=string::npos;
-        else
-            aa=ori_str.find(a,pos);
-        if(b=="")
-            bb=string::npos;
-        else
-            bb=ori_str.find(b,aa+1);
-        if(aa==string::npos&&bb==string::npos)
-        {
-                str="";
-                //return str;
-                return bb;
-        }
-        else if(aa==string::npos&&bb!=string::npos)
-        {
-                str=ori_str.substr(0,bb);
-                //return str;
-                return bb;
-        }
-        else if(aa!=string::npos&&bb==string::npos)
-        {
-                aa+=a.length();
-                str=ori_str.substr(aa);
-                //return str;
-                return bb;
-        }
-        aa+=a.length();
-        str=ori_str.substr(aa,bb-aa);
-        //return str;
-        return bb;
-    }
-    string& stt::data::HttpStringUtil::get_value_header(const string& ori_str,string &str,const string& name)
-    {
-        size_t ii=ori_str.find(name);
-	    if(ii==string::npos)
-	    {
-		    str="";
-		    return str;
-	    }
-		    get_split_str(ori_str,str,name+": ","\r\n");
-		    //del_space_str(str);
-		    return str;
-    }
-    string& stt::data::HttpStringUtil::get_value_str(const string& ori_str,string &str,const string& name)
-{
-    size_t ii=ori_str.find("?");
-    if(ii==string::npos)
-        ii=0;
-	ii=ori_str.find(name+"=",ii);
-	if(ii==string::npos)
-	{
-		str="";
-		return str;
-	}
-	//分两种情况，可能是最后一个，或者不是最后一个。&分隔开很关键
-	if(ori_str.find("&",ii)==string::npos)//最后一个
-	{
-		ii=ori_str.find("=",ii);
-		str=ori_str.substr(ii+1,ori_str.length()-ii-1);
-		//del_space_str(str);//去掉空格
-		return str;
-	}
-	else
-	{
-		get_split_str(ori_str,str,name+"=","&");
-		//del_space_str(str);
-		return str;
-	}
-}
-    string& stt::data::HttpStringUtil::get_location_str(const string& ori_str,string &str)
-{
-	auto pos1=ori_str.find("://");
-    if(pos1==string::npos)
-        pos1=0;
-    else
-    {
-        pos1=ori_str.find("/",pos1+3);
-    }
-
-    auto pos2=ori_str.find("?");
-
-    str=ori_str.substr(pos1,pos2-pos1);
-    return str;
-    
-}
-    string& stt::data::HttpStringUtil::getLocPara(const string &url,string &locPara)
-    {
-        auto pos1=url.find("://");
-        if(pos1==string::npos)
-            pos1=0;
-        else
-        {
-            pos1=url.find("/",pos1+3);
-        }
-        if(pos1==string::npos)
-        {
-            cerr<<"无效url"<<endl;
-            locPara="";
-            return locPara;
-        }
-        locPara=url.substr(pos1);
-        return locPara;
-    }
-    string& stt::data::HttpStringUtil::getPara(const string &url,string &para)
-    {
-        para="";
-        auto pos=url.find("?");
-        if(pos==string::npos)
-            return para;
-        para=url.substr(pos);
-        return para;
-    }
-
-    string& stt::data::HttpStringUtil::getIP(const string &url,string &IP)
-    {
-        HttpStringUtil::get_split_str(url,IP,"//",":");
-        return IP;
-    }
-    int& stt::data::HttpStringUtil::getPort(const string &url,int &port)
-    {
-        auto pos=url.find(":");
-        string pport;
-        HttpStringUtil::get_split_str(url,pport,":","/",pos+1);
-        return stt::data::NumberStringConvertUtil::toInt(pport,port);
-    }
-    string stt::data::HttpStringUtil::createHeader(const string& first,const string& second)
-	{
-		string cf=first+": "+second+"\r\n";
-		return cf;
-	}
-string& stt::data::WebsocketStringUtil::transfer_websocket_key(string &str)
-{
-    str=str+"258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-    string b="";
-    CryptoUtil::sha1(str,b);
-    str=EncodingUtil::base64_encode(b);
-    return str;
-}
-    int& stt::data::NumberStringConvertUtil::toInt(const string_view&ori_str,int &result,const int &i)
-    {
-        /*
-        try
-        {
-            result=stoi(ori_str);
-        }
-        catch(...)
-        {
-            result=i;
-            return result;
-        }
-        return result;
-        */
-        if(from_chars(ori_str.data(),ori_str.data()+ori_str.length(),result).ec!=errc())
-            result=i;
-        return result;
-    }
-	long& stt::data::NumberStringConvertUtil::toLong(const string_view&ori_str,long &result,const long &i)
-    {
-        /*
-        try
-        {
-            result=stol(ori_str);
-        }
-        catch(...)
-        {
-            result=i;
-            return result;
-        }
-        return result;
-        */
-        if(from_chars(ori_str.data(),ori_str.data()+ori_str.length(),result).ec!=errc())
-            result=i;
-        return result;
-    }
-	float& stt::data::NumberStringConvertUtil::toFloat(const string&ori_str,float &result,const float &i)
-    {
-        
-        try
-        {
-            result=stof(ori_str);
-        }
-        catch(...)
-        {
-            result=i;
-            return result;
-        }
-        return result;
-        
-    }
-	double& stt::data::NumberStringConvertUtil::toDouble(const string&ori_str,double &result,const double &i)
-    {
-        
-        try
-        {
-            result=stod(ori_str);
-        }
-        catch(...)
-        {
-            result=i;
-            return result;
-        }
-        return result;
-
-    }
-    bool& stt::data::NumberStringConvertUtil::toBool(const string_view&ori_str,bool &result)
-    {
-        
-        if(ori_str=="true"||ori_str=="TRUE"||ori_str=="True")
-        {
-            result=true;
-            return result;
-        }
-        else
-        {
-            result=false;
-            return result;
-        }
-
-    }
-    
-    
-    
-    
-    
-string& stt::data::NumberStringConvertUtil::strto16(const string &ori_str,string &result)//字符串转化为16进制字符串
-{
-    int size=ori_str.length();
-    const char *buffer1;
-    char buffer2[2*size+1];
-    buffer2[2*size]=0;
-    buffer1=ori_str.c_str();
-    for(int i=0;i<size;i++)
-        snprintf(buffer2+i*2,3,"%02x",buffer1[i]);
-    result.assign(buffer2);
-    return result;
-}
-    int& stt::data::NumberStringConvertUtil::str16toInt(const string_view&ori_str,int &result,const int &i)
-    {
-        int bit=ori_str.length()-1;
-        result=0;
-        for(auto &ii:ori_str)
-        {
-            if(ii=='0')
-                result+=0*pow(16,bit);
-            else if(ii=='1')
-                result+=1*pow(16,bit);
-            else if(ii=='2')
-                result+=2*pow(16,bit);
-            else if(ii=='3')
-                result+=3*pow(16,bit);
-            else if(ii=='4')
-                result+=4*pow(16,bit);
-            else if(ii=='5')
-                result+=5*pow(16,bit);
-            else if(ii=='6')
-                result+=6*pow(16,bit);
-            else if(ii=='7')
-                result+=7*pow(16,bit);
-            else if(ii=='8')
-                result+=8*pow(16,bit);
-            else if(ii=='9')
-                result+=9*pow(16,bit);
-            else if(ii=='a'||ii=='A')
-                result+=10*pow(16,bit);
-            else if(ii=='b'||ii=='B')
-                result+=11*pow(16,bit);
-            else if(ii=='c'||ii=='C')
-                result+=12*pow(16,bit);
-            else if(ii=='d'||ii=='D')
-                result+=13*pow(16,bit);
-            else if(ii=='e'||ii=='E')
-                result+=14*pow(16,bit);
-            else if(ii=='f'||ii=='F')
-                result+=15*pow(16,bit);
-            else
-            {
-                result=i;
-                break;
-            }
-            bit--;
-        }
-        return result;
-    }
-    // Function to encode a string using Base64
-std::string stt::data::EncodingUtil::base64_encode(const std::string &input) {
-    BIO *bio, *b64;
-    BUF_MEM *bufferPtr;
-
-    b64 = BIO_new(BIO_f_base64());
-    bio = BIO_new(BIO_s_mem());
-    bio = BIO_push(b64, bio);
-
-    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL); // Ignore newlines
-    BIO_write(bio, input.c_str(), input.length());
-    BIO_flush(bio);
-    BIO_get_mem_ptr(bio, &bufferPtr);
-
-    std::string encoded_data(bufferPtr->data, bufferPtr->length);
-    BIO_free_all(bio);
-    return encoded_data;
-}
-
-// Function to decode a Base64 encoded string
-std::string stt::data::EncodingUtil::base64_decode(const std::string &input) {
-    BIO *bio, *b64;
-    char *buffer = (char *)malloc(input.length());
-    memset(buffer, 0, input.length());
-
-    b64 = BIO_new(BIO_f_base64());
-    bio = BIO_new_mem_buf(input.c_str(), input.length());
-    bio = BIO_push(b64, bio);
-
-    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL); // Ignore newlines
-    int decoded_length = BIO_read(bio, buffer, input.length());
-    std::string decoded_data(buffer, decoded_length);
-    BIO_free_all(bio);
-    free(buffer);
-
-    return decoded_data;
-}
-
-
-
-string& stt::data::EncodingUtil::maskCalculate(string &data,const string &mask)
-{
-    const char *m=mask.data();
-    int ii=0;
-    for(char &cc:data)
-    {
-        cc=cc^m[ii%4];
-        ii++;
-    }
-    return data;
-}
-string& stt::data::EncodingUtil::transfer_websocket_key(string &str)
-{
-    str=str+"258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-    string b="";
-    CryptoUtil::sha1(str,b);
-    str=base64_encode(b);
-    return str;
-}
-string& stt::data::EncodingUtil::generateMask_4(string &mask)
-{
-    mask.clear();
-		// 定义包含可能字符的字符串
-    	const string characters = "01";
-        string bitStr;
-    	// 设置随机数引擎和分布
-    	random_device rd;
-    	mt19937 generator(rd());
-    	uniform_int_distribution<int> distribution(0, characters.size() - 1);
-
-    	// 生成随机字符串
-    	
-    	for (int i = 1; i <=32; i++) //长度为randomNumber
-		{
-        	bitStr += characters[distribution(generator)];
-    	}
-        BitUtil::toBit(bitStr,mask);
-        return mask;
-}
-    int stt::data::JsonHelper::getValue(const string &oriStr,string &result,const string &type,const string &name,const int &num)
-    {
-        Json::Value root;
-        Json::CharReaderBuilder reader;
-        string errs;
-        istringstream s(oriStr);
-        bool is;
-
-        if(type=="arrayvalue")//数组中的数据
-        {
-            is=Json::parseFromStream(reader,s,&root,&errs);
-            if(!is||!root.isArray()||root.isNull())
-            {   
-                return -1;
-            }
-            Json::Value next=root[num];
-            if(next.isNull())
-            {
-                return -1;
-            }
-
-            if(next.isObject()||next.isArray())//嵌套了数组或者json对象
-            {
-                Json::StreamWriterBuilder writerBuilder;
-                result = Json::writeString(writerBuilder, next);
-                return 1;
-            }
-            else//普通数据
-            {
-                result=root[num].asString();
-                return 0;
-            }
-        }
-        
-        else if(type=="value")//json中的普通数据
-        {
-            is=Json::parseFromStream(reader,s,&root,&errs);
-            if(!is||!root.isObject()||root.isNull())
-            {   
-                return -1;
-            }
-            Json::Value next=root[name];
-            if(next.isNull())
-                return -1;
-            if(next.isObject()||next.isArray())//对象
-            {
-                Json::StreamWriterBuilder writerBuilder;
-                result = Json::writeString(writerBuilder, next);
-                return 1;
-            }
-            else//普通数据
-            {
-                result=root[name].asString();
-                return 0;
-            }
-            
-        }    
-        else
-        {   
-            return -1;
-        }
-    }
-    string stt::data::JsonHelper::toString(const Json::Value &val)
-    {
-        return val.asString();
-    }
-    Json::Value stt::data::JsonHelper::toJsonArray(const string & str)
-    {
-        Json::Value root;
-        Json::CharReaderBuilder reader;
-        string errs;
-        istringstream s(str);
-        
-        if(!Json::parseFromStream(reader,s,&root,&errs))
-        {
-            cerr<<"json转换错误 : "<<errs<<endl;
-        }
-        return root;
-    }
-    string stt::data::JsonHelper::jsonAdd(const string &a,const string &b)
-    {
-        string result=a;
-        result.erase(a.length()-2);
-        if(a.length()>3)
-            result+=",";
-        result+=b.substr(1);
-        return result;
-    }
-    string& stt::data::JsonHelper::jsonFormatify(const string &a,string &b)
-    {
-        Json::CharReaderBuilder reader;
-        Json::Value root;
-        string errs;
-        istringstream s(a);
-        if(!Json::parseFromStream(reader,s,&root,&errs))
-        {
-            cerr<<"json转换错误 : "<<errs<<endl;
-            b="";
-            return b;
-        }
-        Json::StreamWriterBuilder writer;
-        writer["indentation"]="";
-        b=Json::writeString(writer,root);
-        return b;
-    }
-    string& stt::data::JsonHelper::jsonToUTF8(const string &input,string &output)
-    {
-        output.clear();
-        regex unicode_regex("\\\\u([0-9a-fA-F]{4})");
-    
-        // 使用sregex_iterator遍历匹配的结果
-        sregex_iterator begin(input.begin(), input.end(), unicode_regex);
-        sregex_iterator end;
-    
-        string::size_type last_pos = 0;
-        for (sregex_iterator i = begin; i != end; ++i) 
-        {
-            smatch match = *i;
-            output += input.substr(last_pos, match.position() - last_pos);  // 添加前面未匹配的部分
-
-            // 提取匹配到的十六进制 Unicode 码
-            unsigned int codepoint;
-            stringstream ss;
-            ss << hex << match.str(1);
-            ss >> codepoint;
-
-            // 将 Unicode 码转换为 UTF-8 字符
-            char utf8_char[5] = {0};
-            if (codepoint <= 0x7F) 
-            {
-                utf8_char[0] = codepoint;
-            } 
-            else if (codepoint <= 0x7FF) 
-            {
-                utf8_char[0] = 0xC0 | ((codepoint >> 6) & 0x1F);
-                utf8_char[1] = 0x80 | (codepoint & 0x3F);
-            } 
-            else if (codepoint <= 0xFFFF) 
-            {
-                utf8_char[0] = 0xE0 | ((codepoint >> 12) & 0x0F);
-                utf8_char[1] = 0x80 | ((codepoint >> 6) & 0x3F);
-                utf8_char[2] = 0x80 | (codepoint & 0x3F);
-            }
-
-            output += std::string(utf8_char);  // 添加转换后的 UTF-8 字符
-            last_pos = match.position() + match.length();
-        }
-    
-        // 添加最后一部分未匹配的字符串
-        output += input.substr(last_pos);
-        return output;
-    
-    }
-
-    
-    void stt::network::TcpFDHandler::blockSet(const int &sec)
-    {
-        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
-        fcntl(fd,F_GETFL,flags&~O_NONBLOCK);
-        flag1=false;
-        if(sec!=-1)
-        {
-            struct timeval tv;
-            tv.tv_sec = sec;  // 设置接收超时时间为 5 秒
-            tv.tv_usec = 0;
-
-            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-        }
-        this->sec=sec;
-    }
-    void stt::network::UdpFDHandler::blockSet(const int &sec)
-    {
-        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
-        fcntl(fd,F_GETFL,flags&~O_NONBLOCK);
-        flag1=false;
-        if(sec!=-1)
-        {
-            struct timeval tv;
-            tv.tv_sec = sec;  // 设置接收超时时间为 5 秒
-            tv.tv_usec = 0;
-
-            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
-        }
-        this->sec=sec;
-    }
-    void stt::network::TcpFDHandler::unblockSet()
-    {
-        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
-        fcntl(fd,F_SETFL,flags|O_NONBLOCK);
-        flag1=true;
-    }
-    void stt::network::UdpFDHandler::unblockSet()
-    {
-        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
-        fcntl(fd,F_SETFL,flags|O_NONBLOCK);
-        flag1=true;
-    }
-    bool stt::network::TcpFDHandler::multiUseSet()
-    {
-        int opt;
-        if(!flag2)//设置为multiuse
-            opt=1;
-        else
-            opt=0;
-        if(setsockopt(fd,SOL_SOCKET,SO_REUSEADDR|SO_REUSEPORT,&opt,sizeof(opt))<0)
-        {
-            cerr<<"set multi failed"<<endl;
-            perror("setsockopt");
-            return false;
-        }
-        flag2=!flag2;
-        return true;
-    }
-    bool stt::network::UdpFDHandler::multiUseSet()
-    {
-        int opt;
-        if(!flag2)//设置为multiuse
-            opt=1;
-        else
-            opt=0;
-        if(setsockopt(fd,SOL_SOCKET,SO_REUSEADDR|SO_REUSEPORT,&opt,sizeof(opt))<0)
-        {
-            cerr<<"set multi failed"<<endl;
-            perror("setsockopt");
-            return false;
-        }
-        flag2=!flag2;
-        return true;
-    }
-    void stt::network::TcpFDHandler::setFD(const int &fd,SSL *ssl,const bool &flag1,const bool &flag2,const int &sec)
-    {
-        this->fd=fd;
-        this->flag1=flag1;
-        this->flag2=flag2;
-        this->ssl=ssl;
-        if(ssl!=nullptr)
-            signal(SIGPIPE,SIG_IGN);
-        
-    }
-    void stt::network::UdpFDHandler::setFD(const int &fd,const bool &flag1,const int &sec,const bool &flag2)
-    {
-        this->fd=fd;
-        this->flag1=flag1;
-        this->flag2=flag2;
-        if(flag1==true)
-            unblockSet();
-        else 
-            blockSet(sec);
-        if(flag2==true)
-            multiUseSet();
-    }
-    void stt::network::TcpFDHandler::close(const bool &cle)
-    {
-        
-        flag1=false;
-        flag2=false;
-        if(cle)
-        {
-            if(ssl!=nullptr)
-            {
-                SSL_shutdown(ssl);
-                SSL_free(ssl);
-            }
-            ::close(fd);
-        }
-        ssl=nullptr;
-        fd=-1;
-    }
-    void stt::network::UdpFDHandler::close(const bool &cle)
-    {
-        flag1=false;
-        flag2=false;
-        sec=-1;
-        if(cle)
-        {
-            ::close(fd);
-        }
-        fd=-1;
-    }
-    bool stt::network::TcpClient::createFD()
-    {
-        //准备socket
-        fd=socket(AF_INET,SOCK_STREAM,0);
-        if(fd<0)
-        {
-            perror("socket");
-            return false;
-        }
-        flag=false;
-        serverIP="";
-        serverPort=-1;
-        flag1=false;
-        flag2=false;
-        if(TLS)
-        {
-            this->TLS=true;
-            if(!initCTX(ca,cert,passwd))
-            {
-                this->TLS=false;
-                return false;
-            }
-            ssl=SSL_new(ctx);
-            if(ssl==NULL)
-            {
-                perror("new ssl wrong");
-                ERR_print_errors_fp(stderr);
-                this->TLS=false;
-                return false;
-            }
-        }
-        else
-        {
-            this->TLS=false;
-            ssl=nullptr;
-        }
-        return true;
-    }
-    void stt::network::TcpClient::closeAndUnCreate()
-    {
-        if(ssl!=nullptr)
-        {
-            SSL_shutdown(ssl);
-            SSL_free(ssl);
-            ssl=nullptr;
-        }
-        ::close(fd);
-        if(ctx!=nullptr)
-        {
-            SSL_CTX_free(ctx);
-            ctx=nullptr;
-        }  
-    }
-    bool stt::network::TcpClient::initCTX(const char *ca,const char *cert,const char *key,const char *passwd)
-    {
-        // 初始化
-        SSLeay_add_ssl_algorithms();
-        OpenSSL_add_all_algorithms();
-        SSL_load_error_strings();
-        ERR_load_BIO_strings();
-        //SSL_library_init();
-
-        // 我们使用SSL V3,V2
-        #if OPENSSL_VERSION_NUMBER < 0x10100000L
-        if((ctx = SSL_CTX_new(SSLv23_client_method()))==NULL)
-            return false;
-        #else
-        if((ctx = SSL_CTX_new(TLS_client_method())) == NULL)
-            return false;
-        #endif
-        //校验对方证书，使用系统自带的权威的ca证书
-        SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, NULL);
-        if(SSL_CTX_load_verify_locations(ctx, ca, NULL)<=0)
-        {
-            cerr<<"ca false"<<endl;
-            return false;
-        }
-        //可能的话加载自己的证书和私钥
-        if(cert!=""&&passwd!="")
-        {
-            if(SSL_CTX_use_certificate_chain_file(ctx, cert) <=0)
-            {
-                cerr<<"加载证书失败"<<endl;
-                return false;
-            }
-            SSL_CTX_set_default_passwd_cb_userdata(ctx, (void*)passwd);
-            if(SSL_CTX_use_PrivateKey_file(ctx, key, SSL_FILETYPE_PEM) <=0)
-            {
-                cerr<<"密码失败"<<endl;
-                return false;
-            }
-            //判断私钥是否正确
-            if(!SSL_CTX_check_private_key(ctx))
-            {
-                cerr<<"密码错误"<<endl;
-                return false;
-            }
-        }
-        signal(SIGPIPE,SIG_IGN);
-        return true;
-    }
-    stt::network::TcpClient::TcpClient(const bool &TLS,const char *ca,const char *cert,const char *key,const char *passwd)
-    {
-        this->ca=ca;
-        this->cert=cert;
-        this->key=key;
-        this->passwd=passwd;
-        this->TLS=TLS;
-        createFD();
-    }
-    void stt::network::TcpClient::resetCTX(const bool &TLS,const char *ca,const char *cert,const char *key,const char *passwd)
-    {
-        this->ca=ca;
-        this->cert=cert;
-        this->key=key;
-        this->passwd=passwd;
-        this->TLS=TLS;
-    }
-    bool stt::network::TcpClient::connect(const string &ip,const int &port)
-    {
-        if(isConnect())
-        {
-          if(!close())
-            return false;
-        }
-        //connect
-        hostent *k1;
-        k1=gethostbyname(ip.c_str());//DNS解析
-        if(k1==nullptr)
-        {
-            cerr<<"get host by name failed"<<endl;
-            close();
-            return false;
-        }
-        struct sockaddr_in k2;
-        memset(&k2,0,sizeof(k2));
-        k2.sin_family=AF_INET;
-        k2.sin_port=htons(port);
-        memcpy(&k2.sin_addr,k1->h_addr,k1->h_length);
-        if(::connect(fd,(struct sockaddr*)&k2,sizeof(k2))!=0)
-        {
-            perror("connect");
-            close();
-            return false;
-        }
-        if(TLS)//套上TLS加密
-        {
-            SSL_set_connect_state(ssl);
-            SSL_set_fd(ssl,fd);
-            int ret=SSL_connect(ssl);
-            if(ret != 1)
-            {
-                printf("%s\n", SSL_state_string_long(ssl));
-                printf("ret = %d, ssl get error %d\n", ret, SSL_get_error(ssl, ret));
-                return false;
-            }
-        }
-        flag=true;
-        return true;
-    }
-    bool stt::network::TcpClient::close()
-    {
-        closeAndUnCreate();
-        return createFD();
-    }
-    int stt::network::TcpFDHandler::sendData(const string &data,const bool &block)
-    {
-        if(!isConnect())
-            return -99;
-        int size=data.size();
-        int totalSize=0;
-        int pos=0;
-        int result;
-        if(block)
-        {
-            if(ssl==nullptr)
-            {
-                while((result=::send(fd,data.substr(pos).c_str(),size-totalSize,MSG_NOSIGNAL)))
-                {
-                    if(result==0)
-                    {
-                        flag3=0;
-                        break;
-                    }
-                    else if(result<0)
-                    {
-                        if(errno==EAGAIN||errno==EWOULDBLOCK)
-                            continue;
-                        //perror("send");
-                        break;
-                    }
-                    else
-                    {
-                        totalSize+=result;
-                        pos=totalSize-1;
-                        if(totalSize>=size)
-                            break;
-                    }
-                }
-            }
-            else
-            {
-                while((result=SSL_write(ssl,data.substr(pos).c_str(),size-totalSize)))
-                {
-                    if(result==0)
-                    {
-                        flag3=0;
-                        break;
-                    }
-                    else if(result<0)
-                    {
-                        if(errno==EAGAIN||errno==EWOULDBLOCK)
-                            continue;
-                        //perror("send");
-                        break;
-                    }
-                    else
-                    {
-                        totalSize+=result;
-                        pos=totalSize-1;
-                        if(totalSize>=size)
-                            break;
-                    }
-                }
-            }
-        }
-        else
-        {
-            if(ssl==nullptr)
-            {
-                totalSize=::send(fd,data.c_str(),data.size(),MSG_NOSIGNAL);
-                if(totalSize<0)
-                {
-                    if(errno==EAGAIN||errno==EWOULDBLOCK)
-                        totalSize=-100;
-                }
-            }
-            else
-            {
-                totalSize=SSL_write(ssl,data.c_str(),data.size());
-                if(totalSize<0)
-                {
-                    if(errno==EAGAIN||errno==EWOULDBLOCK)
-                        totalSize=-100;
-                }
-            }
-        }
-        
-        return totalSize;
-    }
-    
-    int stt::network::UdpFDHandler::sendData(const string &data,const string &ip,const int &port,const bool &block)
-    {
-        if(fd==-1)
-            return -99;
-        //填充目标信息
-        hostent *k1;
-        k1=gethostbyname(ip.c_str());//DNS解析
-        if(k1==nullptr)
-        {
-            cerr<<"get host by name failed"<<endl;
-            return -98;
-        }
-        struct sockaddr_in k2;
-        memset(&k2,0,sizeof(k2));
-        k2.sin_family=AF_INET;
-        k2.sin_port=htons(port);
-        memcpy(&k2.sin_addr,k1->h_addr,k1->h_length);
-        //发送
-        int size=data.size();
-        int totalSize=0;
-        int pos=0;
-        int result;
-        if(block)
-        {
-            while((result=::sendto(fd,data.substr(pos).c_str(),size-totalSize,MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2))))
-            {
-                if(result<0)
-                {
-                    if(errno==EAGAIN||errno==EWOULDBLOCK)
-                        continue;
-                    //perror("send");
-                    break;
-                }
-                else
-                {
-                    totalSize+=result;
-                    pos=totalSize-1;
-                    if(totalSize>=size)
-                        break;
-                }
-            }
-        }
-        else
-        {
-            totalSize=::sendto(fd,data.c_str(),data.size(),MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2));
-            if(totalSize<0)
-            {
-                if(errno==EAGAIN||errno==EWOULDBLOCK)
-                    totalSize=-100;
-            }
-        }
-        return totalSize;
-    }
-    
-    int stt::network::TcpFDHandler::sendData(const char *data,const uint64_t &length,const bool &block)
-    {
-        if(!isConnect())
-            return -99;
-        int totalSize=0;
-        int pos=0;
-        int result;
-        if(block)
-        {
-            if(ssl==nullptr)
-            {
-                while((result=::send(fd,data+pos,length-totalSize,MSG_NOSIGNAL)))
-                {
-                    if(result==0)
-                    {
-                        flag3=0;
-                        break;
-                    }
-                    else if(result<0)
-                    {
-                        if(errno==EAGAIN||errno==EWOULDBLOCK)
-                            continue;
-                        //perror("send");
-                        break;
-                    }
-                    else
-                    {
-                        totalSize+=result;
-                        pos=totalSize-1;
-                        if(totalSize>=length)
-                            break;
-                    }
-                }
-            }
-            else
-            {
-                while((result=::SSL_write(ssl,data+pos,length-totalSize)))
-                {
-                    if(result==0)
-                    {
-                        flag3=0;
-                        break;
-                    }
-                    else if(result<0)
-                    {
-                        if(errno==EAGAIN||errno==EWOULDBLOCK)
-                            continue;
-                        //perror("send");
-                        break;
-                    }
-                    else
-                    {
-                        totalSize+=result;
-                        pos=totalSize-1;
-                        if(totalSize>=length)
-                            break;
-                    }
-                }
-            }
-        }
-        else
-        {
-            if(ssl==nullptr)
-            {
-                totalSize=::send(fd,data,length,MSG_NOSIGNAL);
-                if(totalSize<0)
-                {
-                    if(errno==EAGAIN||errno==EWOULDBLOCK)
-                        totalSize=-100;
-                }
-            }
-            else
-            {
-                totalSize=SSL_write(ssl,data,length);
-                if(totalSize<0)
-                {
-                    if(errno==EAGAIN||errno==EWOULDBLOCK)
-                        totalSize=-100;
-                }
-            }
-        }
-        return totalSize;
-    }
-    
-    int stt::network::UdpFDHandler::sendData(const char *data,const uint64_t &length,const string &ip,const int &port,const bool &block)
-    {
-        if(fd==-1)
-            return -99;
-        //填充目标信息
-        hostent *k1;
-        k1=gethostbyname(ip.c_str());//DNS解析
-        if(k1==nullptr)
-        {
-            cerr<<"get host by name failed"<<endl;
-            return -98;
-        }
-        struct sockaddr_in k2;
-        memset(&k2,0,sizeof(k2));
-        k2.sin_family=AF_INET;
-        k2.sin_port=htons(port);
-        memcpy(&k2.sin_addr,k1->h_addr,k1->h_length);
-        //发送
-        int totalSize=0;
-        int pos=0;
-        int result;
-        if(block)
-        {
-            while((result=::sendto(fd,data+pos,length-totalSize,MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2))))
-            {
-                if(result<0)
-                {
-                    if(errno==EAGAIN||errno==EWOULDBLOCK)
-                        continue;
-                    //perror("send");
-                    break;
-                }
-                else
-                {
-                    totalSize+=result;
-                    pos=totalSize-1;
-                    if(totalSize>=length)
-                        break;
-                }
-            }
-        }
-        else
-        {
-            totalSize=::sendto(fd,data,length,MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2));
-            if(totalSize<0)
-            {
-                if(errno==EAGAIN||errno==EWOULDBLOCK)
-                    totalSize=-100;
-            }
-        }
-        return totalSize;
-    }
-    
-    int stt::network::TcpFDHandler::recvDataByLength(string &data,const uint64_t &length,const int &sec)
-    {
-        if(!isConnect())
-            return -99;
-        if(flag1&&sec!=-1)//非阻塞模式且sec设置为非无限等待
-        {
-            DateTime timer;
-            Duration dt{0,0,0,sec,0};
-            unique_ptr<char[]> buffer(new char[length]);
-            data.clear();
-            uint64_t size=length;
-            int64_t recvSize;
-            while(size>0)
-            {
-                timer.startTiming();
-                if(ssl==nullptr)
-                    recvSize=::recv(fd,buffer.get(),size,0);
-                else
-                    recvSize=SSL_read(ssl,buffer.get(),size);
-                if(recvSize<=0)
-                {
-                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                    {
-                        //cout<<"ok"<<endl;
-                        if(dt>=timer.checkTime())
-                            continue;
-                        else
-                        {
-                            return -100;
-                        }
-                    }
-                    return recvSize;
-                }
-                timer.endTiming(); 
-                data+=string(buffer.get(),recvSize);
-                size-=recvSize;
-            }
-        }
-        else//阻塞模式
-        {
-            int sec_backup=this->sec;
-            blockSet(sec);
-            unique_ptr<char[]> buffer(new char[length]);
-            data.clear();
-            uint64_t size=length;
-            int64_t recvSize;
-            while(size>0)
-            {
-                if(ssl==nullptr)
-                    recvSize=::recv(fd,buffer.get(),size,0);
-                else
-                    recvSize=SSL_read(ssl,buffer.get(),size);
-                if(recvSize<=0)
-                {
-                    blockSet(sec_backup);
-                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                        return -100;
-                    return recvSize;
-                }
-                data+=string(buffer.get(),recvSize);
-                size-=recvSize;
-            }
-        }
-
-        
-        return length;
-    }
-    /*
-    int UdpFDHandler::recvDataByLength(string &data,const uint64_t &length,string &ip,int &port,const int &sec)
-    {
-        if(fd==-1)
-            return -99;
-        int sec_back_up;
-        if(!flag1)//如果是阻塞模式要设置新的超时时间
-        {
-            sec_back_up=this->sec;
-            blockSet(sec);
-        }
-        //预备接收对端的信息
-        struct sockaddr_in chenfan;
-	    socklen_t tanziliang=sizeof(chenfan);
-        //接收
-        char buffer[length];
-        data.clear();
-        uint64_t size=length;
-        int64_t recvSize;
-        if(flag1)//非阻塞模式
-        {
-            DateTime timer;
-            Duration dt{0,0,0,sec,0};
-            while(size>0)
-            {
-                timer.startTiming();
-                recvSize=::recvfrom(fd,buffer,size,0,(struct sockaddr*)&chenfan,&tanziliang);
-                if(recvSize<0)
-                {
-                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                    {
-                        //cout<<"ok"<<endl;
-                        if(dt<timer.checkTime())
-                            continue;
-                        else
-                        {
-                            port=chenfan.sin_port;
-	                        ip.assign(inet_ntoa(chenfan.sin_addr));
-                            if(!flag1)
-                                blockSet(sec_back_up);
-                            return -100;
-                        }
-                    }
-                    perror("recv()");
-                    break;
-                }
-                timer.endTiming(); 
-                data+=string(buffer,recvSize);
-                size-=recvSize;
-            }
-        }
-        else//阻塞模式
-        {
-            while(size>0)
-            {
-                recvSize=::recvfrom(fd,buffer,size,0,(struct sockaddr*)&chenfan,&tanziliang);
-                if(recvSize<0)
-                {
-                    perror("recv()");
-                    break;
-                }
-                data+=string(buffer,recvSize);
-                size-=recvSize;
-            }
-        }
-        //ip和port
-        port=chenfan.sin_port;
-	    ip.assign(inet_ntoa(chenfan.sin_addr));
-        //如果是阻塞模式 接收完毕还原超时时间
-        if(!flag1)
-            blockSet(sec_back_up);
-        if(recvSize<0)
-            return recvSize;
-        return length;
-    }
-    */
-    int stt::network::TcpFDHandler::recvDataByLength(char *data,const uint64_t &length,const int &sec)
-    {
-        if(!isConnect())
-            return -99;
-        
-        if(flag1&&sec!=-1)//非阻塞模式
-        {
-            DateTime timer;
-            Duration dt{0,0,0,sec,0};
-            memset(data,0,length);
-            uint64_t size=length;
-            int64_t recvSize=0;
-            while(size>0)
-            {
-                timer.startTiming();
-                if(ssl==nullptr)
-                    recvSize=::recv(fd,data+(length-size),size,0);
-                else
-                    recvSize=SSL_read(ssl,data+(length-size),size);
-                if(recvSize<=0)
-                {
-                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                    {
-                        if(dt>=timer.checkTime())
-                            continue;
-                        else
-                        {
-                            return -100;
-                        }
-                    }
-
-                    return recvSize;
-                }
-                timer.endTiming();
-
-                size-=recvSize;
-            }
-        }
-        else
-        {
-            int sec_backup=this->sec;
-            blockSet(sec);
-            memset(data,0,length);
-            uint64_t size=length;
-            int64_t recvSize=0;
-            while(size>0)
-            {
-                if(ssl==nullptr)
-                    recvSize=::recv(fd,data+(length-size),size,0);
-                else
-                    recvSize=SSL_read(ssl,data+(length-size),size);
-                if(recvSize<=0)
-                {
-                    blockSet(sec_backup);
-                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                    {
-                        return -100;
-                    }
-
-                    return recvSize;
-                }
-
-                size-=recvSize;
-            }
-        }
-
-        return length;
-    }
-    int stt::network::TcpFDHandler::recvData(string &data,const uint64_t &length)
-    {
-        if(!isConnect())
-            return -99;
-        unique_ptr<char[]> buffer(new char[length]);
-        int size;
-        if(ssl==nullptr)
-            size=::recv(fd,buffer.get(),length,0);
-        else
-            size=SSL_read(ssl,buffer.get(),length);
-        if(size>0)
-            data=string(buffer.get(),size);
-        else
-        {
-            if(flag1==true&&size<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                return -100;
-            //perror("recv()");
-        }
-        return size;
-    }
-    int stt::network::UdpFDHandler::recvData(string &data,const uint64_t &length,string &ip,int &port)
-    {
-        if(fd==-1)
-            return -99;
-        unique_ptr<char[]> buffer(new char[length]);
-        int size;
-        struct sockaddr_in chenfan;
-	    socklen_t tanziliang=sizeof(chenfan);
-        size=::recvfrom(fd,buffer.get(),length,0,(struct sockaddr*)&chenfan,&tanziliang);
-        if(size>0)
-        {
-            data=string(buffer.get(),size);
-            port=chenfan.sin_port;
-	        ip.assign(inet_ntoa(chenfan.sin_addr));
-        }
-        else
-        {
-            if((errno==EAGAIN||errno==EWOULDBLOCK))
-                return -100;
-            //perror("recv()");
-        }
-        return size;
-    }
-    int stt::network::TcpFDHandler::recvData(char *data,const uint64_t &length)
-    {
-        if(!isConnect())
-            return -99;
-        int size;
-        if(ssl==nullptr)
-            size=::recv(fd,data,length,0);
-        else
-            size=SSL_read(ssl,data,length);
-        if(size<0)
-        {
-            if(flag1==true&&(errno==EAGAIN||errno==EWOULDBLOCK))
-                return -100;
-            //perror("recv()");
-        }
-        return size;
-    }
-    int stt::network::UdpFDHandler::recvData(char *data,const uint64_t &length,string &ip,int &port)
-    {
-        if(fd==-1)
-            return -99;
-        int size;
-        struct sockaddr_in chenfan;
-	    socklen_t tanziliang=sizeof(chenfan);
-        size=::recvfrom(fd,data,length,0,(struct sockaddr*)&chenfan,&tanziliang);
-        if(size<0)
-        {
-            if((errno==EAGAIN||errno==EWOULDBLOCK))
-                return -100;
-            //perror("recv()");
-        }
-        port=chenfan.sin_port;
-	    ip.assign(inet_ntoa(chenfan.sin_addr));
-        return size;
-    }
-    stt::network::UdpClient::UdpClient(const bool &flag1,const int &sec)
-    {
-        fd=socket(AF_INET,SOCK_DGRAM,0);
-        if(fd<0)
-        {
-            cerr<<" udp fd failed"<<endl;;
-            fd=-1;
-        }
-        else
-        {
-            if(flag1)
-                unblockSet();
-            else
-                blockSet(sec);
-            this->flag1=flag1;
-            this->sec=sec;
-            this->flag2=false;
-        }
-    }
-    bool stt::network::UdpClient::createFD(const bool &flag1,const int &sec)
-    {
-        if(fd!=-1)
-            close();
-        fd=socket(AF_INET,SOCK_DGRAM,0);
-        if(fd<0)
-        {
-            cerr<<" udp fd failed"<<endl;;
-            fd=-1;
-            return false;
-        }
-        else
-        {
-            if(flag1)
-                unblockSet();
-            else
-                blockSet(sec);
-            this->flag1=flag1;
-            this->sec=sec;
-            this->flag2=false;
-        }
-        return true;
-    }
-    stt::network::UdpServer::UdpServer(const int &port,const bool &flag1,const int &sec,const bool &flag2)
-    {
-        fd=socket(AF_INET,SOCK_DGRAM,0);
-        if(fd<0)
-        {
-            cerr<<" udp fd failed"<<endl;;
-            fd=-1;
-        }
-        else
-        {
-            if(flag1)
-                unblockSet();
-            else
-                blockSet(sec);
-            if(flag2)
-                multiUseSet();
-            this->flag1=flag1;
-            this->sec=sec;
-            this->flag2=flag2;
-            struct sockaddr_in k;
-	        memset(&k,0,sizeof(k));
-	        k.sin_family=AF_INET;
-	        k.sin_addr.s_addr=htonl(INADDR_ANY);
-	        k.sin_port=htons(port);
-	        if(bind(fd,(struct sockaddr*)&k,sizeof(k))!=0)//成
-	        {
-		        perror("bind");
-		        close(fd);
-	        }
-        }
-    }
-    bool stt::network::UdpServer::createFD(const int &port,const bool &flag1,const int &sec,const bool &flag2)
-    {
-        if(fd!=-1)
-            close();
-        fd=socket(AF_INET,SOCK_DGRAM,0);
-        if(fd<0)
-        {
-            cerr<<" udp fd failed"<<endl;;
-            fd=-1;
-            return false;
-        }
-        else
-        {
-            if(flag1)
-                unblockSet();
-            else
-                blockSet(sec);
-            if(flag2)
-                multiUseSet();
-            this->flag1=flag1;
-            this->sec=sec;
-            this->flag2=flag2;
-            struct sockaddr_in k;
-	        memset(&k,0,sizeof(k));
-	        k.sin_family=AF_INET;
-	        k.sin_addr.s_addr=htonl(INADDR_ANY);
-	        k.sin_port=htons(port);
-	        if(bind(fd,(struct sockaddr*)&k,sizeof(k))!=0)//成
-	        {
-		        perror("bind");
-		        close(fd);
-                return false;
-	        }
-        }
-        return true;
-    }
-    
-    
-    bool stt::network::HttpClient::getRequest(const string &url,const string &header,const string &header1,const int &sec)
-    {
-        this->flag=false;
-        this->header="";
-        this->body="";
-        string ip;
-        int port;
-        string locPara;
-        HttpStringUtil::getIP(url,ip);
-        HttpStringUtil::getPort(url,port);
-        HttpStringUtil::getLocPara(url,locPara);
-        blockSet(sec);
-        if(!isConnect()||getServerIP()!=ip||getServerPort()!=port)//没有连接或者服务器变更需要重新连接
-        {
-            if(isConnect())//如果是变更服务器 需要先关闭原有的连接
-            {
-                if(!close())
-                {
-                    cerr<<"http无法关闭前一个连接"<<endl;
-                    return false;
-                }
-            }
-            blockSet(sec);
-            if(!connect(ip,port))
-            {
-                cerr<<"http无法连接到服务器"<<endl;
-                return false;
-            }
-        }
-
-        //连接到服务器完成，后面进行发送请求报文操作
-
-        //拼接报文
-        string ss;
-        ss="GET "+locPara+" HTTP/1.1\r\n"\
-            +"Host: "+ip+":"+to_string(port)+"\r\n"\
-            +header1+"\r\n"\
-            +header+"\r\n";
-
-        //发送
-        if(sendData(ss)!=ss.length())
-            return false;
-        //接收
-        string totalRecv="";
-        string recv;
-        while(totalRecv.find("\r\n\r\n")==string::npos)
-        {
-            if(recvData(recv,1024)<=0)
-            {
-                flag=false;
-                this->header="";
-                body="";
-                return true;
-            }
-            totalRecv+=recv;
-        }
-        auto pos=totalRecv.find("\r\n\r\n");
-        recv.clear();
-        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
-        {
-            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
-            {
-                if(recvData(recv,1024)<=0)
-                {
-                    flag=false;
-                    body="";
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                totalRecv+=recv;
-            }
-            //cout<<totalRecv<<endl;
-            string size;
-            int ssize;
-            string chunk;
-            auto ppos=pos+2;
-            while(1)
-            {
-                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                ppos=totalRecv.find("\r\n",ppos+2);
-                //cout<<size<<endl;
-                NumberStringConvertUtil::str16toInt(size,ssize);
-                if(ssize==-1)
-                {
-                    flag=false;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    body="";
-                    return true;
-                }
-                else if(ssize==0)
-                {
-                    flag=true;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                else//读取数据
-                {
-                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                    chunk=totalRecv.substr(ppos+2,ssize);
-                    body+=chunk;
-                    ppos=ppos+2+ssize;
-                }
-            }
-        }
-        else//按照指定字节接收
-        {
-            int hasReceived=totalRecv.length()-(pos+4);
-            string size;
-            int ssize;
-            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
-            NumberStringConvertUtil::toInt(size,ssize);
-            if(ssize==-1)
-            {
-                flag=true;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                body="";
-                return true;
-            }
-            else if(ssize==0)
-            {
-                flag=true;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                body="";
-                return true;
-            }
-            else
-            {
-                if(ssize-hasReceived<=0)
-                {
-                    body=totalRecv.substr(pos);
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    flag=true;
-                    return true;
-                }
-                else
-                {  
-                    if(recvDataByLength(recv,ssize-hasReceived,sec)<=0)
-                    {
-                        flag=false;
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        body="";
-                        return true;
-                    }
-                    else
-                    {
-                        totalRecv+=recv;
-                        body=totalRecv.substr(pos);
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        flag=true;
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-    bool stt::network::HttpClient::getRequestFromFD(const int &fd,SSL *ssl,const string &url,const string &header,const string &header1,const int &sec)
-    {
-        this->flag=false;
-        this->header="";
-        this->body="";
-        string ip;
-        int port;
-        string locPara;
-        HttpStringUtil::getIP(url,ip);
-        HttpStringUtil::getPort(url,port);
-        HttpStringUtil::getLocPara(url,locPara);
-        TcpFDHandler k;
-        k.setFD(fd,ssl,false,false,sec);
-        k.blockSet(sec);
-        //套上套接字完成，后面进行发送请求报文操作
-
-        //拼接报文
-        string ss;
-        ss="GET "+locPara+" HTTP/1.1\r\n"\
-            +"Host: "+ip+":"+to_string(port)+"\r\n"\
-            +header1+"\r\n"\
-            +header+"\r\n";
-
-        //发送
-        if(k.sendData(ss)!=ss.length())
-            return false;
-        //接收
-        string totalRecv="";
-        string recv;
-        while(totalRecv.find("\r\n\r\n")==string::npos)
-        {
-            if(k.recvData(recv,1024)<=0)
-            {
-                flag=false;
-                this->header="";
-                body="";
-                return true;
-            }
-            totalRecv+=recv;
-        }
-        auto pos=totalRecv.find("\r\n\r\n");
-        recv.clear();
-        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
-        {
-            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
-            {
-                if(recvData(recv,1024)<=0)
-                {
-                    flag=false;
-                    body="";
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                totalRecv+=recv;
-            }
-            //cout<<totalRecv<<endl;
-            string size;
-            int ssize;
-            string chunk;
-            auto ppos=pos+2;
-            while(1)
-            {
-                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                ppos=totalRecv.find("\r\n",ppos+2);
-                //cout<<size<<endl;
-                NumberStringConvertUtil::str16toInt(size,ssize);
-                if(ssize==-1)
-                {
-                    flag=false;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    body="";
-                    return true;
-                }
-                else if(ssize==0)
-                {
-                    flag=true;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                else//读取数据
-                {
-                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                    chunk=totalRecv.substr(ppos+2,ssize);
-                    body+=chunk;
-                    ppos=ppos+2+ssize;
-                }
-            }
-        }
-        else//按照指定字节接收
-        {
-            int hasReceived=totalRecv.length()-(pos+4);
-            string size;
-            int ssize;
-            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
-            NumberStringConvertUtil::toInt(size,ssize);
-            if(ssize==-1)
-            {
-                flag=true;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                body="";
-                return true;
-            }
-            else if(ssize==0)
-            {
-                flag=true;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                body="";
-                return true;
-            }
-            else
-            {
-                if(ssize-hasReceived<=0)
-                {
-                    body=totalRecv.substr(pos);
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    flag=true;
-                    return true;
-                }
-                else
-                {  
-                    if(k.recvDataByLength(recv,ssize-hasReceived,sec)<=0)
-                    {
-                        flag=false;
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        body="";
-                        return true;
-                    }
-                    else
-                    {
-                        totalRecv+=recv;
-                        body=totalRecv.substr(pos);
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        flag=true;
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-    bool stt::network::HttpClient::postRequest(const string &url,const string &body,const string &header,const string &header1,const int &sec)
-    {
-        this->flag=false;
-        this->header="";
-        this->body="";
-        string ip;
-        int port;
-        string locPara;
-        HttpStringUtil::getIP(url,ip);
-        HttpStringUtil::getPort(url,port);
-        HttpStringUtil::getLocPara(url,locPara);
-        blockSet(sec);
-        if(!isConnect()||getServerIP()!=ip||getServerPort()!=port)//没有连接或者服务器变更需要重新连接
-        {
-            if(isConnect())//如果是变更服务器 需要先关闭原有的连接
-            {
-                if(!close())
-                {
-                    cerr<<"http无法关闭前一个连接"<<endl;
-                    return false;
-                }
-            }
-            blockSet(sec);
-            if(!connect(ip,port))
-            {
-                //cout<<ip<<endl;
-                //cout<<port<<endl;
-                cerr<<"http无法连接到服务器"<<endl;
-                return false;
-            }
-        }
-
-        //连接到服务器完成，后面进行发送请求报文操作
-
-        //拼接报文
-        string ss;
-        ss="POST "+locPara+" HTTP/1.1\r\n"\
-            +"Host: "+ip+":"+to_string(port)+"\r\n"\
-            +"Content-Length: "+to_string(body.length())+"\r\n"\
-            +header1+"\r\n"\
-            +header+"\r\n"\
-            +body;
-
-        //发送
-        if(sendData(ss)!=ss.length())
-            return false;
-        //接收
-        string totalRecv="";
-        string recv;
-        while(recv.find("\r\n\r\n")==string::npos)
-        {
-            if(recvData(recv,1024)<=0)
-            {
-                flag=false;
-                this->header="";
-                this->body="";
-                return true;
-            }
-            totalRecv+=recv;
-        }
-        auto pos=totalRecv.find("\r\n\r\n");
-
-        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
-        {
-            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
-            {
-                if(recvData(recv,1024)<=0)
-                {
-                    flag=false;
-                    this->body="";
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                totalRecv+=recv;
-            }
-            //cout<<totalRecv<<endl;
-            string size;
-            int ssize;
-            string chunk;
-            auto ppos=pos+2;
-            while(1)
-            {
-                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                ppos=totalRecv.find("\r\n",ppos+2);
-                //cout<<size<<endl;
-                NumberStringConvertUtil::str16toInt(size,ssize);
-                if(ssize==-1)
-                {
-                    flag=false;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    this->body="";
-                    return true;
-                }
-                else if(ssize==0)
-                {
-                    flag=true;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                else//读取数据
-                {
-                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                    chunk=totalRecv.substr(ppos+2,ssize);
-                    this->body+=chunk;
-                    ppos=ppos+2+ssize;
-                }
-            }
-        }
-        else//按照指定字节接收
-        {
-            int hasReceived=totalRecv.length()-(pos+4);
-            string size;
-            int ssize;
-            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
-            NumberStringConvertUtil::toInt(size,ssize);
-            if(ssize==-1)
-            {
-                flag=false;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                this->body="";
-                return true;
-            }
-            else if(ssize==0)
-            {
-                flag=true;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                this->body="";
-                return true;
-            }
-            else
-            {
-                if(ssize-hasReceived<=0)
-                {
-                    this->body=totalRecv.substr(pos);
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    flag=true;
-                    return true;
-                }
-                else
-                {
-                    if(recvDataByLength(recv,ssize-hasReceived,sec)<=0)
-                    {
-                        flag=false;
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        this->body="";
-                        return true;
-                    }
-                    else
-                    {
-                        totalRecv+=recv;
-                        this->body=totalRecv.substr(pos);
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        flag=true;
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-    bool stt::network::HttpClient::postRequestFromFD(const int &fd,SSL *ssl,const string &url,const string &body,const string &header,const string &header1,const int &sec)
-    {
-        this->flag=false;
-        this->header="";
-        this->body="";
-        string ip;
-        int port;
-        string locPara;
-        HttpStringUtil::getIP(url,ip);
-        HttpStringUtil::getPort(url,port);
-        HttpStringUtil::getLocPara(url,locPara);
-        TcpFDHandler k;
-        k.setFD(fd,ssl,false,false,sec);
-        k.blockSet(sec);
-        //套上套接字完成，后面进行发送请求报文操作
-
-        //拼接报文
-        string ss;
-        ss="POST "+locPara+" HTTP/1.1\r\n"\
-            +"Host: "+ip+":"+to_string(port)+"\r\n"\
-            +"Content-Length: "+to_string(body.length())+"\r\n"\
-            +header1+"\r\n"\
-            +header+"\r\n"\
-            +body;
-
-        //发送
-        if(k.sendData(ss)!=ss.length())
-            return false;
-        //接收
-        string totalRecv="";
-        string recv;
-        while(recv.find("\r\n\r\n")==string::npos)
-        {
-            if(k.recvData(recv,1024)<=0)
-            {
-                flag=false;
-                this->header="";
-                this->body="";
-                return true;
-            }
-            totalRecv+=recv;
-        }
-        auto pos=totalRecv.find("\r\n\r\n");
-
-        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
-        {
-            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
-            {
-                if(recvData(recv,1024)<=0)
-                {
-                    flag=false;
-                    this->body="";
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                totalRecv+=recv;
-            }
-            //cout<<totalRecv<<endl;
-            string size;
-            int ssize;
-            string chunk;
-            auto ppos=pos+2;
-            while(1)
-            {
-                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                ppos=totalRecv.find("\r\n",ppos+2);
-                //cout<<size<<endl;
-                NumberStringConvertUtil::str16toInt(size,ssize);
-                if(ssize==-1)
-                {
-                    flag=false;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    this->body="";
-                    return true;
-                }
-                else if(ssize==0)
-                {
-                    flag=true;
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    return true;
-                }
-                else//读取数据
-                {
-                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
-                    chunk=totalRecv.substr(ppos+2,ssize);
-                    this->body+=chunk;
-                    ppos=ppos+2+ssize;
-                }
-            }
-        }
-        else//按照指定字节接收
-        {
-            int hasReceived=totalRecv.length()-(pos+4);
-            string size;
-            int ssize;
-            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
-            NumberStringConvertUtil::toInt(size,ssize);
-            if(ssize==-1)
-            {
-                flag=false;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                this->body="";
-                return true;
-            }
-            else if(ssize==0)
-            {
-                flag=true;
-                totalRecv.erase(pos);
-                this->header=totalRecv;
-                this->body="";
-                return true;
-            }
-            else
-            {
-                if(ssize-hasReceived<=0)
-                {
-                    this->body=totalRecv.substr(pos);
-                    totalRecv.erase(pos);
-                    this->header=totalRecv;
-                    flag=true;
-                    return true;
-                }
-                else
-                {
-                    if(k.recvDataByLength(recv,ssize-hasReceived,sec)<=0)
-                    {
-                        flag=false;
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        this->body="";
-                        return true;
-                    }
-                    else
-                    {
-                        totalRecv+=recv;
-                        this->body=totalRecv.substr(pos);
-                        totalRecv.erase(pos);
-                        this->header=totalRecv;
-                        flag=true;
-                        return true;
-                    }
-                }
-            }
-        }
-    }
-    void stt::network::TcpServer::putTask(const std::function<int(TcpFDHandler &k,TcpInformation &inf)> &fun,TcpFDHandler &k,TcpInformation &inf)
-    {
-        workpool->submit([this,&k,&inf,fun]()->void
-        {
-            int ret=fun(k,inf);
-            //入队
-            this->finishQueue.push({inf.fd,ret});
-            //按钟
-            uint64_t one = 1;
-            write(this->workerEventFD, &one, sizeof(one));
-        });
-    }
-    void stt::network::HttpServer::putTask(const std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> &fun,HttpServerFDHandler &k,HttpRequestInformation &inf)
-    {
-        workpool->submit([this,&k,&inf,fun]()->void
-        {
-            int ret=fun(k,inf);
-            //入队
-            
-            this->finishQueue.push({inf.fd,ret});
-            //按钟
-            uint64_t one = 1;
-            
-            write(this->workerEventFD, &one, sizeof(one));
-            
-        });
-    }
-    void stt::network::WebSocketServer::putTask(const std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> &fun,WebSocketServerFDHandler &k,WebSocketFDInformation &inf)
-    {
-        workpool->submit([this,&k,&inf,fun]()->void
-        {
-            int ret=fun(k,inf);
-            //入队
-            this->finishQueue.push({inf.fd,ret});
-
-            //按钟
-            uint64_t one = 1;
-            write(this->workerEventFD, &one, sizeof(one));
-        });
-    }
-    bool stt::network::TcpServer::setTLS(const char *cacert,const char *key,const char *passwd,const char *ca)
-    {
-        if(TLS)
-            redrawTLS();
-        // 初始化
-        SSLeay_add_ssl_algorithms();
-        OpenSSL_add_all_algorithms();
-        SSL_load_error_strings();
-        ERR_load_BIO_strings();
-        // 我们使用SSL V3,V2
-        if((ctx = SSL_CTX_new(SSLv23_method())) == NULL)
-        {
-            cerr<<"new ctx wrong"<<endl;
-            return false;
-        }
-
-        // 要求校验对方证书，这里建议使用SSL_VERIFY_FAIL_IF_NO_PEER_CERT，详见https://blog.csdn.net/u013919153/article/details/78616737
-        //对于服务器端来说如果使用的是SSL_VERIFY_PEER且服务器端没有考虑对方没交证书的情况，会出现只能访问一次，第二次访问就失败的情况。
-        SSL_CTX_set_verify(ctx, SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
-
-        // 加载CA的证书
-        if(!SSL_CTX_load_verify_locations(ctx, ca, NULL))
-        {
-            cerr<<"load ca wrong"<<endl;
-            return false;
-        }
-        // 加载自己的证书
-        if(SSL_CTX_use_certificate_chain_file(ctx, cacert) <= 0)
-        {
-            cerr<<"load cert wrong"<<endl;
-            return false;
-        }
-        //assert(SSL_CTX_use_certificate_file(ctx, "cacert.pem", SSL_FILETYPE_PEM) > 0);
-        // 加载自己的私钥 
-        if(passwd!="")
-            SSL_CTX_set_default_passwd_cb_userdata(ctx, (void*)passwd);
-        if(SSL_CTX_use_PrivateKey_file(ctx, key, SSL_FILETYPE_PEM) <= 0)
-        {
-            cerr<<"load key wrong"<<endl;
-            return false;
-        }
- 
-        // 判定私钥是否正确  
-        if(!SSL_CTX_check_private_key(ctx))
-        {
-            cerr<<"key wrong"<<endl;
-            return false;
-        }
-
-        TLS=true;
-        signal(SIGPIPE,SIG_IGN);
-        return true;
-    }
-    void stt::network::TcpServer::redrawTLS()
-    {
-        if(TLS)
-        {
-            SSL_CTX_free(ctx);
-            TLS=false;
-        }
-    }
-    bool stt::network::TcpServer::startListen(const int &port,const int &threads)
-    {
-        if(threads<=0)
-            return false;
-        if(isListen())
-        {
-            //是否是改变端口的监听？
-            if(this->port==port)
-                return true;
-            else
-            {
-                stopListen();
-                flag=false;
-            }
-        }
-        //this->logfile=logfile;
-        //memset(solvingFD,0,sizeof(int)*maxFD);
-        //clientfd=new TcpFDInf[maxFD];
-        
-        //fdQueue=new queue<QueueFD>[threads];
-        //cv=new condition_variable[threads];
-        //lq1=new mutex[threads];
-        clientfd=new TcpFDInf[maxFD];
-        for(int ii=0;ii<maxFD;ii++)
-            clientfd[ii].fd=-1;
-        //socket准备
-        fd=socket(AF_INET,SOCK_STREAM,0);
-        if(fd<0)
-        {
-            perror("socket");
-            return false;
-        }
-        //设置unblock和mutiuse
-        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
-        fcntl(fd,F_SETFL,flags|O_NONBLOCK);
-        int opt=1;
-        if(setsockopt(fd,SOL_SOCKET,SO_REUSEADDR|SO_REUSEPORT,&opt,sizeof(opt))<0)
-        {
-            cerr<<"set multi failed"<<endl;
-            perror("setsockopt");
-            return false;
-        }
-        //bind
-        struct sockaddr_in k;
-        memset(&k,0,sizeof(k));
-        k.sin_family=AF_INET;
-        k.sin_port=htons(port);
-        this->port=port;
-        k.sin_addr.s_addr=htonl(INADDR_ANY);
-        if(bind(fd,(struct sockaddr*)&k,sizeof(k))!=0)
-        {
-            perror("bind");
-            ::close(fd);
-            return false;
-        }
-        //listen
-        uint64_t backlog = maxFD / 50;  // 经验值
-        //backlog = std::clamp(backlog, 128, 4096);
-        if(backlog<128)
-            backlog=128;
-        else if(backlog>4096)
-            backlog=4096;
-        if(listen(fd,backlog)!=0)
-        {
-            perror("listen");
-            ::close(fd);
-            return false;
-        }
-        //this->logfile=logfile;
-        flag1=true;
-        flag2=false;
-        this->unblock=true;
-        
-        workpool=new WorkerPool(threads);
-        //for(int sj=0;sj<threads;sj++)
-        //    thread(&TcpServer::consumer,this,sj).detach();
-        thread(&TcpServer::epolll,this,maxFD+10).detach();
-        //flag_detect=true;
-        //thread(&security::ConnectionLimiter::connectionDetect,&connectionLimiter).detach();
-        //this->consumerNum=threads;
-
-        connection_obj_fd=1;
-        flag=true;
-        //this->logfile=logfile;
-        return true;
-    }
-    bool stt::network::TcpServer::stopListen()
-    {
-        if(!isListen())
-        {
-            return true;
-        }
-        shutdown(fd,SHUT_RDWR);
-        ::close(fd);
-        //随后取消掉几个监听和消费线程
-        do
-        {
-            flag1=false;
-        }while(!flag2);
-        //for(int ii=0;ii<consumerNum;ii++)
-        //    cv[ii].notify_all();
-        //while(consumerNum!=0||!flag2)
-        //{
-        //    flag1=false;//不断提醒关闭
-        //    for(int ii=0;ii<consumerNum;ii++)
-        //        cv[ii].notify_all();
-        //}
-        workpool->stop();
-        flag=false;
-        //关闭监听连接的消息活动的线程
-        //do
-        //{
-        //    flag_detect=false;
-        //}while(flag_detect_status);
-        return true;
-    }
-    bool stt::network::TcpServer::close()
-    {
- 
-        if(isListen())
-        {
-            if(!stopListen())
-                return false;
-        }
-  
-        //unique_lock<mutex> lock2(lc1);
-        //unique_lock<mutex> lock1(ltl1);
-        for(int ii=0;ii<maxFD;ii++)
-        {
-
-            if(clientfd[ii].fd!=-1)
-            {
-
-            if(this->security_open)
-                connectionLimiter.clearIP(clientfd[ii].ip,ii);
-            //auto jj=tlsfd.find(ii.first);
-
-            if(clientfd[ii].ssl!=nullptr)//这个套接字启用了tls
-            {
-                SSL_shutdown(clientfd[ii].ssl);
-                SSL_free(clientfd[ii].ssl);
-            }
-  
-            shutdown(ii,SHUT_RDWR);
-            ::close(ii);
-            //clientfd[ii].fd=-1;
-            //clientfd[ii].pendindQueue.clear();
-            delete[] clientfd[ii].buffer;
-            //delete clientfd[ii];
-            }
-        }
-        //std::cout<<"tcp died"<<std::endl;
-        delete[] clientfd;
-        //delete[] fdQueue;
-        //delete[] lq1;
-        //delete[] cv;
-        //clientfd.clear();
-        //key.clear();
-        //functionT.clear();
-        //redrawTLS();
-        return true;
-    }
-    bool stt::network::TcpServer::close(const int &fd)
-    {
-       
-        //unique_lock<mutex> lock2(lc1);
-        //unique_lock<mutex> lock1(ltl1);
-        //auto ii=clientfd.find(fd);
-        
-        if(fd>=maxFD||clientfd[fd].fd==-1)
-        {
-            
-            return false;
-        }
-        else
-        {
-            
-            if(this->security_open)
-                connectionLimiter.clearIP(clientfd[fd].ip,clientfd[fd].fd);
-            
-            //auto jj=tlsfd.find(fd);
-            
-            if(clientfd[fd].ssl!=nullptr)
-            {
-                if(clientfd[fd].tls_state != TLSState::HANDSHAKING)
-                {
-                    SSL_shutdown(clientfd[fd].ssl);
-                }
-                SSL_free(clientfd[fd].ssl);
-            }
-            
-            ::close(clientfd[fd].fd);
-
-            closeFun(clientfd[fd].fd);
-            
-            clientfd[fd].fd=-1;
-            
-            delete[] clientfd[fd].buffer;
-            
-            clientfd[fd].pendindQueue= std::queue<std::any>();
-            
-        }
-        
-        return true;
-    }
-    chrono::high_resolution_clock::time_point start;
-    chrono::high_resolution_clock::time_point endd;
-    chrono::microseconds duration;
-    unsigned long op=0;
-    int times=0;
-    
-    void stt::network::TcpServer::epolll(const int &evsNum)
-    {
-    
-        int epollFD=epoll_create(1);//创建epoll句柄
-        epoll_event ev;//epoll事件的数据结构
-        ev.data.fd=fd;
-        ev.events=EPOLLIN|EPOLLET;//边缘触发
-        epoll_ctl(epollFD,EPOLL_CTL_ADD,fd,&ev);//把事件放入epoll中
-
-        //加入worker线程fd
-        workerEventFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
-        ev.events = EPOLLIN;
-        ev.data.fd = workerEventFD;
-
-        epoll_ctl(epollFD, EPOLL_CTL_ADD, workerEventFD, &ev);
-
-        //加入时间事件fd
-        int hbTimerFD=-1;
-        if(serverType==3)//加入websocket心跳时间事件
-        {
-            hbTimerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
-            itimerspec its{};
-            its.it_interval.tv_sec = 30;   // 每 30 秒触发一次
-            its.it_value.tv_sec    = 30;   // 首次 30 秒后触发
-            timerfd_settime(hbTimerFD, 0, &its, nullptr);
-            //丢进epoll
-            epoll_event ev;
-            ev.data.fd = hbTimerFD;
-            ev.events  = EPOLLIN;
-            epoll_ctl(epollFD, EPOLL_CTL_ADD, hbTimerFD, &ev);
-        }
-        int securityTimerFD=-1;
-        if(this->security_open)//加入信息安全的时间事件
-        {
-            securityTimerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
-            itimerspec its{};
-            its.it_interval.tv_sec = this->checkFrequency;   
-            its.it_value.tv_sec    = this->checkFrequency;   
-            timerfd_settime(securityTimerFD, 0, &its, nullptr);
-            //丢进epoll
-            epoll_event ev;
-            ev.data.fd = securityTimerFD;
-            ev.events  = EPOLLIN;
-            epoll_ctl(epollFD, EPOLL_CTL_ADD, securityTimerFD, &ev);
-        }
-
-
-        //检查连接表里面是不是有套接字，有的话加入
-       
-        for(int ii=0;ii<maxFD;ii++)
-        {
-            //unique_lock<mutex> lock6(lc1);
-
-                if(clientfd[ii].fd!=-1)
-                {
-                //cout<<"has:"<<clientfd[ii].fd<<endl;
-                ev.data.fd=clientfd[ii].fd;
-                
-                    ev.events=EPOLLIN|EPOLLERR | EPOLLHUP | EPOLLRDHUP|EPOLLET;//边缘触发
-
-                epoll_ctl(epollFD,EPOLL_CTL_ADD,clientfd[ii].fd,&ev);//把事件放入epoll中
-                }
-        }
-       //cout<<"ok"<<endl;
-       
-        epoll_event *evs=new epoll_event[evsNum];//存放epoll返回的事件
-
-        //用来accept的
-        struct sockaddr_in k;
-        socklen_t k_len=sizeof(k);
-        //用来加密accept的
-        SSL *ssl;
-        int ret;
-        
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("tcp server epoll打开");
-            else
-                stt::system::ServerSetting::logfile->writeLog("tcp server epoll has opened");
-        }
-        
-        while(flag1)
-        {
-            //监听等待，一秒钟检查一次flag条件是否满足
-            int infds=epoll_wait(epollFD,evs,evsNum,1000);
-            if(infds<=0)//<0失败=0超时
-            {
-                continue;
-            }
-            else//有事发生
-            {
-                for(int ii=0;ii<infds;ii++)
-                {
-                    if(evs[ii].data.fd==fd)//有新的连接
-                    {
-                        while(1)
-                        {  
-
-                            k_len = sizeof(k);
-                            int cfd=accept(fd,(struct sockaddr*)&k,&k_len);
-                            if(cfd<0)
-                            {
-                                if(errno==EAGAIN||errno==EWOULDBLOCK)
-                                    break;//全部连接都accept了
-                                else//真的失败
-                                {
-                                    if(stt::system::ServerSetting::logfile!=nullptr)
-                                    {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:accept错误 error="+errno);
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:accept failed error="+errno);
-                                    }
-                                    continue;
-                                }
-                            }
-                            string ip(inet_ntoa(k.sin_addr));//获取客户端的ip
-                            if(cfd>=maxFD)
-                            {
-                                ::close(cfd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" ip连接数量达到系统上限，已经关闭这个连接");
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" this connection has been closed because system connection has been reached limit");
-                                }
-                                continue;
-                            }
-                            
-                            
-                            if(this->security_open)
-                            {
-                                int ret=connectionLimiter.allowConnect(ip,cfd,connectionTimes,connectionSecs);
-                                if(ret==stt::security::DefenseDecision::CLOSE)
-                                {
-                                ::close(cfd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" 此ip连接数量或者速度达到上限，已经关闭这个连接");
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" this connection has been closed because this ip has reached connection num's or rate's limit");
-                                }
-                                continue;
-                                }
-                            }
-                            int flags=fcntl(cfd,F_GETFL,0);
-                            if(flags==-1)
-                            {
-                                ::close(cfd);
-                                //cout<<"The non-blocking mode setting failed"<<endl;
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" 非阻塞模式设置失败");
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" The non-blocking mode setting failed");
-                                }
-                                continue;
-                            }
-                            if(fcntl(cfd,F_SETFL,flags|O_NONBLOCK)==-1)
-                            {
-                                ::close(cfd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" 非阻塞模式设置失败");
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" The non-blocking mode setting failed");
-                                }
-                                continue;
-                            }
-                            
-                            if(TLS)//加密accept
-                            {
-                                ssl=SSL_new(ctx);
-                                if(ssl==nullptr)
-                                {
-                                    cerr<<"new ssl wrong"<<endl;
-                                    ::close(cfd);
-                                    continue;
-                                }
-                                SSL_set_accept_state(ssl);
-                                //关联这个fd和ss
-                                SSL_set_fd(ssl,cfd);
-
-                                clientfd[cfd].tls_state = TLSState::HANDSHAKING;
-                                
-                                //unique_lock<mutex> lock1(ltl1);
-                                //tlsfd.emplace(cfd,ssl);//emplace???erase???
-
-                            }
-                            else
-                            {
-                                ssl=nullptr;
-                                clientfd[cfd].tls_state = TLSState::NONE;
-                            }
-                            clientfd[cfd].ssl=ssl;
-                            //cout<<"ok"<<endl;
-                            //epoll注册
-                            ev.data.fd=cfd;
-                            
-                                ev.events=EPOLLIN|EPOLLERR | EPOLLHUP | EPOLLRDHUP|EPOLLET;//边缘触发
-
-                            epoll_ctl(epollFD,EPOLL_CTL_ADD,cfd,&ev);
-                            //cout<<"listen:"<<cfd<<endl;
-                            //对象表注册
-                            string port=to_string(k.sin_port);//获取客户端的端口
-                            //string ip(inet_ntoa(k.sin_addr));//获取客户端的ip
-                            clientfd[cfd].fd=cfd;
-                            clientfd[cfd].ip=ip;
-                            clientfd[cfd].port=port;
-                            clientfd[cfd].status=0;
-                            clientfd[cfd].data="";
-                            clientfd[cfd].buffer=new char[buffer_size];
-                            clientfd[cfd].p_buffer_now=0;
-                            clientfd[cfd].FDStatus=-1;
-                            clientfd[cfd].connection_obj_fd=this->connection_obj_fd++;
-                            //clientfd[cfd].p_request_now=0;
-                            //unique_lock<mutex> lock6(lc1);
-                            //clientfd.emplace(cfd,inf);
-                            
-                            //lock6.unlock();
-                            //写入日志
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server epoll:收到新的连接："+ip+":"+port+"存入fd= "+to_string(cfd));
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server epoll:has received a new connection: "+ip+":"+port+"save as fd= "+to_string(cfd));
-                            }
-                        }                                                
-                    }
-                    else if(evs[ii].data.fd==hbTimerFD)//websocket时间事件
-                    {
-                        uint64_t exp;
-                        read(hbTimerFD, &exp, sizeof(exp)); // 必须读，清事件
-                        handleHeartbeat(); 
-                    }
-                    else if(evs[ii].data.fd==securityTimerFD)//信息安全时间事件
-                    {
-                       
-                        uint64_t exp;
-                        read(securityTimerFD, &exp, sizeof(exp)); // 必须读，清事件
-                        //遍历判断所有
-                        for(int i=0;i<maxFD;i++)
-                        {
-                            if(clientfd[i].fd!=-1)
-                            {
-                                if(this->connectionLimiter.connectionDetect(clientfd[i].ip,i))//超时 是僵尸连接
-                                {
-                                    
-                                    if(stt::system::ServerSetting::logfile!=nullptr)
-                                    {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:监测到僵尸连接：fd= "+to_string(i)+" 已关闭");
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll : has detected a zoombie connection : fd= "+to_string(i)+" and it has been closed");
-                                    }
-                                    close(i);
-                                    
-                                    
-
-
-                                }
-                            }
-                        }
-                    }
-                    else if(evs[ii].data.fd==workerEventFD)//worker事件
-                    {
-                        uint64_t cnt;
-                        read(workerEventFD, &cnt, sizeof(cnt)); // 清门铃
-                        WorkerMessage wm;
-                        // 一口气处理完队列
-                        while(finishQueue.pop(wm))
-                        {
-                            handler_workerevent(wm.fd,wm.ret);
-                        }
-                    }
-                    else//有数据上来了
-                    {
-                       //start=chrono::high_resolution_clock::now();
-                        if(evs[ii].events&(EPOLLERR | EPOLLHUP | EPOLLRDHUP))
-                        {
-
-                                
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("tcp server epoll:收到连接关闭消息：fd= "+to_string(evs[ii].data.fd)+" 已关闭");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("tcp server epoll:receive connection close message: fd= "+to_string(evs[ii].data.fd)+" and it has been pushed into queue");
-                                }
-                                
-
-                                close(evs[ii].data.fd);
-                                //{
-                                //std::lock_guard<std::mutex> lock(lq1[evs[ii].data.fd%consumerNum]);
-                                //fdQueue[evs[ii].data.fd%consumerNum].push(QueueFD{evs[ii].data.fd,true});
-                               //}
-                                //cv[evs[ii].data.fd%consumerNum].notify_one();
-                            
-
-                        }
-                        else
-                        {
-                            //tls状态
-                            if (clientfd[evs[ii].data.fd].tls_state == TLSState::HANDSHAKING) 
-                            {
-                                //tls accept
-                                int ret = SSL_accept(clientfd[evs[ii].data.fd].ssl);
-                                if (ret == 1) 
-                                {
-                                    clientfd[evs[ii].data.fd].tls_state = TLSState::ESTABLISHED;
-                                    // TLS 握手完成
-                                    if(stt::system::ServerSetting::logfile!=nullptr)
-                                    {
-                                        if(stt::system::ServerSetting::language=="Chinese")
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:收到TLS握手数据：fd= "+to_string(evs[ii].data.fd)+",完成!");
-                                        else
-                                            stt::system::ServerSetting::logfile->writeLog("tcp server epoll:has received tls handshake data: fd= "+to_string(evs[ii].data.fd)+",finish!");
-                                    }
-                                } 
-                                else 
-                                {
-                                    int err = SSL_get_error(clientfd[evs[ii].data.fd].ssl, ret);
-                                    if (err == SSL_ERROR_WANT_READ) 
-                                    {
-                                        // 等下一个 EPOLLIN
-                                        
-                                    } 
-                                    else if (err == SSL_ERROR_WANT_WRITE) 
-                                    {
-                                        // 确保监听 EPOLLOUT
-                                        
-                                    }
-                                    else 
-                                    {
-                                        // 真错误
-                                        //printf("SSL_accept error: %s\n", ERR_error_string(ERR_get_error(), nullptr));
-    	                                //printf("SSL_accept returned %d, SSL error code: %d\n", ret, SSL_get_error(ssl, ret));
-                                        //SSL_free(clientfd[evs[ii].data.fd].ssl);
-                                        close(evs[ii].data.fd);
-                                        if(stt::system::ServerSetting::logfile!=nullptr)
-                                        {
-                                            if(stt::system::ServerSetting::language=="Chinese")
-                                                stt::system::ServerSetting::logfile->writeLog("tcp server epoll:TLS握手：fd= "+to_string(evs[ii].data.fd)+"错误");
-                                            else
-                                                stt::system::ServerSetting::logfile->writeLog("tcp server epoll: received tls handshake data: fd= "+to_string(evs[ii].data.fd)+" fail");
-                                        }
-                                    }
-                                }
-                                continue;
-                            }
-                            //普通数据
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server epoll:收到新数据：fd= "+to_string(evs[ii].data.fd));
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server epoll:has received new data: fd= "+to_string(evs[ii].data.fd));
-                            }
-                            handler_netevent(evs[ii].data.fd);
-                             //{
-                             //   std::lock_guard<std::mutex> lock(lq1[evs[ii].data.fd%consumerNum]);
-                             //   fdQueue[evs[ii].data.fd%consumerNum].push(QueueFD{evs[ii].data.fd,false});
-                             //}
-                            //cv[evs[ii].data.fd%consumerNum].notify_one();
-                        }
-                        //endd=chrono::high_resolution_clock::now();
-                        //duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-                        //cout<<"入队用时"<<duration.count()<<endl;
-                    }
-                }
-            }
-        }
-        delete[] evs;
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("tcp服务器监听的epoll退出");
-            else
-                stt::system::ServerSetting::logfile->writeLog("tcp server's listening epoll quit");
-        }
-        //cout<<"epoll quit"<<endl;
-        flag2=true;
-    }
-    void stt::network::TcpServer::handler_workerevent(const int &fd,const int &ret)
-    {
-        if(ret==-2)
-        {
-            TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : worker处理失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : worker solve fail fd= "+to_string(fd)+" ,now has closed this connection");
-                    }
-            return;
-        }
-        TcpFDHandler k;
-        k.setFD(fd,clientfd[fd].ssl,unblock);
-        if(ret==-1)
-        {
-            clientfd[fd].pendindQueue.pop();
-            if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : worker处理失败 fd= "+to_string(fd)+" ，跳过本次请求");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : worker solve fail fd= "+to_string(fd)+" ,skip this request");
-                    }
-        }
-        else
-        {
-            if(clientfd[fd].pendindQueue.empty())
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("tcp server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("tcp server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
-                }
-                return;
-            }
-            TcpInformation &inf=std::any_cast<TcpInformation&>(clientfd[fd].pendindQueue.front());
-            if(inf.connection_obj_fd!=clientfd[fd].connection_obj_fd)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("tcp server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("tcp server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
-                }
-                return;
-            }
-            auto ii=solveFun.find(std::any_cast<const std::string&>(inf.ctx["key"]));//对应的任务
-            if(stt::system::ServerSetting::logfile!=nullptr)
-            {
-                if(stt::system::ServerSetting::language=="Chinese")
-                    stt::system::ServerSetting::logfile->writeLog("tcp server : worker处理成功 fd= "+to_string(fd));
-                else
-                    stt::system::ServerSetting::logfile->writeLog("tcp server : worker solve sucessfully fd= "+to_string(fd));
-            }
-            if(ii==solveFun.end())//找不到
-                {
-                    //TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                    }
-                    if(!globalSolveFun(k,inf))
-                    {
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
-                        }
-                        return;
-                    }
-                    clientfd[fd].pendindQueue.pop();
-                }
-            else
-            {
-            //继续做
-            for(;clientfd[fd].FDStatus<ii->second.size();)
-            {
-                int rett=ii->second[clientfd[fd].FDStatus](k,inf);
-                clientfd[fd].FDStatus++;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
-                            }
-                            //clientfd[fd].pendindQueue.pop();
-                            return;
-                        }
-            }
-            }
-            clientfd[fd].pendindQueue.pop();
-        }
-
-        TcpFDInf Tcpinf=clientfd[fd];
-        //检查是否有下一轮
-        if(Tcpinf.pendindQueue.size()>=1)//只有一个 说明没有任务没做完 直接执行
-            {
-                TcpInformation &inff=std::any_cast<TcpInformation&>(clientfd[fd].pendindQueue.front());
-                Tcpinf.FDStatus=-1;
-                int ret;
-                //获取key,自动解析到ctx的key键
-                ++Tcpinf.FDStatus;
-                ret=parseKey(k,inff);
-
-                if(ret==0) //慢任务
-                    return;
-                else if(ret<=-1)
-                {
-                    //清掉任务后返回
-                    Tcpinf.pendindQueue.pop();
-                    //-2要关闭连接
-                    if(ret==-2)
-                    {
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
-                        }
-                    }
-                    else
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey fail fd= "+to_string(fd)+",now has throwed this task");
-                        }
-                    }
-                    return;
-                }
-                
-                //遍历任务
-                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
-                if(ii==solveFun.end())//找不到
-                {
-                    //TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                    }
-                    if(!globalSolveFun(k,inff))
-                    {
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
-                        }
-                        return;
-                    }
-                    Tcpinf.pendindQueue.pop();
-                }
-                else//找得到处理函数
-                {
-                    for(auto &f:ii->second)
-                    {
-                        int rett=f(k,inff);
-                        ++Tcpinf.FDStatus;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else if(rett==-1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                        else
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                    }
-                    
-                }
-                Tcpinf.pendindQueue.pop();
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" sucessfully");
-                    }
-                
-            }
-
-    }
-    void stt::network::TcpServer::handler_netevent(const int &fd)
-    {
-        TcpFDHandler k;
-        TcpInformation inf;
-        if(clientfd[fd].fd!=-1)//can not find fd information,we need to writedown this error and close this fd
-        {
-            
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("tcp server : 正在处理fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("tcp server : now handleing fd= "+to_string(fd));
-                }
-            
-            TcpFDInf &Tcpinf=clientfd[fd];
-            k.setFD(fd,clientfd[fd].ssl,unblock);
-            
-            int ret=1;
-            Tcpinf.p_buffer_now=0;
-            while(ret>0&&buffer_size-Tcpinf.p_buffer_now>0)
-            {
-                ret=k.recvData(Tcpinf.buffer+Tcpinf.p_buffer_now,buffer_size-Tcpinf.p_buffer_now);
-                if(ret>0)
-                    Tcpinf.p_buffer_now+=ret;
-            }
-            if(buffer_size-Tcpinf.p_buffer_now<=0)
-            {
-                TcpServer::close(fd);
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 缓冲区容量不足 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : buffer size is not enough,read data from fd= "+to_string(fd)+" fail,now has closed this connection");
-                    }
-                return;
-            }
-            if(ret<=0)
-            {
-                if(ret!=-100)
-                {
-                    TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : read data from fd= "+to_string(fd)+" fail,now has closed this connection");
-                    }
-                    return;
-                }
-            }
-        //}
-        
-            inf.fd=fd;
-            inf.connection_obj_fd=clientfd[fd].connection_obj_fd;
-            inf.data=string(Tcpinf.buffer,Tcpinf.p_buffer_now);
-
-            
-            //lock6.unlock();
-            //开始处理
-                //入队
-            
-            Tcpinf.pendindQueue.push(move(inf));
-            
-            if(Tcpinf.pendindQueue.size()==1)//只有一个 说明没有任务没做完 直接执行
-            {
-                TcpInformation &inff=std::any_cast<TcpInformation&>(clientfd[fd].pendindQueue.front());
-                Tcpinf.FDStatus=-1;
-                int ret;
-                //获取key,自动解析到ctx的key键
-                ++Tcpinf.FDStatus;
-                ret=parseKey(k,inff);
-                
-                if(ret==0) //慢任务
-                {
-                    return;
-                }
-                else if(ret<=-1)
-                {
-                    //清掉任务后返回
-                    //Tcpinf.pendindQueue.pop();
-                    //-2要关闭连接
-                    if(ret==-2)
-                    {
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
-                        }
-                    }
-                    else
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : parsekey fail fd= "+to_string(fd)+",now has throwed this task");
-                        }
-                    }
-                    return;
-                }
-                if(security_open)
-                {
-                    int ret=connectionLimiter.allowRequest(clientfd[fd].ip,fd,std::any_cast<const std::string&>(inff.ctx["key"]),requestTimes,requestSecs);
-                    if(ret!=stt::security::ALLOW)
-                    {
-                        securitySendBackFun(k,inff);
-                        if(ret==stt::security::CLOSE)
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : fd="+to_string(fd)+"请求太频繁，已经关闭连接");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
-                            }
-                        }
-                        else
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : fd="+to_string(fd)+"请求太频繁，已经忽略请求");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
-                            }
-                        }
-                        return;
-                    }
-                }
-                //遍历任务
-                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
-               
-                if(ii==solveFun.end())//找不到
-                {
-                    
-                    //TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                    }
-                    if(!globalSolveFun(k,inff))
-                    {
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
-                        }
-                        return;
-                    }
-                    Tcpinf.pendindQueue.pop();
-                }
-                else//找得到处理函数
-                {
-                    
-                    for(auto &f:ii->second)
-                    {
-                        int rett=f(k,inff);
-                        ++Tcpinf.FDStatus;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else if(rett==-1)
-                        {
-                        
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                        else
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                    }
-                    Tcpinf.pendindQueue.pop();
-                }
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : 处理fd= "+to_string(fd)+" 完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("tcp server : handled fd= "+to_string(fd)+" sucessfully");
-                    }
-                
-            }
-            
-        }
-    }
-    /*
-    void stt::network::TcpServer::consumer(const int &threadID)
-    {
-        TcpFDHandler k;
-
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-            stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" 打开");
-            else
-                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" 打开");
-        }
-        while(flag1)
-        {
-            unique_lock<mutex> ul1(lq1[threadID]);
-            while(fdQueue[threadID].empty()&&flag1)
-            {
-                cv[threadID].wait(ul1);
-            }
-            if(!flag1)
-            {
-                ul1.unlock();
-                break;
-            }
-            QueueFD cclientfd=fdQueue[threadID].front();
-            fdQueue[threadID].pop();
-            
-            ul1.unlock();
-
-            
-            if(cclientfd.close)
-            {
-                TcpServer::close(cclientfd.fd);
-                continue;
-            }
-            
-            //unique_lock<mutex> lock6(lc1);
-            //auto jj=clientfd.find(cclientfd.fd);
-            if(clientfd[cclientfd.fd].fd==-1)//can not find fd information,we need to writedown this error and close this fd
-            {
-                //lock6.unlock();
-                continue;
-            }
-            else
-            {
-                if(security_open)
-                {
-                    if(!connectionLimiter.allowRequest(clientfd[cclientfd.fd].ip))
-                    {
-                        TcpServer::close(cclientfd.fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"请求太频繁，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"request are too frequent,now has closed this connection");
-                        }
-                        continue;
-                    }
-                }
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : 正在处理fd= "+to_string(cclientfd.fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" :now handleing fd= "+to_string(cclientfd.fd));
-                }
-                k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                TcpFDInf &Tcpinf=clientfd[cclientfd.fd];
-            //lock6.unlock();
-            
-            if(!fc(k,Tcpinf))
-            {
-                TcpServer::close(cclientfd.fd);
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer"+to_string(threadID)+" : 处理fd= "+to_string(cclientfd.fd)+" 失败，已经关闭连接");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : handled fd= "+to_string(cclientfd.fd)+" fail,now has closed this connection");
-                }
-            }
-            else
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer"+to_string(threadID)+" : 处理fd= "+to_string(cclientfd.fd)+" 完成");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : handled fd= "+to_string(cclientfd.fd)+" sucessfully");
-                }
-            }
-            }
-            
-        }
-        //跳出循环意味着结束线程
-        unique_lock<mutex> lock3(lco1);
-        consumerNum--;
-        lock3.unlock();
-        cout<<"consumer "<<consumerNum<<" quit"<<endl;
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(consumerNum)+"退出");
-            else
-                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(consumerNum)+"quit");
-        }
-    }
-    */
-    bool stt::network::HttpServerFDHandler::sendBack(const string &data,const string &header,const string &code,const string &header1)
-    {
-
-        string result="HTTP/1.1 "+code+"\r\nContent-Length: "+\
-             to_string(data.length())+"\r\n"+\
-             header1+\
-             header+"\r\n"+\
-             data;
-        
-        if(sendData(result)!=result.length())
-        {
-            return false;
-        }
-        return true;
-    }
-    
-    bool stt::network::HttpServerFDHandler::sendBack(const char *data,const size_t &length,const char *header,const char *code,const char *header1,const size_t &header_length)
-    {
-         
-        /*
-        string ii="HTTP/1.1 "+code+"\r\nContent-Length: "+\
-             to_string(length)+"\r\n"+\
-             header1+\
-             header+"\r\n";
-        char *buffer=new char[length+ii.length()];
-        memcpy(buffer,ii.c_str(),ii.length());
-        memcpy(buffer+ii.length(),data,length);
-        if(sendData(buffer,length+ii.length())!=length+ii.length())
-        {
-            delete buffer;
-            return false;
-        }
-        delete buffer;
-        */
-        char *buffer=new char[length+header_length+4+1];       
-        size_t ret=snprintf(buffer,length+header_length+4+1,"HTTP/1.1 %s\r\nContent-Length: %zu\r\n%s%s\r\n%s",code,length,header,header1,data);
-        if(ret<length+header_length+4+1)
-        {
-            if(sendData(buffer,ret)!=ret)
-            {
-                delete[] buffer;
-                return false;
-            }
-            delete[] buffer;
-            return true;
-        }
-        else
-        {
-            delete[] buffer;
-            return false;
-        }
-    }
-    
-    int stt::network::HttpServerFDHandler::solveRequest(TcpFDInf &TcpInf,HttpRequestInformation &HttpInf,const unsigned long &buffer_size,const int &times)
-    {
-
-        if(times==1)
-        {
-            
-            //unsigned long long p_buffer_now_backup=TcpInf.p_buffer_now;
-            int ret=1;
-            while(ret>0&&buffer_size-TcpInf.p_buffer_now>0)
-            {
-                
-                ret=recvData(TcpInf.buffer+TcpInf.p_buffer_now,buffer_size-TcpInf.p_buffer_now);
-                if(ret>0)
-                    TcpInf.p_buffer_now+=ret;
-            }
-            if(buffer_size-TcpInf.p_buffer_now<=0)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server : 缓冲区容量不足 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server : buffer size is not enough,read data from fd= "+to_string(fd)+" fail,now has closed this connection");
-                    }
-                return -1;
-            }
-            if(ret<=0)
-            {
-                
-                if(ret!=-100)
-                    return -1;
-                
-            }
-            //TcpInf.data=string_view(TcpInf.buffer+p_buffer_now_backup,TcpInf.p_buffer_now);
-            TcpInf.data=string_view(TcpInf.buffer,TcpInf.p_buffer_now);
-            //cout<<TcpInf.data<<endl;
-        }
-        //cout<<TcpInf.data<<endl;
-        //endd=chrono::high_resolution_clock::now();
-        //                duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-        //                cout<<"接受完数据用时"<<duration.count()<<endl;
-        //数据准备完成，开始判断
-        
-        if(TcpInf.status==0||TcpInf.status==1)
-        {
-            auto pos=TcpInf.data.find("\r\n\r\n");
-            if(pos==string::npos)
-            {
-                if(TcpInf.status==0)
-                    TcpInf.status=1;
-                //memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
-                //TcpInf.p_buffer_now=TcpInf.data.length();
-                
-                return 0;
-            }
-            
-            //转到状态2或者3
-            HttpInf.header=TcpInf.data.substr(0,pos);
-            
-            
-            if(HttpInf.header.find("Transfer-Encoding: chunked")!=string::npos)//状态2
-            {
-                TcpInf.status=2;
-                
-                if(TcpInf.data.find("0\r\n\r\n")==string::npos)
-                {
-                    //memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
-                    HttpInf.header=string(TcpInf.buffer,pos);
-                    //TcpInf.p_buffer_now=TcpInf.data.length();
-                    return 0;
-                }
-                string_view size;
-                int ssize;
-                size_t ppos=0;
-                TcpInf.data=TcpInf.data.substr(2+HttpInf.header.length());
-                while(1)
-                {
-                    HttpStringUtil::get_split_str(TcpInf.data,size,"\r\n","\r\n",ppos);
-                    
-                    ppos=TcpInf.data.find("\r\n",ppos+2);
-                    NumberStringConvertUtil::str16toInt(string(size),ssize);
-                    if(ssize==-1)
-                    {
-                        
-                        return -1;
-                    }
-                    else if(ssize==0)
-                    {
-                        //TcpInf.data=TcpInf.data.substr(ppos+5);
-                        TcpInf.status=0;
-                        //if(TcpInf.data.length()==ppos+2)
-                        //    TcpInf.data={};
-                        //else
-                        //    TcpInf.data=TcpInf.data.substr(ppos+2);
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                        memcpy(TcpInf.buffer,TcpInf.buffer+ppos+2,TcpInf.p_buffer_now-(ppos+2));
-                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(ppos+2);
-                        return 1;
-                    }
-                    else//读取数据
-                    {
-                        HttpInf.body_chunked+=TcpInf.data.substr(ppos+2,ssize);
-                        ppos=ppos+2+ssize;
-                    }
-                }
-            }
-            else//状态3
-            {
-                 //endd=chrono::high_resolution_clock::now();
-                 //       duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-                 //       cout<<"状态3用时"<<duration.count()<<endl;
-                TcpInf.status=3;
-                string_view size;
-                long ssize;
-
-                HttpStringUtil::get_split_str(HttpInf.header,size,"Content-Length: ","\r\n");
-                 //endd=chrono::high_resolution_clock::now();
-                //        duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-                 //       cout<<"split完用时"<<duration.count()<<endl;
-                NumberStringConvertUtil::toLong(string(size),ssize);
-                // endd=chrono::high_resolution_clock::now();
-                //        duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-                //        cout<<"tolong完用时"<<duration.count()<<endl;
-                if(ssize==-1)
-                {
-                    
-                    //if(HttpInf.header.find("GET")!=string::npos)
-                    //{
-                        TcpInf.status=0;
-                        //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
-                        //    TcpInf.data={};
-                        //else
-                        //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                        memcpy(TcpInf.buffer,TcpInf.buffer+HttpInf.header.length()+4,TcpInf.p_buffer_now-(HttpInf.header.length()+4));
-                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(HttpInf.header.length()+4);
-                        return 1;
-                    //}
-                    //else
-                    //    return -1;
-                }
-                else if(ssize==0)
-                {
-                    TcpInf.status=0;
-                    //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
-                    //    TcpInf.data={};
-                    //else
-                    //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
-                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                    HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                    HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                    memcpy(TcpInf.buffer,TcpInf.buffer+HttpInf.header.length()+4,TcpInf.p_buffer_now-(HttpInf.header.length()+4));
-                    TcpInf.p_buffer_now=TcpInf.p_buffer_now-(HttpInf.header.length()+4);
-                    return 1;
-                }
-                else if(ssize>0)
-                {
-                    if(TcpInf.data.length()-4-HttpInf.header.length()>=ssize)
-                    {
-                        HttpInf.body=TcpInf.data.substr(4+HttpInf.header.length(),ssize);
-                        //if(TcpInf.data.length()-4-HttpInf.header.length()==ssize)
-                        //    TcpInf.data={};
-                        //else
-                        //    TcpInf.data=TcpInf.data.substr(4+HttpInf.header.length()+ssize);
-                        TcpInf.status=0;
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                        memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length()+ssize,TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize));
-                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize);
-                        return 1;
-                    }
-                    else
-                    {
-                        memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
-                        HttpInf.header=string(TcpInf.buffer,pos);
-                        TcpInf.p_buffer_now=TcpInf.data.length();
-                        return 0;
-                    }
-                }
-            }
-        }
-        else if(TcpInf.status==2)
-        {
-            if(TcpInf.data.find("0\r\n\r\n")==string::npos)
-                {
-                    memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
-                    TcpInf.p_buffer_now=TcpInf.data.length();
-                    return 0;
-                }
-                string_view size;
-                int ssize;
-                size_t ppos=0;
-                TcpInf.data=TcpInf.data.substr(2+HttpInf.header.length());
-                while(1)
-                {
-                    HttpStringUtil::get_split_str(TcpInf.data,size,"\r\n","\r\n",ppos);
-                    
-                    ppos=TcpInf.data.find("\r\n",ppos+2);
-                    NumberStringConvertUtil::str16toInt(string(size),ssize);
-                    if(ssize==-1)
-                    {
-                        
-                        return -1;
-                    }
-                    else if(ssize==0)
-                    {
-                        //TcpInf.data=TcpInf.data.substr(ppos+5);
-                        TcpInf.status=0;
-                        //if(TcpInf.data.length()==ppos+2)
-                        //    TcpInf.data={};
-                        //else
-                        //    TcpInf.data=TcpInf.data.substr(ppos+2);
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                        memcpy(TcpInf.buffer,TcpInf.buffer+ppos+2,TcpInf.p_buffer_now-(ppos+2));
-                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(ppos+2);
-                        return 1;
-                    }
-                    else//读取数据
-                    {
-                        HttpInf.body_chunked+=TcpInf.data.substr(ppos+2,ssize);
-                        ppos=ppos+2+ssize;
-                    }
-                }
-        }   
-        else if(TcpInf.status==3)
-        {
-                TcpInf.status=3;
-                string_view size;
-                long ssize;
-                HttpStringUtil::get_split_str(HttpInf.header,size,"Content-Length: ","\r\n");
-                NumberStringConvertUtil::toLong(string(size),ssize);
-
-                if(ssize==-1)
-                {
-                    
-                    //if(HttpInf.header.find("GET")!=string::npos)
-                    //{
-                        TcpInf.status=0;
-                        //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
-                        //    TcpInf.data={};
-                        //else
-                        //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                        memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length(),TcpInf.p_buffer_now-(4+HttpInf.header.length()));
-                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length());
-                        return 1;
-                    //}
-                    //else
-                    //    return -1;
-                }
-                else if(ssize==0)
-                {
-                    TcpInf.status=0;
-                    //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
-                    //    TcpInf.data={};
-                    //else
-                    //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
-                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                    HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                    HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                    memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length(),TcpInf.p_buffer_now-(4+HttpInf.header.length()));
-                    TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length());
-                    return 1;
-                }
-                else if(ssize>0)
-                {
-                    if(TcpInf.data.length()-4-HttpInf.header.length()>=ssize)
-                    {
-                        HttpInf.body=TcpInf.data.substr(4+HttpInf.header.length(),ssize);
-                        //if(TcpInf.data.length()-4-HttpInf.header.length()==ssize)
-                         //   TcpInf.data={};
-                        //else
-                        //    TcpInf.data=TcpInf.data.substr(4+HttpInf.header.length()+ssize);
-                        TcpInf.status=0;
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
-                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
-                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
-                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
-                        memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length()+ssize,TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize));
-                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize);
-                        return 1;
-                    }
-                    else
-                    {
-                        memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
-                        TcpInf.p_buffer_now=TcpInf.data.length();
-                        return 0;
-                    }
-                }
-        }
-        
-        return -1;
-
-    }
-    void stt::network::HttpServer::handler_netevent(const int &fd)
-    {
-        HttpServerFDHandler k;
-        //HttpRequestInformation inf;
-        if(clientfd[fd].fd!=-1)//can not find fd information,we need to writedown this error and close this fd
-        {
-            
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("http server : 正在处理fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("http server : now handleing fd= "+to_string(fd));
-                }
-            TcpFDInf &Tcpinf=clientfd[fd];
-            k.setFD(fd,clientfd[fd].ssl,unblock);
-            
-            int ret=1;
-            httpinf[fd].fd=fd;
-            httpinf[fd].connection_obj_fd=clientfd[fd].connection_obj_fd;
-            
-            ret=k.solveRequest(Tcpinf,httpinf[fd],buffer_size,1);
-            
-            if(ret==-1)
-            {
-                    TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server : 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server : read data from fd= "+to_string(fd)+" fail,now has closed this connection");
-                    }
-                    return;
-            }
-            else if(ret==1)
-            {
-                
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                    {
-                        if(httpinf[fd].body.length()<=1024*10 && httpinf[fd].body_chunked.length()<=1024*10)
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer  : fd= "+to_string(fd)+" 读取数据完成。 \n*******请求信息：*********\nheader= "+string(httpinf[fd].header)+"\nbody="+string(httpinf[fd].body)+"\nbody_chunked="+string(httpinf[fd].body_chunked)+"\n*************************");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer  : fd= "+to_string(fd)+" 读取数据完成。 \n*******请求信息：*********\nheader= "+string(httpinf[fd].header)+"\nbody,body_chunked= ... \n*************************");
-                    }
-                    else
-                    {
-                        if(httpinf[fd].body.length()<=1024*10 && httpinf[fd].body_chunked.length()<=1024*10)
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer  : fd= "+to_string(fd)+" now has solved request.\n*******request information：*********\nheader= "+string(httpinf[fd].header)+"\nbody="+string(httpinf[fd].body)+"\nbody_chunked="+string(httpinf[fd].body_chunked)+"\n*************************");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer  : fd= "+to_string(fd)+" now has solved request.\n*******request information：*********\nheader= "+string(httpinf[fd].header)+"\nbody,body_chunked= ... \n*************************");
-                    }
-
-                }
-                
-            }
-            else if(ret==0)
-            {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer  : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer  : fd= "+to_string(fd)+"wait new data to continue solve this request");
-                    }
-                    return;
-            }
-        
-            
-
-            
-            //lock6.unlock();
-            //开始处理
-                //入队
-            Tcpinf.pendindQueue.push(move(httpinf[fd]));
-            
-            if(Tcpinf.pendindQueue.size()==1)//只有一个 说明没有任务没做完 直接执行
-            {
-                HttpRequestInformation &inff=std::any_cast<HttpRequestInformation&>(clientfd[fd].pendindQueue.front());
-                Tcpinf.FDStatus=-1;
-                int ret;
-                //获取key,自动解析到ctx的key键
-                ++Tcpinf.FDStatus;
-                ret=parseKey(k,inff);
-    
-                if(ret==0)//慢处理
-                {
-                    return;
-                }
-                else if(ret<=-1)
-                {
-                    //清掉任务后返回
-                    //Tcpinf.pendindQueue.pop();
-                    //-2要关闭连接
-                    if(ret==-2)
-                    {
-                        k.sendBack("","","404 NOT FOUND");
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
-                        }
-                    }
-                    else
-                    {
-                        k.sendBack("","","404 NOT FOUND");
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
-                        }
-                    }
-                    return;
-                }
-                if(security_open)
-                {
-                    int ret=connectionLimiter.allowRequest(clientfd[fd].ip,fd,std::any_cast<const std::string&>(inff.ctx["key"]),requestTimes,requestSecs);
-                    if(ret!=stt::security::ALLOW)
-                    {
-                        securitySendBackFun(k,inff);
-                        if(ret==stt::security::CLOSE)
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : fd="+to_string(fd)+"请求太频繁，已经关闭连接");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
-                            }
-                        }
-                        else
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : fd="+to_string(fd)+"请求太频繁，已经忽略请求");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
-                            }
-                        }
-                        return;
-                    }
-                }
-                //遍历任务
-                
-                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
-                
-                if(ii==solveFun.end())//找不到
-                {
-                    if(globalSolveFun.size()==0)//连全局处理函数都没有 只能发404
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : 找不到处理函数也找不到全局处理函数 fd= "+to_string(fd)+"发送404 not found.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : can not find solve function and global function. fd= "+to_string(fd)+". has sent 404 not found.");
-                        }
-                        if(!k.sendBack("","","404 NOT FOUND"))
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 发送404 not found失败 fd= "+to_string(fd)+"已经关闭连接.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : sending 404 not found fail. fd= "+to_string(fd)+". has closed this connection.");
-                            }
-                            return;
-                        }
-                    }
-                    else
-                    {
-                    
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                        }
-                        for(auto &f:globalSolveFun)
-                        {
-                            int rett=f(k,inff);
-                            ++Tcpinf.FDStatus;
-                            if(rett==1)
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                                }
-                            }
-                            else if(rett==0)
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                                }
-                            
-                                return;
-                            }
-                            else if(rett==-1)
-                            {
-                            
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                                }
-                                //Tcpinf.pendindQueue.pop();
-                                return;
-                            }
-                            else
-                            {
-                                TcpServer::close(fd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                                }
-                                //Tcpinf.pendindQueue.pop();
-                                return;
-                            }
-                        }
-                    }
-                    clientfd[fd].pendindQueue.pop();
-                }
-                else//找得到处理函数
-                {
-                    for(auto &f:ii->second)
-                    {
-                        int rett=f(k,inff);
-                        ++Tcpinf.FDStatus;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            
-                            return;
-                        }
-                        else if(rett==-1)
-                        {
-                            
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                        else
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                    }
-                    Tcpinf.pendindQueue.pop();
-                }
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully");
-                    }
-                
-            }
-            
-        }
-    }
-     void stt::network::HttpServer::handler_workerevent(const int &fd,const int &ret)
-    {
-       
-        if(ret==-2)
-        {
-            TcpServer::close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server : worker处理失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server : worker solve fail fd= "+to_string(fd)+" ,now has closed this connection");
-                    }
-            return;
-        }
-        HttpServerFDHandler k;
-        k.setFD(fd,clientfd[fd].ssl,unblock);
-        
-        if(ret==-1)
-        {
-            clientfd[fd].pendindQueue.pop();
-            if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server : worker处理失败 fd= "+to_string(fd)+" ，跳过本次请求");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server : worker solve fail fd= "+to_string(fd)+" ,skip this request");
-                    }
-        }
-        else
-        {
-            if(clientfd[fd].pendindQueue.empty())
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("http server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("http server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
-                }
-                return;
-            }
-            HttpRequestInformation &inf=std::any_cast<HttpRequestInformation&>(clientfd[fd].pendindQueue.front());
-            if(inf.connection_obj_fd!=clientfd[fd].connection_obj_fd)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("http server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("http server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
-                }
-                return;
-            }
-            
-            auto ii=solveFun.find(std::any_cast<const std::string&>(inf.ctx["key"]));//对应的任务
-            if(stt::system::ServerSetting::logfile!=nullptr)
-            {
-                if(stt::system::ServerSetting::language=="Chinese")
-                    stt::system::ServerSetting::logfile->writeLog("http server : worker处理成功 fd= "+to_string(fd));
-                else
-                    stt::system::ServerSetting::logfile->writeLog("http server : worker solve sucessfully fd= "+to_string(fd));
-            }
-            if(ii==solveFun.end())//找不到
-            {
-                    
-                    if(globalSolveFun.size()==0)//连全局处理函数都没有 只能发404
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : 找不到处理函数也找不到全局处理函数 fd= "+to_string(fd)+"发送404 not found.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : can not find solve function and global function. fd= "+to_string(fd)+". has sent 404 not found.");
-                        }
-                        if(!k.sendBack("","","404 NOT FOUND"))
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 发送404 not found失败 fd= "+to_string(fd)+"已经关闭连接.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : sending 404 not found fail. fd= "+to_string(fd)+". has closed this connection.");
-                            }
-                            return;
-                        }
-                    }
-                    else
-                    {
-                    
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                        }
-                        for(;clientfd[fd].FDStatus<globalSolveFun.size();)
-                        {
-                            //继续做
-                            int rett=globalSolveFun[clientfd[fd].FDStatus](k,inf);
-                            clientfd[fd].FDStatus++;
-                            if(rett==1)
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
-                                }
-                            }
-                            else if(rett==0)
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
-                                }
-                                return;
-                            }
-                            else
-                            {
-                                TcpServer::close(fd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
-                                }
-                                //clientfd[fd].pendindQueue.pop();
-                                return;
-                            }
-                        }
-                    }
-                    clientfd[fd].pendindQueue.pop();
-            }
-            else
-            {
-            //继续做
-            
-            for(;clientfd[fd].FDStatus<ii->second.size();)
-            {
-                
-                int rett=ii->second[clientfd[fd].FDStatus](k,inf);
-                clientfd[fd].FDStatus++;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
-                            }
-                            //clientfd[fd].pendindQueue.pop();
-                            return;
-                        }
-            }
-            
-            clientfd[fd].pendindQueue.pop();
-            }
-        }
-     
-        TcpFDInf Tcpinf=clientfd[fd];
-        //检查是否有下一轮
-        if(Tcpinf.pendindQueue.size()>=1)//只有一个 说明没有任务没做完 直接执行
-            {
-                HttpRequestInformation &inff=std::any_cast<HttpRequestInformation&>(clientfd[fd].pendindQueue.front());
-                Tcpinf.FDStatus=-1;
-                int ret;
-                //获取key,自动解析到ctx的key键
-                ++Tcpinf.FDStatus;
-                ret=parseKey(k,inff);
-
-                if(ret==0)//慢处理
-                    return;
-                else if(ret<=-1)
-                {
-                    //清掉任务后返回
-                    Tcpinf.pendindQueue.pop();
-                    //-2要关闭连接
-                    if(ret==-2)
-                    {
-                        k.sendBack("","","404 NOT FOUND");
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
-                        }
-                    }
-                    else
-                    {
-                        k.sendBack("","","404 NOT FOUND");
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
-                        }
-                    }
-                    return;
-                }
-                
-                //遍历任务
-                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
-                if(ii==solveFun.end())//找不到
-                {
-                    if(globalSolveFun.size()==0)//连全局处理函数都没有 只能发404
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : 找不到处理函数也找不到全局处理函数 fd= "+to_string(fd)+"发送404 not found.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : can not find solve function and global function. fd= "+to_string(fd)+". has sent 404 not found.");
-                        }
-                        if(!k.sendBack("","","404 NOT FOUND"))
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 发送404 not found失败 fd= "+to_string(fd)+"已经关闭连接.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : sending 404 not found fail. fd= "+to_string(fd)+". has closed this connection.");
-                            }
-                            return;
-                        }
-                    }
-                    else
-                    {
-                    
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("http server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("http server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                        }
-                        for(auto &f:globalSolveFun)
-                        {
-                            int rett=f(k,inff);
-                            ++Tcpinf.FDStatus;
-                            if(rett==1)
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                                }
-                            }
-                            else if(rett==0)
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                                }
-                            
-                                return;
-                            }
-                            else if(rett==-1)
-                            {
-                            
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                                }
-                                //Tcpinf.pendindQueue.pop();
-                                return;
-                            }
-                            else
-                            {
-                                TcpServer::close(fd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                                }
-                                //Tcpinf.pendindQueue.pop();
-                                return;
-                            }
-                        }
-                    }
-                    clientfd[fd].pendindQueue.pop();
-                }
-                else//找得到处理函数
-                {
-                    for(auto &f:ii->second)
-                    {
-                        int rett=f(k,inff);
-                        ++Tcpinf.FDStatus;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else if(rett==-1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                        else
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                    }
-                    
-                }
-                Tcpinf.pendindQueue.pop();
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server : 处理fd= "+to_string(fd)+" 完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server : handled fd= "+to_string(fd)+" sucessfully");
-                    }
-                
-            }
-
-    }
-
-    void stt::network::WebSocketServer::handler_netevent(const int &fd)
-    {
-        
-        
-        if(clientfd[fd].fd!=-1)//can not find fd information,we need to writedown this error and close this fd
-        {
-            
-                
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server : 正在处理fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server : now handleing fd= "+to_string(fd));
-                }
-            TcpFDInf &Tcpinf=clientfd[fd];
-
-            //unique_lock<mutex> lock(lwb);
-            auto jj=wbclientfd.find(fd);
-            if(jj==wbclientfd.end())//没有进行wb握手
-            {
-                
-                HttpServerFDHandler k;
-                k.setFD(fd,clientfd[fd].ssl,unblock);
-                //k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                //unique_lock<mutex> lock(lwb);
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 正在进行websocket握手");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" handshaking websocket...");
-                }
-                WebSocketFDInformation winf;
-                winf.fd=fd;
-                winf.closeflag=false;
-                
-                //HttpRequestInformation HttpInf;
-                int ret=k.solveRequest(Tcpinf,winf.httpinf,buffer_size,1);
-                if(ret==-1)
-                {
-                    //k.close();
-
-                        TcpServer::close(fd);
-                        
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 无法解析http请求或者对端关闭连接 wb握手失败 已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" couldn't solve http request or host had closed this connection.fail to handshake websocket.have closed this connection");
-                        }
-                    //continue;
-                    return;
-                    //wb握手失败
-                }
-                else if(ret==0)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+"wait new data to continue solve this request");
-                    }
-                    //continue;
-                    return;
-                }
-                else if(ret==1)
-                {
-                    winf.locPara=winf.httpinf.locPara;
-                    winf.header=winf.httpinf.header;
-                    //cout<<winf.header<<endl;
-                    if(security_open)
-                    {
-                        int ret=connectionLimiter.allowRequest(clientfd[fd].ip,fd,winf.httpinf.loc,requestTimes,requestSecs);
-                        if(ret!=stt::security::ALLOW)
-                        {
-                            //securitySendBackFun(k,inff);
-                            if(ret==stt::security::CLOSE)
-                            {
-                                TcpServer::close(fd);
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"请求太频繁，已经关闭连接");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
-                                }
-                            }
-                            else
-                            {
-                                if(stt::system::ServerSetting::logfile!=nullptr)
-                                {
-                                    if(stt::system::ServerSetting::language=="Chinese")
-                                        stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"请求太频繁，已经忽略请求");
-                                    else
-                                        stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
-                                }
-                            }
-                            return;
-                        }
-                    }
-                    if(!fcc(winf))//条件不满足
-                    {
-                        //k.close();
-                        TcpServer::close(fd);
-                        
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 连接限制条件不满足 websocket握手失败 服务器已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" The connection constraints are not met.websocket handshake fail.server has closed this connection.");
-                        }
-                        //continue;
-                        return;
-                    }
-                    string_view key;
-                    string keyy;
-                    HttpStringUtil::get_value_header(winf.httpinf.header,key,"Sec-WebSocket-Key");
-                    keyy.assign(key);
-                    keyy+="258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-                    string result="";
-                    CryptoUtil::sha1(string(keyy),result);
-                    keyy=EncodingUtil::base64_encode(result);
-                    result=HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Accept",keyy);
-                    //清理接收缓冲区可能的数据遗漏
-                    //Tcpinf.data={};
-                    memset(Tcpinf.buffer,0,buffer_size);
-                    
-                    if(!k.sendBack("",result,"101 Switching Protocols"))
-                    {
-                        //k.close();
-                        TcpServer::close(fd);
-                    
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 握手响应无法发送 websocket握手失败 服务器已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" couldn't send handshake response .websocket handshake fail. server has closed this connection");
-                        }
-                        //continue;
-                        return;
-                        //握手失败
-                    }
-                    winf.response=::time(0);
-                    winf.HBTime=0;
-                    wbclientfd.emplace(fd,winf);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" websocket握手成功");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" websocket has handshaked sucessfully");
-                    }
-                    //thread(fccc,winf,ref(*this)).detach();
-                    WebSocketServerFDHandler kk;
-                    kk.setFD(fd,clientfd[fd].ssl,unblock);
-                    if(!fccc(kk,winf))
-                    {
-                        closeWithoutLock(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : fd= "+to_string(fd)+" 调用连接后的初始函数失败，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : fd= "+to_string(fd)+" fail to use start function,now has closed this connection");
-                        }
-                        return;
-                    }
-                    
-                }
-                //sleep(10);
-                //k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
-                //sleep(5);
-                //lock.unlock();
-            }
-            else
-            {
-                
-                //lock.unlock();
-                WebSocketServerFDHandler k;
-                
-            k.setFD(fd,clientfd[fd].ssl,unblock);
-            
-            int ret=1;
-            jj->second.fd=fd;
-            jj->second.connection_obj_fd=clientfd[fd].connection_obj_fd;
-            
-            ret=k.getMessage(Tcpinf,jj->second,buffer_size,1);
-            
-            if(ret==-1)
-            {
-                    closeWithoutLock(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : read data from fd= "+to_string(fd)+" fail,now has closed this connection");
-                    }
-                    return;
-            }
-            else if(ret==1)
-            {
-                    if(jj->second.closeflag==true)//收到关闭确认
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 收到关闭确认帧: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" has received closed confirm fin:"+ jj->second.message);
-                        }
-                        TcpServer::close(fd);
-                    }
-                    else//收到关闭
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 收到关闭帧: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" has received closed fin:"+ jj->second.message);
-                        }
-                        
-                        closeAck(fd,jj->second.message);
-                    }
-                    wbclientfd.erase(jj);
-                    return;
-            }
-            else if(ret==2)
-            {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 收到心跳确认: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" has received heartbeat confirm:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    jj->second.HBTime=0;
-
-                    //记录心跳确认
-
-                    jj->second.message="";
-                    return;
-            }
-            else if(ret==3)
-            {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 收到心跳: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" has received heartbeat:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    if(!sendMessage(jj->first,"心跳","1010"))//发送心跳失败直接关闭
-                    {
-                        wbclientfd.erase(jj);
-                        TcpServer::close(jj->first);
-                        return;
-                    }
-         
-                    //心跳
-                    else
-                        jj->second.message="";
-                    return;
-            }
-            else if(ret==4)
-            {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+"wait new data to continue solve this request");
-                    }
-                    return;
-            }
-            else if(ret==0)
-            {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" 收到常规信息: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer  : fd= "+to_string(fd)+" has received normal message:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    //if(!fc(jj->second.message,*this,jj->second))//回调函数失败
-                    //{
-                    //    close(fd);
-                    //    return;
-                    //}
-                    //jj->second.message="";
-                    //return;
-            }
-        
-            //lock.unlock();
-            
-            
-            //lock6.unlock();
-            //开始处理
-                //入队
-            Tcpinf.pendindQueue.push(move(jj->second));
-            
-            if(Tcpinf.pendindQueue.size()==1)//只有一个 说明没有任务没做完 直接执行
-            {
-               
-                WebSocketFDInformation &inff=std::any_cast<WebSocketFDInformation&>(clientfd[fd].pendindQueue.front());
-                Tcpinf.FDStatus=-1;
-                int ret;
-                //获取key,自动解析到ctx的key键
-                ++Tcpinf.FDStatus;
-                ret=parseKey(k,inff);
-                
-                if(ret==0)//慢处理
-                {
-                    return;
-                }
-                else if(ret<=-1)
-                {
-                    //清掉任务后返回
-                    //Tcpinf.pendindQueue.pop();
-                    //-2要关闭连接
-                    if(ret==-2)
-                    {
-                        closeFD(fd);
-                        //closeWithoutLock(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
-                        }
-                    }
-                    else
-                    {
-                        //k.sendBack("","","404 NOT FOUND");
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
-                        }
-                    }
-                    return;
-                }
-                if(security_open)
-                {
-                    int ret=connectionLimiter.allowRequest(clientfd[fd].ip,fd,std::any_cast<const std::string&>(inff.ctx["key"]),requestTimes,requestSecs);
-                    if(ret!=stt::security::ALLOW)
-                    {
-                        securitySendBackFun(k,inff);
-                        if(ret==stt::security::CLOSE)
-                        {
-                            TcpServer::close(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"请求太频繁，已经关闭连接");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
-                            }
-                        }
-                        else
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"请求太频繁，已经忽略请求");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
-                            }
-                        }
-                        return;
-                    }
-                }
-                //遍历任务
-                
-                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
-                
-                if(ii==solveFun.end())//找不到
-                {
-                    
-                    //k.sendBack("","","404 NOT FOUND");
-                    //close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                    }
-                    if(!globalSolveFun(k,inff))
-                    {
-                        closeFD(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
-                        }
-                    }
-                    Tcpinf.pendindQueue.pop();
-                }
-                else//找得到处理函数
-                {
-                    
-                    for(auto &f:ii->second)
-                    {
-                        int rett=f(k,inff);
-                        ++Tcpinf.FDStatus;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            
-                            return;
-                        }
-                        else if(rett==-1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                        else
-                        {
-                            closeFD(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                    }
-                    
-                    Tcpinf.pendindQueue.pop();
-                }
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" sucessfully");
-                    }
-                
-            }
-            
-            }
-        }
-    }
-    void stt::network::WebSocketServer::handler_workerevent(const int &fd,const int &ret)
-    {
-       
-        if(ret==-2)
-        {
-            closeFD(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : worker处理失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : worker solve fail fd= "+to_string(fd)+" ,now has closed this connection");
-                    }
-            return;
-        }
-        WebSocketServerFDHandler k;
-        k.setFD(fd,clientfd[fd].ssl,unblock);
-        
-        if(ret==-1)
-        {
-            clientfd[fd].pendindQueue.pop();
-            if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : worker处理失败 fd= "+to_string(fd)+" ，跳过本次请求");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : worker solve fail fd= "+to_string(fd)+" ,skip this request");
-                    }
-        }
-        else
-        {
-            if(clientfd[fd].pendindQueue.empty())
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
-                }
-                return;
-            }
-            WebSocketFDInformation &inf=std::any_cast<WebSocketFDInformation&>(clientfd[fd].pendindQueue.front());
-            if(inf.connection_obj_fd!=clientfd[fd].connection_obj_fd)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd));
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
-                }
-                return;
-            }
-            
-            auto ii=solveFun.find(std::any_cast<const std::string&>(inf.ctx["key"]));//对应的任务
-            if(stt::system::ServerSetting::logfile!=nullptr)
-            {
-                if(stt::system::ServerSetting::language=="Chinese")
-                    stt::system::ServerSetting::logfile->writeLog("websocket server : worker处理成功 fd= "+to_string(fd));
-                else
-                    stt::system::ServerSetting::logfile->writeLog("websocket server : worker solve sucessfully fd= "+to_string(fd));
-            }
-            if(ii==solveFun.end())//找不到
-                {
-                    
-                    //k.sendBack("","","404 NOT FOUND");
-                    //close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                    }
-                    if(!globalSolveFun(k,inf))
-                    {
-                        closeFD(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
-                        }
-                    }
-                    //clientfd[fd].pendindQueue.pop();
-                    clientfd[fd].pendindQueue.pop();
-                }
-            else
-            {
-            //继续做
-            
-            for(;clientfd[fd].FDStatus<ii->second.size();)
-            {
-                
-                int rett=ii->second[clientfd[fd].FDStatus](k,inf);
-                clientfd[fd].FDStatus++;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else
-                        {
-                            closeFD(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
-                            }
-                            //clientfd[fd].pendindQueue.pop();
-                            return;
-                        }
-            }
-            
-            clientfd[fd].pendindQueue.pop();
-            }
-        }
-     
-        TcpFDInf Tcpinf=clientfd[fd];
-        //检查是否有下一轮
-        if(Tcpinf.pendindQueue.size()>=1)//只有一个 说明没有任务没做完 直接执行
-            {
-                WebSocketFDInformation &inff=std::any_cast< WebSocketFDInformation&>(clientfd[fd].pendindQueue.front());
-                Tcpinf.FDStatus=-1;
-                int ret;
-                //获取key,自动解析到ctx的key键
-                ++Tcpinf.FDStatus;
-                ret=parseKey(k,inff);
-
-                if(ret==0)//慢处理
-                    return;
-                else if(ret<=-1)
-                {
-                    //清掉任务后返回
-                    Tcpinf.pendindQueue.pop();
-                    //-2要关闭连接
-                    if(ret==-2)
-                    {
-                        //k.sendBack("","","404 NOT FOUND");
-                        closeFD(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
-                        }
-                    }
-                    else
-                    {
-                        //k.sendBack("","","404 NOT FOUND");
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocketserver : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
-                        }
-                    }
-                    return;
-                }
-                
-                //遍历任务
-                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
-                if(ii==solveFun.end())//找不到
-                {
-                    //k.sendBack("","","404 NOT FOUND");
-                    //close(fd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
-                    }
-                    if(!globalSolveFun(k,inff))
-                    {
-                        closeFD(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
-                        }
-                    }
-                    Tcpinf.pendindQueue.pop();
-                }
-                else//找得到处理函数
-                {
-                    for(auto &f:ii->second)
-                    {
-                        int rett=f(k,inff);
-                        ++Tcpinf.FDStatus;
-                        if(rett==1)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
-                            }
-                        }
-                        else if(rett==0)
-                        {
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
-                            }
-                            return;
-                        }
-                        else if(rett==-1)
-                        {
-
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                        else
-                        {
-                            closeFD(fd);
-                            if(stt::system::ServerSetting::logfile!=nullptr)
-                            {
-                                if(stt::system::ServerSetting::language=="Chinese")
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。");
-                                else
-                                    stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
-                            }
-                            //Tcpinf.pendindQueue.pop();
-                            return;
-                        }
-                    }
-                    
-                }
-                Tcpinf.pendindQueue.pop();
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 处理fd= "+to_string(fd)+" 完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : handled fd= "+to_string(fd)+" sucessfully");
-                    }
-                
-            }
-
-
-    }
-    /*
-    void stt::network::HttpServer::consumer(const int &threadID)
-    {
-        HttpServerFDHandler k;
-        //TcpFDInf &Tcpinf;
-        
-
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" 打开");
-            else
-                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" has opened");
-        }
-
-        while(flag1)
-        {
-            unique_lock<mutex> ul1(lq1[threadID]);
-            while(fdQueue[threadID].empty()&&flag1)
-            {
-                cv[threadID].wait(ul1);
-            }
-            if(!flag1)
-            {
-                ul1.unlock();
-                break;
-            }
-            int cclientfd=fdQueue[threadID].front().fd;
-            bool cclose=fdQueue[threadID].front().close;
-            fdQueue[threadID].pop();
-            
-            ul1.unlock();
-
-            if(cclose)
-            {
-                TcpServer::close(cclientfd);
-                continue;
-            }
-           // endd=chrono::high_resolution_clock::now();
-            //            duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-           //             cout<<"队列中拿出用时"<<duration.count()<<endl;
-            //unique_lock<mutex> lock6(lc1);
-            //auto jj=clientfd.find(cclientfd.fd);
-            if(clientfd[cclientfd].fd==-1)//can not find fd information,we need to writedown this error and close this fd
-            {
-                continue;
-            }
-            else
-            {
-                
-                if(security_open)
-                {
-                    if(!connectionLimiter.allowRequest(clientfd[cclientfd].ip,HttpInf[cclientfd].loc))
-                    {
-                        TcpServer::close(cclientfd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+"请求太频繁，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+"request are too frequent,now has closed this connection");
-                        }
-                        continue;
-                    }
-                }
-                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                
-                //TcpFDInf &Tcpinf=clientfd[cclientfd.fd];
-                
-            //lock6.unlock();
-
-             if(stt::system::ServerSetting::logfile!=nullptr)
-             {
-                if(stt::system::ServerSetting::language=="Chinese")
-                    stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 开始处理fd= "+to_string(cclientfd));
-                else
-                    stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : now start solveing fd= "+to_string(cclientfd));
-             }
-            
-            
-            //endd=chrono::high_resolution_clock::now();
-            //            duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-            //            cout<<"开始处理用时"<<duration.count()<<endl;
-             int ret=1;
-             int ii=1;
-             k.setFD(cclientfd,clientfd[cclientfd].ssl,unblock);
-            //cout<<"fd="<<cclientfd<<endl;
-            while(ret==1)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" 正在解析请求... 第"+to_string(ii)+"次处理");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" now solveing request... it is the "+to_string(ii)+" times");
-                }
-            ret=k.solveRequest(clientfd[cclientfd],HttpInf[cclientfd],buffer_size,ii);
-            if(ret==-1)
-            {
-                    TcpServer::close(cclientfd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" 解析请求失败或者是对方已经关闭连接，服务器已经关闭这个连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" solved request fail or host had closed connection.now server has closed this connection");
-                    }
-            }
-
-            else if(ret==1)
-            {
-                
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                    {
-                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" 正在处理请求... \n*******请求信息：*********\nheader= "+string(HttpInf[cclientfd].header)+"\nbody="+string(HttpInf[cclientfd].body)+"\nbody_chunked="+string(HttpInf[cclientfd].body_chunked)+"\n*************************");
-                    }
-                    else
-                    {
-                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" now handleing request...\n*******request information：*********\nheader= "+string(HttpInf[cclientfd].header)+"\nbody="+string(HttpInf[cclientfd].body)+"\nbody_chunked="+string(HttpInf[cclientfd].body_chunked)+"\n*************************");
-                    }
-
-                }
-                //endd=chrono::high_resolution_clock::now();
-                //        duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-                //        cout<<"开始调用fc用时"<<duration.count()<<endl;
-                if(!fc(HttpInf[cclientfd],k))
-                {
-                
-                    TcpServer::close(cclientfd);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 处理fd= "+to_string(cclientfd)+"失败或者是对方已经关闭连接，已经关闭连接");
-                        else
-                           stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : handle fd= "+to_string(cclientfd)+"fail or host had closed connection.now server has closed this connection");
-                    }
-                    break;
-                }
-                else
-                {
-                    //endd=chrono::high_resolution_clock::now();
-                    //    duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-                    //    cout<<"fc完成用时"<<duration.count()<<endl;
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 处理fd= "+to_string(cclientfd)+"完成");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : has solved fd= "+to_string(cclientfd)+"sucessfully");
-                    }
-                    break;
-                }
-            }
-            else if(ret==0)
-            {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 解析fd= "+to_string(cclientfd)+"未完成 等待新的数据继续解析");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+"wait new data to continue solve this request");
-                    }
-            }
-            ++ii;
-            //k.solveRequest(clientfd[cclientfd],HttpInf[cclientfd],buffer_size,ii);
-            }
-            //endd=chrono::high_resolution_clock::now();
-            //            duration=chrono::duration_cast<chrono::microseconds>(endd-start);
-            //            cout<<"全部处理完用时"<<duration.count()<<endl;
-            //            op+=duration.count();
-             //           times++;
-            //            cout<<"times="<<times<<"op="<<op<<endl;
-
-            }
-        }
-        //跳出循环意味着结束线程
-        unique_lock<mutex> lock3(lco1);
-        consumerNum--;
-        cout<<"consumer "<<consumerNum<<" quit"<<endl;
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(consumerNum)+"退出");
-            else
-                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(consumerNum)+"quit");
-        }
-    }
-    */
-    
-    bool stt::network::EpollSingle::endListen()
-    {
-        flag1=false;
-        while(flag2);
-        return true;
-    }
-    void stt::network::EpollSingle::epolll()
-    {
-        int epollFD=epoll_create(1);
-        epoll_event ev;
-        ev.data.fd=fd;
-        if(flag==false)
-            ev.events=EPOLLIN|EPOLLET;
-        else
-            ev.events=EPOLLIN;
-        epoll_ctl(epollFD,EPOLL_CTL_ADD,fd,&ev);
-        epoll_event evs;
-
-        DateTime timer1;
-        Duration dt;
-        DateTime timer2;
-        Duration t;
-        while(flag1)
-        {
-            if(!timer1.isStart())
-                timer1.startTiming();
-            int infds=epoll_wait(epollFD,&evs,1,1000);
-            if(infds<0)
-                continue;
-            else if(infds==0)
-            {
-                if(!flag3)
-                {
-                    dt=timer1.checkTime();
-                    if(dt>=this->dt)
-                    {
-                        if(!fcTimeOut(fd))
-                            break;
-                    }
-                }
-                else
-                {
-                    if(!timer2.startTiming())//说明已经不是第一次，而是在计时中了
-                    {
-                        t=timer2.checkTime();
-                        if(t>=this->t)
-                            break;
-                    }
-                }
-            }
-            else//有事件发生了
-            {
-                if(flag3)//打开了退出倒计时
-                {
-                    flag3=false;
-                    timer2.endTiming();
-                }
-                timer1.endTiming();
-                if(!fc(fd))
-                    break;
-            }
-        }
-        //只要跳出了这个循环就意味着要退出了
-        //cout<<"epoll quit"<<endl;
-        fcEnd(fd);
-        dt=Duration{0,20,0,0,0};
-        flag1=true;
-        flag3=false;
-        flag2=false;
-    }
-    void stt::network::EpollSingle::startListen(const int &fd,const bool &flag,const Duration &dt)
-    {
-        if(isListen())
-        {
-            endListen();
-        }
-        this->fd=fd;
-        this->flag=flag;
-        this->dt=dt;
-        thread(&EpollSingle::epolll,this).detach();
-        flag2=true;
-    }
-    
-    /*
-    void Epoll::startListen(const int &fd,const condition_variable &cv1,const bool &flag,const int &evsNum)
-    {
-        if(isListen())
-        {
-            endListen();
-        }
-        this->fd=fd;
-        this->flag=flag;
-        this->cv1=cv1;
-        this->evsNum=evsNum;
-        thread(&EpollSingle::epolll,this).detach();
-    }
-    void Epoll::epolll()
-    {
-        int epollFD=epoll_create(1);
-        epoll_event ev;
-        ev.data.fd=fd;
-        if(flag==false)
-            ev.events=EPOLLIN|EPOLLET;
-        else
-            ev.events=EPOLLIN;
-        epoll_ctl(epollFD,EPOLL_CTL_ADD,fd,&ev);
-        epoll_event evs[evsNum];
-    }
-    */
-    
-    void stt::network::WebSocketClient::close(const short &code,const string &message,const bool &wait)
-    {
-        if(!isConnect())//没有连接 何来关闭
-            return;
-        char ccode[2];
-        memcpy(ccode,&code,2);
-        string codee(ccode,2);
-        codee+=message;
-        if(!sendMessage(codee,"1000"))//如果发送失败 说明连接可能断了或者有其他错误 自行终止本方连接就ok了,否则等待epoll那边收到关闭帧再关闭
-        {
-            if(wait)
-                k.endListenWithSignal();//发送停止信号
-        }
-        if(wait)
-        {
-            k.waitAndQuit();
-            while(k.isListen());//wb的标志位会比epoll的标志位先确定，epoll是最后才改变的标志位，所以监听最后的epoll标志位更安全
-        }
-        flag5=true;//为了省事，一概设置flag5为true，如果是主动的那就设置了，后面能用；被动的后面也不需要在检查这个了。
-    }
-    void stt::network::WebSocketClient::close(const string &closeCodeAndMessage,const bool &wait)
-    {
-        if(!isConnect())//没有连接 何来关闭
-            return;
-        if(!sendMessage(closeCodeAndMessage,"1000"))//如果发送失败 说明连接可能断了或者有其他错误 自行终止本方连接就ok了,否则等待epoll那边收到关闭帧再关闭
-        {
-            if(wait)
-                k.endListenWithSignal();//发送停止信号
-        }
-        if(wait)
-        {
-            k.waitAndQuit();
-            while(k.isListen());
-        }
-        flag5=true;//为了省事，一概设置flag5为true，如果是主动的那就设置了，后面能用；被动的后面也不需要在检查这个了。
-    }
-    bool stt::network::WebSocketClient::close1()
-    {
-        flag4=false;
-        flag5=false;
-        if(!TcpClient::close())
-        {
-            cerr<<"wb无法关闭前一个连接(tcp连接已经关闭但是没办法创建新的套接字，这个对象需要弃用)"<<endl;
-            return false;
-        }
-        return true;
-    }
-    stt::network::WebSocketClient::~WebSocketClient()
-    {
-        close(1000,"bye");
-    }
-    bool stt::network::WebSocketClient::connect(const string &url,const int &min)
-    {
-        //解析url
-        //建立tcp连接
-        string ip;
-        int port;
-        string locPara;
-        HttpStringUtil::getIP(url,ip);
-        HttpStringUtil::getPort(url,port);
-        HttpStringUtil::getLocPara(url,locPara);
-        if(!TcpClient::isConnect()||TcpClient::getServerIP()!=ip||TcpClient::getServerPort()!=port)//没有连接或者服务器变更需要重新连接
-        {
-            if(TcpClient::isConnect())//如果是变更服务器 需要先关闭原有的连接
-            {
-                if(!TcpClient::close())
-                {
-                    cerr<<"wb无法关闭前一个连接"<<endl;
-                    return false;
-                }
-            }
-            if(!TcpClient::connect(ip,port))//重新连接或者第一次连接
-            {
-                cerr<<"wb无法连接到服务器"<<endl;
-                return false;
-            }
-        }
-        //进行websocket握手
-        string httpURL=url;
-        auto pos=httpURL.find("ws");
-        httpURL.replace(pos,2,"http");
-        string wbKey;
-        RandomUtil::getRandomStr_base64(wbKey,24);
-        HttpClient k;
-        if(!k.getRequestFromFD(TcpFDHandler::getFD(),TcpFDHandler::ssl,httpURL,HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Key",wbKey),"Sec-WebSocket-Version: 13"))
-            return false;
-        if(!k.isReturn())
-            return false;
-        if(k.header.find("HTTP/1.1 101")==string::npos)
-            return false;
-        //连接完毕
-        this->url=url;
-        flag4=true;
-        flag5=false;
-        if(this->k.isListen())
-            this->k.endListen();
-        //监听,用水平触发的逻辑
-        auto ffc=[this](const int &fd)->bool
-        {
-            TcpFDHandler k;
-            k.setFD(fd,this->ssl);
-            string totalResult="";
-            char b1;
-            char b2;
-            string code;
-            bool isRec;
-            do
-            {
-                isRec=true;
-                if(k.recvDataByLength(&b1,1)<=0)
-                {   
-                    //if(!this->close(1002,"",false))
-                    //{
-                    //    cout<<"false"<<endl;
-                        return false;
-                    //}
-                }
-                if(k.recvDataByLength(&b2,1)<=0)
-                {   
-                    //if(!this->close(1002,"",false))
-                    //{
-                        return false;
-                    //}
-                }
-                
-                
-                unsigned long sizee;//payload len
-                string ssize;
-                BitUtil::bitOutput(b2,ssize);
-                ssize=ssize.substr(1);
-                BitUtil::bitStrToNumber(ssize,sizee);//单字节里的是大端序 
-                if(sizee==126)
-                {
-                    char s[2];
-                    if(k.recvDataByLength(s,2)<=0)
-                    {   
-                        //if(!this->close(1002,"",false))
-                        //{
-                            return false;
-                        //}
-                    }
-                    sizee=BitUtil::bitToNumber(string(s,2),sizee);
-                }
-                else if(sizee==127)
-                {
-                    char s[8];
-                    if(k.recvDataByLength(s,8)<=0)
-                    {   
-                        //if(!this->close(1002,"",false))
-                        //{
-                            return false;
-                        //}
-                    }
-                    sizee=BitUtil::bitToNumber(string(s,8),sizee);
-                }
-                if(sizee==0)//长度为0只可能是控制帧，但控制帧最大长度125，不允许分片
-                    isRec=false;
-                //接收正文
-                string result;
-                if(isRec)
-                {
-                    if(k.recvDataByLength(result,sizee)<=0)
-                    {
-                        //if(!this->close(1002,"",false))
-                        //{
-                            return false;
-                        //}
-                    }
-                    totalResult+=result;
-                }
-                //检查收到的讯息
-                
-                BitUtil::bitOutput(b1,code);
-                code=code.substr(4);
-                //cout<<"finish+"<<code<<endl;
-                if(code=="1000")
-                {
-                    //cout<<"收到对端关闭帧";
-                    if(this->flag5)//说明是关闭确认帧
-                    {
-                        return false;
-                    }
-                    else//需要发送关闭确认帧
-                    {
-                        //if(!this->close(totalResult,false))
-                        //{
-                        //    return false;
-                        //}
-                        //isRec=false;
-                        this->close(totalResult,false);
-                        return false;
-                    }
-                }
-                else if(code=="1001")
-                {
-                    //cout<<"收到对端心跳:"<<totalResult<<endl;
-                    this->sendMessage(totalResult,"1010");
-                    isRec=false;
-                }
-                else if(code=="1010")
-                {
-                    //cout<<"收到对端心跳响应"<<endl;
-                    isRec=false;
-                }
-                BitUtil::bitOutput_bit(b1,1,b1);
-            }while(BitUtil::bitOutput(b1,code).substr(0,1)=="0"&&BitUtil::bitOutput(b1,code).substr(4)=="0000"&&isRec);  
-
-            //用回调函数处理
-            if(isRec)
-                return this->fc(totalResult,*this);//处理失败epoll会退出
-            return true;
-        };
-        auto endfc=[this](const int &fd)->void
-        {
-            this->close1();
-        };
-        auto timeoutfc=[this](const int &fd)->bool
-        {
-            if(!this->sendMessage("心跳","1001"))
-                return false;
-            this->k.waitAndQuit();
-            return true;
-        };
-        this->k.setFunction(ffc);
-        this->k.setEndFunction(endfc);
-        this->k.setTimeOutFunction(timeoutfc);
-        this->k.startListen(TcpFDHandler::getFD(),true,Duration{0,0,min,0,0});
-        return this->k.isListen();
-    }
-    bool stt::network::WebSocketClient::sendMessage(const string &message,const string &type)
-    {
-        if(!isConnect())
-        {
-            cerr<<"websocket对象没有连接,发送失败"<<endl;
-            return false;
-        }
-        string typee="1000"+type;
-        string mess=message;
-        unsigned long size=message.length();//生成extern payload len前的东西,默认一片长度为8的数据帧发完数据
-
-        if(size<=125)
-        {
-            //cout<<"send1+size="<<size<<"+::"<<message<<endl;
-            string header;
-            BitUtil::toBit(typee,header);
-
-            char cc;
-            memcpy(&cc,&size,1);
-            cc=cc|'z'+6;
-        
-            //设置mask
-            string mask;
-            EncodingUtil::generateMask_4(mask);
-        
-            //mask处理数据
-            EncodingUtil::maskCalculate(mess,mask);
-            //拼接数据帧
-            mess=header+cc+mask+mess;
-        }
-        else if(size<=65535)
-        {
-            //cout<<"send2+size="<<size<<"+::"<<message<<endl;
-            unsigned short tt=(unsigned short)size;
-            tt=htons(tt);
-            string header;
-            BitUtil::toBit(typee+"11111110",header);
-            char ss[2];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
-            memcpy(ss,&tt,2);
-            //设置mask
-            string mask;
-            EncodingUtil::generateMask_4(mask);
-            EncodingUtil::maskCalculate(mess,mask);
-            //拼接数据帧
-            mess=header+string(ss,2)+mask+mess;
-        }
-        else
-        {
-            //cout<<"send3+size="<<size<<"+::"<<message<<endl;
-            NetworkOrderUtil::htonl_ntohl_64(size);
-            string header;
-            BitUtil::toBit(typee+"11111111",header);
-            char ss[8];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
-            memcpy(ss,&size,sizeof(size));
-            //设置mask
-            string mask;
-            EncodingUtil::generateMask_4(mask);
-            //mask处理数据
-            EncodingUtil::maskCalculate(mess,mask);
-            //拼接数据帧
-            mess=header+string(ss,8)+mask+mess;
-        }
-    
-
-        //发送数据帧
-        if(sendData(mess)!=mess.length())
-        {
-            cout<<"send failed"<<endl;
-            return false;
-        }
-        return true;
-    }
-    
-    int stt::network::WebSocketServerFDHandler::getMessage(TcpFDInf &Tcpinf,WebSocketFDInformation &Websocketinf,const unsigned long &buffer_size,const int &ii)
-    {
-        /*
-            string recv="";
-            int ret=1;
-            while(ret>0)
-            {
-                Tcpinf.data+=recv;
-                recv.clear();
-                ret=recvData(recv,8192);
-            }
-            if(ret<=0&&ret!=-100)
-                return -1;
-            
-            */
-
-         //   if(ii==1)
-        //{
-
-            int ret=1;
-            unsigned long long p_buffer_now_backup=Tcpinf.p_buffer_now;
-            
-            
-            while(ret>0&&buffer_size-Tcpinf.p_buffer_now>0)
-            {
-                ret=recvData(Tcpinf.buffer+Tcpinf.p_buffer_now,buffer_size-Tcpinf.p_buffer_now);
-                if(ret>0)
-                    Tcpinf.p_buffer_now+=ret;
-                
-            }
-            if(buffer_size-Tcpinf.p_buffer_now<=0)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : 缓冲区容量不足 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server : buffer size is not enough,read data from fd= "+to_string(fd)+" fail,now has closed this connection");
-                    }
-                return -1;
-            }
-            if(ret<=0)
-            {
-                if(ret!=-100)
-                    return -1;
-            }
-        //}
-        
-        
-        Tcpinf.data=string_view(Tcpinf.buffer+p_buffer_now_backup,Tcpinf.p_buffer_now);
-        
-        //cout<<Tcpinf.data<<endl;
-            //数据接收完，开始处理
-            
-            while(1)
-            {
-                //第一个字节
-                if(Tcpinf.status==0||Tcpinf.status==1)
-                {
-                    Websocketinf.recv_length=0;
-                    Websocketinf.have_recv_length=0;
-
-                    if(Tcpinf.status==0)
-                        Tcpinf.status=1;
-                    if(Tcpinf.data.length()<1)
-                        return 4;
-                    char b1=Tcpinf.data[0];
-                    string code;
-                    BitUtil::bitOutput(b1,code);
-                    if(code.substr(0,1)=="1")
-                    {
-                        
-                        Websocketinf.fin=true;
-                    }
-                    else
-                    {
-                        
-                        Websocketinf.fin=false;
-                    }
-                    code=code.substr(4);
-
-                    if(code=="1000")
-                    {
-                        Websocketinf.message_type=1;
-                    }
-                    else if(code=="1001")
-                    {
-                        Websocketinf.message_type=3;
-                    }
-                    else if(code=="1010")
-                    {
-                        Websocketinf.message_type=2;
-                    }
-                    else
-                       Websocketinf.message_type=0;
-
-                    ++Websocketinf.have_recv_length;
-                    Tcpinf.status=2;
-                    if(Tcpinf.data.length()>1)
-                        Tcpinf.data=Tcpinf.data.substr(1);
-                    else
-                    {
-                        //Tcpinf.data={};
-                        return 4;
-                    }
-                    Websocketinf.recv_length=1;
-                    
-                }
-                //长度
-                if(Tcpinf.status==2)
-                {
-                    
-                    unsigned long sizee;//payload len
-                    if(Websocketinf.recv_length==1)
-                    {
-                        if(Tcpinf.data.length()<1)
-                            return 4;
-                        char b2=Tcpinf.data[0];
-                        ++Websocketinf.have_recv_length;
-                        string ssize;
-                        BitUtil::bitOutput(b2,ssize);
-                        ssize=ssize.substr(1);
-                        BitUtil::bitStrToNumber(ssize,sizee);//单字节里的是大端序 
-                        if(sizee==126)
-                            Websocketinf.recv_length=2;
-                        else if(sizee==127)
-                            Websocketinf.recv_length=8;
-                        else
-                        {
-                            Tcpinf.status=3;
-                            Websocketinf.recv_length=sizee;
-                            if(Tcpinf.data.length()<=1)
-                            {
-                                //Tcpinf.data={};
-                                return 4;
-                            }
-                            else
-                                Tcpinf.data=Tcpinf.data.substr(1);
-                        }
-                    }
-                    if(Websocketinf.recv_length==2&&Tcpinf.status==2)
-                    {
-                    
-                        if(Tcpinf.data.length()<=1)
-                        {
-                           // Tcpinf.data={};
-                            return 4;
-                        }
-                        Tcpinf.data=Tcpinf.data.substr(1);
-                        sizee=BitUtil::bitToNumber(string(Tcpinf.data.substr(0,2)),sizee);
-                        Tcpinf.status=3;
-                        Websocketinf.recv_length=sizee;
-                        if(Tcpinf.data.length()<=2)
-                        {
-                            //Tcpinf.data={};
-                            return 4;
-                        }
-                        else
-                            Tcpinf.data=Tcpinf.data.substr(2);
-                        Websocketinf.have_recv_length=Websocketinf.have_recv_length+2;
-                    }
-                    else if(Websocketinf.recv_length==8&&Tcpinf.status==2)
-                    {
-                        
-                        if(Tcpinf.data.length()<=1)
-                        {
-                            //Tcpinf.data={};
-                            return 4;
-                        }
-                        Tcpinf.data=Tcpinf.data.substr(1);
-                        sizee=BitUtil::bitToNumber(string(Tcpinf.data.substr(0,8)),sizee);
-                        Tcpinf.status=3;
-                        Websocketinf.recv_length=sizee;
-                        if(Tcpinf.data.length()<=8)
-                        {
-                            //Tcpinf.data={};
-                            return 4;
-                        }
-                        else
-                            Tcpinf.data=Tcpinf.data.substr(8);
-                        Websocketinf.have_recv_length=Websocketinf.have_recv_length+8;
-                    }
-                    
-                    
-                }
-
-                //接收mask
-                if(Tcpinf.status==3)
-                {
-                    
-                    if(Tcpinf.data.length()<4)
-                        return 4;
-                    Websocketinf.mask=Tcpinf.data.substr(0,4);
-
-                    Tcpinf.status=4;
-
-                    if(Tcpinf.data.length()<5)
-                    {
-                        if(Websocketinf.recv_length!=0)
-                        {
-                            //Tcpinf.data={};
-                            return 4;
-                        }
-                    }
-                    Tcpinf.data=Tcpinf.data.substr(4);
-                    Websocketinf.have_recv_length=Websocketinf.have_recv_length+4;
-                }
-
-                //接收数据
-                if(Tcpinf.status==4)
-                {
-                    if(Websocketinf.recv_length!=0)
-                    {
-                    if(Tcpinf.data.length()<1)
-                        return 4;
-
-                    string a;
-                    if(Tcpinf.data.length()<=Websocketinf.recv_length)
-                    {
-                        a=Tcpinf.data;
-                        Websocketinf.recv_length=Websocketinf.recv_length-Tcpinf.data.length();
-                        //Tcpinf.data={};
-                    }
-                    else
-                    {
-                        a=Tcpinf.data.substr(0,Websocketinf.recv_length);
-                        Tcpinf.data=Tcpinf.data.substr(Websocketinf.recv_length);
-                        Websocketinf.have_recv_length=Websocketinf.have_recv_length+Websocketinf.recv_length;
-                        //搬内存
-                        memcpy(Tcpinf.buffer,Tcpinf.buffer+Websocketinf.have_recv_length,Websocketinf.have_recv_length);
-                        Tcpinf.p_buffer_now=Tcpinf.p_buffer_now-Websocketinf.have_recv_length;
-                        Websocketinf.recv_length=0;
-                        Websocketinf.have_recv_length=0;
-                    }
-                    EncodingUtil::maskCalculate(a,Websocketinf.mask);
-                    Websocketinf.message+=a;
-                    //cout<<Websocketinf.message<<endl;
-                    if(Websocketinf.recv_length!=0)
-                        return 4;
-                    }
-                    //cout<<Websocketinf.message<<endl;
-
-                    Tcpinf.status=0;
-                    if(Websocketinf.message_type==1)
-                    {
-                        //cout<<"收到对端关闭帧";
-
-                        return 1;
-                    }
-                    else if(Websocketinf.message_type==2)
-                    {
-                        //cout<<"收到对端心跳响应"<<endl;
-                        return 2;
-                    }
-                    else if(Websocketinf.message_type==3)
-                    {
-                        //cout<<"收到对端心跳:"<<Websocketinf.message<<endl;
-                        sendMessage(Websocketinf.message,"1010");
-                        return 3;
-                    }
-                    else
-                    {
-                        if(Websocketinf.fin)                         
-                            break;   
-                    }
-                    
-                    
-                }
-            }
- 
-             return Websocketinf.message_type;
-    }
-    bool stt::network::WebSocketServerFDHandler::sendMessage(const string &msg,const string &type)
-    {
-        string typee="1000"+type;
-        string mess=msg;
-        unsigned long size=msg.length();//生成extern payload len前的东西,默认一片长度为8的数据帧发完数据
-
-        if(size<=125)
-        {
-            string header;
-            BitUtil::toBit(typee,header);
-
-            char cc;
-            memcpy(&cc,&size,1);
-            cc=cc&'z'+5;
-        
-        
-            //拼接数据帧
-            mess=header+cc+mess;
-        }
-        else if(size<=65535)
-        {
-            unsigned short tt=(unsigned short)size;
-            tt=htons(tt);
-            string header;
-            BitUtil::toBit(typee+"01111110",header);
-            char ss[2];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
-            memcpy(ss,&tt,2);
-        
-            //拼接数据帧
-            mess=header+string(ss,2)+mess;
-        }
-        else
-        {
-            NetworkOrderUtil::htonl_ntohl_64(size);
-            string header;
-            BitUtil::toBit(typee+"01111111",header);
-            char ss[8];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
-            memcpy(ss,&size,sizeof(size));
-            //拼接数据帧
-            mess=header+string(ss,8)+mess;
-        }
-        //发送数据帧
-        if(sendData(mess,false)!=mess.length())
-            return false;
-        return true;
-    }
-    /*
-    void WebSocketServerFDHandler::closeAck(const string &closeCodeAndMessage)
-    {
-        sendMessage(closeCodeAndMessage,"1000");
-        TcpFDHandler::close();
-    }
-    void WebSocketServerFDHandler::closeAck(const short &code,const string &message)
-    {
-        char ccode[2];
-        memcpy(ccode,&code,2);
-        string codee(ccode,2);
-        codee+=message;
-        sendMessage(codee,"1000");
-        TcpFDHandler::close();
-    }
-    */
-    void stt::network::WebSocketServer::closeAck(const int &fd,const string &closeCodeAndMessage)
-    {
-        sendMessage(fd,closeCodeAndMessage,"1000");
-        TcpServer::close(fd);
-    }
-    void stt::network::WebSocketServer::closeAck(const int &fd,const short &code,const string &message)
-    {
-        char ccode[2];
-        memcpy(ccode,&code,2);
-        string codee(ccode,2);
-        codee+=message;
-        sendMessage(fd,codee,"1000");
-        TcpServer::close(fd);
-    }
-    bool stt::network::WebSocketServer::closeFD(const int &fd,const string &closeCodeAndMessage)
-    {
-       
-        //unique_lock<mutex> lock(lwb);
-        auto ii=wbclientfd.find(fd);
-
-        if(ii==wbclientfd.end()||ii->second.closeflag==true)
-        {
-            
-            return false;
-        }
-        else
-        {
-            
-            //lock.unlock();
-            WebSocketServerFDHandler k;
-            k.setFD(fd,getSSL(fd),unblock);
-            if(!k.sendMessage(closeCodeAndMessage,"1000"))
-            {
-                
-                
-                    //lock.lock();
-                    auto ii=wbclientfd.find(fd);
-                    if(ii!=wbclientfd.end())
-                    {
-                        TcpServer::close(fd);
-                        wbclientfd.erase(ii);
-                    }
-                    //lock.unlock();
-                
-                
-                return true;
-            }
-            ii->second.closeflag=true;
-            return true;
-        }
-    }
-    
-    bool stt::network::WebSocketServer::closeFD(const int &fd,const short &code,const string &message)
-    {
-        
-        //unique_lock<mutex> lock(lwb);
-        auto ii=wbclientfd.find(fd);
-        
-        if(ii==wbclientfd.end()||ii->second.closeflag==true)//找不到或者已经发送过了
-        {
-            
-            return false;
-        }
-        else
-        {
-            
-            //lock.unlock();
-            char ccode[2];
-            memcpy(ccode,&code,2);
-            string codee(ccode,2);
-            codee+=message;
-            WebSocketServerFDHandler k;
-            k.setFD(fd,getSSL(fd),unblock);
-            if(!k.sendMessage(codee,"1000"))//发送失败会自动删除在记录表里的
-            {
-                
-                    //lock.lock();
-                    auto ii=wbclientfd.find(fd);
-                    if(ii!=wbclientfd.end())
-                    {
-                        TcpServer::close(fd);
-                        wbclientfd.erase(ii);
-                    }
-                    //lock.unlock();
-                
-                return true;
-            }
-            ii->second.closeflag=true;
-            return true;
-        }
-    }
-    
-    bool stt::network::WebSocketServer::close(const int &fd)
-    {
-
-                    //unique_lock<mutex> lock(lwb);
-                    auto ii=wbclientfd.find(fd);
-                    if(ii!=wbclientfd.end())
-                    {
-                        TcpServer::close(fd);
-                        wbclientfd.erase(ii);
-                    }
-                    
-                
-                return true;
-            
-    }
-    bool stt::network::WebSocketServer::closeWithoutLock(const int &fd,const string &closeCodeAndMessage)
-    {
-        auto ii=wbclientfd.find(fd);
-        if(ii==wbclientfd.end()||ii->second.closeflag==true)
-        {
-            return false;
-        }
-        else
-        {
-            WebSocketServerFDHandler k;
-            k.setFD(fd,getSSL(fd),unblock);
-            if(!k.sendMessage(closeCodeAndMessage,"1000"))
-            {
-                TcpServer::close(fd);
-                wbclientfd.erase(ii);
-                return false;
-            }
-            ii->second.closeflag=true;
-            return true;
-        }
-    }
-    bool stt::network::WebSocketServer::closeWithoutLock(const int &fd,const short &code,const string &message)
-    {
-        auto ii=wbclientfd.find(fd);
-        if(ii==wbclientfd.end()||ii->second.closeflag==true)//找不到或者已经发送过了
-        {
-            return false;
-        }
-        else
-        {
-            char ccode[2];
-            memcpy(ccode,&code,2);
-            string codee(ccode,2);
-            codee+=message;
-            WebSocketServerFDHandler k;
-            k.setFD(fd,getSSL(fd),unblock);
-            if(!k.sendMessage(codee,"1000"))//发送失败会自动删除在记录表里的
-            {
-                TcpServer::close(fd);
-                wbclientfd.erase(ii);
-                return false;
-            }
-            ii->second.closeflag=true;
-            return true;
-        }
-    }
-    /*
-    void stt::network::WebSocketServer::handler(const int &fd)
-    {
-        HttpServerFDHandler k;
-        WebSocketServerFDHandler k1;
-            if(clientfd[fd].fd!=-1)
-            {
-                if(security_open)
-                {
-                    if(!connectionLimiter.allowRequest(clientfd[fd].ip))
-                    {
-                        TcpServer::close(fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer : fd= "+to_string(fd)+"请求太频繁，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer : fd= "+to_string(fd)+"request are too frequent,now has closed this connection");
-                        }
-                      
-                    }
-                }
-                
-                TcpFDInf &Tcpinf=clientfd[fd];
-
-            cout<<"websocket fd="<<fd<<endl;
-            if(stt::system::ServerSetting::logfile!=nullptr)
-             {
-                if(stt::system::ServerSetting::language=="Chinese")
-                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer : 正在处理fd= "+to_string(fd));
-                else
-                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer : now solveing fd= "+to_string(fd));
-             }
-            //拿到fd之后开始操作
-            unique_lock<mutex> lock(lwb);
-            auto jj=wbclientfd.find(fd);
-            if(jj==wbclientfd.end())//没有进行wb握手
-            {
-                k.setFD(fd,clientfd[fd].ssl,unblock);
-
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 正在进行websocket握手");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" handshaking websocket...");
-                }
-                WebSocketFDInformation winf;
-                winf.fd=fd;
-                winf.closeflag=false;
-                
-                HttpRequestInformation HttpInf;
-                int ret=k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
-                if(ret==-1)
-                {
-                    //k.close();
-
-                        TcpServer::close(fd);
-                        cout<<"无法解析http请求 wb握手失败"<<endl;
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 无法解析http请求或者对端关闭连接 wb握手失败 已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" couldn't solve http request or host had closed this connection.fail to handshake websocket.have closed this connection");
-                        }
-                   
-                    //wb握手失败
-                }
-                else if(ret==0)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+"wait new data to continue solve this request");
-                    }
-                 
-                }
-                else if(ret==1)
-                {
-                    winf.locPara=HttpInf.locPara;
-                    winf.header=HttpInf.header;
-                    //cout<<winf.header<<endl;
-                    if(!fcc(winf))//条件不满足
-                    {
-                        //k.close();
-                        TcpServer::close(fd);
-                        cout<<"连接限制条件不满足 wb握手失败"<<endl;
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 连接限制条件不满足 websocket握手失败 服务器已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" The connection constraints are not met.websocket handshake fail.server has closed this connection.");
-                        }
-                    
-                    }
-                    string_view key;
-                    string keyy;
-                    HttpStringUtil::get_value_header(HttpInf.header,key,"Sec-WebSocket-Key");
-                    keyy.assign(key);
-                    keyy+="258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-                    string result="";
-                    CryptoUtil::sha1(string(keyy),result);
-                    keyy=EncodingUtil::base64_encode(result);
-                    result=HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Accept",keyy);
-                    //清理接收缓冲区可能的数据遗漏
-                    //Tcpinf.data={};
-                    
-                    if(!k.sendBack("",result,"101 Switching Protocols"))
-                    {
-                        //k.close();
-                        TcpServer::close(fd);
-                        cout<<"握手响应无法发送 wb握手失败"<<endl;
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 握手响应无法发送 websocket握手失败 服务器已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" couldn't send handshake response .websocket handshake fail. server has closed this connection");
-                        }
-                   
-                        //握手失败
-                    }
-                    winf.response=::time(0);
-                    winf.HBTime=0;
-                    wbclientfd.emplace(fd,winf);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" websocket握手成功");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" websocket has handshaked sucessfully");
-                    }
-                    thread(fccc,winf,ref(*this)).detach();
-                }
-                //sleep(10);
-                //k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
-                //sleep(5);
-
-            }
-            else//已经进行了握手操作
-            {
-                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                k1.setFD(fd,clientfd[fd].ssl,unblock);
-            int r=1;
-            
-            
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 正在解析请求... ");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" now solveing request... ");
-                }
-                r=k1.getMessage(Tcpinf,jj->second,buffer_size,1);
-
-                if(r==-1)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 接收错误，关闭连接中 ");
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+"error of receiving, and now closing this connection ");
-                    }
-                    closeWithoutLock(fd);
-                }
-                else if(r==1)
-                {
-                    
-                    
-                   
-                    if(jj->second.closeflag==true)//收到关闭确认
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到关闭确认帧: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received closed confirm fin:"+ jj->second.message);
-                        }
-                        TcpServer::close(fd);
-                    }
-                    else//收到关闭
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到关闭帧: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received closed fin:"+ jj->second.message);
-                        }
-                        cout<<"yes"<<endl;
-                        closeAck(fd,jj->second.message);
-                    }
-                    wbclientfd.erase(jj);
-                   
-                }
-                else if(r==2)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到心跳确认: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received heartbeat confirm:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    jj->second.HBTime=0;
-
-                    //记录心跳确认
-
-                    jj->second.message="";
-                   
-                }
-                else if(r==3)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到心跳: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received heartbeat:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    if(!sendMessage(jj->first,"心跳","1010"))//发送心跳失败直接关闭
-                    {
-                        wbclientfd.erase(jj);
-                        TcpServer::close(jj->first);
-                        
-                    }
-         
-                    //心跳
-                    else
-                        jj->second.message="";
-                    
-                }
-                else if(r==0)//正常报文
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到常规信息: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received normal message:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    if(!fc(jj->second.message,*this,jj->second))//回调函数失败
-                    {
-                        close(fd);
-                        
-                    }
-                    jj->second.message="";
-                    
-                }
-                //else if(r==4)
-                //{
-                //        solvingFD_lock.lock();
-                //        solvingFD[cclientfd]=false;
-                //        solvingFD_lock.unlock();
-                //        continue;
-                //}
-
-                if(r!=4)
-                {
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 处理完成");
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has solved sucessfully");
-                    }
-                }
-                else
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 继续等待数据中");
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" waiting data...");
-                    }
-                }
-            
-            }
-            }
-    }
-    */
-    /*
-    void stt::network::WebSocketServer::consumer(const int &threadID)
-    {
-        HttpServerFDHandler k;
-        //TcpFDInf &Tcpinf;
-        WebSocketServerFDHandler k1;
-        
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" 打开");
-            else
-                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" has opened");
-        }
-        while(flag1)
-        {
-            unique_lock<mutex> ul1(lq1[threadID]);
-            while(fdQueue[threadID].empty()&&flag1)
-            {
-                cv[threadID].wait(ul1);
-            }
-            if(!flag1)
-            {
-                ul1.unlock();
-                break;
-            }
-            QueueFD cclientfd=fdQueue[threadID].front();
-            fdQueue[threadID].pop();
-            
-            ul1.unlock();
-
-            if(cclientfd.close)
-            {
-                    auto ii=wbclientfd.find(cclientfd.fd);
-                    if(ii!=wbclientfd.end())
-                    {
-                        TcpServer::close(cclientfd.fd);
-                        wbclientfd.erase(ii);
-                    }
-                continue;
-            }
-
-
-            //unique_lock<mutex> lock6(lc1);
-            //auto ii=clientfd.find(cclientfd.fd);
-            if(clientfd[cclientfd.fd].fd==-1)//can not find fd information,we need to writedown this error and close this fd
-            {
-                //lock6.unlock();
-                continue;
-            }
-            else
-            {
-                if(security_open)
-                {
-                    if(!connectionLimiter.allowRequest(clientfd[cclientfd.fd].ip))
-                    {
-                        TcpServer::close(cclientfd.fd);
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"请求太频繁，已经关闭连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"request are too frequent,now has closed this connection");
-                        }
-                        continue;
-                    }
-                }
-                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                //k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                TcpFDInf &Tcpinf=clientfd[cclientfd.fd];
-            //lock6.unlock();
-            cout<<"websocket fd="<<cclientfd.fd<<endl;
-            if(stt::system::ServerSetting::logfile!=nullptr)
-             {
-                if(stt::system::ServerSetting::language=="Chinese")
-                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : 正在处理fd= "+to_string(cclientfd.fd));
-                else
-                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : now solveing fd= "+to_string(cclientfd.fd));
-             }
-            //拿到fd之后开始操作
-            unique_lock<mutex> lock(lwb);
-            auto jj=wbclientfd.find(cclientfd.fd);
-            if(jj==wbclientfd.end())//没有进行wb握手
-            {
-                k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                //k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                //unique_lock<mutex> lock(lwb);
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 正在进行websocket握手");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" handshaking websocket...");
-                }
-                WebSocketFDInformation winf;
-                winf.fd=cclientfd.fd;
-                winf.closeflag=false;
-                
-                HttpRequestInformation HttpInf;
-                int ret=k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
-                if(ret==-1)
-                {
-                    //k.close();
-
-                        TcpServer::close(cclientfd.fd);
-                        cout<<"无法解析http请求 wb握手失败"<<endl;
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 无法解析http请求或者对端关闭连接 wb握手失败 已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" couldn't solve http request or host had closed this connection.fail to handshake websocket.have closed this connection");
-                        }
-                    continue;
-                    //wb握手失败
-                }
-                else if(ret==0)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : 解析fd= "+to_string(cclientfd.fd)+"未完成 等待新的数据继续解析");
-                        else
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"wait new data to continue solve this request");
-                    }
-                    continue;
-                }
-                else if(ret==1)
-                {
-                    winf.locPara=HttpInf.locPara;
-                    winf.header=HttpInf.header;
-                    //cout<<winf.header<<endl;
-                    if(!fcc(winf))//条件不满足
-                    {
-                        //k.close();
-                        TcpServer::close(cclientfd.fd);
-                        cout<<"连接限制条件不满足 wb握手失败"<<endl;
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 连接限制条件不满足 websocket握手失败 服务器已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" The connection constraints are not met.websocket handshake fail.server has closed this connection.");
-                        }
-                        continue;
-                    }
-                    string_view key;
-                    string keyy;
-                    HttpStringUtil::get_value_header(HttpInf.header,key,"Sec-WebSocket-Key");
-                    keyy.assign(key);
-                    keyy+="258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
-                    string result="";
-                    CryptoUtil::sha1(string(keyy),result);
-                    keyy=EncodingUtil::base64_encode(result);
-                    result=HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Accept",keyy);
-                    //清理接收缓冲区可能的数据遗漏
-                    //Tcpinf.data={};
-                    
-                    if(!k.sendBack("",result,"101 Switching Protocols"))
-                    {
-                        //k.close();
-                        TcpServer::close(cclientfd.fd);
-                        cout<<"握手响应无法发送 wb握手失败"<<endl;
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 握手响应无法发送 websocket握手失败 服务器已经关闭这个连接");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" couldn't send handshake response .websocket handshake fail. server has closed this connection");
-                        }
-                        continue;
-                        //握手失败
-                    }
-                    winf.response=::time(0);
-                    winf.HBTime=0;
-                    wbclientfd.emplace(cclientfd.fd,winf);
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                            if(stt::system::ServerSetting::language=="Chinese")
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" websocket握手成功");
-                            else
-                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" websocket has handshaked sucessfully");
-                    }
-                    thread(fccc,winf,ref(*this)).detach();
-                }
-                //sleep(10);
-                //k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
-                //sleep(5);
-
-            }
-            else//已经进行了握手操作
-            {
-                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-                k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
-            int r=1;
-             int ii=1;
-            while(r!=-1&&r!=4)
-            {
-                if(stt::system::ServerSetting::logfile!=nullptr)
-                {
-                    if(stt::system::ServerSetting::language=="Chinese")
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 正在解析请求... 第"+to_string(ii)+"次处理");
-                    else
-                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" now solveing request... it is the "+to_string(ii)+" times");
-                }
-                r=k1.getMessage(Tcpinf,jj->second,buffer_size,ii);
-
-                if(r==-1)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 接收错误，关闭连接中 ");
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"error of receiving, and now closing this connection ");
-                    }
-                    closeWithoutLock(cclientfd.fd);
-                }
-                else if(r==1)
-                {
-                    
-                    
-                   
-                    if(jj->second.closeflag==true)//收到关闭确认
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到关闭确认帧: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received closed confirm fin:"+ jj->second.message);
-                        }
-                        TcpServer::close(cclientfd.fd);
-                    }
-                    else//收到关闭
-                    {
-                        if(stt::system::ServerSetting::logfile!=nullptr)
-                        {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到关闭帧: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received closed fin:"+ jj->second.message);
-                        }
-                        cout<<"yes"<<endl;
-                        closeAck(cclientfd.fd,jj->second.message);
-                    }
-                    wbclientfd.erase(jj);
-                    break;
-                }
-                else if(r==2)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到心跳确认: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received heartbeat confirm:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    jj->second.HBTime=0;
-
-                    //记录心跳确认
-
-                    jj->second.message="";
-                    break;
-                }
-                else if(r==3)
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到心跳: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received heartbeat:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    if(!sendMessage(jj->first,"心跳","1010"))//发送心跳失败直接关闭
-                    {
-                        wbclientfd.erase(jj);
-                        TcpServer::close(jj->first);
-                        break;
-                    }
-         
-                    //心跳
-                    else
-                        jj->second.message="";
-                    break;
-                }
-                else if(r==0)//正常报文
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到常规信息: "+ jj->second.message);
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received normal message:"+ jj->second.message);
-                    }
-                    jj->second.response=::time(0);
-                    if(!fc(jj->second.message,*this,jj->second))//回调函数失败
-                    {
-                        close(cclientfd.fd);
-                        break;
-                    }
-                    jj->second.message="";
-                    break;
-                }
-                //else if(r==4)
-                //{
-                //        solvingFD_lock.lock();
-                //        solvingFD[cclientfd]=false;
-                //        solvingFD_lock.unlock();
-                //        continue;
-                //}
-
-                if(r!=4)
-                {
-
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 处理完成");
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has solved sucessfully");
-                    }
-                }
-                else
-                {
-                    if(stt::system::ServerSetting::logfile!=nullptr)
-                    {
-                        if(stt::system::ServerSetting::language=="Chinese")
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 继续等待数据中");
-                        else 
-                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" waiting data...");
-                    }
-                }
-                ++ii;
-            } 
-            }
-            }
-        }
-        //跳出循环意味着结束线程
-        unique_lock<mutex> lock3(lco1);
-        consumerNum--;
-        cout<<"consumer "<<consumerNum<<" quit"<<endl;
-        lock3.unlock();
-        if(stt::system::ServerSetting::logfile!=nullptr)
-        {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(consumerNum)+"退出");
-            else
-                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(consumerNum)+"quit");
-        }
-    }
-    */
-    SSL* stt::network::TcpServer::getSSL(const int &fd)
-    {
-        //SSL *ssl;
-        //unique_lock<mutex> lock1(ltl1);
-        //auto ii=tlsfd.find(fd);
-        //if(ii==tlsfd.end())
-        //    ssl=nullptr;
-        //else
-        //    ssl=ii->second;
-        //unique_lock<mutex> lock1(lc1);
-        //auto ii=clientfd.find(fd);
-        if(fd>=maxFD||clientfd[fd].fd==-1)
-            return nullptr;
-        return clientfd[fd].ssl;
-    }
-    void stt::network::WebSocketServer::handleHeartbeat()
-    {
-        
-        time_t now;
-        
-            now=::time(0);
-            //unique_lock<mutex> lock(lwb);
-            
-            for(auto ii=wbclientfd.begin();ii!=wbclientfd.end();)
-            {
-                if(ii->second.HBTime!=0)//已经发送心跳
-                {
-                    if(now-ii->second.response>secb)//超时
-                    {
-                        if(ii->second.closeflag!=true)
-                        {
-                            short code=1000;
-                            char ccode[2];
-                            memcpy(ccode,&code,2);
-                            string codee(ccode,2);
-                            codee+="bye";
-                            WebSocketServerFDHandler k;
-                            k.setFD(ii->first,getSSL(ii->first),unblock);
-                            if(!k.sendMessage(codee,"1000"))//发送失败会自动删除在记录表里的
-                            {
-                                TcpServer::close(ii->first);
-                                ii=wbclientfd.erase(ii);
-                                continue;
-                            }
-                            ii->second.closeflag=true;
-                        }
-                    }
-                }
-                else//检查是否需要发送心跳
-                {
-                    if(now-ii->second.response>seca)
-                    {
-                        //cout<<"send"<<endl;
-                        if(!sendMessage(ii->first,"心跳","1001"))//发送心跳失败直接关闭
-                        {
-                            ii=wbclientfd.erase(ii);
-                            TcpServer::close(ii->first);
-                            continue;
-                        }
-                        ii->second.HBTime=now;
-                    }
-                }
-                ++ii;
-            }
-            
-            
-    }
-    bool stt::network::WebSocketServer::close()
-    {
-        if(!TcpServer::close())
-            return false;
-        //HBflag1=false;
-        //while(HBflag);
-        return true;
-    }
-    void stt::network::WebSocketServer::sendMessage(const string &msg,const string &type)
-    {
-        //unique_lock<mutex> lock(lwb);
-        for(auto ii=wbclientfd.begin();ii!=wbclientfd.end();)
-        {
-            if(!sendMessage(ii->first,msg,type))//发送失败直接关闭
-            {
-                ii=wbclientfd.erase(ii);
-                TcpServer::close(ii->first);
-                continue;
-            }
-            ++ii;
-        }
-    }
-    
-bool stt::system::csemp::init(key_t key,unsigned short value,short sem_flg)
-{
-    if (m_semid!=-1) return false; // 如果已经初始化了，不必再次初始化。
-
-    m_sem_flg=sem_flg;
-
-    // 信号量的初始化不能直接用semget(key,1,0666|IPC_CREAT)
-    // 因为信号量创建后，初始值是0，如果用于互斥锁，需要把它的初始值设置为1，
-    // 而获取信号量则不需要设置初始值，所以，创建信号量和获取信号量的流程不同。
-
-    // 信号量的初始化分三个步骤：
-    // 1）获取信号量，如果成功，函数返回。
-    // 2）如果失败，则创建信号量。
-    // 3) 设置信号量的初始值。
-
-    // 获取信号量。
-    if ( (m_semid=semget(key,1,0666)) == -1)
-    {
-        // 如果信号量不存在，创建它。
-        if (errno==ENOENT)
-        {
-            // 用IPC_EXCL标志确保只有一个进程创建并初始化信号量，其它进程只能获取。
-            if ( (m_semid=semget(key,1,0666|IPC_CREAT|IPC_EXCL)) == -1)
-            {
-                if (errno==EEXIST) // 如果错误代码是信号量已存在，则再次获取信号量。
-                {
-                    if ( (m_semid=semget(key,1,0666)) == -1)
-                    { 
-                        perror("init 1 semget()"); return false; 
-                    }
-                    return true;
-                }
-                else  // 如果是其它错误，返回失败。
-                {
-                    perror("init 2 semget()"); return false;
-                }
-            }
-
-            // 信号量创建成功后，还需要把它初始化成value。
-            union semun sem_union;
-            sem_union.val = value;   // 设置信号量的初始值。
-            if (semctl(m_semid,0,SETVAL,sem_union) <  0) 
-            { 
-                perror("init semctl()"); return false; 
-            }
-        }
-        else
-        { perror("init 3 semget()"); return false; }
-    }
-
-    return true;
-}
-
-// 信号量的P操作（把信号量的值减value），如果信号量的值是0，将阻塞等待，直到信号量的值大于0。
-bool stt::system::csemp::wait(short value)
-{
-    if (m_semid==-1) return false;
-
-    struct sembuf sem_b;
-    sem_b.sem_num = 0;      // 信号量编号，0代表第一个信号量。
-    sem_b.sem_op = value;   // P操作的value必须小于0。
-    sem_b.sem_flg = m_sem_flg;
-    if (semop(m_semid,&sem_b,1) == -1) { perror("p semop()"); return false; }
-
-    return true;
-}
-
-// 信号量的V操作（把信号量的值减value）。
-bool stt::system::csemp::post(short value)
-{
-    if (m_semid==-1) return false;
-
-    struct sembuf sem_b;
-    sem_b.sem_num = 0;     // 信号量编号，0代表第一个信号量。
-    sem_b.sem_op = value;  // V操作的value必须大于0。
-    sem_b.sem_flg = m_sem_flg;
-    if (semop(m_semid,&sem_b,1) == -1) { perror("V semop()"); return false; }
-
-    return true;
-}
-
-// 获取信号量的值，成功返回信号量的值，失败返回-1。
-int stt::system::csemp::getvalue()
-{
-    return semctl(m_semid,0,GETVAL);
-}
-
-// 销毁信号量。
-bool stt::system::csemp::destroy()
-{
-    if (m_semid==-1) return false;
-
-    if (semctl(m_semid,0,IPC_RMID) == -1) { perror("destroy semctl()"); return false; }
-
-    return true;
-}
-
-stt::system::csemp::~csemp()
-{
-}
-//string stt::system::ServerSetting::logName;
-stt::file::LogFile* stt::system::ServerSetting::logfile=nullptr;
-string stt::system::ServerSetting::language="English";
-void stt::system::ServerSetting::setExceptionHandling()
-{
-    for(int ii=0;ii<=64;ii++)
-        signal(ii,SIG_IGN);
-    //SIGSEGV
-    signal(SIGSEGV,signalSIGSEGV);
-    //SIGABRT
-    signal(SIGABRT,signalSIGABRT);
-    //terminate全局终止函数
-    set_terminate(signalterminated);
-}
-
-void stt::system::ServerSetting::setLogFile(LogFile *logfile,const string &language)
-{
-    //日志设置
-    if(logfile==nullptr)
-        return;
-    if(language!="")
-        stt::system::ServerSetting::language=language;
-    stt::system::ServerSetting::logfile=logfile;
-     //设置为本对象的logfile
-    if(!logfile->isOpen())
-    {
-        string logName;
-        DateTime::getTime(logName);
-        logName="./server_log/server_log_"+logName;
-        stt::system::ServerSetting::logfile->openFile(logName);
-    }
-}
-
-void stt::system::ServerSetting::init(LogFile *logfile,const string &language)
-{
-    setExceptionHandling();//信号设置
-    //日志设置
-   setLogFile(logfile,language);
-    //写日志通知打开完成了
-    if(stt::system::ServerSetting::logfile!=nullptr)
-    {
-        if(stt::system::ServerSetting::language=="Chinese")
-            stt::system::ServerSetting::logfile->writeLog("服务器信号，日志等设置完成");
-        else
-            stt::system::ServerSetting::logfile->writeLog("set server signals and logfile sucessfully");
-    }
-}
-ProcessInf* stt::system::HBSystem::p=nullptr;
-stt::system::csemp stt::system::HBSystem::plock;
-bool stt::system::HBSystem::isJoin=false;
-bool stt::system::HBSystem::join(const char *name,const char *argv0,const char *argv1,const char *argv2)
-{
-    if(p!=nullptr)
-        return false;
-    //获取/创建共享内存
-    bool first=false;
-    int shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640);
-    if(shmid==-1)
-    {
-        shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640|IPC_CREAT);
-        if(shmid==-1)
-            return false;
-        first=true;
-    }
-    p=static_cast<ProcessInf *>(shmat(shmid,0,0));
-    if(p==(void*)-1)
-        return false;
-    //获取锁
-    plock.init(0x5095);
-    //是否第一次是否需要初始化
-    if(first)
-    {
-        memset(p,-1,sizeof(struct ProcessInf)*MAX_PROCESS_INF);
-    }
-    //写入信息
-    time_t now=::time(nullptr);
-    pid_t pid=getpid();
-        //遍历找到位置
-    first=false;
-    //cout<<"join id= "<<pid<<endl;
-    if(stt::system::ServerSetting::logfile!=nullptr)
-    {
-        if(stt::system::ServerSetting::language=="Chinese")
-            stt::system::ServerSetting::logfile->writeLog("本进程正在加入心跳系统,id= "+to_string(pid));
-        else
-            stt::system::ServerSetting::logfile->writeLog("This peocess is joining HBSystem,id= "+to_string(pid));
-    }
-    plock.wait();
-    for(int ii=0;ii<MAX_PROCESS_INF;ii++)
-    {
-        if(p[ii].pid==pid||p[ii].pid==0||p[ii].pid==-1)
-        {
-            p[ii].pid=pid;
-            p[ii].lastTime=now;
-            memcpy(p[ii].name,name,MAX_PROCESS_NAME);
-            memcpy(p[ii].argv0,argv0,20);
-            memcpy(p[ii].argv1,argv1,20);
-            memcpy(p[ii].argv2,argv2,20);
-            first=true;
-            break;
-        }
-    }
-    plock.post();
-    if(first)
-    {
-        isJoin=true;
-         if(stt::system::ServerSetting::logfile!=nullptr)
-         {
-            if(stt::system::ServerSetting::language=="Chinese")
-                stt::system::ServerSetting::logfile->writeLog("本进程加入心跳系统成功");
-            else
-                stt::system::ServerSetting::logfile->writeLog("this process has join HBSystem sucessfully");
-         }
-        return true;
-    }
-    else
-        return false;
-}
-bool stt::system::HBSystem::renew()
-{
-    if(p==nullptr)
-        return false;
-    time_t now=::time(nullptr);
-    pid_t pid=getpid();
-    //cout<<"renew= "<<pid<<endl;
-    plock.wait();
-    for(int ii=0;ii<MAX_PROCESS_INF;ii++)
-    {
-        if(p[ii].pid==pid)
-        {
-            p[ii].pid=pid;
-            p[ii].lastTime=now;
-            //cout<<"renwe*** ";
-            list();
-            plock.post();
-            return true;
-        }
-    }
-    plock.post();
-    return false;
-}
-void stt::system::HBSystem::list()
-{
-    if(p!=nullptr)
-    {
-        for(int ii=0;ii<MAX_PROCESS_INF;ii++)
-        {
-            if(p[ii].pid>0)
-                cout<<"pid= "<<p[ii].pid<<"name= "<<p[ii].name<<" last time= "<<p[ii].lastTime<<"para="<<p[ii].argv0<<" "<<p[ii].argv1<<" "<<p[ii].argv2<<endl;
-        }
-    }
-}
-bool stt::system::HBSystem::HBCheck(const int &sec)
-{
-    //拿到共享内存
-    if(p==nullptr)
-    {
-        //获取/创建共享内存
-        bool first=false;
-        int shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640);
-        if(shmid==-1)
-        {
-            shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640|IPC_CREAT);
-            if(shmid==-1)
-                return false;
-            first=true;
-        }
-        p=static_cast<ProcessInf *>(shmat(shmid,0,0));
-        if(p==(void*)-1)
-            return false;
-        //获取锁
-        plock.init(0x5095);
-        //是否第一次是否需要初始化
-        if(first)
-        {
-            memset(p,-1,sizeof(struct ProcessInf)*MAX_PROCESS_INF);
-        }
-    }
-    list();
-    //遍历检查
-    for(int ii=0;ii<MAX_PROCESS_INF;ii++)
-    {
-        time_t now=::time(nullptr);
-        if(p[ii].pid==0)
-            continue;
-        else if(p[ii].pid==-1)
-            break;
-        //超时
-        if((now-p[ii].lastTime)>=sec)
-        {
-            //检查是否存在
-                //发送信号杀死
-                //检查是否杀死
-                int sec=0;
-                while(kill(p[ii].pid,0)!=-1&&sec<=7)
-                {
-                    kill(p[ii].pid,15);
-                    sleep(1);
-                    sec++;
-                }
-
-                while(kill(p[ii].pid,0)!=-1)
-                {
-                    kill(p[ii].pid,9);
-                    sleep(1);
-                }
-            
-            //清理信息
-            plock.wait();
-            p[ii].pid=0;
-            p[ii].lastTime=0;
-            plock.post();
-            //重新启动
-            Process::startProcess(p[ii].name,-1,p[ii].argv0,p[ii].argv1,p[ii].argv2);
-        }
-    }
-    return true;
-}
-bool stt::system::HBSystem::deleteFromHBS()
-{
-    if(isJoin&&(p!=nullptr))
-    {
-        //cout<<"清理信息"<<endl;
-        pid_t pid=getpid();
-        plock.wait();
-        for(int ii=0;ii<MAX_PROCESS_INF;ii++)
-        {
-            if(p[ii].pid==pid)
-            {
-                p[ii].pid=0;
-                p[ii].lastTime=0;
-                plock.post();
-                list();
-                return true;
-            }
-        }
-        plock.post();
-        cerr<<"can't find process in hbs"<<endl;
-        return false;
-    }
-    return false;
-}
-stt::system::HBSystem::~HBSystem()
-{
-    //cout<<"析构函数运行  ~HBS"<<endl;
-    if(p!=nullptr)
-    {
-        if(!deleteFromHBS()||shmdt(p)==-1)
-            cerr<<"close shared memory failed"<<endl;
-    }
-}
-bool stt::security::ConnectionLimiter::allow(RateState &st,const RateLimitType &type,const int &times,const int &secs,const std::chrono::steady_clock::time_point &now)
-{
-    using namespace std::chrono;
-
-    if (times <= 0 || secs <= 0)
-        return true;
-
-    auto window = seconds(secs);
-
-    switch (type)
-    {
-    case RateLimitType::Cooldown:
-        if (st.lastTime.time_since_epoch().count() == 0)
-            st.lastTime = now;
-
-        if (now - st.lastTime >= window)
-        {
-            st.counter = 0;
-            st.lastTime = now;
-        }
-
-        if (st.counter >= times)
-        {
-            st.violations++;
-            return false;
-        }
-
-        st.counter++;
-        st.lastTime = now;
-        return true;
-
-    case RateLimitType::FixedWindow:
-        if (st.lastTime.time_since_epoch().count() == 0)
-            st.lastTime = now;
-
-        if (now - st.lastTime >= window)
-        {
-            st.counter = 0;
-            st.lastTime = now;
-        }
-
-        if (st.counter >= times)
-        {
-            st.violations++;
-            return false;
-        }
-
-        st.counter++;
-        return true;
-
-    case RateLimitType::SlidingWindow:
-        while (!st.history.empty() &&
-               now - st.history.front() >= window)
-            st.history.pop_front();
-
-        if ((int)st.history.size() >= times)
-        {
-            st.violations++;
-            return false;
-        }
-
-        st.history.push_back(now);
-        return true;
-
-    case RateLimitType::TokenBucket:
-        if (st.lastRefill.time_since_epoch().count() == 0)
-        {
-            st.tokens = times;
-            st.lastRefill = now;
-        }
-
-        double dt =
-            std::chrono::duration_cast<std::chrono::duration<double>>(
-                now - st.lastRefill).count();
-
-        st.tokens = std::min<double>(
-            times,
-            st.tokens + dt * (double(times) / secs));
-
-        st.lastRefill = now;
-
-        if (st.tokens < 1.0)
-        {
-            st.violations++;
-            return false;
-        }
-
-        st.tokens -= 1.0;
-        return true;
-    }
-
-    return true;
-}
-stt::security::DefenseDecision stt::security::ConnectionLimiter::allowConnect(const std::string &ip, const int &fd,const int &times, const int &secs)
-{
-    auto now = std::chrono::steady_clock::now();
-
-    // ===== 黑名单检查 =====
-    auto bit = blacklist.find(ip);
-    if (bit != blacklist.end())
-    {
-        if (now < bit->second)
-        {
-            logSecurity(
-                "【封禁】IP " + ip + " 尝试连接，被拒绝（封禁中）",
-                "[BAN] IP " + ip + " connection rejected (banned)"
-            );
-            return CLOSE;
-        }
-        blacklist.erase(bit); // 解封
-    }
-
-    auto &info = table[ip];
-
-    // 并发连接数
-    if (info.activeConnections >= maxConnections)
-    {
-        info.badScore++;
-
-        logSecurity(
-            "【安全】IP " + ip + " 并发连接数超限，已断开",
-            "[SECURITY] IP " + ip + " exceeded max connections"
-        );
-
-        return CLOSE;
-    }
-
-    // 建连速率
-    if (!allow(info.connectRate, connectStrategy, times, secs, now))
-    {
-        info.badScore++;
-
-        logSecurity(
-            "【安全】IP " + ip + " 建连过快，已断开",
-            "[SECURITY] IP " + ip + " connection rate limited"
-        );
-
-        // 升级为黑名单
-        if (info.badScore >= 10)
-        {
-            blacklist[ip] = now + std::chrono::minutes(10);
-
-            logSecurity(
-                "【封禁】IP " + ip + " 多次恶意建连，封禁 10 分钟",
-                "[BAN] IP " + ip + " banned for 10 minutes"
-            );
-        }
-
-        return CLOSE;
-    }
-
-    // ===== 正式登记 fd =====
-    info.activeConnections++;
-    info.conns.emplace(fd, ConnectionState{
-        fd, RateState{}, {}, now
-    });
-
-    return ALLOW;
-}
-
-
-stt::security::DefenseDecision stt::security::ConnectionLimiter::allowRequest(const std::string &ip,const int &fd,const std::string_view &path,const int &times,const int &secs)
-{
-    auto now = std::chrono::steady_clock::now();
-
-    auto it = table.find(ip);
-    if (it == table.end())
-        return CLOSE;
-
-    auto &info = it->second;
-
-    // 黑名单检查
-    auto bit = blacklist.find(ip);
-    if (bit != blacklist.end() && now < bit->second)
-        return CLOSE;
-
-    auto itc = info.conns.find(fd);
-    if (itc == info.conns.end())
-        return CLOSE;
-
-    auto &conn = itc->second;
-    conn.lastActivity = now;
-
-    // fd 级限流
-    if (!allow(conn.requestRate, requestStrategy, times, secs, now))
-    {
-        if (conn.requestRate.violations < 3)
-        {
-            logSecurity(
-                "【限流】IP " + ip + " fd=" + std::to_string(fd) +
-                " 请求过快，已丢弃",
-                "[RATE] IP " + ip + " fd=" + std::to_string(fd) +
-                " request dropped"
-            );
-            return DROP;
-        }
-
-        info.badScore++;
-
-        logSecurity(
-            "【安全】IP " + ip + " fd=" + std::to_string(fd) +
-            " 多次违规，已断开",
-            "[SECURITY] IP " + ip + " fd=" + std::to_string(fd) +
-            " repeated abuse, closed"
-        );
-
-        if (info.badScore >= 15)
-        {
-            blacklist[ip] = now + std::chrono::minutes(30);
-
-            logSecurity(
-                "【封禁】IP " + ip + " 恶意请求，封禁 30 分钟",
-                "[BAN] IP " + ip + " banned for 30 minutes"
-            );
-        }
-
-        return CLOSE;
-    }
-
-    // path 级限流
-    auto pc = pathConfig.find(std::string(path));
-    if (pc != pathConfig.end())
-    {
-        auto &[ptimes, psecs] = pc->second;
-        auto &pst = conn.pathRate[std::string(path)];
-
-        if (!allow(pst, pathStrategy, ptimes, psecs, now))
-        {
-            logSecurity(
-                "【安全】IP " + ip + " fd=" + std::to_string(fd) +
-                " 访问路径 " + std::string(path) + " 过于频繁，已断开",
-                "[SECURITY] IP " + ip + " fd=" + std::to_string(fd) +
-                " path rate limited"
-            );
-
-            info.badScore++;
-            return CLOSE;
-        }
-    }
-
-    return ALLOW;
-}
-void stt::security::ConnectionLimiter::setPathLimit(const std::string &path, const int &times, const int &secs)
-{
-    pathConfig[path] = {times, secs};
-}
-bool stt::security::ConnectionLimiter::connectionDetect(const std::string &ip,const int &fd)
-{
-    if (connectionTimeout < 0)
-        return false;
-
-    auto it = table.find(ip);
-    if (it == table.end())
-        return false;
-
-    auto &info = it->second;
-    auto itc = info.conns.find(fd);
-    if (itc == info.conns.end())
-        return false;
-
-    auto now = std::chrono::steady_clock::now();
-    if (now - itc->second.lastActivity >
-        std::chrono::seconds(connectionTimeout))
-    {
-        info.conns.erase(itc);
-        if (info.activeConnections > 0)
-            info.activeConnections--;
-        return true;
-    }
-
-    return false;
-
-}
-void stt::security::ConnectionLimiter::setConnectStrategy(const RateLimitType &type)
-{
-    connectStrategy = type;
-}
-
-void stt::security::ConnectionLimiter::setRequestStrategy(const RateLimitType &type)
-{
-    requestStrategy = type;
-}
-
-void stt::security::ConnectionLimiter::setPathStrategy(const RateLimitType &type)
-{
-    pathStrategy = type;
-}
-void stt::security::ConnectionLimiter::clearIP(const std::string &ip,const int &fd)
-{
-    auto it = table.find(ip);
-    if (it == table.end())
-        return;
-
-    auto &info = it->second;
-    auto itc = info.conns.find(fd);
-    if (itc == info.conns.end())
-        return;
-
-    info.conns.erase(itc);
-    if (info.activeConnections > 0)
-        info.activeConnections--;
-}
-inline void stt::security::ConnectionLimiter::logSecurity(const std::string &msgCN,const std::string &msgEN)
-{
-    if (stt::system::ServerSetting::logfile != nullptr)
-    {
-        if (stt::system::ServerSetting::language == "Chinese")
-            stt::system::ServerSetting::logfile->writeLog(msgCN);
-        else
-            stt::system::ServerSetting::logfile->writeLog(msgEN);
-    }
-}
-void stt::security::ConnectionLimiter::banIP(
-    const std::string &ip,
-    int banSeconds,
-    const std::string &reasonCN,
-    const std::string &reasonEN)
-{
-    auto now = std::chrono::steady_clock::now();
-
-    std::chrono::steady_clock::time_point until;
-
-    if (banSeconds < 0)
-    {
-        // 永久封禁（不会溢出、不会依赖 int）
-        until = std::chrono::steady_clock::time_point::max();
-    }
-    else if (banSeconds == 0)
-    {
-        return;
-    }
-    else
-    {
-        // 防御性截断，避免 int 极值/误传
-        if (banSeconds > 65535)
-            banSeconds = 65535;
-
-        until = now + std::chrono::seconds(banSeconds);
-    }
-    auto it = blacklist.find(ip);
-    if (it != blacklist.end())
-    {
-        // 若已有封禁时间更晚，则不缩短
-        if (it->second >= until)
-            return;
-    }
-    blacklist[ip] = until;
-
-    logSecurity(
-        "【直接封禁】IP " + ip + "：" + reasonCN +
-            (banSeconds < 0
-                ? "（永久封禁）"
-                : "，封禁 " + std::to_string(banSeconds) + " 秒"),
-        "[DIRECT BAN] IP " + ip + ": " + reasonEN +
-            (banSeconds < 0
-                ? " (permanent)"
-                : ", banned for " + std::to_string(banSeconds) + " seconds")
-    );
-}
-
-void stt::security::ConnectionLimiter::unbanIP(const std::string &ip)
-{
-    auto it = blacklist.find(ip);
-    if (it != blacklist.end())
-    {
-        blacklist.erase(it);
-
-        logSecurity(
-            "【解封】IP " + ip + " 已解除封禁",
-            "[UNBAN] IP " + ip + " unbanned"
-        );
-    }
-}
-bool stt::security::ConnectionLimiter::isBanned(
-    const std::string &ip) const
-{
-    auto it = blacklist.find(ip);
-    if (it == blacklist.end())
-        return false;
-
-    return std::chrono::steady_clock::now() < it->second;
-}
+#include"../include/sttnet.h"
+using namespace std;
+using namespace stt::file;
+using namespace stt::time;
+using namespace stt::data;
+using namespace stt::network;
+using namespace stt::system;
+
+
+            //思路：先从尾到头遍历检查看看哪里的目录是不存在的，边检查边逐级创建
+bool stt::file::FileTool::createDir(const string & ddir,const mode_t &mode)
+{	
+	string k=ddir;
+	string test;
+	size_t ii=1;
+	while(1)
+	{	
+		if((ii=k.find('/',ii))==string::npos)//已经是最顶层
+		{	
+			if(access(k.c_str(),F_OK)<0)//不存在就创建
+			{
+				if(mkdir(k.c_str(),mode)<0)
+				{
+					//cout<<k<<endl;
+					perror("mkdir() fail");
+					return false;
+				}
+			}
+			break;
+		}
+		//非最顶层
+		test=k.substr(0,ii);
+		if(access(test.c_str(),F_OK)<0)//不存在就创建
+		{
+                                if(mkdir(test.c_str(),mode)<0)
+                                {
+                                        //cout<<test<<endl;
+                                        perror("mkdir() fail");
+					return false;
+                                }
+                        
+		}
+		ii++;
+	}		
+	return true;
+}
+bool stt::file::FileTool::createFile(const string &filePath,const mode_t &mode)
+{
+    if(access(filePath.c_str(),F_OK)==0)//检查文件是否已经存在
+    {
+        //cerr<<"file has already exist"<<endl;
+        return true;
+    }
+    //创建路径
+    size_t ii=filePath.rfind("/");
+    string path=filePath;
+    if(ii!=string::npos)
+    {
+        path.erase(ii);
+        if(createDir(path,0775)==false)
+        {
+            cerr<<"create path fail"<<endl;
+            return false;
+        }
+    }
+    //创建文件
+    int fd=open(filePath.c_str(),O_CREAT|O_EXCL,mode);
+    if(fd<0)
+    {
+        perror("open() fail");
+        return false;
+    }
+    //关闭文件
+    ::close(fd);
+    return true;
+}
+bool stt::file::FileTool::copy(const string &a,const string &b)
+{
+	ifstream a1;
+	ofstream b1;
+	a1.open(a,ios::in);
+	b1.open(b,ios::out);
+//	if(a1.is_open()==false||b1.is_open()==false)
+//		return false;
+	string kk;
+	while(getline(a1,kk))
+	      b1<<kk<<endl;
+	a1.close();
+	b1.close();
+	return true;
+}
+    size_t stt::file::FileTool::get_file_size(const string &fileName)
+    {
+        struct stat st;
+        if(stat(fileName.c_str(),&st)==0)
+        {
+            return st.st_size;
+        }
+        else
+            return -1;
+    }
+    mutex File::l1;
+    unordered_map<string,FileThreadLock> File::fl2;
+    bool stt::file::File::closeFile(const bool &del)
+    {
+        bool ok=true;
+        if(!isOpen())//检查是否对象打开了文件
+        {
+            cerr<<"没有打开文件"<<endl;
+            return false;
+        }
+        //看是否需要unlockmemory
+        //如果还是锁住说明是突然关闭，那么理应回退内存，操作失败 
+        unique_lock<mutex> testlock(che,try_to_lock);
+        if(!testlock.owns_lock())//拿不到锁
+        {
+            unlockMemory(true);
+        }
+
+        //关闭锁注册表
+        //if(l1use)
+        unique_lock<mutex> lock2(l1);
+        auto ii=fl2.find(fileName);
+        if(ii!=fl2.end())
+        {
+        if(ii->second.threads==1)
+        {
+            fl2.erase(ii);
+        }
+        else
+            ii->second.threads--;
+        }
+        //if(l1use)
+        lock2.unlock();
+        //关闭读流
+        fin.clear();//清除文件数据流
+        fin.close();
+
+        //if(fin.fail())
+        //{
+        //   perror("fin close() fail");
+        //    ok=false;
+        //}
+        if(del==true)
+        {
+            if(remove(fileName.c_str())!=0)
+            {
+                perror("file delete() fail");
+                ok=false;
+            }
+        }
+        //清除内存数据
+        if(binary)
+            data.clear();
+        else
+        {
+            if(data_binary!=nullptr)
+            {
+                delete[] data_binary;
+                data_binary=nullptr;
+            }
+            if(backUp_binary!=nullptr)
+            {
+                delete[] backUp_binary;
+                backUp_binary=nullptr;
+            }
+        }
+        //关闭fd
+        //::close(fd);
+        //fd=-1;
+        //完成
+        flag=false;
+        return ok;
+        
+    }
+    bool stt::file::File::toDisk()//创造临时文件 加锁 写 覆盖原文件。不在源文件直接写是怕清空内容后来不及写就发生故障 文字消失 (就算前面主文件有读写锁了，只能保证在这个类的操作不会影响这个临时文件，不代表其他不会，所以一样要加上读锁)
+    {
+        //创建一个临时文件
+        int fdd=open(fileNameTemp.c_str(),O_RDWR|O_CREAT,mode);//问了进程锁 用posix的接口打开文件
+        if(fdd<0)
+        {
+            cerr<<"临时文件创建失败"<<endl;
+            return false;
+        }
+        //打开临时文件
+        if(binary)
+        {
+            fout.open(fileNameTemp,ios::binary);
+            if(!fout.is_open())
+            {
+                perror("tempfile fout open() fail");
+                fout.clear();
+                fout.close();
+                ::close(fdd);
+                return false;
+            }
+            fout.write(data_binary,size1);
+            
+            size=size1;
+        }
+        else
+        {
+            fout.open(fileNameTemp,ios::trunc);
+            if(!fout.is_open())
+            {
+                perror("tempfile fout open() fail");
+                fout.clear();
+                fout.close();
+                ::close(fdd);
+                return false;
+            }
+            fout<<unitbuf;//不启用缓冲区
+
+            //把内存数据存到一个字符串
+            string dataa;
+            for(auto &ii:this->data)
+            {
+                dataa+=ii+"\n";
+            }
+            if(dataa!="")
+                dataa.erase(dataa.size()-1);
+
+            fout<<dataa;
+
+            totalLines=this->data.size();
+        }
+        
+        fout.clear();
+        fout.close();
+        if(fout.fail())
+        {
+            perror("temp fout close() fail");
+            ::close(fdd);
+            return false;
+        }
+        if(rename(fileNameTemp.c_str(),fileName.c_str())<0)
+		{
+			perror("temp rename() fail");
+            ::close(fdd);
+			return false;
+		}
+        ::close(fdd);
+        return true;
+    }
+
+    void stt::file::File::toMemory()
+    {
+        fin.close();
+        if(binary)
+        {
+            /*
+            fin.open(fileName,ios::binary);
+            fin.seekg(0,ios::end);
+            streampos file_size = fin.tellg(); // 获取文件大小
+            size=static_cast<size_t>(file_size);
+
+            fin.seekg(0,ios::beg);
+            */
+            if(data_binary!=nullptr)
+                delete[] data_binary;
+            if(backUp_binary!=nullptr)
+                delete[] backUp_binary;
+            size=FileTool::get_file_size(fileName);
+            fin.open(fileName,ios::binary);
+            
+            if(multiple_backup==0)
+            {
+                malloced=size*multiple;
+            }
+            else
+            {
+                malloced=multiple_backup;
+            }
+            
+            data_binary=new char[malloced];
+            backUp_binary=new char[malloced];
+
+            fin.read(data_binary,size);
+            memcpy(backUp_binary,data_binary,size);
+
+            size1=size;
+            size2=size;
+        }
+        else
+        {
+            fin.open(fileName,ios::in);
+            string dataa;
+            data.clear();
+            fin.seekg(0, ios::beg); 
+            while(1)
+            {
+                getline(fin,dataa);
+                if(fin)
+                {
+                    //cout<<"+dataa:"<<dataa<<endl;
+                    data.push_back(dataa);
+                }
+                else
+                {
+                    //fin.seekg(0,ios::beg);
+                    break;
+                }
+            }
+            totalLines=data.size();
+        }
+        
+        //fin.seekg(0, ios::end); // 移动到文件末尾
+        //streampos file_size = fin.tellg(); // 获取文件大小
+        //size=static_cast<size_t>(file_size);
+    }
+    bool stt::file::File::openFile(const string & fileName,const bool &create,const int &multiple,const size_t &size,const mode_t &mode)
+    {
+        if(isOpen())
+        {
+            if(!closeFile(false))
+            {
+                cerr<<"对象无法关闭已经打开的文件"<<endl;
+                return false;
+            }
+        }
+        if(!create)
+        {
+            if(access(fileName.c_str(),F_OK)!=0)//检查文件是否已经存在
+                return false;
+        }
+        this->mode=mode;
+        if(multiple>=1)
+        {
+            this->binary=true;
+            this->multiple=multiple;
+            this->multiple_backup=size;
+        }
+        else
+            this->binary=false;
+        this->fileName=fileName;
+        this->fileNameTemp=fileName+".temp";
+        if(!createFile(fileName,mode))
+        {
+            cerr<<"文件不存在 且创建文件失败"<<endl;
+            return false;
+        }
+        //读文件流
+        /*
+        //std::ios::in：打开文件用于读取（默认模式）。
+	    //std::ios::out：打开文件用于写入。
+	    //std::ios::app：打开文件用于追加写入，文件指针移动到文件末尾。
+	    //std::ios::binary：以二进制模式打开文件，用于处理二进制数据。
+        */
+        if(binary)
+        {
+            fin.open(fileName,ios::binary);
+        }
+        else
+        {
+            fin.open(fileName,ios::in);
+        }
+        if(!fin.is_open())
+        {
+            perror("file fin open() fail");
+            return false;
+        }
+        
+        //把数据读入到容器
+        //toMemory();
+        //if(l1use)
+        unique_lock<mutex> lock2(l1);
+        auto ii=fl2.find(fileName);
+        if(ii!=fl2.end())
+            ii->second.threads++;
+        else
+        {
+            File::fl2.emplace(piecewise_construct,forward_as_tuple(fileName),forward_as_tuple(fileName,1));
+        }
+        //if(l1use)
+        lock2.unlock();
+        flag=true;
+        return flag;
+    }
+    string& stt::file::File::read(string &data,const int &linePos,const int &num)
+    {
+        unique_lock<mutex> lock1(fl1); //因为要调用size函数 所以要上锁小心改变
+        toMemory();
+        
+        return readC(data,linePos,num);
+    }
+    string& stt::file::File::readC(string &data,const int &linePos,const int &num)
+    {
+        data="";
+        if(!isOpen())
+            return data;
+        if(linePos<=this->data.size()&&(linePos+num-1)<=this->data.size())
+        {
+            int ii=1;
+            while(ii<=num)
+            {
+                data+=this->data[linePos-1+ii-1]+"\n";
+                ii++;
+            }
+            if(data!="")
+                data.erase(data.size()-1);
+            return data;
+        }
+        else
+            return data;
+    }
+    bool stt::file::File::readLine(string &data,const int linePos)
+    {
+        unique_lock<mutex> lock1(fl1); //因为要调用size函数 所以要上锁小心改变
+        toMemory();
+        
+        return readLineC(data,linePos);
+    }
+    
+    bool stt::file::File::readLineC(string &data,const int linePos)
+    {
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return false;
+        }
+        if(this->data.size()<linePos)
+            return false;
+        data=this->data[linePos-1];
+        return true;
+    }
+    
+    string& stt::file::File::readAll(string &data)
+    {
+        unique_lock<mutex> lock1(fl1);//由于是read，不需要加锁（要确保读写统一性请组合操作 组合操作前后操作锁），因为要遍历容器，所以要上内存的容器锁
+        toMemory();
+        readAllC(data);
+        return data;
+    }
+    
+    string& stt::file::File::readAllC(string &data)
+    {
+        data="";
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return data;
+        }
+        
+        for(auto &ii:this->data)
+        {
+            data+=ii+"\n";
+        }
+
+        if(data!="")
+            data.erase(data.size()-1);
+        return data;
+    }
+    
+    void stt::file::File::lockfl2()
+    {
+        //if(l1use)
+        unique_lock<mutex> lock2(l1);
+        auto ii=fl2.find(fileName);
+        if(ii==fl2.end())
+        {
+            //cout<<fileName<<endl;
+            //cout<<"lock找不到文件"<<endl;
+        }
+        else
+            ii->second.lock.lock();
+    }
+    void stt::file::File::unlockfl2()
+    {
+        //if(l1use)
+        unique_lock<mutex> lock2(l1);
+        auto ii=fl2.find(fileName);
+        //if(ii==fl2.end())
+            //cout<<"unlock找不到文件"<<endl;
+        //else
+        if(ii!=fl2.end())
+            ii->second.lock.unlock();
+    }
+    bool stt::file::File::lockMemory()
+    {
+        //if(fd<0)
+        //{
+        //    fd=open(fileName.c_str(),O_RDWR,mode);//问了进程锁 用posix的接口打开文件
+        //    if(fd<0)
+        //    {
+        //        cerr<<"fd打开文件失败"<<endl;
+        //        return false;
+        //    }
+        //}
+        //if(flag_lock)
+        //    unlockMemory(true);
+        //flag_lock=true;
+        che.lock();
+        //线程上锁
+        lockfl2();
+         // 获取文件锁
+        //struct flock fl;
+        //fl.l_type = F_RDLCK;  // 写入锁
+        //fl.l_whence = SEEK_SET;
+        //fl.l_start = 0;
+        //fl.l_len = 0;
+        //if (fcntl(fd, F_SETLKW, &fl) == -1)
+		//{
+        //    ::close(fd);
+        //    fd=-1;
+        //    cerr << getpid()<<":failed to acquire lock." <<endl;
+        //    return false;
+        //}
+        //File::fl2.lock();
+        fl1.lock();
+        toMemory();
+        backUp=data;
+        return true;
+    }
+    bool stt::file::File::unlockMemory(const bool &rec)
+    {
+        //if(!chee.owns_lock())
+        //    return false;
+        //struct flock fl;
+        //fl.l_type = F_UNLCK;  // 解锁
+        //fl.l_whence = SEEK_SET;
+        //fl.l_start = 0;
+        //fl.l_len = 0;
+        //flag_lock=false;
+        if(rec||!toDisk())
+        {
+            //释放原来文件的锁
+            //File::fl2.unlock();
+            //if (fcntl(fd, F_SETLK, &fl) == -1) 
+	        //{
+            //    cerr << getpid()<< "Failed to unlock file" << endl;
+		    //    perror("unlock");
+            //    //::close(fd);
+            //    //fd不可以取消,取消了就无法处理没解锁的情况了
+            //    //return false;
+            //}
+            //close(fd);
+            //fd=-1;
+            unlockfl2();
+            if(!binary)
+                data=backUp;
+            else
+            {
+                memcpy(data_binary,backUp_binary,size2);
+                size1=size2;
+            }
+
+            if(rec==false)
+            {
+                fl1.unlock();
+                //flag_lock=false;
+                che.unlock();
+                return false;
+            }
+            else
+            {
+                fl1.unlock();
+                //flag_lock=false;
+                che.unlock();
+                return true;//因为别的原因（导入了参数，而参数来自其他操作）需要回退内存也是返回false
+            }
+        }
+        else
+        {
+            //释放原来文件的锁
+            //File::fl2.unlock();
+            //if (fcntl(fd, F_SETLK, &fl) == -1) 
+	        //{
+            //    cerr << getpid()<< "Failed to unlock file" << endl;
+		    //    perror("unlock");
+            //    //::close(fd);
+            //    //fd不可以取消
+            //    //return false;
+            //}
+            //close(fd);
+            //fd=-1;
+            unlockfl2();
+            fl1.unlock();
+            //flag_lock=false;
+            che.unlock();
+            return true;
+        }
+    }
+    int stt::file::File::findC(const string &targetString,const int linePos)
+    {
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return -1;
+        }
+        if(this->data.size()<linePos)
+            return -1;
+        for(int pos=linePos;pos<=this->data.size();pos++)
+        {
+            if(this->data[pos-1].find(targetString)!=string::npos)
+            {
+                return pos;
+            }
+        }
+        return -1;
+    }
+    int stt::file::File::find(const string &targetString,const int linePos)
+    {
+        int rec;
+        //fl1.lock();//不涉及内存改变 正常加锁就行
+        unique_lock<mutex> lock1(fl1);
+        //new:需要加锁（内存容器的） 因为调用了size函数
+        toMemory();
+        rec=findC(targetString,linePos);
+        //lock1.unlock();
+        return rec;
+    }
+    bool stt::file::File::appendLineC(const string &data,const int &linePos)
+    {
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return false;
+        }
+        if(linePos==0)
+        {
+            this->data.push_back(data);
+        }
+        else
+        {
+            if(linePos>this->data.size())
+            {
+                cerr<<"插入行无法定位"<<endl;
+                return false;
+            }
+            this->data.insert(this->data.begin()+linePos-1,data);
+        }
+        return true;
+
+    }
+    bool stt::file::File::appendLine(const string &data,const int &linePos)
+    {
+        if(!lockMemory())
+            return false;
+        return unlockMemory(!appendLineC(data,linePos));
+    }
+    bool stt::file::File::deleteLineC(const int &linePos)
+    {
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return false;
+        }
+        if(linePos==0)
+        {
+            this->data.pop_back();
+        }
+        else
+        {
+            if(linePos>this->data.size())
+            {
+                cerr<<"删除行无法定位"<<endl;
+                return false;
+            }
+            this->data.erase(this->data.begin()+linePos-1);
+        }
+        return true;
+    }
+    bool stt::file::File::deleteLine(const int &linePos)
+    {
+        if(!lockMemory())
+            return false;
+        return unlockMemory(!deleteLineC(linePos));
+    }
+    bool stt::file::File::deleteAllC()
+    {
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return false;
+        }
+        this->data.clear();
+        return true;
+    }
+    bool stt::file::File::deleteAll()
+    {
+        if(!lockMemory())
+            return false;
+        return unlockMemory(!deleteAllC());
+    }
+    bool stt::file::File::chgLineC(const string &data,const int &linePos)
+    {
+        if(!isOpen())
+        {
+            cerr<<"对象没有打开文件 无法调用函数"<<endl;
+            return false;
+        }
+        if(linePos==0)
+        {
+            this->data[this->data.size()-1]=data;
+        }
+        else
+        {
+            if(linePos>this->data.size())
+            {
+                cerr<<"修改行无法定位"<<endl;
+                return false;
+            }
+            this->data[linePos-1]=data;
+        }
+        return true;
+    }
+    bool stt::file::File::chgLine(const string &data,const int &linePos)
+    {
+        if(!lockMemory())
+            return false;
+        return unlockMemory(!chgLineC(data,linePos));
+    }
+    /*
+    char* File::read(char *data,const int &size,const int &pos)
+    {
+        string dataa;
+        readAll(dataa);
+        dataa=dataa.substr(pos,size);
+        memcpy(data,dataa.data(),size);
+        return data;
+    }
+    bool File::write(char *data,const int &size)
+    {
+        string dataa(data,size);
+        return appendLine(dataa);
+    }
+    bool File::rewrite(char *data,const int &size)
+    {
+        lockMemory();
+        if(!deleteAllC())
+        {
+            unlockMemory();
+            return false;
+        }
+        string dataa(data,size);
+        if(!appendLine(dataa))
+        {
+            unlockMemory();
+            return false;
+        }
+        return unlockMemory();
+    }
+    */
+    
+    bool stt::file::File::read(char *data,const size_t &pos,const size_t &size)
+    {
+        unique_lock<mutex> lock1(fl1);
+        //要上锁，防止容器的size改变了没及时发现，可能带来危险
+        toMemory();
+        return readC(data,pos,size);
+    }
+    bool stt::file::File::readC(char *data,const size_t &pos,const size_t &size)
+    {
+        //判断是否越界(是否在文件有效范围内)
+        if(pos+1<=size1&&pos+size<=size1)
+        {
+            //读内存
+            memcpy(data,data_binary+pos,size);
+            return true;
+        }
+        return false;
+    }
+    bool stt::file::File::write(const char *data,const size_t &pos,const size_t &size)
+    {
+        lockMemory();
+        return unlockMemory(!writeC(data,pos,size));
+    }
+    bool stt::file::File::writeC(const char *data,const size_t &pos,const size_t &size)
+    {
+        //判断是否越界(有没有超出限制)
+        if(((pos+1)<=malloced)&&((pos+size)<=malloced))
+        {
+            //写内存
+            memcpy(data_binary+pos,data,size);
+            //改变size1的值
+            if(pos+size>size1)
+                size1=pos+size;
+            return true;
+        }
+        return false;
+    }
+    void stt::file::File::format()
+    {
+        lockMemory();
+        formatC();
+        unlockMemory();
+    }
+    bool stt::file::File::formatC()
+    {
+        //格式化内存
+        memset(data_binary,0,size1);
+        //改变size1的值
+        size1=0;
+        return true;
+    }
+    
+    ostream& stt::time::operator<<(ostream &os,const Duration &a)
+    {
+        os<<"day="<<a.day<<" "<<a.hour<<":"<<a.min<<":"<<a.sec<<"."<<a.msec;
+        return os;
+    }
+    chrono::system_clock::time_point stt::time::DateTime::strToTimePoint(const string &timeStr,const string &format)
+    {
+        //获取毫秒保存
+        string sss;
+        auto pos=format.find(".sss");
+        if(pos==string::npos)
+            sss="000";
+        else
+            sss=timeStr.substr(pos+1,3);
+        //创建一个新的日期和格式字符串的拷贝并且消掉毫秒部分
+        string cformat=format;
+        string ctimeStr=timeStr;
+
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,4,"");
+            ctimeStr.replace(pos,4,"");
+        }
+
+        //先把yyyy格式转化为gettime接受的形式
+        pos=cformat.find("yyyy");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,4,"%Y");
+        }
+        pos=cformat.find("mm");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%m");
+        }
+        pos=cformat.find("dd");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%d");
+        }
+        pos=cformat.find("hh");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%H");
+        }
+        pos=cformat.find("mi");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%M");
+        }
+        pos=cformat.find("ss");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%S");
+        }
+        //开始反向解析日期字符串
+            //先用istringstream和gettime反向解析为tm结构体
+        tm t;
+        istringstream ss(ctimeStr);
+        ss>>get_time(&t,cformat.c_str());
+        if(ss.fail())
+        {
+            cerr<<"fail to parse time string to tm struct"<<endl;
+        }
+        t.tm_isdst = -1; //tm结构体要补完 防止没有初始化导致有时有可能行为不确定
+        //cout<<t.tm_year<<endl;
+        //cout<<t.tm_mon<<endl;
+        //cout<<t.tm_mday<<endl;
+        //cout<<t.tm_hour<<endl;
+        //cout<<t.tm_min<<endl;
+        //cout<<t.tm_sec<<endl;
+            //tm结构体转化为timet
+        //setenv("TZ","UTC0",1);
+        //tzset();//设置时区为utc并且禁用夏令时，调用tzset更新环境变量
+        time_t tt=mktime(&t);
+        //cout<<tt<<endl;
+            //timet转换为chrono::system_clock::time_point
+        chrono::system_clock::time_point tp=chrono::system_clock::from_time_t(tt);
+        
+        //cout<<tp.time_since_epoch().count()<<endl;
+        
+            //检查是否存在毫秒
+        if(sss!="000")
+        {
+            int msec=stoi(sss);
+            tp+=Milliseconds(msec);
+        }
+        //else//为了转化为毫秒精度的chrono::system_clock::time_point,没有就设置为0
+        //{
+        ///    tp+=Milliseconds(0);
+        //}
+        return tp;
+    }
+    string& stt::time::DateTime::timePointToStr(const chrono::system_clock::time_point &tp,string &timeStr,const string &format)
+    {
+        string cformat=format;
+        //先把yyyy格式转化为puttime接受的形式
+        auto pos=cformat.find("yyyy");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,4,"%Y");
+        }
+        pos=cformat.find("mm");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%m");
+        }
+        pos=cformat.find("dd");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%d");
+        }
+        pos=cformat.find("hh");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%H");
+        }
+        pos=cformat.find("mi");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%M");
+        }
+        pos=cformat.find("ss");
+        if(pos!=string::npos)
+        {
+            cformat.replace(pos,2,"%S");
+        }
+
+        
+        time_t t_tp;
+        t_tp=chrono::system_clock::to_time_t(tp);
+        //to_time_t得到的时间可能处理不了久远的、时间 自己写实现办法 转化为timet
+        //string a="1970-01-01T00:00:00";
+        //chrono::system_clock::time_point b=DateTime::strToTimePoint(a);
+        
+       //cout<<b.time_since_epoch().count()<<endl;
+       //cout<<tp.time_since_epoch().count()<<endl;
+
+          //  s=chrono::duration_cast<chrono::duration<uint64_t>>(b-tp);
+          //  t_tp=0-s.count();
+
+        //
+
+        tm tm_tp;
+        localtime_r(&t_tp,&tm_tp);
+        ostringstream oss;
+        oss<<put_time(&tm_tp,cformat.c_str());
+        timeStr=oss.str();
+        //检查是否有毫秒
+        pos=timeStr.find("sss");
+        if(pos!=string::npos)
+        {
+            Milliseconds milliseconds=chrono::duration_cast<Milliseconds>(tp.time_since_epoch())%1000;
+            oss.str("");
+            oss<<setfill('0')<<setw(3)<<milliseconds.count();
+            timeStr.replace(pos,3,oss.str());
+        }
+        return timeStr;
+    }
+    string& stt::time::DateTime::getTime(string &timeStr,const string &format)
+    {
+        chrono::time_point<chrono::system_clock> now=chrono::system_clock::now();
+        timePointToStr(now,timeStr,format);
+        return timeStr;
+    }
+    Duration& stt::time::DateTime::dTOD(const Milliseconds& d1,Duration &D1)
+    {
+        uint64_t msec=d1.count();
+        D1.day=msec/(24*60*60*1000);
+        msec=msec%(24*60*60*1000);
+        D1.hour=msec/(60*60*1000);
+        msec=msec%(60*60*1000);
+        D1.min=msec/(60*1000);
+        msec=msec%(60*1000);
+        D1.sec=msec/(1000);
+        msec=msec%(1000);
+        D1.msec=msec;
+        return D1;
+    }
+    Milliseconds& stt::time::DateTime::DTOd(const Duration &D1,Milliseconds& d1)
+    {
+        uint64_t msec=0;
+        msec+=static_cast<uint64_t>(D1.day)*86400000;
+        msec+=static_cast<uint64_t>(D1.hour)*60*60*1000;
+        msec+=static_cast<uint64_t>(D1.min)*60*1000;
+        msec+=static_cast<uint64_t>(D1.sec)*1000;
+        msec+=D1.msec;
+        d1=Milliseconds(msec);
+        return d1;
+    }
+    bool stt::time::DateTime::convertFormat(string &timeStr,const string &oldFormat,const string &newFormat)
+    {
+        string str=newFormat;
+        auto pos1=oldFormat.find("yyyy");
+        auto pos2=str.find("yyyy");
+        if(pos1!=string::npos)//新字符串比起旧的缺失了不要紧 如果新的比起旧的新加了 那就是缺少数据 会导致字符串数据不完整 直接报错就行了
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,4,timeStr.substr(pos1,4));
+        }
+        else
+            return false;
+        pos1=oldFormat.find("mm");
+        pos2=str.find("mm");
+        if(pos1!=string::npos)
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,2,timeStr.substr(pos1,2));
+        }
+        else
+            return false;
+        pos1=oldFormat.find("dd");
+        pos2=str.find("dd");
+        if(pos1!=string::npos)
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,2,timeStr.substr(pos1,2));
+        }
+        else
+            return false;
+        pos1=oldFormat.find("hh");
+        pos2=str.find("hh");
+        if(pos1!=string::npos)
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,2,timeStr.substr(pos1,2));
+        }
+        else
+            return false;
+        pos1=oldFormat.find("mi");
+        pos2=str.find("mi");
+        if(pos1!=string::npos)
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,2,timeStr.substr(pos1,2));
+        }
+        else
+            return false;
+        pos1=oldFormat.find("ss");
+        pos2=str.find("ss");
+        if(pos1!=string::npos)
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,2,timeStr.substr(pos1,2));
+        }
+        else
+            return false;
+        pos1=oldFormat.find("sss");
+        pos2=str.find("sss");
+        if(pos1!=string::npos)
+        {
+            if(pos2!=string::npos)
+                str.replace(pos2,3,timeStr.substr(pos1,3));
+        }
+        else
+            return false;
+        timeStr=str;
+        return true;
+    }
+    Duration& stt::time::DateTime::calculateTime(const string &time1,const string &time2,Duration &result,const string &format1,const string &format2)
+    {
+        Milliseconds dt;
+        chrono::system_clock::time_point t1=strToTimePoint(time1,format1);
+        chrono::system_clock::time_point t2=strToTimePoint(time2,format2);
+        dt=chrono::duration_cast<Milliseconds>(t1-t2);
+        dTOD(dt,result);
+        return result;
+    }
+    string& stt::time::DateTime::calculateTime(const string &time1,const Duration &time2,string &result,const string &am,const string &format1,const string &format2)
+    {
+        chrono::system_clock::time_point t1=strToTimePoint(time1,format1);
+        Milliseconds t2;
+        DTOd(time2,t2);
+        chrono::system_clock::time_point t3;
+        if(am=="+")
+            t3=t1+t2;
+        else
+            t3=t1-t2;
+        time_t t_tp=chrono::system_clock::to_time_t(t3);
+        timePointToStr(t3,result,format2);
+        return result;
+    }
+    bool stt::time::DateTime::startTiming()
+    {
+        if(isStart())
+            return false;
+        flag=true;
+        start=chrono::steady_clock::now();
+        return true;
+    }
+    Duration stt::time::DateTime::endTiming()
+    {
+        if(!isStart())
+        {
+            dt.day=-1;
+            dt.hour=-1;
+            dt.min=-1;
+            dt.sec=-1;
+            dt.msec=-1;
+            return dt;
+        }
+        end=chrono::steady_clock::now();
+        dTOD(chrono::duration_cast<Milliseconds>(end-start),dt);
+        flag=false;
+        return dt;
+    }
+    Duration stt::time::DateTime::checkTime()
+    {
+        if(!isStart())
+        {
+            dt.day=-1;
+            dt.hour=-1;
+            dt.min=-1;
+            dt.sec=-1;
+            dt.msec=-1;
+            return dt;
+        }
+        end=chrono::steady_clock::now();
+        dTOD(chrono::duration_cast<Milliseconds>(end-start),dt);
+        return dt;
+    }
+    bool stt::time::DateTime::compareTime(const string &time1,const string &time2,const string &format1,const string &format2)
+    {
+        auto t1=strToTimePoint(time1,format1);
+        auto t2=strToTimePoint(time2,format2);
+        if(t1.time_since_epoch()>=t2.time_since_epoch())
+            return true;
+        else
+            return false;
+    }
+
+    stt::file::LogFile::~LogFile()
+    {
+        consumerGuard=false;
+        //queueCV.notify_all();
+        uint64_t one=1;
+        if(::write(wakeFD,&one,sizeof(one))<0)
+            perror("log eventfd write() fail");
+        if(consumerThread.joinable())
+            consumerThread.join();//消费者退出前会写完队列里剩下的日志
+        delete binQueue.exchange(nullptr);
+        ::close(wakeFD);
+        lock_guard<mutex> lock(writeMutex);
+        if(logFD>=0)
+        {
+            if(syncPolicy!=(int)LogSyncPolicy::NEVER)
+                fdatasync(logFD);
+            ::close(logFD);
+            logFD=-1;
+        }
+    }
+    //每批最多攒这么多行日志 用一次writev写入（不能超过IOV_MAX）
+    static constexpr size_t logBatchLines=256;
+    //空闲后先自旋这么多轮（每轮让出一次CPU）再睡眠
+    static constexpr int logSpinRounds=64;
+    //INFO以外的级别在日志内容前加上标记
+    static const char *logLevelTag(const stt::file::LogLevel &level)
+    {
+        switch(level)
+        {
+        case stt::file::LogLevel::TRACE:return "[TRACE] ";
+        case stt::file::LogLevel::DEBUG:return "[DEBUG] ";
+        case stt::file::LogLevel::WARN:return "[WARN] ";
+        case stt::file::LogLevel::ERROR:return "[ERROR] ";
+        default:return "";
+        }
+    }
+    //本地时间的日期 用来判断按天轮转
+    static int logDay(const time_t &t)
+    {
+        struct tm tmv;
+        localtime_r(&t,&tmv);
+        return (tmv.tm_year+1900)*1000+tmv.tm_yday;
+    }
+    std::atomic<uint64_t> stt::file::LogFile::nextInstanceId{1};
+    stt::file::LogFile::ThreadRing *stt::file::LogFile::threadRing()
+    {
+        //按对象的实例id找本线程的暂存队列 不用对象地址 避免析构后新对象复用地址拿到旧队列
+        struct Cache
+        {
+            uint64_t id=0;
+            ThreadRing *ring=nullptr;
+        };
+        thread_local Cache last;
+        if(last.id==instanceId)
+            return last.ring;
+        thread_local unordered_map<uint64_t,shared_ptr<ThreadRing>> mine;
+        auto &ring=mine[instanceId];
+        if(ring==nullptr)
+        {
+            ring=make_shared<ThreadRing>(ringCapacity);
+            ring->thread=this_thread::get_id();
+            lock_guard<mutex> lock(ringMutex);
+            rings.push_back(ring);
+            ringsChanged=true;
+        }
+        last.id=instanceId;
+        last.ring=ring.get();
+        return last.ring;
+    }
+    bool stt::file::LogFile::pushEntry(string &&content)
+    {
+        ThreadRing *ring=threadRing();
+        LogEntry e;
+        e.timestamp=chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+        e.content=std::move(content);
+        //计数只有本线程写 不需要原子加
+        if(!ring->queue.push(std::move(e)))
+        {
+            ring->dropped.store(ring->dropped.load(memory_order_relaxed)+1,memory_order_relaxed);
+            return false;
+        }
+        ring->written.store(ring->written.load(memory_order_relaxed)+1,memory_order_relaxed);
+        notifyConsumer();
+        return true;
+    }
+    void stt::file::LogFile::formatEntry(const LogEntry &e,string &line,string &time)
+    {
+        timePointToStr(chrono::system_clock::time_point(chrono::duration_cast<chrono::system_clock::duration>(chrono::nanoseconds(e.timestamp))),time,timeFormat);
+        line=time;
+        line+=contentFormat;
+        line+=e.content;
+        line+='\n';
+    }
+    void stt::file::LogFile::retireRings()
+    {
+        //线程退出后它的thread_local引用被释放 只剩rings和消费者手里的两份 队列也空了就回收
+        lock_guard<mutex> lock(ringMutex);
+        if(ringsChanged)//消费者手里的快照不是最新的 引用计数对不上 下次再回收
+            return;
+        for(size_t ii=0;ii<rings.size();)
+        {
+            if(rings[ii].use_count()<=2&&rings[ii]->queue.approx_size()==0)
+            {
+                retiredWritten+=rings[ii]->written.load();
+                retiredDropped+=rings[ii]->dropped.load();
+                rings[ii]=rings.back();
+                rings.pop_back();
+                ringsChanged=true;
+            }
+            else
+                ii++;
+        }
+    }
+    std::vector<stt::file::LogThreadStat> stt::file::LogFile::getThreadStats()
+    {
+        vector<LogThreadStat> stats;
+        lock_guard<mutex> lock(ringMutex);
+        for(auto &ring:rings)
+        {
+            LogThreadStat st;
+            st.thread=ring->thread;
+            st.written=ring->written.load(memory_order_relaxed);
+            st.dropped=ring->dropped.load(memory_order_relaxed);
+            stats.push_back(st);
+        }
+        return stats;
+    }
+    uint64_t stt::file::LogFile::getDroppedCount()
+    {
+        lock_guard<mutex> lock(ringMutex);
+        uint64_t total=retiredDropped;
+        for(auto &ring:rings)
+            total+=ring->dropped.load(memory_order_relaxed);
+        return total;
+    }
+    void stt::file::LogFile::consumer()
+    {
+        vector<string> batch(logBatchLines);//行缓冲反复复用 不用每行重新分配
+        vector<LogEntry> entries(logBatchLines);
+        vector<LogRecord> records(logBatchLines);
+        //(时间戳,下标) 下标小于logBatchLines的是文本日志 否则是二进制记录
+        vector<pair<int64_t,size_t>> order;
+        order.reserve(logBatchLines);
+        vector<shared_ptr<ThreadRing>> local;
+        size_t start=0;
+        int idle=0;
+        string time;
+        while(1)
+        {
+            //先读标志再取队列 这样退出前已经入队的日志都能写完
+            bool stop=!consumerGuard;
+            if(ringsChanged.exchange(false))
+            {
+                lock_guard<mutex> lock(ringMutex);
+                local=rings;
+            }
+            //轮流从各线程的暂存队列取 每轮每个队列最多取一小段 一个线程写得多也不会挤掉别的线程
+            size_t n=0;
+            bool progress=!local.empty();
+            while(n<logBatchLines&&progress)
+            {
+                progress=false;
+                for(size_t kk=0;kk<local.size()&&n<logBatchLines;kk++)
+                {
+                    auto &queue=local[(start+kk)%local.size()]->queue;
+                    for(int cc=0;cc<32&&n<logBatchLines&&queue.pop(entries[n]);cc++)
+                    {
+                        n++;
+                        progress=true;
+                    }
+                }
+            }
+            start++;
+            //二进制日志在这里才格式化 时间用记录里的原始时间戳
+            size_t m=0;
+            system::MPSCQueue<LogRecord> *q=binQueue.load(std::memory_order_acquire);
+            if(q!=nullptr)
+                m=q->pop_bulk(records.data(),logBatchLines-n);
+            size_t total=n+m;
+            if(total>0)
+            {
+                //按时间戳合并各线程的日志
+                order.clear();
+                for(size_t ii=0;ii<n;ii++)
+                    order.emplace_back(entries[ii].timestamp,ii);
+                for(size_t ii=0;ii<m;ii++)
+                    order.emplace_back(records[ii].timestamp,logBatchLines+ii);
+                std::stable_sort(order.begin(),order.end(),[](const pair<int64_t,size_t> &a,const pair<int64_t,size_t> &b){return a.first<b.first;});
+                for(size_t ii=0;ii<total;ii++)
+                {
+                    if(order[ii].second<logBatchLines)
+                        formatEntry(entries[order[ii].second],batch[ii],time);
+                    else
+                        formatRecord(records[order[ii].second-logBatchLines],batch[ii],time);
+                }
+                writeBatch(batch,total);
+            }
+            if(total==logBatchLines)//队列里可能还有 接着取
+                continue;
+            if(stop)
+                break;
+            if(total>0)
+            {
+                idle=0;
+                continue;
+            }
+            //空闲：先短暂自旋 突发日志不用付出唤醒的代价
+            if(++idle<logSpinRounds)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+            idle=0;
+            retireRings();
+            //先标记睡眠再检查一次队列 和生产者的notifyConsumer配对
+            sleeping.store(true);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            bool pending=ringsChanged.load()||!consumerGuard;
+            for(auto &ring:local)
+                pending=pending||ring->queue.approx_size()>0;
+            q=binQueue.load(std::memory_order_acquire);
+            if(pending||(q!=nullptr&&q->approx_size()>0))
+            {
+                sleeping.store(false);
+                continue;
+            }
+            struct pollfd pfd;
+            pfd.fd=wakeFD;
+            pfd.events=POLLIN;
+            ::poll(&pfd,1,1000);
+            uint64_t count;
+            if(::read(wakeFD,&count,sizeof(count))<0){}
+            sleeping.store(false);
+        }
+    }
+    void stt::file::LogFile::writeBatch(vector<string> &batch,const size_t &n)
+    {
+        struct iovec iov[logBatchLines];
+        for(size_t ii=0;ii<n;ii++)
+        {
+            iov[ii].iov_base=batch[ii].data();
+            iov[ii].iov_len=batch[ii].size();
+        }
+        lock_guard<mutex> lock(writeMutex);
+        if(logFD<0)//没有打开日志文件 丢弃
+            return;
+        size_t bytes=0;
+        for(size_t ii=0;ii<n;ii++)
+            bytes+=iov[ii].iov_len;
+        if(rotateBytes>0||rotateDaily)
+        {
+            string now;
+            getTime(now,ISO8086A);
+            if((rotateBytes>0&&segmentBytes>0&&segmentBytes+bytes>rotateBytes)||(rotateDaily&&logDay(::time(nullptr))!=segmentDay))
+            {
+                rotate(now);
+                if(logFD<0)
+                    return;
+            }
+            if(segmentFirst.empty())
+                segmentFirst=now;
+            segmentLast=now;
+        }
+        segmentBytes+=bytes;
+        size_t idx=0;
+        while(idx<n)
+        {
+            ssize_t ret=::writev(logFD,iov+idx,n-idx);
+            if(ret<0)
+            {
+                if(errno==EINTR)
+                    continue;
+                perror("log writev() fail");
+                return;
+            }
+            //处理部分写入（磁盘满、被信号打断等）
+            size_t written=ret;
+            while(idx<n&&written>=iov[idx].iov_len)
+            {
+                written-=iov[idx].iov_len;
+                idx++;
+            }
+            if(idx<n)
+            {
+                iov[idx].iov_base=(char*)iov[idx].iov_base+written;
+                iov[idx].iov_len-=written;
+            }
+        }
+        int policy=syncPolicy;
+        if(policy==(int)LogSyncPolicy::PER_BATCH)
+        {
+            fdatasync(logFD);
+        }
+        else if(policy==(int)LogSyncPolicy::INTERVAL)
+        {
+            auto now=std::chrono::steady_clock::now();
+            if(now-lastSync>=std::chrono::milliseconds(syncIntervalMs.load()))
+            {
+                fdatasync(logFD);
+                lastSync=now;
+            }
+        }
+    }
+    bool stt::file::LogFile::reopenLogFD()
+    {
+        //调用者持有writeMutex
+        if(logFD>=0)
+            ::close(logFD);
+        logFD=::open(getFileName().c_str(),O_WRONLY|O_APPEND|O_CREAT|O_CLOEXEC,0664);
+        if(logFD<0)
+        {
+            perror("log open() fail");
+            return false;
+        }
+        //当前分段的大小和日期 文件里已有的内容按最后修改时间算日期
+        struct stat st;
+        if(fstat(logFD,&st)==0&&st.st_size>0)
+        {
+            segmentBytes=st.st_size;
+            segmentDay=logDay(st.st_mtime);
+            if(segmentFirst.empty())
+                segmentFirst="-";
+        }
+        else
+        {
+            segmentBytes=0;
+            segmentDay=logDay(::time(nullptr));
+            segmentFirst.clear();
+        }
+        return true;
+    }
+    void stt::file::LogFile::rotate(const string &now)
+    {
+        //调用者持有writeMutex 旧分段按轮转时间命名 yyyy-mm-ddThh:mi:ss -> yyyymmdd-hhmiss
+        string stamp;
+        for(auto &c:now)
+        {
+            if(c=='T')
+                stamp+='-';
+            else if(c!='-'&&c!=':')
+                stamp+=c;
+        }
+        string name=getFileName()+"."+stamp;
+        for(int ii=1;access(name.c_str(),F_OK)==0||access((name+".gz").c_str(),F_OK)==0;ii++)
+            name=getFileName()+"."+stamp+"-"+to_string(ii);
+        ::close(logFD);
+        logFD=-1;
+        if(::rename(getFileName().c_str(),name.c_str())!=0)
+        {
+            perror("log rename() fail");
+            reopenLogFD();
+            return;
+        }
+        //索引每行：分段文件名\t第一条日志时间\t最后一条日志时间
+        string line=name+"\t"+(segmentFirst.empty()?"-":segmentFirst)+"\t"+(segmentLast.empty()?now:segmentLast)+"\n";
+        int indexFD=::open((getFileName()+".index").c_str(),O_WRONLY|O_APPEND|O_CREAT|O_CLOEXEC,0664);
+        if(indexFD>=0)
+        {
+            if(::write(indexFD,line.data(),line.size())<0)
+                perror("log index write() fail");
+            ::close(indexFD);
+        }
+        else
+            perror("log index open() fail");
+        segmentFirst.clear();
+        segmentLast.clear();
+        reopenLogFD();
+        if(compressSegments)
+        {
+            //gzip压缩完会删除原文件 索引里保留原名 清理时两个名字都删
+            std::thread([name]()->void
+            {
+                pid_t pid;
+                char *argv[]={(char*)"gzip",(char*)"-f",(char*)name.c_str(),nullptr};
+                if(posix_spawnp(&pid,"gzip",nullptr,nullptr,argv,environ)==0)
+                    waitpid(pid,nullptr,0);
+            }).detach();
+        }
+    }
+    void stt::file::LogFile::setRotation(const size_t &maxBytes,const bool &daily,const bool &compress)
+    {
+        lock_guard<mutex> lock(writeMutex);
+        rotateBytes=maxBytes;
+        rotateDaily=daily;
+        compressSegments=compress;
+    }
+    int stt::file::LogFile::purgeSegments(const string &date)
+    {
+        lock_guard<mutex> lock(writeMutex);
+        string indexName=getFileName()+".index";
+        ifstream in(indexName);
+        if(!in.is_open())
+            return access(indexName.c_str(),F_OK)==0?-1:0;
+        string keep;
+        string line;
+        int deleted=0;
+        while(getline(in,line))
+        {
+            size_t p1=line.find('\t');
+            size_t p2=(p1==string::npos?string::npos:line.find('\t',p1+1));
+            if(p2==string::npos)
+            {
+                keep+=line+"\n";
+                continue;
+            }
+            string name=line.substr(0,p1);
+            //最后一条日志早于date 整个分段都在删除范围内
+            if(!compareTime(line.substr(p2+1),date,ISO8086A,timeFormat))
+            {
+                ::unlink(name.c_str());
+                ::unlink((name+".gz").c_str());
+                deleted++;
+            }
+            else
+                keep+=line+"\n";
+        }
+        in.close();
+        if(deleted==0)
+            return 0;
+        //索引很小 整个重写
+        string tempName=indexName+".temp";
+        int fd=::open(tempName.c_str(),O_WRONLY|O_CREAT|O_TRUNC|O_CLOEXEC,0664);
+        if(fd<0)
+        {
+            perror("log index open() fail");
+            return deleted;
+        }
+        if(::write(fd,keep.data(),keep.size())<0)
+            perror("log index write() fail");
+        ::close(fd);
+        ::rename(tempName.c_str(),indexName.c_str());
+        return deleted;
+    }
+    bool stt::file::LogFile::openFile(const string &fileName,const string &timeFormat,const string &contentFormat)
+    {
+        this->timeFormat=timeFormat;
+        this->contentFormat=contentFormat;
+        if(!File::openFile(fileName,true,0,0,0664))
+            return false;
+        lock_guard<mutex> lock(writeMutex);
+        lastSync=std::chrono::steady_clock::now();
+        return reopenLogFD();
+    }
+    void stt::file::LogFile::writeLog(const string &data)
+    {
+        //string content;
+        //getTime(content,timeFormat);
+        //content+=contentFormat+data;
+        
+        if(!shouldLog(LogLevel::INFO))
+            return;
+        //{
+        //    std::lock_guard<std::mutex> lock(queueMutex);
+            pushEntry(string(data));
+        //}
+        //queueCV.notify_all();
+        /*
+        string content;
+        getTime(content,timeFormat);
+        content+=contentFormat+data;
+        return appendLine(content);
+        */
+    }
+    void stt::file::LogFile::writeLog(const string &data,const LogLevel &level)
+    {
+        if(!shouldLog(level))
+            return;
+        const char *tag=logLevelTag(level);
+        if(*tag=='\0')
+            pushEntry(string(data));
+        else
+            pushEntry(tag+data);
+    }
+    bool stt::file::LogFile::enableBinaryLog(const size_t &queueCap)
+    {
+        if(binQueue.load()!=nullptr)
+            return true;
+        if(queueCap<2||(queueCap&(queueCap-1))!=0)
+            return false;
+        auto *q=new system::MPSCQueue<LogRecord>(queueCap);
+        system::MPSCQueue<LogRecord> *expected=nullptr;
+        if(!binQueue.compare_exchange_strong(expected,q))
+            delete q;//别的线程已经开启
+        return true;
+    }
+    void stt::file::LogFile::formatRecord(const LogRecord &r,string &line,string &time)
+    {
+        timePointToStr(chrono::system_clock::time_point(chrono::duration_cast<chrono::system_clock::duration>(chrono::nanoseconds(r.timestamp))),time,timeFormat);
+        line=time;
+        line+=contentFormat;
+        line+=logLevelTag(r.fmt->level);
+        //按顺序把{}替换成参数 多出来的{}原样保留
+        const char *p=r.fmt->format;
+        int argi=0;
+        char num[32];
+        while(*p!='\0')
+        {
+            if(p[0]=='{'&&p[1]=='}'&&argi<r.argc)
+            {
+                auto &a=r.args[argi];
+                switch(r.types[argi])
+                {
+                case LogRecord::INT:line.append(num,std::to_chars(num,num+sizeof(num),a.i).ptr-num);break;
+                case LogRecord::UINT:line.append(num,std::to_chars(num,num+sizeof(num),a.u).ptr-num);break;
+                case LogRecord::DOUBLE:line.append(num,snprintf(num,sizeof(num),"%g",a.d));break;
+                case LogRecord::STRING:line.append(r.text+a.s.off,a.s.len);break;
+                case LogRecord::BOOL:line+=(a.u?"true":"false");break;
+                case LogRecord::CHAR:line+=(char)a.i;break;
+                }
+                argi++;
+                p+=2;
+            }
+            else
+                line+=*p++;
+        }
+        line+='\n';
+    }
+    bool stt::file::LogFile::closeFile(const bool &del)
+    {
+        {
+            lock_guard<mutex> lock(writeMutex);
+            if(logFD>=0)
+            {
+                if(syncPolicy!=(int)LogSyncPolicy::NEVER)
+                    fdatasync(logFD);
+                ::close(logFD);
+                logFD=-1;
+            }
+        }
+        timeFormat.clear();
+        contentFormat.clear();
+        return File::closeFile(del);
+    }
+    bool stt::file::LogFile::clearLog()
+    {
+        //重写文件期间停止追加 完成后文件已经换成新的 需要重新打开
+        lock_guard<mutex> lock(writeMutex);
+        bool ok=File::deleteAll();
+        if(isOpen())
+            reopenLogFD();
+        return ok;
+    }
+    bool stt::file::LogFile::deleteLogByTime(const string &date1,const string &date2)
+    {
+        if(!isOpen())
+            return false;
+        lock_guard<mutex> lock(writeMutex);
+        int linePos=1;
+        string data;
+        string time;
+        int timeSize=timeFormat.size();
+        if(!lockMemory())
+            return false;
+        while(readLineC(data,linePos))
+        {
+            time=data.substr(0,timeSize);
+            if((date1=="1"||compareTime(time,date1,timeFormat,timeFormat)==true)&&(date2=="2"||compareTime(time,date2,timeFormat,timeFormat)==false))
+            {
+                deleteLineC(linePos);
+                unlockMemory(false);
+                linePos--;
+            }
+            linePos++;
+        }
+        //if(chee.owns_lock())
+        //    unlockMemory(true);
+        unique_lock<mutex> testlock(che,try_to_lock);
+        if(!testlock.owns_lock())
+            unlockMemory(true);
+        reopenLogFD();
+        return true;
+    }
+    
+    bool stt::data::CryptoUtil::encryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after)
+    {
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        if (!ctx) return false;
+        int len;
+        int ciphertext_len;
+        // 初始化加密操作
+        if (1 != EVP_EncryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, passwd, iv)) 
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            return false;
+        }
+        // 加密数据
+        if (1 != EVP_EncryptUpdate(ctx, after, &len, before, length))
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            return false;
+        }
+        ciphertext_len = len;
+        // 加密完成
+        if (1 != EVP_EncryptFinal_ex(ctx, after + len, &len)) 
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            return false;
+        }
+        ciphertext_len += len;
+        EVP_CIPHER_CTX_free(ctx);
+        return ciphertext_len;
+    }
+    bool stt::data::CryptoUtil::decryptSymmetric(const unsigned char *before,const size_t &length,const unsigned char *passwd,const unsigned char *iv,unsigned char *after)
+    {
+        EVP_CIPHER_CTX* ctx = EVP_CIPHER_CTX_new();
+        if (!ctx) return false;
+
+        int len;
+        int plaintext_len;
+
+        // 初始化解密操作
+        if (1 != EVP_DecryptInit_ex(ctx, EVP_aes_256_cbc(), nullptr, passwd, iv)) 
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            return false;
+        }
+
+        // 解密数据
+        if (1 != EVP_DecryptUpdate(ctx, after, &len, before, length)) 
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            return false;
+        }
+        plaintext_len = len;
+
+        // 解密完成
+        if (1 != EVP_DecryptFinal_ex(ctx, after + len, &len)) 
+        {
+            EVP_CIPHER_CTX_free(ctx);
+            return false;
+        }
+        plaintext_len += len;
+
+        EVP_CIPHER_CTX_free(ctx);
+        return plaintext_len;
+    }
+string& stt::data::CryptoUtil::sha1(const string &ori_str,string &result)
+{
+	unsigned char hash[SHA_DIGEST_LENGTH];
+	SHA1((unsigned char*)ori_str.c_str(),ori_str.length(),hash);
+    char hash1[SHA_DIGEST_LENGTH];
+    for(int i=0;i<SHA_DIGEST_LENGTH;i++)
+        hash1[i]=static_cast<char>(hash[i]);
+	result.assign(hash1,SHA_DIGEST_LENGTH);
+	return result;
+}
+string& stt::data::CryptoUtil::sha11(const string &ori_str,string &result)
+{
+	unsigned char hash[SHA_DIGEST_LENGTH];
+	SHA1((unsigned char*)ori_str.c_str(),ori_str.length(),hash);
+	char buffer[2*SHA_DIGEST_LENGTH+1];
+	buffer[2*SHA_DIGEST_LENGTH]=0;
+	for(int i=0;i<SHA_DIGEST_LENGTH;i++)
+	{
+		snprintf(buffer+i*2,3,"%02x",hash[i]);
+	}
+	result.assign(buffer);
+	return result;
+}
+string& stt::data::BitUtil::bitOutput(char input,string &result)
+{
+    result.clear();
+    for(int i=1;i<=8;i++)
+    {
+        if((input&'z'+6)=='z'+6)
+            result+='1';
+        else
+            result+='0';
+        input=input<<1;
+    }
+    return result;
+}
+string& stt::data::BitUtil::bitOutput(const string &input,string &result)
+{
+    result.clear();
+    for(char cc:input)
+    {
+        for(int i=1;i<=8;i++)
+        {
+            if((cc&'z'+6)=='z'+6)
+                result+='1';
+            else
+                result+='0';
+            cc=cc<<1;
+        }
+    }
+    return result;
+}
+char& stt::data::BitUtil::bitOutput_bit(char input,const int pos,char &result)
+{
+    input=input<<(pos-1);
+    if((input&'z'+6)=='z'+6)
+        result='1';
+    else
+        result='0';
+    return result;
+}
+unsigned long& stt::data::BitUtil::bitStrToNumber(const string &input,unsigned long &result)
+{
+    result=0;
+    int mul=input.length()-1;
+    for(const char &cc:input)
+    {
+        if(cc=='1')
+            result+=pow(2,mul);
+        mul--;
+    }
+    return result;
+}
+unsigned long& stt::data::BitUtil::bitToNumber(const string &input,unsigned long &result)
+{
+    string rr;
+    bitOutput(input,rr);
+    result=bitStrToNumber(rr,result);
+    return result;
+}
+char& stt::data::BitUtil::toBit(const string &input,char &result)
+{
+    int pos=0;
+    result='z'-122;
+    unsigned char cc;
+    for(const char &ii:input)
+    {
+        if(ii=='1')
+        {
+            cc='z'+6;
+            cc=cc>>(pos%8);
+            result=result|cc;
+        }
+        pos++;
+    }
+    return result;
+}
+string& stt::data::BitUtil::toBit(const string &input,string &result)
+{
+    result.clear();
+    int pos=0;
+    char bb='z'-122;
+    unsigned char cc;
+    for(const char &ii:input)
+    {
+        if(ii=='1')
+        {
+            cc='z'+6;
+            cc=cc>>pos;
+            bb=bb|cc;
+        }
+        pos++;
+        if(pos==8)
+        {
+            pos=0;
+            result+=bb;
+            bb='z'-122;
+        }
+    }
+    return result;
+}
+    long stt::data::RandomUtil::getRandomNumber(const long &a,const long &b)
+    {
+        random_device rd;
+        mt19937_64 generator(rd());
+        uniform_int_distribution<long long> dist(a,b);
+        return dist(generator);
+    }
+    string& stt::data::RandomUtil::getRandomStr_base64(string &str,const int &length)
+    {
+        str.clear();
+		// 定义包含可能字符的字符串
+    	const string characters = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz+/";
+
+    	// 设置随机数引擎和分布
+    	random_device rd;
+    	mt19937 generator(rd());
+    	uniform_int_distribution<int> distribution(0, characters.size() - 1);
+
+    	// 生成随机字符串
+    	
+    	for (int i = 1; i <=length-length%4; i++) //长度为randomNumber
+		{
+        	str += characters[distribution(generator)];
+    	}
+        for(int i=1;i<=length%4;i++)
+        {
+            str+='=';
+        }
+        return str;
+    }
+string& stt::data::RandomUtil::generateMask_4(string &mask)
+{
+    mask.clear();
+		// 定义包含可能字符的字符串
+    	const string characters = "01";
+        string bitStr;
+    	// 设置随机数引擎和分布
+    	random_device rd;
+    	mt19937 generator(rd());
+    	uniform_int_distribution<int> distribution(0, characters.size() - 1);
+
+    	// 生成随机字符串
+    	
+    	for (int i = 1; i <=32; i++) //长度为randomNumber
+		{
+        	bitStr += characters[distribution(generator)];
+    	}
+        BitUtil::toBit(bitStr,mask);
+        return mask;
+}
+unsigned long& stt::data::NetworkOrderUtil::htonl_ntohl_64(unsigned long &data)
+{
+    char swi;
+    for(int i=0;i<4;i++)
+    {
+        memcpy(&swi,(char*)&data+i,1);
+        memcpy((char*)&data+i,(char*)&data+7-i,1);
+        memcpy((char*)&data+7-i,&swi,1);
+    }
+    return data;
+}
+    string& stt::data::PrecisionUtil::getPreciesFloat(const float &number,const int &bit,string &str)
+    {
+        stringstream ss;
+        ss<<fixed<<setprecision(bit)<<number;
+        str=ss.str();
+        return str;
+    }
+    string& stt::data::PrecisionUtil::getPreciesDouble(const double &number,const int &bit,string &str)
+    {
+        stringstream ss;
+        ss<<fixed<<setprecision(bit)<<number;
+        str=ss.str();
+        return str;
+    }
+    float& stt::data::PrecisionUtil::getPreciesFloat(float &number,const int &bit)
+    {
+        number=round(number*pow(10,bit))/pow(10,bit);
+        return number;
+    }
+    double& stt::data::PrecisionUtil::getPreciesDouble(double &number,const int &bit)
+    {
+        number=round(number*pow(10,bit))/pow(10,bit);
+        return number;
+    }
+    float& stt::data::PrecisionUtil::getValidFloat(float &number,const int &bit)
+    {
+        int bitt=0;
+
+        while(((int)(number*pow(10,bitt))==0)&&bitt<=6)//如果是1以下的小数 确定位数
+        {
+            bitt++;
+        }
+
+        if(bitt==7)
+            return number;
+        if((int)number==0)
+            bitt=bitt+bit-1;//1以下的
+        else
+            bitt=bitt+bit;//1以上的
+        number=round(number*pow(10,bitt))/pow(10,bitt);
+        return number;
+    }
+
+    size_t stt::data::HttpStringUtil::get_split_str(const string_view& ori_str,string_view &str,const string_view &a,const string_view &b,const size_t &pos)
+    {
+        size_t aa;
+        size_t bb;
+        if(a=="")
+            aa=string::npos;
+        else
+            aa=ori_str.find(a,pos);
+        if(b=="")
+            bb=string::npos;
+        else
+            bb=ori_str.find(b,aa+1);
+        if(aa==string::npos&&bb==string::npos)
+        {
+                str="";
+                //return str;
+                return bb;
+        }
+        else if(aa==string::npos&&bb!=string::npos)
+        {
+                str=ori_str.substr(0,bb);
+                //return str;
+                return bb;
+        }
+        else if(aa!=string::npos&&bb==string::npos)
+        {
+                aa+=a.length();
+                str=ori_str.substr(aa);
+                //return str;
+                return bb;
+        }
+        aa+=a.length();
+        str=ori_str.substr(aa,bb-aa);
+        //return str;
+        return bb;
+    }
+    string_view& stt::data::HttpStringUtil::get_value_header(const string_view& ori_str,string_view &str,const string& name)
+    {
+        size_t ii=ori_str.find(name);
+	    if(ii==string::npos)
+	    {
+		    str="";
+		    return str;
+	    }
+		    get_split_str(ori_str,str,name+": ","\r\n");
+		    //del_space_str(str);
+		    return str;
+    }
+    string_view& stt::data::HttpStringUtil::get_value_str(const string_view& ori_str,string_view &str,const string& name)
+{
+    size_t ii=ori_str.find("?");
+    if(ii==string::npos)
+        ii=0;
+	ii=ori_str.find(name+"=",ii);
+	if(ii==string::npos)
+	{
+		str="";
+		return str;
+	}
+	//分两种情况，可能是最后一个，或者不是最后一个。&分隔开很关键
+	if(ori_str.find("&",ii)==string::npos)//最后一个
+	{
+		ii=ori_str.find("=",ii);
+		str=ori_str.substr(ii+1,ori_str.length()-ii-1);
+		//del_space_str(str);//去掉空格
+		return str;
+	}
+	else
+	{
+		get_split_str(ori_str,str,name+"=","&");
+		//del_space_str(str);
+		return str;
+	}
+}
+    string_view& stt::data::HttpStringUtil::get_location_str(const string_view& ori_str,string_view &str)
+{
+	auto pos1=ori_str.find("://");
+    if(pos1==string::npos)
+        pos1=0;
+    else
+    {
+        pos1=ori_str.find("/",pos1+3);
+    }
+
+    auto pos2=ori_str.find("?");
+
+    str=ori_str.substr(pos1,pos2-pos1);
+    return str;
+    
+}
+    string_view& stt::data::HttpStringUtil::getLocPara(const string_view &url,string_view &locPara)
+    {
+        auto pos1=url.find("://");
+        if(pos1==string::npos)
+            pos1=0;
+        else
+        {
+            pos1=url.find("/",pos1+3);
+        }
+        if(pos1==string::npos)
+        {
+            cerr<<"无效url"<<endl;
+            locPara="";
+            return locPara;
+        }
+        locPara=url.substr(pos1);
+        return locPara;
+    }
+    string_view& stt::data::HttpStringUtil::getPara(const string_view &url,string_view &para)
+    {
+        para="";
+        auto pos=url.find("?");
+        if(pos==string::npos)
+            return para;
+        para=url.substr(pos);
+        return para;
+    }
+
+
+    size_t stt::data::HttpStringUtil::get_split_str(const string_view& ori_str,string &str,const string_view &a,const string_view &b,const size_t &pos)
+    {
+        size_t aa;
+        size_t bb;
+        if(a=="")
+            aa=string::npos;
+        else
+            aa=ori_str.find(a,pos);
+        if(b=="")
+            bb=string::npos;
+        else
+            bb=ori_str.find(b,aa+1);
+        if(aa==string::npos&&bb==string::npos)
+        {
+                str="";
+                //return str;
+                return bb;
+        }
+        else if(aa==string::npos&&bb!=string::npos)
+        {
+                str=ori_str.substr(0,bb);
+                //return str;
+                return bb;
+        }
+        else if(aa!=string::npos&&bb==string::npos)
+        {
+                aa+=a.length();
+                str=ori_str.substr(aa);
+                //return str;
+                return bb;
+        }
+        aa+=a.length();
+        str=ori_str.substr(aa,bb-aa);
+        //return str;
+        return bb;
+    }
+    string& stt::data::HttpStringUtil::get_value_header(const string& ori_str,string &str,const string& name)
+    {
+        size_t ii=ori_str.find(name);
+	    if(ii==string::npos)
+	    {
+		    str="";
+		    return str;
+	    }
+		    get_split_str(ori_str,str,name+": ","\r\n");
+		    //del_space_str(str);
+		    return str;
+    }
+    string& stt::data::HttpStringUtil::get_value_str(const string& ori_str,string &str,const string& name)
+{
+    size_t ii=ori_str.find("?");
+    if(ii==string::npos)
+        ii=0;
+	ii=ori_str.find(name+"=",ii);
+	if(ii==string::npos)
+	{
+		str="";
+		return str;
+	}
+	//分两种情况，可能是最后一个，或者不是最后一个。&分隔开很关键
+	if(ori_str.find("&",ii)==string::npos)//最后一个
+	{
+		ii=ori_str.find("=",ii);
+		str=ori_str.substr(ii+1,ori_str.length()-ii-1);
+		//del_space_str(str);//去掉空格
+		return str;
+	}
+	else
+	{
+		get_split_str(ori_str,str,name+"=","&");
+		//del_space_str(str);
+		return str;
+	}
+}
+    string& stt::data::HttpStringUtil::get_location_str(const string& ori_str,string &str)
+{
+	auto pos1=ori_str.find("://");
+    if(pos1==string::npos)
+        pos1=0;
+    else
+    {
+        pos1=ori_str.find("/",pos1+3);
+    }
+
+    auto pos2=ori_str.find("?");
+
+    str=ori_str.substr(pos1,pos2-pos1);
+    return str;
+    
+}
+    string& stt::data::HttpStringUtil::getLocPara(const string &url,string &locPara)
+    {
+        auto pos1=url.find("://");
+        if(pos1==string::npos)
+            pos1=0;
+        else
+        {
+            pos1=url.find("/",pos1+3);
+        }
+        if(pos1==string::npos)
+        {
+            cerr<<"无效url"<<endl;
+            locPara="";
+            return locPara;
+        }
+        locPara=url.substr(pos1);
+        return locPara;
+    }
+    string& stt::data::HttpStringUtil::getPara(const string &url,string &para)
+    {
+        para="";
+        auto pos=url.find("?");
+        if(pos==string::npos)
+            return para;
+        para=url.substr(pos);
+        return para;
+    }
+
+    string& stt::data::HttpStringUtil::getIP(const string &url,string &IP)
+    {
+        HttpStringUtil::get_split_str(url,IP,"//",":");
+        return IP;
+    }
+    int& stt::data::HttpStringUtil::getPort(const string &url,int &port)
+    {
+        auto pos=url.find(":");
+        string pport;
+        HttpStringUtil::get_split_str(url,pport,":","/",pos+1);
+        return stt::data::NumberStringConvertUtil::toInt(pport,port);
+    }
+    string stt::data::HttpStringUtil::createHeader(const string& first,const string& second)
+	{
+		string cf=first+": "+second+"\r\n";
+		return cf;
+	}
+string& stt::data::WebsocketStringUtil::transfer_websocket_key(string &str)
+{
+    str=str+"258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    string b="";
+    CryptoUtil::sha1(str,b);
+    str=EncodingUtil::base64_encode(b);
+    return str;
+}
+    int& stt::data::NumberStringConvertUtil::toInt(const string_view&ori_str,int &result,const int &i)
+    {
+        /*
+        try
+        {
+            result=stoi(ori_str);
+        }
+        catch(...)
+        {
+            result=i;
+            return result;
+        }
+        return result;
+        */
+        if(from_chars(ori_str.data(),ori_str.data()+ori_str.length(),result).ec!=errc())
+            result=i;
+        return result;
+    }
+	long& stt::data::NumberStringConvertUtil::toLong(const string_view&ori_str,long &result,const long &i)
+    {
+        /*
+        try
+        {
+            result=stol(ori_str);
+        }
+        catch(...)
+        {
+            result=i;
+            return result;
+        }
+        return result;
+        */
+        if(from_chars(ori_str.data(),ori_str.data()+ori_str.length(),result).ec!=errc())
+            result=i;
+        return result;
+    }
+	float& stt::data::NumberStringConvertUtil::toFloat(const string&ori_str,float &result,const float &i)
+    {
+        
+        try
+        {
+            result=stof(ori_str);
+        }
+        catch(...)
+        {
+            result=i;
+            return result;
+        }
+        return result;
+        
+    }
+	double& stt::data::NumberStringConvertUtil::toDouble(const string&ori_str,double &result,const double &i)
+    {
+        
+        try
+        {
+            result=stod(ori_str);
+        }
+        catch(...)
+        {
+            result=i;
+            return result;
+        }
+        return result;
+
+    }
+    bool& stt::data::NumberStringConvertUtil::toBool(const string_view&ori_str,bool &result)
+    {
+        
+        if(ori_str=="true"||ori_str=="TRUE"||ori_str=="True")
+        {
+            result=true;
+            return result;
+        }
+        else
+        {
+            result=false;
+            return result;
+        }
+
+    }
+    
+    
+    
+    
+    
+string& stt::data::NumberStringConvertUtil::strto16(const string &ori_str,string &result)//字符串转化为16进制字符串
+{
+    int size=ori_str.length();
+    const char *buffer1;
+    char buffer2[2*size+1];
+    buffer2[2*size]=0;
+    buffer1=ori_str.c_str();
+    for(int i=0;i<size;i++)
+        snprintf(buffer2+i*2,3,"%02x",buffer1[i]);
+    result.assign(buffer2);
+    return result;
+}
+    int& stt::data::NumberStringConvertUtil::str16toInt(const string_view&ori_str,int &result,const int &i)
+    {
+        int bit=ori_str.length()-1;
+        result=0;
+        for(auto &ii:ori_str)
+        {
+            if(ii=='0')
+                result+=0*pow(16,bit);
+            else if(ii=='1')
+                result+=1*pow(16,bit);
+            else if(ii=='2')
+                result+=2*pow(16,bit);
+            else if(ii=='3')
+                result+=3*pow(16,bit);
+            else if(ii=='4')
+                result+=4*pow(16,bit);
+            else if(ii=='5')
+                result+=5*pow(16,bit);
+            else if(ii=='6')
+                result+=6*pow(16,bit);
+            else if(ii=='7')
+                result+=7*pow(16,bit);
+            else if(ii=='8')
+                result+=8*pow(16,bit);
+            else if(ii=='9')
+                result+=9*pow(16,bit);
+            else if(ii=='a'||ii=='A')
+                result+=10*pow(16,bit);
+            else if(ii=='b'||ii=='B')
+                result+=11*pow(16,bit);
+            else if(ii=='c'||ii=='C')
+                result+=12*pow(16,bit);
+            else if(ii=='d'||ii=='D')
+                result+=13*pow(16,bit);
+            else if(ii=='e'||ii=='E')
+                result+=14*pow(16,bit);
+            else if(ii=='f'||ii=='F')
+                result+=15*pow(16,bit);
+            else
+            {
+                result=i;
+                break;
+            }
+            bit--;
+        }
+        return result;
+    }
+    // Function to encode a string using Base64
+std::string stt::data::EncodingUtil::base64_encode(const std::string &input) {
+    BIO *bio, *b64;
+    BUF_MEM *bufferPtr;
+
+    b64 = BIO_new(BIO_f_base64());
+    bio = BIO_new(BIO_s_mem());
+    bio = BIO_push(b64, bio);
+
+    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL); // Ignore newlines
+    BIO_write(bio, input.c_str(), input.length());
+    BIO_flush(bio);
+    BIO_get_mem_ptr(bio, &bufferPtr);
+
+    std::string encoded_data(bufferPtr->data, bufferPtr->length);
+    BIO_free_all(bio);
+    return encoded_data;
+}
+
+// Function to decode a Base64 encoded string
+std::string stt::data::EncodingUtil::base64_decode(const std::string &input) {
+    BIO *bio, *b64;
+    char *buffer = (char *)malloc(input.length());
+    memset(buffer, 0, input.length());
+
+    b64 = BIO_new(BIO_f_base64());
+    bio = BIO_new_mem_buf(input.c_str(), input.length());
+    bio = BIO_push(b64, bio);
+
+    BIO_set_flags(bio, BIO_FLAGS_BASE64_NO_NL); // Ignore newlines
+    int decoded_length = BIO_read(bio, buffer, input.length());
+    std::string decoded_data(buffer, decoded_length);
+    BIO_free_all(bio);
+    free(buffer);
+
+    return decoded_data;
+}
+
+
+
+string& stt::data::EncodingUtil::maskCalculate(string &data,const string &mask)
+{
+    const char *m=mask.data();
+    int ii=0;
+    for(char &cc:data)
+    {
+        cc=cc^m[ii%4];
+        ii++;
+    }
+    return data;
+}
+string& stt::data::EncodingUtil::transfer_websocket_key(string &str)
+{
+    str=str+"258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+    string b="";
+    CryptoUtil::sha1(str,b);
+    str=base64_encode(b);
+    return str;
+}
+string& stt::data::EncodingUtil::generateMask_4(string &mask)
+{
+    mask.clear();
+		// 定义包含可能字符的字符串
+    	const string characters = "01";
+        string bitStr;
+    	// 设置随机数引擎和分布
+    	random_device rd;
+    	mt19937 generator(rd());
+    	uniform_int_distribution<int> distribution(0, characters.size() - 1);
+
+    	// 生成随机字符串
+    	
+    	for (int i = 1; i <=32; i++) //长度为randomNumber
+		{
+        	bitStr += characters[distribution(generator)];
+    	}
+        BitUtil::toBit(bitStr,mask);
+        return mask;
+}
+    int stt::data::JsonHelper::getValue(const string &oriStr,string &result,const string &type,const string &name,const int &num)
+    {
+        Json::Value root;
+        Json::CharReaderBuilder reader;
+        string errs;
+        istringstream s(oriStr);
+        bool is;
+
+        if(type=="arrayvalue")//数组中的数据
+        {
+            is=Json::parseFromStream(reader,s,&root,&errs);
+            if(!is||!root.isArray()||root.isNull())
+            {   
+                return -1;
+            }
+            Json::Value next=root[num];
+            if(next.isNull())
+            {
+                return -1;
+            }
+
+            if(next.isObject()||next.isArray())//嵌套了数组或者json对象
+            {
+                Json::StreamWriterBuilder writerBuilder;
+                result = Json::writeString(writerBuilder, next);
+                return 1;
+            }
+            else//普通数据
+            {
+                result=root[num].asString();
+                return 0;
+            }
+        }
+        
+        else if(type=="value")//json中的普通数据
+        {
+            is=Json::parseFromStream(reader,s,&root,&errs);
+            if(!is||!root.isObject()||root.isNull())
+            {   
+                return -1;
+            }
+            Json::Value next=root[name];
+            if(next.isNull())
+                return -1;
+            if(next.isObject()||next.isArray())//对象
+            {
+                Json::StreamWriterBuilder writerBuilder;
+                result = Json::writeString(writerBuilder, next);
+                return 1;
+            }
+            else//普通数据
+            {
+                result=root[name].asString();
+                return 0;
+            }
+            
+        }    
+        else
+        {   
+            return -1;
+        }
+    }
+    string stt::data::JsonHelper::toString(const Json::Value &val)
+    {
+        return val.asString();
+    }
+    Json::Value stt::data::JsonHelper::toJsonArray(const string & str)
+    {
+        Json::Value root;
+        Json::CharReaderBuilder reader;
+        string errs;
+        istringstream s(str);
+        
+        if(!Json::parseFromStream(reader,s,&root,&errs))
+        {
+            cerr<<"json转换错误 : "<<errs<<endl;
+        }
+        return root;
+    }
+    string stt::data::JsonHelper::jsonAdd(const string &a,const string &b)
+    {
+        string result=a;
+        result.erase(a.length()-2);
+        if(a.length()>3)
+            result+=",";
+        result+=b.substr(1);
+        return result;
+    }
+    string& stt::data::JsonHelper::jsonFormatify(const string &a,string &b)
+    {
+        Json::CharReaderBuilder reader;
+        Json::Value root;
+        string errs;
+        istringstream s(a);
+        if(!Json::parseFromStream(reader,s,&root,&errs))
+        {
+            cerr<<"json转换错误 : "<<errs<<endl;
+            b="";
+            return b;
+        }
+        Json::StreamWriterBuilder writer;
+        writer["indentation"]="";
+        b=Json::writeString(writer,root);
+        return b;
+    }
+    string& stt::data::JsonHelper::jsonToUTF8(const string &input,string &output)
+    {
+        output.clear();
+        regex unicode_regex("\\\\u([0-9a-fA-F]{4})");
+    
+        // 使用sregex_iterator遍历匹配的结果
+        sregex_iterator begin(input.begin(), input.end(), unicode_regex);
+        sregex_iterator end;
+    
+        string::size_type last_pos = 0;
+        for (sregex_iterator i = begin; i != end; ++i) 
+        {
+            smatch match = *i;
+            output += input.substr(last_pos, match.position() - last_pos);  // 添加前面未匹配的部分
+
+            // 提取匹配到的十六进制 Unicode 码
+            unsigned int codepoint;
+            stringstream ss;
+            ss << hex << match.str(1);
+            ss >> codepoint;
+
+            // 将 Unicode 码转换为 UTF-8 字符
+            char utf8_char[5] = {0};
+            if (codepoint <= 0x7F) 
+            {
+                utf8_char[0] = codepoint;
+            } 
+            else if (codepoint <= 0x7FF) 
+            {
+                utf8_char[0] = 0xC0 | ((codepoint >> 6) & 0x1F);
+                utf8_char[1] = 0x80 | (codepoint & 0x3F);
+            } 
+            else if (codepoint <= 0xFFFF) 
+            {
+                utf8_char[0] = 0xE0 | ((codepoint >> 12) & 0x0F);
+                utf8_char[1] = 0x80 | ((codepoint >> 6) & 0x3F);
+                utf8_char[2] = 0x80 | (codepoint & 0x3F);
+            }
+
+            output += std::string(utf8_char);  // 添加转换后的 UTF-8 字符
+            last_pos = match.position() + match.length();
+        }
+    
+        // 添加最后一部分未匹配的字符串
+        output += input.substr(last_pos);
+        return output;
+    
+    }
+
+    
+    void stt::network::TcpFDHandler::blockSet(const int &sec)
+    {
+        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
+        fcntl(fd,F_GETFL,flags&~O_NONBLOCK);
+        flag1=false;
+        if(sec!=-1)
+        {
+            struct timeval tv;
+            tv.tv_sec = sec;  // 设置接收超时时间为 5 秒
+            tv.tv_usec = 0;
+
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        }
+        this->sec=sec;
+    }
+    void stt::network::UdpFDHandler::blockSet(const int &sec)
+    {
+        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
+        fcntl(fd,F_GETFL,flags&~O_NONBLOCK);
+        flag1=false;
+        if(sec!=-1)
+        {
+            struct timeval tv;
+            tv.tv_sec = sec;  // 设置接收超时时间为 5 秒
+            tv.tv_usec = 0;
+
+            setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        }
+        this->sec=sec;
+    }
+    void stt::network::TcpFDHandler::unblockSet()
+    {
+        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
+        fcntl(fd,F_SETFL,flags|O_NONBLOCK);
+        flag1=true;
+    }
+    void stt::network::UdpFDHandler::unblockSet()
+    {
+        int flags=fcntl(fd,F_GETFL,0);//获取当前标志
+        fcntl(fd,F_SETFL,flags|O_NONBLOCK);
+        flag1=true;
+    }
+    bool stt::network::TcpFDHandler::multiUseSet()
+    {
+        int opt;
+        if(!flag2)//设置为multiuse
+            opt=1;
+        else
+            opt=0;
+        if(setsockopt(fd,SOL_SOCKET,SO_REUSEADDR|SO_REUSEPORT,&opt,sizeof(opt))<0)
+        {
+            cerr<<"set multi failed"<<endl;
+            perror("setsockopt");
+            return false;
+        }
+        flag2=!flag2;
+        return true;
+    }
+    bool stt::network::UdpFDHandler::multiUseSet()
+    {
+        int opt;
+        if(!flag2)//设置为multiuse
+            opt=1;
+        else
+            opt=0;
+        if(setsockopt(fd,SOL_SOCKET,SO_REUSEADDR|SO_REUSEPORT,&opt,sizeof(opt))<0)
+        {
+            cerr<<"set multi failed"<<endl;
+            perror("setsockopt");
+            return false;
+        }
+        flag2=!flag2;
+        return true;
+    }
+    void stt::network::TcpFDHandler::setFD(const int &fd,SSL *ssl,const bool &flag1,const bool &flag2,const int &sec)
+    {
+        this->fd=fd;
+        this->flag1=flag1;
+        this->flag2=flag2;
+        this->ssl=ssl;
+        this->out=nullptr;
+        if(ssl!=nullptr)
+            signal(SIGPIPE,SIG_IGN);
+        
+    }
+    void stt::network::UdpFDHandler::setFD(const int &fd,const bool &flag1,const int &sec,const bool &flag2)
+    {
+        this->fd=fd;
+        this->flag1=flag1;
+        this->flag2=flag2;
+        if(flag1==true)
+            unblockSet();
+        else 
+            blockSet(sec);
+        if(flag2==true)
+            multiUseSet();
+    }
+    void stt::network::TcpFDHandler::close(const bool &cle)
+    {
+        
+        flag1=false;
+        flag2=false;
+        if(cle)
+        {
+            if(ssl!=nullptr)
+            {
+                SSL_shutdown(ssl);
+                SSL_free(ssl);
+            }
+            ::close(fd);
+        }
+        ssl=nullptr;
+        out=nullptr;
+        fd=-1;
+    }
+    void stt::network::UdpFDHandler::close(const bool &cle)
+    {
+        flag1=false;
+        flag2=false;
+        sec=-1;
+        if(cle)
+        {
+            ::close(fd);
+        }
+        fd=-1;
+    }
+    bool stt::network::TcpClient::createFD()
+    {
+        //准备socket
+        fd=socket(AF_INET,SOCK_STREAM,0);
+        if(fd<0)
+        {
+            perror("socket");
+            return false;
+        }
+        flag=false;
+        serverIP="";
+        serverPort=-1;
+        flag1=false;
+        flag2=false;
+        if(TLS)
+        {
+            this->TLS=true;
+            if(!initCTX(ca,cert,passwd))
+            {
+                this->TLS=false;
+                return false;
+            }
+            ssl=SSL_new(ctx);
+            if(ssl==NULL)
+            {
+                perror("new ssl wrong");
+                ERR_print_errors_fp(stderr);
+                this->TLS=false;
+                return false;
+            }
+        }
+        else
+        {
+            this->TLS=false;
+            ssl=nullptr;
+        }
+        return true;
+    }
+    void stt::network::TcpClient::closeAndUnCreate()
+    {
+        if(ssl!=nullptr)
+        {
+            SSL_shutdown(ssl);
+            SSL_free(ssl);
+            ssl=nullptr;
+        }
+        ::close(fd);
+        if(ctx!=nullptr)
+        {
+            SSL_CTX_free(ctx);
+            ctx=nullptr;
+        }  
+    }
+    bool stt::network::TcpClient::initCTX(const char *ca,const char *cert,const char *key,const char *passwd)
+    {
+        // 初始化
+        SSLeay_add_ssl_algorithms();
+        OpenSSL_add_all_algorithms();
+        SSL_load_error_strings();
+        ERR_load_BIO_strings();
+        //SSL_library_init();
+
+        // 我们使用SSL V3,V2
+        #if OPENSSL_VERSION_NUMBER < 0x10100000L
+        if((ctx = SSL_CTX_new(SSLv23_client_method()))==NULL)
+            return false;
+        #else
+        if((ctx = SSL_CTX_new(TLS_client_method())) == NULL)
+            return false;
+        #endif
+        //校验对方证书，使用系统自带的权威的ca证书
+        SSL_CTX_set_verify(ctx, SSL_VERIFY_PEER, NULL);
+        if(SSL_CTX_load_verify_locations(ctx, ca, NULL)<=0)
+        {
+            cerr<<"ca false"<<endl;
+            return false;
+        }
+        //可能的话加载自己的证书和私钥
+        if(cert!=""&&passwd!="")
+        {
+            if(SSL_CTX_use_certificate_chain_file(ctx, cert) <=0)
+            {
+                cerr<<"加载证书失败"<<endl;
+                return false;
+            }
+            SSL_CTX_set_default_passwd_cb_userdata(ctx, (void*)passwd);
+            if(SSL_CTX_use_PrivateKey_file(ctx, key, SSL_FILETYPE_PEM) <=0)
+            {
+                cerr<<"密码失败"<<endl;
+                return false;
+            }
+            //判断私钥是否正确
+            if(!SSL_CTX_check_private_key(ctx))
+            {
+                cerr<<"密码错误"<<endl;
+                return false;
+            }
+        }
+        signal(SIGPIPE,SIG_IGN);
+        return true;
+    }
+    stt::network::TcpClient::TcpClient(const bool &TLS,const char *ca,const char *cert,const char *key,const char *passwd)
+    {
+        this->ca=ca;
+        this->cert=cert;
+        this->key=key;
+        this->passwd=passwd;
+        this->TLS=TLS;
+        createFD();
+    }
+    void stt::network::TcpClient::resetCTX(const bool &TLS,const char *ca,const char *cert,const char *key,const char *passwd)
+    {
+        this->ca=ca;
+        this->cert=cert;
+        this->key=key;
+        this->passwd=passwd;
+        this->TLS=TLS;
+    }
+    bool stt::network::TcpClient::connect(const string &ip,const int &port)
+    {
+        if(isConnect())
+        {
+          if(!close())
+            return false;
+        }
+        //connect
+        hostent *k1;
+        k1=gethostbyname(ip.c_str());//DNS解析
+        if(k1==nullptr)
+        {
+            cerr<<"get host by name failed"<<endl;
+            close();
+            return false;
+        }
+        struct sockaddr_in k2;
+        memset(&k2,0,sizeof(k2));
+        k2.sin_family=AF_INET;
+        k2.sin_port=htons(port);
+        memcpy(&k2.sin_addr,k1->h_addr,k1->h_length);
+        if(::connect(fd,(struct sockaddr*)&k2,sizeof(k2))!=0)
+        {
+            perror("connect");
+            close();
+            return false;
+        }
+        if(TLS)//套上TLS加密
+        {
+            SSL_set_connect_state(ssl);
+            SSL_set_fd(ssl,fd);
+            int ret=SSL_connect(ssl);
+            if(ret != 1)
+            {
+                printf("%s\n", SSL_state_string_long(ssl));
+                printf("ret = %d, ssl get error %d\n", ret, SSL_get_error(ssl, ret));
+                return false;
+            }
+        }
+        flag=true;
+        return true;
+    }
+    bool stt::network::TcpClient::close()
+    {
+        closeAndUnCreate();
+        return createFD();
+    }
+    std::mutex stt::network::FileCache::lc;
+    std::list<std::pair<std::string,std::shared_ptr<stt::network::FileCache::Entry>>> stt::network::FileCache::lru;
+    std::unordered_map<std::string,std::list<std::pair<std::string,std::shared_ptr<stt::network::FileCache::Entry>>>::iterator> stt::network::FileCache::table;
+    size_t stt::network::FileCache::capacity=256;
+    std::shared_ptr<stt::network::FileCache::Entry> stt::network::FileCache::get(const std::string &path)
+    {
+        auto now=std::chrono::steady_clock::now();
+        std::shared_ptr<Entry> old;
+        {
+            std::lock_guard<std::mutex> lock(lc);
+            auto ii=table.find(path);
+            if(ii!=table.end())
+            {
+                lru.splice(lru.begin(),lru,ii->second);
+                old=ii->second->second;
+                if(now-old->checked<std::chrono::milliseconds(CHECK_INTERVAL))
+                    return old;
+            }
+        }
+        //stat和open不持锁
+        struct stat st;
+        if(::stat(path.c_str(),&st)!=0||!S_ISREG(st.st_mode))
+        {
+            if(old)
+            {
+                std::lock_guard<std::mutex> lock(lc);
+                auto ii=table.find(path);
+                if(ii!=table.end()&&ii->second->second==old)
+                {
+                    lru.erase(ii->second);
+                    table.erase(ii);
+                }
+            }
+            return nullptr;
+        }
+        if(old&&old->ino==st.st_ino&&old->size==(uint64_t)st.st_size&&old->mtime==st.st_mtime)//没有变化
+        {
+            std::lock_guard<std::mutex> lock(lc);
+            old->checked=now;
+            return old;
+        }
+        std::shared_ptr<Entry> entry=std::make_shared<Entry>();
+        entry->fd=::open(path.c_str(),O_RDONLY|O_CLOEXEC);
+        if(entry->fd==-1||fstat(entry->fd,&st)!=0||!S_ISREG(st.st_mode))
+            return nullptr;
+        entry->size=st.st_size;
+        entry->mtime=st.st_mtime;
+        entry->ino=st.st_ino;
+        entry->checked=now;
+        char buf[64];
+        snprintf(buf,sizeof(buf),"\"%lx-%lx\"",(unsigned long)st.st_mtime,(unsigned long)st.st_size);
+        entry->etag=buf;
+        tm t;
+        gmtime_r(&st.st_mtime,&t);
+        strftime(buf,sizeof(buf),"%a, %d %b %Y %H:%M:%S GMT",&t);
+        entry->lastModified=buf;
+        std::lock_guard<std::mutex> lock(lc);
+        auto ii=table.find(path);
+        if(ii!=table.end())
+        {
+            ii->second->second=entry;
+            lru.splice(lru.begin(),lru,ii->second);
+        }
+        else
+        {
+            lru.emplace_front(path,entry);
+            table.emplace(path,lru.begin());
+            //淘汰最久没用的 正在发送的响应还持有shared_ptr 发完才关fd
+            while(lru.size()>capacity)
+            {
+                table.erase(lru.back().first);
+                lru.pop_back();
+            }
+        }
+        return entry;
+    }
+    void stt::network::FileCache::setCapacity(const size_t &capacity)
+    {
+        std::lock_guard<std::mutex> lock(lc);
+        FileCache::capacity=capacity;
+        while(lru.size()>FileCache::capacity)
+        {
+            table.erase(lru.back().first);
+            lru.pop_back();
+        }
+    }
+    size_t stt::network::FileCache::size()
+    {
+        std::lock_guard<std::mutex> lock(lc);
+        return lru.size();
+    }
+    void stt::network::FileCache::clear()
+    {
+        std::lock_guard<std::mutex> lock(lc);
+        table.clear();
+        lru.clear();
+    }
+    int stt::network::OutputBuffer::sendSome(SSL *ssl,const char *data,const size_t &length,size_t &sent)
+    {
+        sent=0;
+        while(sent<length)
+        {
+            int result;
+            if(ssl==nullptr||ktls)//内核TLS直接写明文 由内核加密
+            {
+                result=::send(fd,data+sent,length-sent,MSG_NOSIGNAL);
+                if(result<0)
+                {
+                    if(errno==EINTR)
+                        continue;
+                    if(errno==EAGAIN||errno==EWOULDBLOCK)//写满了 等可写事件
+                        return 0;
+                    return -1;
+                }
+            }
+            else
+            {
+                size_t len=length-sent;
+                if(len>INT_MAX)
+                    len=INT_MAX;
+                result=SSL_write(ssl,data+sent,len);
+                if(result<=0)
+                {
+                    int err=SSL_get_error(ssl,result);
+                    if(err==SSL_ERROR_WANT_WRITE||err==SSL_ERROR_WANT_READ)//重试时必须带上同样的数据 所以这部分数据留在队首
+                        return 0;
+                    return -1;
+                }
+            }
+            sent+=result;
+        }
+        return 0;
+    }
+    int stt::network::OutputBuffer::sendSomeV(SSL *ssl,const struct iovec *iov,const int &iovcnt,size_t &sent,const int &flags)
+    {
+        sent=0;
+        if(ssl==nullptr||ktls)//明文（或者内核TLS）一次系统调用把多段一起交给内核
+        {
+            iovec v[IOV_BATCH];
+            int n=0;
+            for(int ii=0;ii<iovcnt&&n<IOV_BATCH;ii++)
+            {
+                if(iov[ii].iov_len==0)
+                    continue;
+                v[n++]=iov[ii];
+            }
+            int idx=0;
+            while(idx<n)
+            {
+                msghdr msg;
+                memset(&msg,0,sizeof(msg));
+                msg.msg_iov=v+idx;
+                msg.msg_iovlen=n-idx;
+                ssize_t result=::sendmsg(fd,&msg,MSG_NOSIGNAL|flags);
+                if(result<0)
+                {
+                    if(errno==EINTR)
+                        continue;
+                    if(errno==EAGAIN||errno==EWOULDBLOCK)//写满了 等可写事件
+                        return 0;
+                    return -1;
+                }
+                sent+=result;
+                //跳过已经发完的段
+                while(idx<n&&(size_t)result>=v[idx].iov_len)
+                {
+                    result-=v[idx].iov_len;
+                    ++idx;
+                }
+                if(idx<n)
+                {
+                    v[idx].iov_base=(char*)v[idx].iov_base+result;
+                    v[idx].iov_len-=result;
+                }
+            }
+            return 0;
+        }
+        //TLS没有writev 小的多段先拼成一条记录再写 大的逐段写
+        size_t total=0;
+        for(int ii=0;ii<iovcnt;ii++)
+            total+=iov[ii].iov_len;
+        if(iovcnt>1&&total<=TLS_BATCH)
+        {
+            thread_local std::string batch;
+            batch.clear();
+            for(int ii=0;ii<iovcnt;ii++)
+                batch.append((const char*)iov[ii].iov_base,iov[ii].iov_len);
+            return sendSome(ssl,batch.data(),batch.size(),sent);
+        }
+        for(int ii=0;ii<iovcnt;ii++)
+        {
+            size_t one;
+            if(sendSome(ssl,(const char*)iov[ii].iov_base,iov[ii].iov_len,one)<0)
+                return -1;
+            sent+=one;
+            if(one<iov[ii].iov_len)
+                break;
+        }
+        return 0;
+    }
+    int stt::network::OutputBuffer::write(SSL *ssl,const char *data,const size_t &length)
+    {
+        iovec v;
+        v.iov_base=(void*)data;
+        v.iov_len=length;
+        return writev(ssl,&v,1);
+    }
+    int stt::network::OutputBuffer::writev(SSL *ssl,const struct iovec *iov,const int &iovcnt)
+    {
+        std::lock_guard<std::mutex> lock(lo);
+        if(closed||closing)
+            return -1;
+        size_t total=0;
+        for(int ii=0;ii<iovcnt;ii++)
+            total+=iov[ii].iov_len;
+        size_t sent=0;
+        if(chunks.empty()&&iovcnt<=IOV_BATCH)//前面没有积压 直接发
+        {
+            if(sendSomeV(ssl,iov,iovcnt,sent)<0)
+                return -1;
+            if(sent==total)
+                return total;
+        }
+        //发不完的部分入队 等可写事件
+        for(int ii=0;ii<iovcnt;ii++)
+        {
+            if(sent>=iov[ii].iov_len)
+            {
+                sent-=iov[ii].iov_len;
+                continue;
+            }
+            chunks.emplace_back((const char*)iov[ii].iov_base+sent,iov[ii].iov_len-sent);
+            bytes+=iov[ii].iov_len-sent;
+            sent=0;
+        }
+        if(bytes>=highWater)
+            overHigh=true;
+        if(!watching)
+        {
+            watching=true;
+            if(watchFun)
+                watchFun(true);
+        }
+        return total;
+    }
+    int stt::network::OutputBuffer::drain(SSL *ssl)
+    {
+        //调用者持有lo 尽量把队列发出去 写满了返回0 出错返回-1
+        while(!chunks.empty())
+        {
+            Chunk &front=chunks.front();
+            if(front.file)//文件块
+            {
+                if(ssl==nullptr||ktls)//明文直接sendfile 内核TLS用SSL_sendfile 数据都不经过用户态
+                {
+                    off_t off=front.fileOffset;
+                    size_t len=front.fileLength;
+                    if(len>(1ULL<<30))
+                        len=1ULL<<30;
+                    ssize_t result;
+                    if(ssl==nullptr)
+                    {
+                        result=::sendfile(fd,front.file->fd,&off,len);
+                        if(result<0)
+                        {
+                            if(errno==EINTR)
+                                continue;
+                            if(errno==EAGAIN||errno==EWOULDBLOCK)
+                                return 0;
+                            return -1;
+                        }
+                    }
+                    else
+                    {
+                        #ifdef SSL_OP_ENABLE_KTLS
+                        result=SSL_sendfile(ssl,front.file->fd,off,len,0);
+                        if(result<0)
+                        {
+                            int err=SSL_get_error(ssl,result);
+                            if(err==SSL_ERROR_WANT_WRITE)
+                                return 0;
+                            if(err==SSL_ERROR_SYSCALL&&errno==EINTR)
+                                continue;
+                            return -1;
+                        }
+                        #else
+                        return -1;
+                        #endif
+                    }
+                    if(result==0)//文件被截短了 已经发出去的Content-Length没法兑现
+                        return -1;
+                    front.fileOffset+=result;
+                    front.fileLength-=result;
+                    bytes-=result;
+                    if(front.fileLength==0)
+                        chunks.pop_front();
+                    continue;
+                }
+                //TLS每次读出一小块放到队首 按普通数据发送 内存占用有上限
+                size_t len=front.fileLength<FILE_PIECE?front.fileLength:FILE_PIECE;
+                std::string piece(len,'\0');
+                ssize_t result;
+                do
+                {
+                    result=::pread(front.file->fd,piece.data(),len,front.fileOffset);
+                }while(result<0&&errno==EINTR);
+                if(result<=0)
+                    return -1;
+                piece.resize(result);
+                front.fileOffset+=result;
+                front.fileLength-=result;
+                if(front.fileLength==0)
+                    chunks.pop_front();
+                chunks.emplace_front(std::move(piece));
+                continue;
+            }
+            //明文和内核TLS一次带上多个块 用户态TLS每次只写队首一块（WANT_WRITE后必须用同样的数据重试）
+            iovec v[IOV_BATCH];
+            int n=0;
+            size_t total=0;
+            int flags=0;
+            for(auto ii=chunks.begin();ii!=chunks.end()&&n<(ssl==nullptr||ktls?IOV_BATCH:1);++ii,++n)
+            {
+                if(ii->file)//后面紧跟着文件 让内核等文件数据一起组包
+                {
+                    flags=MSG_MORE;
+                    break;
+                }
+                size_t skip=(n==0?offset:0);
+                v[n].iov_base=(char*)ii->data.data()+skip;
+                v[n].iov_len=ii->data.size()-skip;
+                total+=v[n].iov_len;
+            }
+            size_t sent;
+            if(sendSomeV(ssl,v,n,sent,flags)<0)
+                return -1;
+            bool full=sent<total;
+            bytes-=sent;
+            //弹出发完的块
+            while(sent>0)
+            {
+                size_t left=chunks.front().data.size()-offset;
+                if(sent<left)
+                {
+                    offset+=sent;
+                    break;
+                }
+                sent-=left;
+                chunks.pop_front();
+                offset=0;
+            }
+            if(full)//又写满了
+                return 0;
+        }
+        return 0;
+    }
+    int stt::network::OutputBuffer::flush(SSL *ssl,bool &resumed)
+    {
+        std::lock_guard<std::mutex> lock(lo);
+        resumed=false;
+        if(closed)
+            return -1;
+        if(drain(ssl)<0)
+            return -1;
+        if(overHigh&&bytes<=lowWater)
+        {
+            overHigh=false;
+            resumed=true;
+        }
+        if(chunks.empty())
+        {
+            if(watching)
+            {
+                watching=false;
+                if(watchFun)
+                    watchFun(false);
+            }
+            return 1;
+        }
+        //还有数据 重新关注可写事件（io_uring的可写登记是一次性的）
+        if(watchFun)
+            watchFun(true);
+        return 0;
+    }
+    int stt::network::OutputBuffer::writeFile(SSL *ssl,const std::string &head,const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length)
+    {
+        std::lock_guard<std::mutex> lock(lo);
+        if(closed||closing)
+            return -1;
+        bool empty=chunks.empty();
+        if(!head.empty())
+            chunks.emplace_back(head.data(),head.size());
+        if(length>0)
+            chunks.emplace_back(file,offset,length);
+        bytes+=head.size()+length;
+        if(empty&&drain(ssl)<0)//前面没有积压 马上开始发
+            return -1;
+        if(bytes>=highWater)
+            overHigh=true;
+        if(!chunks.empty()&&!watching)
+        {
+            watching=true;
+            if(watchFun)
+                watchFun(true);
+        }
+        uint64_t total=head.size()+length;
+        return total>INT_MAX?INT_MAX:total;
+    }
+    bool stt::network::OutputBuffer::deferClose()
+    {
+        std::lock_guard<std::mutex> lock(lo);
+        if(closed||closing||chunks.empty())
+            return false;
+        closing=true;
+        return true;
+    }
+    bool stt::network::OutputBuffer::isClosing()
+    {
+        std::lock_guard<std::mutex> lock(lo);
+        return closing;
+    }
+    void stt::network::OutputBuffer::close()
+    {
+        std::lock_guard<std::mutex> lock(lo);
+        closed=true;
+        chunks.clear();
+        offset=0;
+        bytes=0;
+        overHigh=false;
+        watching=false;
+    }
+    //阻塞发送时等待socket可写 超时或者出错返回false
+    static bool waitWritable(const int &fd,const short &events,const int &sec)
+    {
+        pollfd pfd;
+        pfd.fd=fd;
+        pfd.events=events;
+        pfd.revents=0;
+        int ret;
+        do
+        {
+            ret=poll(&pfd,1,sec<0?-1:sec*1000);
+        }while(ret<0&&errno==EINTR);
+        return ret>0&&!(pfd.revents&(POLLERR|POLLNVAL));
+    }
+    int stt::network::TcpFDHandler::sendData(const string &data,const bool &block)
+    {
+        return sendData(data.data(),data.size(),block);
+    }
+    
+    int stt::network::UdpFDHandler::sendData(const string &data,const string &ip,const int &port,const bool &block)
+    {
+        if(fd==-1)
+            return -99;
+        //填充目标信息
+        hostent *k1;
+        k1=gethostbyname(ip.c_str());//DNS解析
+        if(k1==nullptr)
+        {
+            cerr<<"get host by name failed"<<endl;
+            return -98;
+        }
+        struct sockaddr_in k2;
+        memset(&k2,0,sizeof(k2));
+        k2.sin_family=AF_INET;
+        k2.sin_port=htons(port);
+        memcpy(&k2.sin_addr,k1->h_addr,k1->h_length);
+        //发送
+        int size=data.size();
+        int totalSize=0;
+        int pos=0;
+        int result;
+        if(block)
+        {
+            while((result=::sendto(fd,data.substr(pos).c_str(),size-totalSize,MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2))))
+            {
+                if(result<0)
+                {
+                    if(errno==EAGAIN||errno==EWOULDBLOCK)
+                        continue;
+                    //perror("send");
+                    break;
+                }
+                else
+                {
+                    totalSize+=result;
+                    pos=totalSize-1;
+                    if(totalSize>=size)
+                        break;
+                }
+            }
+        }
+        else
+        {
+            totalSize=::sendto(fd,data.c_str(),data.size(),MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2));
+            if(totalSize<0)
+            {
+                if(errno==EAGAIN||errno==EWOULDBLOCK)
+                    totalSize=-100;
+            }
+        }
+        return totalSize;
+    }
+    
+    int stt::network::TcpFDHandler::sendData(const char *data,const uint64_t &length,const bool &block)
+    {
+        if(!isConnect())
+            return -99;
+        if(out!=nullptr)//服务端的连接 发不完的交给输出队列 由reactor在可写时继续发送
+        {
+            int result=out->write(ssl,data,length);
+            if(result<0)
+            {
+                if(block)
+                {
+                    flag3=true;
+                    return 0;
+                }
+                return -1;
+            }
+            return result;
+        }
+        uint64_t totalSize=0;
+        int result;
+        if(block)
+        {
+            while(totalSize<length)
+            {
+                if(ssl==nullptr)
+                {
+                    result=::send(fd,data+totalSize,length-totalSize,MSG_NOSIGNAL);
+                    if(result<0)
+                    {
+                        if(errno==EINTR)
+                            continue;
+                        //写满了就等可写 不再空转
+                        if((errno==EAGAIN||errno==EWOULDBLOCK)&&waitWritable(fd,POLLOUT,sec))
+                            continue;
+                        //perror("send");
+                        flag3=true;
+                        break;
+                    }
+                }
+                else
+                {
+                    result=::SSL_write(ssl,data+totalSize,length-totalSize);
+                    if(result<=0)
+                    {
+                        int err=SSL_get_error(ssl,result);
+                        if(err==SSL_ERROR_WANT_WRITE&&waitWritable(fd,POLLOUT,sec))
+                            continue;
+                        if(err==SSL_ERROR_WANT_READ&&waitWritable(fd,POLLIN,sec))
+                            continue;
+                        flag3=true;
+                        break;
+                    }
+                }
+                totalSize+=result;
+            }
+        }
+        else
+        {
+            if(ssl==nullptr)
+            {
+                result=::send(fd,data,length,MSG_NOSIGNAL);
+                if(result<0)
+                {
+                    if(errno==EAGAIN||errno==EWOULDBLOCK)
+                        result=-100;
+                }
+            }
+            else
+            {
+                result=SSL_write(ssl,data,length);
+                if(result<0)
+                {
+                    int err=SSL_get_error(ssl,result);
+                    if(err==SSL_ERROR_WANT_WRITE||err==SSL_ERROR_WANT_READ)
+                        result=-100;
+                }
+            }
+            return result;
+        }
+        return totalSize;
+    }
+    
+    int stt::network::TcpFDHandler::sendData(const struct iovec *iov,const int &iovcnt,const bool &block)
+    {
+        if(!isConnect())
+            return -99;
+        if(out!=nullptr)//服务端的连接 交给输出队列聚合发送
+        {
+            int result=out->writev(ssl,iov,iovcnt);
+            if(result<0)
+            {
+                if(block)
+                {
+                    flag3=true;
+                    return 0;
+                }
+                return -1;
+            }
+            return result;
+        }
+        //没有输出队列 逐段发送
+        int totalSize=0;
+        for(int ii=0;ii<iovcnt;ii++)
+        {
+            int result=sendData((const char*)iov[ii].iov_base,iov[ii].iov_len,block);
+            if(result<0)
+                return totalSize>0?totalSize:result;
+            totalSize+=result;
+            if((size_t)result<iov[ii].iov_len)
+                break;
+        }
+        return totalSize;
+    }
+    
+    int stt::network::TcpFDHandler::sendFile(const std::shared_ptr<FileCache::Entry> &file,const uint64_t &offset,const uint64_t &length,const std::string &head,const bool &block)
+    {
+        if(!isConnect())
+            return -99;
+        if(file==nullptr||offset+length>file->size)
+            return -1;
+        if(out!=nullptr)//服务端的连接 交给输出队列 明文走sendfile
+        {
+            int result=out->writeFile(ssl,head,file,offset,length);
+            if(result<0)
+            {
+                if(block)
+                {
+                    flag3=true;
+                    return 0;
+                }
+                return -1;
+            }
+            return result;
+        }
+        uint64_t totalSize=0;
+        if(!head.empty())
+        {
+            int result=sendData(head.data(),head.size(),block);
+            if(result<(int)head.size())
+                return result;
+            totalSize+=result;
+        }
+        off_t off=offset;
+        uint64_t left=length;
+        if(ssl==nullptr)
+        {
+            while(left>0)
+            {
+                ssize_t result=::sendfile(fd,file->fd,&off,left>(1ULL<<30)?(1ULL<<30):left);
+                if(result<0)
+                {
+                    if(errno==EINTR)
+                        continue;
+                    if(block&&(errno==EAGAIN||errno==EWOULDBLOCK)&&waitWritable(fd,POLLOUT,sec))
+                        continue;
+                    if(block)
+                        flag3=true;
+                    else if(errno==EAGAIN||errno==EWOULDBLOCK)
+                        break;
+                    return totalSize>0?(totalSize>INT_MAX?INT_MAX:totalSize):-1;
+                }
+                if(result==0)
+                {
+                    flag3=true;
+                    break;
+                }
+                left-=result;
+                totalSize+=result;
+            }
+        }
+        #ifdef SSL_OP_ENABLE_KTLS
+        else if(BIO_get_ktls_send(SSL_get_wbio(ssl)))//内核TLS 文件直接交给内核加密发送
+        {
+            while(left>0)
+            {
+                ossl_ssize_t result=SSL_sendfile(ssl,file->fd,off,left>(1ULL<<30)?(1ULL<<30):left,0);
+                if(result<=0)
+                {
+                    int err=SSL_get_error(ssl,result);
+                    if(block&&err==SSL_ERROR_WANT_WRITE&&waitWritable(fd,POLLOUT,sec))
+                        continue;
+                    if(block||err!=SSL_ERROR_WANT_WRITE)
+                        flag3=true;
+                    break;
+                }
+                off+=result;
+                left-=result;
+                totalSize+=result;
+            }
+        }
+        #endif
+        else
+        {
+            //TLS下分块读出来再发送
+            std::string piece;
+            while(left>0)
+            {
+                size_t len=left<OutputBuffer::FILE_PIECE?left:OutputBuffer::FILE_PIECE;
+                piece.resize(len);
+                ssize_t result=::pread(file->fd,piece.data(),len,off);
+                if(result<=0)
+                {
+                    if(result<0&&errno==EINTR)
+                        continue;
+                    flag3=true;
+                    break;
+                }
+                int sent=sendData(piece.data(),result,block);
+                if(sent<=0)
+                    break;
+                off+=sent;
+                left-=sent;
+                totalSize+=sent;
+                if(sent<result)
+                    break;
+            }
+        }
+        return totalSize>INT_MAX?INT_MAX:totalSize;
+    }
+    
+    int stt::network::UdpFDHandler::sendData(const char *data,const uint64_t &length,const string &ip,const int &port,const bool &block)
+    {
+        if(fd==-1)
+            return -99;
+        //填充目标信息
+        hostent *k1;
+        k1=gethostbyname(ip.c_str());//DNS解析
+        if(k1==nullptr)
+        {
+            cerr<<"get host by name failed"<<endl;
+            return -98;
+        }
+        struct sockaddr_in k2;
+        memset(&k2,0,sizeof(k2));
+        k2.sin_family=AF_INET;
+        k2.sin_port=htons(port);
+        memcpy(&k2.sin_addr,k1->h_addr,k1->h_length);
+        //发送
+        int totalSize=0;
+        int pos=0;
+        int result;
+        if(block)
+        {
+            while((result=::sendto(fd,data+pos,length-totalSize,MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2))))
+            {
+                if(result<0)
+                {
+                    if(errno==EAGAIN||errno==EWOULDBLOCK)
+                        continue;
+                    //perror("send");
+                    break;
+                }
+                else
+                {
+                    totalSize+=result;
+                    pos=totalSize-1;
+                    if(totalSize>=length)
+                        break;
+                }
+            }
+        }
+        else
+        {
+            totalSize=::sendto(fd,data,length,MSG_NOSIGNAL,(struct sockaddr*)&k2,sizeof(k2));
+            if(totalSize<0)
+            {
+                if(errno==EAGAIN||errno==EWOULDBLOCK)
+                    totalSize=-100;
+            }
+        }
+        return totalSize;
+    }
+    
+    int stt::network::TcpFDHandler::recvDataByLength(string &data,const uint64_t &length,const int &sec)
+    {
+        if(!isConnect())
+            return -99;
+        if(flag1&&sec!=-1)//非阻塞模式且sec设置为非无限等待
+        {
+            DateTime timer;
+            Duration dt{0,0,0,sec,0};
+            unique_ptr<char[]> buffer(new char[length]);
+            data.clear();
+            uint64_t size=length;
+            int64_t recvSize;
+            while(size>0)
+            {
+                timer.startTiming();
+                if(ssl==nullptr)
+                    recvSize=::recv(fd,buffer.get(),size,0);
+                else
+                    recvSize=SSL_read(ssl,buffer.get(),size);
+                if(recvSize<=0)
+                {
+                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                    {
+                        //cout<<"ok"<<endl;
+                        if(dt>=timer.checkTime())
+                            continue;
+                        else
+                        {
+                            return -100;
+                        }
+                    }
+                    return recvSize;
+                }
+                timer.endTiming(); 
+                data+=string(buffer.get(),recvSize);
+                size-=recvSize;
+            }
+        }
+        else//阻塞模式
+        {
+            int sec_backup=this->sec;
+            blockSet(sec);
+            unique_ptr<char[]> buffer(new char[length]);
+            data.clear();
+            uint64_t size=length;
+            int64_t recvSize;
+            while(size>0)
+            {
+                if(ssl==nullptr)
+                    recvSize=::recv(fd,buffer.get(),size,0);
+                else
+                    recvSize=SSL_read(ssl,buffer.get(),size);
+                if(recvSize<=0)
+                {
+                    blockSet(sec_backup);
+                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                        return -100;
+                    return recvSize;
+                }
+                data+=string(buffer.get(),recvSize);
+                size-=recvSize;
+            }
+        }
+
+        
+        return length;
+    }
+    /*
+    int UdpFDHandler::recvDataByLength(string &data,const uint64_t &length,string &ip,int &port,const int &sec)
+    {
+        if(fd==-1)
+            return -99;
+        int sec_back_up;
+        if(!flag1)//如果是阻塞模式要设置新的超时时间
+        {
+            sec_back_up=this->sec;
+            blockSet(sec);
+        }
+        //预备接收对端的信息
+        struct sockaddr_in chenfan;
+	    socklen_t tanziliang=sizeof(chenfan);
+        //接收
+        char buffer[length];
+        data.clear();
+        uint64_t size=length;
+        int64_t recvSize;
+        if(flag1)//非阻塞模式
+        {
+            DateTime timer;
+            Duration dt{0,0,0,sec,0};
+            while(size>0)
+            {
+                timer.startTiming();
+                recvSize=::recvfrom(fd,buffer,size,0,(struct sockaddr*)&chenfan,&tanziliang);
+                if(recvSize<0)
+                {
+                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                    {
+                        //cout<<"ok"<<endl;
+                        if(dt<timer.checkTime())
+                            continue;
+                        else
+                        {
+                            port=chenfan.sin_port;
+	                        ip.assign(inet_ntoa(chenfan.sin_addr));
+                            if(!flag1)
+                                blockSet(sec_back_up);
+                            return -100;
+                        }
+                    }
+                    perror("recv()");
+                    break;
+                }
+                timer.endTiming(); 
+                data+=string(buffer,recvSize);
+                size-=recvSize;
+            }
+        }
+        else//阻塞模式
+        {
+            while(size>0)
+            {
+                recvSize=::recvfrom(fd,buffer,size,0,(struct sockaddr*)&chenfan,&tanziliang);
+                if(recvSize<0)
+                {
+                    perror("recv()");
+                    break;
+                }
+                data+=string(buffer,recvSize);
+                size-=recvSize;
+            }
+        }
+        //ip和port
+        port=chenfan.sin_port;
+	    ip.assign(inet_ntoa(chenfan.sin_addr));
+        //如果是阻塞模式 接收完毕还原超时时间
+        if(!flag1)
+            blockSet(sec_back_up);
+        if(recvSize<0)
+            return recvSize;
+        return length;
+    }
+    */
+    int stt::network::TcpFDHandler::recvDataByLength(char *data,const uint64_t &length,const int &sec)
+    {
+        if(!isConnect())
+            return -99;
+        
+        if(flag1&&sec!=-1)//非阻塞模式
+        {
+            DateTime timer;
+            Duration dt{0,0,0,sec,0};
+            memset(data,0,length);
+            uint64_t size=length;
+            int64_t recvSize=0;
+            while(size>0)
+            {
+                timer.startTiming();
+                if(ssl==nullptr)
+                    recvSize=::recv(fd,data+(length-size),size,0);
+                else
+                    recvSize=SSL_read(ssl,data+(length-size),size);
+                if(recvSize<=0)
+                {
+                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                    {
+                        if(dt>=timer.checkTime())
+                            continue;
+                        else
+                        {
+                            return -100;
+                        }
+                    }
+
+                    return recvSize;
+                }
+                timer.endTiming();
+
+                size-=recvSize;
+            }
+        }
+        else
+        {
+            int sec_backup=this->sec;
+            blockSet(sec);
+            memset(data,0,length);
+            uint64_t size=length;
+            int64_t recvSize=0;
+            while(size>0)
+            {
+                if(ssl==nullptr)
+                    recvSize=::recv(fd,data+(length-size),size,0);
+                else
+                    recvSize=SSL_read(ssl,data+(length-size),size);
+                if(recvSize<=0)
+                {
+                    blockSet(sec_backup);
+                    if(recvSize<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                    {
+                        return -100;
+                    }
+
+                    return recvSize;
+                }
+
+                size-=recvSize;
+            }
+        }
+
+        return length;
+    }
+    int stt::network::TcpFDHandler::recvData(string &data,const uint64_t &length)
+    {
+        if(!isConnect())
+            return -99;
+        unique_ptr<char[]> buffer(new char[length]);
+        int size;
+        if(ssl==nullptr)
+            size=::recv(fd,buffer.get(),length,0);
+        else
+            size=SSL_read(ssl,buffer.get(),length);
+        if(size>0)
+            data=string(buffer.get(),size);
+        else
+        {
+            if(flag1==true&&size<0&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                return -100;
+            //perror("recv()");
+        }
+        return size;
+    }
+    int stt::network::UdpFDHandler::recvData(string &data,const uint64_t &length,string &ip,int &port)
+    {
+        if(fd==-1)
+            return -99;
+        unique_ptr<char[]> buffer(new char[length]);
+        int size;
+        struct sockaddr_in chenfan;
+	    socklen_t tanziliang=sizeof(chenfan);
+        size=::recvfrom(fd,buffer.get(),length,0,(struct sockaddr*)&chenfan,&tanziliang);
+        if(size>0)
+        {
+            data=string(buffer.get(),size);
+            port=chenfan.sin_port;
+	        ip.assign(inet_ntoa(chenfan.sin_addr));
+        }
+        else
+        {
+            if((errno==EAGAIN||errno==EWOULDBLOCK))
+                return -100;
+            //perror("recv()");
+        }
+        return size;
+    }
+    int stt::network::TcpFDHandler::recvData(char *data,const uint64_t &length)
+    {
+        if(!isConnect())
+            return -99;
+        int size;
+        if(ssl==nullptr)
+            size=::recv(fd,data,length,0);
+        else
+            size=SSL_read(ssl,data,length);
+        if(size<0)
+        {
+            if(flag1==true&&(errno==EAGAIN||errno==EWOULDBLOCK))
+                return -100;
+            //perror("recv()");
+        }
+        return size;
+    }
+    int stt::network::UdpFDHandler::recvData(char *data,const uint64_t &length,string &ip,int &port)
+    {
+        if(fd==-1)
+            return -99;
+        int size;
+        struct sockaddr_in chenfan;
+	    socklen_t tanziliang=sizeof(chenfan);
+        size=::recvfrom(fd,data,length,0,(struct sockaddr*)&chenfan,&tanziliang);
+        if(size<0)
+        {
+            if((errno==EAGAIN||errno==EWOULDBLOCK))
+                return -100;
+            //perror("recv()");
+        }
+        port=chenfan.sin_port;
+	    ip.assign(inet_ntoa(chenfan.sin_addr));
+        return size;
+    }
+    stt::network::UdpClient::UdpClient(const bool &flag1,const int &sec)
+    {
+        fd=socket(AF_INET,SOCK_DGRAM,0);
+        if(fd<0)
+        {
+            cerr<<" udp fd failed"<<endl;;
+            fd=-1;
+        }
+        else
+        {
+            if(flag1)
+                unblockSet();
+            else
+                blockSet(sec);
+            this->flag1=flag1;
+            this->sec=sec;
+            this->flag2=false;
+        }
+    }
+    bool stt::network::UdpClient::createFD(const bool &flag1,const int &sec)
+    {
+        if(fd!=-1)
+            close();
+        fd=socket(AF_INET,SOCK_DGRAM,0);
+        if(fd<0)
+        {
+            cerr<<" udp fd failed"<<endl;;
+            fd=-1;
+            return false;
+        }
+        else
+        {
+            if(flag1)
+                unblockSet();
+            else
+                blockSet(sec);
+            this->flag1=flag1;
+            this->sec=sec;
+            this->flag2=false;
+        }
+        return true;
+    }
+    stt::network::UdpServer::UdpServer(const int &port,const bool &flag1,const int &sec,const bool &flag2)
+    {
+        fd=socket(AF_INET,SOCK_DGRAM,0);
+        if(fd<0)
+        {
+            cerr<<" udp fd failed"<<endl;;
+            fd=-1;
+        }
+        else
+        {
+            if(flag1)
+                unblockSet();
+            else
+                blockSet(sec);
+            if(flag2)
+                multiUseSet();
+            this->flag1=flag1;
+            this->sec=sec;
+            this->flag2=flag2;
+            struct sockaddr_in k;
+	        memset(&k,0,sizeof(k));
+	        k.sin_family=AF_INET;
+	        k.sin_addr.s_addr=htonl(INADDR_ANY);
+	        k.sin_port=htons(port);
+	        if(bind(fd,(struct sockaddr*)&k,sizeof(k))!=0)//成
+	        {
+		        perror("bind");
+		        close(fd);
+	        }
+        }
+    }
+    bool stt::network::UdpServer::createFD(const int &port,const bool &flag1,const int &sec,const bool &flag2)
+    {
+        if(fd!=-1)
+            close();
+        fd=socket(AF_INET,SOCK_DGRAM,0);
+        if(fd<0)
+        {
+            cerr<<" udp fd failed"<<endl;;
+            fd=-1;
+            return false;
+        }
+        else
+        {
+            if(flag1)
+                unblockSet();
+            else
+                blockSet(sec);
+            if(flag2)
+                multiUseSet();
+            this->flag1=flag1;
+            this->sec=sec;
+            this->flag2=flag2;
+            struct sockaddr_in k;
+	        memset(&k,0,sizeof(k));
+	        k.sin_family=AF_INET;
+	        k.sin_addr.s_addr=htonl(INADDR_ANY);
+	        k.sin_port=htons(port);
+	        if(bind(fd,(struct sockaddr*)&k,sizeof(k))!=0)//成
+	        {
+		        perror("bind");
+		        close(fd);
+                return false;
+	        }
+        }
+        return true;
+    }
+    
+    
+    bool stt::network::HttpClient::getRequest(const string &url,const string &header,const string &header1,const int &sec)
+    {
+        this->flag=false;
+        this->header="";
+        this->body="";
+        string ip;
+        int port;
+        string locPara;
+        HttpStringUtil::getIP(url,ip);
+        HttpStringUtil::getPort(url,port);
+        HttpStringUtil::getLocPara(url,locPara);
+        blockSet(sec);
+        if(!isConnect()||getServerIP()!=ip||getServerPort()!=port)//没有连接或者服务器变更需要重新连接
+        {
+            if(isConnect())//如果是变更服务器 需要先关闭原有的连接
+            {
+                if(!close())
+                {
+                    cerr<<"http无法关闭前一个连接"<<endl;
+                    return false;
+                }
+            }
+            blockSet(sec);
+            if(!connect(ip,port))
+            {
+                cerr<<"http无法连接到服务器"<<endl;
+                return false;
+            }
+        }
+
+        //连接到服务器完成，后面进行发送请求报文操作
+
+        //拼接报文
+        string ss;
+        ss="GET "+locPara+" HTTP/1.1\r\n"\
+            +"Host: "+ip+":"+to_string(port)+"\r\n"\
+            +header1+"\r\n"\
+            +header+"\r\n";
+
+        //发送
+        if(sendData(ss)!=ss.length())
+            return false;
+        //接收
+        string totalRecv="";
+        string recv;
+        while(totalRecv.find("\r\n\r\n")==string::npos)
+        {
+            if(recvData(recv,1024)<=0)
+            {
+                flag=false;
+                this->header="";
+                body="";
+                return true;
+            }
+            totalRecv+=recv;
+        }
+        auto pos=totalRecv.find("\r\n\r\n");
+        recv.clear();
+        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
+        {
+            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
+            {
+                if(recvData(recv,1024)<=0)
+                {
+                    flag=false;
+                    body="";
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                totalRecv+=recv;
+            }
+            //cout<<totalRecv<<endl;
+            string size;
+            int ssize;
+            string chunk;
+            auto ppos=pos+2;
+            while(1)
+            {
+                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                ppos=totalRecv.find("\r\n",ppos+2);
+                //cout<<size<<endl;
+                NumberStringConvertUtil::str16toInt(size,ssize);
+                if(ssize==-1)
+                {
+                    flag=false;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    body="";
+                    return true;
+                }
+                else if(ssize==0)
+                {
+                    flag=true;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                else//读取数据
+                {
+                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                    chunk=totalRecv.substr(ppos+2,ssize);
+                    body+=chunk;
+                    ppos=ppos+2+ssize;
+                }
+            }
+        }
+        else//按照指定字节接收
+        {
+            int hasReceived=totalRecv.length()-(pos+4);
+            string size;
+            int ssize;
+            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
+            NumberStringConvertUtil::toInt(size,ssize);
+            if(ssize==-1)
+            {
+                flag=true;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                body="";
+                return true;
+            }
+            else if(ssize==0)
+            {
+                flag=true;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                body="";
+                return true;
+            }
+            else
+            {
+                if(ssize-hasReceived<=0)
+                {
+                    body=totalRecv.substr(pos);
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    flag=true;
+                    return true;
+                }
+                else
+                {  
+                    if(recvDataByLength(recv,ssize-hasReceived,sec)<=0)
+                    {
+                        flag=false;
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        body="";
+                        return true;
+                    }
+                    else
+                    {
+                        totalRecv+=recv;
+                        body=totalRecv.substr(pos);
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        flag=true;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    bool stt::network::HttpClient::getRequestFromFD(const int &fd,SSL *ssl,const string &url,const string &header,const string &header1,const int &sec)
+    {
+        this->flag=false;
+        this->header="";
+        this->body="";
+        string ip;
+        int port;
+        string locPara;
+        HttpStringUtil::getIP(url,ip);
+        HttpStringUtil::getPort(url,port);
+        HttpStringUtil::getLocPara(url,locPara);
+        TcpFDHandler k;
+        k.setFD(fd,ssl,false,false,sec);
+        k.blockSet(sec);
+        //套上套接字完成，后面进行发送请求报文操作
+
+        //拼接报文
+        string ss;
+        ss="GET "+locPara+" HTTP/1.1\r\n"\
+            +"Host: "+ip+":"+to_string(port)+"\r\n"\
+            +header1+"\r\n"\
+            +header+"\r\n";
+
+        //发送
+        if(k.sendData(ss)!=ss.length())
+            return false;
+        //接收
+        string totalRecv="";
+        string recv;
+        while(totalRecv.find("\r\n\r\n")==string::npos)
+        {
+            if(k.recvData(recv,1024)<=0)
+            {
+                flag=false;
+                this->header="";
+                body="";
+                return true;
+            }
+            totalRecv+=recv;
+        }
+        auto pos=totalRecv.find("\r\n\r\n");
+        recv.clear();
+        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
+        {
+            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
+            {
+                if(recvData(recv,1024)<=0)
+                {
+                    flag=false;
+                    body="";
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                totalRecv+=recv;
+            }
+            //cout<<totalRecv<<endl;
+            string size;
+            int ssize;
+            string chunk;
+            auto ppos=pos+2;
+            while(1)
+            {
+                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                ppos=totalRecv.find("\r\n",ppos+2);
+                //cout<<size<<endl;
+                NumberStringConvertUtil::str16toInt(size,ssize);
+                if(ssize==-1)
+                {
+                    flag=false;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    body="";
+                    return true;
+                }
+                else if(ssize==0)
+                {
+                    flag=true;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                else//读取数据
+                {
+                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                    chunk=totalRecv.substr(ppos+2,ssize);
+                    body+=chunk;
+                    ppos=ppos+2+ssize;
+                }
+            }
+        }
+        else//按照指定字节接收
+        {
+            int hasReceived=totalRecv.length()-(pos+4);
+            string size;
+            int ssize;
+            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
+            NumberStringConvertUtil::toInt(size,ssize);
+            if(ssize==-1)
+            {
+                flag=true;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                body="";
+                return true;
+            }
+            else if(ssize==0)
+            {
+                flag=true;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                body="";
+                return true;
+            }
+            else
+            {
+                if(ssize-hasReceived<=0)
+                {
+                    body=totalRecv.substr(pos);
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    flag=true;
+                    return true;
+                }
+                else
+                {  
+                    if(k.recvDataByLength(recv,ssize-hasReceived,sec)<=0)
+                    {
+                        flag=false;
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        body="";
+                        return true;
+                    }
+                    else
+                    {
+                        totalRecv+=recv;
+                        body=totalRecv.substr(pos);
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        flag=true;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    bool stt::network::HttpClient::postRequest(const string &url,const string &body,const string &header,const string &header1,const int &sec)
+    {
+        this->flag=false;
+        this->header="";
+        this->body="";
+        string ip;
+        int port;
+        string locPara;
+        HttpStringUtil::getIP(url,ip);
+        HttpStringUtil::getPort(url,port);
+        HttpStringUtil::getLocPara(url,locPara);
+        blockSet(sec);
+        if(!isConnect()||getServerIP()!=ip||getServerPort()!=port)//没有连接或者服务器变更需要重新连接
+        {
+            if(isConnect())//如果是变更服务器 需要先关闭原有的连接
+            {
+                if(!close())
+                {
+                    cerr<<"http无法关闭前一个连接"<<endl;
+                    return false;
+                }
+            }
+            blockSet(sec);
+            if(!connect(ip,port))
+            {
+                //cout<<ip<<endl;
+                //cout<<port<<endl;
+                cerr<<"http无法连接到服务器"<<endl;
+                return false;
+            }
+        }
+
+        //连接到服务器完成，后面进行发送请求报文操作
+
+        //拼接报文
+        string ss;
+        ss="POST "+locPara+" HTTP/1.1\r\n"\
+            +"Host: "+ip+":"+to_string(port)+"\r\n"\
+            +"Content-Length: "+to_string(body.length())+"\r\n"\
+            +header1+"\r\n"\
+            +header+"\r\n"\
+            +body;
+
+        //发送
+        if(sendData(ss)!=ss.length())
+            return false;
+        //接收
+        string totalRecv="";
+        string recv;
+        while(recv.find("\r\n\r\n")==string::npos)
+        {
+            if(recvData(recv,1024)<=0)
+            {
+                flag=false;
+                this->header="";
+                this->body="";
+                return true;
+            }
+            totalRecv+=recv;
+        }
+        auto pos=totalRecv.find("\r\n\r\n");
+
+        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
+        {
+            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
+            {
+                if(recvData(recv,1024)<=0)
+                {
+                    flag=false;
+                    this->body="";
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                totalRecv+=recv;
+            }
+            //cout<<totalRecv<<endl;
+            string size;
+            int ssize;
+            string chunk;
+            auto ppos=pos+2;
+            while(1)
+            {
+                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                ppos=totalRecv.find("\r\n",ppos+2);
+                //cout<<size<<endl;
+                NumberStringConvertUtil::str16toInt(size,ssize);
+                if(ssize==-1)
+                {
+                    flag=false;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    this->body="";
+                    return true;
+                }
+                else if(ssize==0)
+                {
+                    flag=true;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                else//读取数据
+                {
+                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                    chunk=totalRecv.substr(ppos+2,ssize);
+                    this->body+=chunk;
+                    ppos=ppos+2+ssize;
+                }
+            }
+        }
+        else//按照指定字节接收
+        {
+            int hasReceived=totalRecv.length()-(pos+4);
+            string size;
+            int ssize;
+            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
+            NumberStringConvertUtil::toInt(size,ssize);
+            if(ssize==-1)
+            {
+                flag=false;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                this->body="";
+                return true;
+            }
+            else if(ssize==0)
+            {
+                flag=true;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                this->body="";
+                return true;
+            }
+            else
+            {
+                if(ssize-hasReceived<=0)
+                {
+                    this->body=totalRecv.substr(pos);
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    flag=true;
+                    return true;
+                }
+                else
+                {
+                    if(recvDataByLength(recv,ssize-hasReceived,sec)<=0)
+                    {
+                        flag=false;
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        this->body="";
+                        return true;
+                    }
+                    else
+                    {
+                        totalRecv+=recv;
+                        this->body=totalRecv.substr(pos);
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        flag=true;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    bool stt::network::HttpClient::postRequestFromFD(const int &fd,SSL *ssl,const string &url,const string &body,const string &header,const string &header1,const int &sec)
+    {
+        this->flag=false;
+        this->header="";
+        this->body="";
+        string ip;
+        int port;
+        string locPara;
+        HttpStringUtil::getIP(url,ip);
+        HttpStringUtil::getPort(url,port);
+        HttpStringUtil::getLocPara(url,locPara);
+        TcpFDHandler k;
+        k.setFD(fd,ssl,false,false,sec);
+        k.blockSet(sec);
+        //套上套接字完成，后面进行发送请求报文操作
+
+        //拼接报文
+        string ss;
+        ss="POST "+locPara+" HTTP/1.1\r\n"\
+            +"Host: "+ip+":"+to_string(port)+"\r\n"\
+            +"Content-Length: "+to_string(body.length())+"\r\n"\
+            +header1+"\r\n"\
+            +header+"\r\n"\
+            +body;
+
+        //发送
+        if(k.sendData(ss)!=ss.length())
+            return false;
+        //接收
+        string totalRecv="";
+        string recv;
+        while(recv.find("\r\n\r\n")==string::npos)
+        {
+            if(k.recvData(recv,1024)<=0)
+            {
+                flag=false;
+                this->header="";
+                this->body="";
+                return true;
+            }
+            totalRecv+=recv;
+        }
+        auto pos=totalRecv.find("\r\n\r\n");
+
+        if(totalRecv.find("Transfer-Encoding: chunked")!=string::npos)//chunked先全部接受完
+        {
+            while(totalRecv.find("0\r\n\r\n",pos)==string::npos)
+            {
+                if(recvData(recv,1024)<=0)
+                {
+                    flag=false;
+                    this->body="";
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                totalRecv+=recv;
+            }
+            //cout<<totalRecv<<endl;
+            string size;
+            int ssize;
+            string chunk;
+            auto ppos=pos+2;
+            while(1)
+            {
+                HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                ppos=totalRecv.find("\r\n",ppos+2);
+                //cout<<size<<endl;
+                NumberStringConvertUtil::str16toInt(size,ssize);
+                if(ssize==-1)
+                {
+                    flag=false;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    this->body="";
+                    return true;
+                }
+                else if(ssize==0)
+                {
+                    flag=true;
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    return true;
+                }
+                else//读取数据
+                {
+                    //chunk=HttpStringUtil::get_split_str(totalRecv,size,"\r\n","\r\n",ppos);
+                    chunk=totalRecv.substr(ppos+2,ssize);
+                    this->body+=chunk;
+                    ppos=ppos+2+ssize;
+                }
+            }
+        }
+        else//按照指定字节接收
+        {
+            int hasReceived=totalRecv.length()-(pos+4);
+            string size;
+            int ssize;
+            HttpStringUtil::get_split_str(totalRecv,size,"Content-Length: ","\r\n");
+            NumberStringConvertUtil::toInt(size,ssize);
+            if(ssize==-1)
+            {
+                flag=false;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                this->body="";
+                return true;
+            }
+            else if(ssize==0)
+            {
+                flag=true;
+                totalRecv.erase(pos);
+                this->header=totalRecv;
+                this->body="";
+                return true;
+            }
+            else
+            {
+                if(ssize-hasReceived<=0)
+                {
+                    this->body=totalRecv.substr(pos);
+                    totalRecv.erase(pos);
+                    this->header=totalRecv;
+                    flag=true;
+                    return true;
+                }
+                else
+                {
+                    if(k.recvDataByLength(recv,ssize-hasReceived,sec)<=0)
+                    {
+                        flag=false;
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        this->body="";
+                        return true;
+                    }
+                    else
+                    {
+                        totalRecv+=recv;
+                        this->body=totalRecv.substr(pos);
+                        totalRecv.erase(pos);
+                        this->header=totalRecv;
+                        flag=true;
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    stt::network::RecvBufferPool::SizeClass stt::network::RecvBufferPool::classes[stt::network::RecvBufferPool::CLASS_NUM];
+    stt::network::RecvBufferPool::FreeList stt::network::RecvBufferPool::freeLists[stt::network::RecvBufferPool::MAX_NODES][stt::network::RecvBufferPool::CLASS_NUM];
+    std::atomic<uint64_t> stt::network::RecvBufferPool::bytesInUse{0};
+    std::atomic<uint64_t> stt::network::RecvBufferPool::bytesHighWater{0};
+    std::atomic<size_t> stt::network::RecvBufferPool::cacheLimit{64*1024*1024};
+    int stt::network::RecvBufferPool::classOf(const unsigned long &size)
+    {
+        for(int ii=0;ii<CLASS_NUM;ii++)
+        {
+            if(size<=classSize(ii))
+                return ii;
+        }
+        return -1;//超过最大一级
+    }
+    int stt::network::RecvBufferPool::nodeIndex()
+    {
+        //只有一个节点的机器上不用每次都查当前CPU
+        static const bool numa=stt::system::CPUAffinity::nodeCount()>1;
+        if(!numa)
+            return 0;
+        return stt::system::CPUAffinity::currentNode()%MAX_NODES;
+    }
+    char* stt::network::RecvBufferPool::acquire(const unsigned long &size,unsigned long &cap)
+    {
+        int cls=classOf(size);
+        char *buffer=nullptr;
+        if(cls==-1)//太大了 不走池
+        {
+            cap=size;
+            buffer=new char[cap];
+        }
+        else
+        {
+            cap=classSize(cls);
+            SizeClass &c=classes[cls];
+            FreeList &f=freeLists[nodeIndex()][cls];
+            {
+                std::lock_guard<std::mutex> lock(f.mtx);
+                if(!f.buffers.empty())
+                {
+                    buffer=f.buffers.back();
+                    f.buffers.pop_back();
+                }
+            }
+            if(buffer==nullptr)
+                buffer=new char[cap];
+            uint64_t now=++c.inUse;
+            uint64_t old=c.highWater;
+            while(now>old&&!c.highWater.compare_exchange_weak(old,now));
+        }
+        uint64_t now=(bytesInUse+=cap);
+        uint64_t old=bytesHighWater;
+        while(now>old&&!bytesHighWater.compare_exchange_weak(old,now));
+        return buffer;
+    }
+    void stt::network::RecvBufferPool::release(char *buffer,const unsigned long &cap)
+    {
+        if(buffer==nullptr)
+            return;
+        bytesInUse-=cap;
+        int cls=classOf(cap);
+        if(cls==-1||classSize(cls)!=cap)//不是池里的尺寸
+        {
+            delete[] buffer;
+            return;
+        }
+        --classes[cls].inUse;
+        //还到当前线程所在节点的链表 reactor拿和还都在自己的节点上
+        FreeList &f=freeLists[nodeIndex()][cls];
+        {
+            std::lock_guard<std::mutex> lock(f.mtx);
+            if((f.buffers.size()+1)*cap<=cacheLimit)
+            {
+                f.buffers.push_back(buffer);
+                return;
+            }
+        }
+        delete[] buffer;
+    }
+    void stt::network::RecvBufferPool::reserve(TcpFDInf &inf,const unsigned long &need)
+    {
+        if(inf.buffer!=nullptr&&inf.buffer_cap>=need)
+            return;
+        unsigned long cap;
+        char *buffer=acquire(need,cap);
+        if(inf.buffer!=nullptr)
+        {
+            if(inf.p_buffer_now>0)
+                memcpy(buffer,inf.buffer,inf.p_buffer_now);
+            release(inf.buffer,inf.buffer_cap);
+        }
+        inf.buffer=buffer;
+        inf.buffer_cap=cap;
+    }
+    void stt::network::RecvBufferPool::recycle(TcpFDInf &inf)
+    {
+        if(inf.buffer==nullptr||inf.p_buffer_now!=0)
+            return;
+        release(inf.buffer,inf.buffer_cap);
+        inf.buffer=nullptr;
+        inf.buffer_cap=0;
+        inf.data=std::string_view();
+    }
+    std::vector<stt::network::RecvBufferPool::ClassStat> stt::network::RecvBufferPool::getStats()
+    {
+        std::vector<ClassStat> stats;
+        for(int ii=0;ii<CLASS_NUM;ii++)
+        {
+            ClassStat st;
+            st.size=classSize(ii);
+            st.inUse=classes[ii].inUse;
+            st.highWater=classes[ii].highWater;
+            st.cached=0;
+            for(int jj=0;jj<MAX_NODES;jj++)
+            {
+                std::lock_guard<std::mutex> lock(freeLists[jj][ii].mtx);
+                st.cached+=freeLists[jj][ii].buffers.size();
+            }
+            stats.push_back(st);
+        }
+        return stats;
+    }
+    void stt::network::TimingWheel::place(const uint64_t &key,Node &node)
+    {
+        //按离现在还有多远选层 超出最高层范围的先放在最高层最远的位置 到时候再重新放置
+        uint64_t expire=node.expire<=current?current:node.expire;
+        uint64_t delta=expire-current;
+        int level=0;
+        while(level<LEVEL_NUM-1&&delta>=(1ULL<<(SLOT_BITS*(level+1))))
+            ++level;
+        if(delta>=(1ULL<<(SLOT_BITS*LEVEL_NUM)))
+            expire=current+(1ULL<<(SLOT_BITS*LEVEL_NUM))-1;
+        node.level=level;
+        node.slot=(expire>>(SLOT_BITS*level))&(SLOT_NUM-1);
+        std::list<uint64_t> &l=slots[level][node.slot];
+        node.it=l.insert(l.end(),key);
+    }
+    void stt::network::TimingWheel::cascade(const int &level,const int &slot)
+    {
+        std::list<uint64_t> l;
+        l.swap(slots[level][slot]);
+        for(auto &key:l)
+            place(key,nodes[key]);
+    }
+    void stt::network::TimingWheel::set(const uint64_t &key,const uint64_t &ticks,const uint64_t &tag)
+    {
+        std::lock_guard<std::mutex> lock(lw);
+        uint64_t expire=current+(ticks==0?1:ticks);
+        auto ii=nodes.find(key);
+        if(ii!=nodes.end())
+        {
+            Node &node=ii->second;
+            node.tag=tag;
+            if(expire>=node.expire)//往后推迟 只改记录 O(1)
+            {
+                node.expire=expire;
+                return;
+            }
+            slots[node.level][node.slot].erase(node.it);
+            node.expire=expire;
+            place(key,node);
+            return;
+        }
+        Node &node=nodes[key];
+        node.expire=expire;
+        node.tag=tag;
+        place(key,node);
+    }
+    bool stt::network::TimingWheel::remove(const uint64_t &key)
+    {
+        std::lock_guard<std::mutex> lock(lw);
+        auto ii=nodes.find(key);
+        if(ii==nodes.end())
+            return false;
+        slots[ii->second.level][ii->second.slot].erase(ii->second.it);
+        nodes.erase(ii);
+        return true;
+    }
+    void stt::network::TimingWheel::advance(const uint64_t &ticks,std::vector<Expired> &expired)
+    {
+        std::lock_guard<std::mutex> lock(lw);
+        for(uint64_t tt=0;tt<ticks;tt++)
+        {
+            ++current;
+            //低层转完一圈 先把高层对应的槽往下放
+            if((current&(SLOT_NUM-1))==0)
+            {
+                int top=1;
+                while(top<LEVEL_NUM-1&&((current>>(SLOT_BITS*top))&(SLOT_NUM-1))==0)
+                    ++top;
+                for(int level=top;level>=1;level--)
+                    cascade(level,(current>>(SLOT_BITS*level))&(SLOT_NUM-1));
+            }
+            std::list<uint64_t> l;
+            l.swap(slots[0][current&(SLOT_NUM-1)]);
+            for(auto &key:l)
+            {
+                auto ii=nodes.find(key);
+                if(ii->second.expire<=current)
+                {
+                    expired.push_back(Expired{key,ii->second.tag});
+                    nodes.erase(ii);
+                }
+                else//被推迟过 放到新的位置
+                    place(key,ii->second);
+            }
+        }
+    }
+    size_t stt::network::TimingWheel::size()
+    {
+        std::lock_guard<std::mutex> lock(lw);
+        return nodes.size();
+    }
+    bool stt::network::IoUring::init(const unsigned &entries,const unsigned &cqEntries)
+    {
+        if(ringFD!=-1)
+            return false;
+        io_uring_params p;
+        memset(&p,0,sizeof(p));
+        p.flags=IORING_SETUP_CQSIZE;
+        p.cq_entries=cqEntries;
+        ringFD=syscall(__NR_io_uring_setup,entries,&p);
+        if(ringFD<0)
+        {
+            ringFD=-1;
+            return false;
+        }
+        //EXT_ARG(5.11)用于带超时的等待 RSRC_TAGS和multishot poll同在5.13引入
+        if(!(p.features&IORING_FEAT_EXT_ARG)||!(p.features&IORING_FEAT_RSRC_TAGS)||!(p.features&IORING_FEAT_NODROP))
+        {
+            close();
+            return false;
+        }
+        sqSize=p.sq_off.array+p.sq_entries*sizeof(unsigned);
+        cqSize=p.cq_off.cqes+p.cq_entries*sizeof(io_uring_cqe);
+        bool single=p.features&IORING_FEAT_SINGLE_MMAP;
+        if(single)
+        {
+            if(cqSize>sqSize)
+                sqSize=cqSize;
+            cqSize=sqSize;
+        }
+        sqPtr=mmap(nullptr,sqSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFD,IORING_OFF_SQ_RING);
+        if(sqPtr==MAP_FAILED)
+        {
+            sqPtr=nullptr;
+            close();
+            return false;
+        }
+        if(single)
+            cqPtr=sqPtr;
+        else
+        {
+            cqPtr=mmap(nullptr,cqSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFD,IORING_OFF_CQ_RING);
+            if(cqPtr==MAP_FAILED)
+            {
+                cqPtr=nullptr;
+                close();
+                return false;
+            }
+        }
+        sqesSize=p.sq_entries*sizeof(io_uring_sqe);
+        void *ptr=mmap(nullptr,sqesSize,PROT_READ|PROT_WRITE,MAP_SHARED|MAP_POPULATE,ringFD,IORING_OFF_SQES);
+        if(ptr==MAP_FAILED)
+        {
+            close();
+            return false;
+        }
+        sqes=(io_uring_sqe*)ptr;
+        char *sq=(char*)sqPtr;
+        sqHead=(unsigned*)(sq+p.sq_off.head);
+        sqTail=(unsigned*)(sq+p.sq_off.tail);
+        sqMask=(unsigned*)(sq+p.sq_off.ring_mask);
+        sqArray=(unsigned*)(sq+p.sq_off.array);
+        sqEntries=p.sq_entries;
+        char *cq=(char*)cqPtr;
+        cqHead=(unsigned*)(cq+p.cq_off.head);
+        cqTail=(unsigned*)(cq+p.cq_off.tail);
+        cqMask=(unsigned*)(cq+p.cq_off.ring_mask);
+        cqes=(io_uring_cqe*)(cq+p.cq_off.cqes);
+        listenFD=-1;
+        multishotAccept=true;
+        acceptedFD.clear();
+        return true;
+    }
+    void stt::network::IoUring::close()
+    {
+        if(sqes!=nullptr)
+        {
+            munmap(sqes,sqesSize);
+            sqes=nullptr;
+        }
+        if(cqPtr!=nullptr&&cqPtr!=sqPtr)
+            munmap(cqPtr,cqSize);
+        cqPtr=nullptr;
+        if(sqPtr!=nullptr)
+        {
+            munmap(sqPtr,sqSize);
+            sqPtr=nullptr;
+        }
+        if(ringFD!=-1)
+        {
+            ::close(ringFD);//关闭环会取消上面所有的请求
+            ringFD=-1;
+        }
+    }
+    io_uring_sqe* stt::network::IoUring::getSQE()
+    {
+        //调用者持有lsq
+        unsigned head=__atomic_load_n(sqHead,__ATOMIC_ACQUIRE);
+        unsigned tail=*sqTail;
+        if(tail-head>=sqEntries)//满了 每次准备完都会立刻提交 正常不会出现
+            return nullptr;
+        io_uring_sqe *sqe=&sqes[tail&*sqMask];
+        memset(sqe,0,sizeof(io_uring_sqe));
+        return sqe;
+    }
+    bool stt::network::IoUring::submit()
+    {
+        //调用者持有lsq 发布getSQE拿到的那一项并且交给内核
+        unsigned tail=*sqTail;
+        sqArray[tail&*sqMask]=tail&*sqMask;
+        __atomic_store_n(sqTail,tail+1,__ATOMIC_RELEASE);
+        unsigned pending=tail+1-__atomic_load_n(sqHead,__ATOMIC_ACQUIRE);
+        int ret;
+        do
+        {
+            ret=syscall(__NR_io_uring_enter,ringFD,pending,0,0,nullptr,0);
+        }while(ret<0&&errno==EINTR);
+        //EBUSY/EAGAIN时条目留在提交队列里 下一次提交会一起交给内核
+        return ret>=0||errno==EBUSY||errno==EAGAIN;
+    }
+    bool stt::network::IoUring::prepPoll(const int &fd,const uint32_t &events,const uint32_t &tag)
+    {
+        io_uring_sqe *sqe=getSQE();
+        if(sqe==nullptr)
+            return false;
+        sqe->opcode=IORING_OP_POLL_ADD;
+        sqe->fd=fd;
+        sqe->len=IORING_POLL_ADD_MULTI;
+        sqe->poll32_events=events&~EPOLLET;//poll本身就是按唤醒通知 没有ET标志
+        sqe->user_data=((uint64_t)(tag&TAG_MASK)<<32)|(uint32_t)fd;
+        return submit();
+    }
+    bool stt::network::IoUring::prepAccept()
+    {
+        if(!multishotAccept)//内核不支持multishot accept 退回poll监听套接字
+            return prepPoll(listenFD,EPOLLIN);
+        io_uring_sqe *sqe=getSQE();
+        if(sqe==nullptr)
+            return false;
+        sqe->opcode=IORING_OP_ACCEPT;
+        sqe->fd=listenFD;
+        sqe->ioprio=IORING_ACCEPT_MULTISHOT;
+        sqe->accept_flags=SOCK_NONBLOCK|SOCK_CLOEXEC;
+        sqe->user_data=ACCEPT_TAG|(uint32_t)listenFD;
+        return submit();
+    }
+    bool stt::network::IoUring::addFD(const int &fd,const uint32_t &events,const uint32_t &tag)
+    {
+        std::lock_guard<std::mutex> lock(lsq);
+        if(ringFD==-1)
+            return false;
+        return prepPoll(fd,events,tag);
+    }
+    bool stt::network::IoUring::addWriteWatch(const int &fd,const uint32_t &tag)
+    {
+        std::lock_guard<std::mutex> lock(lsq);
+        if(ringFD==-1)
+            return false;
+        io_uring_sqe *sqe=getSQE();
+        if(sqe==nullptr)
+            return false;
+        sqe->opcode=IORING_OP_POLL_ADD;
+        sqe->fd=fd;
+        sqe->len=0;//一次性 可写一次就失效
+        sqe->poll32_events=EPOLLOUT;
+        sqe->user_data=WRITE_TAG|((uint64_t)(tag&TAG_MASK)<<32)|(uint32_t)fd;
+        return submit();
+    }
+    bool stt::network::IoUring::removeFD(const int &fd,const uint32_t &tag)
+    {
+        std::lock_guard<std::mutex> lock(lsq);
+        if(ringFD==-1)
+            return false;
+        //读事件的multishot登记和可能还在等待的可写登记都要取消 没有的那个会以-ENOENT完成
+        uint64_t data=((uint64_t)(tag&TAG_MASK)<<32)|(uint32_t)fd;
+        for(uint64_t kind:{(uint64_t)0,WRITE_TAG})
+        {
+            io_uring_sqe *sqe=getSQE();
+            if(sqe==nullptr)
+                return false;
+            sqe->opcode=IORING_OP_POLL_REMOVE;
+            sqe->fd=-1;
+            sqe->addr=kind|data;//要取消的请求的user_data
+            sqe->user_data=CANCEL_TAG|kind|data;
+            if(!submit())
+                return false;
+        }
+        return true;
+    }
+    bool stt::network::IoUring::addAccept(const int &fd)
+    {
+        std::lock_guard<std::mutex> lock(lsq);
+        if(ringFD==-1)
+            return false;
+        listenFD=fd;
+        acceptStopped=false;
+        return prepAccept();
+    }
+    bool stt::network::IoUring::removeAccept()
+    {
+        std::lock_guard<std::mutex> lock(lsq);
+        if(ringFD==-1||listenFD==-1||acceptStopped)
+            return false;
+        acceptStopped=true;//之后multishot结束也不再重新登记
+        io_uring_sqe *sqe=getSQE();
+        if(sqe==nullptr)
+            return false;
+        if(multishotAccept)
+        {
+            sqe->opcode=IORING_OP_ASYNC_CANCEL;
+            sqe->addr=ACCEPT_TAG|(uint32_t)listenFD;
+        }
+        else
+        {
+            sqe->opcode=IORING_OP_POLL_REMOVE;
+            sqe->addr=(uint32_t)listenFD;
+        }
+        sqe->fd=-1;
+        sqe->user_data=CANCEL_TAG|ACCEPT_TAG|(uint32_t)listenFD;
+        return submit();
+    }
+    int stt::network::IoUring::wait(epoll_event *evs,const int &maxevents,const int &timeout)
+    {
+        unsigned head=*cqHead;
+        unsigned tail=__atomic_load_n(cqTail,__ATOMIC_ACQUIRE);
+        if(head==tail&&timeout!=0)//没有现成的事件才进内核等
+        {
+            __kernel_timespec ts;
+            ts.tv_sec=timeout/1000;
+            ts.tv_nsec=(timeout%1000)*1000000LL;
+            io_uring_getevents_arg arg;
+            memset(&arg,0,sizeof(arg));
+            arg.ts=(uint64_t)&ts;
+            int ret=syscall(__NR_io_uring_enter,ringFD,0,1,IORING_ENTER_GETEVENTS|IORING_ENTER_EXT_ARG,&arg,sizeof(arg));
+            if(ret<0&&errno!=ETIME&&errno!=EINTR&&errno!=EBUSY)
+                return -1;
+            tail=__atomic_load_n(cqTail,__ATOMIC_ACQUIRE);
+        }
+        int n=0;
+        bool rearmAccept=false;
+        std::vector<uint64_t> rearm;
+        while(head!=tail&&n<maxevents)
+        {
+            io_uring_cqe *cqe=&cqes[head&*cqMask];
+            uint64_t data=cqe->user_data;
+            int res=cqe->res;
+            bool more=cqe->flags&IORING_CQE_F_MORE;
+            ++head;
+            if(data&CANCEL_TAG)//取消请求自己的完成事件
+                continue;
+            if(data&ACCEPT_TAG)
+            {
+                if(res>=0)
+                    acceptedFD.push_back(res);
+                else if(res==-EINVAL)//内核不支持multishot accept
+                    multishotAccept=false;
+                if(!more)
+                    rearmAccept=true;
+                continue;
+            }
+            int fd=(int)(uint32_t)data;
+            if(res<0)//请求被取消或者fd已经失效 不用再登记
+                continue;
+            if(data&WRITE_TAG)//一次性的可写登记 不用重新登记
+            {
+                evs[n].data.u64=data&~WRITE_TAG;
+                evs[n].events=EPOLLOUT|(res&(EPOLLERR|EPOLLHUP));
+                ++n;
+                continue;
+            }
+            if(!multishotAccept&&fd==listenFD)
+            {
+                if(!more&&!acceptStopped)
+                    rearmAccept=true;
+            }
+            else if(!more)//multishot被内核终止（比如完成队列溢出） 需要重新登记
+                rearm.push_back(data);
+            evs[n].data.u64=data;//高32位带着登记时的标记
+            evs[n].events=res;
+            ++n;
+        }
+        __atomic_store_n(cqHead,head,__ATOMIC_RELEASE);
+        if(rearmAccept||!rearm.empty())
+        {
+            std::lock_guard<std::mutex> lock(lsq);
+            if(rearmAccept&&!acceptStopped)
+                prepAccept();
+            for(auto &data:rearm)
+                prepPoll((int)(uint32_t)data,EPOLLIN|EPOLLRDHUP,(uint32_t)(data>>32));
+        }
+        return n;
+    }
+    void stt::network::TcpServer::putTask(const std::function<int(TcpFDHandler &k,TcpInformation &inf)> &fun,TcpFDHandler &k,TcpInformation &inf)
+    {
+        //完成结果回到负责这个连接的reactor
+        ReactorInf *r=reactorInf[clientfd[inf.fd].reactor].get();
+        int cfd=inf.fd;//任务完成后inf可能已经随连接释放 先拷贝fd
+        auto task=[r,cfd,k,&inf,fun]() mutable ->void
+        {
+            int ret=fun(k,inf);
+            //入队
+            r->finishQueue.push({cfd,ret});
+            //按钟
+            uint64_t one = 1;
+            write(r->workerEventFD, &one, sizeof(one));
+        };
+        if(!dispatchTask(inf.ctx,clientfd[cfd].connection_obj_fd,std::move(task)))
+        {
+            //线程组排满了或者排队时间过长 跳过这条消息
+            securitySendBackFun(k,inf);
+            r->finishQueue.push({cfd,-1});
+            uint64_t one = 1;
+            write(r->workerEventFD, &one, sizeof(one));
+        }
+    }
+    void stt::network::HttpServer::putTask(const std::function<int(HttpServerFDHandler &k,HttpRequestInformation &inf)> &fun,HttpServerFDHandler &k,HttpRequestInformation &inf)
+    {
+        //完成结果回到负责这个连接的reactor
+        ReactorInf *r=reactorInf[clientfd[inf.fd].reactor].get();
+        int cfd=inf.fd;//任务完成后inf可能已经随连接释放 先拷贝fd
+        auto task=[r,cfd,k,&inf,fun]() mutable ->void
+        {
+            int ret=fun(k,inf);
+            //入队
+            r->finishQueue.push({cfd,ret});
+            //按钟
+            uint64_t one = 1;
+            write(r->workerEventFD, &one, sizeof(one));
+        };
+        if(!dispatchTask(inf.ctx,clientfd[cfd].connection_obj_fd,std::move(task)))
+        {
+            //线程组排满了或者排队时间过长 马上回复并跳过这个请求
+            if(securitySendBackSet)
+                securitySendBackFun(k,inf);
+            else
+                k.sendBack("","","503 Service Unavailable");
+            r->finishQueue.push({cfd,-1});
+            uint64_t one = 1;
+            write(r->workerEventFD, &one, sizeof(one));
+        }
+    }
+    void stt::network::WebSocketServer::putTask(const std::function<int(WebSocketServerFDHandler &k,WebSocketFDInformation &inf)> &fun,WebSocketServerFDHandler &k,WebSocketFDInformation &inf)
+    {
+        //完成结果回到负责这个连接的reactor
+        ReactorInf *r=reactorInf[clientfd[inf.fd].reactor].get();
+        int cfd=inf.fd;//任务完成后inf可能已经随连接释放 先拷贝fd
+        auto task=[r,cfd,k,&inf,fun]() mutable ->void
+        {
+            int ret=fun(k,inf);
+            //入队
+            r->finishQueue.push({cfd,ret});
+            //按钟
+            uint64_t one = 1;
+            write(r->workerEventFD, &one, sizeof(one));
+        };
+        if(!dispatchTask(inf.ctx,clientfd[cfd].connection_obj_fd,std::move(task)))
+        {
+            //线程组排满了或者排队时间过长 跳过这条消息
+            securitySendBackFun(k,inf);
+            r->finishQueue.push({cfd,-1});
+            uint64_t one = 1;
+            write(r->workerEventFD, &one, sizeof(one));
+        }
+    }
+    bool stt::network::TicketKeyRing::generate(Key &key)
+    {
+        if(RAND_bytes(key.name,sizeof(key.name))<=0||RAND_bytes(key.aesKey,sizeof(key.aesKey))<=0||RAND_bytes(key.hmacKey,sizeof(key.hmacKey))<=0)
+            return false;
+        key.created=std::chrono::steady_clock::now();
+        return true;
+    }
+    bool stt::network::TicketKeyRing::current(Key &key)
+    {
+        std::lock_guard<std::mutex> lock(lk);
+        if(count==0||std::chrono::steady_clock::now()-keys[0].created>=std::chrono::seconds(interval))//还没有或者到期了
+        {
+            Key fresh;
+            if(!generate(fresh))
+                return false;
+            keys[1]=keys[0];
+            keys[0]=fresh;
+            if(count<2)
+                ++count;
+        }
+        key=keys[0];
+        return true;
+    }
+    int stt::network::TicketKeyRing::find(const unsigned char *name,Key &key)
+    {
+        std::lock_guard<std::mutex> lock(lk);
+        for(int ii=0;ii<count;ii++)
+        {
+            if(memcmp(keys[ii].name,name,sizeof(keys[ii].name))==0)
+            {
+                key=keys[ii];
+                //上一把密钥解开的票据 或者当前密钥已经过期 让OpenSSL换发新票据
+                if(ii>0||std::chrono::steady_clock::now()-keys[ii].created>=std::chrono::seconds(interval))
+                    return 2;
+                return 1;
+            }
+        }
+        return 0;
+    }
+    void stt::network::TicketKeyRing::rotate()
+    {
+        std::lock_guard<std::mutex> lock(lk);
+        Key fresh;
+        if(!generate(fresh))
+            return;
+        keys[1]=keys[0];
+        keys[0]=fresh;
+        if(count<2)
+            ++count;
+    }
+    #if OPENSSL_VERSION_NUMBER >= 0x30000000L
+    //OpenSSL签发和解开会话票据时的回调 密钥来自TicketKeyRing
+    static int ticketKeyCallback(SSL *ssl,unsigned char *name,unsigned char *iv,EVP_CIPHER_CTX *ectx,EVP_MAC_CTX *hctx,int enc)
+    {
+        stt::network::TicketKeyRing *ring=(stt::network::TicketKeyRing*)SSL_CTX_get_app_data(SSL_get_SSL_CTX(ssl));
+        if(ring==nullptr)
+            return -1;
+        stt::network::TicketKeyRing::Key key;
+        int ret=1;
+        if(enc)//签发
+        {
+            if(!ring->current(key))
+                return -1;
+            memcpy(name,key.name,sizeof(key.name));
+            if(RAND_bytes(iv,EVP_CIPHER_get_iv_length(EVP_aes_256_cbc()))<=0)
+                return -1;
+            if(EVP_EncryptInit_ex(ectx,EVP_aes_256_cbc(),nullptr,key.aesKey,iv)!=1)
+                return -1;
+        }
+        else//解开
+        {
+            ret=ring->find(name,key);
+            if(ret==0)
+                return 0;
+            if(EVP_DecryptInit_ex(ectx,EVP_aes_256_cbc(),nullptr,key.aesKey,iv)!=1)
+                return -1;
+        }
+        OSSL_PARAM params[3];
+        params[0]=OSSL_PARAM_construct_octet_string("key",key.hmacKey,sizeof(key.hmacKey));
+        params[1]=OSSL_PARAM_construct_utf8_string("digest",(char*)"SHA256",0);
+        params[2]=OSSL_PARAM_construct_end();
+        if(EVP_MAC_CTX_set_params(hctx,params)!=1)
+            return -1;
+        return ret;
+    }
+    #endif
+    bool stt::network::TcpServer::setTLS(const char *cacert,const char *key,const char *passwd,const char *ca,const long &sessionCacheSize,const long &sessionTimeout,const int &ticketKeyInterval)
+    {
+        if(TLS)
+            redrawTLS();
+        // 初始化
+        SSLeay_add_ssl_algorithms();
+        OpenSSL_add_all_algorithms();
+        SSL_load_error_strings();
+        ERR_load_BIO_strings();
+        // 我们使用SSL V3,V2
+        if((ctx = SSL_CTX_new(SSLv23_method())) == NULL)
+        {
+            cerr<<"new ctx wrong"<<endl;
+            return false;
+        }
+        //输出队列按块发送：允许SSL_write只写出一部分，WANT_WRITE之后用搬到队列里的同一份数据重试
+        SSL_CTX_set_mode(ctx,SSL_MODE_ENABLE_PARTIAL_WRITE|SSL_MODE_ACCEPT_MOVING_WRITE_BUFFER);
+        #ifdef SSL_OP_ENABLE_KTLS
+        if(ktls)//握手完成后由OpenSSL把密钥交给内核
+            SSL_CTX_set_options(ctx,SSL_OP_ENABLE_KTLS);
+        #endif
+
+        // 要求校验对方证书，这里建议使用SSL_VERIFY_FAIL_IF_NO_PEER_CERT，详见https://blog.csdn.net/u013919153/article/details/78616737
+        //对于服务器端来说如果使用的是SSL_VERIFY_PEER且服务器端没有考虑对方没交证书的情况，会出现只能访问一次，第二次访问就失败的情况。
+        SSL_CTX_set_verify(ctx, SSL_VERIFY_FAIL_IF_NO_PEER_CERT, NULL);
+
+        // 加载CA的证书
+        if(!SSL_CTX_load_verify_locations(ctx, ca, NULL))
+        {
+            cerr<<"load ca wrong"<<endl;
+            return false;
+        }
+        // 加载自己的证书
+        if(SSL_CTX_use_certificate_chain_file(ctx, cacert) <= 0)
+        {
+            cerr<<"load cert wrong"<<endl;
+            return false;
+        }
+        //assert(SSL_CTX_use_certificate_file(ctx, "cacert.pem", SSL_FILETYPE_PEM) > 0);
+        // 加载自己的私钥 
+        if(passwd!="")
+            SSL_CTX_set_default_passwd_cb_userdata(ctx, (void*)passwd);
+        if(SSL_CTX_use_PrivateKey_file(ctx, key, SSL_FILETYPE_PEM) <= 0)
+        {
+            cerr<<"load key wrong"<<endl;
+            return false;
+        }
+ 
+        // 判定私钥是否正确  
+        if(!SSL_CTX_check_private_key(ctx))
+        {
+            cerr<<"key wrong"<<endl;
+            return false;
+        }
+
+        //会话复用 重连的客户端走简化握手
+        SSL_CTX_set_session_id_context(ctx,(const unsigned char*)"sttnet",6);
+        if(sessionCacheSize>0)
+        {
+            SSL_CTX_set_session_cache_mode(ctx,SSL_SESS_CACHE_SERVER);
+            SSL_CTX_sess_set_cache_size(ctx,sessionCacheSize);//满了OpenSSL会淘汰最旧的
+        }
+        else
+            SSL_CTX_set_session_cache_mode(ctx,SSL_SESS_CACHE_OFF);
+        SSL_CTX_set_timeout(ctx,sessionTimeout);
+        if(ticketKeyInterval>0)
+        {
+            ticketKeys.setInterval(ticketKeyInterval);
+            #if OPENSSL_VERSION_NUMBER >= 0x30000000L
+            SSL_CTX_set_app_data(ctx,&ticketKeys);
+            SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx,ticketKeyCallback);
+            #endif
+        }
+        else
+            SSL_CTX_set_options(ctx,SSL_OP_NO_TICKET);
+
+        TLS=true;
+        signal(SIGPIPE,SIG_IGN);
+        return true;
+    }
+    void stt::network::TcpServer::redrawTLS()
+    {
+        if(TLS)
+        {
+            SSL_CTX_free(ctx);
+            TLS=false;
+        }
+    }
+    void stt::network::TcpServer::setKTLS(const bool &on)
+    {
+        ktls=on;
+        #ifdef SSL_OP_ENABLE_KTLS
+        if(TLS)
+        {
+            if(on)
+                SSL_CTX_set_options(ctx,SSL_OP_ENABLE_KTLS);
+            else
+                SSL_CTX_clear_options(ctx,SSL_OP_ENABLE_KTLS);
+        }
+        #else
+        if(on)
+            STT_LOG(stt::file::LogLevel::WARN,"tcp server : 当前OpenSSL不支持kTLS，继续使用用户态加密","tcp server : this OpenSSL does not support kTLS, keep encrypting in user space");
+        #endif
+    }
+    bool stt::network::TcpServer::startListen(const int &port,const int &threads,const int &reactors)
+    {
+        if(threads<=0||reactors<=0)
+            return false;
+        if(isListen())
+        {
+            //是否是改变端口的监听？
+            if(this->port==port)
+                return true;
+            else
+            {
+                stopListen();
+                flag=false;
+            }
+        }
+        //this->logfile=logfile;
+        //memset(solvingFD,0,sizeof(int)*maxFD);
+        //clientfd=new TcpFDInf[maxFD];
+        
+        //fdQueue=new queue<QueueFD>[threads];
+        //cv=new condition_variable[threads];
+        //lq1=new mutex[threads];
+        //连接表按页懒分配 只有出现过连接的页才会真正分配内存
+        clientfd.init(maxFD,[](TcpFDInf &inf)
+        {
+            inf.fd=-1;
+            inf.reactor=0;
+        });
+        handshakeState.init(maxFD);
+        this->port=port;
+        accepting=true;
+        handedOver=false;
+        //热重启：先向旧进程要监听套接字 没有旧进程再自己bind
+        fd=-1;
+        if(!hotRestartPath.empty())
+            fd=inheritListenFD(port);
+        if(fd==-1)
+        {
+            //socket准备
+            fd=socket(AF_INET,SOCK_STREAM|SOCK_CLOEXEC,0);
+            if(fd<0)
+            {
+                perror("socket");
+                return false;
+            }
+            //设置unblock和mutiuse
+            int flags=fcntl(fd,F_GETFL,0);//获取当前标志
+            fcntl(fd,F_SETFL,flags|O_NONBLOCK);
+            int opt=1;
+            if(setsockopt(fd,SOL_SOCKET,SO_REUSEADDR|SO_REUSEPORT,&opt,sizeof(opt))<0)
+            {
+                cerr<<"set multi failed"<<endl;
+                perror("setsockopt");
+                return false;
+            }
+            //bind
+            struct sockaddr_in k;
+            memset(&k,0,sizeof(k));
+            k.sin_family=AF_INET;
+            k.sin_port=htons(port);
+            k.sin_addr.s_addr=htonl(INADDR_ANY);
+            if(bind(fd,(struct sockaddr*)&k,sizeof(k))!=0)
+            {
+                perror("bind");
+                ::close(fd);
+                return false;
+            }
+            //listen
+            uint64_t backlog = maxFD / 50;  // 经验值
+            //backlog = std::clamp(backlog, 128, 4096);
+            if(backlog<128)
+                backlog=128;
+            else if(backlog>4096)
+                backlog=4096;
+            if(listen(fd,backlog)!=0)
+            {
+                perror("listen");
+                ::close(fd);
+                return false;
+            }
+        }
+        //监听套接字上的选项 accept出来的连接会继承TCP_NODELAY 不用每个连接再设置一次
+        int nodelay=noDelay?1:0;
+        setsockopt(fd,IPPROTO_TCP,TCP_NODELAY,&nodelay,sizeof(nodelay));
+        if(deferAcceptSecs>0)
+            setsockopt(fd,IPPROTO_TCP,TCP_DEFER_ACCEPT,&deferAcceptSecs,sizeof(deferAcceptSecs));
+        if(fastOpenQueue>0&&setsockopt(fd,IPPROTO_TCP,TCP_FASTOPEN,&fastOpenQueue,sizeof(fastOpenQueue))!=0)
+        {
+            STT_LOG(stt::file::LogLevel::ERROR,"tcp server : TCP Fast Open开启失败 error="+to_string(errno),"tcp server : failed to enable TCP Fast Open error="+to_string(errno));
+        }
+        //this->logfile=logfile;
+        flag1=true;
+        this->unblock=true;
+        
+        workpool=new WorkerPool(threads,workerCPUs);
+        for(auto &ii:workerGroups)
+            ii.second->pool.reset(new WorkerPool(ii.second->threads,workerCPUs,ii.second->nice));
+        //握手线程池 排队的握手数不超过handshakeLimit 所以每个reactor的握手完成队列按它取2的幂
+        size_t handshakeQueue_cap=2;
+        if(handshakeThreads>0)
+        {
+            handshakePool=new WorkerPool(handshakeThreads,workerCPUs);
+            while(handshakeQueue_cap<(size_t)handshakeLimit)
+                handshakeQueue_cap<<=1;
+        }
+        //reactor准备：epoll句柄和门铃在线程启动前建好，acceptor可以马上往里面分配连接
+        reactorNum=reactors;
+        reactorInf.clear();
+        //绑定了CPU时当前线程临时换到每个reactor的CPU上创建它的队列和事件环 首次写入的页落在reactor所在的NUMA节点上
+        std::vector<int> callerCPUs=CPUAffinity::threadCPUs();
+        for(int ii=0;ii<reactorNum;ii++)
+        {
+            if(!reactorCPUs.empty())
+                CPUAffinity::bindThread({reactorCPUs[ii%reactorCPUs.size()]});
+            reactorInf.emplace_back(new ReactorInf(ii,finishQueue_cap,handshakeQueue_cap));
+            reactorInf[ii]->workerEventFD=eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        }
+        if(engine==EventEngine::IO_URING)
+        {
+            //完成队列按每个reactor的连接数估计 multishot poll每个连接每次唤醒都产生一个完成事件
+            unsigned long long cq=maxFD/reactorNum*2;
+            if(cq<1024)
+                cq=1024;
+            else if(cq>65536)
+                cq=65536;
+            for(auto &r:reactorInf)
+            {
+                if(!reactorCPUs.empty())
+                    CPUAffinity::bindThread({reactorCPUs[r->id%reactorCPUs.size()]});
+                r->ring.reset(new IoUring());
+                if(!r->ring->init(64,cq))
+                {
+                    //内核不支持 全部回退到epoll
+                    for(auto &rr:reactorInf)
+                        rr->ring.reset();
+                    engine=EventEngine::EPOLL;
+                    STT_LOG(stt::file::LogLevel::WARN,"tcp server : 内核不支持io_uring，回退到epoll","tcp server : io_uring is not supported by the kernel, fall back to epoll");
+                    break;
+                }
+            }
+        }
+        if(engine==EventEngine::EPOLL)
+        {
+            for(auto &r:reactorInf)
+                r->epollFD=epoll_create(1);
+        }
+        if(!reactorCPUs.empty())
+            CPUAffinity::bindThread(callerCPUs);
+        //报告线程布局
+        std::string layout="nodes="+to_string(CPUAffinity::nodeCount());
+        for(int ii=0;ii<reactorNum;ii++)
+            layout+=" reactor"+to_string(ii)+"="+CPUAffinity::describe(reactorCPUs.empty()?std::vector<int>():std::vector<int>{reactorCPUs[ii%reactorCPUs.size()]});
+        if(reactorNum>1)
+            layout+=" acceptor="+CPUAffinity::describe(reactorCPUs);
+        layout+=" workers="+CPUAffinity::describe(workerCPUs);
+        for(auto &ii:workerGroups)
+            layout+=" group:"+ii.first+"="+to_string(ii.second->threads)+"threads/nice"+to_string(ii.second->nice);
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server : 线程布局 "+layout,"tcp server : thread layout "+layout);
+        connection_obj_fd=1;
+        nextReactor=0;
+        //for(int sj=0;sj<threads;sj++)
+        //    thread(&TcpServer::consumer,this,sj).detach();
+        //在path上等待下一个新进程来交接
+        int controlFD=-1;
+        if(!hotRestartPath.empty())
+            controlFD=openControlSocket();
+        loopNum=reactorNum+(reactorNum>1?1:0)+(controlFD!=-1?1:0);
+        for(int ii=0;ii<reactorNum;ii++)
+            thread(&TcpServer::epolll,this,ii).detach();
+        if(reactorNum>1)//多reactor模式 单独的acceptor线程
+            thread(&TcpServer::acceptLoop,this).detach();
+        if(controlFD!=-1)
+            thread(&TcpServer::hotRestartLoop,this,controlFD).detach();
+        //flag_detect=true;
+        //thread(&security::ConnectionLimiter::connectionDetect,&connectionLimiter).detach();
+        //this->consumerNum=threads;
+
+        flag=true;
+        //this->logfile=logfile;
+        return true;
+    }
+    bool stt::network::TcpServer::stopListen()
+    {
+        if(!isListen())
+        {
+            return true;
+        }
+        if(!handedOver)//交接出去的监听套接字新进程还在用 不能shutdown
+            shutdown(fd,SHUT_RDWR);
+        ::close(fd);
+        //随后取消掉acceptor和所有reactor线程
+        do
+        {
+            flag1=false;
+        }while(loopNum!=0);
+        //for(int ii=0;ii<consumerNum;ii++)
+        //    cv[ii].notify_all();
+        //while(consumerNum!=0||!flag2)
+        //{
+        //    flag1=false;//不断提醒关闭
+        //    for(int ii=0;ii<consumerNum;ii++)
+        //        cv[ii].notify_all();
+        //}
+        workpool->stop();
+        for(auto &ii:workerGroups)
+        {
+            if(ii.second->pool)
+                ii.second->pool->stop();
+            ii.second->pool.reset();
+        }
+        if(handshakePool!=nullptr)
+        {
+            handshakePool->stop();
+            delete handshakePool;
+            handshakePool=nullptr;
+        }
+        //worker全部退出后才能关掉reactor的门铃
+        for(auto &r:reactorInf)
+        {
+            if(r->epollFD!=-1)
+                ::close(r->epollFD);
+            r->epollFD=-1;
+            r->ring.reset();//关闭io_uring 取消上面全部登记
+            ::close(r->workerEventFD);
+        }
+        flag=false;
+        //关闭监听连接的消息活动的线程
+        //do
+        //{
+        //    flag_detect=false;
+        //}while(flag_detect_status);
+        return true;
+    }
+    bool stt::network::TcpServer::close()
+    {
+ 
+        if(isListen())
+        {
+            if(!stopListen())
+                return false;
+        }
+  
+        //unique_lock<mutex> lock2(lc1);
+        //unique_lock<mutex> lock1(ltl1);
+        //只遍历活跃连接
+        clientfd.forEachLive([this](const int &ii,TcpFDInf &inf)
+        {
+            if(this->security_open)
+                connectionLimiter.clearIP(inf.getIP(),ii);
+            //auto jj=tlsfd.find(ii.first);
+
+            if(inf.ssl!=nullptr)//这个套接字启用了tls
+            {
+                SSL_shutdown(inf.ssl);
+                SSL_free(inf.ssl);
+            }
+  
+            shutdown(ii,SHUT_RDWR);
+            ::close(ii);
+            //clientfd[ii].fd=-1;
+            //clientfd[ii].pendindQueue.clear();
+            RecvBufferPool::release(inf.buffer,inf.buffer_cap);
+            //delete clientfd[ii];
+        });
+        //std::cout<<"tcp died"<<std::endl;
+        clientfd.clear();
+        //delete[] fdQueue;
+        //delete[] lq1;
+        //delete[] cv;
+        //clientfd.clear();
+        //key.clear();
+        //functionT.clear();
+        //redrawTLS();
+        return true;
+    }
+    bool stt::network::TcpServer::close(const int &fd)
+    {
+       
+        //unique_lock<mutex> lock2(lc1);
+        //unique_lock<mutex> lock1(ltl1);
+        //auto ii=clientfd.find(fd);
+        
+        TcpFDInf *inf=clientfd.find(fd);
+        if(inf==nullptr||inf->fd==-1)
+        {
+            
+            return false;
+        }
+        //输出队列里还有没发完的数据 先不关 等reactor发完再关
+        std::shared_ptr<OutputBuffer> out=std::atomic_load(&inf->out);
+        if(out&&out->deferClose())
+            return true;
+        else
+        {
+            
+            if(this->security_open)
+                connectionLimiter.clearIP(clientfd[fd].getIP(),clientfd[fd].fd);
+            
+            //auto jj=tlsfd.find(fd);
+            
+            if(clientfd[fd].ssl!=nullptr)
+            {
+                if(clientfd[fd].tls_state != TLSState::HANDSHAKING)
+                {
+                    SSL_shutdown(clientfd[fd].ssl);
+                }
+                SSL_free(clientfd[fd].ssl);
+                clientfd[fd].ssl=nullptr;//同一批里可能还有这个fd的事件 不能留下已经释放的指针
+            }
+            
+            closeFun(clientfd[fd].fd);
+            
+            clientfd[fd].fd=-1;
+            clientfd.setLive(fd,false);
+            --reactorInf[clientfd[fd].reactor]->connections;
+            
+            RecvBufferPool::release(clientfd[fd].buffer,clientfd[fd].buffer_cap);
+            clientfd[fd].buffer=nullptr;
+            clientfd[fd].buffer_cap=0;
+            clientfd[fd].p_buffer_now=0;
+            
+            clientfd[fd].pendindQueue= std::queue<std::any>();
+            if(out)//之后还拿着这个队列的处理对象写入都会失败 不会写到复用这个fd的新连接上
+                out->close();
+            
+            //io_uring持有文件引用 必须先取消登记套接字才会真正关闭
+            ReactorInf &r=*reactorInf[clientfd[fd].reactor];
+            r.wheel.remove(((uint64_t)fd<<1)|TIMER_IDLE);
+            r.wheel.remove(((uint64_t)fd<<1)|TIMER_HEARTBEAT);
+            if(r.ring)
+                r.ring->removeFD(fd,eventTag(clientfd[fd].connection_obj_fd));
+            //最后才真正关闭fd 关闭后这个fd号可能马上被acceptor分配给新的连接
+            ::close(fd);
+            
+        }
+        
+        return true;
+    }
+    chrono::high_resolution_clock::time_point start;
+    chrono::high_resolution_clock::time_point endd;
+    chrono::microseconds duration;
+    unsigned long op=0;
+    int times=0;
+    
+    void stt::network::TcpServer::acceptConnection()
+    {
+        //用来accept的 对端地址按二进制保存
+        struct sockaddr_storage k;
+        socklen_t k_len=sizeof(k);
+        while(1)
+        {  
+
+            k_len = sizeof(k);
+            //一次系统调用拿到非阻塞的套接字 热重启启动的新进程不继承连接
+            int cfd=accept4(fd,(struct sockaddr*)&k,&k_len,SOCK_NONBLOCK|SOCK_CLOEXEC);
+            if(cfd<0)
+            {
+                if(errno==EAGAIN||errno==EWOULDBLOCK)
+                    break;//全部连接都accept了
+                if(errno==EINTR||errno==ECONNABORTED)
+                    continue;//只影响这一个连接 继续accept
+                //真的失败（监听套接字已关闭、fd耗尽等）不能原地重试 否则会空转刷日志
+                STT_LOG(stt::file::LogLevel::ERROR,"tcp server epoll:accept错误 error="+to_string(errno),"tcp server epoll:accept failed error="+to_string(errno));
+                break;
+            }
+            addConnection(cfd,&k,k_len);
+        }
+    }
+    void stt::network::TcpServer::watchFD(ReactorInf &r,const int &fd,const uint32_t &events,const uint32_t &tag)
+    {
+        //高32位放连接的标记 reactor用它丢掉已经关闭的旧连接残留的事件
+        if(r.ring)
+        {
+            r.ring->addFD(fd,events,tag);
+        }
+        else
+        {
+            epoll_event ev;
+            ev.data.u64=((uint64_t)tag<<32)|(uint32_t)fd;
+            ev.events=events;
+            epoll_ctl(r.epollFD,EPOLL_CTL_ADD,fd,&ev);
+        }
+    }
+    void stt::network::TcpServer::watchWrite(const int &reactor,const int &fd,const bool &on,const uint32_t &tag)
+    {
+        ReactorInf &r=*reactorInf[reactor];
+        if(r.ring)
+        {
+            if(on)
+                r.ring->addWriteWatch(fd,tag);
+        }
+        else
+        {
+            epoll_event ev;
+            ev.data.u64=((uint64_t)tag<<32)|(uint32_t)fd;
+            ev.events=EPOLLIN|EPOLLERR|EPOLLHUP|EPOLLRDHUP|EPOLLET|(on?EPOLLOUT:0);
+            epoll_ctl(r.epollFD,EPOLL_CTL_MOD,fd,&ev);
+        }
+    }
+    void stt::network::TcpServer::forceClose(const int &fd)
+    {
+        TcpFDInf *inf=clientfd.find(fd);
+        if(inf==nullptr||inf->fd==-1)
+            return;
+        std::shared_ptr<OutputBuffer> out=std::atomic_load(&inf->out);
+        if(out&&out->isClosing())//已经在等待发完后关闭 上层的关闭流程已经走过了
+        {
+            out->close();
+            TcpServer::close(fd);
+            return;
+        }
+        if(out)//丢掉积压的数据 不再等待
+            out->close();
+        close(fd);
+    }
+    bool stt::network::TcpServer::idleCheckOn()
+    {
+        return security_open&&checkFrequency>0&&connectionLimiter.getConnectionTimeout()>=0;
+    }
+    void stt::network::TcpServer::armTimer(const int &fd,const int &kind,const int &secs)
+    {
+        //tick和设置的时刻不对齐 多加一个tick保证至少过了secs秒
+        TcpFDInf &inf=clientfd[fd];
+        reactorInf[inf.reactor]->wheel.set(((uint64_t)fd<<1)|kind,secs<0?1:secs+1,inf.connection_obj_fd);
+    }
+    void stt::network::TcpFDInf::formatAddress(const sockaddr_storage &addr,std::string &ip,std::string &port)
+    {
+        char buf[INET6_ADDRSTRLEN];
+        if(addr.ss_family==AF_INET6)
+        {
+            const struct sockaddr_in6 *a=(const struct sockaddr_in6*)&addr;
+            inet_ntop(AF_INET6,&a->sin6_addr,buf,sizeof(buf));
+            ip=buf;
+            port=to_string(ntohs(a->sin6_port));
+        }
+        else
+        {
+            const struct sockaddr_in *a=(const struct sockaddr_in*)&addr;
+            inet_ntop(AF_INET,&a->sin_addr,buf,sizeof(buf));
+            ip=buf;
+            port=to_string(ntohs(a->sin_port));
+        }
+    }
+    void stt::network::TcpFDInf::formatAddress()
+    {
+        if(addr_len==0)//accept时没有拿到对端地址
+        {
+            addr_len=sizeof(addr);
+            if(getpeername(fd,(struct sockaddr*)&addr,&addr_len)!=0)
+            {
+                addr_len=0;
+                return;
+            }
+        }
+        formatAddress(addr,ip,port);
+    }
+    void stt::network::TcpServer::addConnection(const int &cfd,const struct sockaddr_storage *addr,const socklen_t &addrLen)
+    {
+        //用来加密accept的
+        SSL *ssl;
+        if(cfd>=maxFD)
+        {
+            ::close(cfd);
+            if(stt::system::ServerSetting::logfile!=nullptr&&stt::system::ServerSetting::logfile->shouldLog(stt::file::LogLevel::WARN))
+            {
+                    string ip,port;
+                    if(addr!=nullptr)
+                        TcpFDInf::formatAddress(*addr,ip,port);
+                    STT_LOG(stt::file::LogLevel::WARN,"tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" ip连接数量达到系统上限，已经关闭这个连接","tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" this connection has been closed because system connection has been reached limit");
+            }
+            return;
+        }
+        //只保存二进制地址 ip和端口字符串等到有人要用时再格式化
+        TcpFDInf &inf=clientfd[cfd];
+        inf.ip.clear();
+        inf.port.clear();
+        if(addr!=nullptr)
+        {
+            memcpy(&inf.addr,addr,addrLen);
+            inf.addr_len=addrLen;
+        }
+        else
+            inf.addr_len=0;//io_uring的multishot accept不带对端地址 第一次用到时再getpeername
+        //安全模块和日志马上就要用 在连接发布之前格式化好
+        if(this->security_open||stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(inf.addr_len==0)
+            {
+                inf.addr_len=sizeof(inf.addr);
+                if(getpeername(cfd,(struct sockaddr*)&inf.addr,&inf.addr_len)!=0)
+                    inf.addr_len=0;
+            }
+            if(inf.addr_len!=0)
+                TcpFDInf::formatAddress(inf.addr,inf.ip,inf.port);
+        }
+        const string &ip=inf.ip;
+        
+        
+        if(this->security_open)
+        {
+            int ret=connectionLimiter.allowConnect(ip,cfd,connectionTimes,connectionSecs);
+            if(ret==stt::security::DefenseDecision::CLOSE)
+            {
+            ::close(cfd);
+            STT_LOG(stt::file::LogLevel::WARN,"tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" 此ip连接数量或者速度达到上限，已经关闭这个连接","tcp server epoll:fd="+to_string(cfd)+" ip="+ip+" this connection has been closed because this ip has reached connection num's or rate's limit");
+            return;
+            }
+        }
+        //accept4和multishot accept拿到的套接字已经是非阻塞的
+        if(TLS)//加密accept
+        {
+            ssl=SSL_new(ctx);
+            if(ssl==nullptr)
+            {
+                cerr<<"new ssl wrong"<<endl;
+                ::close(cfd);
+                return;
+            }
+            SSL_set_accept_state(ssl);
+            //关联这个fd和ss
+            SSL_set_fd(ssl,cfd);
+
+            clientfd[cfd].tls_state = TLSState::HANDSHAKING;
+            if(handshakePool!=nullptr)
+                handshakeState[cfd]=0;
+            
+            //unique_lock<mutex> lock1(ltl1);
+            //tlsfd.emplace(cfd,ssl);//emplace???erase???
+
+        }
+        else
+        {
+            ssl=nullptr;
+            clientfd[cfd].tls_state = TLSState::NONE;
+        }
+        clientfd[cfd].ssl=ssl;
+        //cout<<"ok"<<endl;
+        //选择reactor：从轮询位置开始找连接数最少的那个
+        int target=0;
+        if(reactorNum>1)
+        {
+            target=(nextReactor++)%reactorNum;
+            for(int jj=1;jj<reactorNum;jj++)
+            {
+                int kk=(target+jj)%reactorNum;
+                if(reactorInf[kk]->connections<reactorInf[target]->connections)
+                    target=kk;
+            }
+        }
+        //对象表注册 必须在epoll注册之前完成，多reactor模式下注册后reactor线程马上就可能处理这个fd
+        clientfd[cfd].status=0;
+        clientfd[cfd].data="";
+        clientfd[cfd].buffer=nullptr;//有数据到来时才从RecvBufferPool拿
+        clientfd[cfd].buffer_cap=0;
+        clientfd[cfd].p_buffer_now=0;
+        clientfd[cfd].FDStatus=-1;
+        clientfd[cfd].connection_obj_fd=this->connection_obj_fd++;
+        clientfd[cfd].reactor=target;
+        uint32_t tag=eventTag(clientfd[cfd].connection_obj_fd);
+        std::atomic_store(&clientfd[cfd].out,std::make_shared<OutputBuffer>(cfd,[this,target,cfd,tag](const bool &on)->void{watchWrite(target,cfd,on,tag);},outHighWater,outLowWater));
+        //fd最后写入 旧连接残留的事件在这之前看到的都是fd=-1 会被reactor丢掉
+        std::atomic_thread_fence(std::memory_order_release);
+        clientfd[cfd].fd=cfd;
+        clientfd.setLive(cfd,true);
+        ++reactorInf[target]->connections;
+        if(idleCheckOn())
+            armTimer(cfd,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+        //clientfd[cfd].p_request_now=0;
+        //unique_lock<mutex> lock6(lc1);
+        //clientfd.emplace(cfd,inf);
+        
+        //lock6.unlock();
+        //epoll/io_uring注册
+        watchFD(*reactorInf[target],cfd,EPOLLIN|EPOLLERR | EPOLLHUP | EPOLLRDHUP|EPOLLET,tag);//边缘触发
+        //cout<<"listen:"<<cfd<<endl;
+        //写入日志
+        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server epoll:收到新的连接："+ip+":"+inf.port+"存入fd= "+to_string(cfd),"tcp server epoll:has received a new connection: "+ip+":"+inf.port+"save as fd= "+to_string(cfd));
+    }
+    void stt::network::TcpServer::acceptLoop()
+    {
+        CPUAffinity::bindThread(reactorCPUs);
+        int epollFD=-1;
+        IoUring ring;
+        bool useRing=(engine==EventEngine::IO_URING&&ring.init(16,1024));
+        if(useRing)
+        {
+            ring.addAccept(fd);//multishot accept 一次提交持续产出新连接
+        }
+        else
+        {
+            epollFD=epoll_create(1);
+            epoll_event ev;
+            ev.data.fd=fd;
+            ev.events=EPOLLIN|EPOLLET;//边缘触发
+            epoll_ctl(epollFD,EPOLL_CTL_ADD,fd,&ev);
+        }
+        epoll_event evs[16];
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server acceptor打开 reactor数量="+to_string(reactorNum),"tcp server acceptor has opened reactors="+to_string(reactorNum));
+        bool listening=true;
+        while(flag1)
+        {
+            if(listening&&!accepting)//监听套接字已经交给新进程
+            {
+                unwatchListen(useRing?&ring:nullptr,epollFD);
+                listening=false;
+            }
+            //监听等待，一秒钟检查一次flag条件是否满足
+            int infds;
+            if(useRing)
+            {
+                infds=ring.wait(evs,16,1000);
+                for(auto &cfd:ring.acceptedFD)
+                    addConnection(cfd);
+                ring.acceptedFD.clear();
+            }
+            else
+                infds=epoll_wait(epollFD,evs,16,1000);
+            if(infds<=0)
+                continue;
+            acceptConnection();
+        }
+        if(epollFD!=-1)
+            ::close(epollFD);
+        ring.close();
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server acceptor退出","tcp server acceptor quit");
+        --loopNum;
+    }
+    void stt::network::TcpServer::unwatchListen(IoUring *ring,const int &epollFD)
+    {
+        //只是不再accept 套接字本身留到stopListen再关 之前取到的事件调用accept也不会出错
+        if(ring!=nullptr)
+            ring->removeAccept();
+        else
+            epoll_ctl(epollFD,EPOLL_CTL_DEL,fd,nullptr);
+    }
+    int stt::network::TcpServer::inheritListenFD(const int &port)
+    {
+        int c=socket(AF_UNIX,SOCK_STREAM|SOCK_CLOEXEC,0);
+        if(c<0)
+            return -1;
+        struct sockaddr_un addr;
+        memset(&addr,0,sizeof(addr));
+        addr.sun_family=AF_UNIX;
+        strncpy(addr.sun_path,hotRestartPath.c_str(),sizeof(addr.sun_path)-1);
+        if(connect(c,(struct sockaddr*)&addr,sizeof(addr))!=0)//没有旧进程
+        {
+            ::close(c);
+            return -1;
+        }
+        timeval tv{3,0};
+        setsockopt(c,SOL_SOCKET,SO_RCVTIMEO,&tv,sizeof(tv));
+        setsockopt(c,SOL_SOCKET,SO_SNDTIMEO,&tv,sizeof(tv));
+        //告诉旧进程要的端口 旧进程回一个字节 1表示附带了监听套接字
+        int listenFD=-1;
+        int32_t want=port;
+        if(send(c,&want,sizeof(want),MSG_NOSIGNAL)==sizeof(want))
+        {
+            char ok=0;
+            iovec iov{&ok,1};
+            char control[CMSG_SPACE(sizeof(int))];
+            msghdr msg;
+            memset(&msg,0,sizeof(msg));
+            msg.msg_iov=&iov;
+            msg.msg_iovlen=1;
+            msg.msg_control=control;
+            msg.msg_controllen=sizeof(control);
+            if(recvmsg(c,&msg,MSG_CMSG_CLOEXEC)==1&&ok==1)
+            {
+                cmsghdr *cmsg=CMSG_FIRSTHDR(&msg);
+                if(cmsg!=nullptr&&cmsg->cmsg_level==SOL_SOCKET&&cmsg->cmsg_type==SCM_RIGHTS)
+                    memcpy(&listenFD,CMSG_DATA(cmsg),sizeof(int));
+            }
+        }
+        //确认拿到的是这个端口上正在监听的套接字
+        if(listenFD!=-1)
+        {
+            struct sockaddr_in k;
+            socklen_t k_len=sizeof(k);
+            int acceptConn=0;
+            socklen_t len=sizeof(acceptConn);
+            if(getsockname(listenFD,(struct sockaddr*)&k,&k_len)!=0||k.sin_family!=AF_INET||ntohs(k.sin_port)!=port||getsockopt(listenFD,SOL_SOCKET,SO_ACCEPTCONN,&acceptConn,&len)!=0||acceptConn==0)
+            {
+                ::close(listenFD);
+                listenFD=-1;
+            }
+        }
+        //回执 旧进程收到1之后才停止accept
+        char ack=(listenFD!=-1)?1:0;
+        send(c,&ack,1,MSG_NOSIGNAL);
+        ::close(c);
+        if(listenFD==-1)
+            return -1;
+        int flags=fcntl(listenFD,F_GETFL,0);
+        fcntl(listenFD,F_SETFL,flags|O_NONBLOCK);
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server 热重启：从旧进程接管了端口"+to_string(port)+"的监听套接字","tcp server hot restart: took over the listening socket of port "+to_string(port)+" from the old process");
+        return listenFD;
+    }
+    int stt::network::TcpServer::openControlSocket()
+    {
+        int c=socket(AF_UNIX,SOCK_STREAM|SOCK_CLOEXEC|SOCK_NONBLOCK,0);
+        if(c<0)
+            return -1;
+        struct sockaddr_un addr;
+        memset(&addr,0,sizeof(addr));
+        addr.sun_family=AF_UNIX;
+        strncpy(addr.sun_path,hotRestartPath.c_str(),sizeof(addr.sun_path)-1);
+        unlink(addr.sun_path);//旧进程的路径 它已经交接完或者已经不在了
+        if(bind(c,(struct sockaddr*)&addr,sizeof(addr))!=0||listen(c,4)!=0)
+        {
+            STT_LOG(stt::file::LogLevel::ERROR,"tcp server 热重启：监听"+hotRestartPath+"失败 error="+to_string(errno),"tcp server hot restart: failed to listen on "+hotRestartPath+" error="+to_string(errno));
+            ::close(c);
+            return -1;
+        }
+        return c;
+    }
+    void stt::network::TcpServer::hotRestartLoop(const int &controlFD)
+    {
+        int cfd=controlFD;
+        while(flag1&&!handedOver)
+        {
+            pollfd p{cfd,POLLIN,0};
+            if(poll(&p,1,1000)<=0)
+                continue;
+            int c=accept4(cfd,nullptr,nullptr,SOCK_CLOEXEC);
+            if(c<0)
+                continue;
+            timeval tv{3,0};
+            setsockopt(c,SOL_SOCKET,SO_RCVTIMEO,&tv,sizeof(tv));
+            setsockopt(c,SOL_SOCKET,SO_SNDTIMEO,&tv,sizeof(tv));
+            int32_t want=-1;
+            char ok=0;
+            if(recv(c,&want,sizeof(want),MSG_WAITALL)==sizeof(want)&&want==port)
+            {
+                //监听套接字和新进程共享 同一个accept队列 交接期间的连接不会丢
+                ok=1;
+                iovec iov{&ok,1};
+                char control[CMSG_SPACE(sizeof(int))];
+                memset(control,0,sizeof(control));
+                msghdr msg;
+                memset(&msg,0,sizeof(msg));
+                msg.msg_iov=&iov;
+                msg.msg_iovlen=1;
+                msg.msg_control=control;
+                msg.msg_controllen=sizeof(control);
+                cmsghdr *cmsg=CMSG_FIRSTHDR(&msg);
+                cmsg->cmsg_level=SOL_SOCKET;
+                cmsg->cmsg_type=SCM_RIGHTS;
+                cmsg->cmsg_len=CMSG_LEN(sizeof(int));
+                memcpy(CMSG_DATA(cmsg),&fd,sizeof(int));
+                char ack=0;
+                if(sendmsg(c,&msg,MSG_NOSIGNAL)==1&&recv(c,&ack,1,0)==1&&ack==1)
+                    handedOver=true;
+            }
+            else
+                send(c,&ok,1,MSG_NOSIGNAL);
+            ::close(c);
+        }
+        ::close(cfd);
+        if(!handedOver)
+        {
+            if(!flag1)
+                unlink(hotRestartPath.c_str());
+            --loopNum;
+            return;
+        }
+        //停止accept 剩下的连接处理完再退出
+        accepting=false;
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server 热重启：端口"+to_string(port)+"的监听套接字已经交给新进程，开始处理剩下的连接","tcp server hot restart: the listening socket of port "+to_string(port)+" has been handed to the new process, draining remaining connections");
+        auto deadline=std::chrono::steady_clock::now()+std::chrono::seconds(hotRestartDrain);
+        while(flag1&&std::chrono::steady_clock::now()<deadline)
+        {
+            int left=0;
+            for(auto &r:reactorInf)
+                left+=r->connections;
+            if(left==0)
+                break;
+            std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server 热重启：端口"+to_string(port)+"的旧连接处理结束","tcp server hot restart: remaining connections of port "+to_string(port)+" are done");
+        //先退出循环计数 fun里面可能会析构服务器
+        bool stopped=!flag1;
+        std::function<void()> fun=drainedFun;
+        --loopNum;
+        if(stopped)
+            return;
+        if(fun)
+            fun();
+        else
+            kill(getpid(),15);
+    }
+    void stt::network::TcpServer::onTLSEstablished(const int &fd)
+    {
+        clientfd[fd].tls_state = TLSState::ESTABLISHED;
+        if(SSL_session_reused(clientfd[fd].ssl))
+            ++resumedHandshakes;
+        else
+            ++fullHandshakes;
+        #ifdef SSL_OP_ENABLE_KTLS
+        if(ktls)//看内核有没有接管加密
+        {
+            SSL *ssl=clientfd[fd].ssl;
+            bool tx=BIO_get_ktls_send(SSL_get_wbio(ssl));
+            bool rx=BIO_get_ktls_recv(SSL_get_rbio(ssl));
+            std::shared_ptr<OutputBuffer> out=std::atomic_load(&clientfd[fd].out);
+            if(tx&&out)
+                out->setKernelTLS(true);
+            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server epoll:fd= "+to_string(fd)+" kTLS 发送:"+(tx?"开启":"不可用")+" 接收:"+(rx?"开启":"不可用"),"tcp server epoll:fd= "+to_string(fd)+" kTLS send:"+(tx?"on":"unavailable")+" recv:"+(rx?"on":"unavailable"));
+        }
+        #endif
+        // TLS 握手完成
+        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server epoll:收到TLS握手数据：fd= "+to_string(fd)+",完成!","tcp server epoll:has received tls handshake data: fd= "+to_string(fd)+",finish!");
+    }
+    void stt::network::TcpServer::handshakeTask(const int &reactor,const int &fd,const uint64_t &connection_obj_fd,const std::chrono::steady_clock::time_point &queued)
+    {
+        //在握手线程池里执行 这段时间reactor不会碰这个连接的SSL
+        auto start=std::chrono::steady_clock::now();
+        uint64_t wait=std::chrono::duration_cast<std::chrono::microseconds>(start-queued).count();
+        ++handshakeRounds;
+        handshakeQueueTime+=wait;
+        uint64_t max=handshakeQueueMax;
+        while(wait>max&&!handshakeQueueMax.compare_exchange_weak(max,wait));
+        SSL *ssl=clientfd[fd].ssl;
+        bool ok=false;
+        while(true)
+        {
+            int ret=SSL_accept(ssl);
+            if(ret==1)
+            {
+                ok=true;
+                break;
+            }
+            int err=SSL_get_error(ssl,ret);
+            if(err==SSL_ERROR_WANT_READ||err==SSL_ERROR_WANT_WRITE)
+            {
+                //等下一批握手数据 如果这期间reactor又收到了数据（状态变成2）就接着做
+                handshakeBusyTime+=std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-start).count();
+                --handshakeInflight;
+                int expect=1;
+                if(handshakeState[fd].compare_exchange_strong(expect,0))
+                    return;//交还给reactor 之后不能再碰这个连接
+                handshakeState[fd]=1;
+                ++handshakeInflight;
+                start=std::chrono::steady_clock::now();
+                continue;
+            }
+            break;
+        }
+        handshakeBusyTime+=std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now()-start).count();
+        --handshakeInflight;
+        //交回reactor 状态保持为1 直到reactor处理这条消息
+        ReactorInf *r=reactorInf[reactor].get();
+        r->handshakeQueue.push({fd,connection_obj_fd,ok});
+        uint64_t one=1;
+        write(r->workerEventFD,&one,sizeof(one));
+    }
+    stt::network::HandshakeStats stt::network::TcpServer::getHandshakeStats()
+    {
+        HandshakeStats st;
+        st.rounds=handshakeRounds;
+        st.rejected=handshakeRejected;
+        st.queueTimeTotal=handshakeQueueTime;
+        st.queueTimeMax=handshakeQueueMax;
+        st.busyTimeTotal=handshakeBusyTime;
+        st.inflight=handshakeInflight;
+        return st;
+    }
+    bool stt::network::TcpServer::setWorkerGroup(const std::string &name,const int &threads,const int &maxQueue,const int &nice)
+    {
+        if(isListen()||name.empty()||threads<=0)
+            return false;
+        std::unique_ptr<WorkerGroup> g(new WorkerGroup());
+        g->name=name;
+        g->threads=threads;
+        g->maxQueue=maxQueue>0?maxQueue:0;
+        g->nice=nice;
+        WorkerGroup *old=nullptr;
+        auto ii=workerGroups.find(name);
+        if(ii!=workerGroups.end())
+            old=ii->second.get();
+        //已经分配到旧组的路由改指新组
+        for(auto &rr:routeGroups)
+        {
+            if(rr.second==old)
+                rr.second=g.get();
+        }
+        workerGroups[name]=std::move(g);
+        return true;
+    }
+    bool stt::network::TcpServer::setRouteGroup(const std::string &key,const std::string &group)
+    {
+        if(isListen())
+            return false;
+        if(group.empty())
+        {
+            routeGroups.erase(key);
+            return true;
+        }
+        auto ii=workerGroups.find(group);
+        if(ii==workerGroups.end())
+            return false;
+        routeGroups[key]=ii->second.get();
+        return true;
+    }
+    std::vector<stt::network::WorkerGroupStats> stt::network::TcpServer::getWorkerGroupStats()
+    {
+        std::vector<WorkerGroupStats> stats;
+        for(auto &ii:workerGroups)
+        {
+            WorkerGroupStats st;
+            st.name=ii.second->name;
+            st.threads=ii.second->threads;
+            st.nice=ii.second->nice;
+            st.maxQueue=ii.second->maxQueue;
+            st.inflight=ii.second->inflight;
+            st.submitted=ii.second->submitted;
+            st.rejected=ii.second->rejected;
+            stats.push_back(st);
+        }
+        return stats;
+    }
+    void stt::network::TcpServer::recordQueueDelay(QueueDelayControl &qc,const std::chrono::steady_clock::time_point &queuedAt)
+    {
+        --qc.queued;
+        auto now=std::chrono::steady_clock::now();
+        uint64_t us=std::chrono::duration_cast<std::chrono::microseconds>(now-queuedAt).count();
+        ++qc.samples;
+        qc.delayTotal+=us;
+        qc.delayLast=us;
+        uint64_t old=qc.delayMax;
+        while(us>old&&!qc.delayMax.compare_exchange_weak(old,us));
+        if(us<(uint64_t)shedTargetUs)
+        {
+            //一次低于目标就说明队列能排空 退出卸载状态
+            if(qc.aboveSince.load(std::memory_order_relaxed)!=0)
+                qc.aboveSince=0;
+            if(qc.dropping.load(std::memory_order_relaxed))
+                qc.dropping=false;
+            return;
+        }
+        int64_t t=std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+        int64_t since=qc.aboveSince.load(std::memory_order_relaxed);
+        if(since==0)
+            qc.aboveSince.compare_exchange_strong(since,t);
+        else if(t-since>=(int64_t)shedIntervalUs*1000&&!qc.dropping.exchange(true))
+        {
+            STT_LOG(stt::file::LogLevel::WARN,"tcp server : 排队时间持续超过"+to_string(shedTargetUs/1000)+"ms 开始拒绝新任务 当前排队时间="+to_string(us/1000)+"ms","tcp server : queue delay above "+to_string(shedTargetUs/1000)+"ms for too long, start shedding new tasks. delay now="+to_string(us/1000)+"ms");
+        }
+    }
+    stt::network::LoadShedStats stt::network::TcpServer::getLoadShedStats(const std::string &group)
+    {
+        LoadShedStats st;
+        QueueDelayControl *qc=&queueDelay;
+        if(!group.empty())
+        {
+            auto ii=workerGroups.find(group);
+            if(ii==workerGroups.end())
+                return st;
+            qc=&ii->second->delay;
+        }
+        st.shed=qc->shed;
+        st.tasks=qc->samples;
+        st.delayAvg=st.tasks>0?qc->delayTotal/st.tasks:0;
+        st.delayMax=qc->delayMax;
+        st.delayLast=qc->delayLast;
+        st.queued=qc->queued;
+        st.dropping=qc->dropping;
+        return st;
+    }
+    bool stt::network::TcpServer::dispatchTask(std::unordered_map<std::string,std::any> &ctx,const uint64_t &connection_obj_fd,std::function<void()> &&task)
+    {
+        //按路由key找线程组 没有分配的路由走默认线程池
+        WorkerGroup *g=nullptr;
+        if(!routeGroups.empty())
+        {
+            auto kk=ctx.find("key");
+            const std::string *key=(kk==ctx.end())?nullptr:std::any_cast<std::string>(&kk->second);
+            if(key!=nullptr)
+            {
+                auto gg=routeGroups.find(*key);
+                if(gg!=routeGroups.end())
+                    g=gg->second;
+            }
+        }
+        //排队时间一直超标时不再排队 直接拒绝
+        QueueDelayControl *qc=nullptr;
+        if(shedTargetUs>0)
+        {
+            qc=(g!=nullptr)?&g->delay:&queueDelay;
+            if(qc->dropping.load(std::memory_order_relaxed))
+            {
+                if(qc->queued.load(std::memory_order_relaxed)==0)//积压已经清空 恢复排队
+                {
+                    qc->aboveSince=0;
+                    qc->dropping=false;
+                }
+                else
+                {
+                    ++qc->shed;
+                    STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 排队时间过长 拒绝任务","tcp server : queue delay too long, task shed");
+                    return false;
+                }
+            }
+        }
+        WorkerPool *pool=workpool;
+        if(g!=nullptr)
+        {
+            if(++g->inflight>g->maxQueue&&g->maxQueue>0)
+            {
+                --g->inflight;
+                ++g->rejected;
+                STT_LOG(stt::file::LogLevel::WARN,"tcp server : 线程组"+g->name+"已满 拒绝任务","tcp server : worker group "+g->name+" is full, task rejected");
+                return false;
+            }
+            ++g->submitted;
+            pool=g->pool.get();
+        }
+        if(qc!=nullptr||g!=nullptr)
+        {
+            std::chrono::steady_clock::time_point queuedAt;
+            if(qc!=nullptr)
+            {
+                ++qc->queued;
+                queuedAt=std::chrono::steady_clock::now();
+            }
+            task=[this,g,qc,queuedAt,task=std::move(task)]()->void
+            {
+                if(qc!=nullptr)
+                    recordQueueDelay(*qc,queuedAt);
+                task();
+                if(g!=nullptr)
+                    --g->inflight;
+            };
+        }
+        if(taskLanes)//同一个连接的任务固定在一个工作线程上按顺序执行
+            pool->submitTo(connection_obj_fd,std::move(task));
+        else
+            pool->submit(std::move(task));
+        return true;
+    }
+    void stt::network::TcpServer::epolll(const int &id)
+    {
+        ReactorInf &r=*reactorInf[id];
+        int epollFD=r.epollFD;//这个reactor的epoll句柄 io_uring模式下为-1
+        if(!reactorCPUs.empty())
+            CPUAffinity::bindThread({reactorCPUs[id%reactorCPUs.size()]});
+        if(reactorNum==1)//单reactor模式下自己负责accept
+        {
+            if(r.ring)
+                r.ring->addAccept(fd);//multishot accept
+            else
+                watchFD(r,fd,EPOLLIN|EPOLLET);//边缘触发
+        }
+
+        //加入worker线程fd
+        watchFD(r,r.workerEventFD,EPOLLIN);
+
+        //加入时间事件fd
+        //加入时间轮的tick 每秒一次 僵尸连接检测和websocket心跳都挂在时间轮上
+        int wheelTimerFD=-1;
+        if(idleCheckOn()||serverType==3)
+        {
+            wheelTimerFD = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+            itimerspec its{};
+            its.it_interval.tv_sec = 1;   
+            its.it_value.tv_sec    = 1;   
+            timerfd_settime(wheelTimerFD, 0, &its, nullptr);
+            //丢进epoll
+            watchFD(r,wheelTimerFD,EPOLLIN);
+        }
+
+
+        //检查连接表里面是不是有套接字，有的话加入
+       
+        clientfd.forEachLive([this,&r,&id](const int &ii,TcpFDInf &inf)
+        {
+            //unique_lock<mutex> lock6(lc1);
+
+                if(inf.reactor==id)
+                {
+                //cout<<"has:"<<clientfd[ii].fd<<endl;
+                watchFD(r,inf.fd,EPOLLIN|EPOLLERR | EPOLLHUP | EPOLLRDHUP|EPOLLET,eventTag(inf.connection_obj_fd));//边缘触发
+                if(idleCheckOn())
+                    armTimer(inf.fd,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+                }
+        });
+       //cout<<"ok"<<endl;
+       
+        //一次最多取回EVENT_BATCH个事件 剩下的下一轮epoll_wait再取 不再按maxFD分配
+        int evsNum=maxFD/reactorNum+10;
+        if(evsNum>EVENT_BATCH)
+            evsNum=EVENT_BATCH;
+        epoll_event *evs=new epoll_event[evsNum];//存放epoll返回的事件
+
+        int ret;
+        
+        STT_LOG(stt::file::LogLevel::INFO,"tcp server epoll打开 reactor="+to_string(id),"tcp server epoll has opened reactor="+to_string(id));
+        
+        bool listening=(reactorNum==1);
+        while(flag1)
+        {
+            if(listening&&!accepting)//监听套接字已经交给新进程
+            {
+                unwatchListen(r.ring.get(),epollFD);
+                listening=false;
+            }
+            //监听等待，一秒钟检查一次flag条件是否满足
+            int infds;
+            if(r.ring)
+            {
+                infds=r.ring->wait(evs,evsNum,1000);
+                //multishot accept收到的新连接
+                for(auto &cfd:r.ring->acceptedFD)
+                    addConnection(cfd);
+                r.ring->acceptedFD.clear();
+            }
+            else
+                infds=epoll_wait(epollFD,evs,evsNum,1000);
+            if(infds<=0)//<0失败=0超时
+            {
+                continue;
+            }
+            else//有事发生
+            {
+                for(int ii=0;ii<infds;ii++)
+                {
+                    if(evs[ii].data.fd==fd)//有新的连接
+                    {
+                        acceptConnection();
+                    }
+                    else if(evs[ii].data.fd==wheelTimerFD)//时间轮tick
+                    {
+                        uint64_t exp;
+                        read(wheelTimerFD, &exp, sizeof(exp)); // 必须读，清事件
+                        //只处理真正到期的连接
+                        std::vector<TimingWheel::Expired> expired;
+                        r.wheel.advance(exp,expired);
+                        for(auto &e:expired)
+                        {
+                            int i=e.key>>1;
+                            TcpFDInf *inf=clientfd.find(i);
+                            if(inf==nullptr||inf->fd==-1||inf->reactor!=id||inf->connection_obj_fd!=e.tag)//连接已经关闭或者fd被复用
+                                continue;
+                            if((int)(e.key&1)==TIMER_HEARTBEAT)
+                            {
+                                handleHeartbeat(id,i);
+                                continue;
+                            }
+                            if(handshakePool!=nullptr&&inf->tls_state==TLSState::HANDSHAKING&&handshakeState[i]!=0)//握手线程池还在用 下一轮再检测
+                            {
+                                armTimer(i,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+                                continue;
+                            }
+                            if(this->connectionLimiter.connectionDetect(inf->getIP(),i))//超时 是僵尸连接
+                            {
+                                
+                                STT_LOG(stt::file::LogLevel::WARN,"tcp server epoll:监测到僵尸连接：fd= "+to_string(i)+" 已关闭","tcp server epoll : has detected a zoombie connection : fd= "+to_string(i)+" and it has been closed");
+                                forceClose(i);
+                            }
+                            else//安全模块里记录的活动时间比时间轮新 重新计时
+                                armTimer(i,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+                        }
+                    }
+                    else if(evs[ii].data.fd==r.workerEventFD)//worker事件
+                    {
+                        uint64_t cnt;
+                        read(r.workerEventFD, &cnt, sizeof(cnt)); // 清门铃
+                        // 一口气处理完队列 每次批量取出一段
+                        WorkerMessage wms[64];
+                        size_t wn;
+                        while((wn=r.finishQueue.pop_bulk(wms,64))>0)
+                        {
+                            for(size_t jj=0;jj<wn;jj++)
+                            {
+                                if(clientfd[wms[jj].fd].reactor!=id)//fd已经被关闭并且重新分配给其他reactor
+                                    continue;
+                                handler_workerevent(wms[jj].fd,wms[jj].ret);
+                            }
+                        }
+                        //握手线程池交回来的连接
+                        HandshakeMessage hm;
+                        while(r.handshakeQueue.pop(hm))
+                        {
+                            TcpFDInf *inf=clientfd.find(hm.fd);
+                            if(inf==nullptr||inf->fd==-1||inf->reactor!=id||inf->connection_obj_fd!=hm.connection_obj_fd)
+                                continue;
+                            handshakeState[hm.fd]=0;
+                            if(!hm.ok)
+                            {
+                                close(hm.fd);
+                                STT_LOG(stt::file::LogLevel::DEBUG,"tcp server epoll:TLS握手：fd= "+to_string(hm.fd)+"错误","tcp server epoll: received tls handshake data: fd= "+to_string(hm.fd)+" fail");
+                                continue;
+                            }
+                            onTLSEstablished(hm.fd);
+                            //第一个请求可能已经到了 和普通数据一样接着读
+                            if(idleCheckOn())
+                                armTimer(hm.fd,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+                            handler_netevent(hm.fd);
+                            if(clientfd[hm.fd].fd!=-1&&clientfd[hm.fd].reactor==id)
+                                RecvBufferPool::recycle(clientfd[hm.fd]);
+                        }
+                    }
+                    else//有数据上来了
+                    {
+                       //start=chrono::high_resolution_clock::now();
+                        //同一批事件里fd已经被关闭（io_uring的multishot poll可能给同一个fd投递多条事件） 或者是fd号被复用前旧连接残留的事件
+                        TcpFDInf &inf=clientfd[evs[ii].data.fd];
+                        if(inf.reactor!=id||inf.fd==-1||(uint32_t)(evs[ii].data.u64>>32)!=eventTag(inf.connection_obj_fd))
+                            continue;
+                        if(evs[ii].events&EPOLLOUT)//socket可写了 继续发送输出队列里积压的数据
+                        {
+                            std::shared_ptr<OutputBuffer> out=std::atomic_load(&clientfd[evs[ii].data.fd].out);
+                            if(out&&clientfd[evs[ii].data.fd].fd!=-1)
+                            {
+                                size_t before=out->pending();
+                                bool resumed;
+                                int ret=out->flush(clientfd[evs[ii].data.fd].ssl,resumed);
+                                if(ret<0)
+                                {
+                                    forceClose(evs[ii].data.fd);
+                                    continue;
+                                }
+                                if(ret==1&&out->isClosing())//发完了 完成之前推迟的关闭
+                                {
+                                    TcpServer::close(evs[ii].data.fd);
+                                    continue;
+                                }
+                                //发送有进展也算活动 推迟僵尸检测定时
+                                if(out->pending()<before&&idleCheckOn())
+                                    armTimer(evs[ii].data.fd,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+                                if(resumed&&writableFun)
+                                    writableFun(evs[ii].data.fd);
+                            }
+                            if(!(evs[ii].events&~EPOLLOUT))//只有可写事件
+                                continue;
+                        }
+                        if(evs[ii].events&(EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+                        {
+                            if(handshakePool!=nullptr&&clientfd[evs[ii].data.fd].tls_state==TLSState::HANDSHAKING)
+                            {
+                                //线程池还在用这个连接的SSL 让它重试SSL_accept时发现错误 由它交回reactor关闭
+                                std::atomic<int> &state=handshakeState[evs[ii].data.fd];
+                                int expect=1;
+                                if(state.compare_exchange_strong(expect,2)||expect==2)
+                                    continue;
+                            }
+
+                                
+                                STT_LOG(stt::file::LogLevel::DEBUG,"tcp server epoll:收到连接关闭消息：fd= "+to_string(evs[ii].data.fd)+" 已关闭","tcp server epoll:receive connection close message: fd= "+to_string(evs[ii].data.fd)+" and it has been pushed into queue");
+                                
+
+                                forceClose(evs[ii].data.fd);
+                                //{
+                                //std::lock_guard<std::mutex> lock(lq1[evs[ii].data.fd%consumerNum]);
+                                //fdQueue[evs[ii].data.fd%consumerNum].push(QueueFD{evs[ii].data.fd,true});
+                               //}
+                                //cv[evs[ii].data.fd%consumerNum].notify_one();
+                            
+
+                        }
+                        else
+                        {
+                            //正在等输出队列发完后关闭 不再处理新的请求
+                            std::shared_ptr<OutputBuffer> out=std::atomic_load(&clientfd[evs[ii].data.fd].out);
+                            if(out&&out->isClosing())
+                                continue;
+                            //tls状态
+                            if (clientfd[evs[ii].data.fd].tls_state == TLSState::HANDSHAKING&&handshakePool!=nullptr)
+                            {
+                                //握手交给线程池 reactor不做非对称运算
+                                std::atomic<int> &state=handshakeState[evs[ii].data.fd];
+                                int expect=0;
+                                if(state.compare_exchange_strong(expect,1))
+                                {
+                                    if(handshakeInflight>=handshakeLimit)//积压太多 直接拒绝 客户端会重试
+                                    {
+                                        state=0;
+                                        ++handshakeRejected;
+                                        STT_LOG(stt::file::LogLevel::WARN,"tcp server epoll:TLS握手排队达到上限：fd= "+to_string(evs[ii].data.fd)+" 已关闭","tcp server epoll:tls handshake queue is full: fd= "+to_string(evs[ii].data.fd)+" has been closed");
+                                        forceClose(evs[ii].data.fd);
+                                        continue;
+                                    }
+                                    ++handshakeInflight;
+                                    int cfd=evs[ii].data.fd;
+                                    uint64_t obj=clientfd[cfd].connection_obj_fd;
+                                    auto queued=std::chrono::steady_clock::now();
+                                    handshakePool->submit([this,id,cfd,obj,queued]()->void{handshakeTask(id,cfd,obj,queued);});
+                                }
+                                else if(expect==1)//线程池正在握手 告诉它又来了数据
+                                    state.compare_exchange_strong(expect,2);
+                                continue;
+                            }
+                            if (clientfd[evs[ii].data.fd].tls_state == TLSState::HANDSHAKING) 
+                            {
+                                //tls accept
+                                int ret = SSL_accept(clientfd[evs[ii].data.fd].ssl);
+                                if (ret == 1) 
+                                {
+                                    onTLSEstablished(evs[ii].data.fd);
+                                } 
+                                else 
+                                {
+                                    int err = SSL_get_error(clientfd[evs[ii].data.fd].ssl, ret);
+                                    if (err == SSL_ERROR_WANT_READ) 
+                                    {
+                                        // 等下一个 EPOLLIN
+                                        
+                                    } 
+                                    else if (err == SSL_ERROR_WANT_WRITE) 
+                                    {
+                                        // 确保监听 EPOLLOUT
+                                        
+                                    }
+                                    else 
+                                    {
+                                        // 真错误
+                                        //printf("SSL_accept error: %s\n", ERR_error_string(ERR_get_error(), nullptr));
+    	                                //printf("SSL_accept returned %d, SSL error code: %d\n", ret, SSL_get_error(ssl, ret));
+                                        //SSL_free(clientfd[evs[ii].data.fd].ssl);
+                                        close(evs[ii].data.fd);
+                                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server epoll:TLS握手：fd= "+to_string(evs[ii].data.fd)+"错误","tcp server epoll: received tls handshake data: fd= "+to_string(evs[ii].data.fd)+" fail");
+                                    }
+                                    continue;
+                                }
+                                //握手完成 第一个请求可能和握手数据一起到达（边缘触发不会再通知） 接着读
+                            }
+                            //普通数据
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server epoll:收到新数据：fd= "+to_string(evs[ii].data.fd),"tcp server epoll:has received new data: fd= "+to_string(evs[ii].data.fd));
+                            //有活动 推迟僵尸检测定时 O(1)
+                            if(idleCheckOn())
+                                armTimer(evs[ii].data.fd,TIMER_IDLE,connectionLimiter.getConnectionTimeout());
+                            handler_netevent(evs[ii].data.fd);
+                            //这一轮的字节都消费完了就把缓冲区还给池 空闲连接不占内存
+                            if(clientfd[evs[ii].data.fd].fd!=-1&&clientfd[evs[ii].data.fd].reactor==id)
+                                RecvBufferPool::recycle(clientfd[evs[ii].data.fd]);
+                             //{
+                             //   std::lock_guard<std::mutex> lock(lq1[evs[ii].data.fd%consumerNum]);
+                             //   fdQueue[evs[ii].data.fd%consumerNum].push(QueueFD{evs[ii].data.fd,false});
+                             //}
+                            //cv[evs[ii].data.fd%consumerNum].notify_one();
+                        }
+                        //endd=chrono::high_resolution_clock::now();
+                        //duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+                        //cout<<"入队用时"<<duration.count()<<endl;
+                    }
+                }
+            }
+        }
+        delete[] evs;
+        if(wheelTimerFD!=-1)
+            ::close(wheelTimerFD);
+        STT_LOG(stt::file::LogLevel::INFO,"tcp服务器监听的epoll退出 reactor="+to_string(id),"tcp server's listening epoll quit reactor="+to_string(id));
+        //cout<<"epoll quit"<<endl;
+        --loopNum;
+    }
+    void stt::network::TcpServer::handler_workerevent(const int &fd,const int &ret)
+    {
+        if(ret==-2)
+        {
+            TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : worker处理失败 fd= "+to_string(fd)+" ，已经关闭连接","tcp server : worker solve fail fd= "+to_string(fd)+" ,now has closed this connection");
+            return;
+        }
+        TcpFDHandler k;
+        k.setFD(fd,clientfd[fd].ssl,unblock);
+        k.setOutputBuffer(getOutputBuffer(fd));
+        if(ret==-1)
+        {
+            clientfd[fd].pendindQueue.pop();
+            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : worker处理失败 fd= "+to_string(fd)+" ，跳过本次请求","tcp server : worker solve fail fd= "+to_string(fd)+" ,skip this request");
+        }
+        else
+        {
+            if(clientfd[fd].pendindQueue.empty())
+            {
+                STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd),"tcp server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
+                return;
+            }
+            TcpInformation &inf=std::any_cast<TcpInformation&>(clientfd[fd].pendindQueue.front());
+            if(inf.connection_obj_fd!=clientfd[fd].connection_obj_fd)
+            {
+                STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd),"tcp server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
+                return;
+            }
+            auto ii=solveFun.find(std::any_cast<const std::string&>(inf.ctx["key"]));//对应的任务
+            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : worker处理成功 fd= "+to_string(fd),"tcp server : worker solve sucessfully fd= "+to_string(fd));
+            if(ii==solveFun.end())//找不到
+                {
+                    //TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","tcp server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                    if(!globalSolveFun(k,inf))
+                    {
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.","tcp server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
+                        return;
+                    }
+                    clientfd[fd].pendindQueue.pop();
+                }
+            else
+            {
+            //继续做
+            for(;clientfd[fd].FDStatus<ii->second.size();)
+            {
+                int rett=ii->second[clientfd[fd].FDStatus](k,inf);
+                clientfd[fd].FDStatus++;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成","tcp server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.","tcp server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。","tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
+                            //clientfd[fd].pendindQueue.pop();
+                            return;
+                        }
+            }
+            }
+            clientfd[fd].pendindQueue.pop();
+        }
+
+        TcpFDInf Tcpinf=clientfd[fd];
+        //检查是否有下一轮
+        if(Tcpinf.pendindQueue.size()>=1)//只有一个 说明没有任务没做完 直接执行
+            {
+                TcpInformation &inff=std::any_cast<TcpInformation&>(clientfd[fd].pendindQueue.front());
+                Tcpinf.FDStatus=-1;
+                int ret;
+                //获取key,自动解析到ctx的key键
+                ++Tcpinf.FDStatus;
+                ret=parseKey(k,inff);
+
+                if(ret==0) //慢任务
+                    return;
+                else if(ret<=-1)
+                {
+                    //清掉任务后返回
+                    Tcpinf.pendindQueue.pop();
+                    //-2要关闭连接
+                    if(ret==-2)
+                    {
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接","tcp server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
+                    }
+                    else
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务","tcp server : parsekey fail fd= "+to_string(fd)+",now has throwed this task");
+                    }
+                    return;
+                }
+                
+                //遍历任务
+                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
+                if(ii==solveFun.end())//找不到
+                {
+                    //TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","tcp server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                    if(!globalSolveFun(k,inff))
+                    {
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.","tcp server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
+                        return;
+                    }
+                    Tcpinf.pendindQueue.pop();
+                }
+                else//找得到处理函数
+                {
+                    for(auto &f:ii->second)
+                    {
+                        int rett=f(k,inff);
+                        ++Tcpinf.FDStatus;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","tcp server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","tcp server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else if(rett==-1)
+                        {
+                            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                        else
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                    }
+                    
+                }
+                Tcpinf.pendindQueue.pop();
+                    STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 完成","tcp server : handled fd= "+to_string(fd)+" sucessfully");
+                
+            }
+
+    }
+    void stt::network::TcpServer::handler_netevent(const int &fd)
+    {
+        TcpFDHandler k;
+        TcpInformation inf;
+        if(clientfd[fd].fd!=-1)//can not find fd information,we need to writedown this error and close this fd
+        {
+            
+                STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 正在处理fd= "+to_string(fd),"tcp server : now handleing fd= "+to_string(fd));
+            
+            TcpFDInf &Tcpinf=clientfd[fd];
+            k.setFD(fd,clientfd[fd].ssl,unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            
+            int ret=1;
+            Tcpinf.p_buffer_now=0;
+            while(ret>0&&buffer_size-Tcpinf.p_buffer_now>0)
+            {
+                //缓冲区装满了（或者还没有）就从池里换上一级 最多到buffer_size
+                if(Tcpinf.p_buffer_now>=Tcpinf.buffer_cap)
+                    RecvBufferPool::reserve(Tcpinf,Tcpinf.p_buffer_now+1);
+                ret=k.recvData(Tcpinf.buffer+Tcpinf.p_buffer_now,(Tcpinf.buffer_cap<buffer_size?Tcpinf.buffer_cap:buffer_size)-Tcpinf.p_buffer_now);
+                if(ret>0)
+                    Tcpinf.p_buffer_now+=ret;
+            }
+            if(buffer_size-Tcpinf.p_buffer_now<=0)
+            {
+                TcpServer::close(fd);
+                STT_LOG(stt::file::LogLevel::WARN,"tcp server : 缓冲区容量不足 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接","tcp server : buffer size is not enough,read data from fd= "+to_string(fd)+" fail,now has closed this connection");
+                return;
+            }
+            if(ret<=0)
+            {
+                if(ret!=-100)
+                {
+                    TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接","tcp server : read data from fd= "+to_string(fd)+" fail,now has closed this connection");
+                    return;
+                }
+            }
+        //}
+        
+            inf.fd=fd;
+            inf.connection_obj_fd=clientfd[fd].connection_obj_fd;
+            inf.data=string(Tcpinf.buffer,Tcpinf.p_buffer_now);
+            Tcpinf.p_buffer_now=0;//数据已经全部拷贝出去 缓冲区可以还回池里
+
+            
+            //lock6.unlock();
+            //开始处理
+                //入队
+            
+            Tcpinf.pendindQueue.push(move(inf));
+            
+            if(Tcpinf.pendindQueue.size()==1)//只有一个 说明没有任务没做完 直接执行
+            {
+                TcpInformation &inff=std::any_cast<TcpInformation&>(clientfd[fd].pendindQueue.front());
+                Tcpinf.FDStatus=-1;
+                int ret;
+                //获取key,自动解析到ctx的key键
+                ++Tcpinf.FDStatus;
+                ret=parseKey(k,inff);
+                
+                if(ret==0) //慢任务
+                {
+                    return;
+                }
+                else if(ret<=-1)
+                {
+                    //清掉任务后返回
+                    //Tcpinf.pendindQueue.pop();
+                    //-2要关闭连接
+                    if(ret==-2)
+                    {
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接","tcp server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
+                    }
+                    else
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务","tcp server : parsekey fail fd= "+to_string(fd)+",now has throwed this task");
+                    }
+                    return;
+                }
+                if(security_open)
+                {
+                    int ret=connectionLimiter.allowRequest(clientfd[fd].getIP(),fd,std::any_cast<const std::string&>(inff.ctx["key"]),requestTimes,requestSecs);
+                    if(ret!=stt::security::ALLOW)
+                    {
+                        securitySendBackFun(k,inff);
+                        if(ret==stt::security::CLOSE)
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::WARN,"tcp server : fd="+to_string(fd)+"请求太频繁，已经关闭连接","tcp server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
+                        }
+                        else
+                        {
+                            STT_LOG(stt::file::LogLevel::WARN,"tcp server : fd="+to_string(fd)+"请求太频繁，已经忽略请求","tcp server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
+                        }
+                        return;
+                    }
+                }
+                //遍历任务
+                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
+               
+                if(ii==solveFun.end())//找不到
+                {
+                    
+                    //TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","tcp server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                    if(!globalSolveFun(k,inff))
+                    {
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.","tcp server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
+                        return;
+                    }
+                    Tcpinf.pendindQueue.pop();
+                }
+                else//找得到处理函数
+                {
+                    
+                    for(auto &f:ii->second)
+                    {
+                        int rett=f(k,inff);
+                        ++Tcpinf.FDStatus;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","tcp server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","tcp server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else if(rett==-1)
+                        {
+                        
+                            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                        else
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"tcp server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","tcp server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                    }
+                    Tcpinf.pendindQueue.pop();
+                }
+
+                    STT_LOG(stt::file::LogLevel::TRACE,"tcp server : 处理fd= "+to_string(fd)+" 完成","tcp server : handled fd= "+to_string(fd)+" sucessfully");
+                
+            }
+            
+        }
+    }
+    /*
+    void stt::network::TcpServer::consumer(const int &threadID)
+    {
+        TcpFDHandler k;
+
+        if(stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(stt::system::ServerSetting::language=="Chinese")
+            stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" 打开");
+            else
+                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" 打开");
+        }
+        while(flag1)
+        {
+            unique_lock<mutex> ul1(lq1[threadID]);
+            while(fdQueue[threadID].empty()&&flag1)
+            {
+                cv[threadID].wait(ul1);
+            }
+            if(!flag1)
+            {
+                ul1.unlock();
+                break;
+            }
+            QueueFD cclientfd=fdQueue[threadID].front();
+            fdQueue[threadID].pop();
+            
+            ul1.unlock();
+
+            
+            if(cclientfd.close)
+            {
+                TcpServer::close(cclientfd.fd);
+                continue;
+            }
+            
+            //unique_lock<mutex> lock6(lc1);
+            //auto jj=clientfd.find(cclientfd.fd);
+            if(clientfd[cclientfd.fd].fd==-1)//can not find fd information,we need to writedown this error and close this fd
+            {
+                //lock6.unlock();
+                continue;
+            }
+            else
+            {
+                if(security_open)
+                {
+                    if(!connectionLimiter.allowRequest(clientfd[cclientfd.fd].getIP()))
+                    {
+                        TcpServer::close(cclientfd.fd);
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"请求太频繁，已经关闭连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"request are too frequent,now has closed this connection");
+                        }
+                        continue;
+                    }
+                }
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : 正在处理fd= "+to_string(cclientfd.fd));
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" :now handleing fd= "+to_string(cclientfd.fd));
+                }
+                k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                TcpFDInf &Tcpinf=clientfd[cclientfd.fd];
+            //lock6.unlock();
+            
+            if(!fc(k,Tcpinf))
+            {
+                TcpServer::close(cclientfd.fd);
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer"+to_string(threadID)+" : 处理fd= "+to_string(cclientfd.fd)+" 失败，已经关闭连接");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : handled fd= "+to_string(cclientfd.fd)+" fail,now has closed this connection");
+                }
+            }
+            else
+            {
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer"+to_string(threadID)+" : 处理fd= "+to_string(cclientfd.fd)+" 完成");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : handled fd= "+to_string(cclientfd.fd)+" sucessfully");
+                }
+            }
+            }
+            
+        }
+        //跳出循环意味着结束线程
+        unique_lock<mutex> lock3(lco1);
+        consumerNum--;
+        lock3.unlock();
+        cout<<"consumer "<<consumerNum<<" quit"<<endl;
+        if(stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(stt::system::ServerSetting::language=="Chinese")
+                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(consumerNum)+"退出");
+            else
+                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(consumerNum)+"quit");
+        }
+    }
+    */
+    //响应头在线程本地的缓冲区里生成 和响应体分两段发送 响应体不拷贝
+    static bool sendResponse(stt::network::HttpServerFDHandler &k,const char *data,const size_t &length,const char *code,const char *headerA,const char *headerB)
+    {
+        thread_local std::string head;
+        head.clear();
+        head.append("HTTP/1.1 ").append(code).append("\r\nContent-Length: ");
+        char num[24];
+        auto [end,ec]=std::to_chars(num,num+sizeof(num),length);
+        head.append(num,end-num).append("\r\n").append(headerA).append(headerB).append("\r\n");
+        iovec iov[2];
+        iov[0].iov_base=(void*)head.data();
+        iov[0].iov_len=head.size();
+        iov[1].iov_base=(void*)data;
+        iov[1].iov_len=length;
+        int total=head.size()+length;
+        return k.sendData(iov,length>0?2:1)==total;
+    }
+    bool stt::network::HttpServerFDHandler::sendBack(const string &data,const string &header,const string &code,const string &header1)
+    {
+        return sendResponse(*this,data.data(),data.length(),code.c_str(),header1.c_str(),header.c_str());
+    }
+    
+    bool stt::network::HttpServerFDHandler::sendBack(const char *data,const size_t &length,const char *header,const char *code,const char *header1,const size_t &header_length)
+    {
+        return sendResponse(*this,data,length,code,header,header1);
+    }
+    
+    //按扩展名猜Content-Type
+    static const char* contentType(const std::string &path)
+    {
+        static const std::unordered_map<std::string,const char*> types={
+            {"html","text/html; charset=utf-8"},{"htm","text/html; charset=utf-8"},{"css","text/css"},
+            {"js","application/javascript"},{"json","application/json"},{"txt","text/plain; charset=utf-8"},
+            {"xml","application/xml"},{"png","image/png"},{"jpg","image/jpeg"},{"jpeg","image/jpeg"},
+            {"gif","image/gif"},{"svg","image/svg+xml"},{"ico","image/x-icon"},{"wasm","application/wasm"},
+            {"pdf","application/pdf"},{"mp4","video/mp4"},{"woff2","font/woff2"}};
+        size_t dot=path.rfind('.');
+        if(dot==std::string::npos||path.find('/',dot)!=std::string::npos)
+            return "application/octet-stream";
+        std::string ext=path.substr(dot+1);
+        for(auto &c:ext)
+            c=tolower(c);
+        auto ii=types.find(ext);
+        return ii==types.end()?"application/octet-stream":ii->second;
+    }
+    int stt::network::HttpServerFDHandler::sendFile(const string &path,const HttpRequestInformation &inf,const string &header,const string &header1)
+    {
+        std::shared_ptr<FileCache::Entry> file=FileCache::get(path);
+        if(file==nullptr)
+            return 0;
+        uint64_t begin=0;
+        uint64_t length=file->size;
+        const char *code="200 OK";
+        std::string extra;
+        std::string value;
+        HttpStringUtil::get_value_header(inf.header,value,"If-None-Match");
+        if(!value.empty()&&(value==file->etag||value=="*"))//客户端的缓存还有效
+        {
+            code="304 Not Modified";
+            length=0;
+        }
+        else
+        {
+            HttpStringUtil::get_value_header(inf.header,value,"Range");
+            //只支持单个区间 多个区间时忽略Range 发整个文件
+            if(value.compare(0,6,"bytes=")==0&&value.find(',')==std::string::npos)
+            {
+                size_t dash=value.find('-',6);
+                bool ok=dash!=std::string::npos;
+                uint64_t a=0;
+                uint64_t b=file->size>0?file->size-1:0;
+                if(ok)
+                {
+                    const char *p1=value.data()+6;
+                    const char *p2=value.data()+dash;
+                    const char *p3=value.data()+value.size();
+                    if(p1==p2)//bytes=-n 最后n个字节
+                    {
+                        uint64_t n=0;
+                        auto [end,ec]=std::from_chars(p2+1,p3,n);
+                        ok=ec==std::errc()&&end==p3&&n>0&&file->size>0;
+                        if(ok&&n<file->size)
+                            a=file->size-n;
+                    }
+                    else
+                    {
+                        auto [end,ec]=std::from_chars(p1,p2,a);
+                        ok=ec==std::errc()&&end==p2;
+                        if(ok&&p2+1!=p3)//bytes=a-b
+                        {
+                            auto [end1,ec1]=std::from_chars(p2+1,p3,b);
+                            ok=ec1==std::errc()&&end1==p3&&b>=a;
+                            if(ok&&b>=file->size)
+                                b=file->size-1;
+                        }
+                        ok=ok&&a<file->size;
+                    }
+                }
+                if(!ok)
+                {
+                    extra="Content-Range: bytes */"+to_string(file->size)+"\r\n";
+                    return sendBack("",extra,"416 Range Not Satisfiable")?1:-1;
+                }
+                begin=a;
+                length=b-a+1;
+                code="206 Partial Content";
+                extra="Content-Range: bytes "+to_string(a)+"-"+to_string(b)+"/"+to_string(file->size)+"\r\n";
+            }
+        }
+        std::string head;
+        head.reserve(256+header.size()+header1.size());
+        head.append("HTTP/1.1 ").append(code).append("\r\n");
+        if(length>0||code[0]!='3')//304不带Content-Length
+            head.append("Content-Length: ").append(to_string(length)).append("\r\n");
+        if(header.find("Content-Type")==std::string::npos&&header1.find("Content-Type")==std::string::npos)
+            head.append("Content-Type: ").append(contentType(path)).append("\r\n");
+        head.append("ETag: ").append(file->etag).append("\r\nLast-Modified: ").append(file->lastModified).append("\r\nAccept-Ranges: bytes\r\n");
+        head.append(extra).append(header).append(header1).append("\r\n");
+        if(inf.type=="HEAD")//HEAD只要响应头
+            length=0;
+        int result=TcpFDHandler::sendFile(file,begin,length,head);
+        return result>0&&!flag3?1:-1;
+    }
+    
+    int stt::network::HttpServerFDHandler::solveRequest(TcpFDInf &TcpInf,HttpRequestInformation &HttpInf,const unsigned long &buffer_size,const int &times)
+    {
+
+        if(times==1)
+        {
+            
+            //unsigned long long p_buffer_now_backup=TcpInf.p_buffer_now;
+            int ret=1;
+            while(ret>0&&buffer_size-TcpInf.p_buffer_now>0)
+            {
+                
+                //缓冲区装满了（或者还没有）就从池里换上一级 最多到buffer_size
+                if(TcpInf.p_buffer_now>=TcpInf.buffer_cap)
+                    RecvBufferPool::reserve(TcpInf,TcpInf.p_buffer_now+1);
+                ret=recvData(TcpInf.buffer+TcpInf.p_buffer_now,(TcpInf.buffer_cap<buffer_size?TcpInf.buffer_cap:buffer_size)-TcpInf.p_buffer_now);
+                if(ret>0)
+                    TcpInf.p_buffer_now+=ret;
+            }
+            if(buffer_size-TcpInf.p_buffer_now<=0)
+            {
+                STT_LOG(stt::file::LogLevel::WARN,"http server : 缓冲区容量不足 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接","http server : buffer size is not enough,read data from fd= "+to_string(fd)+" fail,now has closed this connection");
+                return -1;
+            }
+            if(ret<=0)
+            {
+                
+                if(ret!=-100)
+                    return -1;
+                
+            }
+            //TcpInf.data=string_view(TcpInf.buffer+p_buffer_now_backup,TcpInf.p_buffer_now);
+            TcpInf.data=string_view(TcpInf.buffer,TcpInf.p_buffer_now);
+            //cout<<TcpInf.data<<endl;
+        }
+        //cout<<TcpInf.data<<endl;
+        //endd=chrono::high_resolution_clock::now();
+        //                duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+        //                cout<<"接受完数据用时"<<duration.count()<<endl;
+        //数据准备完成，开始判断
+        
+        if(TcpInf.status==0||TcpInf.status==1)
+        {
+            auto pos=TcpInf.data.find("\r\n\r\n");
+            if(pos==string::npos)
+            {
+                if(TcpInf.status==0)
+                    TcpInf.status=1;
+                //memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
+                //TcpInf.p_buffer_now=TcpInf.data.length();
+                
+                return 0;
+            }
+            
+            //转到状态2或者3
+            HttpInf.header=TcpInf.data.substr(0,pos);
+            
+            
+            if(HttpInf.header.find("Transfer-Encoding: chunked")!=string::npos)//状态2
+            {
+                TcpInf.status=2;
+                
+                if(TcpInf.data.find("0\r\n\r\n")==string::npos)
+                {
+                    //memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
+                    HttpInf.header=string(TcpInf.buffer,pos);
+                    //TcpInf.p_buffer_now=TcpInf.data.length();
+                    return 0;
+                }
+                string_view size;
+                int ssize;
+                size_t ppos=0;
+                TcpInf.data=TcpInf.data.substr(2+HttpInf.header.length());
+                while(1)
+                {
+                    HttpStringUtil::get_split_str(TcpInf.data,size,"\r\n","\r\n",ppos);
+                    
+                    ppos=TcpInf.data.find("\r\n",ppos+2);
+                    NumberStringConvertUtil::str16toInt(string(size),ssize);
+                    if(ssize==-1)
+                    {
+                        
+                        return -1;
+                    }
+                    else if(ssize==0)
+                    {
+                        //TcpInf.data=TcpInf.data.substr(ppos+5);
+                        TcpInf.status=0;
+                        //if(TcpInf.data.length()==ppos+2)
+                        //    TcpInf.data={};
+                        //else
+                        //    TcpInf.data=TcpInf.data.substr(ppos+2);
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                        memcpy(TcpInf.buffer,TcpInf.buffer+ppos+2,TcpInf.p_buffer_now-(ppos+2));
+                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(ppos+2);
+                        return 1;
+                    }
+                    else//读取数据
+                    {
+                        HttpInf.body_chunked+=TcpInf.data.substr(ppos+2,ssize);
+                        ppos=ppos+2+ssize;
+                    }
+                }
+            }
+            else//状态3
+            {
+                 //endd=chrono::high_resolution_clock::now();
+                 //       duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+                 //       cout<<"状态3用时"<<duration.count()<<endl;
+                TcpInf.status=3;
+                string_view size;
+                long ssize;
+
+                HttpStringUtil::get_split_str(HttpInf.header,size,"Content-Length: ","\r\n");
+                 //endd=chrono::high_resolution_clock::now();
+                //        duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+                 //       cout<<"split完用时"<<duration.count()<<endl;
+                NumberStringConvertUtil::toLong(string(size),ssize);
+                // endd=chrono::high_resolution_clock::now();
+                //        duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+                //        cout<<"tolong完用时"<<duration.count()<<endl;
+                if(ssize==-1)
+                {
+                    
+                    //if(HttpInf.header.find("GET")!=string::npos)
+                    //{
+                        TcpInf.status=0;
+                        //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
+                        //    TcpInf.data={};
+                        //else
+                        //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                        memcpy(TcpInf.buffer,TcpInf.buffer+HttpInf.header.length()+4,TcpInf.p_buffer_now-(HttpInf.header.length()+4));
+                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(HttpInf.header.length()+4);
+                        return 1;
+                    //}
+                    //else
+                    //    return -1;
+                }
+                else if(ssize==0)
+                {
+                    TcpInf.status=0;
+                    //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
+                    //    TcpInf.data={};
+                    //else
+                    //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
+                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                    HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                    HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                    memcpy(TcpInf.buffer,TcpInf.buffer+HttpInf.header.length()+4,TcpInf.p_buffer_now-(HttpInf.header.length()+4));
+                    TcpInf.p_buffer_now=TcpInf.p_buffer_now-(HttpInf.header.length()+4);
+                    return 1;
+                }
+                else if(ssize>0)
+                {
+                    if(TcpInf.data.length()-4-HttpInf.header.length()>=ssize)
+                    {
+                        HttpInf.body=TcpInf.data.substr(4+HttpInf.header.length(),ssize);
+                        //if(TcpInf.data.length()-4-HttpInf.header.length()==ssize)
+                        //    TcpInf.data={};
+                        //else
+                        //    TcpInf.data=TcpInf.data.substr(4+HttpInf.header.length()+ssize);
+                        TcpInf.status=0;
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                        memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length()+ssize,TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize));
+                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize);
+                        return 1;
+                    }
+                    else
+                    {
+                        memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
+                        HttpInf.header=string(TcpInf.buffer,pos);
+                        TcpInf.p_buffer_now=TcpInf.data.length();
+                        return 0;
+                    }
+                }
+            }
+        }
+        else if(TcpInf.status==2)
+        {
+            if(TcpInf.data.find("0\r\n\r\n")==string::npos)
+                {
+                    memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
+                    TcpInf.p_buffer_now=TcpInf.data.length();
+                    return 0;
+                }
+                string_view size;
+                int ssize;
+                size_t ppos=0;
+                TcpInf.data=TcpInf.data.substr(2+HttpInf.header.length());
+                while(1)
+                {
+                    HttpStringUtil::get_split_str(TcpInf.data,size,"\r\n","\r\n",ppos);
+                    
+                    ppos=TcpInf.data.find("\r\n",ppos+2);
+                    NumberStringConvertUtil::str16toInt(string(size),ssize);
+                    if(ssize==-1)
+                    {
+                        
+                        return -1;
+                    }
+                    else if(ssize==0)
+                    {
+                        //TcpInf.data=TcpInf.data.substr(ppos+5);
+                        TcpInf.status=0;
+                        //if(TcpInf.data.length()==ppos+2)
+                        //    TcpInf.data={};
+                        //else
+                        //    TcpInf.data=TcpInf.data.substr(ppos+2);
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                        memcpy(TcpInf.buffer,TcpInf.buffer+ppos+2,TcpInf.p_buffer_now-(ppos+2));
+                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(ppos+2);
+                        return 1;
+                    }
+                    else//读取数据
+                    {
+                        HttpInf.body_chunked+=TcpInf.data.substr(ppos+2,ssize);
+                        ppos=ppos+2+ssize;
+                    }
+                }
+        }   
+        else if(TcpInf.status==3)
+        {
+                TcpInf.status=3;
+                string_view size;
+                long ssize;
+                HttpStringUtil::get_split_str(HttpInf.header,size,"Content-Length: ","\r\n");
+                NumberStringConvertUtil::toLong(string(size),ssize);
+
+                if(ssize==-1)
+                {
+                    
+                    //if(HttpInf.header.find("GET")!=string::npos)
+                    //{
+                        TcpInf.status=0;
+                        //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
+                        //    TcpInf.data={};
+                        //else
+                        //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                        memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length(),TcpInf.p_buffer_now-(4+HttpInf.header.length()));
+                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length());
+                        return 1;
+                    //}
+                    //else
+                    //    return -1;
+                }
+                else if(ssize==0)
+                {
+                    TcpInf.status=0;
+                    //if(TcpInf.data.length()-4-HttpInf.header.length()==0)
+                    //    TcpInf.data={};
+                    //else
+                    //    TcpInf.data=TcpInf.data.substr(HttpInf.header.length()+4);
+                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                    HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                    HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                    HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                    memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length(),TcpInf.p_buffer_now-(4+HttpInf.header.length()));
+                    TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length());
+                    return 1;
+                }
+                else if(ssize>0)
+                {
+                    if(TcpInf.data.length()-4-HttpInf.header.length()>=ssize)
+                    {
+                        HttpInf.body=TcpInf.data.substr(4+HttpInf.header.length(),ssize);
+                        //if(TcpInf.data.length()-4-HttpInf.header.length()==ssize)
+                         //   TcpInf.data={};
+                        //else
+                        //    TcpInf.data=TcpInf.data.substr(4+HttpInf.header.length()+ssize);
+                        TcpInf.status=0;
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.type,""," ");
+                        HttpStringUtil::get_split_str(HttpInf.header,HttpInf.locPara," "," ");
+                        HttpStringUtil::get_location_str(HttpInf.locPara,HttpInf.loc);
+                        HttpStringUtil::getPara(HttpInf.locPara,HttpInf.para);
+                        memcpy(TcpInf.buffer,TcpInf.buffer+4+HttpInf.header.length()+ssize,TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize));
+                        TcpInf.p_buffer_now=TcpInf.p_buffer_now-(4+HttpInf.header.length()+ssize);
+                        return 1;
+                    }
+                    else
+                    {
+                        memcpy(TcpInf.buffer,TcpInf.buffer+TcpInf.p_buffer_now-TcpInf.data.length(),TcpInf.data.length());
+                        TcpInf.p_buffer_now=TcpInf.data.length();
+                        return 0;
+                    }
+                }
+        }
+        
+        return -1;
+
+    }
+    int stt::network::HttpServer::serveStatic(HttpServerFDHandler &k,HttpRequestInformation &inf)
+    {
+        for(auto &[prefix,dir]:staticDir)
+        {
+            if(inf.loc.compare(0,prefix.size(),prefix)!=0)
+                continue;
+            std::string rest=inf.loc.substr(prefix.size());
+            if(rest.find("..")!=std::string::npos)//不允许跳出目录
+                return k.sendBack("","","403 FORBIDDEN")?1:-1;
+            std::string path=dir;
+            if(!path.empty()&&path.back()!='/'&&!rest.empty()&&rest[0]!='/')
+                path+='/';
+            path+=rest;
+            struct stat st;
+            if(path.empty()||path.back()=='/')
+                path+="index.html";
+            else if(::stat(path.c_str(),&st)==0&&S_ISDIR(st.st_mode))
+                path+="/index.html";
+            int ret=k.sendFile(path,inf);
+            if(ret==0)
+                return k.sendBack("","","404 NOT FOUND")?1:-1;
+            STT_LOG(stt::file::LogLevel::DEBUG,"http server : fd= "+to_string(inf.fd)+" 发送静态文件 "+path,"http server : fd= "+to_string(inf.fd)+" sent static file "+path);
+            return ret;
+        }
+        return 0;
+    }
+    void stt::network::HttpServer::handler_netevent(const int &fd)
+    {
+        HttpServerFDHandler k;
+        //HttpRequestInformation inf;
+        if(clientfd[fd].fd!=-1)//can not find fd information,we need to writedown this error and close this fd
+        {
+            
+                STT_LOG(stt::file::LogLevel::TRACE,"http server : 正在处理fd= "+to_string(fd),"http server : now handleing fd= "+to_string(fd));
+            TcpFDInf &Tcpinf=clientfd[fd];
+            k.setFD(fd,clientfd[fd].ssl,unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            
+            int ret=1;
+            httpinf[fd].fd=fd;
+            httpinf[fd].connection_obj_fd=clientfd[fd].connection_obj_fd;
+            
+            ret=k.solveRequest(Tcpinf,httpinf[fd],buffer_size,1);
+            
+            if(ret==-1)
+            {
+                    TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"http server : 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接","http server : read data from fd= "+to_string(fd)+" fail,now has closed this connection");
+                    return;
+            }
+            else if(ret==1)
+            {
+                
+                //整个请求内容的转储 只在TRACE级别生成
+                STT_LOG(stt::file::LogLevel::TRACE,
+                    (httpinf[fd].body.length()<=1024*10&&httpinf[fd].body_chunked.length()<=1024*10)?
+                    "http server consumer  : fd= "+to_string(fd)+" 读取数据完成。 \n*******请求信息：*********\nheader= "+string(httpinf[fd].header)+"\nbody="+string(httpinf[fd].body)+"\nbody_chunked="+string(httpinf[fd].body_chunked)+"\n*************************":
+                    "http server consumer  : fd= "+to_string(fd)+" 读取数据完成。 \n*******请求信息：*********\nheader= "+string(httpinf[fd].header)+"\nbody,body_chunked= ... \n*************************",
+                    (httpinf[fd].body.length()<=1024*10&&httpinf[fd].body_chunked.length()<=1024*10)?
+                    "http server consumer  : fd= "+to_string(fd)+" now has solved request.\n*******request information：*********\nheader= "+string(httpinf[fd].header)+"\nbody="+string(httpinf[fd].body)+"\nbody_chunked="+string(httpinf[fd].body_chunked)+"\n*************************":
+                    "http server consumer  : fd= "+to_string(fd)+" now has solved request.\n*******request information：*********\nheader= "+string(httpinf[fd].header)+"\nbody,body_chunked= ... \n*************************");
+            }
+            else if(ret==0)
+            {
+                    STT_LOG(stt::file::LogLevel::TRACE,"http server consumer  : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析","http server consumer  : fd= "+to_string(fd)+"wait new data to continue solve this request");
+                    return;
+            }
+        
+            
+
+            
+            //lock6.unlock();
+            //开始处理
+                //入队
+            Tcpinf.pendindQueue.push(move(httpinf[fd]));
+            
+            if(Tcpinf.pendindQueue.size()==1)//只有一个 说明没有任务没做完 直接执行
+            {
+                HttpRequestInformation &inff=std::any_cast<HttpRequestInformation&>(clientfd[fd].pendindQueue.front());
+                Tcpinf.FDStatus=-1;
+                int ret;
+                //获取key,自动解析到ctx的key键
+                ++Tcpinf.FDStatus;
+                ret=parseKey(k,inff);
+    
+                if(ret==0)//慢处理
+                {
+                    return;
+                }
+                else if(ret<=-1)
+                {
+                    //清掉任务后返回
+                    //Tcpinf.pendindQueue.pop();
+                    //-2要关闭连接
+                    if(ret==-2)
+                    {
+                        k.sendBack("","","404 NOT FOUND");
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接","http server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
+                    }
+                    else
+                    {
+                        k.sendBack("","","404 NOT FOUND");
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息","http server : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
+                    }
+                    return;
+                }
+                if(security_open)
+                {
+                    int ret=connectionLimiter.allowRequest(clientfd[fd].getIP(),fd,std::any_cast<const std::string&>(inff.ctx["key"]),requestTimes,requestSecs);
+                    if(ret!=stt::security::ALLOW)
+                    {
+                        securitySendBackFun(k,inff);
+                        if(ret==stt::security::CLOSE)
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::WARN,"http server : fd="+to_string(fd)+"请求太频繁，已经关闭连接","http server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
+                        }
+                        else
+                        {
+                            STT_LOG(stt::file::LogLevel::WARN,"http server : fd="+to_string(fd)+"请求太频繁，已经忽略请求","http server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
+                        }
+                        return;
+                    }
+                }
+                //遍历任务
+                
+                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
+                
+                if(ii==solveFun.end())//找不到
+                {
+                    int staticRet=serveStatic(k,inff);//先看是不是静态目录里的文件
+                    if(staticRet<0)
+                    {
+                        TcpServer::close(fd);
+                        return;
+                    }
+                    else if(staticRet>0)
+                    {
+                        ++Tcpinf.FDStatus;
+                    }
+                    else if(globalSolveFun.size()==0)//连全局处理函数都没有 只能发404
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : 找不到处理函数也找不到全局处理函数 fd= "+to_string(fd)+"发送404 not found.","http server : can not find solve function and global function. fd= "+to_string(fd)+". has sent 404 not found.");
+                        if(!k.sendBack("","","404 NOT FOUND"))
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 发送404 not found失败 fd= "+to_string(fd)+"已经关闭连接.","http server : sending 404 not found fail. fd= "+to_string(fd)+". has closed this connection.");
+                            return;
+                        }
+                    }
+                    else
+                    {
+                    
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","http server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                        for(auto &f:globalSolveFun)
+                        {
+                            int rett=f(k,inff);
+                            ++Tcpinf.FDStatus;
+                            if(rett==1)
+                            {
+                                STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                            }
+                            else if(rett==0)
+                            {
+                                STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            
+                                return;
+                            }
+                            else if(rett==-1)
+                            {
+                            
+                                STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                                //Tcpinf.pendindQueue.pop();
+                                return;
+                            }
+                            else
+                            {
+                                TcpServer::close(fd);
+                                STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                                //Tcpinf.pendindQueue.pop();
+                                return;
+                            }
+                        }
+                    }
+                    clientfd[fd].pendindQueue.pop();
+                }
+                else//找得到处理函数
+                {
+                    for(auto &f:ii->second)
+                    {
+                        int rett=f(k,inff);
+                        ++Tcpinf.FDStatus;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            
+                            return;
+                        }
+                        else if(rett==-1)
+                        {
+                            
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                        else
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                    }
+                    Tcpinf.pendindQueue.pop();
+                }
+
+                    STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 完成","http server : handled fd= "+to_string(fd)+" sucessfully");
+                
+            }
+            
+        }
+    }
+     void stt::network::HttpServer::handler_workerevent(const int &fd,const int &ret)
+    {
+       
+        if(ret==-2)
+        {
+            TcpServer::close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"http server : worker处理失败 fd= "+to_string(fd)+" ，已经关闭连接","http server : worker solve fail fd= "+to_string(fd)+" ,now has closed this connection");
+            return;
+        }
+        HttpServerFDHandler k;
+        k.setFD(fd,clientfd[fd].ssl,unblock);
+        k.setOutputBuffer(getOutputBuffer(fd));
+        
+        if(ret==-1)
+        {
+            clientfd[fd].pendindQueue.pop();
+            STT_LOG(stt::file::LogLevel::DEBUG,"http server : worker处理失败 fd= "+to_string(fd)+" ，跳过本次请求","http server : worker solve fail fd= "+to_string(fd)+" ,skip this request");
+        }
+        else
+        {
+            if(clientfd[fd].pendindQueue.empty())
+            {
+                STT_LOG(stt::file::LogLevel::DEBUG,"http server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd),"http server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
+                return;
+            }
+            HttpRequestInformation &inf=std::any_cast<HttpRequestInformation&>(clientfd[fd].pendindQueue.front());
+            if(inf.connection_obj_fd!=clientfd[fd].connection_obj_fd)
+            {
+                STT_LOG(stt::file::LogLevel::DEBUG,"http server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd),"http server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
+                return;
+            }
+            
+            auto ii=solveFun.find(std::any_cast<const std::string&>(inf.ctx["key"]));//对应的任务
+            STT_LOG(stt::file::LogLevel::TRACE,"http server : worker处理成功 fd= "+to_string(fd),"http server : worker solve sucessfully fd= "+to_string(fd));
+            if(ii==solveFun.end())//找不到
+            {
+                    
+                    if(globalSolveFun.size()==0)//连全局处理函数都没有 只能发404
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : 找不到处理函数也找不到全局处理函数 fd= "+to_string(fd)+"发送404 not found.","http server : can not find solve function and global function. fd= "+to_string(fd)+". has sent 404 not found.");
+                        if(!k.sendBack("","","404 NOT FOUND"))
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 发送404 not found失败 fd= "+to_string(fd)+"已经关闭连接.","http server : sending 404 not found fail. fd= "+to_string(fd)+". has closed this connection.");
+                            return;
+                        }
+                    }
+                    else
+                    {
+                    
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","http server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                        for(;clientfd[fd].FDStatus<globalSolveFun.size();)
+                        {
+                            //继续做
+                            int rett=globalSolveFun[clientfd[fd].FDStatus](k,inf);
+                            clientfd[fd].FDStatus++;
+                            if(rett==1)
+                            {
+                                STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成","http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
+                            }
+                            else if(rett==0)
+                            {
+                                STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.","http server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
+                                return;
+                            }
+                            else
+                            {
+                                TcpServer::close(fd);
+                                STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
+                                //clientfd[fd].pendindQueue.pop();
+                                return;
+                            }
+                        }
+                    }
+                    clientfd[fd].pendindQueue.pop();
+            }
+            else
+            {
+            //继续做
+            
+            for(;clientfd[fd].FDStatus<ii->second.size();)
+            {
+                
+                int rett=ii->second[clientfd[fd].FDStatus](k,inf);
+                clientfd[fd].FDStatus++;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成","http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.","http server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
+                            //clientfd[fd].pendindQueue.pop();
+                            return;
+                        }
+            }
+            
+            clientfd[fd].pendindQueue.pop();
+            }
+        }
+     
+        TcpFDInf Tcpinf=clientfd[fd];
+        //检查是否有下一轮
+        if(Tcpinf.pendindQueue.size()>=1)//只有一个 说明没有任务没做完 直接执行
+            {
+                HttpRequestInformation &inff=std::any_cast<HttpRequestInformation&>(clientfd[fd].pendindQueue.front());
+                Tcpinf.FDStatus=-1;
+                int ret;
+                //获取key,自动解析到ctx的key键
+                ++Tcpinf.FDStatus;
+                ret=parseKey(k,inff);
+
+                if(ret==0)//慢处理
+                    return;
+                else if(ret<=-1)
+                {
+                    //清掉任务后返回
+                    Tcpinf.pendindQueue.pop();
+                    //-2要关闭连接
+                    if(ret==-2)
+                    {
+                        k.sendBack("","","404 NOT FOUND");
+                        TcpServer::close(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接","http server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
+                    }
+                    else
+                    {
+                        k.sendBack("","","404 NOT FOUND");
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息","http server : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
+                    }
+                    return;
+                }
+                
+                //遍历任务
+                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
+                if(ii==solveFun.end())//找不到
+                {
+                    int staticRet=serveStatic(k,inff);//先看是不是静态目录里的文件
+                    if(staticRet<0)
+                    {
+                        TcpServer::close(fd);
+                        return;
+                    }
+                    else if(staticRet>0)
+                    {
+                        ++Tcpinf.FDStatus;
+                    }
+                    else if(globalSolveFun.size()==0)//连全局处理函数都没有 只能发404
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : 找不到处理函数也找不到全局处理函数 fd= "+to_string(fd)+"发送404 not found.","http server : can not find solve function and global function. fd= "+to_string(fd)+". has sent 404 not found.");
+                        if(!k.sendBack("","","404 NOT FOUND"))
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 发送404 not found失败 fd= "+to_string(fd)+"已经关闭连接.","http server : sending 404 not found fail. fd= "+to_string(fd)+". has closed this connection.");
+                            return;
+                        }
+                    }
+                    else
+                    {
+                    
+                        STT_LOG(stt::file::LogLevel::DEBUG,"http server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","http server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                        for(auto &f:globalSolveFun)
+                        {
+                            int rett=f(k,inff);
+                            ++Tcpinf.FDStatus;
+                            if(rett==1)
+                            {
+                                STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                            }
+                            else if(rett==0)
+                            {
+                                STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            
+                                return;
+                            }
+                            else if(rett==-1)
+                            {
+                            
+                                STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                                //Tcpinf.pendindQueue.pop();
+                                return;
+                            }
+                            else
+                            {
+                                TcpServer::close(fd);
+                                STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                                //Tcpinf.pendindQueue.pop();
+                                return;
+                            }
+                        }
+                    }
+                    clientfd[fd].pendindQueue.pop();
+                }
+                else//找得到处理函数
+                {
+                    for(auto &f:ii->second)
+                    {
+                        int rett=f(k,inff);
+                        ++Tcpinf.FDStatus;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","http server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","http server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else if(rett==-1)
+                        {
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                        else
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"http server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","http server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                    }
+                    
+                }
+                Tcpinf.pendindQueue.pop();
+
+                    STT_LOG(stt::file::LogLevel::TRACE,"http server : 处理fd= "+to_string(fd)+" 完成","http server : handled fd= "+to_string(fd)+" sucessfully");
+                
+            }
+
+    }
+
+    void stt::network::WebSocketServer::handler_netevent(const int &fd)
+    {
+        
+        
+        if(clientfd[fd].fd!=-1)//can not find fd information,we need to writedown this error and close this fd
+        {
+            
+                
+                STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 正在处理fd= "+to_string(fd),"websocket server : now handleing fd= "+to_string(fd));
+            TcpFDInf &Tcpinf=clientfd[fd];
+
+            //unique_lock<mutex> lock(lwb);
+            auto jj=wbTable(fd).find(fd);
+            if(jj==wbTable(fd).end())//没有进行wb握手
+            {
+                
+                HttpServerFDHandler k;
+                k.setFD(fd,clientfd[fd].ssl,unblock);
+                k.setOutputBuffer(getOutputBuffer(fd));
+                //k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                //unique_lock<mutex> lock(lwb);
+                STT_LOG(stt::file::LogLevel::TRACE,"websocket server consumer  : fd= "+to_string(fd)+" 正在进行websocket握手","websocket server consumer  : fd= "+to_string(fd)+" handshaking websocket...");
+                WebSocketFDInformation winf;
+                winf.fd=fd;
+                winf.closeflag=false;
+                
+                //HttpRequestInformation HttpInf;
+                int ret=k.solveRequest(Tcpinf,winf.httpinf,buffer_size,1);
+                if(ret==-1)
+                {
+                    //k.close();
+
+                        TcpServer::close(fd);
+                        
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server consumer  : fd= "+to_string(fd)+" 无法解析http请求或者对端关闭连接 wb握手失败 已经关闭这个连接","websocket server consumer  : fd= "+to_string(fd)+" couldn't solve http request or host had closed this connection.fail to handshake websocket.have closed this connection");
+                    //continue;
+                    return;
+                    //wb握手失败
+                }
+                else if(ret==0)
+                {
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server consumer  : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析","websocket server consumer  : fd= "+to_string(fd)+"wait new data to continue solve this request");
+                    //continue;
+                    return;
+                }
+                else if(ret==1)
+                {
+                    winf.locPara=winf.httpinf.locPara;
+                    winf.header=winf.httpinf.header;
+                    //cout<<winf.header<<endl;
+                    if(security_open)
+                    {
+                        int ret=connectionLimiter.allowRequest(clientfd[fd].getIP(),fd,winf.httpinf.loc,requestTimes,requestSecs);
+                        if(ret!=stt::security::ALLOW)
+                        {
+                            //securitySendBackFun(k,inff);
+                            if(ret==stt::security::CLOSE)
+                            {
+                                TcpServer::close(fd);
+                                STT_LOG(stt::file::LogLevel::WARN,"websocket server : fd="+to_string(fd)+"请求太频繁，已经关闭连接","websocket server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
+                            }
+                            else
+                            {
+                                STT_LOG(stt::file::LogLevel::WARN,"websocket server : fd="+to_string(fd)+"请求太频繁，已经忽略请求","websocket server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
+                            }
+                            return;
+                        }
+                    }
+                    if(!fcc(winf))//条件不满足
+                    {
+                        //k.close();
+                        TcpServer::close(fd);
+                        
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server consumer  : fd= "+to_string(fd)+" 连接限制条件不满足 websocket握手失败 服务器已经关闭这个连接","websocket server consumer  : fd= "+to_string(fd)+" The connection constraints are not met.websocket handshake fail.server has closed this connection.");
+                        //continue;
+                        return;
+                    }
+                    string_view key;
+                    string keyy;
+                    HttpStringUtil::get_value_header(winf.httpinf.header,key,"Sec-WebSocket-Key");
+                    keyy.assign(key);
+                    keyy+="258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+                    string result="";
+                    CryptoUtil::sha1(string(keyy),result);
+                    keyy=EncodingUtil::base64_encode(result);
+                    result=HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Accept",keyy);
+                    //清理接收缓冲区可能的数据遗漏
+                    //Tcpinf.data={};
+                    
+                    if(!k.sendBack("",result,"101 Switching Protocols"))
+                    {
+                        //k.close();
+                        TcpServer::close(fd);
+                    
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server consumer  : fd= "+to_string(fd)+" 握手响应无法发送 websocket握手失败 服务器已经关闭这个连接","websocket server consumer  : fd= "+to_string(fd)+" couldn't send handshake response .websocket handshake fail. server has closed this connection");
+                        //continue;
+                        return;
+                        //握手失败
+                    }
+                    winf.response=::time(0);
+                    winf.HBTime=0;
+                    wbTable(fd).emplace(fd,winf);
+                    armTimer(fd,TIMER_HEARTBEAT,seca);//心跳定时 有消息时只更新response 到期时再按response重新计算
+                    STT_LOG(stt::file::LogLevel::DEBUG,"websocket server consumer  : fd= "+to_string(fd)+" websocket握手成功","websocket server consumer  : fd= "+to_string(fd)+" websocket has handshaked sucessfully");
+                    //thread(fccc,winf,ref(*this)).detach();
+                    WebSocketServerFDHandler kk;
+                    kk.setFD(fd,clientfd[fd].ssl,unblock);
+                    kk.setOutputBuffer(getOutputBuffer(fd));
+                    if(!fccc(kk,winf))
+                    {
+                        closeWithoutLock(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : fd= "+to_string(fd)+" 调用连接后的初始函数失败，已经关闭连接","websocket server : fd= "+to_string(fd)+" fail to use start function,now has closed this connection");
+                        return;
+                    }
+                    
+                }
+                //sleep(10);
+                //k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
+                //sleep(5);
+                //lock.unlock();
+            }
+            else
+            {
+                
+                //lock.unlock();
+                WebSocketServerFDHandler k;
+                
+            k.setFD(fd,clientfd[fd].ssl,unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            
+            int ret=1;
+            jj->second.fd=fd;
+            jj->second.connection_obj_fd=clientfd[fd].connection_obj_fd;
+            
+            ret=k.getMessage(Tcpinf,jj->second,buffer_size,1);
+            
+            if(ret==-1)
+            {
+                    closeWithoutLock(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接","websocket server : read data from fd= "+to_string(fd)+" fail,now has closed this connection");
+                    return;
+            }
+            else if(ret==1)
+            {
+                    if(jj->second.closeflag==true)//收到关闭确认
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server consumer  : fd= "+to_string(fd)+" 收到关闭确认帧: "+ jj->second.message,"websocket server consumer  : fd= "+to_string(fd)+" has received closed confirm fin:"+ jj->second.message);
+                        TcpServer::close(fd);
+                    }
+                    else//收到关闭
+                    {
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server consumer  : fd= "+to_string(fd)+" 收到关闭帧: "+ jj->second.message,"websocket server consumer  : fd= "+to_string(fd)+" has received closed fin:"+ jj->second.message);
+                        
+                        closeAck(fd,jj->second.message);
+                    }
+                    wbTable(fd).erase(jj);
+                    return;
+            }
+            else if(ret==2)
+            {
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server consumer  : fd= "+to_string(fd)+" 收到心跳确认: "+ jj->second.message,"websocket server consumer  : fd= "+to_string(fd)+" has received heartbeat confirm:"+ jj->second.message);
+                    jj->second.response=::time(0);
+                    jj->second.HBTime=0;
+
+                    //记录心跳确认
+
+                    jj->second.message="";
+                    return;
+            }
+            else if(ret==3)
+            {
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server consumer  : fd= "+to_string(fd)+" 收到心跳: "+ jj->second.message,"websocket server consumer  : fd= "+to_string(fd)+" has received heartbeat:"+ jj->second.message);
+                    jj->second.response=::time(0);
+                    if(!sendMessage(jj->first,"心跳","1010"))//发送心跳失败直接关闭
+                    {
+                        wbTable(fd).erase(jj);
+                        TcpServer::close(fd);
+                        return;
+                    }
+         
+                    //心跳
+                    else
+                        jj->second.message="";
+                    return;
+            }
+            else if(ret==4)
+            {
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server consumer  : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析","websocket server consumer  : fd= "+to_string(fd)+"wait new data to continue solve this request");
+                    return;
+            }
+            else if(ret==0)
+            {
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server consumer  : fd= "+to_string(fd)+" 收到常规信息: "+ jj->second.message,"websocket server consumer  : fd= "+to_string(fd)+" has received normal message:"+ jj->second.message);
+                    jj->second.response=::time(0);
+                    //if(!fc(jj->second.message,*this,jj->second))//回调函数失败
+                    //{
+                    //    close(fd);
+                    //    return;
+                    //}
+                    //jj->second.message="";
+                    //return;
+            }
+        
+            //lock.unlock();
+            
+            
+            //lock6.unlock();
+            //开始处理
+                //入队
+            Tcpinf.pendindQueue.push(move(jj->second));
+            
+            if(Tcpinf.pendindQueue.size()==1)//只有一个 说明没有任务没做完 直接执行
+            {
+               
+                WebSocketFDInformation &inff=std::any_cast<WebSocketFDInformation&>(clientfd[fd].pendindQueue.front());
+                Tcpinf.FDStatus=-1;
+                int ret;
+                //获取key,自动解析到ctx的key键
+                ++Tcpinf.FDStatus;
+                ret=parseKey(k,inff);
+                
+                if(ret==0)//慢处理
+                {
+                    return;
+                }
+                else if(ret<=-1)
+                {
+                    //清掉任务后返回
+                    //Tcpinf.pendindQueue.pop();
+                    //-2要关闭连接
+                    if(ret==-2)
+                    {
+                        closeFD(fd);
+                        //closeWithoutLock(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接","websocket server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
+                    }
+                    else
+                    {
+                        //k.sendBack("","","404 NOT FOUND");
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息","websocket server : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
+                    }
+                    return;
+                }
+                if(security_open)
+                {
+                    int ret=connectionLimiter.allowRequest(clientfd[fd].getIP(),fd,std::any_cast<const std::string&>(inff.ctx["key"]),requestTimes,requestSecs);
+                    if(ret!=stt::security::ALLOW)
+                    {
+                        securitySendBackFun(k,inff);
+                        if(ret==stt::security::CLOSE)
+                        {
+                            TcpServer::close(fd);
+                            STT_LOG(stt::file::LogLevel::WARN,"websocket server : fd="+to_string(fd)+"请求太频繁，已经关闭连接","websocket server : fd="+to_string(fd)+"request are too frequent,now has closed this connection");
+                        }
+                        else
+                        {
+                            STT_LOG(stt::file::LogLevel::WARN,"websocket server : fd="+to_string(fd)+"请求太频繁，已经忽略请求","websocket server : fd="+to_string(fd)+"request are too frequent,now has ignored this request");
+                        }
+                        return;
+                    }
+                }
+                //遍历任务
+                
+                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
+                
+                if(ii==solveFun.end())//找不到
+                {
+                    
+                    //k.sendBack("","","404 NOT FOUND");
+                    //close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","websocket server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                    if(!globalSolveFun(k,inff))
+                    {
+                        closeFD(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.","websocket server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
+                    }
+                    Tcpinf.pendindQueue.pop();
+                }
+                else//找得到处理函数
+                {
+                    
+                    for(auto &f:ii->second)
+                    {
+                        int rett=f(k,inff);
+                        ++Tcpinf.FDStatus;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","websocket server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","websocket server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            
+                            return;
+                        }
+                        else if(rett==-1)
+                        {
+                            STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败.","websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                        else
+                        {
+                            closeFD(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                    }
+                    
+                    Tcpinf.pendindQueue.pop();
+                }
+
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 完成","websocket server : handled fd= "+to_string(fd)+" sucessfully");
+                
+            }
+            
+            }
+        }
+    }
+    void stt::network::WebSocketServer::handler_workerevent(const int &fd,const int &ret)
+    {
+       
+        if(ret==-2)
+        {
+            closeFD(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : worker处理失败 fd= "+to_string(fd)+" ，已经关闭连接","websocket server : worker solve fail fd= "+to_string(fd)+" ,now has closed this connection");
+            return;
+        }
+        WebSocketServerFDHandler k;
+        k.setFD(fd,clientfd[fd].ssl,unblock);
+        k.setOutputBuffer(getOutputBuffer(fd));
+        
+        if(ret==-1)
+        {
+            clientfd[fd].pendindQueue.pop();
+            STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : worker处理失败 fd= "+to_string(fd)+" ，跳过本次请求","websocket server : worker solve fail fd= "+to_string(fd)+" ,skip this request");
+        }
+        else
+        {
+            if(clientfd[fd].pendindQueue.empty())
+            {
+                STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd),"websocket server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
+                return;
+            }
+            WebSocketFDInformation &inf=std::any_cast<WebSocketFDInformation&>(clientfd[fd].pendindQueue.front());
+            if(inf.connection_obj_fd!=clientfd[fd].connection_obj_fd)
+            {
+                STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : worker处理成功,但是上一个连接已经关闭，所以不予继续处理 fd= "+to_string(fd),"websocket server : worker solve sucessfully.but the last connection has been closed so stop solving this request. fd= "+to_string(fd));
+                return;
+            }
+            
+            auto ii=solveFun.find(std::any_cast<const std::string&>(inf.ctx["key"]));//对应的任务
+            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : worker处理成功 fd= "+to_string(fd),"websocket server : worker solve sucessfully fd= "+to_string(fd));
+            if(ii==solveFun.end())//找不到
+                {
+                    
+                    //k.sendBack("","","404 NOT FOUND");
+                    //close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","websocket server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                    if(!globalSolveFun(k,inf))
+                    {
+                        closeFD(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.","websocket server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
+                    }
+                    //clientfd[fd].pendindQueue.pop();
+                    clientfd[fd].pendindQueue.pop();
+                }
+            else
+            {
+            //继续做
+            
+            for(;clientfd[fd].FDStatus<ii->second.size();)
+            {
+                
+                int rett=ii->second[clientfd[fd].FDStatus](k,inf);
+                clientfd[fd].FDStatus++;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次完成","websocket server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(clientfd[fd].FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次.等待任务完成.","websocket server : handled fd= "+to_string(fd)+" .It's the "+to_string(clientfd[fd].FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else
+                        {
+                            closeFD(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(clientfd[fd].FDStatus)+  "次失败。已经关闭连接。","websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(clientfd[fd].FDStatus)+"times and now has closed this connection.");
+                            //clientfd[fd].pendindQueue.pop();
+                            return;
+                        }
+            }
+            
+            clientfd[fd].pendindQueue.pop();
+            }
+        }
+     
+        TcpFDInf Tcpinf=clientfd[fd];
+        //检查是否有下一轮
+        if(Tcpinf.pendindQueue.size()>=1)//只有一个 说明没有任务没做完 直接执行
+            {
+                WebSocketFDInformation &inff=std::any_cast< WebSocketFDInformation&>(clientfd[fd].pendindQueue.front());
+                Tcpinf.FDStatus=-1;
+                int ret;
+                //获取key,自动解析到ctx的key键
+                ++Tcpinf.FDStatus;
+                ret=parseKey(k,inff);
+
+                if(ret==0)//慢处理
+                    return;
+                else if(ret<=-1)
+                {
+                    //清掉任务后返回
+                    Tcpinf.pendindQueue.pop();
+                    //-2要关闭连接
+                    if(ret==-2)
+                    {
+                        //k.sendBack("","","404 NOT FOUND");
+                        closeFD(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已经关闭连接","websocket server : parsekey fail fd= "+to_string(fd)+",now has closed this connection");
+                    }
+                    else
+                    {
+                        //k.sendBack("","","404 NOT FOUND");
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : parsekey的时候失败 fd= "+to_string(fd)+" ，已扔掉本次任务并且发回错误信息","websocketserver : parsekey fail fd= "+to_string(fd)+",now has throwed this task and send back error message");
+                    }
+                    return;
+                }
+                
+                //遍历任务
+                auto ii=solveFun.find(std::any_cast<const std::string&>(inff.ctx["key"]));
+                if(ii==solveFun.end())//找不到
+                {
+                    //k.sendBack("","","404 NOT FOUND");
+                    //close(fd);
+                    STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 找不到处理函数 fd= "+to_string(fd)+"。调用全局备用处理函数","websocket server : can not find solve function fd= "+to_string(fd)+" . use global backup slove function.");
+                    if(!globalSolveFun(k,inff))
+                    {
+                        closeFD(fd);
+                        STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 调用全局备用函数失败 fd= "+to_string(fd)+"已经关闭连接.","websocket server : use global backup slove function fail. fd= "+to_string(fd)+". has closed this connection.");
+                    }
+                    Tcpinf.pendindQueue.pop();
+                }
+                else//找得到处理函数
+                {
+                    for(auto &f:ii->second)
+                    {
+                        int rett=f(k,inff);
+                        ++Tcpinf.FDStatus;
+                        if(rett==1)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次完成","websocket server : handled fd= "+to_string(fd)+" sucessfully.It's the "+to_string(Tcpinf.FDStatus)+"times");
+                        }
+                        else if(rett==0)
+                        {
+                            STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次.等待任务完成.","websocket server : handled fd= "+to_string(fd)+" .It's the "+to_string(Tcpinf.FDStatus)+"times job. now is waitting it to be finish.");
+                            return;
+                        }
+                        else if(rett==-1)
+                        {
+
+                            STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。","websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                        else
+                        {
+                            closeFD(fd);
+                            STT_LOG(stt::file::LogLevel::DEBUG,"websocket server : 处理fd= "+to_string(fd)+" 第"+ to_string(Tcpinf.FDStatus)+  "次失败。已经关闭连接。","websocket server : handled fd= "+to_string(fd)+" fail.It's the "+to_string(Tcpinf.FDStatus)+"times and now has closed this connection.");
+                            //Tcpinf.pendindQueue.pop();
+                            return;
+                        }
+                    }
+                    
+                }
+                Tcpinf.pendindQueue.pop();
+
+                    STT_LOG(stt::file::LogLevel::TRACE,"websocket server : 处理fd= "+to_string(fd)+" 完成","websocket server : handled fd= "+to_string(fd)+" sucessfully");
+                
+            }
+
+
+    }
+    /*
+    void stt::network::HttpServer::consumer(const int &threadID)
+    {
+        HttpServerFDHandler k;
+        //TcpFDInf &Tcpinf;
+        
+
+        if(stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(stt::system::ServerSetting::language=="Chinese")
+                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" 打开");
+            else
+                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" has opened");
+        }
+
+        while(flag1)
+        {
+            unique_lock<mutex> ul1(lq1[threadID]);
+            while(fdQueue[threadID].empty()&&flag1)
+            {
+                cv[threadID].wait(ul1);
+            }
+            if(!flag1)
+            {
+                ul1.unlock();
+                break;
+            }
+            int cclientfd=fdQueue[threadID].front().fd;
+            bool cclose=fdQueue[threadID].front().close;
+            fdQueue[threadID].pop();
+            
+            ul1.unlock();
+
+            if(cclose)
+            {
+                TcpServer::close(cclientfd);
+                continue;
+            }
+           // endd=chrono::high_resolution_clock::now();
+            //            duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+           //             cout<<"队列中拿出用时"<<duration.count()<<endl;
+            //unique_lock<mutex> lock6(lc1);
+            //auto jj=clientfd.find(cclientfd.fd);
+            if(clientfd[cclientfd].fd==-1)//can not find fd information,we need to writedown this error and close this fd
+            {
+                continue;
+            }
+            else
+            {
+                
+                if(security_open)
+                {
+                    if(!connectionLimiter.allowRequest(clientfd[cclientfd].getIP(),HttpInf[cclientfd].loc))
+                    {
+                        TcpServer::close(cclientfd);
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+"请求太频繁，已经关闭连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+"request are too frequent,now has closed this connection");
+                        }
+                        continue;
+                    }
+                }
+                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                
+                //TcpFDInf &Tcpinf=clientfd[cclientfd.fd];
+                
+            //lock6.unlock();
+
+             if(stt::system::ServerSetting::logfile!=nullptr)
+             {
+                if(stt::system::ServerSetting::language=="Chinese")
+                    stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 开始处理fd= "+to_string(cclientfd));
+                else
+                    stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : now start solveing fd= "+to_string(cclientfd));
+             }
+            
+            
+            //endd=chrono::high_resolution_clock::now();
+            //            duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+            //            cout<<"开始处理用时"<<duration.count()<<endl;
+             int ret=1;
+             int ii=1;
+             k.setFD(cclientfd,clientfd[cclientfd].ssl,unblock);
+            //cout<<"fd="<<cclientfd<<endl;
+            while(ret==1)
+            {
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" 正在解析请求... 第"+to_string(ii)+"次处理");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" now solveing request... it is the "+to_string(ii)+" times");
+                }
+            ret=k.solveRequest(clientfd[cclientfd],HttpInf[cclientfd],buffer_size,ii);
+            if(ret==-1)
+            {
+                    TcpServer::close(cclientfd);
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" 解析请求失败或者是对方已经关闭连接，服务器已经关闭这个连接");
+                        else
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" solved request fail or host had closed connection.now server has closed this connection");
+                    }
+            }
+
+            else if(ret==1)
+            {
+                
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                    {
+                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" 正在处理请求... \n*******请求信息：*********\nheader= "+string(HttpInf[cclientfd].header)+"\nbody="+string(HttpInf[cclientfd].body)+"\nbody_chunked="+string(HttpInf[cclientfd].body_chunked)+"\n*************************");
+                    }
+                    else
+                    {
+                        stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+" now handleing request...\n*******request information：*********\nheader= "+string(HttpInf[cclientfd].header)+"\nbody="+string(HttpInf[cclientfd].body)+"\nbody_chunked="+string(HttpInf[cclientfd].body_chunked)+"\n*************************");
+                    }
+
+                }
+                //endd=chrono::high_resolution_clock::now();
+                //        duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+                //        cout<<"开始调用fc用时"<<duration.count()<<endl;
+                if(!fc(HttpInf[cclientfd],k))
+                {
+                
+                    TcpServer::close(cclientfd);
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 处理fd= "+to_string(cclientfd)+"失败或者是对方已经关闭连接，已经关闭连接");
+                        else
+                           stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : handle fd= "+to_string(cclientfd)+"fail or host had closed connection.now server has closed this connection");
+                    }
+                    break;
+                }
+                else
+                {
+                    //endd=chrono::high_resolution_clock::now();
+                    //    duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+                    //    cout<<"fc完成用时"<<duration.count()<<endl;
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 处理fd= "+to_string(cclientfd)+"完成");
+                        else
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : has solved fd= "+to_string(cclientfd)+"sucessfully");
+                    }
+                    break;
+                }
+            }
+            else if(ret==0)
+            {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : 解析fd= "+to_string(cclientfd)+"未完成 等待新的数据继续解析");
+                        else
+                            stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd)+"wait new data to continue solve this request");
+                    }
+            }
+            ++ii;
+            //k.solveRequest(clientfd[cclientfd],HttpInf[cclientfd],buffer_size,ii);
+            }
+            //endd=chrono::high_resolution_clock::now();
+            //            duration=chrono::duration_cast<chrono::microseconds>(endd-start);
+            //            cout<<"全部处理完用时"<<duration.count()<<endl;
+            //            op+=duration.count();
+             //           times++;
+            //            cout<<"times="<<times<<"op="<<op<<endl;
+
+            }
+        }
+        //跳出循环意味着结束线程
+        unique_lock<mutex> lock3(lco1);
+        consumerNum--;
+        cout<<"consumer "<<consumerNum<<" quit"<<endl;
+        if(stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(stt::system::ServerSetting::language=="Chinese")
+                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(consumerNum)+"退出");
+            else
+                stt::system::ServerSetting::logfile->writeLog("http server consumer "+to_string(consumerNum)+"quit");
+        }
+    }
+    */
+    
+    bool stt::network::EpollSingle::endListen()
+    {
+        flag1=false;
+        while(flag2);
+        return true;
+    }
+    void stt::network::EpollSingle::epolll()
+    {
+        int epollFD=epoll_create(1);
+        epoll_event ev;
+        ev.data.fd=fd;
+        if(flag==false)
+            ev.events=EPOLLIN|EPOLLET;
+        else
+            ev.events=EPOLLIN;
+        epoll_ctl(epollFD,EPOLL_CTL_ADD,fd,&ev);
+        epoll_event evs;
+
+        DateTime timer1;
+        Duration dt;
+        DateTime timer2;
+        Duration t;
+        while(flag1)
+        {
+            if(!timer1.isStart())
+                timer1.startTiming();
+            int infds=epoll_wait(epollFD,&evs,1,1000);
+            if(infds<0)
+                continue;
+            else if(infds==0)
+            {
+                if(!flag3)
+                {
+                    dt=timer1.checkTime();
+                    if(dt>=this->dt)
+                    {
+                        if(!fcTimeOut(fd))
+                            break;
+                    }
+                }
+                else
+                {
+                    if(!timer2.startTiming())//说明已经不是第一次，而是在计时中了
+                    {
+                        t=timer2.checkTime();
+                        if(t>=this->t)
+                            break;
+                    }
+                }
+            }
+            else//有事件发生了
+            {
+                if(flag3)//打开了退出倒计时
+                {
+                    flag3=false;
+                    timer2.endTiming();
+                }
+                timer1.endTiming();
+                if(!fc(fd))
+                    break;
+            }
+        }
+        //只要跳出了这个循环就意味着要退出了
+        //cout<<"epoll quit"<<endl;
+        fcEnd(fd);
+        dt=Duration{0,20,0,0,0};
+        flag1=true;
+        flag3=false;
+        flag2=false;
+    }
+    void stt::network::EpollSingle::startListen(const int &fd,const bool &flag,const Duration &dt)
+    {
+        if(isListen())
+        {
+            endListen();
+        }
+        this->fd=fd;
+        this->flag=flag;
+        this->dt=dt;
+        thread(&EpollSingle::epolll,this).detach();
+        flag2=true;
+    }
+    
+    /*
+    void Epoll::startListen(const int &fd,const condition_variable &cv1,const bool &flag,const int &evsNum)
+    {
+        if(isListen())
+        {
+            endListen();
+        }
+        this->fd=fd;
+        this->flag=flag;
+        this->cv1=cv1;
+        this->evsNum=evsNum;
+        thread(&EpollSingle::epolll,this).detach();
+    }
+    void Epoll::epolll()
+    {
+        int epollFD=epoll_create(1);
+        epoll_event ev;
+        ev.data.fd=fd;
+        if(flag==false)
+            ev.events=EPOLLIN|EPOLLET;
+        else
+            ev.events=EPOLLIN;
+        epoll_ctl(epollFD,EPOLL_CTL_ADD,fd,&ev);
+        epoll_event evs[evsNum];
+    }
+    */
+    
+    void stt::network::WebSocketClient::close(const short &code,const string &message,const bool &wait)
+    {
+        if(!isConnect())//没有连接 何来关闭
+            return;
+        char ccode[2];
+        memcpy(ccode,&code,2);
+        string codee(ccode,2);
+        codee+=message;
+        if(!sendMessage(codee,"1000"))//如果发送失败 说明连接可能断了或者有其他错误 自行终止本方连接就ok了,否则等待epoll那边收到关闭帧再关闭
+        {
+            if(wait)
+                k.endListenWithSignal();//发送停止信号
+        }
+        if(wait)
+        {
+            k.waitAndQuit();
+            while(k.isListen());//wb的标志位会比epoll的标志位先确定，epoll是最后才改变的标志位，所以监听最后的epoll标志位更安全
+        }
+        flag5=true;//为了省事，一概设置flag5为true，如果是主动的那就设置了，后面能用；被动的后面也不需要在检查这个了。
+    }
+    void stt::network::WebSocketClient::close(const string &closeCodeAndMessage,const bool &wait)
+    {
+        if(!isConnect())//没有连接 何来关闭
+            return;
+        if(!sendMessage(closeCodeAndMessage,"1000"))//如果发送失败 说明连接可能断了或者有其他错误 自行终止本方连接就ok了,否则等待epoll那边收到关闭帧再关闭
+        {
+            if(wait)
+                k.endListenWithSignal();//发送停止信号
+        }
+        if(wait)
+        {
+            k.waitAndQuit();
+            while(k.isListen());
+        }
+        flag5=true;//为了省事，一概设置flag5为true，如果是主动的那就设置了，后面能用；被动的后面也不需要在检查这个了。
+    }
+    bool stt::network::WebSocketClient::close1()
+    {
+        flag4=false;
+        flag5=false;
+        if(!TcpClient::close())
+        {
+            cerr<<"wb无法关闭前一个连接(tcp连接已经关闭但是没办法创建新的套接字，这个对象需要弃用)"<<endl;
+            return false;
+        }
+        return true;
+    }
+    stt::network::WebSocketClient::~WebSocketClient()
+    {
+        close(1000,"bye");
+    }
+    bool stt::network::WebSocketClient::connect(const string &url,const int &min)
+    {
+        //解析url
+        //建立tcp连接
+        string ip;
+        int port;
+        string locPara;
+        HttpStringUtil::getIP(url,ip);
+        HttpStringUtil::getPort(url,port);
+        HttpStringUtil::getLocPara(url,locPara);
+        if(!TcpClient::isConnect()||TcpClient::getServerIP()!=ip||TcpClient::getServerPort()!=port)//没有连接或者服务器变更需要重新连接
+        {
+            if(TcpClient::isConnect())//如果是变更服务器 需要先关闭原有的连接
+            {
+                if(!TcpClient::close())
+                {
+                    cerr<<"wb无法关闭前一个连接"<<endl;
+                    return false;
+                }
+            }
+            if(!TcpClient::connect(ip,port))//重新连接或者第一次连接
+            {
+                cerr<<"wb无法连接到服务器"<<endl;
+                return false;
+            }
+        }
+        //进行websocket握手
+        string httpURL=url;
+        auto pos=httpURL.find("ws");
+        httpURL.replace(pos,2,"http");
+        string wbKey;
+        RandomUtil::getRandomStr_base64(wbKey,24);
+        HttpClient k;
+        if(!k.getRequestFromFD(TcpFDHandler::getFD(),TcpFDHandler::ssl,httpURL,HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Key",wbKey),"Sec-WebSocket-Version: 13"))
+            return false;
+        if(!k.isReturn())
+            return false;
+        if(k.header.find("HTTP/1.1 101")==string::npos)
+            return false;
+        //连接完毕
+        this->url=url;
+        flag4=true;
+        flag5=false;
+        if(this->k.isListen())
+            this->k.endListen();
+        //监听,用水平触发的逻辑
+        auto ffc=[this](const int &fd)->bool
+        {
+            TcpFDHandler k;
+            k.setFD(fd,this->ssl);
+            string totalResult="";
+            char b1;
+            char b2;
+            string code;
+            bool isRec;
+            do
+            {
+                isRec=true;
+                if(k.recvDataByLength(&b1,1)<=0)
+                {   
+                    //if(!this->close(1002,"",false))
+                    //{
+                    //    cout<<"false"<<endl;
+                        return false;
+                    //}
+                }
+                if(k.recvDataByLength(&b2,1)<=0)
+                {   
+                    //if(!this->close(1002,"",false))
+                    //{
+                        return false;
+                    //}
+                }
+                
+                
+                unsigned long sizee;//payload len
+                string ssize;
+                BitUtil::bitOutput(b2,ssize);
+                ssize=ssize.substr(1);
+                BitUtil::bitStrToNumber(ssize,sizee);//单字节里的是大端序 
+                if(sizee==126)
+                {
+                    char s[2];
+                    if(k.recvDataByLength(s,2)<=0)
+                    {   
+                        //if(!this->close(1002,"",false))
+                        //{
+                            return false;
+                        //}
+                    }
+                    sizee=BitUtil::bitToNumber(string(s,2),sizee);
+                }
+                else if(sizee==127)
+                {
+                    char s[8];
+                    if(k.recvDataByLength(s,8)<=0)
+                    {   
+                        //if(!this->close(1002,"",false))
+                        //{
+                            return false;
+                        //}
+                    }
+                    sizee=BitUtil::bitToNumber(string(s,8),sizee);
+                }
+                if(sizee==0)//长度为0只可能是控制帧，但控制帧最大长度125，不允许分片
+                    isRec=false;
+                //接收正文
+                string result;
+                if(isRec)
+                {
+                    if(k.recvDataByLength(result,sizee)<=0)
+                    {
+                        //if(!this->close(1002,"",false))
+                        //{
+                            return false;
+                        //}
+                    }
+                    totalResult+=result;
+                }
+                //检查收到的讯息
+                
+                BitUtil::bitOutput(b1,code);
+                code=code.substr(4);
+                //cout<<"finish+"<<code<<endl;
+                if(code=="1000")
+                {
+                    //cout<<"收到对端关闭帧";
+                    if(this->flag5)//说明是关闭确认帧
+                    {
+                        return false;
+                    }
+                    else//需要发送关闭确认帧
+                    {
+                        //if(!this->close(totalResult,false))
+                        //{
+                        //    return false;
+                        //}
+                        //isRec=false;
+                        this->close(totalResult,false);
+                        return false;
+                    }
+                }
+                else if(code=="1001")
+                {
+                    //cout<<"收到对端心跳:"<<totalResult<<endl;
+                    this->sendMessage(totalResult,"1010");
+                    isRec=false;
+                }
+                else if(code=="1010")
+                {
+                    //cout<<"收到对端心跳响应"<<endl;
+                    isRec=false;
+                }
+                BitUtil::bitOutput_bit(b1,1,b1);
+            }while(BitUtil::bitOutput(b1,code).substr(0,1)=="0"&&BitUtil::bitOutput(b1,code).substr(4)=="0000"&&isRec);  
+
+            //用回调函数处理
+            if(isRec)
+                return this->fc(totalResult,*this);//处理失败epoll会退出
+            return true;
+        };
+        auto endfc=[this](const int &fd)->void
+        {
+            this->close1();
+        };
+        auto timeoutfc=[this](const int &fd)->bool
+        {
+            if(!this->sendMessage("心跳","1001"))
+                return false;
+            this->k.waitAndQuit();
+            return true;
+        };
+        this->k.setFunction(ffc);
+        this->k.setEndFunction(endfc);
+        this->k.setTimeOutFunction(timeoutfc);
+        this->k.startListen(TcpFDHandler::getFD(),true,Duration{0,0,min,0,0});
+        return this->k.isListen();
+    }
+    bool stt::network::WebSocketClient::sendMessage(const string &message,const string &type)
+    {
+        if(!isConnect())
+        {
+            cerr<<"websocket对象没有连接,发送失败"<<endl;
+            return false;
+        }
+        string typee="1000"+type;
+        string mess=message;
+        unsigned long size=message.length();//生成extern payload len前的东西,默认一片长度为8的数据帧发完数据
+
+        if(size<=125)
+        {
+            //cout<<"send1+size="<<size<<"+::"<<message<<endl;
+            string header;
+            BitUtil::toBit(typee,header);
+
+            char cc;
+            memcpy(&cc,&size,1);
+            cc=cc|'z'+6;
+        
+            //设置mask
+            string mask;
+            EncodingUtil::generateMask_4(mask);
+        
+            //mask处理数据
+            EncodingUtil::maskCalculate(mess,mask);
+            //拼接数据帧
+            mess=header+cc+mask+mess;
+        }
+        else if(size<=65535)
+        {
+            //cout<<"send2+size="<<size<<"+::"<<message<<endl;
+            unsigned short tt=(unsigned short)size;
+            tt=htons(tt);
+            string header;
+            BitUtil::toBit(typee+"11111110",header);
+            char ss[2];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
+            memcpy(ss,&tt,2);
+            //设置mask
+            string mask;
+            EncodingUtil::generateMask_4(mask);
+            EncodingUtil::maskCalculate(mess,mask);
+            //拼接数据帧
+            mess=header+string(ss,2)+mask+mess;
+        }
+        else
+        {
+            //cout<<"send3+size="<<size<<"+::"<<message<<endl;
+            NetworkOrderUtil::htonl_ntohl_64(size);
+            string header;
+            BitUtil::toBit(typee+"11111111",header);
+            char ss[8];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
+            memcpy(ss,&size,sizeof(size));
+            //设置mask
+            string mask;
+            EncodingUtil::generateMask_4(mask);
+            //mask处理数据
+            EncodingUtil::maskCalculate(mess,mask);
+            //拼接数据帧
+            mess=header+string(ss,8)+mask+mess;
+        }
+    
+
+        //发送数据帧
+        if(sendData(mess)!=mess.length())
+        {
+            cout<<"send failed"<<endl;
+            return false;
+        }
+        return true;
+    }
+    
+    int stt::network::WebSocketServerFDHandler::getMessage(TcpFDInf &Tcpinf,WebSocketFDInformation &Websocketinf,const unsigned long &buffer_size,const int &ii)
+    {
+        /*
+            string recv="";
+            int ret=1;
+            while(ret>0)
+            {
+                Tcpinf.data+=recv;
+                recv.clear();
+                ret=recvData(recv,8192);
+            }
+            if(ret<=0&&ret!=-100)
+                return -1;
+            
+            */
+
+         //   if(ii==1)
+        //{
+
+            int ret=1;
+            
+            
+            while(ret>0&&buffer_size-Tcpinf.p_buffer_now>0)
+            {
+                //缓冲区装满了（或者还没有）就从池里换上一级 最多到buffer_size
+                if(Tcpinf.p_buffer_now>=Tcpinf.buffer_cap)
+                    RecvBufferPool::reserve(Tcpinf,Tcpinf.p_buffer_now+1);
+                ret=recvData(Tcpinf.buffer+Tcpinf.p_buffer_now,(Tcpinf.buffer_cap<buffer_size?Tcpinf.buffer_cap:buffer_size)-Tcpinf.p_buffer_now);
+                if(ret>0)
+                    Tcpinf.p_buffer_now+=ret;
+                
+            }
+            if(buffer_size-Tcpinf.p_buffer_now<=0)
+            {
+                STT_LOG(stt::file::LogLevel::WARN,"websocket server : 缓冲区容量不足 读取数据fd= "+to_string(fd)+" 失败，已经关闭连接","websocket server : buffer size is not enough,read data from fd= "+to_string(fd)+" fail,now has closed this connection");
+                return -1;
+            }
+            if(ret<=0)
+            {
+                if(ret!=-100)
+                    return -1;
+            }
+        //}
+        
+        
+        Tcpinf.data=string_view(Tcpinf.buffer,Tcpinf.p_buffer_now);
+        //返回前把已经解析掉的字节挪走 缓冲区里只留下没处理的部分
+        auto compact=[&Tcpinf](const int &r)->int
+        {
+            size_t left=Tcpinf.data.length();
+            if(left>0&&Tcpinf.data.data()!=Tcpinf.buffer)
+                memmove(Tcpinf.buffer,Tcpinf.data.data(),left);
+            Tcpinf.p_buffer_now=left;
+            Tcpinf.data=string_view(Tcpinf.buffer,left);
+            return r;
+        };
+        
+        //cout<<Tcpinf.data<<endl;
+            //数据接收完，开始处理
+            
+            while(1)
+            {
+                //第一个字节
+                if(Tcpinf.status==0||Tcpinf.status==1)
+                {
+                    Websocketinf.recv_length=0;
+                    Websocketinf.have_recv_length=0;
+
+                    if(Tcpinf.status==0)
+                        Tcpinf.status=1;
+                    if(Tcpinf.data.length()<1)
+                        return compact(4);
+                    char b1=Tcpinf.data[0];
+                    string code;
+                    BitUtil::bitOutput(b1,code);
+                    if(code.substr(0,1)=="1")
+                    {
+                        
+                        Websocketinf.fin=true;
+                    }
+                    else
+                    {
+                        
+                        Websocketinf.fin=false;
+                    }
+                    code=code.substr(4);
+
+                    if(code=="1000")
+                    {
+                        Websocketinf.message_type=1;
+                    }
+                    else if(code=="1001")
+                    {
+                        Websocketinf.message_type=3;
+                    }
+                    else if(code=="1010")
+                    {
+                        Websocketinf.message_type=2;
+                    }
+                    else
+                       Websocketinf.message_type=0;
+
+                    ++Websocketinf.have_recv_length;
+                    Tcpinf.status=2;
+                    Tcpinf.data=Tcpinf.data.substr(1);
+                    Websocketinf.recv_length=1;//接下来要读1字节的payload len
+                    
+                }
+                //长度
+                if(Tcpinf.status==2)
+                {
+                    
+                    unsigned long sizee;//payload len
+                    if(Websocketinf.recv_length==1)
+                    {
+                        if(Tcpinf.data.length()<1)
+                            return compact(4);
+                        char b2=Tcpinf.data[0];
+                        ++Websocketinf.have_recv_length;
+                        Tcpinf.data=Tcpinf.data.substr(1);
+                        string ssize;
+                        BitUtil::bitOutput(b2,ssize);
+                        ssize=ssize.substr(1);
+                        BitUtil::bitStrToNumber(ssize,sizee);//单字节里的是大端序 
+                        if(sizee==126)
+                            Websocketinf.recv_length=2;
+                        else if(sizee==127)
+                            Websocketinf.recv_length=8;
+                        else
+                        {
+                            Tcpinf.status=3;
+                            Websocketinf.recv_length=sizee;
+                        }
+                    }
+                    //扩展长度 2字节或者8字节 要等够了再读
+                    if(Tcpinf.status==2)
+                    {
+                        size_t n=Websocketinf.recv_length;
+                        if(Tcpinf.data.length()<n)
+                            return compact(4);
+                        sizee=BitUtil::bitToNumber(string(Tcpinf.data.substr(0,n)),sizee);
+                        Tcpinf.status=3;
+                        Websocketinf.recv_length=sizee;
+                        Tcpinf.data=Tcpinf.data.substr(n);
+                        Websocketinf.have_recv_length=Websocketinf.have_recv_length+n;
+                    }
+                    
+                    
+                }
+
+                //接收mask
+                if(Tcpinf.status==3)
+                {
+                    
+                    if(Tcpinf.data.length()<4)
+                        return compact(4);
+                    Websocketinf.mask=Tcpinf.data.substr(0,4);
+
+                    Tcpinf.status=4;
+                    Tcpinf.data=Tcpinf.data.substr(4);
+                    Websocketinf.have_recv_length=Websocketinf.have_recv_length+4;
+                }
+
+                //接收数据
+                if(Tcpinf.status==4)
+                {
+                    if(Websocketinf.recv_length!=0)
+                    {
+                    if(Tcpinf.data.length()<1)
+                        return compact(4);
+
+                    size_t n=Tcpinf.data.length()<Websocketinf.recv_length?Tcpinf.data.length():Websocketinf.recv_length;
+                    string a(Tcpinf.data.substr(0,n));
+                    Tcpinf.data=Tcpinf.data.substr(n);
+                    Websocketinf.recv_length=Websocketinf.recv_length-n;
+                    Websocketinf.have_recv_length=Websocketinf.have_recv_length+n;
+                    EncodingUtil::maskCalculate(a,Websocketinf.mask);
+                    Websocketinf.message+=a;
+                    //cout<<Websocketinf.message<<endl;
+                    if(Websocketinf.recv_length!=0)
+                    {
+                        //只收到一部分payload 下一段要从mask的第n%4个字节接着异或
+                        if(n%4!=0)
+                            Websocketinf.mask=Websocketinf.mask.substr(n%4)+Websocketinf.mask.substr(0,n%4);
+                        return compact(4);
+                    }
+                    }
+                    //cout<<Websocketinf.message<<endl;
+
+                    Tcpinf.status=0;
+                    if(Websocketinf.message_type==1)
+                    {
+                        //cout<<"收到对端关闭帧";
+
+                        return compact(1);
+                    }
+                    else if(Websocketinf.message_type==2)
+                    {
+                        //cout<<"收到对端心跳响应"<<endl;
+                        return compact(2);
+                    }
+                    else if(Websocketinf.message_type==3)
+                    {
+                        //cout<<"收到对端心跳:"<<Websocketinf.message<<endl;
+                        sendMessage(Websocketinf.message,"1010");
+                        return compact(3);
+                    }
+                    else
+                    {
+                        if(Websocketinf.fin)                         
+                            break;   
+                    }
+                    
+                    
+                }
+            }
+ 
+             return compact(Websocketinf.message_type);
+    }
+    bool stt::network::WebSocketServerFDHandler::sendMessage(const string &msg,const string &type)
+    {
+        string typee="1000"+type;
+        string mess=msg;
+        unsigned long size=msg.length();//生成extern payload len前的东西,默认一片长度为8的数据帧发完数据
+
+        if(size<=125)
+        {
+            string header;
+            BitUtil::toBit(typee,header);
+
+            char cc;
+            memcpy(&cc,&size,1);
+            cc=cc&'z'+5;
+        
+        
+            //拼接数据帧
+            mess=header+cc+mess;
+        }
+        else if(size<=65535)
+        {
+            unsigned short tt=(unsigned short)size;
+            tt=htons(tt);
+            string header;
+            BitUtil::toBit(typee+"01111110",header);
+            char ss[2];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
+            memcpy(ss,&tt,2);
+        
+            //拼接数据帧
+            mess=header+string(ss,2)+mess;
+        }
+        else
+        {
+            NetworkOrderUtil::htonl_ntohl_64(size);
+            string header;
+            BitUtil::toBit(typee+"01111111",header);
+            char ss[8];//把int数据转换成char，底层二进制数据不变，用指针复制内存的办法
+            memcpy(ss,&size,sizeof(size));
+            //拼接数据帧
+            mess=header+string(ss,8)+mess;
+        }
+        //发送数据帧
+        if(sendData(mess,false)!=mess.length())
+            return false;
+        return true;
+    }
+    /*
+    void WebSocketServerFDHandler::closeAck(const string &closeCodeAndMessage)
+    {
+        sendMessage(closeCodeAndMessage,"1000");
+        TcpFDHandler::close();
+    }
+    void WebSocketServerFDHandler::closeAck(const short &code,const string &message)
+    {
+        char ccode[2];
+        memcpy(ccode,&code,2);
+        string codee(ccode,2);
+        codee+=message;
+        sendMessage(codee,"1000");
+        TcpFDHandler::close();
+    }
+    */
+    void stt::network::WebSocketServer::closeAck(const int &fd,const string &closeCodeAndMessage)
+    {
+        sendMessage(fd,closeCodeAndMessage,"1000");
+        TcpServer::close(fd);
+    }
+    void stt::network::WebSocketServer::closeAck(const int &fd,const short &code,const string &message)
+    {
+        char ccode[2];
+        memcpy(ccode,&code,2);
+        string codee(ccode,2);
+        codee+=message;
+        sendMessage(fd,codee,"1000");
+        TcpServer::close(fd);
+    }
+    bool stt::network::WebSocketServer::closeFD(const int &fd,const string &closeCodeAndMessage)
+    {
+       
+        //unique_lock<mutex> lock(lwb);
+        auto ii=wbTable(fd).find(fd);
+
+        if(ii==wbTable(fd).end()||ii->second.closeflag==true)
+        {
+            
+            return false;
+        }
+        else
+        {
+            
+            //lock.unlock();
+            WebSocketServerFDHandler k;
+            k.setFD(fd,getSSL(fd),unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            if(!k.sendMessage(closeCodeAndMessage,"1000"))
+            {
+                
+                
+                    //lock.lock();
+                    auto ii=wbTable(fd).find(fd);
+                    if(ii!=wbTable(fd).end())
+                    {
+                        wbTable(fd).erase(ii);
+                        TcpServer::close(fd);
+                    }
+                    //lock.unlock();
+                
+                
+                return true;
+            }
+            ii->second.closeflag=true;
+            return true;
+        }
+    }
+    
+    bool stt::network::WebSocketServer::closeFD(const int &fd,const short &code,const string &message)
+    {
+        
+        //unique_lock<mutex> lock(lwb);
+        auto ii=wbTable(fd).find(fd);
+        
+        if(ii==wbTable(fd).end()||ii->second.closeflag==true)//找不到或者已经发送过了
+        {
+            
+            return false;
+        }
+        else
+        {
+            
+            //lock.unlock();
+            char ccode[2];
+            memcpy(ccode,&code,2);
+            string codee(ccode,2);
+            codee+=message;
+            WebSocketServerFDHandler k;
+            k.setFD(fd,getSSL(fd),unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            if(!k.sendMessage(codee,"1000"))//发送失败会自动删除在记录表里的
+            {
+                
+                    //lock.lock();
+                    auto ii=wbTable(fd).find(fd);
+                    if(ii!=wbTable(fd).end())
+                    {
+                        wbTable(fd).erase(ii);
+                        TcpServer::close(fd);
+                    }
+                    //lock.unlock();
+                
+                return true;
+            }
+            ii->second.closeflag=true;
+            return true;
+        }
+    }
+    
+    bool stt::network::WebSocketServer::close(const int &fd)
+    {
+
+                    //unique_lock<mutex> lock(lwb);
+                    auto ii=wbTable(fd).find(fd);
+                    if(ii!=wbTable(fd).end())
+                    {
+                        wbTable(fd).erase(ii);
+                        TcpServer::close(fd);
+                    }
+                    
+                
+                return true;
+            
+    }
+    bool stt::network::WebSocketServer::closeWithoutLock(const int &fd,const string &closeCodeAndMessage)
+    {
+        auto ii=wbTable(fd).find(fd);
+        if(ii==wbTable(fd).end()||ii->second.closeflag==true)
+        {
+            return false;
+        }
+        else
+        {
+            WebSocketServerFDHandler k;
+            k.setFD(fd,getSSL(fd),unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            if(!k.sendMessage(closeCodeAndMessage,"1000"))
+            {
+                wbTable(fd).erase(ii);
+                TcpServer::close(fd);
+                return false;
+            }
+            ii->second.closeflag=true;
+            return true;
+        }
+    }
+    bool stt::network::WebSocketServer::closeWithoutLock(const int &fd,const short &code,const string &message)
+    {
+        auto ii=wbTable(fd).find(fd);
+        if(ii==wbTable(fd).end()||ii->second.closeflag==true)//找不到或者已经发送过了
+        {
+            return false;
+        }
+        else
+        {
+            char ccode[2];
+            memcpy(ccode,&code,2);
+            string codee(ccode,2);
+            codee+=message;
+            WebSocketServerFDHandler k;
+            k.setFD(fd,getSSL(fd),unblock);
+            k.setOutputBuffer(getOutputBuffer(fd));
+            if(!k.sendMessage(codee,"1000"))//发送失败会自动删除在记录表里的
+            {
+                wbTable(fd).erase(ii);
+                TcpServer::close(fd);
+                return false;
+            }
+            ii->second.closeflag=true;
+            return true;
+        }
+    }
+    /*
+    void stt::network::WebSocketServer::handler(const int &fd)
+    {
+        HttpServerFDHandler k;
+        WebSocketServerFDHandler k1;
+            if(clientfd[fd].fd!=-1)
+            {
+                if(security_open)
+                {
+                    if(!connectionLimiter.allowRequest(clientfd[fd].getIP()))
+                    {
+                        TcpServer::close(fd);
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer : fd= "+to_string(fd)+"请求太频繁，已经关闭连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer : fd= "+to_string(fd)+"request are too frequent,now has closed this connection");
+                        }
+                      
+                    }
+                }
+                
+                TcpFDInf &Tcpinf=clientfd[fd];
+
+            cout<<"websocket fd="<<fd<<endl;
+            if(stt::system::ServerSetting::logfile!=nullptr)
+             {
+                if(stt::system::ServerSetting::language=="Chinese")
+                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer : 正在处理fd= "+to_string(fd));
+                else
+                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer : now solveing fd= "+to_string(fd));
+             }
+            //拿到fd之后开始操作
+            unique_lock<mutex> lock(lwb);
+            auto jj=wbTable(fd).find(fd);
+            if(jj==wbTable(fd).end())//没有进行wb握手
+            {
+                k.setFD(fd,clientfd[fd].ssl,unblock);
+
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 正在进行websocket握手");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" handshaking websocket...");
+                }
+                WebSocketFDInformation winf;
+                winf.fd=fd;
+                winf.closeflag=false;
+                
+                HttpRequestInformation HttpInf;
+                int ret=k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
+                if(ret==-1)
+                {
+                    //k.close();
+
+                        TcpServer::close(fd);
+                        cout<<"无法解析http请求 wb握手失败"<<endl;
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 无法解析http请求或者对端关闭连接 wb握手失败 已经关闭这个连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" couldn't solve http request or host had closed this connection.fail to handshake websocket.have closed this connection");
+                        }
+                   
+                    //wb握手失败
+                }
+                else if(ret==0)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : 解析fd= "+to_string(fd)+"未完成 等待新的数据继续解析");
+                        else
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+"wait new data to continue solve this request");
+                    }
+                 
+                }
+                else if(ret==1)
+                {
+                    winf.locPara=HttpInf.locPara;
+                    winf.header=HttpInf.header;
+                    //cout<<winf.header<<endl;
+                    if(!fcc(winf))//条件不满足
+                    {
+                        //k.close();
+                        TcpServer::close(fd);
+                        cout<<"连接限制条件不满足 wb握手失败"<<endl;
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 连接限制条件不满足 websocket握手失败 服务器已经关闭这个连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" The connection constraints are not met.websocket handshake fail.server has closed this connection.");
+                        }
+                    
+                    }
+                    string_view key;
+                    string keyy;
+                    HttpStringUtil::get_value_header(HttpInf.header,key,"Sec-WebSocket-Key");
+                    keyy.assign(key);
+                    keyy+="258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+                    string result="";
+                    CryptoUtil::sha1(string(keyy),result);
+                    keyy=EncodingUtil::base64_encode(result);
+                    result=HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Accept",keyy);
+                    //清理接收缓冲区可能的数据遗漏
+                    //Tcpinf.data={};
+                    
+                    if(!k.sendBack("",result,"101 Switching Protocols"))
+                    {
+                        //k.close();
+                        TcpServer::close(fd);
+                        cout<<"握手响应无法发送 wb握手失败"<<endl;
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 握手响应无法发送 websocket握手失败 服务器已经关闭这个连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" couldn't send handshake response .websocket handshake fail. server has closed this connection");
+                        }
+                   
+                        //握手失败
+                    }
+                    winf.response=::time(0);
+                    winf.HBTime=0;
+                    wbTable(fd).emplace(fd,winf);
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" websocket握手成功");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" websocket has handshaked sucessfully");
+                    }
+                    thread(fccc,winf,ref(*this)).detach();
+                }
+                //sleep(10);
+                //k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
+                //sleep(5);
+
+            }
+            else//已经进行了握手操作
+            {
+                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                k1.setFD(fd,clientfd[fd].ssl,unblock);
+            int r=1;
+            
+            
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 正在解析请求... ");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" now solveing request... ");
+                }
+                r=k1.getMessage(Tcpinf,jj->second,buffer_size,1);
+
+                if(r==-1)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 接收错误，关闭连接中 ");
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+"error of receiving, and now closing this connection ");
+                    }
+                    closeWithoutLock(fd);
+                }
+                else if(r==1)
+                {
+                    
+                    
+                   
+                    if(jj->second.closeflag==true)//收到关闭确认
+                    {
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到关闭确认帧: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received closed confirm fin:"+ jj->second.message);
+                        }
+                        TcpServer::close(fd);
+                    }
+                    else//收到关闭
+                    {
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到关闭帧: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received closed fin:"+ jj->second.message);
+                        }
+                        cout<<"yes"<<endl;
+                        closeAck(fd,jj->second.message);
+                    }
+                    wbTable(fd).erase(jj);
+                   
+                }
+                else if(r==2)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到心跳确认: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received heartbeat confirm:"+ jj->second.message);
+                    }
+                    jj->second.response=::time(0);
+                    jj->second.HBTime=0;
+
+                    //记录心跳确认
+
+                    jj->second.message="";
+                   
+                }
+                else if(r==3)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到心跳: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received heartbeat:"+ jj->second.message);
+                    }
+                    jj->second.response=::time(0);
+                    if(!sendMessage(jj->first,"心跳","1010"))//发送心跳失败直接关闭
+                    {
+                        wbTable(fd).erase(jj);
+                        TcpServer::close(fd);
+                        
+                    }
+         
+                    //心跳
+                    else
+                        jj->second.message="";
+                    
+                }
+                else if(r==0)//正常报文
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 收到常规信息: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has received normal message:"+ jj->second.message);
+                    }
+                    jj->second.response=::time(0);
+                    if(!fc(jj->second.message,*this,jj->second))//回调函数失败
+                    {
+                        close(fd);
+                        
+                    }
+                    jj->second.message="";
+                    
+                }
+                //else if(r==4)
+                //{
+                //        solvingFD_lock.lock();
+                //        solvingFD[cclientfd]=false;
+                //        solvingFD_lock.unlock();
+                //        continue;
+                //}
+
+                if(r!=4)
+                {
+
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 处理完成");
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" has solved sucessfully");
+                    }
+                }
+                else
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" 继续等待数据中");
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer : fd= "+to_string(fd)+" waiting data...");
+                    }
+                }
+            
+            }
+            }
+    }
+    */
+    /*
+    void stt::network::WebSocketServer::consumer(const int &threadID)
+    {
+        HttpServerFDHandler k;
+        //TcpFDInf &Tcpinf;
+        WebSocketServerFDHandler k1;
+        
+        if(stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(stt::system::ServerSetting::language=="Chinese")
+                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" 打开");
+            else
+                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" has opened");
+        }
+        while(flag1)
+        {
+            unique_lock<mutex> ul1(lq1[threadID]);
+            while(fdQueue[threadID].empty()&&flag1)
+            {
+                cv[threadID].wait(ul1);
+            }
+            if(!flag1)
+            {
+                ul1.unlock();
+                break;
+            }
+            QueueFD cclientfd=fdQueue[threadID].front();
+            fdQueue[threadID].pop();
+            
+            ul1.unlock();
+
+            if(cclientfd.close)
+            {
+                    auto ii=wbTable(cclientfd.fd).find(cclientfd.fd);
+                    if(ii!=wbTable(cclientfd.fd).end())
+                    {
+                        wbTable(cclientfd.fd).erase(ii);
+                        TcpServer::close(cclientfd.fd);
+                    }
+                continue;
+            }
+
+
+            //unique_lock<mutex> lock6(lc1);
+            //auto ii=clientfd.find(cclientfd.fd);
+            if(clientfd[cclientfd.fd].fd==-1)//can not find fd information,we need to writedown this error and close this fd
+            {
+                //lock6.unlock();
+                continue;
+            }
+            else
+            {
+                if(security_open)
+                {
+                    if(!connectionLimiter.allowRequest(clientfd[cclientfd.fd].getIP()))
+                    {
+                        TcpServer::close(cclientfd.fd);
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"请求太频繁，已经关闭连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("tcp server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"request are too frequent,now has closed this connection");
+                        }
+                        continue;
+                    }
+                }
+                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                //k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                TcpFDInf &Tcpinf=clientfd[cclientfd.fd];
+            //lock6.unlock();
+            cout<<"websocket fd="<<cclientfd.fd<<endl;
+            if(stt::system::ServerSetting::logfile!=nullptr)
+             {
+                if(stt::system::ServerSetting::language=="Chinese")
+                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : 正在处理fd= "+to_string(cclientfd.fd));
+                else
+                    stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : now solveing fd= "+to_string(cclientfd.fd));
+             }
+            //拿到fd之后开始操作
+            unique_lock<mutex> lock(lwb);
+            auto jj=wbTable(cclientfd.fd).find(cclientfd.fd);
+            if(jj==wbTable(cclientfd.fd).end())//没有进行wb握手
+            {
+                k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                //k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                //unique_lock<mutex> lock(lwb);
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 正在进行websocket握手");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" handshaking websocket...");
+                }
+                WebSocketFDInformation winf;
+                winf.fd=cclientfd.fd;
+                winf.closeflag=false;
+                
+                HttpRequestInformation HttpInf;
+                int ret=k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
+                if(ret==-1)
+                {
+                    //k.close();
+
+                        TcpServer::close(cclientfd.fd);
+                        cout<<"无法解析http请求 wb握手失败"<<endl;
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 无法解析http请求或者对端关闭连接 wb握手失败 已经关闭这个连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" couldn't solve http request or host had closed this connection.fail to handshake websocket.have closed this connection");
+                        }
+                    continue;
+                    //wb握手失败
+                }
+                else if(ret==0)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : 解析fd= "+to_string(cclientfd.fd)+"未完成 等待新的数据继续解析");
+                        else
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"wait new data to continue solve this request");
+                    }
+                    continue;
+                }
+                else if(ret==1)
+                {
+                    winf.locPara=HttpInf.locPara;
+                    winf.header=HttpInf.header;
+                    //cout<<winf.header<<endl;
+                    if(!fcc(winf))//条件不满足
+                    {
+                        //k.close();
+                        TcpServer::close(cclientfd.fd);
+                        cout<<"连接限制条件不满足 wb握手失败"<<endl;
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 连接限制条件不满足 websocket握手失败 服务器已经关闭这个连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" The connection constraints are not met.websocket handshake fail.server has closed this connection.");
+                        }
+                        continue;
+                    }
+                    string_view key;
+                    string keyy;
+                    HttpStringUtil::get_value_header(HttpInf.header,key,"Sec-WebSocket-Key");
+                    keyy.assign(key);
+                    keyy+="258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
+                    string result="";
+                    CryptoUtil::sha1(string(keyy),result);
+                    keyy=EncodingUtil::base64_encode(result);
+                    result=HttpStringUtil::createHeader("Upgrade","websocket","Connection","Upgrade","Sec-WebSocket-Accept",keyy);
+                    //清理接收缓冲区可能的数据遗漏
+                    //Tcpinf.data={};
+                    
+                    if(!k.sendBack("",result,"101 Switching Protocols"))
+                    {
+                        //k.close();
+                        TcpServer::close(cclientfd.fd);
+                        cout<<"握手响应无法发送 wb握手失败"<<endl;
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 握手响应无法发送 websocket握手失败 服务器已经关闭这个连接");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" couldn't send handshake response .websocket handshake fail. server has closed this connection");
+                        }
+                        continue;
+                        //握手失败
+                    }
+                    winf.response=::time(0);
+                    winf.HBTime=0;
+                    wbTable(cclientfd.fd).emplace(cclientfd.fd,winf);
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                            if(stt::system::ServerSetting::language=="Chinese")
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" websocket握手成功");
+                            else
+                                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" websocket has handshaked sucessfully");
+                    }
+                    thread(fccc,winf,ref(*this)).detach();
+                }
+                //sleep(10);
+                //k.solveRequest(Tcpinf,HttpInf,buffer_size,1);
+                //sleep(5);
+
+            }
+            else//已经进行了握手操作
+            {
+                //k.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+                k1.setFD(cclientfd.fd,clientfd[cclientfd.fd].ssl,unblock);
+            int r=1;
+             int ii=1;
+            while(r!=-1&&r!=4)
+            {
+                if(stt::system::ServerSetting::logfile!=nullptr)
+                {
+                    if(stt::system::ServerSetting::language=="Chinese")
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 正在解析请求... 第"+to_string(ii)+"次处理");
+                    else
+                        stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" now solveing request... it is the "+to_string(ii)+" times");
+                }
+                r=k1.getMessage(Tcpinf,jj->second,buffer_size,ii);
+
+                if(r==-1)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 接收错误，关闭连接中 ");
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+"error of receiving, and now closing this connection ");
+                    }
+                    closeWithoutLock(cclientfd.fd);
+                }
+                else if(r==1)
+                {
+                    
+                    
+                   
+                    if(jj->second.closeflag==true)//收到关闭确认
+                    {
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到关闭确认帧: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received closed confirm fin:"+ jj->second.message);
+                        }
+                        TcpServer::close(cclientfd.fd);
+                    }
+                    else//收到关闭
+                    {
+                        if(stt::system::ServerSetting::logfile!=nullptr)
+                        {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到关闭帧: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received closed fin:"+ jj->second.message);
+                        }
+                        cout<<"yes"<<endl;
+                        closeAck(cclientfd.fd,jj->second.message);
+                    }
+                    wbTable(cclientfd.fd).erase(jj);
+                    break;
+                }
+                else if(r==2)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到心跳确认: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received heartbeat confirm:"+ jj->second.message);
+                    }
+                    jj->second.response=::time(0);
+                    jj->second.HBTime=0;
+
+                    //记录心跳确认
+
+                    jj->second.message="";
+                    break;
+                }
+                else if(r==3)
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到心跳: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received heartbeat:"+ jj->second.message);
+                    }
+                    jj->second.response=::time(0);
+                    if(!sendMessage(jj->first,"心跳","1010"))//发送心跳失败直接关闭
+                    {
+                        wbTable(cclientfd.fd).erase(jj);
+                        TcpServer::close(cclientfd.fd);
+                        break;
+                    }
+         
+                    //心跳
+                    else
+                        jj->second.message="";
+                    break;
+                }
+                else if(r==0)//正常报文
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 收到常规信息: "+ jj->second.message);
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has received normal message:"+ jj->second.message);
+                    }
+                    jj->second.response=::time(0);
+                    if(!fc(jj->second.message,*this,jj->second))//回调函数失败
+                    {
+                        close(cclientfd.fd);
+                        break;
+                    }
+                    jj->second.message="";
+                    break;
+                }
+                //else if(r==4)
+                //{
+                //        solvingFD_lock.lock();
+                //        solvingFD[cclientfd]=false;
+                //        solvingFD_lock.unlock();
+                //        continue;
+                //}
+
+                if(r!=4)
+                {
+
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 处理完成");
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" has solved sucessfully");
+                    }
+                }
+                else
+                {
+                    if(stt::system::ServerSetting::logfile!=nullptr)
+                    {
+                        if(stt::system::ServerSetting::language=="Chinese")
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" 继续等待数据中");
+                        else 
+                            stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(threadID)+" : fd= "+to_string(cclientfd.fd)+" waiting data...");
+                    }
+                }
+                ++ii;
+            } 
+            }
+            }
+        }
+        //跳出循环意味着结束线程
+        unique_lock<mutex> lock3(lco1);
+        consumerNum--;
+        cout<<"consumer "<<consumerNum<<" quit"<<endl;
+        lock3.unlock();
+        if(stt::system::ServerSetting::logfile!=nullptr)
+        {
+            if(stt::system::ServerSetting::language=="Chinese")
+                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(consumerNum)+"退出");
+            else
+                stt::system::ServerSetting::logfile->writeLog("websocket server consumer "+to_string(consumerNum)+"quit");
+        }
+    }
+    */
+    SSL* stt::network::TcpServer::getSSL(const int &fd)
+    {
+        //SSL *ssl;
+        //unique_lock<mutex> lock1(ltl1);
+        //auto ii=tlsfd.find(fd);
+        //if(ii==tlsfd.end())
+        //    ssl=nullptr;
+        //else
+        //    ssl=ii->second;
+        //unique_lock<mutex> lock1(lc1);
+        //auto ii=clientfd.find(fd);
+        TcpFDInf *inf=clientfd.find(fd);
+        if(inf==nullptr||inf->fd==-1)
+            return nullptr;
+        return inf->ssl;
+    }
+    std::shared_ptr<stt::network::OutputBuffer> stt::network::TcpServer::getOutputBuffer(const int &fd)
+    {
+        TcpFDInf *inf=clientfd.find(fd);
+        if(inf==nullptr||inf->fd==-1)
+            return nullptr;
+        return std::atomic_load(&inf->out);
+    }
+    void stt::network::WebSocketServer::handleHeartbeat(const int &id,const int &fd)
+    {
+        
+        time_t now;
+        
+            now=::time(0);
+            //unique_lock<mutex> lock(lwb);
+            
+            //只处理属于这个reactor的连接
+            std::unordered_map<int,WebSocketFDInformation> &table=wbclientfd[id];
+            auto ii=table.find(fd);
+            if(ii==table.end())
+                return;
+            if(ii->second.HBTime!=0)//已经发送心跳
+            {
+                if(now-ii->second.response>secb)//超时
+                {
+                    if(ii->second.closeflag!=true)
+                    {
+                        short code=1000;
+                        char ccode[2];
+                        memcpy(ccode,&code,2);
+                        string codee(ccode,2);
+                        codee+="bye";
+                        WebSocketServerFDHandler k;
+                        k.setFD(ii->first,getSSL(ii->first),unblock);
+                        k.setOutputBuffer(getOutputBuffer(ii->first));
+                        if(!k.sendMessage(codee,"1000"))//发送失败会自动删除在记录表里的
+                        {
+                            table.erase(ii);
+                            TcpServer::close(fd);
+                            return;
+                        }
+                        ii->second.closeflag=true;
+                    }
+                }
+                else//期间收到过消息 等到secb之后再看
+                    armTimer(fd,TIMER_HEARTBEAT,secb-(now-ii->second.response));
+            }
+            else//检查是否需要发送心跳
+            {
+                if(now-ii->second.response>seca)
+                {
+                    //cout<<"send"<<endl;
+                    if(!sendMessage(ii->first,"心跳","1001"))//发送心跳失败直接关闭
+                    {
+                        table.erase(ii);
+                        TcpServer::close(fd);
+                        return;
+                    }
+                    ii->second.HBTime=now;
+                    armTimer(fd,TIMER_HEARTBEAT,secb);
+                }
+                else//期间收到过消息 按最后一次消息的时间重新计时
+                    armTimer(fd,TIMER_HEARTBEAT,seca-(now-ii->second.response));
+            }
+            
+            
+    }
+    bool stt::network::WebSocketServer::close()
+    {
+        if(!TcpServer::close())
+            return false;
+        //HBflag1=false;
+        //while(HBflag);
+        return true;
+    }
+    void stt::network::WebSocketServer::sendMessage(const string &msg,const string &type)
+    {
+        //unique_lock<mutex> lock(lwb);
+        for(auto &table:wbclientfd)
+        {
+            for(auto ii=table.begin();ii!=table.end();)
+            {
+                if(!sendMessage(ii->first,msg,type))//发送失败直接关闭
+                {
+                    int cfd=ii->first;
+                    ii=table.erase(ii);
+                    TcpServer::close(cfd);
+                    continue;
+                }
+                ++ii;
+            }
+        }
+    }
+    
+bool stt::system::csemp::init(key_t key,unsigned short value,short sem_flg)
+{
+    if (m_semid!=-1) return false; // 如果已经初始化了，不必再次初始化。
+
+    m_sem_flg=sem_flg;
+
+    // 信号量的初始化不能直接用semget(key,1,0666|IPC_CREAT)
+    // 因为信号量创建后，初始值是0，如果用于互斥锁，需要把它的初始值设置为1，
+    // 而获取信号量则不需要设置初始值，所以，创建信号量和获取信号量的流程不同。
+
+    // 信号量的初始化分三个步骤：
+    // 1）获取信号量，如果成功，函数返回。
+    // 2）如果失败，则创建信号量。
+    // 3) 设置信号量的初始值。
+
+    // 获取信号量。
+    if ( (m_semid=semget(key,1,0666)) == -1)
+    {
+        // 如果信号量不存在，创建它。
+        if (errno==ENOENT)
+        {
+            // 用IPC_EXCL标志确保只有一个进程创建并初始化信号量，其它进程只能获取。
+            if ( (m_semid=semget(key,1,0666|IPC_CREAT|IPC_EXCL)) == -1)
+            {
+                if (errno==EEXIST) // 如果错误代码是信号量已存在，则再次获取信号量。
+                {
+                    if ( (m_semid=semget(key,1,0666)) == -1)
+                    { 
+                        perror("init 1 semget()"); return false; 
+                    }
+                    return true;
+                }
+                else  // 如果是其它错误，返回失败。
+                {
+                    perror("init 2 semget()"); return false;
+                }
+            }
+
+            // 信号量创建成功后，还需要把它初始化成value。
+            union semun sem_union;
+            sem_union.val = value;   // 设置信号量的初始值。
+            if (semctl(m_semid,0,SETVAL,sem_union) <  0) 
+            { 
+                perror("init semctl()"); return false; 
+            }
+        }
+        else
+        { perror("init 3 semget()"); return false; }
+    }
+
+    return true;
+}
+
+// 信号量的P操作（把信号量的值减value），如果信号量的值是0，将阻塞等待，直到信号量的值大于0。
+bool stt::system::csemp::wait(short value)
+{
+    if (m_semid==-1) return false;
+
+    struct sembuf sem_b;
+    sem_b.sem_num = 0;      // 信号量编号，0代表第一个信号量。
+    sem_b.sem_op = value;   // P操作的value必须小于0。
+    sem_b.sem_flg = m_sem_flg;
+    if (semop(m_semid,&sem_b,1) == -1) { perror("p semop()"); return false; }
+
+    return true;
+}
+
+// 信号量的V操作（把信号量的值减value）。
+bool stt::system::csemp::post(short value)
+{
+    if (m_semid==-1) return false;
+
+    struct sembuf sem_b;
+    sem_b.sem_num = 0;     // 信号量编号，0代表第一个信号量。
+    sem_b.sem_op = value;  // V操作的value必须大于0。
+    sem_b.sem_flg = m_sem_flg;
+    if (semop(m_semid,&sem_b,1) == -1) { perror("V semop()"); return false; }
+
+    return true;
+}
+
+// 获取信号量的值，成功返回信号量的值，失败返回-1。
+int stt::system::csemp::getvalue()
+{
+    return semctl(m_semid,0,GETVAL);
+}
+
+// 销毁信号量。
+bool stt::system::csemp::destroy()
+{
+    if (m_semid==-1) return false;
+
+    if (semctl(m_semid,0,IPC_RMID) == -1) { perror("destroy semctl()"); return false; }
+
+    return true;
+}
+
+stt::system::csemp::~csemp()
+{
+}
+//string stt::system::ServerSetting::logName;
+stt::file::LogFile* stt::system::ServerSetting::logfile=nullptr;
+string stt::system::ServerSetting::language="English";
+void stt::system::ServerSetting::setExceptionHandling()
+{
+    for(int ii=0;ii<=64;ii++)
+        signal(ii,SIG_IGN);
+    //SIGSEGV
+    signal(SIGSEGV,signalSIGSEGV);
+    //SIGABRT
+    signal(SIGABRT,signalSIGABRT);
+    //terminate全局终止函数
+    set_terminate(signalterminated);
+}
+
+void stt::system::ServerSetting::setLogFile(LogFile *logfile,const string &language)
+{
+    //日志设置
+    if(logfile==nullptr)
+        return;
+    if(language!="")
+        stt::system::ServerSetting::language=language;
+    stt::system::ServerSetting::logfile=logfile;
+     //设置为本对象的logfile
+    if(!logfile->isOpen())
+    {
+        string logName;
+        DateTime::getTime(logName);
+        logName="./server_log/server_log_"+logName;
+        stt::system::ServerSetting::logfile->openFile(logName);
+    }
+}
+
+void stt::system::ServerSetting::init(LogFile *logfile,const string &language)
+{
+    setExceptionHandling();//信号设置
+    //日志设置
+   setLogFile(logfile,language);
+    //写日志通知打开完成了
+    STT_LOG(stt::file::LogLevel::INFO,"服务器信号，日志等设置完成","set server signals and logfile sucessfully");
+}
+ProcessInf* stt::system::HBSystem::p=nullptr;
+stt::system::csemp stt::system::HBSystem::plock;
+bool stt::system::HBSystem::isJoin=false;
+bool stt::system::HBSystem::join(const char *name,const char *argv0,const char *argv1,const char *argv2)
+{
+    if(p!=nullptr)
+        return false;
+    //获取/创建共享内存
+    bool first=false;
+    int shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640);
+    if(shmid==-1)
+    {
+        shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640|IPC_CREAT);
+        if(shmid==-1)
+            return false;
+        first=true;
+    }
+    p=static_cast<ProcessInf *>(shmat(shmid,0,0));
+    if(p==(void*)-1)
+        return false;
+    //获取锁
+    plock.init(0x5095);
+    //是否第一次是否需要初始化
+    if(first)
+    {
+        memset(p,-1,sizeof(struct ProcessInf)*MAX_PROCESS_INF);
+    }
+    //写入信息
+    time_t now=::time(nullptr);
+    pid_t pid=getpid();
+        //遍历找到位置
+    first=false;
+    //cout<<"join id= "<<pid<<endl;
+    STT_LOG(stt::file::LogLevel::INFO,"本进程正在加入心跳系统,id= "+to_string(pid),"This peocess is joining HBSystem,id= "+to_string(pid));
+    plock.wait();
+    for(int ii=0;ii<MAX_PROCESS_INF;ii++)
+    {
+        if(p[ii].pid==pid||p[ii].pid==0||p[ii].pid==-1)
+        {
+            p[ii].pid=pid;
+            p[ii].lastTime=now;
+            memcpy(p[ii].name,name,MAX_PROCESS_NAME);
+            memcpy(p[ii].argv0,argv0,20);
+            memcpy(p[ii].argv1,argv1,20);
+            memcpy(p[ii].argv2,argv2,20);
+            first=true;
+            break;
+        }
+    }
+    plock.post();
+    if(first)
+    {
+        isJoin=true;
+         STT_LOG(stt::file::LogLevel::INFO,"本进程加入心跳系统成功","this process has join HBSystem sucessfully");
+        return true;
+    }
+    else
+        return false;
+}
+bool stt::system::HBSystem::renew()
+{
+    if(p==nullptr)
+        return false;
+    time_t now=::time(nullptr);
+    pid_t pid=getpid();
+    //cout<<"renew= "<<pid<<endl;
+    plock.wait();
+    for(int ii=0;ii<MAX_PROCESS_INF;ii++)
+    {
+        if(p[ii].pid==pid)
+        {
+            p[ii].pid=pid;
+            p[ii].lastTime=now;
+            //cout<<"renwe*** ";
+            list();
+            plock.post();
+            return true;
+        }
+    }
+    plock.post();
+    return false;
+}
+void stt::system::HBSystem::list()
+{
+    if(p!=nullptr)
+    {
+        for(int ii=0;ii<MAX_PROCESS_INF;ii++)
+        {
+            if(p[ii].pid>0)
+                cout<<"pid= "<<p[ii].pid<<"name= "<<p[ii].name<<" last time= "<<p[ii].lastTime<<"para="<<p[ii].argv0<<" "<<p[ii].argv1<<" "<<p[ii].argv2<<endl;
+        }
+    }
+}
+bool stt::system::HBSystem::HBCheck(const int &sec)
+{
+    //拿到共享内存
+    if(p==nullptr)
+    {
+        //获取/创建共享内存
+        bool first=false;
+        int shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640);
+        if(shmid==-1)
+        {
+            shmid=shmget(0x5095,sizeof(struct ProcessInf)*MAX_PROCESS_INF,0640|IPC_CREAT);
+            if(shmid==-1)
+                return false;
+            first=true;
+        }
+        p=static_cast<ProcessInf *>(shmat(shmid,0,0));
+        if(p==(void*)-1)
+            return false;
+        //获取锁
+        plock.init(0x5095);
+        //是否第一次是否需要初始化
+        if(first)
+        {
+            memset(p,-1,sizeof(struct ProcessInf)*MAX_PROCESS_INF);
+        }
+    }
+    list();
+    //遍历检查
+    for(int ii=0;ii<MAX_PROCESS_INF;ii++)
+    {
+        time_t now=::time(nullptr);
+        if(p[ii].pid==0)
+            continue;
+        else if(p[ii].pid==-1)
+            break;
+        //超时
+        if((now-p[ii].lastTime)>=sec)
+        {
+            //检查是否存在
+                //发送信号杀死
+                //检查是否杀死
+                int sec=0;
+                while(kill(p[ii].pid,0)!=-1&&sec<=7)
+                {
+                    kill(p[ii].pid,15);
+                    sleep(1);
+                    sec++;
+                }
+
+                while(kill(p[ii].pid,0)!=-1)
+                {
+                    kill(p[ii].pid,9);
+                    sleep(1);
+                }
+            
+            //清理信息
+            plock.wait();
+            p[ii].pid=0;
+            p[ii].lastTime=0;
+            plock.post();
+            //重新启动
+            Process::startProcess(p[ii].name,-1,p[ii].argv0,p[ii].argv1,p[ii].argv2);
+        }
+    }
+    return true;
+}
+bool stt::system::HBSystem::deleteFromHBS()
+{
+    if(isJoin&&(p!=nullptr))
+    {
+        //cout<<"清理信息"<<endl;
+        pid_t pid=getpid();
+        plock.wait();
+        for(int ii=0;ii<MAX_PROCESS_INF;ii++)
+        {
+            if(p[ii].pid==pid)
+            {
+                p[ii].pid=0;
+                p[ii].lastTime=0;
+                plock.post();
+                list();
+                return true;
+            }
+        }
+        plock.post();
+        cerr<<"can't find process in hbs"<<endl;
+        return false;
+    }
+    return false;
+}
+stt::system::HBSystem::~HBSystem()
+{
+    //cout<<"析构函数运行  ~HBS"<<endl;
+    if(p!=nullptr)
+    {
+        if(!deleteFromHBS()||shmdt(p)==-1)
+            cerr<<"close shared memory failed"<<endl;
+    }
+}
+//解析"0-3,8,10-11"形式的CPU列表
+static std::vector<int> parseCPUList(const std::string &list)
+{
+    std::vector<int> cpus;
+    size_t pos=0;
+    while(pos<list.size())
+    {
+        size_t end=list.find(',',pos);
+        if(end==std::string::npos)
+            end=list.size();
+        std::string part=list.substr(pos,end-pos);
+        size_t dash=part.find('-');
+        int a=atoi(part.c_str());
+        int b=(dash==std::string::npos)?a:atoi(part.c_str()+dash+1);
+        if(!part.empty()&&isdigit((unsigned char)part[0]))
+        {
+            for(int ii=a;ii<=b;ii++)
+                cpus.push_back(ii);
+        }
+        pos=end+1;
+    }
+    return cpus;
+}
+static std::string readSysLine(const std::string &path)
+{
+    std::ifstream in(path);
+    std::string line;
+    std::getline(in,line);
+    return line;
+}
+//CPU编号到NUMA节点的表 第一次用到时从sysfs读一次
+static const std::vector<int>& cpuNodeTable()
+{
+    static const std::vector<int> table=[]()->std::vector<int>
+    {
+        std::vector<int> t;
+        for(int node:parseCPUList(readSysLine("/sys/devices/system/node/online")))
+        {
+            for(int cpu:parseCPUList(readSysLine("/sys/devices/system/node/node"+to_string(node)+"/cpulist")))
+            {
+                if(cpu>=(int)t.size())
+                    t.resize(cpu+1,0);
+                t[cpu]=node;
+            }
+        }
+        return t;
+    }();
+    return table;
+}
+int stt::system::CPUAffinity::nodeCount()
+{
+    static const int count=[]()->int
+    {
+        std::vector<int> nodes=parseCPUList(readSysLine("/sys/devices/system/node/online"));
+        return nodes.empty()?1:nodes.back()+1;
+    }();
+    return count;
+}
+int stt::system::CPUAffinity::nodeOfCPU(const int &cpu)
+{
+    const std::vector<int> &t=cpuNodeTable();
+    if(cpu<0||cpu>=(int)t.size())
+        return 0;
+    return t[cpu];
+}
+int stt::system::CPUAffinity::currentNode()
+{
+    //sched_getcpu走vDSO 不进内核
+    return nodeOfCPU(sched_getcpu());
+}
+bool stt::system::CPUAffinity::bindThread(const std::vector<int> &cpus)
+{
+    if(cpus.empty())
+        return true;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(int cpu:cpus)
+    {
+        if(cpu>=0&&cpu<CPU_SETSIZE)
+            CPU_SET(cpu,&set);
+    }
+    return pthread_setaffinity_np(pthread_self(),sizeof(set),&set)==0;
+}
+std::vector<int> stt::system::CPUAffinity::threadCPUs()
+{
+    std::vector<int> cpus;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if(pthread_getaffinity_np(pthread_self(),sizeof(set),&set)!=0)
+        return cpus;
+    for(int cpu=0;cpu<CPU_SETSIZE;cpu++)
+    {
+        if(CPU_ISSET(cpu,&set))
+            cpus.push_back(cpu);
+    }
+    return cpus;
+}
+std::string stt::system::CPUAffinity::describe(const std::vector<int> &cpus)
+{
+    if(cpus.empty())
+        return "unpinned";
+    std::vector<int> sorted(cpus);
+    std::sort(sorted.begin(),sorted.end());
+    sorted.erase(std::unique(sorted.begin(),sorted.end()),sorted.end());
+    std::string s;
+    std::vector<int> nodes;
+    for(size_t ii=0;ii<sorted.size();)
+    {
+        size_t jj=ii;
+        while(jj+1<sorted.size()&&sorted[jj+1]==sorted[jj]+1)
+            jj++;
+        if(!s.empty())
+            s+=",";
+        s+=to_string(sorted[ii]);
+        if(jj>ii)
+            s+="-"+to_string(sorted[jj]);
+        for(size_t kk=ii;kk<=jj;kk++)
+        {
+            int node=nodeOfCPU(sorted[kk]);
+            if(std::find(nodes.begin(),nodes.end(),node)==nodes.end())
+                nodes.push_back(node);
+        }
+        ii=jj+1;
+    }
+    s+="(node";
+    for(size_t ii=0;ii<nodes.size();ii++)
+        s+=(ii==0?"":",")+to_string(nodes[ii]);
+    return s+")";
+}
+bool stt::security::ConnectionLimiter::allow(RateState &st,const RateLimitType &type,const int &times,const int &secs,const std::chrono::steady_clock::time_point &now)
+{
+    using namespace std::chrono;
+
+    if (times <= 0 || secs <= 0)
+        return true;
+
+    auto window = seconds(secs);
+
+    switch (type)
+    {
+    case RateLimitType::Cooldown:
+        if (st.lastTime.time_since_epoch().count() == 0)
+            st.lastTime = now;
+
+        if (now - st.lastTime >= window)
+        {
+            st.counter = 0;
+            st.lastTime = now;
+        }
+
+        if (st.counter >= times)
+        {
+            st.violations++;
+            return false;
+        }
+
+        st.counter++;
+        st.lastTime = now;
+        return true;
+
+    case RateLimitType::FixedWindow:
+        if (st.lastTime.time_since_epoch().count() == 0)
+            st.lastTime = now;
+
+        if (now - st.lastTime >= window)
+        {
+            st.counter = 0;
+            st.lastTime = now;
+        }
+
+        if (st.counter >= times)
+        {
+            st.violations++;
+            return false;
+        }
+
+        st.counter++;
+        return true;
+
+    case RateLimitType::SlidingWindow:
+        while (!st.history.empty() &&
+               now - st.history.front() >= window)
+            st.history.pop_front();
+
+        if ((int)st.history.size() >= times)
+        {
+            st.violations++;
+            return false;
+        }
+
+        st.history.push_back(now);
+        return true;
+
+    case RateLimitType::TokenBucket:
+        if (st.lastRefill.time_since_epoch().count() == 0)
+        {
+            st.tokens = times;
+            st.lastRefill = now;
+        }
+
+        double dt =
+            std::chrono::duration_cast<std::chrono::duration<double>>(
+                now - st.lastRefill).count();
+
+        st.tokens = std::min<double>(
+            times,
+            st.tokens + dt * (double(times) / secs));
+
+        st.lastRefill = now;
+
+        if (st.tokens < 1.0)
+        {
+            st.violations++;
+            return false;
+        }
+
+        st.tokens -= 1.0;
+        return true;
+    }
+
+    return true;
+}
+stt::security::DefenseDecision stt::security::ConnectionLimiter::allowConnect(const std::string &ip, const int &fd,const int &times, const int &secs)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto now = std::chrono::steady_clock::now();
+
+    // ===== 黑名单检查 =====
+    auto bit = blacklist.find(ip);
+    if (bit != blacklist.end())
+    {
+        if (now < bit->second)
+        {
+            STT_LOG(stt::file::LogLevel::WARN,
+                "【封禁】IP " + ip + " 尝试连接，被拒绝（封禁中）",
+                "[BAN] IP " + ip + " connection rejected (banned)"
+            );
+            return CLOSE;
+        }
+        blacklist.erase(bit); // 解封
+    }
+
+    auto &info = table[ip];
+
+    // 并发连接数
+    if (info.activeConnections >= maxConnections)
+    {
+        info.badScore++;
+
+        STT_LOG(stt::file::LogLevel::WARN,
+            "【安全】IP " + ip + " 并发连接数超限，已断开",
+            "[SECURITY] IP " + ip + " exceeded max connections"
+        );
+
+        return CLOSE;
+    }
+
+    // 建连速率
+    if (!allow(info.connectRate, connectStrategy, times, secs, now))
+    {
+        info.badScore++;
+
+        STT_LOG(stt::file::LogLevel::WARN,
+            "【安全】IP " + ip + " 建连过快，已断开",
+            "[SECURITY] IP " + ip + " connection rate limited"
+        );
+
+        // 升级为黑名单
+        if (info.badScore >= 10)
+        {
+            blacklist[ip] = now + std::chrono::minutes(10);
+
+            STT_LOG(stt::file::LogLevel::WARN,
+                "【封禁】IP " + ip + " 多次恶意建连，封禁 10 分钟",
+                "[BAN] IP " + ip + " banned for 10 minutes"
+            );
+        }
+
+        return CLOSE;
+    }
+
+    // ===== 正式登记 fd =====
+    info.activeConnections++;
+    info.conns.emplace(fd, ConnectionState{
+        fd, RateState{}, {}, now
+    });
+
+    return ALLOW;
+}
+
+
+stt::security::DefenseDecision stt::security::ConnectionLimiter::allowRequest(const std::string &ip,const int &fd,const std::string_view &path,const int &times,const int &secs)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto now = std::chrono::steady_clock::now();
+
+    auto it = table.find(ip);
+    if (it == table.end())
+        return CLOSE;
+
+    auto &info = it->second;
+
+    // 黑名单检查
+    auto bit = blacklist.find(ip);
+    if (bit != blacklist.end() && now < bit->second)
+        return CLOSE;
+
+    auto itc = info.conns.find(fd);
+    if (itc == info.conns.end())
+        return CLOSE;
+
+    auto &conn = itc->second;
+    conn.lastActivity = now;
+
+    // fd 级限流
+    if (!allow(conn.requestRate, requestStrategy, times, secs, now))
+    {
+        if (conn.requestRate.violations < 3)
+        {
+            STT_LOG(stt::file::LogLevel::WARN,
+                "【限流】IP " + ip + " fd=" + std::to_string(fd) +
+                " 请求过快，已丢弃",
+                "[RATE] IP " + ip + " fd=" + std::to_string(fd) +
+                " request dropped"
+            );
+            return DROP;
+        }
+
+        info.badScore++;
+
+        STT_LOG(stt::file::LogLevel::WARN,
+            "【安全】IP " + ip + " fd=" + std::to_string(fd) +
+            " 多次违规，已断开",
+            "[SECURITY] IP " + ip + " fd=" + std::to_string(fd) +
+            " repeated abuse, closed"
+        );
+
+        if (info.badScore >= 15)
+        {
+            blacklist[ip] = now + std::chrono::minutes(30);
+
+            STT_LOG(stt::file::LogLevel::WARN,
+                "【封禁】IP " + ip + " 恶意请求，封禁 30 分钟",
+                "[BAN] IP " + ip + " banned for 30 minutes"
+            );
+        }
+
+        return CLOSE;
+    }
+
+    // path 级限流
+    auto pc = pathConfig.find(std::string(path));
+    if (pc != pathConfig.end())
+    {
+        auto &[ptimes, psecs] = pc->second;
+        auto &pst = conn.pathRate[std::string(path)];
+
+        if (!allow(pst, pathStrategy, ptimes, psecs, now))
+        {
+            STT_LOG(stt::file::LogLevel::WARN,
+                "【安全】IP " + ip + " fd=" + std::to_string(fd) +
+                " 访问路径 " + std::string(path) + " 过于频繁，已断开",
+                "[SECURITY] IP " + ip + " fd=" + std::to_string(fd) +
+                " path rate limited"
+            );
+
+            info.badScore++;
+            return CLOSE;
+        }
+    }
+
+    return ALLOW;
+}
+void stt::security::ConnectionLimiter::setPathLimit(const std::string &path, const int &times, const int &secs)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    pathConfig[path] = {times, secs};
+}
+bool stt::security::ConnectionLimiter::connectionDetect(const std::string &ip,const int &fd)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    if (connectionTimeout < 0)
+        return false;
+
+    auto it = table.find(ip);
+    if (it == table.end())
+        return false;
+
+    auto &info = it->second;
+    auto itc = info.conns.find(fd);
+    if (itc == info.conns.end())
+        return false;
+
+    auto now = std::chrono::steady_clock::now();
+    if (now - itc->second.lastActivity >
+        std::chrono::seconds(connectionTimeout))
+    {
+        info.conns.erase(itc);
+        if (info.activeConnections > 0)
+            info.activeConnections--;
+        return true;
+    }
+
+    return false;
+
+}
+void stt::security::ConnectionLimiter::setConnectStrategy(const RateLimitType &type)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    connectStrategy = type;
+}
+
+void stt::security::ConnectionLimiter::setRequestStrategy(const RateLimitType &type)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    requestStrategy = type;
+}
+
+void stt::security::ConnectionLimiter::setPathStrategy(const RateLimitType &type)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    pathStrategy = type;
+}
+void stt::security::ConnectionLimiter::clearIP(const std::string &ip,const int &fd)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = table.find(ip);
+    if (it == table.end())
+        return;
+
+    auto &info = it->second;
+    auto itc = info.conns.find(fd);
+    if (itc == info.conns.end())
+        return;
+
+    info.conns.erase(itc);
+    if (info.activeConnections > 0)
+        info.activeConnections--;
+}
+void stt::security::ConnectionLimiter::banIP(
+    const std::string &ip,
+    int banSeconds,
+    const std::string &reasonCN,
+    const std::string &reasonEN)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto now = std::chrono::steady_clock::now();
+
+    std::chrono::steady_clock::time_point until;
+
+    if (banSeconds < 0)
+    {
+        // 永久封禁（不会溢出、不会依赖 int）
+        until = std::chrono::steady_clock::time_point::max();
+    }
+    else if (banSeconds == 0)
+    {
+        return;
+    }
+    else
+    {
+        // 防御性截断，避免 int 极值/误传
+        if (banSeconds > 65535)
+            banSeconds = 65535;
+
+        until = now + std::chrono::seconds(banSeconds);
+    }
+    auto it = blacklist.find(ip);
+    if (it != blacklist.end())
+    {
+        // 若已有封禁时间更晚，则不缩短
+        if (it->second >= until)
+            return;
+    }
+    blacklist[ip] = until;
+
+    STT_LOG(stt::file::LogLevel::WARN,
+        "【直接封禁】IP " + ip + "：" + reasonCN +
+            (banSeconds < 0
+                ? "（永久封禁）"
+                : "，封禁 " + std::to_string(banSeconds) + " 秒"),
+        "[DIRECT BAN] IP " + ip + ": " + reasonEN +
+            (banSeconds < 0
+                ? " (permanent)"
+                : ", banned for " + std::to_string(banSeconds) + " seconds")
+    );
+}
+
+void stt::security::ConnectionLimiter::unbanIP(const std::string &ip)
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = blacklist.find(ip);
+    if (it != blacklist.end())
+    {
+        blacklist.erase(it);
+
+        STT_LOG(stt::file::LogLevel::WARN,
+            "【解封】IP " + ip + " 已解除封禁",
+            "[UNBAN] IP " + ip + " unbanned"
+        );
+    }
+}
+bool stt::security::ConnectionLimiter::isBanned(
+    const std::string &ip) const
+{
+    std::lock_guard<std::mutex> lock(mtx);
+    auto it = blacklist.find(ip);
+    if (it == blacklist.end())
+        return false;
+
+    return std::chrono::steady_clock::now() < it->second;
+}